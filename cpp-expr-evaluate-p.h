@@ -0,0 +1,25 @@
+#define CPP_EXPR_LOGICAL_OR                       1
+#define CPP_EXPR_LOGICAL_AND                      2
+#define CPP_EXPR_BITWISE_OR                       3
+#define CPP_EXPR_BITWISE_XOR                      4
+#define CPP_EXPR_BITWISE_AND                      5
+#define CPP_EXPR_EQ                               6
+#define CPP_EXPR_NEQ                              7
+#define CPP_EXPR_GT                               8
+#define CPP_EXPR_GTEQ                             9
+#define CPP_EXPR_LT                              10
+#define CPP_EXPR_LTEQ                            11
+#define CPP_EXPR_LTLT                            12
+#define CPP_EXPR_GTGT                            13
+#define CPP_EXPR_PLUS                            14
+#define CPP_EXPR_MINUS                           15
+#define CPP_EXPR_STAR                            16
+#define CPP_EXPR_SLASH                           17
+#define CPP_EXPR_PERCENT                         18
+#define CPP_EXPR_BANG                            19
+#define CPP_EXPR_TILDE                           20
+#define CPP_EXPR_UNARY                           21
+#define CPP_EXPR_NUMBER                          22
+#define CPP_EXPR_IDENTIFIER                      23
+#define CPP_EXPR_LPAREN                          24
+#define CPP_EXPR_RPAREN                          25
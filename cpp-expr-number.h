@@ -14,6 +14,54 @@ struct CPP_Expr_Result
   };
 };
 
+/* Arithmetic for #if, shared by the lemon evaluator and the
+ * compiled-expression interpreter.  C leaves signed overflow and
+ * out-of-range shifts undefined; here they wrap as in two's complement,
+ * a shift by a negative count shifts the other way, and a shift by
+ * 64 or more leaves only the sign.  Division by zero is checked by
+ * the callers, which fail the expression.
+ */
+static inline int64_t
+cpp_expr_wrap (uint64_t v)
+{
+  return v > (uint64_t) INT64_MAX ? -(int64_t) (~v) - 1 : (int64_t) v;
+}
+#define cpp_expr_mul(a,b)   cpp_expr_wrap ((uint64_t) (a) * (uint64_t) (b))
+#define cpp_expr_add(a,b)   cpp_expr_wrap ((uint64_t) (a) + (uint64_t) (b))
+#define cpp_expr_sub(a,b)   cpp_expr_wrap ((uint64_t) (a) - (uint64_t) (b))
+#define cpp_expr_neg(a)     cpp_expr_wrap (0 - (uint64_t) (a))
+
+static inline int64_t
+cpp_expr_div (int64_t a, int64_t b)
+{
+  return b == -1 ? cpp_expr_neg (a) : a / b;
+}
+static inline int64_t
+cpp_expr_mod (int64_t a, int64_t b)
+{
+  return b == -1 ? 0 : a % b;
+}
+
+static inline int64_t cpp_expr_shift_right (int64_t a, int64_t n);
+static inline int64_t
+cpp_expr_shift_left (int64_t a, int64_t n)
+{
+  if (n < 0)
+    return n <= -64 ? cpp_expr_shift_right (a, 64) : cpp_expr_shift_right (a, -n);
+  if (n >= 64)
+    return 0;
+  return cpp_expr_wrap ((uint64_t) a << n);
+}
+static inline int64_t
+cpp_expr_shift_right (int64_t a, int64_t n)
+{
+  if (n < 0)
+    return n <= -64 ? 0 : cpp_expr_shift_left (a, -n);
+  if (n >= 64)
+    return a < 0 ? -1 : 0;
+  return a < 0 ? ~(~a >> n) : a >> n;
+}
+
 typedef struct {
   bool finished;
   CPP_Expr_Result result;
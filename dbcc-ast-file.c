@@ -0,0 +1,807 @@
+#include "dbcc.h"
+#include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* --- Writing --- */
+struct DBCC_AstWriter
+{
+  DBCC_PtrTable string_indices;         /* by DBCC_Symbol */
+  DBCC_PtrTable type_indices;           /* by DBCC_Type */
+  DBCC_PtrTable node_indices;           /* by DBCC_Expr or DBCC_Statement */
+
+  size_t n_strings, strings_alloced;
+  DBCC_AstFileString *strings;
+  size_t n_types, types_alloced;
+  DBCC_AstFileType *types;
+  size_t n_nodes, nodes_alloced;
+  DBCC_AstFileNode *nodes;
+  size_t n_extra, extra_alloced;
+  uint32_t *extra;
+  size_t n_toplevel, toplevel_alloced;
+  uint32_t *toplevel;
+
+  size_t string_data_size, string_data_alloced;
+  char *string_data;
+  size_t constant_data_size, constant_data_alloced;
+  uint8_t *constant_data;
+};
+
+/* Make room for 'n' more elements, returning the first. */
+#define GROW(writer, member, n)                                         \
+  ((writer)->n_##member + (n) > (writer)->member##_alloced              \
+     ? (grow_array ((void **) &(writer)->member,                        \
+                    &(writer)->member##_alloced,                        \
+                    (writer)->n_##member + (n),                         \
+                    sizeof (*(writer)->member)), 0) : 0,                \
+   (writer)->n_##member += (n),                                         \
+   (writer)->member + (writer)->n_##member - (n))
+
+static void
+grow_array (void **array, size_t *alloced, size_t needed, size_t elt_size)
+{
+  size_t new_alloced = *alloced * 2;
+  while (new_alloced < needed)
+    new_alloced *= 2;
+  *array = realloc (*array, new_alloced * elt_size);
+  *alloced = new_alloced;
+}
+
+static void *
+grow_bytes (uint8_t **data, size_t *size, size_t *alloced, size_t n, size_t align)
+{
+  size_t start = DBCC_ALIGN (*size, align);
+  if (start + n > *alloced)
+    grow_array ((void **) data, alloced, start + n, 1);
+  memset (*data + *size, 0, start - *size);
+  *size = start + n;
+  return *data + start;
+}
+
+DBCC_AstWriter *
+dbcc_ast_writer_new           (void)
+{
+  DBCC_AstWriter *w = DBCC_NEW (DBCC_AstWriter);
+  dbcc_ptr_table_init (&w->string_indices);
+  dbcc_ptr_table_init (&w->type_indices);
+  dbcc_ptr_table_init (&w->node_indices);
+#define INIT_ARRAY(member, type)                                        \
+  w->n_##member = 1;                    /* index 0 is "none" */         \
+  w->member##_alloced = 64;                                             \
+  w->member = calloc (w->member##_alloced, sizeof (type));
+  INIT_ARRAY (strings, DBCC_AstFileString);
+  INIT_ARRAY (types, DBCC_AstFileType);
+  INIT_ARRAY (nodes, DBCC_AstFileNode);
+  INIT_ARRAY (extra, uint32_t);
+#undef INIT_ARRAY
+  w->n_toplevel = 0;
+  w->toplevel_alloced = 16;
+  w->toplevel = DBCC_NEW_ARRAY (w->toplevel_alloced, uint32_t);
+  w->string_data_size = 1;              /* "" for index 0 */
+  w->string_data_alloced = 4096;
+  w->string_data = calloc (w->string_data_alloced, 1);
+  w->constant_data_size = 0;
+  w->constant_data_alloced = 1024;
+  w->constant_data = malloc (w->constant_data_alloced);
+  return w;
+}
+
+static uint32_t
+add_string (DBCC_AstWriter *w, DBCC_Symbol *symbol)
+{
+  if (symbol == NULL)
+    return 0;
+  uintptr_t index = (uintptr_t) dbcc_ptr_table_lookup_value (&w->string_indices, symbol);
+  if (index != 0)
+    return index;
+  char *str = grow_bytes ((uint8_t **) &w->string_data, &w->string_data_size,
+                          &w->string_data_alloced, symbol->length + 1, 1);
+  memcpy (str, dbcc_symbol_get_string (symbol), symbol->length + 1);
+  DBCC_AstFileString *s = GROW (w, strings, 1);
+  s->offset = str - w->string_data;
+  s->length = symbol->length;
+  index = s - w->strings;
+  dbcc_ptr_table_set (&w->string_indices, symbol, (void *) index);
+  return index;
+}
+
+static uint32_t
+add_extra (DBCC_AstWriter *w, size_t n, const uint32_t *values)
+{
+  uint32_t *at = GROW (w, extra, n);
+  memcpy (at, values, n * sizeof (uint32_t));
+  return at - w->extra;
+}
+
+static uint32_t add_type (DBCC_AstWriter *w, DBCC_Type *type);
+
+static uint32_t
+add_members (DBCC_AstWriter *w, DBCC_Type *type)
+{
+  bool is_struct = type->metatype == DBCC_TYPE_METATYPE_STRUCT;
+  size_t n = is_struct ? type->v_struct.n_members : type->v_union.n_branches;
+  uint32_t *values = DBCC_NEW_ARRAY (n * 4 + 1, uint32_t);
+  for (size_t i = 0; i < n; i++)
+    {
+      DBCC_Type *mtype;
+      DBCC_Symbol *name;
+      size_t offset = 0;
+      bool is_bitfield;
+      unsigned bit_length, bit_offset;
+      if (is_struct)
+        {
+          DBCC_TypeStructMember *m = type->v_struct.members + i;
+          mtype = m->type; name = m->name; offset = m->offset;
+          is_bitfield = m->is_bitfield;
+          bit_length = m->bit_length; bit_offset = m->bit_offset;
+        }
+      else
+        {
+          DBCC_TypeUnionBranch *m = type->v_union.branches + i;
+          mtype = m->type; name = m->name;
+          is_bitfield = m->is_bitfield;
+          bit_length = m->bit_length; bit_offset = m->bit_offset;
+        }
+      values[4*i+0] = add_type (w, mtype);
+      values[4*i+1] = add_string (w, name);
+      values[4*i+2] = offset;
+      values[4*i+3] = is_bitfield ? (bit_length << 8) | bit_offset : 0;
+    }
+  uint32_t rv = add_extra (w, n * 4, values);
+  free (values);
+  return rv;
+}
+
+/* The index is claimed before the types this one refers to are
+ * added, so that cycles through pointers end here.
+ */
+static uint32_t
+add_type (DBCC_AstWriter *w, DBCC_Type *type)
+{
+  if (type == NULL)
+    return 0;
+  uintptr_t index = (uintptr_t) dbcc_ptr_table_lookup_value (&w->type_indices, type);
+  if (index != 0)
+    return index;
+  index = GROW (w, types, 1) - w->types;
+  dbcc_ptr_table_set (&w->type_indices, type, (void *) index);
+
+  DBCC_AstFileType t;
+  memset (&t, 0, sizeof (t));
+  t.metatype = type->metatype;
+  t.name = add_string (w, type->base.name);
+  t.sizeof_instance = type->base.sizeof_instance;
+  t.alignof_instance = type->base.alignof_instance;
+  switch (type->metatype)
+    {
+    case DBCC_TYPE_METATYPE_VOID:
+    case DBCC_TYPE_METATYPE_BOOL:
+    case DBCC_TYPE_METATYPE_KR_FUNCTION:
+      break;
+    case DBCC_TYPE_METATYPE_INT:
+      if (type->v_int.is_signed)
+        t.flags |= DBCC_AST_FILE_TYPE_SIGNED;
+      break;
+    case DBCC_TYPE_METATYPE_FLOAT:
+      t.count = type->v_float.float_type;
+      if (type->v_float.is_complex)
+        t.flags |= DBCC_AST_FILE_TYPE_COMPLEX;
+      break;
+    case DBCC_TYPE_METATYPE_ARRAY:
+      t.target = add_type (w, type->v_array.element_type);
+      t.count = type->v_array.n_elements;
+      break;
+    case DBCC_TYPE_METATYPE_VARIABLE_LENGTH_ARRAY:
+      t.target = add_type (w, type->v_variable_length_array.element_type);
+      break;
+    case DBCC_TYPE_METATYPE_STRUCT:
+      t.name = add_string (w, type->v_struct.tag);
+      t.count = type->v_struct.n_members;
+      if (type->v_struct.incomplete)
+        t.flags |= DBCC_AST_FILE_TYPE_INCOMPLETE;
+      t.extra = add_members (w, type);
+      break;
+    case DBCC_TYPE_METATYPE_UNION:
+      t.name = add_string (w, type->v_union.tag);
+      t.count = type->v_union.n_branches;
+      if (type->v_union.incomplete)
+        t.flags |= DBCC_AST_FILE_TYPE_INCOMPLETE;
+      t.extra = add_members (w, type);
+      break;
+    case DBCC_TYPE_METATYPE_ENUM:
+      {
+        t.name = add_string (w, type->v_enum.tag);
+        if (type->v_enum.is_signed)
+          t.flags |= DBCC_AST_FILE_TYPE_SIGNED;
+        size_t n = type->v_enum.n_values;
+        uint32_t *values = DBCC_NEW_ARRAY (n * 2 + 1, uint32_t);
+        for (size_t i = 0; i < n; i++)
+          {
+            values[2*i+0] = add_string (w, type->v_enum.values[i].name);
+            values[2*i+1] = (uint32_t) type->v_enum.values[i].value;
+          }
+        t.count = n;
+        t.extra = add_extra (w, n * 2, values);
+        free (values);
+        break;
+      }
+    case DBCC_TYPE_METATYPE_POINTER:
+      t.target = add_type (w, type->v_pointer.target_type);
+      break;
+    case DBCC_TYPE_METATYPE_TYPEDEF:
+      t.target = add_type (w, type->v_typedef.underlying_type);
+      break;
+    case DBCC_TYPE_METATYPE_QUALIFIED:
+      t.target = add_type (w, type->v_qualified.underlying_type);
+      t.qualifiers = type->v_qualified.qualifiers;
+      break;
+    case DBCC_TYPE_METATYPE_FUNCTION:
+      {
+        t.target = add_type (w, type->v_function.return_type);
+        if (type->v_function.has_varargs)
+          t.flags |= DBCC_AST_FILE_TYPE_VARARGS;
+        unsigned n = type->v_function.n_params;
+        uint32_t *values = DBCC_NEW_ARRAY (n * 2 + 1, uint32_t);
+        for (unsigned i = 0; i < n; i++)
+          {
+            values[2*i+0] = add_type (w, type->v_function.params[i].type);
+            values[2*i+1] = add_string (w, type->v_function.params[i].name);
+          }
+        t.count = n;
+        t.extra = add_extra (w, n * 2, values);
+        free (values);
+        break;
+      }
+    }
+  w->types[index] = t;
+  return index;
+}
+
+static void
+set_code_position (DBCC_AstWriter *w, DBCC_AstFileNode *n, DBCC_CodePosition *cp)
+{
+  if (cp == NULL)
+    return;
+  n->filename = add_string (w, cp->filename);
+  n->line_no = cp->line_no;
+  n->column = cp->column;
+}
+
+static uint32_t
+finish_node (DBCC_AstWriter *w, const void *key, DBCC_AstFileNode *n)
+{
+  uint32_t index = GROW (w, nodes, 1) - w->nodes;
+  w->nodes[index] = *n;
+  dbcc_ptr_table_set (&w->node_indices, key, (void *) (uintptr_t) index);
+  return index;
+}
+
+static uint32_t add_statement (DBCC_AstWriter *w, DBCC_Statement *stmt);
+
+static uint32_t
+add_expr (DBCC_AstWriter *w, DBCC_Expr *expr)
+{
+  if (expr == NULL)
+    return 0;
+  uintptr_t index = (uintptr_t) dbcc_ptr_table_lookup_value (&w->node_indices, expr);
+  if (index != 0)
+    return index;
+
+  DBCC_AstFileNode n;
+  memset (&n, 0, sizeof (n));
+  n.kind = expr->expr_type;
+  n.type = add_type (w, expr->base.value_type);
+  set_code_position (w, &n, expr->base.code_position);
+
+  DBCC_Constant *c = expr->base.constant;
+  if (c != NULL && c->constant_type == DBCC_CONSTANT_TYPE_VALUE
+   && expr->base.value_type != NULL)
+    {
+      size_t size = expr->base.value_type->base.sizeof_instance;
+      uint8_t *at = grow_bytes (&w->constant_data, &w->constant_data_size,
+                                &w->constant_data_alloced, size, 8);
+      memcpy (at, c->v_value.data, size);
+      n.constant_offset = at - w->constant_data;
+      n.flags |= DBCC_AST_FILE_NODE_HAS_CONSTANT;
+    }
+  else if (c != NULL && c->constant_type == DBCC_CONSTANT_TYPE_LINK_ADDRESS)
+    {
+      n.name = add_string (w, c->v_link_address.name);
+      n.flags |= DBCC_AST_FILE_NODE_LINK_ADDRESS;
+    }
+
+  switch (expr->expr_type)
+    {
+    case DBCC_EXPR_TYPE_UNARY_OP:
+      n.op = expr->v_unary.op;
+      n.children[0] = add_expr (w, expr->v_unary.a);
+      break;
+    case DBCC_EXPR_TYPE_BINARY_OP:
+      n.op = expr->v_binary.op;
+      n.children[0] = add_expr (w, expr->v_binary.a);
+      n.children[1] = add_expr (w, expr->v_binary.b);
+      break;
+    case DBCC_EXPR_TYPE_TERNARY_OP:
+      n.children[0] = add_expr (w, expr->v_ternary.condition);
+      n.children[1] = add_expr (w, expr->v_ternary.true_value);
+      n.children[2] = add_expr (w, expr->v_ternary.false_value);
+      break;
+    case DBCC_EXPR_TYPE_INPLACE_BINARY_OP:
+      n.op = expr->v_inplace_binary.op;
+      n.children[0] = add_expr (w, expr->v_inplace_binary.inout);
+      n.children[1] = add_expr (w, expr->v_inplace_binary.b);
+      break;
+    case DBCC_EXPR_TYPE_INPLACE_UNARY_OP:
+      n.op = expr->v_inplace_unary.op;
+      n.children[0] = add_expr (w, expr->v_inplace_unary.inout);
+      break;
+    case DBCC_EXPR_TYPE_CONSTANT:
+      break;
+    case DBCC_EXPR_TYPE_CALL:
+      {
+        size_t n_args = expr->v_call.n_args;
+        uint32_t *args = DBCC_NEW_ARRAY (n_args + 1, uint32_t);
+        n.children[0] = add_expr (w, expr->v_call.head);
+        for (size_t i = 0; i < n_args; i++)
+          args[i] = add_expr (w, expr->v_call.args[i]);
+        n.n_extra = n_args;
+        n.extra = add_extra (w, n_args, args);
+        free (args);
+        break;
+      }
+    case DBCC_EXPR_TYPE_CAST:
+      n.children[0] = add_expr (w, expr->v_cast.pre_cast_expr);
+      break;
+    case DBCC_EXPR_TYPE_ACCESS:
+      n.children[0] = add_expr (w, expr->v_access.object);
+      n.name = add_string (w, expr->v_access.name);
+      if (expr->v_access.is_pointer)
+        n.flags |= DBCC_AST_FILE_NODE_POINTER_ACCESS;
+      if (expr->v_access.is_union)
+        n.flags |= DBCC_AST_FILE_NODE_UNION_ACCESS;
+      break;
+    case DBCC_EXPR_TYPE_IDENTIFIER:
+      n.name = add_string (w, expr->v_identifier.name);
+      n.op = expr->v_identifier.id_type;
+      break;
+    case DBCC_EXPR_TYPE_STRUCTURED_INITIALIZER:
+      {
+        /* only the flattened form:  that is what's left after
+         * the initializer's type is known */
+        DBCC_StructuredInitializerExpr *si = &expr->v_structured_initializer;
+        uint32_t *values = DBCC_NEW_ARRAY (si->n_flat_pieces * 3 + 1, uint32_t);
+        for (size_t i = 0; i < si->n_flat_pieces; i++)
+          {
+            values[3*i+0] = si->flat_pieces[i].offset;
+            values[3*i+1] = si->flat_pieces[i].length;
+            values[3*i+2] = add_expr (w, si->flat_pieces[i].piece_expr);
+          }
+        n.n_extra = si->n_flat_pieces * 3;
+        n.extra = add_extra (w, n.n_extra, values);
+        free (values);
+        break;
+      }
+    }
+  return finish_node (w, expr, &n);
+}
+
+static uint32_t
+add_statement (DBCC_AstWriter *w, DBCC_Statement *stmt)
+{
+  if (stmt == NULL)
+    return 0;
+  uintptr_t index = (uintptr_t) dbcc_ptr_table_lookup_value (&w->node_indices, stmt);
+  if (index != 0)
+    return index;
+
+  DBCC_AstFileNode n;
+  memset (&n, 0, sizeof (n));
+  n.kind = stmt->type;
+  set_code_position (w, &n, stmt->base.code_position);
+  switch (stmt->type)
+    {
+    case DBCC_STATEMENT_COMPOUND:
+      {
+        unsigned count = stmt->v_compound.n_statements;
+        uint32_t *values = DBCC_NEW_ARRAY (count + 1, uint32_t);
+        for (unsigned i = 0; i < count; i++)
+          values[i] = add_statement (w, stmt->v_compound.statements[i]);
+        n.n_extra = count;
+        n.extra = add_extra (w, count, values);
+        free (values);
+        if (stmt->v_compound.defines_scope)
+          n.flags |= DBCC_AST_FILE_NODE_DEFINES_SCOPE;
+        break;
+      }
+    case DBCC_STATEMENT_FOR:
+      n.children[0] = add_statement (w, stmt->v_for.init);
+      n.children[1] = add_expr (w, stmt->v_for.condition);
+      n.children[2] = add_statement (w, stmt->v_for.advance);
+      n.children[3] = add_statement (w, stmt->v_for.body);
+      break;
+    case DBCC_STATEMENT_WHILE:
+      n.children[0] = add_expr (w, stmt->v_while.condition);
+      n.children[1] = add_statement (w, stmt->v_while.body);
+      break;
+    case DBCC_STATEMENT_DO_WHILE:
+      n.children[0] = add_statement (w, stmt->v_do_while.body);
+      n.children[1] = add_expr (w, stmt->v_do_while.condition);
+      break;
+    case DBCC_STATEMENT_SWITCH:
+      {
+        n.children[0] = add_expr (w, stmt->v_switch.value_expr);
+        n.children[1] = add_statement (w, stmt->v_switch.body);
+        unsigned count = stmt->v_switch.n_cases;
+        uint32_t *values = DBCC_NEW_ARRAY (count * 3 + 1, uint32_t);
+        for (unsigned i = 0; i < count; i++)
+          {
+            uint64_t v = stmt->v_switch.cases[i].value;
+            values[3*i+0] = (uint32_t) v;
+            values[3*i+1] = (uint32_t) (v >> 32);
+            values[3*i+2] = add_statement (w, stmt->v_switch.cases[i].case_statement);
+          }
+        n.n_extra = count * 3;
+        n.extra = add_extra (w, n.n_extra, values);
+        free (values);
+        break;
+      }
+    case DBCC_STATEMENT_IF:
+      n.children[0] = add_expr (w, stmt->v_if.condition);
+      n.children[1] = add_statement (w, stmt->v_if.body);
+      n.children[2] = add_statement (w, stmt->v_if.else_body);
+      break;
+    case DBCC_STATEMENT_GOTO:
+      n.name = add_string (w, stmt->v_goto.label);
+      break;
+    case DBCC_STATEMENT_BREAK:
+    case DBCC_STATEMENT_CONTINUE:
+    case DBCC_STATEMENT_DEFAULT:
+      break;
+    case DBCC_STATEMENT_RETURN:
+      n.children[0] = add_expr (w, stmt->v_return.return_value);
+      break;
+    case DBCC_STATEMENT_LABEL:
+      n.name = add_string (w, stmt->v_label.name);
+      break;
+    case DBCC_STATEMENT_CASE:
+      n.children[0] = add_expr (w, stmt->v_case.value_expr);
+      break;
+    case DBCC_STATEMENT_EXPR:
+      n.children[0] = add_expr (w, stmt->v_expr.expr);
+      break;
+    case DBCC_STATEMENT_DECLARATION:
+      n.op = stmt->v_declaration.storage_specs;
+      n.type = add_type (w, stmt->v_declaration.type);
+      n.name = add_string (w, stmt->v_declaration.name);
+      n.children[0] = add_expr (w, stmt->v_declaration.opt_value);
+      break;
+    }
+  return finish_node (w, stmt, &n);
+}
+
+void
+dbcc_ast_writer_add_statement (DBCC_AstWriter *writer,
+                               DBCC_Statement *statement)
+{
+  uint32_t index = add_statement (writer, statement);
+  *GROW (writer, toplevel, 1) = index;
+}
+
+static bool
+write_section (FILE *fp, uint64_t *offset_out, const void *data, size_t size)
+{
+  static const uint8_t zeroes[8];
+  long pos = ftell (fp);
+  size_t pad = DBCC_ALIGN (pos, 8) - pos;
+  if (pad > 0 && fwrite (zeroes, pad, 1, fp) != 1)
+    return false;
+  *offset_out = pos + pad;
+  return size == 0 || fwrite (data, size, 1, fp) == 1;
+}
+
+bool
+dbcc_ast_writer_write         (DBCC_AstWriter *w,
+                               const char     *filename,
+                               DBCC_Error    **error)
+{
+  FILE *fp = fopen (filename, "wb");
+  if (fp == NULL)
+    {
+      *error = dbcc_error_new (DBCC_ERROR_WRITING_FILE,
+                               "error creating %s: %s",
+                               filename, strerror (errno));
+      return false;
+    }
+
+  DBCC_AstFileHeader h;
+  memset (&h, 0, sizeof (h));
+  memcpy (h.magic, DBCC_AST_FILE_MAGIC, sizeof (h.magic));
+  h.version = DBCC_AST_FILE_VERSION;
+  h.byte_order_mark = DBCC_AST_FILE_BYTE_ORDER_MARK;
+  h.n_strings = w->n_strings;
+  h.n_types = w->n_types;
+  h.n_nodes = w->n_nodes;
+  h.n_extra = w->n_extra;
+  h.n_toplevel = w->n_toplevel;
+  h.string_data_size = w->string_data_size;
+  h.constant_data_size = w->constant_data_size;
+
+  /* write the header twice:  once to hold its place, once
+   * with the offsets filled in */
+  uint64_t header_offset;
+  bool ok = write_section (fp, &header_offset, &h, sizeof (h))
+         && write_section (fp, &h.strings_offset, w->strings,
+                           w->n_strings * sizeof (DBCC_AstFileString))
+         && write_section (fp, &h.types_offset, w->types,
+                           w->n_types * sizeof (DBCC_AstFileType))
+         && write_section (fp, &h.nodes_offset, w->nodes,
+                           w->n_nodes * sizeof (DBCC_AstFileNode))
+         && write_section (fp, &h.extra_offset, w->extra,
+                           w->n_extra * sizeof (uint32_t))
+         && write_section (fp, &h.toplevel_offset, w->toplevel,
+                           w->n_toplevel * sizeof (uint32_t))
+         && write_section (fp, &h.string_data_offset, w->string_data,
+                           w->string_data_size)
+         && write_section (fp, &h.constant_data_offset, w->constant_data,
+                           w->constant_data_size);
+  if (ok)
+    {
+      h.file_size = ftell (fp);
+      ok = fseek (fp, 0, SEEK_SET) == 0
+        && fwrite (&h, sizeof (h), 1, fp) == 1;
+    }
+  if (fclose (fp) != 0)
+    ok = false;
+  if (!ok)
+    {
+      *error = dbcc_error_new (DBCC_ERROR_WRITING_FILE,
+                               "error writing %s: %s",
+                               filename, strerror (errno));
+      return false;
+    }
+  return true;
+}
+
+void
+dbcc_ast_writer_destroy       (DBCC_AstWriter *writer)
+{
+  dbcc_ptr_table_clear (&writer->string_indices);
+  dbcc_ptr_table_clear (&writer->type_indices);
+  dbcc_ptr_table_clear (&writer->node_indices);
+  free (writer->strings);
+  free (writer->types);
+  free (writer->nodes);
+  free (writer->extra);
+  free (writer->toplevel);
+  free (writer->string_data);
+  free (writer->constant_data);
+  free (writer);
+}
+
+/* --- Reading --- */
+
+/* Is [offset, offset + n * size) inside a file of 'file_size' bytes? */
+static bool
+section_ok (uint64_t file_size, uint64_t offset, uint64_t n, uint64_t size)
+{
+  if (offset % 8 != 0 || offset > file_size)
+    return false;
+  return n <= (file_size - offset) / size;
+}
+
+static bool
+extra_ok (const DBCC_AstFile *file, uint32_t start, uint64_t n)
+{
+  return start <= file->header->n_extra
+      && n <= file->header->n_extra - start;
+}
+
+static bool
+types_ok (const DBCC_AstFile *file)
+{
+  const DBCC_AstFileHeader *h = file->header;
+  for (uint32_t i = 1; i < h->n_types; i++)
+    {
+      const DBCC_AstFileType *t = file->types + i;
+      if (t->name >= h->n_strings || t->target >= h->n_types)
+        return false;
+      unsigned per;
+      switch (t->metatype)
+        {
+        case DBCC_TYPE_METATYPE_STRUCT:
+        case DBCC_TYPE_METATYPE_UNION:
+          per = 4;
+          break;
+        case DBCC_TYPE_METATYPE_FUNCTION:
+        case DBCC_TYPE_METATYPE_ENUM:
+          per = 2;
+          break;
+        default:
+          continue;
+        }
+      if (t->count < 0 || !extra_ok (file, t->extra, (uint64_t) t->count * per))
+        return false;
+      const uint32_t *e = file->extra + t->extra;
+      for (int64_t j = 0; j < t->count; j++, e += per)
+        if (t->metatype == DBCC_TYPE_METATYPE_ENUM
+              ? e[0] >= h->n_strings
+              : e[0] >= h->n_types || e[1] >= h->n_strings)
+          return false;
+    }
+  return true;
+}
+
+/* Extras holding node indices:  all of them, or every third. */
+static bool
+node_extras_ok (const DBCC_AstFile *file, uint32_t index)
+{
+  const DBCC_AstFileNode *n = file->nodes + index;
+  unsigned stride, which;
+  switch (n->kind)
+    {
+    case DBCC_EXPR_TYPE_CALL:
+    case DBCC_STATEMENT_COMPOUND:
+      stride = 1, which = 0;
+      break;
+    case DBCC_EXPR_TYPE_STRUCTURED_INITIALIZER:
+    case DBCC_STATEMENT_SWITCH:
+      stride = 3, which = 2;
+      break;
+    default:
+      return n->n_extra == 0;
+    }
+  if (n->n_extra % stride != 0 || !extra_ok (file, n->extra, n->n_extra))
+    return false;
+  for (uint32_t j = which; j < n->n_extra; j += stride)
+    if (file->extra[n->extra + j] >= index)
+      return false;
+  return true;
+}
+
+static bool
+nodes_ok (const DBCC_AstFile *file)
+{
+  const DBCC_AstFileHeader *h = file->header;
+  for (uint32_t i = 1; i < h->n_nodes; i++)
+    {
+      const DBCC_AstFileNode *n = file->nodes + i;
+      if (n->type >= h->n_types
+       || n->name >= h->n_strings
+       || n->filename >= h->n_strings)
+        return false;
+      for (unsigned c = 0; c < DSK_N_ELEMENTS (n->children); c++)
+        if (n->children[c] >= i)
+          return false;
+      if (!node_extras_ok (file, i))
+        return false;
+      if (n->flags & DBCC_AST_FILE_NODE_HAS_CONSTANT)
+        {
+          if (n->type == 0)
+            return false;
+          uint64_t size = file->types[n->type].sizeof_instance;
+          if (n->constant_offset > h->constant_data_size
+           || size > h->constant_data_size - n->constant_offset)
+            return false;
+        }
+    }
+  for (uint32_t i = 0; i < h->n_toplevel; i++)
+    if (file->toplevel[i] == 0 || file->toplevel[i] >= h->n_nodes)
+      return false;
+  return true;
+}
+
+static bool
+init_file (DBCC_AstFile *file, size_t size, const uint8_t *data)
+{
+  const DBCC_AstFileHeader *h = (const DBCC_AstFileHeader *) data;
+  if (size < sizeof (DBCC_AstFileHeader)
+   || ((uintptr_t) data) % 8 != 0
+   || memcmp (h->magic, DBCC_AST_FILE_MAGIC, sizeof (h->magic)) != 0
+   || h->version != DBCC_AST_FILE_VERSION
+   || h->byte_order_mark != DBCC_AST_FILE_BYTE_ORDER_MARK
+   || h->file_size != size
+   || h->n_strings == 0 || h->n_types == 0 || h->n_nodes == 0)
+    return false;
+  if (!section_ok (size, h->strings_offset, h->n_strings, sizeof (DBCC_AstFileString))
+   || !section_ok (size, h->types_offset, h->n_types, sizeof (DBCC_AstFileType))
+   || !section_ok (size, h->nodes_offset, h->n_nodes, sizeof (DBCC_AstFileNode))
+   || !section_ok (size, h->extra_offset, h->n_extra, sizeof (uint32_t))
+   || !section_ok (size, h->toplevel_offset, h->n_toplevel, sizeof (uint32_t))
+   || !section_ok (size, h->string_data_offset, h->string_data_size, 1)
+   || !section_ok (size, h->constant_data_offset, h->constant_data_size, 1))
+    return false;
+
+  file->header = h;
+  file->strings = (const DBCC_AstFileString *) (data + h->strings_offset);
+  file->types = (const DBCC_AstFileType *) (data + h->types_offset);
+  file->nodes = (const DBCC_AstFileNode *) (data + h->nodes_offset);
+  file->extra = (const uint32_t *) (data + h->extra_offset);
+  file->toplevel = (const uint32_t *) (data + h->toplevel_offset);
+  file->string_data = (const char *) (data + h->string_data_offset);
+  file->constant_data = data + h->constant_data_offset;
+
+  for (uint32_t i = 0; i < h->n_strings; i++)
+    {
+      const DBCC_AstFileString *s = file->strings + i;
+      if ((uint64_t) s->offset + s->length >= h->string_data_size
+       || file->string_data[s->offset + s->length] != '\0')
+        return false;
+    }
+  return types_ok (file) && nodes_ok (file);
+}
+
+DBCC_AstFile *
+dbcc_ast_file_open_data (size_t              size,
+                         const uint8_t      *data,
+                         DBCC_Error        **error)
+{
+  DBCC_AstFile *file = DBCC_NEW (DBCC_AstFile);
+  file->mapping = NULL;
+  file->mapping_size = 0;
+  if (!init_file (file, size, data))
+    {
+      free (file);
+      *error = dbcc_error_new (DBCC_ERROR_BAD_AST_FILE, "malformed AST file");
+      return NULL;
+    }
+  return file;
+}
+
+DBCC_AstFile *
+dbcc_ast_file_open      (const char         *filename,
+                         DBCC_Error        **error)
+{
+  int fd = open (filename, O_RDONLY);
+  if (fd < 0)
+    {
+      *error = dbcc_error_new (DBCC_ERROR_READING_FILE,
+                               "error opening %s: %s",
+                               filename, strerror (errno));
+      return NULL;
+    }
+  struct stat st;
+  if (fstat (fd, &st) < 0)
+    {
+      *error = dbcc_error_new (DBCC_ERROR_READING_FILE,
+                               "error stat'ing %s: %s",
+                               filename, strerror (errno));
+      close (fd);
+      return NULL;
+    }
+  size_t size = st.st_size;
+  void *mapping = size == 0 ? MAP_FAILED
+                            : mmap (NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  int mmap_errno = errno;
+  close (fd);
+  if (mapping == MAP_FAILED)
+    {
+      *error = dbcc_error_new (DBCC_ERROR_READING_FILE,
+                               "error mapping %s: %s",
+                               filename, size == 0 ? "empty file"
+                                                   : strerror (mmap_errno));
+      return NULL;
+    }
+
+  DBCC_AstFile *file = DBCC_NEW (DBCC_AstFile);
+  file->mapping = mapping;
+  file->mapping_size = size;
+  if (!init_file (file, size, mapping))
+    {
+      dbcc_ast_file_close (file);
+      *error = dbcc_error_new (DBCC_ERROR_BAD_AST_FILE,
+                               "%s: malformed AST file", filename);
+      return NULL;
+    }
+  return file;
+}
+
+void
+dbcc_ast_file_close     (DBCC_AstFile       *file)
+{
+  if (file->mapping != NULL)
+    munmap (file->mapping, file->mapping_size);
+  free (file);
+}
@@ -0,0 +1,226 @@
+#ifndef __DBCC_AST_FILE_H_
+#define __DBCC_AST_FILE_H_
+
+/* A binary form of the AST that downstream tools (indexers,
+ * linters, code generators) can mmap and walk in place,
+ * without a parser and without building any objects.
+ *
+ * The file is a header followed by tables of fixed-size records.
+ * Records refer to each other by index, never by pointer;
+ * index 0 of every table is a placeholder, so 0 means "none".
+ * Strings are NUL-terminated, so they can be used directly.
+ *
+ * Nodes are written children first:  every child's index is less
+ * than its parent's, which dbcc_ast_file_open() checks, so a tool
+ * can walk the tree recursively without guarding against cycles.
+ * Types may refer to each other in cycles (a struct holding
+ * a pointer to itself).
+ *
+ * The file is in the byte order of the machine that wrote it;
+ * opening it elsewhere fails.
+ */
+
+#define DBCC_AST_FILE_MAGIC             "DBCCAST"       /* with its NUL, 8 bytes */
+#define DBCC_AST_FILE_VERSION           1
+#define DBCC_AST_FILE_BYTE_ORDER_MARK   0x01020304
+
+typedef struct DBCC_AstFileHeader DBCC_AstFileHeader;
+typedef struct DBCC_AstFileString DBCC_AstFileString;
+typedef struct DBCC_AstFileType DBCC_AstFileType;
+typedef struct DBCC_AstFileNode DBCC_AstFileNode;
+typedef struct DBCC_AstFile DBCC_AstFile;
+typedef struct DBCC_AstWriter DBCC_AstWriter;
+
+struct DBCC_AstFileHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order_mark;
+
+  uint32_t n_strings;
+  uint32_t n_types;
+  uint32_t n_nodes;
+  uint32_t n_extra;
+  uint32_t n_toplevel;
+  uint32_t reserved;
+
+  /* byte offsets from the start of the file, each 8-aligned */
+  uint64_t strings_offset;
+  uint64_t types_offset;
+  uint64_t nodes_offset;
+  uint64_t extra_offset;
+  uint64_t toplevel_offset;
+  uint64_t string_data_offset;
+  uint64_t string_data_size;
+  uint64_t constant_data_offset;
+  uint64_t constant_data_size;
+  uint64_t file_size;
+};
+
+struct DBCC_AstFileString
+{
+  uint32_t offset;              /* into the string data */
+  uint32_t length;              /* not counting the NUL */
+};
+
+/* Per-metatype meaning of 'target', 'count' and 'extra':
+ *
+ *   POINTER                target = pointed-to type
+ *   ARRAY                  target = element type, count = length or -1
+ *   VARIABLE_LENGTH_ARRAY  target = element type
+ *   TYPEDEF, QUALIFIED     target = underlying type
+ *   FLOAT                  count = DBCC_FloatType
+ *   FUNCTION               target = return type,  count params of
+ *                          2 extras each:  type, name
+ *   STRUCT, UNION          count members of 4 extras each:  type,
+ *                          name, byte offset, bit-field info
+ *                          (length << 8 | bit offset, or 0)
+ *   ENUM                   count values of 2 extras each:  name, value
+ *
+ * 'name' is the typedef name or the tag.
+ */
+typedef enum
+{
+  DBCC_AST_FILE_TYPE_SIGNED       = (1<<0),
+  DBCC_AST_FILE_TYPE_VARARGS      = (1<<1),
+  DBCC_AST_FILE_TYPE_INCOMPLETE   = (1<<2),
+  DBCC_AST_FILE_TYPE_COMPLEX      = (1<<3),
+} DBCC_AstFileTypeFlags;
+
+struct DBCC_AstFileType
+{
+  uint16_t metatype;            /* DBCC_Type_Metatype */
+  uint16_t flags;               /* DBCC_AstFileTypeFlags */
+  uint32_t name;
+  uint32_t target;
+  uint32_t extra;
+  int64_t count;
+  uint64_t sizeof_instance;
+  uint32_t alignof_instance;
+  uint32_t qualifiers;          /* DBCC_TypeQualifier, for QUALIFIED */
+};
+
+/* 'kind' is a DBCC_Expr_Type, or a DBCC_StatementType for
+ * statements (which start at DBCC_STATEMENT_COMPOUND).
+ *
+ * Children, by kind:
+ *
+ *   UNARY_OP, INPLACE_UNARY_OP, CAST    a                      op
+ *   BINARY_OP, INPLACE_BINARY_OP        a, b                   op
+ *   TERNARY_OP                          cond, true, false
+ *   CALL                                head;  args in extras
+ *   ACCESS                              object                 name
+ *   IDENTIFIER                                                 name, op = DBCC_IdentifierType
+ *   STRUCTURED_INITIALIZER              extras:  3 per flattened piece:
+ *                                       offset, length, expr (0 to zero it)
+ *
+ *   COMPOUND                            extras:  the statements
+ *   FOR                                 init, cond, advance, body
+ *   WHILE, IF                           cond, body (, else)
+ *   DO_WHILE                            body, cond
+ *   SWITCH                              value, body;  extras:  3 per case:
+ *                                       value low 32 bits, high 32 bits, statement
+ *   RETURN, CASE, EXPR                  value
+ *   GOTO, LABEL                                                name
+ *   DECLARATION                         initial value          name, type,
+ *                                                              op = DBCC_StorageClassSpecifier
+ *
+ * For expressions, 'type' is the value type once inferred.
+ */
+typedef enum
+{
+  DBCC_AST_FILE_NODE_HAS_CONSTANT = (1<<0),     /* constant_offset is valid */
+  DBCC_AST_FILE_NODE_LINK_ADDRESS = (1<<1),     /* constant is &name */
+  DBCC_AST_FILE_NODE_POINTER_ACCESS = (1<<2),   /* -> rather than . */
+  DBCC_AST_FILE_NODE_UNION_ACCESS = (1<<3),
+  DBCC_AST_FILE_NODE_DEFINES_SCOPE = (1<<4),    /* compound statement */
+} DBCC_AstFileNodeFlags;
+
+struct DBCC_AstFileNode
+{
+  uint16_t kind;
+  uint16_t flags;               /* DBCC_AstFileNodeFlags */
+  uint32_t op;
+  uint32_t type;
+  uint32_t name;
+  uint32_t children[4];
+  uint32_t n_extra;
+  uint32_t extra;
+
+  /* code position;  filename 0 if unknown */
+  uint32_t filename;
+  uint32_t line_no;
+  uint32_t column;
+  uint32_t reserved;
+
+  /* into the constant data;  type->sizeof_instance bytes */
+  uint64_t constant_offset;
+};
+
+/* --- Reading --- */
+struct DBCC_AstFile
+{
+  const DBCC_AstFileHeader *header;
+  const DBCC_AstFileString *strings;
+  const DBCC_AstFileType *types;
+  const DBCC_AstFileNode *nodes;
+  const uint32_t *extra;
+  const uint32_t *toplevel;
+  const char *string_data;
+  const uint8_t *constant_data;
+
+  /*< private >*/
+  void *mapping;
+  size_t mapping_size;
+};
+
+/* Maps the file and checks every index and range in it,
+ * so the accessors below need no further checks.
+ */
+DBCC_AstFile *dbcc_ast_file_open      (const char         *filename,
+                                       DBCC_Error        **error);
+
+/* 'data' must be 8-aligned and outlive the returned file. */
+DBCC_AstFile *dbcc_ast_file_open_data (size_t              size,
+                                       const uint8_t      *data,
+                                       DBCC_Error        **error);
+void          dbcc_ast_file_close     (DBCC_AstFile       *file);
+
+DBCC_INLINE const char *
+dbcc_ast_file_get_string (const DBCC_AstFile *file, uint32_t index)
+{
+  return index == 0 ? NULL : file->string_data + file->strings[index].offset;
+}
+
+DBCC_INLINE const DBCC_AstFileNode *
+dbcc_ast_file_get_node   (const DBCC_AstFile *file, uint32_t index)
+{
+  return index == 0 ? NULL : file->nodes + index;
+}
+
+DBCC_INLINE const DBCC_AstFileType *
+dbcc_ast_file_get_type   (const DBCC_AstFile *file, uint32_t index)
+{
+  return index == 0 ? NULL : file->types + index;
+}
+
+DBCC_INLINE const uint32_t *
+dbcc_ast_file_get_node_extra (const DBCC_AstFile *file, const DBCC_AstFileNode *node)
+{
+  return file->extra + node->extra;
+}
+
+/* --- Writing --- */
+DBCC_AstWriter *dbcc_ast_writer_new           (void);
+
+/* Adds a toplevel statement, with everything it refers to.
+ * Nodes and types reached more than once are written once.
+ */
+void            dbcc_ast_writer_add_statement (DBCC_AstWriter *writer,
+                                               DBCC_Statement *statement);
+bool            dbcc_ast_writer_write         (DBCC_AstWriter *writer,
+                                               const char     *filename,
+                                               DBCC_Error    **error);
+void            dbcc_ast_writer_destroy       (DBCC_AstWriter *writer);
+
+#endif
@@ -8,8 +8,9 @@ dbcc_code_position_new  (DBCC_CodePosition *expanded_from,
                          unsigned           column,
                          unsigned           byte_offset)
 {
-  DBCC_CodePosition *cp = malloc (sizeof (DBCC_CodePosition));
+  DBCC_CodePosition *cp = dbcc_node_alloc (sizeof (DBCC_CodePosition));
   cp->ref_count = 1;
+  cp->from_region = dbcc_node_allocs_from_region ();
   cp->expanded_from = expanded_from;
   if (expanded_from)
     dbcc_code_position_ref (expanded_from);
@@ -25,11 +26,14 @@ dbcc_code_position_new  (DBCC_CodePosition *expanded_from,
 
 DBCC_CodePosition *dbcc_code_position_ref   (DBCC_CodePosition *cp)
 {
-  cp->ref_count += 1;
+  if (!cp->from_region)
+    cp->ref_count += 1;
   return cp;
 }
 void               dbcc_code_position_unref (DBCC_CodePosition *cp)
 {
+  if (cp->from_region)
+    return;
   if (cp->ref_count == 1)
     {
       if (cp->expanded_from)
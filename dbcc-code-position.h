@@ -9,6 +9,7 @@ struct DBCC_CodePosition
   unsigned line_no;
   unsigned column;
   unsigned byte_offset;
+  bool from_region;             /* ref/unref are no-ops */
 };
 
 DBCC_CodePosition *dbcc_code_position_new   (DBCC_CodePosition *expanded_from,
@@ -189,16 +189,24 @@ dbcc_common_char_constant_value (DBCC_TargetEnvironment *target_env,
   return true;
 }
 
+/* For a pp-number that the tokenizer accepted:
+ * true unless it has a decimal point or an exponent.
+ * Integer suffixes (u, l, ll) are allowed.
+ */
 bool
 dbcc_common_number_is_integral  (size_t       length,
                                  const char  *str)
 {
-  while (length--)
+  if (length >= 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X'))
     {
-      if (*str < '0' || *str > '9')
-        return false;
-      str++;
+      for (size_t i = 2; i < length; i++)
+        if (str[i] == '.' || str[i] == 'p' || str[i] == 'P')
+          return false;
+      return true;
     }
+  for (size_t i = 0; i < length; i++)
+    if (str[i] == '.' || str[i] == 'e' || str[i] == 'E')
+      return false;
   return true;
 }
 
@@ -228,6 +236,11 @@ dbcc_common_number_parse_int64  (size_t       length,
   for (L = 0; L < length; L++)
     if (!is_alphanum (str[L]) && str[L] != '.')
       break;
+
+  /* strip the integer-suffix */
+  while (L > 0 && (str[L-1] == 'u' || str[L-1] == 'U'
+                || str[L-1] == 'l' || str[L-1] == 'L'))
+    L--;
   char *val = alloca (L + 1);
   memcpy (val, str, L);
   val[L] = 0;
@@ -291,7 +304,7 @@ dbcc_common_integer_get_info    (DBCC_TargetEnvironment *target_env,
     }
   if (str[0] == '0')
     {
-      if (str[1] == 'x')
+      if (length >= 2 && (str[1] == 'x' || str[1] == 'X'))
         {
           str += 2;
           length -= 2;
@@ -316,6 +329,8 @@ dbcc_common_integer_get_info    (DBCC_TargetEnvironment *target_env,
           for (L = 1; L < length; L++)
             if (!('0' <= str[L] && str[L] <= '7'))
               break;
+          str += L;
+          length -= L;
         }
       goto maybe_handle_suffix;
     }
@@ -338,15 +353,16 @@ dbcc_common_integer_get_info    (DBCC_TargetEnvironment *target_env,
     }
 
 maybe_handle_suffix:
+  *is_signed_out = true;
   if (length > 0 && (*str == 'u' || *str == 'U'))
     {
       *is_signed_out = false;
       length--;
       str++;
     }
-  else
-    *is_signed_out = true;
 
+  bool got_l = true;
+  *sizeof_int_type_out = target_env->sizeof_int;
   if (length >= 2
    && ((str[0] == 'l' && str[1] == 'l')
     || (str[0] == 'L' && str[1] == 'L')))
@@ -354,15 +370,24 @@ maybe_handle_suffix:
       length -= 2;
       str += 2;
       *sizeof_int_type_out = target_env->sizeof_long_long_int;
-      return true;
     }
-  if (length >= 1
+  else if (length >= 1
    && (str[0] == 'l' || str[0] == 'L'))
     {
-      length -= 2;
-      str += 2;
+      length -= 1;
+      str += 1;
       *sizeof_int_type_out = target_env->sizeof_long_int;
-      return true;
+    }
+  else
+    got_l = false;
+
+  /* "lu" and "llu" */
+  if (*is_signed_out && got_l && length > 0
+   && (*str == 'u' || *str == 'U'))
+    {
+      *is_signed_out = false;
+      length--;
+      str++;
     }
   if (length > 0)
     {
@@ -370,7 +395,6 @@ maybe_handle_suffix:
                                "integer constant followed by unexpected character %c", str[0]);
        return false;
     }
-  *sizeof_int_type_out = target_env->sizeof_int;
   return true;
 }
 
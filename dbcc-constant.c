@@ -1,13 +1,21 @@
 #include "dbcc.h"
 
+DBCC_Constant *
+dbcc_constant_alloc     (void)
+{
+  DBCC_Constant *c = dbcc_node_alloc (sizeof (DBCC_Constant));
+  c->from_region = dbcc_node_allocs_from_region ();
+  return c;
+}
+
 DBCC_Constant *
 dbcc_constant_new_value (DBCC_Type *type,
                          const void *optional_value)
 {
-  DBCC_Constant *c = malloc (sizeof (DBCC_Constant));
+  DBCC_Constant *c = dbcc_constant_alloc ();
   c->constant_type = DBCC_CONSTANT_TYPE_VALUE;
   size_t s = type->base.sizeof_instance;
-  c->v_value.data = malloc (s);
+  c->v_value.data = dbcc_node_alloc (s);
   if (optional_value != NULL)
     memcpy (c->v_value.data, optional_value, s);
   else
@@ -25,12 +33,12 @@ DBCC_Constant *
 dbcc_constant_copy      (DBCC_Type *type, 
                          DBCC_Constant *to_copy)
 {
-  DBCC_Constant *rv = malloc (sizeof (DBCC_Constant));
+  DBCC_Constant *rv = dbcc_constant_alloc ();
   rv->constant_type = to_copy->constant_type;
   switch (rv->constant_type)
     {
     case DBCC_CONSTANT_TYPE_VALUE:
-      rv->v_value.data = malloc (type->base.sizeof_instance);
+      rv->v_value.data = dbcc_node_alloc (type->base.sizeof_instance);
       memcpy (rv->v_value.data,
               to_copy->v_value.data,
               type->base.sizeof_instance);
@@ -59,7 +67,8 @@ dbcc_constant_free     (DBCC_Type *type,
   switch (to_free->constant_type)
     {
     case DBCC_CONSTANT_TYPE_VALUE:
-      free (to_free->v_value.data);
+      if (!to_free->from_region)
+        free (to_free->v_value.data);
       break;
     case DBCC_CONSTANT_TYPE_LINK_ADDRESS:
       //dbcc_symbol_unref (to_copy->v_link_address.name);
@@ -73,5 +82,6 @@ dbcc_constant_free     (DBCC_Type *type,
       dbcc_constant_free (type, to_free->v_offset.base);
       break;
     }
-  free(to_free);
+  if (!to_free->from_region)
+    free(to_free);
 }
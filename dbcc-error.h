@@ -41,8 +41,11 @@ typedef enum
   DBCC_ERROR_PREPROCESSOR_UNMATCHED_ENDIF,
   DBCC_ERROR_PREPROCESSOR_ELSE_NOT_ALLOWED,
   DBCC_ERROR_PREPROCESSOR_HASH_ERROR,
+  DBCC_ERROR_PREPROCESSOR_INCLUDE_NOT_FOUND,
+  DBCC_ERROR_PREPROCESSOR_INCLUDE_DEPTH,
 
   /* Token-level parsing error */
+  DBCC_ERROR_SYNTAX,
   DBCC_ERROR_TOO_MANY_TYPE_SPECIFIERS,
   DBCC_ERROR_CONFLICTING_QUALIFIERS,
   DBCC_ERROR_CONSTANT_REQUIRED,
@@ -111,6 +114,10 @@ typedef enum
 
   /* I/O errors */
   DBCC_ERROR_READING_FILE,
+  DBCC_ERROR_WRITING_FILE,
+  DBCC_ERROR_BAD_EDIT,
+  DBCC_ERROR_BAD_PROFILE,
+  DBCC_ERROR_BAD_AST_FILE,
 
   /* type-checking errors */
 
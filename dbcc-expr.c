@@ -45,11 +45,15 @@ dbcc_expr_is_lvalue (DBCC_Expr *expr)
     }
 }
 
+_Static_assert (sizeof (DBCC_Expr) <= DBCC_REGION_CACHE_LINE_SIZE,
+                "DBCC_Expr should fit in one cache line");
+
 static inline DBCC_Expr *
 expr_alloc (DBCC_Expr_Type t)
 {
-  DBCC_Expr *rv = calloc (sizeof (DBCC_Expr), 1);
+  DBCC_Expr *rv = DBCC_NODE_NEW0 (DBCC_Expr);
   rv->expr_type = t;
+  rv->base.from_region = dbcc_node_allocs_from_region ();
   return rv;
 }
 
@@ -295,9 +299,9 @@ handle_add (DBCC_Namespace *ns, DBCC_Expr *expr, DBCC_Error **error)
                                 btype, bexpr->base.constant->v_value.data))
             assert (0);
 
-          DBCC_Constant *result = malloc (sizeof (DBCC_Constant));
+          DBCC_Constant *result = dbcc_constant_alloc ();
           result->constant_type = DBCC_CONSTANT_TYPE_VALUE;
-          result->v_value.data = malloc (type->base.sizeof_instance);
+          result->v_value.data = dbcc_node_alloc (type->base.sizeof_instance);
           dbcc_typed_value_add (type, result->v_value.data,
                                 acasted, bcasted);
           expr->base.constant = result;
@@ -361,7 +365,7 @@ handle_subtract (DBCC_Namespace *ns, DBCC_Expr *expr, DBCC_Error **error)
           assert(bexpr->base.constant->constant_type == DBCC_CONSTANT_TYPE_VALUE);
           void *acasted = alloca (type->base.sizeof_instance);
           void *bcasted = alloca (type->base.sizeof_instance);
-          void *const_value = malloc (type->base.sizeof_instance);
+          void *const_value = dbcc_node_alloc (type->base.sizeof_instance);
 
           // cast both values
           if (!dbcc_cast_value (type, acasted,
@@ -441,7 +445,7 @@ handle_multiply (DBCC_Namespace *ns, DBCC_Expr *expr, DBCC_Error **error)
     {
       void *acasted = alloca (type->base.sizeof_instance);
       void *bcasted = alloca (type->base.sizeof_instance);
-      void *const_value = malloc (type->base.sizeof_instance);
+      void *const_value = dbcc_node_alloc (type->base.sizeof_instance);
 
       // cast both values
       if (!dbcc_cast_value (type, acasted,
@@ -452,7 +456,7 @@ handle_multiply (DBCC_Namespace *ns, DBCC_Expr *expr, DBCC_Error **error)
 
       dbcc_typed_value_multiply (type, const_value, acasted, bcasted);
 
-      expr->base.constant = malloc (sizeof (DBCC_Constant));
+      expr->base.constant = dbcc_constant_alloc ();
       expr->base.constant->constant_type = DBCC_CONSTANT_TYPE_VALUE;
       expr->base.constant->v_value.data = const_value;
       free (acasted);
@@ -495,7 +499,7 @@ handle_divide (DBCC_Namespace *ns, DBCC_Expr *expr, DBCC_Error **error)
       assert(bexpr->base.constant->constant_type == DBCC_CONSTANT_TYPE_VALUE);
       void *acasted = alloca (type->base.sizeof_instance);
       void *bcasted = alloca (type->base.sizeof_instance);
-      void *const_value = malloc (type->base.sizeof_instance);
+      void *const_value = dbcc_node_alloc (type->base.sizeof_instance);
 
       // cast both values
       if (!dbcc_cast_value (type, acasted,
@@ -506,7 +510,7 @@ handle_divide (DBCC_Namespace *ns, DBCC_Expr *expr, DBCC_Error **error)
 
       dbcc_typed_value_multiply (type, const_value, acasted, bcasted);
 
-      expr->base.constant = malloc (sizeof (DBCC_Constant));
+      expr->base.constant = dbcc_constant_alloc ();
       expr->base.constant->constant_type = DBCC_CONSTANT_TYPE_VALUE;
       expr->base.constant->v_value.data = const_value;
     }
@@ -547,7 +551,7 @@ handle_remainder (DBCC_Namespace *ns, DBCC_Expr *expr, DBCC_Error **error)
       assert(bexpr->base.constant->constant_type == DBCC_CONSTANT_TYPE_VALUE);
       void *acasted = alloca (type->base.sizeof_instance);
       void *bcasted = alloca (type->base.sizeof_instance);
-      void *const_value = malloc (type->base.sizeof_instance);
+      void *const_value = dbcc_node_alloc (type->base.sizeof_instance);
 
       // cast both values
       if (!dbcc_cast_value (type, acasted,
@@ -558,7 +562,7 @@ handle_remainder (DBCC_Namespace *ns, DBCC_Expr *expr, DBCC_Error **error)
 
       dbcc_typed_value_multiply (type, const_value, acasted, bcasted);
 
-      expr->base.constant = malloc (sizeof (DBCC_Constant));
+      expr->base.constant = dbcc_constant_alloc ();
       expr->base.constant->constant_type = DBCC_CONSTANT_TYPE_VALUE;
       expr->base.constant->v_value.data = const_value;
       free (acasted);
@@ -614,13 +618,13 @@ handle_relational_operator (DBCC_Namespace *ns,
           void *bcasted = alloca (cmp_type->base.sizeof_instance);
           dbcc_cast_value (cmp_type, acasted, atype, aexpr->base.constant->v_value.data);
           dbcc_cast_value (cmp_type, bcasted, btype, bexpr->base.constant->v_value.data);
-          void *res = malloc (ns->target_env->sizeof_int);
+          void *res = dbcc_node_alloc (ns->target_env->sizeof_int);
           dbcc_typed_value_compare (ns,
                                     cmp_type,
                                     expr->v_binary.op,
                                     res, acasted, bcasted);
 
-          expr->base.constant = malloc (sizeof (DBCC_Constant));
+          expr->base.constant = dbcc_constant_alloc ();
           expr->base.constant->constant_type = DBCC_CONSTANT_TYPE_VALUE;
           expr->base.constant->v_value.data = res;
           free (acasted);
@@ -691,13 +695,13 @@ handle_equality_operator   (DBCC_Namespace *ns,
           void *bcasted = alloca (cmp_type->base.sizeof_instance);
           dbcc_cast_value (cmp_type, acasted, atype, aexpr->base.constant->v_value.data);
           dbcc_cast_value (cmp_type, bcasted, btype, bexpr->base.constant->v_value.data);
-          void *res = malloc (ns->target_env->sizeof_int);
+          void *res = dbcc_node_alloc (ns->target_env->sizeof_int);
           dbcc_typed_value_compare (ns,
                                     cmp_type,
                                     expr->v_binary.op,
                                     res, acasted, bcasted);
 
-          expr->base.constant = malloc (sizeof (DBCC_Constant));
+          expr->base.constant = dbcc_constant_alloc ();
           expr->base.constant->constant_type = DBCC_CONSTANT_TYPE_VALUE;
           expr->base.constant->v_value.data = res;
           free (acasted);
@@ -778,7 +782,7 @@ handle_shift_operator   (DBCC_Namespace *ns,
       const void *bc_orig = b->base.constant->v_value.data;
       void *a_casted_to_rvtype = alloca (rv_type->base.sizeof_instance);
       void *b_casted_to_rvtype = alloca (rv_type->base.sizeof_instance);
-      void *rv_value = alloca (rv_type->base.sizeof_instance);
+      void *rv_value = dbcc_node_alloc (rv_type->base.sizeof_instance);
       dbcc_cast_value (rv_type, a_casted_to_rvtype, a->base.value_type, ac_orig);
       dbcc_cast_value (rv_type, b_casted_to_rvtype, b->base.value_type, bc_orig);
       switch (expr->v_binary.op)
@@ -797,7 +801,7 @@ handle_shift_operator   (DBCC_Namespace *ns,
           assert(0);
         }
 
-      expr->base.constant = malloc (sizeof (DBCC_Constant));
+      expr->base.constant = dbcc_constant_alloc ();
       expr->base.constant->constant_type = DBCC_CONSTANT_TYPE_VALUE;
       expr->base.constant->v_value.data = rv_value;
       free (a_casted_to_rvtype);
@@ -853,9 +857,9 @@ handle_logical_op       (DBCC_Namespace *ns,
           int value = expr->v_binary.op == DBCC_BINARY_OPERATOR_LOGICAL_AND
                     ? (a_truth && b_truth)
                     : (a_truth || b_truth);
-          expr->base.constant = malloc (sizeof (DBCC_Constant));
+          expr->base.constant = dbcc_constant_alloc ();
           expr->base.constant->constant_type = DBCC_CONSTANT_TYPE_VALUE;
-          expr->base.constant->v_value.data = malloc (ns->target_env->sizeof_int);
+          expr->base.constant->v_value.data = dbcc_node_alloc (ns->target_env->sizeof_int);
           dbcc_typed_value_set_int64 (expr->base.value_type,
                                       expr->base.constant->v_value.data,
                                       value);
@@ -899,7 +903,7 @@ handle_bitwise_op       (DBCC_Namespace *ns,
     {
       void *acasted = alloca (type->base.sizeof_instance);
       void *bcasted = alloca (type->base.sizeof_instance);
-      void *const_value = malloc (type->base.sizeof_instance);
+      void *const_value = dbcc_node_alloc (type->base.sizeof_instance);
 
       // cast both values
       if (!dbcc_cast_value (type, acasted,
@@ -924,7 +928,7 @@ handle_bitwise_op       (DBCC_Namespace *ns,
           assert(0);
         }
 
-      expr->base.constant = malloc (sizeof (DBCC_Constant));
+      expr->base.constant = dbcc_constant_alloc ();
       expr->base.constant->constant_type = DBCC_CONSTANT_TYPE_VALUE;
       expr->base.constant->v_value.data = const_value;
     }
@@ -1746,9 +1750,9 @@ do_symbol_type_inference (DBCC_Namespace     *ns,
       id->v_identifier.v_enum_value.enum_value = entry.v_enum_value.enum_value;
 
       // setup constant value
-      id->base.constant = malloc (sizeof (DBCC_Constant));
+      id->base.constant = dbcc_constant_alloc ();
       id->base.constant->constant_type = DBCC_CONSTANT_TYPE_VALUE;
-      id->base.constant->v_value.data = malloc (etype->base.sizeof_instance);
+      id->base.constant->v_value.data = dbcc_node_alloc (etype->base.sizeof_instance);
       dbcc_typed_value_set_int64 (etype, id->base.constant->v_value.data,
                                   entry.v_enum_value.enum_value->value);
       return true;
@@ -1786,9 +1790,9 @@ dbcc_expr_new_int_constant     (DBCC_Type          *type,
 {
   DBCC_Expr *rv = expr_alloc (DBCC_EXPR_TYPE_CONSTANT);
   rv->base.value_type = type;
-  rv->base.constant = malloc (sizeof (DBCC_Constant));
+  rv->base.constant = dbcc_constant_alloc ();
   rv->base.constant->constant_type = DBCC_CONSTANT_TYPE_VALUE;
-  rv->base.constant->v_value.data = malloc (type->base.sizeof_instance);
+  rv->base.constant->v_value.data = dbcc_node_alloc (type->base.sizeof_instance);
   dbcc_typed_value_set_int64 (type, rv->base.constant->v_value.data, value);
   return rv;
 }
@@ -1799,11 +1803,21 @@ dbcc_expr_new_string_constant  (DBCC_Namespace    *ns,
 {
   DBCC_Expr *expr = expr_alloc (DBCC_EXPR_TYPE_CONSTANT);
   DBCC_Address *address;
-  address = dbcc_namespace_global_allocate_constant0
-                  (ns, constant->length, (const uint8_t *) constant->str);
+  DBCC_Type *elt_type;
+  address = dbcc_namespace_global_allocate_string (ns, constant);
+  if (constant->is_wchar)
+    elt_type = dbcc_namespace_get_integer_type (ns,
+                                                ns->target_env->is_wchar_signed,
+                                                ns->target_env->sizeof_wchar);
+  else if (constant->sizeof_elt <= 1)
+    elt_type = dbcc_namespace_get_char_type (ns);
+  else
+    elt_type = dbcc_namespace_get_integer_type (ns, false, constant->sizeof_elt);
+
+  // 6.4.5p6: the array has room for the terminating NUL.
   expr->base.value_type = dbcc_type_new_array (ns->target_env,
-                                 constant->length,
-                                 dbcc_namespace_get_char_type(ns));
+                                 constant->length + 1,
+                                 elt_type);
   expr->v_constant_address.address = address;
   return expr;
 }
@@ -1816,9 +1830,9 @@ dbcc_expr_new_float_constant   (DBCC_Namespace     *global_ns,
   DBCC_Expr *expr = expr_alloc (DBCC_EXPR_TYPE_CONSTANT);
   DBCC_Type *type = dbcc_namespace_get_floating_point_type (global_ns, float_type);
   expr->base.value_type = type;
-  expr->base.constant = malloc (sizeof (DBCC_Constant));
+  expr->base.constant = dbcc_constant_alloc ();
   expr->base.constant->constant_type = DBCC_CONSTANT_TYPE_VALUE;
-  expr->base.constant->v_value.data = malloc (type->base.sizeof_instance);
+  expr->base.constant->v_value.data = dbcc_node_alloc (type->base.sizeof_instance);
   dbcc_typed_value_set_long_double (type, expr->base.constant->v_value.data, value);
   return expr;
 }
@@ -1831,9 +1845,9 @@ dbcc_expr_new_char_constant    (DBCC_Type          *type,
 {
   DBCC_Expr *expr = expr_alloc (DBCC_EXPR_TYPE_CONSTANT);
   expr->base.value_type = type;
-  expr->base.constant = malloc (sizeof (DBCC_Constant));
+  expr->base.constant = dbcc_constant_alloc ();
   expr->base.constant->constant_type = DBCC_CONSTANT_TYPE_VALUE;
-  expr->base.constant->v_value.data = malloc (type->base.sizeof_instance);
+  expr->base.constant->v_value.data = dbcc_node_alloc (type->base.sizeof_instance);
   dbcc_typed_value_set_int64 (type, expr->base.constant->v_value.data, value);
   return expr;
 }
@@ -1845,9 +1859,9 @@ dbcc_expr_new_enum_constant (DBCC_Type       *type,
   // ASSERT THAT 'type' is compat with 'enum_value'
   DBCC_Expr *expr = expr_alloc (DBCC_EXPR_TYPE_CONSTANT);
   expr->base.value_type = type;
-  expr->base.constant = malloc (sizeof (DBCC_Constant));
+  expr->base.constant = dbcc_constant_alloc ();
   expr->base.constant->constant_type = DBCC_CONSTANT_TYPE_VALUE;
-  expr->base.constant->v_value.data = malloc (type->base.sizeof_instance);
+  expr->base.constant->v_value.data = dbcc_node_alloc (type->base.sizeof_instance);
   dbcc_typed_value_set_int64 (type, expr->base.constant->v_value.data, enum_value->value);
   return expr;
 }
@@ -1882,7 +1896,7 @@ do_unary_operator_type_inference (DBCC_Namespace *ns,
        && expr->v_unary.base.constant->constant_type == DBCC_CONSTANT_TYPE_VALUE)
         {
           const void *in = sub->base.constant->v_value.data;
-          void *out = malloc (subtype->base.sizeof_instance);
+          void *out = dbcc_node_alloc (subtype->base.sizeof_instance);
            if (expr->v_unary.op == DBCC_UNARY_OPERATOR_NOOP)
              {
                /* "p2: The result of the unary + operator is the value
@@ -1917,9 +1931,9 @@ do_unary_operator_type_inference (DBCC_Namespace *ns,
           DBCC_TriState v = dbcc_typed_value_scalar_to_tristate (subtype, sub->base.constant);
           if (v != DBCC_MAYBE)
             {
-              expr->base.constant = malloc (sizeof (DBCC_Constant));
+              expr->base.constant = dbcc_constant_alloc ();
               expr->base.constant->constant_type = DBCC_CONSTANT_TYPE_VALUE;
-              expr->base.constant->v_value.data = malloc (expr->base.value_type->base.sizeof_instance);
+              expr->base.constant->v_value.data = dbcc_node_alloc (expr->base.value_type->base.sizeof_instance);
               dbcc_typed_value_set_int64 (expr->base.value_type,
                                           expr->base.constant->v_value.data,
                                           v);
@@ -1940,8 +1954,8 @@ do_unary_operator_type_inference (DBCC_Namespace *ns,
        && sub->base.constant->constant_type == DBCC_CONSTANT_TYPE_VALUE)
         {
           const void *in = sub->base.constant->v_value.data;
-          void *out = malloc (subtype->base.sizeof_instance);
-          expr->base.constant = malloc (sizeof (DBCC_Constant));
+          void *out = dbcc_node_alloc (subtype->base.sizeof_instance);
+          expr->base.constant = dbcc_constant_alloc ();
           expr->base.constant->constant_type = DBCC_CONSTANT_TYPE_VALUE;
           expr->base.constant->v_value.data = out;
           dbcc_typed_value_bitwise_not (expr->base.value_type, out, in);
@@ -2267,9 +2281,9 @@ do_ternary_operator_type_inference (DBCC_Namespace *ns,
           if (vexpr->base.constant != NULL
            && vexpr->base.constant->constant_type == DBCC_CONSTANT_TYPE_VALUE)
             {
-              expr->base.constant = malloc (sizeof (DBCC_Constant));
+              expr->base.constant = dbcc_constant_alloc ();
               expr->base.constant->constant_type = DBCC_CONSTANT_TYPE_VALUE;
-              expr->base.constant->v_value.data = malloc (type->base.sizeof_instance);
+              expr->base.constant->v_value.data = dbcc_node_alloc (type->base.sizeof_instance);
               dbcc_cast_value (type,
                                expr->base.constant->v_value.data,
                                vexpr->base.value_type,
@@ -2774,5 +2788,6 @@ dbcc_expr_destroy (DBCC_Expr *expr)
     dbcc_constant_free (expr->base.value_type, expr->base.constant);
   if (expr->base.value_type != NULL)
     dbcc_type_unref (expr->base.value_type);
-  free (expr);
+  if (!expr->base.from_region)
+    free (expr);
 }
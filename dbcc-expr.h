@@ -45,11 +45,14 @@ typedef enum
 struct DBCC_Expr_Base
 {
   DBCC_Expr_Type type;
+
+  /* the flags fill the padding after 'type' */
+  unsigned types_inferred : 1;
+  unsigned from_region : 1;
+
   DBCC_Type *value_type;
   DBCC_Constant *constant;
   DBCC_CodePosition *code_position;
-
-  unsigned types_inferred : 1;
 };
 
 struct DBCC_BinaryOperatorExpr
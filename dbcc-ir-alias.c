@@ -0,0 +1,423 @@
+#include "dbcc.h"
+
+/* --- Provenance ---
+ *
+ * The lattice, bottom to top:
+ *
+ *    UNDEF           no definition seen (yet)
+ *    NONE            not derived from any parameter:  integers
+ *    BASE(p, off)    entry value of parameter 'p' plus 'off' bytes
+ *    BASE(p, ?)      ... plus some offset
+ *    UNKNOWN         may point anywhere
+ *
+ * NONE and BASE values join to UNKNOWN.
+ */
+typedef enum
+{
+  PROV_UNDEF,
+  PROV_NONE,
+  PROV_BASE,
+  PROV_UNKNOWN
+} ProvKind;
+
+typedef struct
+{
+  ProvKind kind;
+  bool offset_known;
+  unsigned base;
+  int64_t offset;
+} Provenance;
+
+struct DBCC_AliasInfo
+{
+  DBCC_Function *function;
+  Provenance *regs;
+};
+
+static const Provenance prov_undef = { PROV_UNDEF, false, 0, 0 };
+static const Provenance prov_none = { PROV_NONE, false, 0, 0 };
+static const Provenance prov_unknown = { PROV_UNKNOWN, false, 0, 0 };
+
+static Provenance
+prov_base (unsigned base, bool offset_known, int64_t offset)
+{
+  Provenance rv = { PROV_BASE, offset_known, base, offset_known ? offset : 0 };
+  return rv;
+}
+
+static Provenance
+prov_join (Provenance a, Provenance b)
+{
+  if (a.kind == PROV_UNDEF)
+    return b;
+  if (b.kind == PROV_UNDEF)
+    return a;
+  if (a.kind == PROV_UNKNOWN || b.kind == PROV_UNKNOWN)
+    return prov_unknown;
+  if (a.kind == PROV_NONE && b.kind == PROV_NONE)
+    return prov_none;
+  if (a.kind == PROV_BASE && b.kind == PROV_BASE && a.base == b.base)
+    return prov_base (a.base,
+                      a.offset_known && b.offset_known && a.offset == b.offset,
+                      a.offset);
+  return prov_unknown;
+}
+
+static bool
+prov_equal (Provenance a, Provenance b)
+{
+  return a.kind == b.kind
+      && a.offset_known == b.offset_known
+      && a.base == b.base
+      && a.offset == b.offset;
+}
+
+/* The provenance of a value read from 'loc'. */
+static Provenance
+read_prov (DBCC_AliasInfo *info, const DBCC_Location *loc)
+{
+  switch (loc->type)
+    {
+    case DBCC_LOCATION_REG:
+      return info->regs[loc->info.v_reg];
+    case DBCC_LOCATION_PTR:
+      return prov_unknown;              /* a pointer loaded from memory */
+    case DBCC_LOCATION_IMMED:
+      return prov_none;
+    }
+  assert (0);
+  return prov_unknown;
+}
+
+/* Integer operations on pointers (other than + and -) launder them. */
+static Provenance
+arith_prov (Provenance a, Provenance b)
+{
+  if (a.kind == PROV_UNDEF || b.kind == PROV_UNDEF)
+    return prov_undef;
+  if (a.kind == PROV_NONE && b.kind == PROV_NONE)
+    return prov_none;
+  return prov_unknown;
+}
+
+static Provenance
+binary_prov (DBCC_AliasInfo *info, const DBCC_IR_Binary *b)
+{
+  Provenance a = read_prov (info, &b->source1);
+  Provenance c = read_prov (info, &b->source2);
+  bool c_immed = b->source2.type == DBCC_LOCATION_IMMED;
+  int64_t c_value = c_immed ? dbcc_location_get_immed (&b->source2) : 0;
+  switch (b->op)
+    {
+    case DBCC_BINARY_OPERATOR_ADD:
+      if (a.kind == PROV_NONE && c.kind == PROV_BASE)
+        {
+          /* int + ptr */
+          bool a_immed = b->source1.type == DBCC_LOCATION_IMMED;
+          int64_t a_value = a_immed ? dbcc_location_get_immed (&b->source1) : 0;
+          return prov_base (c.base, a_immed && c.offset_known, c.offset + a_value);
+        }
+      /* fall through */
+    case DBCC_BINARY_OPERATOR_SUB:
+      if (a.kind == PROV_BASE && c.kind == PROV_NONE)
+        {
+          int64_t delta = b->op == DBCC_BINARY_OPERATOR_ADD ? c_value : -c_value;
+          return prov_base (a.base, c_immed && a.offset_known, a.offset + delta);
+        }
+      if (b->op == DBCC_BINARY_OPERATOR_SUB
+       && a.kind == PROV_BASE && c.kind == PROV_BASE)
+        return prov_none;               /* ptrdiff */
+      return arith_prov (a, c);
+    default:
+      return arith_prov (a, c);
+    }
+}
+
+static bool
+define_reg (DBCC_AliasInfo *info, const DBCC_Location *dest, Provenance prov)
+{
+  if (dest->type != DBCC_LOCATION_REG || prov.kind == PROV_UNDEF)
+    return false;
+  Provenance *p = info->regs + dest->info.v_reg;
+  Provenance joined = prov_join (*p, prov);
+  if (prov_equal (joined, *p))
+    return false;
+  *p = joined;
+  return true;
+}
+
+/* One pass over all the definitions;  returns whether anything changed. */
+static bool
+propagate (DBCC_AliasInfo *info)
+{
+  DBCC_Function *f = info->function;
+  bool changed = false;
+  for (unsigned i = 0; i < f->n_blocks; i++)
+    for (DBCC_IR *ir = f->blocks[i]->first; ir != NULL; ir = ir->next)
+      switch (ir->type)
+        {
+        case DBCC_IR_TYPE_UNARY:
+          {
+            DBCC_IR_Unary *u = (DBCC_IR_Unary *) ir;
+            Provenance src = read_prov (info, &u->source);
+            Provenance p;
+            if (u->op == DBCC_UNARY_OPERATOR_NOOP)
+              p = src;
+            else if (u->op == DBCC_UNARY_OPERATOR_REFERENCE)
+              p = prov_unknown;
+            else
+              p = arith_prov (src, prov_none);
+            changed |= define_reg (info, &u->dest, p);
+            break;
+          }
+        case DBCC_IR_TYPE_BINARY:
+          {
+            DBCC_IR_Binary *b = (DBCC_IR_Binary *) ir;
+            changed |= define_reg (info, &b->dest, binary_prov (info, b));
+            break;
+          }
+        case DBCC_IR_TYPE_VECTOR_BINARY:
+          {
+            DBCC_IR_VectorBinary *v = (DBCC_IR_VectorBinary *) ir;
+            changed |= define_reg (info, &v->dest, prov_unknown);
+            break;
+          }
+        case DBCC_IR_TYPE_CALL_BY_NAME:
+          {
+            DBCC_IR_CallByName *c = (DBCC_IR_CallByName *) ir;
+            if (c->has_result)
+              changed |= define_reg (info, &c->result, prov_unknown);
+            break;
+          }
+        case DBCC_IR_TYPE_CALL_BY_POINTER:
+          {
+            DBCC_IR_CallByPointer *c = (DBCC_IR_CallByPointer *) ir;
+            if (c->has_result)
+              changed |= define_reg (info, &c->result, prov_unknown);
+            break;
+          }
+        default:
+          break;
+        }
+  return changed;
+}
+
+DBCC_AliasInfo *
+dbcc_alias_info_new     (DBCC_Function       *function)
+{
+  DBCC_AliasInfo *info = DBCC_NEW (DBCC_AliasInfo);
+  info->function = function;
+  info->regs = DBCC_NEW_ARRAY (function->n_regs + 1, Provenance);
+  for (unsigned r = 0; r < function->n_regs; r++)
+    info->regs[r] = r < function->n_params ? prov_base (r, true, 0) : prov_undef;
+
+  /* Terminates:  each register can only move up the lattice. */
+  while (propagate (info))
+    ;
+  return info;
+}
+
+static bool
+is_restrict_base (DBCC_AliasInfo *info, Provenance p)
+{
+  return p.kind == PROV_BASE
+      && (info->function->param_flags[p.base] & DBCC_FUNCTION_PARAM_RESTRICT) != 0;
+}
+
+/* Whether 'p' is known not to be based on the restrict parameter of 'r'. */
+static bool
+excluded_by_restrict (DBCC_AliasInfo *info, Provenance r, Provenance p)
+{
+  if (!is_restrict_base (info, r))
+    return false;
+  if (p.kind == PROV_NONE)
+    return true;
+  return p.kind == PROV_BASE && p.base != r.base;
+}
+
+DBCC_AliasResult
+dbcc_alias_info_query   (DBCC_AliasInfo      *info,
+                         const DBCC_Location *a,
+                         const DBCC_Location *b)
+{
+  if (a->type == DBCC_LOCATION_IMMED || b->type == DBCC_LOCATION_IMMED)
+    return DBCC_ALIAS_NO;
+  if (a->type == DBCC_LOCATION_REG || b->type == DBCC_LOCATION_REG)
+    {
+      /* registers have no address */
+      if (a->type == b->type && a->info.v_reg == b->info.v_reg)
+        return DBCC_ALIAS_MUST;
+      return DBCC_ALIAS_NO;
+    }
+
+  if (a->info.v_ptr == b->info.v_ptr)
+    return a->width == b->width ? DBCC_ALIAS_MUST : DBCC_ALIAS_MAY;
+
+  Provenance pa = info->regs[a->info.v_ptr];
+  Provenance pb = info->regs[b->info.v_ptr];
+  if (pa.kind == PROV_BASE && pb.kind == PROV_BASE && pa.base == pb.base)
+    {
+      if (!pa.offset_known || !pb.offset_known)
+        return DBCC_ALIAS_MAY;
+      int64_t a_end = pa.offset + (1 << a->width);
+      int64_t b_end = pb.offset + (1 << b->width);
+      if (a_end <= pb.offset || b_end <= pa.offset)
+        return DBCC_ALIAS_NO;
+      if (pa.offset == pb.offset && a->width == b->width)
+        return DBCC_ALIAS_MUST;
+      return DBCC_ALIAS_MAY;
+    }
+  if (excluded_by_restrict (info, pa, pb)
+   || excluded_by_restrict (info, pb, pa))
+    return DBCC_ALIAS_NO;
+  return DBCC_ALIAS_MAY;
+}
+
+void
+dbcc_alias_info_destroy (DBCC_AliasInfo      *info)
+{
+  free (info->regs);
+  free (info);
+}
+
+/* --- Load forwarding --- */
+typedef struct
+{
+  DBCC_Location mem;
+  unsigned value_reg;
+} AvailableValue;
+
+typedef struct
+{
+  size_t n;
+  size_t alloced;
+  AvailableValue *values;
+} AvailableSet;
+
+static void
+available_add (AvailableSet *set, const DBCC_Location *mem, unsigned value_reg)
+{
+  if (set->n == set->alloced)
+    {
+      set->alloced = set->alloced ? set->alloced * 2 : 16;
+      set->values = realloc (set->values, sizeof (AvailableValue) * set->alloced);
+    }
+  set->values[set->n].mem = *mem;
+  set->values[set->n].value_reg = value_reg;
+  set->n++;
+}
+
+/* A register was written:  forget values that used it. */
+static void
+available_kill_reg (AvailableSet *set, const DBCC_Location *dest)
+{
+  if (dest->type != DBCC_LOCATION_REG)
+    return;
+  unsigned reg = dest->info.v_reg;
+  size_t o = 0;
+  for (size_t i = 0; i < set->n; i++)
+    if (set->values[i].mem.info.v_ptr != reg && set->values[i].value_reg != reg)
+      set->values[o++] = set->values[i];
+  set->n = o;
+}
+
+/* Memory was written:  forget values it may have overwritten. */
+static void
+available_kill_mem (AvailableSet *set, DBCC_AliasInfo *info,
+                    const DBCC_Location *dest)
+{
+  if (dest->type != DBCC_LOCATION_PTR)
+    return;
+  size_t o = 0;
+  for (size_t i = 0; i < set->n; i++)
+    if (dbcc_alias_info_query (info, &set->values[i].mem, dest) == DBCC_ALIAS_NO)
+      set->values[o++] = set->values[i];
+  set->n = o;
+}
+
+static void
+forward_loads_in_block (DBCC_BB        *bb,
+                        DBCC_AliasInfo *info,
+                        AvailableSet   *set,
+                        size_t         *n_forwarded)
+{
+  set->n = 0;
+  DBCC_IR *next;
+  for (DBCC_IR *ir = bb->first; ir != NULL; ir = next)
+    {
+      next = ir->next;
+      switch (ir->type)
+        {
+        case DBCC_IR_TYPE_UNARY:
+          {
+            DBCC_IR_Unary *u = (DBCC_IR_Unary *) ir;
+            bool is_move = u->op == DBCC_UNARY_OPERATOR_NOOP;
+            if (is_move
+             && u->dest.type == DBCC_LOCATION_REG
+             && u->source.type == DBCC_LOCATION_PTR)
+              {
+                DBCC_Location mem = u->source;
+                for (size_t i = 0; i < set->n; i++)
+                  if (dbcc_alias_info_query (info, &set->values[i].mem, &mem)
+                      == DBCC_ALIAS_MUST)
+                    {
+                      DBCC_Location src = dbcc_location_reg (mem.width,
+                                                             set->values[i].value_reg);
+                      DBCC_IR *move = dbcc_ir_new_move (u->dest, src);
+                      dbcc_bb_insert_before (bb, ir, move);
+                      dbcc_bb_remove (bb, ir);
+                      dbcc_ir_free (ir);
+                      u = (DBCC_IR_Unary *) move;
+                      *n_forwarded += 1;
+                      break;
+                    }
+                available_kill_reg (set, &u->dest);
+                if (u->dest.info.v_reg != mem.info.v_ptr)
+                  available_add (set, &mem, u->dest.info.v_reg);
+                break;
+              }
+            available_kill_reg (set, &u->dest);
+            available_kill_mem (set, info, &u->dest);
+            if (is_move
+             && u->dest.type == DBCC_LOCATION_PTR
+             && u->source.type == DBCC_LOCATION_REG)
+              available_add (set, &u->dest, u->source.info.v_reg);
+            break;
+          }
+        case DBCC_IR_TYPE_BINARY:
+          {
+            DBCC_IR_Binary *b = (DBCC_IR_Binary *) ir;
+            available_kill_reg (set, &b->dest);
+            available_kill_mem (set, info, &b->dest);
+            break;
+          }
+        case DBCC_IR_TYPE_VECTOR_BINARY:
+          {
+            DBCC_IR_VectorBinary *v = (DBCC_IR_VectorBinary *) ir;
+            available_kill_reg (set, &v->dest);
+            available_kill_mem (set, info, &v->dest);
+            break;
+          }
+        case DBCC_IR_TYPE_CALL_BY_NAME:
+        case DBCC_IR_TYPE_CALL_BY_POINTER:
+          /* the callee may write any memory it can reach */
+          set->n = 0;
+          break;
+        default:
+          break;
+        }
+    }
+}
+
+size_t
+dbcc_function_forward_loads   (DBCC_Function               *function)
+{
+  DBCC_AliasInfo *info = dbcc_alias_info_new (function);
+  AvailableSet set = { 0, 0, NULL };
+  size_t rv = 0;
+  for (unsigned i = 0; i < function->n_blocks; i++)
+    forward_loads_in_block (function->blocks[i], info, &set, &rv);
+  free (set.values);
+  dbcc_alias_info_destroy (info);
+  return rv;
+}
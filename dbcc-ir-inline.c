@@ -0,0 +1,502 @@
+#include "dbcc.h"
+
+/* Cost model.
+ *
+ * A function's inline cost approximates the code it adds at each
+ * call site:  one per instruction, with calls weighted to reflect
+ * their argument setup and the registers they clobber.  Returns are
+ * free, since they become jumps to the code after the call.
+ *
+ * Each immediate argument is a discount:  once the callee's
+ * parameter is a known constant, later folding usually removes
+ * a few of the instructions that use it.
+ */
+#define COST_INSTRUCTION         1
+#define COST_CALL                5
+#define COST_RETURN              0
+#define IMMEDIATE_ARG_BONUS      3
+
+static unsigned
+instruction_cost (const DBCC_IR *ir)
+{
+  switch (ir->type)
+    {
+    case DBCC_IR_TYPE_CALL_BY_NAME:
+    case DBCC_IR_TYPE_CALL_BY_POINTER:
+      return COST_CALL;
+    case DBCC_IR_TYPE_RETURN_VOID:
+    case DBCC_IR_TYPE_RETURN_REG:
+      return COST_RETURN;
+    default:
+      return COST_INSTRUCTION;
+    }
+}
+
+unsigned
+dbcc_function_get_inline_cost (DBCC_Function *function)
+{
+  unsigned rv = 0;
+  for (unsigned i = 0; i < function->n_blocks; i++)
+    for (DBCC_IR *ir = function->blocks[i]->first; ir != NULL; ir = ir->next)
+      rv += instruction_cost (ir);
+  return rv;
+}
+
+/* --- The call graph --- */
+typedef struct
+{
+  DBCC_Function *function;
+  size_t n_call_sites;          /* calls to this function */
+  unsigned scc;                 /* strongly-connected component */
+  bool recursive;               /* in a cycle, possibly of length 1 */
+  bool reachable;
+
+  /* Tarjan */
+  int index, lowlink;
+  bool on_stack;
+} FunctionInfo;
+
+typedef struct
+{
+  DBCC_IR_Module *module;
+  FunctionInfo *infos;
+  DBCC_PtrTable info_by_function;
+
+  /* Tarjan */
+  int next_index;
+  unsigned n_sccs;
+  FunctionInfo **stack;
+  size_t stack_size;
+  FunctionInfo **order;         /* callees before callers */
+  size_t n_order;
+} CallGraph;
+
+static FunctionInfo *
+get_callee_info (CallGraph *graph, const DBCC_IR *ir)
+{
+  if (ir->type != DBCC_IR_TYPE_CALL_BY_NAME)
+    return NULL;
+  const DBCC_IR_CallByName *call = (const DBCC_IR_CallByName *) ir;
+  DBCC_Function *callee = dbcc_ir_module_lookup (graph->module, call->name);
+  if (callee == NULL)
+    return NULL;
+  return dbcc_ptr_table_lookup_value (&graph->info_by_function, callee);
+}
+
+#define FOREACH_CALLEE(graph, function, callee_info, code)                 \
+  for (unsigned _b = 0; _b < (function)->n_blocks; _b++)                   \
+    for (DBCC_IR *_ir = (function)->blocks[_b]->first; _ir; _ir = _ir->next) \
+      {                                                                    \
+        FunctionInfo *callee_info = get_callee_info ((graph), _ir);        \
+        if (callee_info != NULL)                                           \
+          { code; }                                                        \
+      }
+
+static void
+strong_connect (CallGraph *graph, FunctionInfo *v)
+{
+  v->index = v->lowlink = graph->next_index++;
+  graph->stack[graph->stack_size++] = v;
+  v->on_stack = true;
+
+  FOREACH_CALLEE (graph, v->function, w, {
+    if (w == v)
+      v->recursive = true;
+    if (w->index < 0)
+      {
+        strong_connect (graph, w);
+        if (w->lowlink < v->lowlink)
+          v->lowlink = w->lowlink;
+      }
+    else if (w->on_stack && w->index < v->lowlink)
+      v->lowlink = w->index;
+  });
+
+  if (v->lowlink == v->index)
+    {
+      /* pop the component;  components are completed callees-first */
+      unsigned scc = graph->n_sccs++;
+      size_t start = graph->stack_size;
+      do
+        start--;
+      while (graph->stack[start] != v);
+      bool cycle = graph->stack_size - start > 1;
+      for (size_t i = start; i < graph->stack_size; i++)
+        {
+          FunctionInfo *w = graph->stack[i];
+          w->on_stack = false;
+          w->scc = scc;
+          if (cycle)
+            w->recursive = true;
+          graph->order[graph->n_order++] = w;
+        }
+      graph->stack_size = start;
+    }
+}
+
+static void
+call_graph_init (CallGraph *graph, DBCC_IR_Module *module)
+{
+  size_t n = module->n_functions;
+  graph->module = module;
+  graph->infos = DBCC_NEW_ARRAY (n, FunctionInfo);
+  dbcc_ptr_table_init (&graph->info_by_function);
+  for (size_t i = 0; i < n; i++)
+    {
+      FunctionInfo *info = graph->infos + i;
+      info->function = module->functions[i];
+      info->n_call_sites = 0;
+      info->scc = 0;
+      info->recursive = false;
+      info->reachable = false;
+      info->index = -1;
+      info->lowlink = -1;
+      info->on_stack = false;
+      dbcc_ptr_table_set (&graph->info_by_function, info->function, info);
+    }
+  for (size_t i = 0; i < n; i++)
+    FOREACH_CALLEE (graph, module->functions[i], callee, callee->n_call_sites++);
+
+  graph->next_index = 0;
+  graph->n_sccs = 0;
+  graph->stack = DBCC_NEW_ARRAY (n, FunctionInfo *);
+  graph->stack_size = 0;
+  graph->order = DBCC_NEW_ARRAY (n, FunctionInfo *);
+  graph->n_order = 0;
+  for (size_t i = 0; i < n; i++)
+    if (graph->infos[i].index < 0)
+      strong_connect (graph, graph->infos + i);
+}
+
+static void
+call_graph_clear (CallGraph *graph)
+{
+  free (graph->infos);
+  free (graph->stack);
+  free (graph->order);
+  dbcc_ptr_table_clear (&graph->info_by_function);
+}
+
+/* --- Inlining one call site --- */
+static void
+remap_location (DBCC_Location *loc, unsigned reg_base)
+{
+  switch (loc->type)
+    {
+    case DBCC_LOCATION_REG:
+      loc->info.v_reg += reg_base;
+      break;
+    case DBCC_LOCATION_PTR:
+      loc->info.v_ptr += reg_base;
+      break;
+    case DBCC_LOCATION_IMMED:
+      break;
+    }
+}
+
+/* Copy 'ir' from the callee, renumbering its registers and
+ * retargeting its jumps;  returns become a jump to 'cont',
+ * preceded by a move to the call's result.
+ */
+static void
+append_inlined_instruction (DBCC_BB                  *bb,
+                            const DBCC_IR            *ir,
+                            unsigned                  reg_base,
+                            DBCC_BB                 **block_map,
+                            const DBCC_IR_CallByName *call,
+                            DBCC_BB                  *cont)
+{
+  if (ir->type == DBCC_IR_TYPE_RETURN_VOID
+   || ir->type == DBCC_IR_TYPE_RETURN_REG)
+    {
+      if (ir->type == DBCC_IR_TYPE_RETURN_REG && call->has_result)
+        {
+          unsigned reg = ((const DBCC_IR_ReturnReg *) ir)->reg + reg_base;
+          DBCC_Location src = dbcc_location_reg (call->result.width, reg);
+          dbcc_bb_append (bb, dbcc_ir_new_move (call->result, src));
+        }
+      dbcc_bb_append (bb, dbcc_ir_new_jump (cont));
+      return;
+    }
+
+  DBCC_IR *copy = dbcc_ir_copy (ir);
+  switch (copy->type)
+    {
+    case DBCC_IR_TYPE_UNARY:
+      {
+        DBCC_IR_Unary *u = (DBCC_IR_Unary *) copy;
+        remap_location (&u->dest, reg_base);
+        remap_location (&u->source, reg_base);
+        break;
+      }
+    case DBCC_IR_TYPE_BINARY:
+      {
+        DBCC_IR_Binary *b = (DBCC_IR_Binary *) copy;
+        remap_location (&b->dest, reg_base);
+        remap_location (&b->source1, reg_base);
+        remap_location (&b->source2, reg_base);
+        break;
+      }
+    case DBCC_IR_TYPE_VECTOR_BINARY:
+      {
+        DBCC_IR_VectorBinary *v = (DBCC_IR_VectorBinary *) copy;
+        remap_location (&v->dest, reg_base);
+        remap_location (&v->source1, reg_base);
+        remap_location (&v->source2, reg_base);
+        break;
+      }
+    case DBCC_IR_TYPE_JUMP:
+      {
+        DBCC_IR_Jump *j = (DBCC_IR_Jump *) copy;
+        j->dst = block_map[j->dst->index];
+        break;
+      }
+    case DBCC_IR_TYPE_JUMP_CONDITIONAL:
+      {
+        DBCC_IR_JumpConditional *j = (DBCC_IR_JumpConditional *) copy;
+        j->reg += reg_base;
+        j->dst = block_map[j->dst->index];
+        break;
+      }
+    case DBCC_IR_TYPE_CALL_BY_NAME:
+      {
+        DBCC_IR_CallByName *c = (DBCC_IR_CallByName *) copy;
+        for (unsigned i = 0; i < c->n_args; i++)
+          remap_location (c->args + i, reg_base);
+        if (c->has_result)
+          remap_location (&c->result, reg_base);
+        break;
+      }
+    case DBCC_IR_TYPE_CALL_BY_POINTER:
+      {
+        DBCC_IR_CallByPointer *c = (DBCC_IR_CallByPointer *) copy;
+        c->reg += reg_base;
+        for (unsigned i = 0; i < c->n_args; i++)
+          remap_location (c->args + i, reg_base);
+        if (c->has_result)
+          remap_location (&c->result, reg_base);
+        break;
+      }
+    default:
+      assert (0);
+    }
+  dbcc_bb_append (bb, copy);
+}
+
+/* Replace 'call' with a copy of 'callee'.
+ *
+ * The block holding the call is split:  the instructions after
+ * the call move to a new continuation block, the arguments are
+ * moved into the copy's parameter registers, and the call itself
+ * becomes a jump to the copy of the callee's entry block.
+ */
+static void
+inline_call (DBCC_Function      *caller,
+             DBCC_IR_CallByName *call,
+             DBCC_Function      *callee)
+{
+  DBCC_BB *bb = call->base.owner;
+
+  DBCC_BB *cont = dbcc_function_add_block (caller);
+  while (call->base.next != NULL)
+    {
+      DBCC_IR *ir = call->base.next;
+      dbcc_bb_remove (bb, ir);
+      dbcc_bb_append (cont, ir);
+    }
+
+  unsigned reg_base = caller->n_regs;
+  caller->n_regs += callee->n_regs;
+  DBCC_BB **block_map = DBCC_NEW_ARRAY (callee->n_blocks, DBCC_BB *);
+  for (unsigned i = 0; i < callee->n_blocks; i++)
+    block_map[i] = dbcc_function_add_block (caller);
+
+  for (unsigned i = 0; i < call->n_args; i++)
+    {
+      DBCC_Location param = dbcc_location_reg (call->args[i].width, reg_base + i);
+      dbcc_bb_insert_before (bb, &call->base,
+                             dbcc_ir_new_move (param, call->args[i]));
+    }
+
+  for (unsigned i = 0; i < callee->n_blocks; i++)
+    for (DBCC_IR *ir = callee->blocks[i]->first; ir != NULL; ir = ir->next)
+      append_inlined_instruction (block_map[i], ir, reg_base, block_map,
+                                  call, cont);
+
+  /* The copy runs once per call from here:  it takes that share
+   * of the callee's counts, which the callee no longer sees. */
+  if (caller->has_profile)
+    {
+      cont->count = bb->count;
+      uint64_t entry_count = callee->has_profile ? callee->entry->count : 0;
+      for (unsigned i = 0; i < callee->n_blocks && entry_count > 0; i++)
+        {
+          DBCC_BB *orig = callee->blocks[i];
+          uint64_t share = (uint64_t) ((double) orig->count * bb->count / entry_count);
+          if (share > orig->count)
+            share = orig->count;
+          block_map[i]->count = share;
+          orig->count -= share;
+        }
+    }
+
+  dbcc_bb_append (bb, dbcc_ir_new_jump (block_map[callee->entry->index]));
+  dbcc_bb_remove (bb, &call->base);
+  dbcc_ir_free (&call->base);
+  free (block_map);
+}
+
+/* --- The pass --- */
+static unsigned
+call_site_cost (unsigned callee_cost, const DBCC_IR_CallByName *call)
+{
+  unsigned bonus = 0;
+  for (unsigned i = 0; i < call->n_args; i++)
+    if (call->args[i].type == DBCC_LOCATION_IMMED)
+      bonus += IMMEDIATE_ARG_BONUS;
+  return callee_cost > bonus ? callee_cost - bonus : 0;
+}
+
+static void
+inline_into_function (CallGraph                   *graph,
+                      FunctionInfo                *caller_info,
+                      unsigned                    *costs,
+                      const DBCC_IR_InlineOptions *options,
+                      DBCC_IR_InlineStats         *stats)
+{
+  DBCC_Function *caller = caller_info->function;
+
+  /* Gather the sites first:  the blocks we add while inlining hold
+   * calls that were already considered when the callee was visited.
+   */
+  size_t n_sites = 0, sites_alloced = 16;
+  DBCC_IR_CallByName **sites = DBCC_NEW_ARRAY (sites_alloced, DBCC_IR_CallByName *);
+  FOREACH_CALLEE (graph, caller, callee_info, {
+    (void) callee_info;
+    if (n_sites == sites_alloced)
+      {
+        sites_alloced *= 2;
+        sites = realloc (sites, sizeof (DBCC_IR_CallByName *) * sites_alloced);
+      }
+    sites[n_sites++] = (DBCC_IR_CallByName *) _ir;
+  });
+
+  unsigned cost = costs[caller_info - graph->infos];
+  unsigned max_cost = cost * options->max_caller_growth;
+  if (max_cost < options->max_cost)
+    max_cost = options->max_cost;           /* wrappers may grow */
+  for (size_t i = 0; i < n_sites; i++)
+    {
+      DBCC_IR_CallByName *call = sites[i];
+      FunctionInfo *callee_info = get_callee_info (graph, &call->base);
+      DBCC_Function *callee = callee_info->function;
+      unsigned callee_cost = costs[callee_info - graph->infos];
+      unsigned site_cost = call_site_cost (callee_cost, call);
+      stats->n_call_sites++;
+
+      if ((callee->flags & (DBCC_FUNCTION_FLAG_NOINLINE|DBCC_FUNCTION_FLAG_VARARGS)) != 0
+       || call->n_args != callee->n_params)
+        {
+          stats->n_rejected_flags++;
+          continue;
+        }
+      if (callee_info->recursive && callee_info->scc == caller_info->scc)
+        {
+          stats->n_rejected_recursive++;
+          continue;
+        }
+
+      /* a static function with one caller disappears once inlined,
+       * so its code moves rather than grows */
+      bool single_caller = (callee->flags & DBCC_FUNCTION_FLAG_STATIC) != 0
+                        && (callee->flags & DBCC_FUNCTION_FLAG_ADDRESS_TAKEN) == 0
+                        && callee_info->n_call_sites == 1;
+      uint64_t count = call->base.owner->count;
+      if (caller->has_profile && count == 0 && !single_caller)
+        {
+          stats->n_rejected_cold++;
+          continue;
+        }
+      unsigned limit;
+      if (single_caller)
+        limit = options->max_cost_single_caller;
+      else if ((callee->flags & DBCC_FUNCTION_FLAG_INLINE_HINT) != 0)
+        limit = options->max_cost_inline_hint;
+      else
+        limit = options->max_cost;
+      if (caller->has_profile
+       && count >= options->hot_call_count
+       && limit < options->max_cost_hot)
+        limit = options->max_cost_hot;
+      if (site_cost > limit)
+        {
+          stats->n_rejected_cost++;
+          continue;
+        }
+      if (!single_caller
+       && site_cost > options->always_inline_cost
+       && cost + callee_cost > max_cost)
+        {
+          stats->n_rejected_growth++;
+          continue;
+        }
+
+      inline_call (caller, call, callee);
+      cost += callee_cost;
+      stats->n_inlined++;
+    }
+  free (sites);
+
+  costs[caller_info - graph->infos] = dbcc_function_get_inline_cost (caller);
+}
+
+static void
+mark_reachable (CallGraph *graph, FunctionInfo *info)
+{
+  if (info->reachable)
+    return;
+  info->reachable = true;
+  FOREACH_CALLEE (graph, info->function, callee, mark_reachable (graph, callee));
+}
+
+void
+dbcc_ir_module_inline (DBCC_IR_Module              *module,
+                       const DBCC_IR_InlineOptions *options,
+                       DBCC_IR_InlineStats         *stats_out)
+{
+  DBCC_IR_InlineStats stats;
+  memset (&stats, 0, sizeof (stats));
+
+  CallGraph graph;
+  call_graph_init (&graph, module);
+
+  /* Visit callees before callers, so each callee has already
+   * absorbed its own inlined calls when its cost is measured.
+   */
+  unsigned *costs = DBCC_NEW_ARRAY (module->n_functions, unsigned);
+  for (size_t i = 0; i < module->n_functions; i++)
+    costs[i] = dbcc_function_get_inline_cost (graph.infos[i].function);
+  for (size_t i = 0; i < graph.n_order; i++)
+    inline_into_function (&graph, graph.order[i], costs, options, &stats);
+  free (costs);
+
+  /* Static functions are only reachable through their callers. */
+  for (size_t i = 0; i < module->n_functions; i++)
+    {
+      DBCC_Function *f = graph.infos[i].function;
+      if ((f->flags & DBCC_FUNCTION_FLAG_STATIC) == 0
+       || (f->flags & DBCC_FUNCTION_FLAG_ADDRESS_TAKEN) != 0)
+        mark_reachable (&graph, graph.infos + i);
+    }
+  size_t n_infos = module->n_functions;
+  for (size_t i = 0; i < n_infos; i++)
+    if (!graph.infos[i].reachable)
+      {
+        dbcc_ir_module_remove (module, graph.infos[i].function);
+        stats.n_functions_removed++;
+      }
+  call_graph_clear (&graph);
+
+  if (stats_out != NULL)
+    *stats_out = stats;
+}
@@ -0,0 +1,851 @@
+#include "dbcc.h"
+#include <limits.h>
+
+/* --- Control flow --- */
+typedef struct
+{
+  unsigned n, alloced;
+  unsigned *v;
+} IndexList;
+
+static void
+index_list_append (IndexList *list, unsigned v)
+{
+  for (unsigned i = 0; i < list->n; i++)
+    if (list->v[i] == v)
+      return;
+  if (list->n == list->alloced)
+    {
+      list->alloced = list->alloced ? list->alloced * 2 : 4;
+      list->v = realloc (list->v, sizeof (unsigned) * list->alloced);
+    }
+  list->v[list->n++] = v;
+}
+
+typedef struct
+{
+  unsigned n_blocks;
+  IndexList *succs;
+  IndexList *preds;
+  unsigned n_reachable;
+  unsigned *rpo;                /* reachable blocks, reverse postorder */
+  unsigned *rpo_number;         /* UINT_MAX if unreachable */
+  unsigned *idom;
+} FlowGraph;
+
+static void
+flow_graph_init (FlowGraph *g, DBCC_Function *f)
+{
+  unsigned n = f->n_blocks;
+  g->n_blocks = n;
+  g->succs = calloc (n, sizeof (IndexList));
+  g->preds = calloc (n, sizeof (IndexList));
+  for (unsigned b = 0; b < n; b++)
+    for (DBCC_IR *ir = f->blocks[b]->first; ir != NULL; ir = ir->next)
+      {
+        DBCC_BB *dst = NULL;
+        if (ir->type == DBCC_IR_TYPE_JUMP)
+          dst = ((DBCC_IR_Jump *) ir)->dst;
+        else if (ir->type == DBCC_IR_TYPE_JUMP_CONDITIONAL)
+          dst = ((DBCC_IR_JumpConditional *) ir)->dst;
+        if (dst != NULL)
+          {
+            index_list_append (g->succs + b, dst->index);
+            index_list_append (g->preds + dst->index, b);
+          }
+      }
+
+  /* Depth-first, with an explicit stack of (block, next successor). */
+  unsigned *postorder = DBCC_NEW_ARRAY (n, unsigned);
+  unsigned n_post = 0;
+  unsigned *stack = DBCC_NEW_ARRAY (n, unsigned);
+  unsigned *next_succ = calloc (n, sizeof (unsigned));
+  bool *visited = calloc (n, sizeof (bool));
+  unsigned sp = 0;
+  stack[sp++] = f->entry->index;
+  visited[f->entry->index] = true;
+  while (sp > 0)
+    {
+      unsigned b = stack[sp - 1];
+      if (next_succ[b] < g->succs[b].n)
+        {
+          unsigned s = g->succs[b].v[next_succ[b]++];
+          if (!visited[s])
+            {
+              visited[s] = true;
+              stack[sp++] = s;
+            }
+        }
+      else
+        {
+          postorder[n_post++] = b;
+          sp--;
+        }
+    }
+  g->n_reachable = n_post;
+  g->rpo = DBCC_NEW_ARRAY (n_post + 1, unsigned);
+  g->rpo_number = DBCC_NEW_ARRAY (n, unsigned);
+  for (unsigned b = 0; b < n; b++)
+    g->rpo_number[b] = UINT_MAX;
+  for (unsigned i = 0; i < n_post; i++)
+    {
+      g->rpo[i] = postorder[n_post - 1 - i];
+      g->rpo_number[g->rpo[i]] = i;
+    }
+  free (postorder);
+  free (stack);
+  free (next_succ);
+  free (visited);
+
+  /* Dominators, by Cooper, Harvey and Kennedy's iteration. */
+  g->idom = DBCC_NEW_ARRAY (n, unsigned);
+  for (unsigned b = 0; b < n; b++)
+    g->idom[b] = UINT_MAX;
+  unsigned entry = f->entry->index;
+  g->idom[entry] = entry;
+  bool changed = true;
+  while (changed)
+    {
+      changed = false;
+      for (unsigned i = 1; i < n_post; i++)
+        {
+          unsigned b = g->rpo[i];
+          unsigned new_idom = UINT_MAX;
+          for (unsigned p = 0; p < g->preds[b].n; p++)
+            {
+              unsigned pred = g->preds[b].v[p];
+              if (g->idom[pred] == UINT_MAX)
+                continue;
+              if (new_idom == UINT_MAX)
+                {
+                  new_idom = pred;
+                  continue;
+                }
+              unsigned x = pred, y = new_idom;
+              while (x != y)
+                {
+                  while (g->rpo_number[x] > g->rpo_number[y])
+                    x = g->idom[x];
+                  while (g->rpo_number[y] > g->rpo_number[x])
+                    y = g->idom[y];
+                }
+              new_idom = x;
+            }
+          if (g->idom[b] != new_idom)
+            {
+              g->idom[b] = new_idom;
+              changed = true;
+            }
+        }
+    }
+}
+
+static bool
+flow_graph_dominates (FlowGraph *g, unsigned a, unsigned b)
+{
+  if (g->rpo_number[b] == UINT_MAX)
+    return false;
+  for (;;)
+    {
+      if (a == b)
+        return true;
+      if (g->idom[b] == b)
+        return false;
+      b = g->idom[b];
+    }
+}
+
+static void
+flow_graph_clear (FlowGraph *g)
+{
+  for (unsigned b = 0; b < g->n_blocks; b++)
+    {
+      free (g->succs[b].v);
+      free (g->preds[b].v);
+    }
+  free (g->succs);
+  free (g->preds);
+  free (g->rpo);
+  free (g->rpo_number);
+  free (g->idom);
+}
+
+/* --- Finding loops --- */
+static void
+loop_add_block (DBCC_IR_Loop *loop, DBCC_BB *bb)
+{
+  if (loop->contains[bb->index])
+    return;
+  loop->contains[bb->index] = 1;
+  loop->blocks[loop->n_blocks++] = bb;
+}
+
+static int
+compare_loops_by_size (const void *a, const void *b)
+{
+  const DBCC_IR_Loop *la = a, *lb = b;
+  return la->n_blocks < lb->n_blocks ? -1 : la->n_blocks > lb->n_blocks ? 1 : 0;
+}
+
+/* Give 'loop' a block that is its only entry from outside:  either
+ * the one predecessor that jumps nowhere else, or a new block.
+ */
+static void
+make_preheader (DBCC_Function      *f,
+                FlowGraph          *g,
+                DBCC_IR_LoopForest *forest,
+                DBCC_IR_Loop       *loop)
+{
+  DBCC_BB *header = loop->header;
+  IndexList *preds = g->preds + header->index;
+  unsigned n_outside = 0, outside = 0;
+  for (unsigned p = 0; p < preds->n; p++)
+    if (preds->v[p] >= loop->n_contains || !loop->contains[preds->v[p]])
+      {
+        n_outside++;
+        outside = preds->v[p];
+      }
+
+  if (n_outside == 1 && header != f->entry
+   && outside < g->n_blocks && g->succs[outside].n == 1)
+    {
+      loop->preheader = f->blocks[outside];
+      return;
+    }
+
+  DBCC_BB *pre = dbcc_function_add_block (f);
+  dbcc_bb_append (pre, dbcc_ir_new_jump (header));
+  for (unsigned p = 0; p < preds->n; p++)
+    {
+      unsigned b = preds->v[p];
+      if (!loop->contains[b])
+        dbcc_bb_retarget_jumps (f->blocks[b], header, pre);
+    }
+  if (f->entry == header)
+    f->entry = pre;
+  loop->preheader = pre;
+
+  /* The preheader belongs to every loop around this one. */
+  for (unsigned i = 0; i < forest->n_loops; i++)
+    {
+      DBCC_IR_Loop *outer = forest->loops + i;
+      if (outer != loop && outer->contains[header->index])
+        loop_add_block (outer, pre);
+    }
+}
+
+DBCC_IR_LoopForest *
+dbcc_function_find_loops (DBCC_Function *function)
+{
+  FlowGraph g;
+  flow_graph_init (&g, function);
+  unsigned n = function->n_blocks;
+
+  /* One loop per header, merging all of its back edges. */
+  DBCC_IR_LoopForest *forest = DBCC_NEW (DBCC_IR_LoopForest);
+  forest->n_loops = 0;
+  forest->loops = DBCC_NEW_ARRAY (n + 1, DBCC_IR_Loop);
+  unsigned *loop_by_header = DBCC_NEW_ARRAY (n, unsigned);
+  for (unsigned b = 0; b < n; b++)
+    loop_by_header[b] = UINT_MAX;
+  unsigned max_blocks = 2 * n;          /* room for the preheaders */
+  unsigned *work = DBCC_NEW_ARRAY (n, unsigned);
+
+  for (unsigned i = 0; i < g.n_reachable; i++)
+    {
+      unsigned tail = g.rpo[i];
+      for (unsigned s = 0; s < g.succs[tail].n; s++)
+        {
+          unsigned head = g.succs[tail].v[s];
+          if (!flow_graph_dominates (&g, head, tail))
+            continue;
+          DBCC_IR_Loop *loop;
+          if (loop_by_header[head] == UINT_MAX)
+            {
+              loop_by_header[head] = forest->n_loops;
+              loop = forest->loops + forest->n_loops++;
+              loop->header = function->blocks[head];
+              loop->preheader = NULL;
+              loop->n_blocks = 0;
+              loop->blocks = DBCC_NEW_ARRAY (max_blocks, DBCC_BB *);
+              loop->n_contains = max_blocks;
+              loop->contains = calloc (max_blocks, 1);
+              loop_add_block (loop, loop->header);
+            }
+          else
+            loop = forest->loops + loop_by_header[head];
+
+          /* Everything that reaches the tail without passing the header. */
+          unsigned n_work = 0;
+          if (!loop->contains[tail])
+            {
+              loop_add_block (loop, function->blocks[tail]);
+              work[n_work++] = tail;
+            }
+          while (n_work > 0)
+            {
+              unsigned b = work[--n_work];
+              for (unsigned p = 0; p < g.preds[b].n; p++)
+                {
+                  unsigned pred = g.preds[b].v[p];
+                  if (g.rpo_number[pred] != UINT_MAX && !loop->contains[pred])
+                    {
+                      loop_add_block (loop, function->blocks[pred]);
+                      work[n_work++] = pred;
+                    }
+                }
+            }
+        }
+    }
+  free (loop_by_header);
+  free (work);
+
+  /* A loop nested in another has fewer blocks, so this puts
+   * inner loops first. */
+  qsort (forest->loops, forest->n_loops, sizeof (DBCC_IR_Loop),
+         compare_loops_by_size);
+  for (unsigned i = 0; i < forest->n_loops; i++)
+    make_preheader (function, &g, forest, forest->loops + i);
+  flow_graph_clear (&g);
+  return forest;
+}
+
+bool
+dbcc_ir_loop_contains (const DBCC_IR_Loop *loop,
+                       const DBCC_BB      *bb)
+{
+  return bb->index < loop->n_contains && loop->contains[bb->index];
+}
+
+void
+dbcc_ir_loop_forest_destroy (DBCC_IR_LoopForest *forest)
+{
+  for (unsigned i = 0; i < forest->n_loops; i++)
+    {
+      free (forest->loops[i].blocks);
+      free (forest->loops[i].contains);
+    }
+  free (forest->loops);
+  free (forest);
+}
+
+/* --- Register bookkeeping --- */
+typedef struct
+{
+  DBCC_Function *function;
+  DBCC_IR_Loop *loop;
+  unsigned *defs_total;         /* parameters count as defined on entry */
+  unsigned *defs_in_loop;
+  DBCC_IR **loop_def;           /* the last definition seen in the loop */
+} RegCounts;
+
+static void
+count_reg (DBCC_IR *ir, unsigned reg, bool is_def, void *data)
+{
+  RegCounts *counts = data;
+  if (!is_def)
+    return;
+  counts->defs_total[reg]++;
+  if (dbcc_ir_loop_contains (counts->loop, ir->owner))
+    {
+      counts->defs_in_loop[reg]++;
+      counts->loop_def[reg] = ir;
+    }
+}
+
+static void
+reg_counts_init (RegCounts *counts, DBCC_Function *f, DBCC_IR_Loop *loop)
+{
+  unsigned n = f->n_regs + 1;
+  counts->function = f;
+  counts->loop = loop;
+  counts->defs_total = calloc (n, sizeof (unsigned));
+  counts->defs_in_loop = calloc (n, sizeof (unsigned));
+  counts->loop_def = calloc (n, sizeof (DBCC_IR *));
+  for (unsigned p = 0; p < f->n_params; p++)
+    counts->defs_total[p] = 1;
+  for (unsigned b = 0; b < f->n_blocks; b++)
+    for (DBCC_IR *ir = f->blocks[b]->first; ir != NULL; ir = ir->next)
+      dbcc_ir_foreach_reg (ir, count_reg, counts);
+}
+
+static void
+reg_counts_clear (RegCounts *counts)
+{
+  free (counts->defs_total);
+  free (counts->defs_in_loop);
+  free (counts->loop_def);
+}
+
+static void
+insert_after (DBCC_IR *at, DBCC_IR *ir)
+{
+  /* every block ends with a jump or return, so 'at' has a successor
+   * unless it is one */
+  assert (at->next != NULL);
+  dbcc_bb_insert_before (at->owner, at->next, ir);
+}
+
+static void
+append_to_preheader (DBCC_IR_Loop *loop, DBCC_IR *ir)
+{
+  dbcc_bb_insert_before (loop->preheader, loop->preheader->last, ir);
+}
+
+static void
+replace_instruction (DBCC_IR *old, DBCC_IR *ir)
+{
+  DBCC_BB *bb = old->owner;
+  dbcc_bb_insert_before (bb, old, ir);
+  dbcc_bb_remove (bb, old);
+  dbcc_ir_free (old);
+}
+
+/* --- Loop-invariant code motion --- */
+typedef struct
+{
+  RegCounts counts;
+  DBCC_AliasInfo *alias;
+  bool has_call;
+  size_t n_stores;
+  DBCC_Location *stores;
+  DBCC_IR *header_exit;         /* first instruction that may leave the header */
+} LoopScan;
+
+static void
+loop_scan_init (LoopScan *scan, DBCC_Function *f, DBCC_IR_Loop *loop,
+                DBCC_AliasInfo *alias)
+{
+  reg_counts_init (&scan->counts, f, loop);
+  scan->alias = alias;
+  scan->has_call = false;
+  scan->n_stores = 0;
+  scan->stores = NULL;
+  size_t stores_alloced = 0;
+  for (unsigned b = 0; b < loop->n_blocks; b++)
+    for (DBCC_IR *ir = loop->blocks[b]->first; ir != NULL; ir = ir->next)
+      {
+        const DBCC_Location *dest = NULL;
+        if (ir->type == DBCC_IR_TYPE_UNARY)
+          dest = &((DBCC_IR_Unary *) ir)->dest;
+        else if (ir->type == DBCC_IR_TYPE_BINARY)
+          dest = &((DBCC_IR_Binary *) ir)->dest;
+        else if (ir->type == DBCC_IR_TYPE_VECTOR_BINARY)
+          dest = &((DBCC_IR_VectorBinary *) ir)->dest;
+        else if (ir->type == DBCC_IR_TYPE_CALL_BY_NAME
+              || ir->type == DBCC_IR_TYPE_CALL_BY_POINTER)
+          scan->has_call = true;
+        if (dest != NULL && dest->type == DBCC_LOCATION_PTR)
+          {
+            if (scan->n_stores == stores_alloced)
+              {
+                stores_alloced = stores_alloced ? stores_alloced * 2 : 8;
+                scan->stores = realloc (scan->stores,
+                                        sizeof (DBCC_Location) * stores_alloced);
+              }
+            scan->stores[scan->n_stores++] = *dest;
+          }
+      }
+  scan->header_exit = NULL;
+  for (DBCC_IR *ir = loop->header->first; ir != NULL; ir = ir->next)
+    if (ir->type != DBCC_IR_TYPE_UNARY && ir->type != DBCC_IR_TYPE_BINARY)
+      {
+        scan->header_exit = ir;
+        break;
+      }
+}
+
+static void
+loop_scan_clear (LoopScan *scan)
+{
+  reg_counts_clear (&scan->counts);
+  free (scan->stores);
+}
+
+/* Whether 'ir' runs every time the loop is entered. */
+static bool
+always_executed (LoopScan *scan, DBCC_IR_Loop *loop, DBCC_IR *ir)
+{
+  if (ir->owner != loop->header)
+    return false;
+  for (DBCC_IR *at = loop->header->first; at != scan->header_exit; at = at->next)
+    if (at == ir)
+      return true;
+  return false;
+}
+
+static bool
+is_invariant (LoopScan *scan, const DBCC_Location *loc, bool *may_trap)
+{
+  switch (loc->type)
+    {
+    case DBCC_LOCATION_IMMED:
+      return true;
+    case DBCC_LOCATION_REG:
+      return scan->counts.defs_in_loop[loc->info.v_reg] == 0;
+    case DBCC_LOCATION_PTR:
+      if (scan->counts.defs_in_loop[loc->info.v_ptr] != 0 || scan->has_call)
+        return false;
+      for (size_t i = 0; i < scan->n_stores; i++)
+        if (dbcc_alias_info_query (scan->alias, scan->stores + i, loc) != DBCC_ALIAS_NO)
+          return false;
+      *may_trap = true;
+      return true;
+    }
+  return false;
+}
+
+static bool
+can_hoist (LoopScan *scan, DBCC_IR_Loop *loop, DBCC_IR *ir)
+{
+  bool may_trap = false;
+  const DBCC_Location *dest;
+  if (ir->type == DBCC_IR_TYPE_UNARY)
+    {
+      DBCC_IR_Unary *u = (DBCC_IR_Unary *) ir;
+      dest = &u->dest;
+      if (!is_invariant (scan, &u->source, &may_trap))
+        return false;
+    }
+  else if (ir->type == DBCC_IR_TYPE_BINARY)
+    {
+      DBCC_IR_Binary *b = (DBCC_IR_Binary *) ir;
+      dest = &b->dest;
+      if (!is_invariant (scan, &b->source1, &may_trap)
+       || !is_invariant (scan, &b->source2, &may_trap))
+        return false;
+      if ((b->op == DBCC_BINARY_OPERATOR_DIV || b->op == DBCC_BINARY_OPERATOR_REM)
+       && (b->source2.type != DBCC_LOCATION_IMMED
+        || dbcc_location_get_immed (&b->source2) == 0))
+        may_trap = true;
+    }
+  else
+    return false;
+
+  /* A register defined once has the same value wherever it is
+   * read, so defining it earlier changes nothing. */
+  if (dest->type != DBCC_LOCATION_REG
+   || scan->counts.defs_total[dest->info.v_reg] != 1)
+    return false;
+  if (may_trap && !always_executed (scan, loop, ir))
+    return false;
+  return true;
+}
+
+static size_t
+hoist_invariants (LoopScan *scan, DBCC_IR_Loop *loop)
+{
+  size_t rv = 0;
+  bool changed = true;
+  while (changed)
+    {
+      changed = false;
+      for (unsigned b = 0; b < loop->n_blocks; b++)
+        {
+          DBCC_BB *bb = loop->blocks[b];
+          DBCC_IR *next;
+          for (DBCC_IR *ir = bb->first; ir != NULL; ir = next)
+            {
+              next = ir->next;
+              if (!can_hoist (scan, loop, ir))
+                continue;
+              const DBCC_Location *dest = ir->type == DBCC_IR_TYPE_UNARY
+                                        ? &((DBCC_IR_Unary *) ir)->dest
+                                        : &((DBCC_IR_Binary *) ir)->dest;
+              scan->counts.defs_in_loop[dest->info.v_reg]--;
+              dbcc_bb_remove (bb, ir);
+              append_to_preheader (loop, ir);
+              rv++;
+              changed = true;
+            }
+        }
+    }
+  return rv;
+}
+
+/* --- Induction variables --- */
+typedef struct
+{
+  unsigned reg;
+  DBCC_IR *increment;           /* reg = reg + step */
+  int64_t step;
+} BasicIV;
+
+typedef struct
+{
+  unsigned iv;                  /* index in the BasicIV array */
+  int64_t factor;
+  unsigned width;
+  unsigned reg;                 /* always iv.reg * factor */
+  DBCC_IR *init;
+} ReducedIV;
+
+/* 'ir' is "reg = reg + c" or "reg = reg - c". */
+static bool
+is_basic_iv_increment (DBCC_IR *ir, unsigned reg, int64_t *step_out)
+{
+  if (ir->type != DBCC_IR_TYPE_BINARY)
+    return false;
+  DBCC_IR_Binary *b = (DBCC_IR_Binary *) ir;
+  if (b->dest.type != DBCC_LOCATION_REG || b->dest.info.v_reg != reg)
+    return false;
+  const DBCC_Location *a = &b->source1, *c = &b->source2;
+  if (b->op == DBCC_BINARY_OPERATOR_ADD && a->type == DBCC_LOCATION_IMMED)
+    {
+      a = &b->source2;
+      c = &b->source1;
+    }
+  else if (b->op != DBCC_BINARY_OPERATOR_ADD && b->op != DBCC_BINARY_OPERATOR_SUB)
+    return false;
+  if (a->type != DBCC_LOCATION_REG || a->info.v_reg != reg
+   || c->type != DBCC_LOCATION_IMMED)
+    return false;
+  int64_t v = dbcc_location_get_immed (c);
+  *step_out = b->op == DBCC_BINARY_OPERATOR_SUB ? -v : v;
+  return true;
+}
+
+/* 'ir' is "dest = reg * k" or "dest = reg << s". */
+static bool
+is_scaled_iv (DBCC_IR *ir, BasicIV *ivs, unsigned n_ivs,
+              unsigned *iv_out, int64_t *factor_out)
+{
+  if (ir->type != DBCC_IR_TYPE_BINARY)
+    return false;
+  DBCC_IR_Binary *b = (DBCC_IR_Binary *) ir;
+  if (b->dest.type != DBCC_LOCATION_REG)
+    return false;
+  const DBCC_Location *r = &b->source1, *k = &b->source2;
+  if (b->op == DBCC_BINARY_OPERATOR_MUL && r->type == DBCC_LOCATION_IMMED)
+    {
+      r = &b->source2;
+      k = &b->source1;
+    }
+  if (r->type != DBCC_LOCATION_REG || k->type != DBCC_LOCATION_IMMED)
+    return false;
+  int64_t kv = dbcc_location_get_immed (k);
+  if (b->op == DBCC_BINARY_OPERATOR_SHIFT_LEFT)
+    {
+      if (kv < 0 || kv >= 62)
+        return false;
+      kv = (int64_t) 1 << kv;
+    }
+  else if (b->op != DBCC_BINARY_OPERATOR_MUL)
+    return false;
+  for (unsigned i = 0; i < n_ivs; i++)
+    if (ivs[i].reg == r->info.v_reg && b->dest.info.v_reg != ivs[i].reg)
+      {
+        *iv_out = i;
+        *factor_out = kv;
+        return true;
+      }
+  return false;
+}
+
+/* --- Eliminating basic induction variables ---
+ *
+ * Once "i * k" is kept in its own register, 'i' may only be needed
+ * for the loop test.  If so, the test "i < N" becomes "i*k < N*k"
+ * (for k > 0) and the increment of 'i' goes away.  This assumes the
+ * scaled value does not wrap, as the original multiply also did.
+ */
+typedef struct
+{
+  DBCC_IR_Loop *loop;
+  unsigned reg;
+  const ReducedIV *reduced;
+  size_t n_reduced;
+  DBCC_IR *increment;
+  DBCC_IR *compare;
+  bool ok;
+} IVUses;
+
+static bool
+is_compare_op (DBCC_BinaryOperator op)
+{
+  switch (op)
+    {
+    case DBCC_BINARY_OPERATOR_LT:
+    case DBCC_BINARY_OPERATOR_LTEQ:
+    case DBCC_BINARY_OPERATOR_GT:
+    case DBCC_BINARY_OPERATOR_GTEQ:
+    case DBCC_BINARY_OPERATOR_EQ:
+    case DBCC_BINARY_OPERATOR_NE:
+      return true;
+    default:
+      return false;
+    }
+}
+
+static void
+check_iv_use (DBCC_IR *ir, unsigned reg, bool is_def, void *data)
+{
+  IVUses *uses = data;
+  if (reg != uses->reg || is_def || !uses->ok || ir == uses->increment)
+    return;
+  for (size_t i = 0; i < uses->n_reduced; i++)
+    if (uses->reduced[i].init == ir)
+      return;
+  if (uses->compare == NULL
+   && ir->type == DBCC_IR_TYPE_BINARY
+   && dbcc_ir_loop_contains (uses->loop, ir->owner))
+    {
+      DBCC_IR_Binary *b = (DBCC_IR_Binary *) ir;
+      bool imm1 = b->source1.type == DBCC_LOCATION_IMMED;
+      bool imm2 = b->source2.type == DBCC_LOCATION_IMMED;
+      if (is_compare_op (b->op) && imm1 != imm2)
+        {
+          uses->compare = ir;
+          return;
+        }
+    }
+  uses->ok = false;
+}
+
+static bool
+try_eliminate_iv (DBCC_Function   *f,
+                  DBCC_IR_Loop    *loop,
+                  BasicIV         *iv,
+                  const ReducedIV *reduced,
+                  size_t           n_reduced,
+                  const ReducedIV *by)
+{
+  if (by->factor <= 0)
+    return false;
+  IVUses uses = { loop, iv->reg, reduced, n_reduced, iv->increment, NULL, true };
+  for (unsigned b = 0; b < f->n_blocks && uses.ok; b++)
+    for (DBCC_IR *ir = f->blocks[b]->first; ir != NULL && uses.ok; ir = ir->next)
+      dbcc_ir_foreach_reg (ir, check_iv_use, &uses);
+  if (!uses.ok || uses.compare == NULL)
+    return false;
+
+  DBCC_IR_Binary *cmp = (DBCC_IR_Binary *) uses.compare;
+  DBCC_Location *bound = cmp->source1.type == DBCC_LOCATION_IMMED
+                       ? &cmp->source1 : &cmp->source2;
+  DBCC_Location *var = bound == &cmp->source1 ? &cmp->source2 : &cmp->source1;
+  int64_t scaled;
+  if (__builtin_mul_overflow (dbcc_location_get_immed (bound), by->factor, &scaled))
+    return false;
+  if (by->width < 3)
+    {
+      int64_t limit = (int64_t) 1 << (8 * (1 << by->width) - 1);
+      if (scaled < -limit || scaled >= limit)
+        return false;
+    }
+  *bound = dbcc_location_immed (by->width, scaled);
+  *var = dbcc_location_reg (by->width, by->reg);
+  dbcc_bb_remove (iv->increment->owner, iv->increment);
+  dbcc_ir_free (iv->increment);
+  iv->increment = NULL;
+  return true;
+}
+
+static void
+reduce_strength (DBCC_Function     *f,
+                 LoopScan          *scan,
+                 DBCC_IR_Loop      *loop,
+                 DBCC_IR_LoopStats *stats)
+{
+  /* Basic IVs:  defined once in the loop, by a constant step. */
+  unsigned n_ivs = 0;
+  BasicIV *ivs = DBCC_NEW_ARRAY (f->n_regs + 1, BasicIV);
+  for (unsigned r = 0; r < f->n_regs; r++)
+    {
+      int64_t step;
+      if (scan->counts.defs_in_loop[r] == 1
+       && is_basic_iv_increment (scan->counts.loop_def[r], r, &step))
+        {
+          ivs[n_ivs].reg = r;
+          ivs[n_ivs].increment = scan->counts.loop_def[r];
+          ivs[n_ivs].step = step;
+          n_ivs++;
+        }
+    }
+
+  size_t n_reduced = 0, reduced_alloced = 8;
+  ReducedIV *reduced = DBCC_NEW_ARRAY (reduced_alloced, ReducedIV);
+  for (unsigned b = 0; b < loop->n_blocks; b++)
+    {
+      DBCC_IR *next;
+      for (DBCC_IR *ir = loop->blocks[b]->first; ir != NULL; ir = next)
+        {
+          next = ir->next;
+          unsigned iv_index;
+          int64_t factor;
+          if (!is_scaled_iv (ir, ivs, n_ivs, &iv_index, &factor))
+            continue;
+          BasicIV *iv = ivs + iv_index;
+          DBCC_IR_Binary *mul = (DBCC_IR_Binary *) ir;
+          unsigned width = mul->dest.width;
+          ReducedIV *red = NULL;
+          for (size_t i = 0; i < n_reduced; i++)
+            if (reduced[i].iv == iv_index && reduced[i].factor == factor
+             && reduced[i].width == width)
+              red = reduced + i;
+          if (red == NULL)
+            {
+              if (n_reduced == reduced_alloced)
+                {
+                  reduced_alloced *= 2;
+                  reduced = realloc (reduced, sizeof (ReducedIV) * reduced_alloced);
+                }
+              red = reduced + n_reduced++;
+              red->iv = iv_index;
+              red->factor = factor;
+              red->width = width;
+              red->reg = dbcc_function_add_reg (f);
+              red->init = dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_MUL,
+                                              dbcc_location_reg (width, red->reg),
+                                              dbcc_location_reg (width, iv->reg),
+                                              dbcc_location_immed (width, factor));
+              append_to_preheader (loop, red->init);
+              DBCC_Location t = dbcc_location_reg (width, red->reg);
+              insert_after (iv->increment,
+                            dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, t, t,
+                                                dbcc_location_immed (width, iv->step * factor)));
+            }
+          replace_instruction (ir, dbcc_ir_new_move (mul->dest,
+                                                     dbcc_location_reg (width, red->reg)));
+          stats->n_strength_reduced++;
+        }
+    }
+
+  for (unsigned i = 0; i < n_ivs; i++)
+    for (size_t r = 0; r < n_reduced; r++)
+      if (reduced[r].iv == i
+       && try_eliminate_iv (f, loop, ivs + i, reduced, n_reduced, reduced + r))
+        {
+          stats->n_ivs_eliminated++;
+          break;
+        }
+  free (reduced);
+  free (ivs);
+}
+
+void
+dbcc_function_optimize_loops (DBCC_Function     *function,
+                              DBCC_IR_LoopStats *stats_out)
+{
+  DBCC_IR_LoopStats stats;
+  memset (&stats, 0, sizeof (stats));
+  DBCC_IR_LoopForest *forest = dbcc_function_find_loops (function);
+  DBCC_AliasInfo *alias = dbcc_alias_info_new (function);
+  stats.n_loops = forest->n_loops;
+
+  /* Inner loops first:  what leaves an inner loop lands in its
+   * preheader, which the enclosing loop then considers. */
+  for (unsigned i = 0; i < forest->n_loops; i++)
+    {
+      DBCC_IR_Loop *loop = forest->loops + i;
+      LoopScan scan;
+      loop_scan_init (&scan, function, loop, alias);
+      stats.n_hoisted += hoist_invariants (&scan, loop);
+      reduce_strength (function, &scan, loop, &stats);
+      loop_scan_clear (&scan);
+    }
+
+  dbcc_alias_info_destroy (alias);
+  dbcc_ir_loop_forest_destroy (forest);
+  if (stats_out != NULL)
+    *stats_out = stats;
+}
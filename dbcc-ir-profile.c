@@ -0,0 +1,299 @@
+#include "dbcc.h"
+#include <stdio.h>
+#include <errno.h>
+
+/* The feedback file is text, one line per function:
+ *
+ *     dbcc-profile 1
+ *     NAME CHECKSUM N_BLOCKS COUNT0 COUNT1 ...
+ *
+ * so that profiles can be inspected, diffed and merged by hand.
+ */
+#define PROFILE_MAGIC   "dbcc-profile 1\n"
+
+/* FNV-1a over the block structure:  what each instruction is, and
+ * where each jump goes.  Register numbers and operands are left
+ * out, so the checksum survives edits that don't change control flow.
+ */
+#define FNV_OFFSET      2166136261U
+#define FNV_PRIME       16777619U
+
+static uint32_t
+fnv_add (uint32_t hash, uint32_t value)
+{
+  for (unsigned i = 0; i < 4; i++)
+    {
+      hash ^= (value >> (8 * i)) & 0xff;
+      hash *= FNV_PRIME;
+    }
+  return hash;
+}
+
+uint32_t
+dbcc_function_get_checksum  (DBCC_Function    *function)
+{
+  uint32_t hash = FNV_OFFSET;
+  hash = fnv_add (hash, function->n_params);
+  hash = fnv_add (hash, function->n_blocks);
+  hash = fnv_add (hash, function->entry == NULL ? 0 : function->entry->index);
+  for (unsigned b = 0; b < function->n_blocks; b++)
+    for (DBCC_IR *ir = function->blocks[b]->first; ir != NULL; ir = ir->next)
+      {
+        hash = fnv_add (hash, ir->type);
+        if (ir->type == DBCC_IR_TYPE_JUMP)
+          hash = fnv_add (hash, ((DBCC_IR_Jump *) ir)->dst->index);
+        else if (ir->type == DBCC_IR_TYPE_JUMP_CONDITIONAL)
+          hash = fnv_add (hash, ((DBCC_IR_JumpConditional *) ir)->dst->index);
+      }
+  return hash;
+}
+
+/* --- Profiles --- */
+static DBCC_IR_Profile *
+profile_new (void)
+{
+  DBCC_IR_Profile *rv = DBCC_NEW (DBCC_IR_Profile);
+  rv->n_functions = 0;
+  rv->functions_alloced = 16;
+  rv->functions = DBCC_NEW_ARRAY (rv->functions_alloced, DBCC_IR_FunctionProfile);
+  dbcc_ptr_table_init (&rv->by_name);
+  return rv;
+}
+
+static DBCC_IR_FunctionProfile *
+profile_lookup (DBCC_IR_Profile *profile, DBCC_Symbol *name)
+{
+  uintptr_t slot_plus_1 = (uintptr_t) dbcc_ptr_table_lookup_value (&profile->by_name, name);
+  return slot_plus_1 == 0 ? NULL : profile->functions + slot_plus_1 - 1;
+}
+
+static DBCC_IR_FunctionProfile *
+profile_add (DBCC_IR_Profile *profile,
+             DBCC_Symbol     *name,
+             uint32_t         checksum,
+             unsigned         n_blocks)
+{
+  if (profile->n_functions == profile->functions_alloced)
+    {
+      profile->functions_alloced *= 2;
+      profile->functions = realloc (profile->functions,
+                                    sizeof (DBCC_IR_FunctionProfile)
+                                    * profile->functions_alloced);
+    }
+  DBCC_IR_FunctionProfile *fp = profile->functions + profile->n_functions++;
+  fp->name = name;
+  fp->checksum = checksum;
+  fp->n_blocks = n_blocks;
+  fp->counts = calloc (n_blocks + 1, sizeof (uint64_t));
+  dbcc_ptr_table_set (&profile->by_name, name,
+                      (void *) (uintptr_t) profile->n_functions);
+  return fp;
+}
+
+void
+dbcc_ir_profile_destroy     (DBCC_IR_Profile  *profile)
+{
+  for (size_t i = 0; i < profile->n_functions; i++)
+    free (profile->functions[i].counts);
+  free (profile->functions);
+  dbcc_ptr_table_clear (&profile->by_name);
+  free (profile);
+}
+
+/* --- Instrumentation --- */
+DBCC_IR_Profile *
+dbcc_ir_module_instrument   (DBCC_IR_Module   *module,
+                             DBCC_SymbolSpace *symbol_space)
+{
+  DBCC_Symbol *counter = dbcc_symbol_space_force (symbol_space,
+                                                  DBCC_IR_PROFILE_COUNT_FUNCTION);
+  DBCC_IR_Profile *profile = profile_new ();
+  for (size_t i = 0; i < module->n_functions; i++)
+    {
+      DBCC_Function *f = module->functions[i];
+      profile_add (profile, f->name, dbcc_function_get_checksum (f), f->n_blocks);
+      for (unsigned b = 0; b < f->n_blocks; b++)
+        {
+          DBCC_BB *bb = f->blocks[b];
+          DBCC_Location args[2] = {
+            dbcc_location_immed (2, profile->n_functions - 1),
+            dbcc_location_immed (2, b)
+          };
+          dbcc_bb_insert_before (bb, bb->first,
+                                 dbcc_ir_new_call_by_name (counter, 2, args, NULL));
+        }
+    }
+  return profile;
+}
+
+void
+dbcc_ir_profile_count       (DBCC_IR_Profile  *profile,
+                             unsigned          slot,
+                             unsigned          block_index)
+{
+  assert (slot < profile->n_functions);
+  assert (block_index < profile->functions[slot].n_blocks);
+  profile->functions[slot].counts[block_index]++;
+}
+
+/* --- Feedback files --- */
+bool
+dbcc_ir_profile_write       (DBCC_IR_Profile  *profile,
+                             const char       *filename,
+                             DBCC_Error      **error)
+{
+  FILE *fp = fopen (filename, "w");
+  if (fp == NULL)
+    {
+      *error = dbcc_error_new (DBCC_ERROR_WRITING_FILE,
+                               "error creating %s: %s",
+                               filename, strerror (errno));
+      return false;
+    }
+  fputs (PROFILE_MAGIC, fp);
+  for (size_t i = 0; i < profile->n_functions; i++)
+    {
+      DBCC_IR_FunctionProfile *f = profile->functions + i;
+      fprintf (fp, "%s %08x %u",
+               dbcc_symbol_get_string (f->name), f->checksum, f->n_blocks);
+      for (unsigned b = 0; b < f->n_blocks; b++)
+        fprintf (fp, " %llu", (unsigned long long) f->counts[b]);
+      fputc ('\n', fp);
+    }
+  bool failed = ferror (fp);
+  if (fclose (fp) != 0)
+    failed = true;
+  if (failed)
+    {
+      *error = dbcc_error_new (DBCC_ERROR_WRITING_FILE,
+                               "error writing %s: %s",
+                               filename, strerror (errno));
+      return false;
+    }
+  return true;
+}
+
+static bool
+parse_number (const char **at, unsigned base, uint64_t *out)
+{
+  const char *p = *at;
+  while (*p == ' ')
+    p++;
+  if (!dsk_ascii_isxdigit (*p))
+    return false;
+  char *end;
+  errno = 0;
+  unsigned long long v = strtoull (p, &end, base);
+  if (errno != 0)
+    return false;
+  *out = v;
+  *at = end;
+  return true;
+}
+
+DBCC_IR_Profile *
+dbcc_ir_profile_read        (DBCC_SymbolSpace *symbol_space,
+                             const char       *filename,
+                             DBCC_Error      **error)
+{
+  DskError *dsk_error = NULL;
+  size_t size;
+  uint8_t *contents = dsk_file_get_contents (filename, &size, &dsk_error);
+  if (contents == NULL)
+    {
+      *error = dbcc_error_new (DBCC_ERROR_READING_FILE, "%s", dsk_error->message);
+      dsk_error_unref (dsk_error);
+      return NULL;
+    }
+
+  /* dsk_file_get_contents() NUL-terminates, so strtoull() stops */
+  const char *at = (const char *) contents;
+  const char *end = at + size;
+  unsigned line_no = 1;
+  if (size < strlen (PROFILE_MAGIC)
+   || memcmp (at, PROFILE_MAGIC, strlen (PROFILE_MAGIC)) != 0)
+    goto bad_profile;
+  at += strlen (PROFILE_MAGIC);
+
+  DBCC_IR_Profile *profile = profile_new ();
+  while (at < end)
+    {
+      line_no++;
+      const char *name_end = at;
+      while (name_end < end && *name_end != ' ' && *name_end != '\n')
+        name_end++;
+      if (name_end == at || name_end == end || *name_end != ' ')
+        goto bad_profile_free;
+      DBCC_Symbol *name = dbcc_symbol_space_force_len (symbol_space, name_end - at, at);
+      at = name_end;
+
+      uint64_t checksum, n_blocks;
+      if (!parse_number (&at, 16, &checksum)
+       || checksum > UINT32_MAX
+       || !parse_number (&at, 10, &n_blocks)
+       || n_blocks > UINT32_MAX
+       || profile_lookup (profile, name) != NULL)
+        goto bad_profile_free;
+      DBCC_IR_FunctionProfile *f = profile_add (profile, name, checksum, n_blocks);
+      for (unsigned b = 0; b < n_blocks; b++)
+        if (!parse_number (&at, 10, f->counts + b))
+          goto bad_profile_free;
+      if (at == end || *at != '\n')
+        goto bad_profile_free;
+      at++;
+    }
+  free (contents);
+  return profile;
+
+bad_profile_free:
+  dbcc_ir_profile_destroy (profile);
+bad_profile:
+  free (contents);
+  *error = dbcc_error_new (DBCC_ERROR_BAD_PROFILE,
+                           "%s:%u: malformed profile", filename, line_no);
+  return NULL;
+}
+
+bool
+dbcc_ir_profile_merge       (DBCC_IR_Profile  *into,
+                             DBCC_IR_Profile  *profile,
+                             DBCC_Error      **error)
+{
+  for (size_t i = 0; i < profile->n_functions; i++)
+    {
+      DBCC_IR_FunctionProfile *src = profile->functions + i;
+      DBCC_IR_FunctionProfile *dst = profile_lookup (into, src->name);
+      if (dst == NULL)
+        dst = profile_add (into, src->name, src->checksum, src->n_blocks);
+      else if (dst->checksum != src->checksum || dst->n_blocks != src->n_blocks)
+        {
+          *error = dbcc_error_new (DBCC_ERROR_BAD_PROFILE,
+                                   "profiles of %s are from different builds",
+                                   dbcc_symbol_get_string (src->name));
+          return false;
+        }
+      for (unsigned b = 0; b < src->n_blocks; b++)
+        dst->counts[b] += src->counts[b];
+    }
+  return true;
+}
+
+size_t
+dbcc_ir_module_apply_profile(DBCC_IR_Module   *module,
+                             DBCC_IR_Profile  *profile)
+{
+  size_t rv = 0;
+  for (size_t i = 0; i < module->n_functions; i++)
+    {
+      DBCC_Function *f = module->functions[i];
+      DBCC_IR_FunctionProfile *fp = profile_lookup (profile, f->name);
+      f->has_profile = fp != NULL
+                    && fp->n_blocks == f->n_blocks
+                    && fp->checksum == dbcc_function_get_checksum (f);
+      for (unsigned b = 0; b < f->n_blocks; b++)
+        f->blocks[b]->count = f->has_profile ? fp->counts[b] : 0;
+      if (f->has_profile)
+        rv++;
+    }
+  return rv;
+}
@@ -0,0 +1,474 @@
+#include "dbcc.h"
+#include <limits.h>
+
+/* The loops handled are those the front end emits for
+ *
+ *     for (i = 0; i < n; i++)
+ *       d[i] = a[i] OP b[i] ...;
+ *
+ * namely a two-block loop:
+ *
+ *   header:  c = i >= N;  if (c) goto exit;  goto body;
+ *       (or  c = i < N;   if (c) goto body;  goto exit;)
+ *   body:    off = i * SIZE;  p = base + off;  x = *p;  ...
+ *            *q = y;  i = i + 1;  goto header;
+ *
+ * where every value computed in the body is a lane:  loaded from
+ * the current element, or computed from lanes and loop invariants.
+ * Nothing may be carried from one iteration to the next (so no
+ * reductions), and nothing computed in the body may be read after
+ * the loop.
+ *
+ * The vector loop goes in front of the original, which is left to
+ * finish the last few iterations:
+ *
+ *   vheader: t = i + VF;  if (t > N) goto header;  goto vbody;
+ *   vbody:   off = i * SIZE;  p = base + off;  X = *p (VF lanes);  ...
+ *            i = i + VF;  goto vheader;
+ *
+ * Supported operations are those SSE2 has for every lane size:
+ * add, subtract, the bitwise operations and left shift by a
+ * constant, plus 16-bit multiply.  AVX2 adds 32-bit multiply.
+ */
+
+typedef enum
+{
+  KIND_NONE,
+  KIND_INDEX,                   /* i * scale */
+  KIND_ADDRESS,                 /* invariant + i * scale */
+  KIND_LANE                     /* element-wise value */
+} ValueKind;
+
+typedef struct
+{
+  DBCC_Function *function;
+  DBCC_IR_Loop *loop;
+  DBCC_AliasInfo *alias;
+  unsigned vector_size;
+  unsigned vector_width;        /* log2 (vector_size) */
+
+  unsigned *defs_in_loop;
+  ValueKind *kinds;
+  int64_t *scales;              /* for INDEX and ADDRESS */
+  unsigned element_width;       /* of every lane;  UINT_MAX until seen */
+
+  unsigned iv;
+  DBCC_Location iv_loc;
+  DBCC_Location bound;
+  DBCC_BB *body;
+  DBCC_IR *increment;
+
+  size_t n_accesses;
+  DBCC_Location *accesses;
+  bool *is_store;
+} VectorizeState;
+
+static void
+count_loop_def (DBCC_IR *ir, unsigned reg, bool is_def, void *data)
+{
+  VectorizeState *state = data;
+  if (is_def && dbcc_ir_loop_contains (state->loop, ir->owner))
+    state->defs_in_loop[reg]++;
+}
+
+static void
+check_use_outside (DBCC_IR *ir, unsigned reg, bool is_def, void *data)
+{
+  VectorizeState *state = data;
+  (void) ir;
+  if (!is_def && state->kinds[reg] != KIND_NONE)
+    state->kinds[reg] = KIND_NONE;      /* live out:  give up */
+}
+
+static bool
+is_invariant (VectorizeState *state, const DBCC_Location *loc)
+{
+  if (loc->type == DBCC_LOCATION_IMMED)
+    return true;
+  return loc->type == DBCC_LOCATION_REG
+      && state->defs_in_loop[loc->info.v_reg] == 0;
+}
+
+static bool
+is_kind (VectorizeState *state, const DBCC_Location *loc, ValueKind kind)
+{
+  return loc->type == DBCC_LOCATION_REG && state->kinds[loc->info.v_reg] == kind;
+}
+
+static bool
+set_element_width (VectorizeState *state, unsigned width)
+{
+  if (state->element_width == UINT_MAX)
+    state->element_width = width;
+  return state->element_width == width;
+}
+
+static bool
+lane_op_supported (VectorizeState *state, const DBCC_IR_Binary *b)
+{
+  unsigned ew = state->element_width;
+  switch (b->op)
+    {
+    case DBCC_BINARY_OPERATOR_ADD:
+    case DBCC_BINARY_OPERATOR_SUB:
+    case DBCC_BINARY_OPERATOR_BITWISE_AND:
+    case DBCC_BINARY_OPERATOR_BITWISE_OR:
+    case DBCC_BINARY_OPERATOR_BITWISE_XOR:
+      return true;
+    case DBCC_BINARY_OPERATOR_MUL:
+      /* pmullw;  vpmulld needs AVX2 (or SSE4.1) */
+      return ew == 1 || (ew == 2 && state->vector_size >= DBCC_TARGET_VECTOR_SIZE_AVX2);
+    case DBCC_BINARY_OPERATOR_SHIFT_LEFT:
+      return ew >= 1 && b->source2.type == DBCC_LOCATION_IMMED;
+    default:
+      return false;
+    }
+}
+
+static void
+add_access (VectorizeState *state, const DBCC_Location *loc, bool is_store)
+{
+  state->accesses[state->n_accesses] = *loc;
+  state->is_store[state->n_accesses] = is_store;
+  state->n_accesses++;
+}
+
+/* Index, address, load, lane operation or store:  classify the
+ * value 'ir' defines, or fail.
+ */
+static bool
+classify (VectorizeState *state, DBCC_IR *ir)
+{
+  if (ir->type == DBCC_IR_TYPE_BINARY)
+    {
+      DBCC_IR_Binary *b = (DBCC_IR_Binary *) ir;
+      if (b->dest.type != DBCC_LOCATION_REG)
+        return false;
+      unsigned d = b->dest.info.v_reg;
+      if (d == state->iv || state->defs_in_loop[d] != 1)
+        return false;
+      const DBCC_Location *s1 = &b->source1, *s2 = &b->source2;
+      bool s1_iv = s1->type == DBCC_LOCATION_REG && s1->info.v_reg == state->iv;
+      bool s2_iv = s2->type == DBCC_LOCATION_REG && s2->info.v_reg == state->iv;
+
+      if (b->op == DBCC_BINARY_OPERATOR_MUL
+       && ((s1_iv && s2->type == DBCC_LOCATION_IMMED)
+        || (s2_iv && s1->type == DBCC_LOCATION_IMMED)))
+        {
+          state->kinds[d] = KIND_INDEX;
+          state->scales[d] = dbcc_location_get_immed (s1_iv ? s2 : s1);
+          return true;
+        }
+      if (b->op == DBCC_BINARY_OPERATOR_SHIFT_LEFT
+       && s1_iv && s2->type == DBCC_LOCATION_IMMED)
+        {
+          int64_t shift = dbcc_location_get_immed (s2);
+          if (shift < 0 || shift > 8)
+            return false;
+          state->kinds[d] = KIND_INDEX;
+          state->scales[d] = (int64_t) 1 << shift;
+          return true;
+        }
+      if (b->op == DBCC_BINARY_OPERATOR_ADD
+       && s1->type == DBCC_LOCATION_REG && s2->type == DBCC_LOCATION_REG)
+        {
+          const DBCC_Location *index = is_kind (state, s1, KIND_INDEX) ? s1 : s2;
+          const DBCC_Location *base = index == s1 ? s2 : s1;
+          if (is_kind (state, index, KIND_INDEX) && is_invariant (state, base))
+            {
+              state->kinds[d] = KIND_ADDRESS;
+              state->scales[d] = state->scales[index->info.v_reg];
+              return true;
+            }
+        }
+
+      /* a lane operation */
+      bool any_lane = false;
+      const DBCC_Location *srcs[2] = { s1, s2 };
+      for (unsigned i = 0; i < 2; i++)
+        if (is_kind (state, srcs[i], KIND_LANE))
+          any_lane = true;
+        else if (!is_invariant (state, srcs[i]))
+          return false;
+      if (!any_lane
+       || !set_element_width (state, b->dest.width)
+       || !lane_op_supported (state, b))
+        return false;
+      state->kinds[d] = KIND_LANE;
+      return true;
+    }
+
+  if (ir->type == DBCC_IR_TYPE_UNARY)
+    {
+      DBCC_IR_Unary *u = (DBCC_IR_Unary *) ir;
+      if (u->op != DBCC_UNARY_OPERATOR_NOOP)
+        return false;
+      if (u->dest.type == DBCC_LOCATION_REG && u->source.type == DBCC_LOCATION_PTR)
+        {
+          /* load a[i] */
+          unsigned d = u->dest.info.v_reg;
+          unsigned p = u->source.info.v_ptr;
+          if (state->defs_in_loop[d] != 1
+           || state->kinds[p] != KIND_ADDRESS
+           || state->scales[p] != (1 << u->source.width)
+           || u->dest.width != u->source.width
+           || !set_element_width (state, u->source.width))
+            return false;
+          state->kinds[d] = KIND_LANE;
+          add_access (state, &u->source, false);
+          return true;
+        }
+      if (u->dest.type == DBCC_LOCATION_PTR && is_kind (state, &u->source, KIND_LANE))
+        {
+          /* store d[i] */
+          unsigned p = u->dest.info.v_ptr;
+          if (state->kinds[p] != KIND_ADDRESS
+           || state->scales[p] != (1 << u->dest.width)
+           || !set_element_width (state, u->dest.width))
+            return false;
+          add_access (state, &u->dest, true);
+          return true;
+        }
+    }
+  return false;
+}
+
+/* Every iteration touches its own element of each array, so
+ * lanes are independent unless two arrays overlap:  each store
+ * must either use the same address register as the other access
+ * or be proven apart from it.
+ */
+static bool
+accesses_independent (VectorizeState *state)
+{
+  for (size_t i = 0; i < state->n_accesses; i++)
+    if (state->is_store[i])
+      for (size_t j = 0; j < state->n_accesses; j++)
+        {
+          if (i == j)
+            continue;
+          const DBCC_Location *a = state->accesses + i;
+          const DBCC_Location *b = state->accesses + j;
+          if (a->info.v_ptr == b->info.v_ptr)
+            continue;
+          if (dbcc_alias_info_query (state->alias, a, b) != DBCC_ALIAS_NO)
+            return false;
+        }
+  return true;
+}
+
+/* Match the header and the increment;  see the comment at the top. */
+static bool
+match_loop_shape (VectorizeState *state)
+{
+  DBCC_IR_Loop *loop = state->loop;
+  if (loop->n_blocks != 2)
+    return false;
+  DBCC_BB *header = loop->header;
+  DBCC_BB *body = loop->blocks[0] == header ? loop->blocks[1] : loop->blocks[0];
+
+  DBCC_IR *cmp_ir = header->first;
+  if (cmp_ir == NULL || cmp_ir->type != DBCC_IR_TYPE_BINARY
+   || cmp_ir->next == NULL || cmp_ir->next->type != DBCC_IR_TYPE_JUMP_CONDITIONAL
+   || cmp_ir->next->next != header->last || header->last->type != DBCC_IR_TYPE_JUMP)
+    return false;
+  DBCC_IR_Binary *cmp = (DBCC_IR_Binary *) cmp_ir;
+  DBCC_IR_JumpConditional *jc = (DBCC_IR_JumpConditional *) cmp_ir->next;
+  DBCC_IR_Jump *j = (DBCC_IR_Jump *) header->last;
+  if (cmp->dest.type != DBCC_LOCATION_REG || jc->reg != cmp->dest.info.v_reg
+   || cmp->source1.type != DBCC_LOCATION_REG)
+    return false;
+  if (cmp->op == DBCC_BINARY_OPERATOR_GTEQ)
+    {
+      if (jc->dst == body || j->dst != body)
+        return false;
+    }
+  else if (cmp->op == DBCC_BINARY_OPERATOR_LT)
+    {
+      if (jc->dst != body || j->dst == body)
+        return false;
+    }
+  else
+    return false;
+
+  state->iv = cmp->source1.info.v_reg;
+  state->iv_loc = cmp->source1;
+  state->bound = cmp->source2;
+  if (!is_invariant (state, &state->bound))
+    return false;
+
+  /* body ends "i = i + 1;  goto header" */
+  DBCC_IR *last = body->last;
+  if (last == NULL || last->type != DBCC_IR_TYPE_JUMP
+   || ((DBCC_IR_Jump *) last)->dst != header
+   || last->prev == NULL || last->prev->type != DBCC_IR_TYPE_BINARY)
+    return false;
+  DBCC_IR_Binary *inc = (DBCC_IR_Binary *) last->prev;
+  if (inc->op != DBCC_BINARY_OPERATOR_ADD
+   || inc->dest.type != DBCC_LOCATION_REG || inc->dest.info.v_reg != state->iv
+   || inc->source1.type != DBCC_LOCATION_REG || inc->source1.info.v_reg != state->iv
+   || inc->source2.type != DBCC_LOCATION_IMMED
+   || dbcc_location_get_immed (&inc->source2) != 1
+   || state->defs_in_loop[state->iv] != 1)
+    return false;
+  state->body = body;
+  state->increment = last->prev;
+  return true;
+}
+
+static DBCC_Location
+lane_location (VectorizeState *state, unsigned *vregs, const DBCC_Location *loc)
+{
+  if (is_kind (state, loc, KIND_LANE))
+    return dbcc_location_reg (state->vector_width, vregs[loc->info.v_reg]);
+  return *loc;
+}
+
+static void
+emit_vector_loop (VectorizeState *state)
+{
+  DBCC_Function *f = state->function;
+  DBCC_IR_Loop *loop = state->loop;
+  unsigned vf = state->vector_size >> state->element_width;
+  unsigned vw = state->vector_width;
+
+  unsigned n_regs = f->n_regs;
+  unsigned *vregs = calloc (n_regs + 1, sizeof (unsigned));
+  for (unsigned r = 0; r < n_regs; r++)
+    if (state->kinds[r] == KIND_LANE)
+      vregs[r] = dbcc_function_add_regs (f, state->vector_size / 8);
+
+  DBCC_BB *vheader = dbcc_function_add_block (f);
+  DBCC_BB *vbody = dbcc_function_add_block (f);
+
+  unsigned iv_width = state->iv_loc.width;
+  DBCC_Location t = dbcc_location_reg (iv_width, dbcc_function_add_reg (f));
+  unsigned cv = dbcc_function_add_reg (f);
+  dbcc_bb_append (vheader, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, t,
+                                               state->iv_loc,
+                                               dbcc_location_immed (iv_width, vf)));
+  dbcc_bb_append (vheader, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_GT,
+                                               dbcc_location_reg (0, cv),
+                                               t, state->bound));
+  dbcc_bb_append (vheader, dbcc_ir_new_jump_conditional (cv, loop->header));
+  dbcc_bb_append (vheader, dbcc_ir_new_jump (vbody));
+
+  for (DBCC_IR *ir = state->body->first; ir != state->increment; ir = ir->next)
+    {
+      if (ir->type == DBCC_IR_TYPE_UNARY)
+        {
+          DBCC_IR_Unary *u = (DBCC_IR_Unary *) ir;
+          DBCC_Location dest = u->dest, src = u->source;
+          if (dest.type == DBCC_LOCATION_PTR)
+            dest.width = vw;
+          else
+            dest = lane_location (state, vregs, &dest);
+          if (src.type == DBCC_LOCATION_PTR)
+            src.width = vw;
+          else
+            src = lane_location (state, vregs, &src);
+          dbcc_bb_append (vbody, dbcc_ir_new_move (dest, src));
+          continue;
+        }
+      DBCC_IR_Binary *b = (DBCC_IR_Binary *) ir;
+      if (state->kinds[b->dest.info.v_reg] != KIND_LANE)
+        {
+          dbcc_bb_append (vbody, dbcc_ir_copy (ir));
+          continue;
+        }
+      dbcc_bb_append (vbody,
+                      dbcc_ir_new_vector_binary (b->op, state->element_width,
+                                                 lane_location (state, vregs, &b->dest),
+                                                 lane_location (state, vregs, &b->source1),
+                                                 lane_location (state, vregs, &b->source2)));
+    }
+  dbcc_bb_append (vbody, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD,
+                                             state->iv_loc, state->iv_loc,
+                                             dbcc_location_immed (iv_width, vf)));
+  dbcc_bb_append (vbody, dbcc_ir_new_jump (vheader));
+
+  dbcc_bb_retarget_jumps (loop->preheader, loop->header, vheader);
+  free (vregs);
+}
+
+static bool
+try_vectorize (DBCC_Function  *f,
+               DBCC_IR_Loop   *loop,
+               DBCC_AliasInfo *alias,
+               unsigned        vector_size)
+{
+  VectorizeState state;
+  state.function = f;
+  state.loop = loop;
+  state.alias = alias;
+  state.vector_size = vector_size;
+  state.vector_width = 0;
+  while ((1U << state.vector_width) < vector_size)
+    state.vector_width++;
+  state.defs_in_loop = calloc (f->n_regs + 1, sizeof (unsigned));
+  state.kinds = calloc (f->n_regs + 1, sizeof (ValueKind));
+  state.scales = calloc (f->n_regs + 1, sizeof (int64_t));
+  state.element_width = UINT_MAX;
+  state.n_accesses = 0;
+  size_t max_accesses = dbcc_function_get_n_instructions (f) + 1;
+  state.accesses = DBCC_NEW_ARRAY (max_accesses, DBCC_Location);
+  state.is_store = DBCC_NEW_ARRAY (max_accesses, bool);
+  for (unsigned b = 0; b < f->n_blocks; b++)
+    for (DBCC_IR *ir = f->blocks[b]->first; ir != NULL; ir = ir->next)
+      dbcc_ir_foreach_reg (ir, count_loop_def, &state);
+
+  /* not worth the code:  the loop never ran */
+  bool ok = !f->has_profile || loop->header->count > 0;
+  ok = ok && match_loop_shape (&state);
+  for (DBCC_IR *ir = ok ? state.body->first : NULL;
+       ir != NULL && ir != state.increment && ok;
+       ir = ir->next)
+    ok = classify (&state, ir);
+  ok = ok && state.n_accesses > 0
+          && state.element_width <= 3
+          && (vector_size >> state.element_width) >= 2
+          && accesses_independent (&state);
+
+  if (ok)
+    {
+      /* nothing computed per-lane may be read after the loop */
+      unsigned n_before = 0, n_after = 0;
+      for (unsigned r = 0; r < f->n_regs; r++)
+        n_before += state.kinds[r] != KIND_NONE;
+      for (unsigned b = 0; b < f->n_blocks; b++)
+        if (!dbcc_ir_loop_contains (loop, f->blocks[b]))
+          for (DBCC_IR *ir = f->blocks[b]->first; ir != NULL; ir = ir->next)
+            dbcc_ir_foreach_reg (ir, check_use_outside, &state);
+      for (unsigned r = 0; r < f->n_regs; r++)
+        n_after += state.kinds[r] != KIND_NONE;
+      ok = n_before == n_after;
+    }
+  if (ok)
+    emit_vector_loop (&state);
+
+  free (state.defs_in_loop);
+  free (state.kinds);
+  free (state.scales);
+  free (state.accesses);
+  free (state.is_store);
+  return ok;
+}
+
+size_t
+dbcc_function_vectorize_loops (DBCC_Function                *function,
+                               const DBCC_TargetEnvironment *target_env)
+{
+  unsigned vector_size = target_env->max_vector_size;
+  if (vector_size < DBCC_TARGET_VECTOR_SIZE_SSE2)
+    return 0;
+
+  DBCC_IR_LoopForest *forest = dbcc_function_find_loops (function);
+  DBCC_AliasInfo *alias = dbcc_alias_info_new (function);
+  size_t rv = 0;
+  for (unsigned i = 0; i < forest->n_loops; i++)
+    if (try_vectorize (function, forest->loops + i, alias, vector_size))
+      rv++;
+  dbcc_alias_info_destroy (alias);
+  dbcc_ir_loop_forest_destroy (forest);
+  return rv;
+}
@@ -0,0 +1,565 @@
+#include "dbcc.h"
+
+/* --- Locations --- */
+DBCC_Location
+dbcc_location_reg   (unsigned width, unsigned reg)
+{
+  DBCC_Location rv;
+  memset (&rv, 0, sizeof (rv));
+  rv.type = DBCC_LOCATION_REG;
+  rv.width = width;
+  rv.info.v_reg = reg;
+  return rv;
+}
+
+DBCC_Location
+dbcc_location_ptr   (unsigned width, unsigned reg)
+{
+  DBCC_Location rv;
+  memset (&rv, 0, sizeof (rv));
+  rv.type = DBCC_LOCATION_PTR;
+  rv.width = width;
+  rv.info.v_ptr = reg;
+  return rv;
+}
+
+DBCC_Location
+dbcc_location_immed (unsigned width, int64_t value)
+{
+  DBCC_Location rv;
+  rv.type = DBCC_LOCATION_IMMED;
+  rv.width = width;
+  uint64_t v = value;
+  for (unsigned i = 0; i < 8; i++)
+    rv.info.v_immed[i] = (uint8_t) (v >> (8*i));
+  return rv;
+}
+
+/* Sign-extended from the location's width. */
+int64_t
+dbcc_location_get_immed (const DBCC_Location *location)
+{
+  assert (location->type == DBCC_LOCATION_IMMED);
+  unsigned n_bytes = 1U << location->width;
+  uint64_t v = 0;
+  for (unsigned i = 0; i < n_bytes; i++)
+    v |= (uint64_t) location->info.v_immed[i] << (8*i);
+  if (n_bytes < 8)
+    {
+      uint64_t sign = (uint64_t) 1 << (8 * n_bytes - 1);
+      v = (v ^ sign) - sign;
+    }
+  return (int64_t) v;
+}
+
+/* --- Functions and blocks --- */
+DBCC_Function *
+dbcc_function_new      (DBCC_Symbol   *name,
+                        unsigned       n_params,
+                        DBCC_Function_Flags flags)
+{
+  DBCC_Function *rv = DBCC_NEW (DBCC_Function);
+  rv->name = name;
+  rv->n_blocks = 0;
+  rv->blocks_alloced = 8;
+  rv->blocks = DBCC_NEW_ARRAY (rv->blocks_alloced, DBCC_BB *);
+  rv->entry = NULL;
+  rv->flags = flags;
+  rv->n_params = n_params;
+  rv->param_flags = calloc (n_params + 1, sizeof (DBCC_Function_ParamFlags));
+  rv->n_regs = n_params;
+  rv->has_profile = false;
+  return rv;
+}
+
+/* The first block added is the entry block. */
+DBCC_BB *
+dbcc_function_add_block(DBCC_Function *function)
+{
+  if (function->n_blocks == function->blocks_alloced)
+    {
+      function->blocks_alloced *= 2;
+      function->blocks = realloc (function->blocks,
+                                  sizeof (DBCC_BB *) * function->blocks_alloced);
+    }
+  DBCC_BB *bb = DBCC_NEW (DBCC_BB);
+  bb->first = bb->last = NULL;
+  bb->function = function;
+  bb->index = function->n_blocks;
+  bb->count = 0;
+  function->blocks[function->n_blocks++] = bb;
+  if (function->entry == NULL)
+    function->entry = bb;
+  return bb;
+}
+
+unsigned
+dbcc_function_add_reg  (DBCC_Function *function)
+{
+  return function->n_regs++;
+}
+
+/* Consecutive registers, as for a vector. */
+unsigned
+dbcc_function_add_regs (DBCC_Function *function,
+                        unsigned       n)
+{
+  unsigned rv = function->n_regs;
+  function->n_regs += n;
+  return rv;
+}
+
+void
+dbcc_function_destroy  (DBCC_Function *function)
+{
+  for (unsigned i = 0; i < function->n_blocks; i++)
+    {
+      DBCC_BB *bb = function->blocks[i];
+      DBCC_IR *ir = bb->first;
+      while (ir != NULL)
+        {
+          DBCC_IR *next = ir->next;
+          dbcc_ir_free (ir);
+          ir = next;
+        }
+      free (bb);
+    }
+  free (function->blocks);
+  free (function->param_flags);
+  free (function);
+}
+
+void
+dbcc_function_set_param_flags (DBCC_Function *function,
+                               unsigned       param_index,
+                               DBCC_Function_ParamFlags flags)
+{
+  assert (param_index < function->n_params);
+  function->param_flags[param_index] = flags;
+}
+
+size_t
+dbcc_function_get_n_instructions (DBCC_Function *function)
+{
+  size_t rv = 0;
+  for (unsigned i = 0; i < function->n_blocks; i++)
+    for (DBCC_IR *ir = function->blocks[i]->first; ir != NULL; ir = ir->next)
+      rv++;
+  return rv;
+}
+
+void
+dbcc_bb_append       (DBCC_BB       *bb,
+                      DBCC_IR       *ir)
+{
+  ir->owner = bb;
+  ir->next = NULL;
+  ir->prev = bb->last;
+  if (bb->last != NULL)
+    bb->last->next = ir;
+  else
+    bb->first = ir;
+  bb->last = ir;
+}
+
+void
+dbcc_bb_insert_before(DBCC_BB       *bb,
+                      DBCC_IR       *at,
+                      DBCC_IR       *ir)
+{
+  assert (at->owner == bb);
+  ir->owner = bb;
+  ir->next = at;
+  ir->prev = at->prev;
+  if (at->prev != NULL)
+    at->prev->next = ir;
+  else
+    bb->first = ir;
+  at->prev = ir;
+}
+
+/* Unlinks 'ir' without freeing it. */
+void
+dbcc_bb_remove       (DBCC_BB       *bb,
+                      DBCC_IR       *ir)
+{
+  assert (ir->owner == bb);
+  if (ir->prev != NULL)
+    ir->prev->next = ir->next;
+  else
+    bb->first = ir->next;
+  if (ir->next != NULL)
+    ir->next->prev = ir->prev;
+  else
+    bb->last = ir->prev;
+  ir->prev = ir->next = NULL;
+  ir->owner = NULL;
+}
+
+void
+dbcc_bb_retarget_jumps (DBCC_BB     *bb,
+                        DBCC_BB     *from,
+                        DBCC_BB     *to)
+{
+  for (DBCC_IR *ir = bb->first; ir != NULL; ir = ir->next)
+    if (ir->type == DBCC_IR_TYPE_JUMP && ((DBCC_IR_Jump *) ir)->dst == from)
+      ((DBCC_IR_Jump *) ir)->dst = to;
+    else if (ir->type == DBCC_IR_TYPE_JUMP_CONDITIONAL
+          && ((DBCC_IR_JumpConditional *) ir)->dst == from)
+      ((DBCC_IR_JumpConditional *) ir)->dst = to;
+}
+
+/* --- Instructions --- */
+static void *
+ir_alloc (DBCC_IR_Type type, size_t size)
+{
+  DBCC_IR *rv = malloc (size);
+  rv->type = type;
+  rv->prev = rv->next = NULL;
+  rv->owner = NULL;
+  return rv;
+}
+
+static DBCC_Location *
+copy_args (unsigned n_args, const DBCC_Location *args)
+{
+  if (n_args == 0)
+    return NULL;
+  DBCC_Location *rv = DBCC_NEW_ARRAY (n_args, DBCC_Location);
+  memcpy (rv, args, sizeof (DBCC_Location) * n_args);
+  return rv;
+}
+
+DBCC_IR *
+dbcc_ir_new_unary    (DBCC_UnaryOperator  op,
+                      DBCC_Location       dest,
+                      DBCC_Location       source)
+{
+  DBCC_IR_Unary *rv = ir_alloc (DBCC_IR_TYPE_UNARY, sizeof (DBCC_IR_Unary));
+  rv->op = op;
+  rv->dest = dest;
+  rv->source = source;
+  return &rv->base;
+}
+
+DBCC_IR *
+dbcc_ir_new_move     (DBCC_Location       dest,
+                      DBCC_Location       source)
+{
+  return dbcc_ir_new_unary (DBCC_UNARY_OPERATOR_NOOP, dest, source);
+}
+
+DBCC_IR *
+dbcc_ir_new_binary   (DBCC_BinaryOperator op,
+                      DBCC_Location       dest,
+                      DBCC_Location       source1,
+                      DBCC_Location       source2)
+{
+  DBCC_IR_Binary *rv = ir_alloc (DBCC_IR_TYPE_BINARY, sizeof (DBCC_IR_Binary));
+  rv->op = op;
+  rv->dest = dest;
+  rv->source1 = source1;
+  rv->source2 = source2;
+  return &rv->base;
+}
+
+DBCC_IR *
+dbcc_ir_new_vector_binary (DBCC_BinaryOperator op,
+                           unsigned            element_width,
+                           DBCC_Location       dest,
+                           DBCC_Location       source1,
+                           DBCC_Location       source2)
+{
+  DBCC_IR_VectorBinary *rv = ir_alloc (DBCC_IR_TYPE_VECTOR_BINARY,
+                                       sizeof (DBCC_IR_VectorBinary));
+  assert (element_width < dest.width);
+  rv->op = op;
+  rv->element_width = element_width;
+  rv->dest = dest;
+  rv->source1 = source1;
+  rv->source2 = source2;
+  return &rv->base;
+}
+
+DBCC_IR *
+dbcc_ir_new_jump     (DBCC_BB            *dst)
+{
+  DBCC_IR_Jump *rv = ir_alloc (DBCC_IR_TYPE_JUMP, sizeof (DBCC_IR_Jump));
+  rv->dst = dst;
+  return &rv->base;
+}
+
+DBCC_IR *
+dbcc_ir_new_jump_conditional (unsigned    reg,
+                              DBCC_BB            *dst)
+{
+  DBCC_IR_JumpConditional *rv = ir_alloc (DBCC_IR_TYPE_JUMP_CONDITIONAL,
+                                          sizeof (DBCC_IR_JumpConditional));
+  rv->reg = reg;
+  rv->dst = dst;
+  return &rv->base;
+}
+
+DBCC_IR *
+dbcc_ir_new_call_by_name (DBCC_Symbol   *name,
+                          unsigned            n_args,
+                          const DBCC_Location *args,
+                          const DBCC_Location *optional_result)
+{
+  DBCC_IR_CallByName *rv = ir_alloc (DBCC_IR_TYPE_CALL_BY_NAME,
+                                     sizeof (DBCC_IR_CallByName));
+  rv->name = name;
+  rv->n_args = n_args;
+  rv->args = copy_args (n_args, args);
+  rv->has_result = optional_result != NULL;
+  if (optional_result != NULL)
+    rv->result = *optional_result;
+  return &rv->base;
+}
+
+DBCC_IR *
+dbcc_ir_new_call_by_pointer (unsigned    reg,
+                             unsigned            n_args,
+                             const DBCC_Location *args,
+                             const DBCC_Location *optional_result)
+{
+  DBCC_IR_CallByPointer *rv = ir_alloc (DBCC_IR_TYPE_CALL_BY_POINTER,
+                                        sizeof (DBCC_IR_CallByPointer));
+  rv->reg = reg;
+  rv->n_args = n_args;
+  rv->args = copy_args (n_args, args);
+  rv->has_result = optional_result != NULL;
+  if (optional_result != NULL)
+    rv->result = *optional_result;
+  return &rv->base;
+}
+
+DBCC_IR *
+dbcc_ir_new_return_void (void)
+{
+  DBCC_IR_ReturnVoid *rv = ir_alloc (DBCC_IR_TYPE_RETURN_VOID,
+                                     sizeof (DBCC_IR_ReturnVoid));
+  return &rv->base;
+}
+
+DBCC_IR *
+dbcc_ir_new_return_reg (unsigned reg)
+{
+  DBCC_IR_ReturnReg *rv = ir_alloc (DBCC_IR_TYPE_RETURN_REG,
+                                    sizeof (DBCC_IR_ReturnReg));
+  rv->reg = reg;
+  return &rv->base;
+}
+
+/* The copy is unlinked;  block targets still point at the
+ * original blocks.
+ */
+DBCC_IR *
+dbcc_ir_copy         (const DBCC_IR      *ir)
+{
+  switch (ir->type)
+    {
+    case DBCC_IR_TYPE_UNARY:
+      {
+        const DBCC_IR_Unary *u = (const DBCC_IR_Unary *) ir;
+        return dbcc_ir_new_unary (u->op, u->dest, u->source);
+      }
+    case DBCC_IR_TYPE_BINARY:
+      {
+        const DBCC_IR_Binary *b = (const DBCC_IR_Binary *) ir;
+        return dbcc_ir_new_binary (b->op, b->dest, b->source1, b->source2);
+      }
+    case DBCC_IR_TYPE_JUMP:
+      return dbcc_ir_new_jump (((const DBCC_IR_Jump *) ir)->dst);
+    case DBCC_IR_TYPE_JUMP_CONDITIONAL:
+      {
+        const DBCC_IR_JumpConditional *j = (const DBCC_IR_JumpConditional *) ir;
+        return dbcc_ir_new_jump_conditional (j->reg, j->dst);
+      }
+    case DBCC_IR_TYPE_CALL_BY_NAME:
+      {
+        const DBCC_IR_CallByName *c = (const DBCC_IR_CallByName *) ir;
+        return dbcc_ir_new_call_by_name (c->name, c->n_args, c->args,
+                                         c->has_result ? &c->result : NULL);
+      }
+    case DBCC_IR_TYPE_CALL_BY_POINTER:
+      {
+        const DBCC_IR_CallByPointer *c = (const DBCC_IR_CallByPointer *) ir;
+        return dbcc_ir_new_call_by_pointer (c->reg, c->n_args, c->args,
+                                            c->has_result ? &c->result : NULL);
+      }
+    case DBCC_IR_TYPE_RETURN_VOID:
+      return dbcc_ir_new_return_void ();
+    case DBCC_IR_TYPE_RETURN_REG:
+      return dbcc_ir_new_return_reg (((const DBCC_IR_ReturnReg *) ir)->reg);
+    case DBCC_IR_TYPE_VECTOR_BINARY:
+      {
+        const DBCC_IR_VectorBinary *v = (const DBCC_IR_VectorBinary *) ir;
+        return dbcc_ir_new_vector_binary (v->op, v->element_width,
+                                          v->dest, v->source1, v->source2);
+      }
+    }
+  assert (0);
+  return NULL;
+}
+
+void
+dbcc_ir_free         (DBCC_IR            *ir)
+{
+  switch (ir->type)
+    {
+    case DBCC_IR_TYPE_CALL_BY_NAME:
+      free (((DBCC_IR_CallByName *) ir)->args);
+      break;
+    case DBCC_IR_TYPE_CALL_BY_POINTER:
+      free (((DBCC_IR_CallByPointer *) ir)->args);
+      break;
+    default:
+      break;
+    }
+  free (ir);
+}
+
+static void
+foreach_location_reg (DBCC_IR             *ir,
+                      const DBCC_Location *loc,
+                      bool                 is_dest,
+                      DBCC_IR_RegFunc      func,
+                      void                *func_data)
+{
+  switch (loc->type)
+    {
+    case DBCC_LOCATION_REG:
+      func (ir, loc->info.v_reg, is_dest, func_data);
+      break;
+    case DBCC_LOCATION_PTR:
+      func (ir, loc->info.v_ptr, false, func_data);
+      break;
+    case DBCC_LOCATION_IMMED:
+      break;
+    }
+}
+
+void
+dbcc_ir_foreach_reg  (DBCC_IR            *ir,
+                      DBCC_IR_RegFunc     func,
+                      void               *func_data)
+{
+  switch (ir->type)
+    {
+    case DBCC_IR_TYPE_UNARY:
+      {
+        DBCC_IR_Unary *u = (DBCC_IR_Unary *) ir;
+        foreach_location_reg (ir, &u->source, false, func, func_data);
+        foreach_location_reg (ir, &u->dest, true, func, func_data);
+        break;
+      }
+    case DBCC_IR_TYPE_BINARY:
+      {
+        DBCC_IR_Binary *b = (DBCC_IR_Binary *) ir;
+        foreach_location_reg (ir, &b->source1, false, func, func_data);
+        foreach_location_reg (ir, &b->source2, false, func, func_data);
+        foreach_location_reg (ir, &b->dest, true, func, func_data);
+        break;
+      }
+    case DBCC_IR_TYPE_JUMP:
+    case DBCC_IR_TYPE_RETURN_VOID:
+      break;
+    case DBCC_IR_TYPE_JUMP_CONDITIONAL:
+      func (ir, ((DBCC_IR_JumpConditional *) ir)->reg, false, func_data);
+      break;
+    case DBCC_IR_TYPE_CALL_BY_NAME:
+      {
+        DBCC_IR_CallByName *c = (DBCC_IR_CallByName *) ir;
+        for (unsigned i = 0; i < c->n_args; i++)
+          foreach_location_reg (ir, c->args + i, false, func, func_data);
+        if (c->has_result)
+          foreach_location_reg (ir, &c->result, true, func, func_data);
+        break;
+      }
+    case DBCC_IR_TYPE_CALL_BY_POINTER:
+      {
+        DBCC_IR_CallByPointer *c = (DBCC_IR_CallByPointer *) ir;
+        func (ir, c->reg, false, func_data);
+        for (unsigned i = 0; i < c->n_args; i++)
+          foreach_location_reg (ir, c->args + i, false, func, func_data);
+        if (c->has_result)
+          foreach_location_reg (ir, &c->result, true, func, func_data);
+        break;
+      }
+    case DBCC_IR_TYPE_RETURN_REG:
+      func (ir, ((DBCC_IR_ReturnReg *) ir)->reg, false, func_data);
+      break;
+    case DBCC_IR_TYPE_VECTOR_BINARY:
+      {
+        DBCC_IR_VectorBinary *v = (DBCC_IR_VectorBinary *) ir;
+        foreach_location_reg (ir, &v->source1, false, func, func_data);
+        foreach_location_reg (ir, &v->source2, false, func, func_data);
+        foreach_location_reg (ir, &v->dest, true, func, func_data);
+        break;
+      }
+    }
+}
+
+/* --- Modules --- */
+DBCC_IR_Module *
+dbcc_ir_module_new      (void)
+{
+  DBCC_IR_Module *rv = DBCC_NEW (DBCC_IR_Module);
+  rv->n_functions = 0;
+  rv->functions_alloced = 16;
+  rv->functions = DBCC_NEW_ARRAY (rv->functions_alloced, DBCC_Function *);
+  dbcc_ptr_table_init (&rv->functions_by_name);
+  return rv;
+}
+
+void
+dbcc_ir_module_add      (DBCC_IR_Module *module,
+                         DBCC_Function  *function)
+{
+  assert (dbcc_ir_module_lookup (module, function->name) == NULL);
+  if (module->n_functions == module->functions_alloced)
+    {
+      module->functions_alloced *= 2;
+      module->functions = realloc (module->functions,
+                                   sizeof (DBCC_Function *) * module->functions_alloced);
+    }
+  module->functions[module->n_functions++] = function;
+  dbcc_ptr_table_set (&module->functions_by_name, function->name, function);
+}
+
+DBCC_Function *
+dbcc_ir_module_lookup   (DBCC_IR_Module *module,
+                         DBCC_Symbol    *name)
+{
+  return dbcc_ptr_table_lookup_value (&module->functions_by_name, name);
+}
+
+/* Removes and destroys 'function'. */
+void
+dbcc_ir_module_remove   (DBCC_IR_Module *module,
+                         DBCC_Function  *function)
+{
+  size_t i;
+  for (i = 0; i < module->n_functions; i++)
+    if (module->functions[i] == function)
+      break;
+  assert (i < module->n_functions);
+  memmove (module->functions + i, module->functions + i + 1,
+           sizeof (DBCC_Function *) * (module->n_functions - i - 1));
+  module->n_functions -= 1;
+
+  /* the table has no delete;  a NULL value reads as absent */
+  dbcc_ptr_table_set (&module->functions_by_name, function->name, NULL);
+  dbcc_function_destroy (function);
+}
+
+void
+dbcc_ir_module_destroy  (DBCC_IR_Module *module)
+{
+  for (size_t i = 0; i < module->n_functions; i++)
+    dbcc_function_destroy (module->functions[i]);
+  free (module->functions);
+  dbcc_ptr_table_clear (&module->functions_by_name);
+  free (module);
+}
@@ -1,6 +1,61 @@
+/* DBCC_IR:  a function body as basic blocks of three-address
+ * instructions over virtual registers.
+ *
+ * Registers are numbered per function;  registers 0 .. n_params-1
+ * hold the parameters on entry.  A location is either a register,
+ * the memory a register points at, or an immediate.
+ *
+ * Each block ends with a jump or a return.  A conditional jump
+ * that is not taken continues with the next instruction.
+ */
+
+typedef struct DBCC_BB DBCC_BB;
+typedef struct DBCC_IR DBCC_IR;
+typedef struct DBCC_Location DBCC_Location;
+typedef struct DBCC_IR_Unary DBCC_IR_Unary;
+typedef struct DBCC_IR_Binary DBCC_IR_Binary;
+typedef struct DBCC_IR_Jump DBCC_IR_Jump;
+typedef struct DBCC_IR_JumpConditional DBCC_IR_JumpConditional;
+typedef struct DBCC_IR_CallByName DBCC_IR_CallByName;
+typedef struct DBCC_IR_CallByPointer DBCC_IR_CallByPointer;
+typedef struct DBCC_IR_ReturnVoid DBCC_IR_ReturnVoid;
+typedef struct DBCC_IR_ReturnReg DBCC_IR_ReturnReg;
+typedef struct DBCC_IR_VectorBinary DBCC_IR_VectorBinary;
+typedef struct DBCC_Function DBCC_Function;
+typedef struct DBCC_IR_Module DBCC_IR_Module;
+
+typedef enum
+{
+  DBCC_IR_TYPE_UNARY,           // includes moves, loads and stores (NOOP)
+  DBCC_IR_TYPE_BINARY,
+  DBCC_IR_TYPE_JUMP,
+  DBCC_IR_TYPE_JUMP_CONDITIONAL,
+  DBCC_IR_TYPE_CALL_BY_NAME,
+  DBCC_IR_TYPE_CALL_BY_POINTER,
+  DBCC_IR_TYPE_RETURN_VOID,
+  DBCC_IR_TYPE_RETURN_REG,
+  DBCC_IR_TYPE_VECTOR_BINARY,
+} DBCC_IR_Type;
+
+typedef enum
+{
+  DBCC_FUNCTION_FLAG_STATIC       = (1<<0),
+  DBCC_FUNCTION_FLAG_INLINE_HINT  = (1<<1),       // declared 'inline'
+  DBCC_FUNCTION_FLAG_NOINLINE     = (1<<2),
+  DBCC_FUNCTION_FLAG_VARARGS      = (1<<3),
+  DBCC_FUNCTION_FLAG_ADDRESS_TAKEN= (1<<4),
+} DBCC_Function_Flags;
+
+typedef enum
+{
+  DBCC_FUNCTION_PARAM_RESTRICT    = (1<<0),
+} DBCC_Function_ParamFlags;
 
 struct DBCC_BB {
   DBCC_IR *first, *last;
+  DBCC_Function *function;
+  unsigned index;               // in function->blocks
+  uint64_t count;               // times run, if function->has_profile
 };
 
 struct DBCC_IR {
@@ -15,13 +70,16 @@ typedef enum DBCC_Location_Type {
   DBCC_LOCATION_IMMED           // constant
 } DBCC_Location_Type;
 
+/* A register location wider than 8 bytes (a vector) occupies
+ * consecutive registers, starting with the one named.
+ */
 struct DBCC_Location {
-  DBCC_Location_Type;
+  DBCC_Location_Type type;
   unsigned width;               //log2(size_bytes)
   union {
     unsigned v_reg;             // value stored in register
     unsigned v_ptr;             // pointer value stored in register
-    uint8_t v_immed[8];
+    uint8_t v_immed[8];         // little-endian
   } info;
 };
 
@@ -47,18 +105,26 @@ struct DBCC_IR_Jump {
 
 struct DBCC_IR_JumpConditional {
   DBCC_IR base;
-  unsigned reg;
+  unsigned reg;                 // jump if nonzero
   DBCC_BB *dst;
 };
 
 struct DBCC_IR_CallByName {
   DBCC_IR base;
-  DBCC_Symbol name;
+  DBCC_Symbol *name;
+  unsigned n_args;
+  DBCC_Location *args;
+  bool has_result;
+  DBCC_Location result;
 };
 
 struct DBCC_IR_CallByPointer {
   DBCC_IR base;
   unsigned reg;
+  unsigned n_args;
+  DBCC_Location *args;
+  bool has_result;
+  DBCC_Location result;
 };
 
 struct DBCC_IR_ReturnVoid {
@@ -70,11 +136,345 @@ struct DBCC_IR_ReturnReg {
   unsigned reg;
 };
 
+/* Lane-wise 'op' over vectors of (1 << element_width)-byte lanes;
+ * the vector size is that of 'dest'.  A source narrower than the
+ * vector is a scalar, broadcast to every lane.
+ */
+struct DBCC_IR_VectorBinary {
+  DBCC_IR base;
+  DBCC_BinaryOperator op;
+  unsigned element_width;
+  DBCC_Location source1;
+  DBCC_Location source2;
+  DBCC_Location dest;
+};
+
 struct DBCC_Function {
-  DBCC_Symbol name;
+  DBCC_Symbol *name;
   unsigned n_blocks;
   DBCC_BB **blocks;
   DBCC_BB *entry;
 
   DBCC_Function_Flags flags;
+
+  unsigned n_params;
+  DBCC_Function_ParamFlags *param_flags;
+  unsigned n_regs;
+  size_t blocks_alloced;
+
+  /* Block counts were loaded from a profile;  see
+   * dbcc_ir_module_apply_profile(). */
+  bool has_profile;
+};
+
+/* All the functions of a translation unit. */
+struct DBCC_IR_Module {
+  size_t n_functions;
+  DBCC_Function **functions;
+  size_t functions_alloced;
+  DBCC_PtrTable functions_by_name;
+};
+
+/* --- Construction --- */
+DBCC_Location dbcc_location_reg   (unsigned width, unsigned reg);
+DBCC_Location dbcc_location_ptr   (unsigned width, unsigned reg);
+DBCC_Location dbcc_location_immed (unsigned width, int64_t value);
+int64_t       dbcc_location_get_immed (const DBCC_Location *location);
+
+DBCC_Function *dbcc_function_new      (DBCC_Symbol   *name,
+                                       unsigned       n_params,
+                                       DBCC_Function_Flags flags);
+DBCC_BB       *dbcc_function_add_block(DBCC_Function *function);
+unsigned       dbcc_function_add_reg  (DBCC_Function *function);
+unsigned       dbcc_function_add_regs (DBCC_Function *function,
+                                       unsigned       n);
+void           dbcc_function_destroy  (DBCC_Function *function);
+void           dbcc_function_set_param_flags (DBCC_Function *function,
+                                       unsigned       param_index,
+                                       DBCC_Function_ParamFlags flags);
+
+/* Append to, or insert before 'at' in, a block.  Takes ownership. */
+void     dbcc_bb_append       (DBCC_BB       *bb,
+                               DBCC_IR       *ir);
+void     dbcc_bb_insert_before(DBCC_BB       *bb,
+                               DBCC_IR       *at,
+                               DBCC_IR       *ir);
+void     dbcc_bb_remove       (DBCC_BB       *bb,
+                               DBCC_IR       *ir);
+/* Point every jump in 'bb' that goes to 'from' at 'to' instead. */
+void     dbcc_bb_retarget_jumps (DBCC_BB     *bb,
+                               DBCC_BB       *from,
+                               DBCC_BB       *to);
+
+DBCC_IR *dbcc_ir_new_unary    (DBCC_UnaryOperator  op,
+                               DBCC_Location       dest,
+                               DBCC_Location       source);
+DBCC_IR *dbcc_ir_new_move     (DBCC_Location       dest,
+                               DBCC_Location       source);
+DBCC_IR *dbcc_ir_new_binary   (DBCC_BinaryOperator op,
+                               DBCC_Location       dest,
+                               DBCC_Location       source1,
+                               DBCC_Location       source2);
+DBCC_IR *dbcc_ir_new_vector_binary (DBCC_BinaryOperator op,
+                               unsigned            element_width,
+                               DBCC_Location       dest,
+                               DBCC_Location       source1,
+                               DBCC_Location       source2);
+DBCC_IR *dbcc_ir_new_jump     (DBCC_BB            *dst);
+DBCC_IR *dbcc_ir_new_jump_conditional (unsigned    reg,
+                               DBCC_BB            *dst);
+DBCC_IR *dbcc_ir_new_call_by_name (DBCC_Symbol   *name,
+                               unsigned            n_args,
+                               const DBCC_Location *args,
+                               const DBCC_Location *optional_result);
+DBCC_IR *dbcc_ir_new_call_by_pointer (unsigned    reg,
+                               unsigned            n_args,
+                               const DBCC_Location *args,
+                               const DBCC_Location *optional_result);
+DBCC_IR *dbcc_ir_new_return_void (void);
+DBCC_IR *dbcc_ir_new_return_reg (unsigned reg);
+DBCC_IR *dbcc_ir_copy         (const DBCC_IR      *ir);
+void     dbcc_ir_free         (DBCC_IR            *ir);
+
+/* Call 'func' for each register 'ir' reads or writes.  A register
+ * used as a pointer is read, even when the memory is written.
+ */
+typedef void (*DBCC_IR_RegFunc) (DBCC_IR  *ir,
+                                 unsigned  reg,
+                                 bool      is_def,
+                                 void     *func_data);
+void     dbcc_ir_foreach_reg  (DBCC_IR            *ir,
+                               DBCC_IR_RegFunc     func,
+                               void               *func_data);
+
+/* Count the instructions in a function. */
+size_t   dbcc_function_get_n_instructions (DBCC_Function *function);
+
+/* --- Modules --- */
+DBCC_IR_Module *dbcc_ir_module_new      (void);
+void            dbcc_ir_module_add      (DBCC_IR_Module *module,
+                                         DBCC_Function  *function);
+DBCC_Function  *dbcc_ir_module_lookup   (DBCC_IR_Module *module,
+                                         DBCC_Symbol    *name);
+void            dbcc_ir_module_remove   (DBCC_IR_Module *module,
+                                         DBCC_Function  *function);
+void            dbcc_ir_module_destroy  (DBCC_IR_Module *module);
+
+/* --- Optimization passes --- */
+
+/* Inline calls by name to functions in the same module.
+ *
+ * A call is inlined when the callee's cost (roughly its instruction
+ * count, with calls weighted heavier and immediate arguments
+ * discounted) is below a threshold, which is higher for functions
+ * declared inline and for static functions with a single caller.
+ * Recursive, variadic and noinline functions are never inlined.
+ * Static functions left without callers are removed.
+ *
+ * When the caller has a profile, calls that never ran are left
+ * alone, and calls that ran often enough may inline bigger
+ * functions.  The inlined blocks take their share of the callee's
+ * counts.
+ */
+typedef struct DBCC_IR_InlineOptions DBCC_IR_InlineOptions;
+struct DBCC_IR_InlineOptions
+{
+  unsigned always_inline_cost;          /* cheaper than the call itself */
+  unsigned max_cost;
+  unsigned max_cost_inline_hint;
+  unsigned max_cost_single_caller;      /* static, one call site */
+
+  /* Stop inlining into a function once it has grown by this factor. */
+  unsigned max_caller_growth;
+
+  /* With a profile:  the limit for calls run at least hot_call_count times. */
+  unsigned max_cost_hot;
+  uint64_t hot_call_count;
+};
+#define DBCC_IR_INLINE_OPTIONS_DEFAULT (DBCC_IR_InlineOptions) { \
+  .always_inline_cost = 8,                                      \
+  .max_cost = 30,                                               \
+  .max_cost_inline_hint = 80,                                   \
+  .max_cost_single_caller = 250,                                \
+  .max_caller_growth = 4,                                       \
+  .max_cost_hot = 120,                                          \
+  .hot_call_count = 1000,                                       \
+}
+
+typedef struct DBCC_IR_InlineStats DBCC_IR_InlineStats;
+struct DBCC_IR_InlineStats
+{
+  size_t n_call_sites;
+  size_t n_inlined;
+  size_t n_rejected_cost;
+  size_t n_rejected_recursive;
+  size_t n_rejected_flags;              /* noinline, varargs */
+  size_t n_rejected_growth;
+  size_t n_rejected_cold;               /* never run, per the profile */
+  size_t n_functions_removed;
+};
+unsigned dbcc_function_get_inline_cost (DBCC_Function *function);
+void     dbcc_ir_module_inline         (DBCC_IR_Module              *module,
+                                        const DBCC_IR_InlineOptions *options,
+                                        DBCC_IR_InlineStats         *stats_out);
+
+/* Alias analysis.
+ *
+ * Each register is given a provenance:  the parameter whose entry
+ * value it was derived from by moves and pointer arithmetic, and
+ * the byte offset from it when that is the same on every path.
+ * This is flow-insensitive, so it holds at every point in the
+ * function.
+ *
+ * Memory reached through a restrict parameter is only reached
+ * through pointers derived from it (C11 6.7.3.1), so it cannot
+ * alias an access whose pointer is known to come from elsewhere.
+ * Pointers loaded from memory or returned by calls may come from
+ * anywhere.
+ */
+typedef enum
+{
+  DBCC_ALIAS_NO,
+  DBCC_ALIAS_MAY,
+  DBCC_ALIAS_MUST
+} DBCC_AliasResult;
+
+typedef struct DBCC_AliasInfo DBCC_AliasInfo;
+DBCC_AliasInfo  *dbcc_alias_info_new     (DBCC_Function       *function);
+DBCC_AliasResult dbcc_alias_info_query   (DBCC_AliasInfo      *info,
+                                          const DBCC_Location *a,
+                                          const DBCC_Location *b);
+void             dbcc_alias_info_destroy (DBCC_AliasInfo      *info);
+
+/* Within each block, replace loads of memory whose value is
+ * already in a register (from an earlier load or store that no
+ * intervening store may have clobbered) with moves.
+ * Returns the number of loads replaced.
+ */
+size_t   dbcc_function_forward_loads   (DBCC_Function               *function);
+
+/* --- Loops ---
+ *
+ * Natural loops, found from the back edges of the dominator tree;
+ * back edges to the same header make one loop.  Finding them also
+ * gives every loop a preheader:  a block outside the loop that is
+ * its only entry, where code hoisted out of the loop goes.
+ */
+typedef struct DBCC_IR_Loop DBCC_IR_Loop;
+struct DBCC_IR_Loop
+{
+  DBCC_BB *header;
+  DBCC_BB *preheader;
+  unsigned n_blocks;
+  DBCC_BB **blocks;                     /* header first */
+
+  /*< private >*/
+  unsigned n_contains;
+  uint8_t *contains;                    /* indexed by block index */
 };
+
+typedef struct DBCC_IR_LoopForest DBCC_IR_LoopForest;
+struct DBCC_IR_LoopForest
+{
+  unsigned n_loops;
+  DBCC_IR_Loop *loops;                  /* inner loops before outer */
+};
+
+DBCC_IR_LoopForest *dbcc_function_find_loops    (DBCC_Function      *function);
+bool                dbcc_ir_loop_contains       (const DBCC_IR_Loop *loop,
+                                                 const DBCC_BB      *bb);
+void                dbcc_ir_loop_forest_destroy (DBCC_IR_LoopForest *forest);
+
+/* Loop-invariant code motion, strength reduction and
+ * induction-variable elimination.
+ *
+ * Instructions whose operands don't change in the loop move to the
+ * preheader;  loads move too when no store in the loop may alias
+ * them and the loop has no calls.  Multiplies of an induction
+ * variable by a constant become a register stepped alongside it,
+ * and an induction variable then only used by the loop test is
+ * replaced in the test by the scaled one.
+ */
+typedef struct DBCC_IR_LoopStats DBCC_IR_LoopStats;
+struct DBCC_IR_LoopStats
+{
+  size_t n_loops;
+  size_t n_hoisted;
+  size_t n_strength_reduced;
+  size_t n_ivs_eliminated;
+};
+void     dbcc_function_optimize_loops  (DBCC_Function               *function,
+                                        DBCC_IR_LoopStats           *stats_out);
+
+/* Rewrite counted loops whose iterations are independent lane-wise
+ * operations on arrays, "d[i] = a[i] op b[i]" and the like, to run
+ * max_vector_size bytes per iteration, with the original loop left
+ * to finish the remainder.  The loop must still be in the form the
+ * front end emits:  run this before dbcc_function_optimize_loops().
+ * Returns the number of loops vectorized.
+ */
+size_t   dbcc_function_vectorize_loops (DBCC_Function                *function,
+                                        const DBCC_TargetEnvironment *target_env);
+
+/* --- Profile-guided optimization ---
+ *
+ * An instrumented build calls
+ *
+ *     __dbcc_profile_count (FUNCTION_SLOT, BLOCK_INDEX)
+ *
+ * at the start of every block;  the runtime passes these on to
+ * dbcc_ir_profile_count() and saves the profile with
+ * dbcc_ir_profile_write() when the program exits.  A later build
+ * reads it back and gives each function's blocks their counts.
+ *
+ * Both builds must instrument and apply at the same point in the
+ * pipeline, before any pass that changes the blocks.  Each
+ * function's counts carry a checksum of its shape, so a function
+ * that was edited since the profile was taken is compiled as if
+ * it had none.
+ */
+#define DBCC_IR_PROFILE_COUNT_FUNCTION  "__dbcc_profile_count"
+
+typedef struct DBCC_IR_FunctionProfile DBCC_IR_FunctionProfile;
+struct DBCC_IR_FunctionProfile
+{
+  DBCC_Symbol *name;
+  uint32_t checksum;
+  unsigned n_blocks;
+  uint64_t *counts;
+};
+
+typedef struct DBCC_IR_Profile DBCC_IR_Profile;
+struct DBCC_IR_Profile
+{
+  size_t n_functions;
+  DBCC_IR_FunctionProfile *functions;   /* indexed by slot */
+  size_t functions_alloced;
+  DBCC_PtrTable by_name;                /* slot + 1 */
+};
+
+uint32_t         dbcc_function_get_checksum  (DBCC_Function    *function);
+
+/* Returns a profile with a zeroed slot for each function. */
+DBCC_IR_Profile *dbcc_ir_module_instrument   (DBCC_IR_Module   *module,
+                                              DBCC_SymbolSpace *symbol_space);
+void             dbcc_ir_profile_count       (DBCC_IR_Profile  *profile,
+                                              unsigned          slot,
+                                              unsigned          block_index);
+
+bool             dbcc_ir_profile_write       (DBCC_IR_Profile  *profile,
+                                              const char       *filename,
+                                              DBCC_Error      **error);
+DBCC_IR_Profile *dbcc_ir_profile_read        (DBCC_SymbolSpace *symbol_space,
+                                              const char       *filename,
+                                              DBCC_Error      **error);
+
+/* Profiles of the same program from several runs add up. */
+bool             dbcc_ir_profile_merge       (DBCC_IR_Profile  *into,
+                                              DBCC_IR_Profile  *profile,
+                                              DBCC_Error      **error);
+
+/* Returns the number of functions given counts. */
+size_t           dbcc_ir_module_apply_profile(DBCC_IR_Module   *module,
+                                              DBCC_IR_Profile  *profile);
+void             dbcc_ir_profile_destroy     (DBCC_IR_Profile  *profile);
@@ -220,11 +220,13 @@ init_ns_builtins (DBCC_Namespace *globals,
 
 
 DBCC_Namespace *
-dbcc_namespace_new_global        (DBCC_TargetEnvironment *target_env)
+dbcc_namespace_new_global        (DBCC_TargetEnvironment *target_env,
+                                  DBCC_SymbolSpace       *symbol_space)
 {
   DBCC_Namespace *ns = calloc (sizeof (DBCC_Namespace), 1);
   ns->is_global = true;
-  ns->symbol_space = dbcc_symbol_space_new ();
+  ns->symbol_space = symbol_space != NULL ? symbol_space
+                                          : dbcc_symbol_space_new ();
   ns->target_env = target_env;
   DBCC_NamespaceBuiltins *b = malloc (sizeof (DBCC_NamespaceBuiltins));
   init_ns_builtins (ns, b);
@@ -299,15 +301,279 @@ void dbcc_namespace_add_by_tag   (DBCC_Namespace      *ns,
 void dbcc_namespace_add_enum_value (DBCC_Namespace *ns,
                                     DBCC_EnumValue *enum_value);
 
+typedef struct GlobalEntry GlobalEntry;
+struct GlobalEntry
+{
+  DBCC_NamespaceEntry entry;
+  DBCC_Global global;
+};
+
+DBCC_Global *
+dbcc_namespace_add_global        (DBCC_Namespace      *ns,
+                                  DBCC_Symbol         *name,
+                                  DBCC_Type           *type)
+{
+  DBCC_NamespaceEntry *old = dbcc_ptr_table_lookup_value (&ns->symbols, name);
+  if (old != NULL && old->entry_type == DBCC_NAMESPACE_ENTRY_GLOBAL)
+    {
+      /* redeclaration:  keep the address, since expressions
+       * (and saved function bodies) may already point at it */
+      old->v_global->type = type;
+      return old->v_global;
+    }
+  GlobalEntry *ge = DBCC_NODE_NEW0 (GlobalEntry);
+  ge->global.address_base.type = DBCC_ADDRESS_TYPE_GLOBAL;
+  ge->global.global_ns = ns;
+  ge->global.type = type;
+  ge->global.name = name;
+  ge->entry.entry_type = DBCC_NAMESPACE_ENTRY_GLOBAL;
+  ge->entry.v_global = &ge->global;
+  dbcc_ptr_table_set (&ns->symbols, name, &ge->entry);
+  return &ge->global;
+}
+
 /* Global namespace functions to create DBCC_Addresses from
  * constant data etc.
+ *
+ * All constant data goes through a pool keyed by (sizeof_elt, bytes),
+ * a chained hash-table whose entries begin with their DBCC_Address.
+ */
+typedef struct ConstantPoolEntry ConstantPoolEntry;
+struct ConstantPoolEntry
+{
+  DBCC_Address address;         /* must be first */
+  unsigned sizeof_elt;
+  size_t length;                /* in bytes */
+  uint8_t *data;
+  uint32_t hash;
+  ConstantPoolEntry *hash_next;
+};
+
+struct DBCC_ConstantPool
+{
+  size_t table_size;            /* power-of-two */
+  ConstantPoolEntry **table;
+  size_t n_entries;
+  DBCC_ConstantPoolStats stats;
+
+  /* n_entries when n_suffix_merged and bytes_allocated were computed */
+  size_t stats_n_entries;
+};
+
+/* The hash of 'data' followed by 'n_zeros' zero bytes. */
+static uint32_t
+hash_constant_data (unsigned sizeof_elt, size_t length, const uint8_t *data,
+                    size_t n_zeros)
+{
+  uint32_t h = 2166136261u ^ sizeof_elt;
+  for (size_t i = 0; i < length; i++)
+    h = (h ^ data[i]) * 16777619u;
+  for (size_t i = 0; i < n_zeros; i++)
+    h = h * 16777619u;
+  return h;
+}
+
+static DBCC_ConstantPool *
+get_constant_pool (DBCC_Namespace *ns)
+{
+  assert(ns->is_global);
+  if (ns->constant_pool == NULL)
+    {
+      DBCC_ConstantPool *pool = calloc (sizeof (DBCC_ConstantPool), 1);
+      pool->table_size = 64;
+      pool->table = calloc (sizeof (ConstantPoolEntry *), pool->table_size);
+      ns->constant_pool = pool;
+    }
+  return ns->constant_pool;
+}
+
+static void
+constant_pool_grow (DBCC_ConstantPool *pool)
+{
+  size_t new_size = pool->table_size * 2;
+  ConstantPoolEntry **new_table = calloc (sizeof (ConstantPoolEntry *), new_size);
+  for (size_t i = 0; i < pool->table_size; i++)
+    {
+      ConstantPoolEntry *at = pool->table[i];
+      while (at != NULL)
+        {
+          ConstantPoolEntry *next = at->hash_next;
+          size_t b = at->hash & (new_size - 1);
+          at->hash_next = new_table[b];
+          new_table[b] = at;
+          at = next;
+        }
+    }
+  free (pool->table);
+  pool->table = new_table;
+  pool->table_size = new_size;
+}
+
+/* 'data' has 'length' bytes, followed by 'n_zeros' bytes of zero
+ * which are part of the constant (the terminator for strings).
  */
+static DBCC_Address *
+constant_pool_force (DBCC_Namespace *ns,
+                     unsigned        sizeof_elt,
+                     size_t          length,
+                     const uint8_t  *data,
+                     size_t          n_zeros)
+{
+  DBCC_ConstantPool *pool = get_constant_pool (ns);
+  size_t total = length + n_zeros;
+  uint32_t hash = hash_constant_data (sizeof_elt, length, data, n_zeros);
+  pool->stats.n_requests++;
+  pool->stats.bytes_requested += total;
+
+  ConstantPoolEntry *at;
+  for (at = pool->table[hash & (pool->table_size - 1)]; at; at = at->hash_next)
+    if (at->hash == hash
+     && at->sizeof_elt == sizeof_elt
+     && at->length == total
+     && memcmp (at->data, data, length) == 0
+     && dbcc_is_zero (n_zeros, at->data + length))
+      return &at->address;
+
+  if (pool->n_entries >= pool->table_size)
+    constant_pool_grow (pool);
+  ConstantPoolEntry *entry = calloc (sizeof (ConstantPoolEntry), 1);
+  entry->address.v_global.address_base.type = DBCC_ADDRESS_TYPE_CONSTANT;
+  entry->address.v_global.global_ns = ns;
+  entry->sizeof_elt = sizeof_elt;
+  entry->length = total;
+  entry->data = malloc (total);
+  memcpy (entry->data, data, length);
+  memset (entry->data + length, 0, n_zeros);
+  entry->hash = hash;
+  size_t b = hash & (pool->table_size - 1);
+  entry->hash_next = pool->table[b];
+  pool->table[b] = entry;
+  pool->n_entries++;
+  pool->stats.n_unique++;
+  pool->stats.bytes_unique += total;
+  return &entry->address;
+}
+
 DBCC_Address *dbcc_namespace_global_allocate_constant (DBCC_Namespace *ns,
                                                        size_t length,
-                                                       const uint8_t *data);
+                                                       const uint8_t *data)
+{
+  return constant_pool_force (ns, 1, length, data, 0);
+}
 DBCC_Address *dbcc_namespace_global_allocate_constant0(DBCC_Namespace *ns,
                                                        size_t length,
-                                                       const uint8_t *data);
+                                                       const uint8_t *data)
+{
+  return constant_pool_force (ns, 1, length, data, 1);
+}
+
+DBCC_Address *dbcc_namespace_global_allocate_string   (DBCC_Namespace *ns,
+                                                       const DBCC_String *str)
+{
+  unsigned sizeof_elt = str->sizeof_elt == 0 ? 1 : str->sizeof_elt;
+  return constant_pool_force (ns, sizeof_elt,
+                              str->length * sizeof_elt,
+                              (const uint8_t *) str->str,
+                              sizeof_elt);
+}
+
+/* Order by element size, then by the bytes compared from the end,
+ * so that a literal sorts immediately before the literals
+ * it is a tail of.
+ */
+static int
+compare_constant_pool_entry_by_reversed_data (const void *a, const void *b)
+{
+  const ConstantPoolEntry *A = * (ConstantPoolEntry * const *) a;
+  const ConstantPoolEntry *B = * (ConstantPoolEntry * const *) b;
+  if (A->sizeof_elt != B->sizeof_elt)
+    return A->sizeof_elt < B->sizeof_elt ? -1 : 1;
+  size_t min_len = A->length < B->length ? A->length : B->length;
+  for (size_t i = 1; i <= min_len; i++)
+    {
+      uint8_t ac = A->data[A->length - i];
+      uint8_t bc = B->data[B->length - i];
+      if (ac != bc)
+        return ac < bc ? -1 : 1;
+    }
+  return A->length < B->length ? -1 : A->length > B->length ? 1 : 0;
+}
+
+static inline bool
+constant_pool_entry_is_tail_of (const ConstantPoolEntry *tail,
+                                const ConstantPoolEntry *host)
+{
+  return tail->sizeof_elt == host->sizeof_elt
+      && tail->length <= host->length
+      && memcmp (tail->data,
+                 host->data + host->length - tail->length,
+                 tail->length) == 0;
+}
+
+/* Sort the entries and place each one, either after the previous
+ * host or inside it.  Offsets are only written when 'assign_offsets'
+ * is set, so the size of the section can be found without fixing
+ * the addresses of its constants.
+ */
+static size_t
+constant_pool_layout (DBCC_ConstantPool *pool, bool assign_offsets)
+{
+  size_t n = pool->n_entries;
+  ConstantPoolEntry **entries = malloc (sizeof (ConstantPoolEntry *) * (n + 1));
+  size_t k = 0;
+  for (size_t i = 0; i < pool->table_size; i++)
+    for (ConstantPoolEntry *at = pool->table[i]; at; at = at->hash_next)
+      entries[k++] = at;
+  assert(k == n);
+  qsort (entries, n, sizeof (ConstantPoolEntry *),
+         compare_constant_pool_entry_by_reversed_data);
+
+  /* Walk backward: each entry is either a tail of the most recently
+   * placed host, or becomes the new host. */
+  size_t offset = 0;
+  size_t n_merged = 0;
+  ConstantPoolEntry *host = NULL;
+  for (size_t i = n; i-- > 0; )
+    {
+      ConstantPoolEntry *e = entries[i];
+      if (host != NULL && constant_pool_entry_is_tail_of (e, host))
+        {
+          if (assign_offsets)
+            e->address.v_global.address_offset
+              = host->address.v_global.address_offset + host->length - e->length;
+          n_merged++;
+        }
+      else
+        {
+          offset = DBCC_ALIGN (offset, e->sizeof_elt);
+          if (assign_offsets)
+            e->address.v_global.address_offset = offset;
+          offset += e->length;
+          host = e;
+        }
+    }
+  free (entries);
+  pool->stats.n_suffix_merged = n_merged;
+  pool->stats.bytes_allocated = offset;
+  pool->stats_n_entries = n;
+  return offset;
+}
+
+size_t
+dbcc_namespace_global_layout_constants  (DBCC_Namespace *ns)
+{
+  return constant_pool_layout (get_constant_pool (ns), true);
+}
+
+void
+dbcc_namespace_global_get_constant_stats(DBCC_Namespace *ns,
+                                         DBCC_ConstantPoolStats *out)
+{
+  DBCC_ConstantPool *pool = get_constant_pool (ns);
+  if (pool->stats_n_entries != pool->n_entries)
+    constant_pool_layout (pool, false);
+  *out = pool->stats;
+}
 
 /* Fixed-width types. */
 DBCC_Type * dbcc_namespace_get_integer_type           (DBCC_Namespace  *ns,
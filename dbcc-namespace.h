@@ -5,6 +5,8 @@ typedef struct DBCC_NamespaceBuiltins DBCC_NamespaceBuiltins;
 
 typedef struct DBCC_Address_Offset DBCC_Address_Offset;
 typedef struct DBCC_Address_Base DBCC_Address_Base;
+typedef struct DBCC_ConstantPool DBCC_ConstantPool;
+typedef struct DBCC_ConstantPoolStats DBCC_ConstantPoolStats;
 
 typedef enum
 {
@@ -48,6 +50,14 @@ struct DBCC_Global
   size_t address_offset;
 };
 
+union DBCC_Address
+{
+  DBCC_Address_Type type;
+  DBCC_Address_Base base;
+  DBCC_Address_Offset v_offset;
+  DBCC_Global v_global;
+};
+
 struct DBCC_Local
 {
   DBCC_Namespace *local_ns;
@@ -84,10 +94,14 @@ struct DBCC_Namespace
   DBCC_NamespaceBuiltins *builtins;
 
   DBCC_Namespace *chain;                /* if lookups fail, go to parent */
+
+  DBCC_ConstantPool *constant_pool;     /* global only: deduplicated constant data */
 };
 
+/* If symbol_space is NULL, the namespace gets its own. */
 DBCC_Namespace *
-dbcc_namespace_new_global        (DBCC_TargetEnvironment *target_env);
+dbcc_namespace_new_global        (DBCC_TargetEnvironment *target_env,
+                                  DBCC_SymbolSpace       *symbol_space);
 
 DBCC_Namespace *
 dbcc_namespace_new_local         (DBCC_Namespace *global);
@@ -114,6 +128,15 @@ void dbcc_namespace_add_by_tag   (DBCC_Namespace      *ns,
 void dbcc_namespace_add_enum_value (DBCC_Namespace *ns,
                                     DBCC_EnumValue *enum_value);
 
+/* Declare a global variable or function.  Redeclaring a name
+ * updates its type and returns the same DBCC_Global.
+ * The entry is allocated with dbcc_node_alloc().
+ */
+DBCC_Global *
+dbcc_namespace_add_global        (DBCC_Namespace      *ns,
+                                  DBCC_Symbol         *name,
+                                  DBCC_Type           *type);
+
 /* Global namespace functions to create DBCC_Addresses from
  * constant data etc.
  */
@@ -124,6 +147,36 @@ DBCC_Address *dbcc_namespace_global_allocate_constant0(DBCC_Namespace *ns,
                                                        size_t length,
                                                        const uint8_t *data);
 
+/* String literals are pooled per translation unit, keyed by
+ * (element size, bytes), so every occurrence of the same literal
+ * returns the same address.  The NUL terminator is included.
+ */
+DBCC_Address *dbcc_namespace_global_allocate_string   (DBCC_Namespace *ns,
+                                                       const DBCC_String *str);
+
+/* Assign each pooled constant its offset in the constant data section.
+ * A literal which is a tail of a longer one ("bar" in "foobar")
+ * is placed inside it rather than getting its own bytes.
+ * Returns the size of the section.
+ */
+size_t        dbcc_namespace_global_layout_constants  (DBCC_Namespace *ns);
+
+struct DBCC_ConstantPoolStats
+{
+  size_t n_requests;            /* calls to allocate a constant */
+  size_t n_unique;              /* distinct (element size, bytes) entries */
+  size_t n_suffix_merged;       /* unique entries stored inside another */
+  size_t bytes_requested;       /* sum over all requests */
+  size_t bytes_unique;          /* sum over distinct entries */
+  size_t bytes_allocated;       /* size of the data section once laid out */
+};
+
+/* Does not lay out the constants:  their addresses are unchanged,
+ * and the section sizes are those layout_constants() would give.
+ */
+void          dbcc_namespace_global_get_constant_stats(DBCC_Namespace *ns,
+                                                       DBCC_ConstantPoolStats *out);
+
 /* Fixed-width types. */
 DBCC_Type * dbcc_namespace_get_integer_type           (DBCC_Namespace  *ns,
                                                        bool is_signed,
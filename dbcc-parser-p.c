@@ -0,0 +1,6301 @@
+/*
+** 2000-05-29
+**
+** The author disclaims copyright to this source code.  In place of
+** a legal notice, here is a blessing:
+**
+**    May you do good and not evil.
+**    May you find forgiveness for yourself and forgive others.
+**    May you share freely, never taking more than you give.
+**
+*************************************************************************
+** Driver template for the LEMON parser generator.
+**
+** The "lemon" program processes an LALR(1) input grammar file, then uses
+** this template to construct a parser.  The "lemon" program inserts text
+** at each "%%" line.  Also, any "P-a-r-s-e" identifer prefix (without the
+** interstitial "-" characters) contained in this template is changed into
+** the value of the %name directive from the grammar.  Otherwise, the content
+** of this template is copied straight through into the generate parser
+** source file.
+**
+** The following is the concatenation of all %include directives from the
+** input grammar file:
+*/
+#include <stdio.h>
+/************ Begin %include sections from the grammar ************************/
+#line 98 "dbcc-parser-p.lemon"
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "dbcc.h"
+#include "p-token.h"
+#include "dbcc-statement-internal.h"
+
+/* This declares the functions defined in the code generated by lemon.
+ * It is included so we will get an error if a function is mis-defined.
+ */
+#include "dbcc-parser-lemon.h"
+
+typedef struct P_DeclaratorList P_DeclaratorList;
+typedef struct P_DeclarationList P_DeclarationList;
+typedef struct P_ParameterList P_ParameterList;
+typedef struct P_Declarator P_Declarator;
+typedef struct P_Declaration P_Declaration;
+typedef struct P_DesignatorList P_DesignatorList;
+typedef struct P_Designator P_Designator;
+
+typedef struct P_AlignmentSpecifier P_AlignmentSpecifier;
+typedef struct P_Initializer P_Initializer;
+typedef struct P_InitializerList P_InitializerList;
+
+typedef struct P_GenericAssociationList P_GenericAssociationList;
+typedef struct P_GenericAssociation P_GenericAssociation;
+
+/* Abandon the parse:  emptying the stack ends the loop in
+ * DBCC_Lemon_Parser().  The caller finds context->error and
+ * replaces the parser; values left on the stack are not destroyed,
+ * since the action may own some of them already.
+ */
+#define FAIL()                                  \
+  do{                                           \
+    assert(context->error != NULL);             \
+    yypParser->yytos = yypParser->yystack;      \
+    return;                                     \
+  }while(0)
+
+#if 0
+static inline char *
+token_strdup (P_Token *t)
+{
+  char *rv = malloc (t->length + 1);
+  memcpy (rv, t->str, t->length);
+  rv[t->length] = 0;
+  return rv;
+}
+#endif
+
+/* Forward declarations of various internal functions */
+static bool declaration_list_to_params (P_Context *context, 
+                                        P_DeclarationList *list,
+                                        size_t *n_params_out,
+                                        DBCC_Param **params_out);
+static void p_declaration_list_clear (P_DeclarationList *list);
+
+struct P_Context
+{
+  DBCC_Error *error;
+  DBCC_Namespace *globals;
+  DBCC_Namespace *locals;
+  DBCC_TargetEnvironment *target_env;
+  int next_enum_value;
+};
+#define P_CONTEXT_NAMESPACE(context) \
+        ((context)->locals ? (context)->locals : (context)->globals)
+
+#define CONTEXT_NS     P_CONTEXT_NAMESPACE(context)
+
+typedef struct 
+{
+  unsigned n_ptr;
+  DBCC_TypeQualifier *ptr_type_qualifiers;
+  DBCC_CodePosition *code_position;
+} P_Pointer;
+static bool
+p_context_lookup (P_Context *context,
+                  DBCC_Symbol *symbol,
+                  DBCC_CodePosition *cp,
+                  DBCC_NamespaceEntry *entry)
+{
+  if (!dbcc_namespace_lookup (CONTEXT_NS, symbol, entry))
+    {
+      context->error = dbcc_error_new (DBCC_ERROR_NOT_FOUND,
+                                       "symbol '%s' not found",
+                                       dbcc_symbol_get_string(symbol));
+      if (cp != NULL)
+        dbcc_error_add_code_position (context->error, cp);
+      return false;
+    }
+  return true;
+}
+
+static DBCC_Type *
+context_new_struct_stub (P_Context         *context,
+                         DBCC_Symbol       *tag,
+                         DBCC_CodePosition *cp)
+{
+  DBCC_Namespace *ns = CONTEXT_NS;
+  (void) cp;
+  DBCC_Type *rv = dbcc_namespace_lookup_struct_tag (ns, tag);
+  if (rv != NULL)
+    return rv;
+  rv = dbcc_type_new_incomplete_struct (tag);
+  dbcc_namespace_add_by_tag (ns, rv);
+  return rv;
+}
+static DBCC_Type *
+context_new_union_stub  (P_Context         *context,
+                         DBCC_Symbol       *tag,
+                         DBCC_CodePosition *cp)
+{
+  DBCC_Namespace *ns = CONTEXT_NS;
+  DBCC_Type *rv = dbcc_namespace_lookup_union_tag (ns, tag);
+  (void) cp;
+  if (rv != NULL)
+    return rv;
+  rv = dbcc_type_new_incomplete_union (tag);
+  dbcc_namespace_add_by_tag (ns, rv);
+  return rv;
+}
+
+static DBCC_Type *
+context_new_struct               (P_Context         *context,
+                                  DBCC_Symbol       *tag,
+                                  DBCC_CodePosition *cp,
+                                  size_t             n_params,
+                                  DBCC_Param        *params)
+{
+  DBCC_Type *rv;
+  DBCC_Namespace *ns = CONTEXT_NS;
+  rv = dbcc_namespace_lookup_struct_tag (ns, tag);
+  if (rv != NULL)
+    {
+      if (!rv->v_struct.incomplete)
+        {
+          context->error = dbcc_error_new (DBCC_ERROR_MULTIPLE_DEFINITION,
+                                           "struct %s multiply defined",
+                                           dbcc_symbol_get_string (tag));
+          dbcc_error_add_code_position (context->error, cp);
+          return NULL;
+        }
+      if (!dbcc_type_complete_struct (context->target_env, rv, n_params, params, &context->error))
+        {
+          dbcc_error_add_code_position (context->error, cp);
+          return NULL;
+        }
+    }
+  else
+    {
+      rv = dbcc_type_new_struct (context->globals,
+                                 tag,
+                                 n_params, params,
+                                 &context->error);
+      if (rv == NULL)
+        {
+          dbcc_error_add_code_position (context->error, cp);
+          return NULL;
+        }
+      dbcc_namespace_add_by_tag (ns, rv);
+    }
+  return rv;
+}
+static DBCC_Type *
+context_new_union               (P_Context         *context,
+                                 DBCC_Symbol       *tag,
+                                 DBCC_CodePosition *cp,
+                                 size_t             n_params,
+                                 DBCC_Param        *params)
+
+{
+  DBCC_Type *rv;
+  DBCC_Namespace *ns = CONTEXT_NS;
+  rv = dbcc_namespace_lookup_union_tag (ns, tag);
+  if (rv != NULL)
+    {
+      if (!rv->v_struct.incomplete)
+        {
+          context->error = dbcc_error_new (DBCC_ERROR_MULTIPLE_DEFINITION,
+                                           "union %s multiply defined",
+                                           dbcc_symbol_get_string (tag));
+          dbcc_error_add_code_position (context->error, cp);
+          return NULL;
+        }
+      if (!dbcc_type_complete_union (context->target_env,
+                                     rv,
+                                     n_params, params,
+                                     &context->error))
+        {
+          dbcc_error_add_code_position (context->error, cp);
+          return NULL;
+        }
+    }
+  else
+    {
+      rv = dbcc_type_new_union (context->globals,
+                                tag, n_params, params,
+                                &context->error);
+      if (rv == NULL)
+        {
+          dbcc_error_add_code_position (context->error, cp);
+          return NULL;
+        }
+      dbcc_namespace_add_by_tag (ns, rv);
+    }
+  return rv;
+}
+
+P_Context *
+p_context_new (DBCC_Namespace *ns)
+{
+  P_Context *rv = malloc (sizeof (P_Context));
+  rv->error = NULL;
+  rv->globals = ns;
+  rv->locals = NULL;
+  rv->target_env = ns->target_env;
+  rv->next_enum_value = 0;
+  return rv;
+}
+
+DBCC_Error *
+p_context_take_error (P_Context *context)
+{
+  DBCC_Error *rv = context->error;
+  context->error = NULL;
+  return rv;
+}
+
+void
+p_context_free (P_Context *context)
+{
+  if (context->error != NULL)
+    dbcc_error_unref (context->error);
+  free (context);
+}
+
+#if 0
+static void
+p_context_add_enum_value (P_Context *context,
+                          DBCC_EnumValue *enum_value)
+{
+  DBCC_Namespace *ns = context->locals ? context->locals : context->globals;
+  dbcc_namespace_add_enum_value (ns, enum_value);
+}
+#endif
+
+struct P_DesignatorList
+{
+  P_Designator *first, *last;
+};
+  
+typedef enum
+{
+  P_ALIGNMENT_SPECIFIER_BY_TYPE,
+  P_ALIGNMENT_SPECIFIER_BY_EXPR
+} P_AlignmentSpecifierType;
+struct P_AlignmentSpecifier
+{
+  P_AlignmentSpecifierType specifier_type;
+  union {
+    DBCC_Type *v_type;
+    DBCC_Expr *v_expr;
+  };
+};
+
+
+typedef enum
+{
+  P_INITIALIZER_TYPE_EXPR,
+  P_INITIALIZER_TYPE_STRUCTURED
+} P_InitializerType;
+
+struct P_InitializerList
+{
+  P_Initializer *first;
+  P_Initializer *last;
+};
+
+struct P_Initializer
+{
+  P_DesignatorList designators;
+  P_InitializerType initializer_type;
+  P_Initializer *next;
+  union {
+    DBCC_Expr *v_expr;
+    P_InitializerList v_structured;               // for objects and arrays
+  };
+};
+static P_Initializer *
+p_initializer_new_expr (DBCC_Expr *expr)
+{
+  P_Initializer *rv = malloc (sizeof(P_Initializer));
+  rv->designators.first = NULL;
+  rv->designators.last = NULL;
+  rv->initializer_type = P_INITIALIZER_TYPE_EXPR;
+  rv->next = NULL;
+  rv->v_expr = expr;
+  return rv;
+}
+static P_Initializer *
+p_initializer_new_structured (P_InitializerList *list)
+{
+  P_Initializer *rv = malloc (sizeof(P_Initializer));
+  rv->designators.first = NULL;
+  rv->designators.last = NULL;
+  rv->initializer_type = P_INITIALIZER_TYPE_STRUCTURED;
+  rv->next = NULL;
+  rv->v_structured = *list;
+  return rv;
+}
+static void p_initializer_list_clear(P_InitializerList *list);
+static void
+p_initializer_destroy (P_Initializer *p)
+{
+  switch (p->initializer_type)
+    {
+    case P_INITIALIZER_TYPE_EXPR:
+      dbcc_expr_destroy (p->v_expr);
+      break;
+    case P_INITIALIZER_TYPE_STRUCTURED:
+      p_initializer_list_clear (&p->v_structured);
+      break;
+    }
+  free (p);
+}
+static void p_initializer_list_clear(P_InitializerList *list)
+{
+  while (list->first != NULL)
+    {
+      P_Initializer *kill = list->first;
+      list->first = kill->next;
+      p_initializer_destroy (kill);
+    }
+  list->last = NULL;
+}
+
+typedef struct P_EnumValueNode P_EnumValueNode;
+typedef struct P_EnumValueList P_EnumValueList;
+struct P_EnumValueList
+{
+  P_EnumValueNode *first, *last;
+};
+
+struct P_EnumValueNode
+{
+  P_EnumValueNode *next;
+  DBCC_EnumValue *enum_value;
+};
+static void
+p_enumerator_list_clear (P_EnumValueList *list)
+{
+  while (list->first != NULL)
+    {
+      P_EnumValueNode *kill = list->first;
+      list->first = kill->next;
+      free (kill);
+    }
+  list->last = NULL;
+}
+
+
+typedef struct P_IdentifierList P_IdentifierList;
+typedef struct P_IdentifierNode P_IdentifierNode;
+struct P_IdentifierList
+{
+  P_IdentifierNode *first, *last;
+};
+struct P_IdentifierNode
+{
+  DBCC_Symbol *identifier;
+  P_IdentifierNode *prev, *next;
+};
+static void p_identifier_node_destroy(P_IdentifierNode *node) { free(node); }
+static void
+p_identifier_list_clear (P_IdentifierList *list)
+{
+  while (list->first != NULL)
+    {
+      P_IdentifierNode *kill = list->first;
+      list->first = kill->next;
+      p_identifier_node_destroy (kill);
+    }
+  list->last = NULL;
+}
+static void
+p_identifier_list_append (P_IdentifierList *list, DBCC_Symbol *identifier)
+{
+  P_IdentifierNode *node = malloc (sizeof (P_IdentifierNode));
+  if (list->first)
+    list->last->next = node;
+  else
+    list->first = node;
+  list->last = node;
+  node->identifier = identifier;
+  node->next = NULL;
+}
+
+
+struct P_GenericAssociationList
+{
+  P_GenericAssociation *first, *last;
+};
+struct P_GenericAssociation
+{
+  P_GenericAssociation *next;
+  DBCC_Type *type;
+  DBCC_Expr *expr;
+};
+static P_GenericAssociation *
+p_generic_association_new (DBCC_Type *type, DBCC_Expr *expr)
+{
+  P_GenericAssociation *rv = malloc (sizeof (P_GenericAssociation));
+  rv->next = NULL;
+  rv->type = type;
+  rv->expr = expr;
+  return rv;
+}
+static void p_generic_association_destroy (P_GenericAssociation *ga)
+{
+  dbcc_type_unref (ga->type);
+  dbcc_expr_destroy (ga->expr);
+  free (ga);
+}
+static void p_generic_association_list_clear (P_GenericAssociationList *list)
+{
+  while (list->first != NULL)
+    {
+      P_GenericAssociation *kill = list->first;
+      list->first = kill->next;
+      p_generic_association_destroy (kill);
+    }
+  list->last = NULL;
+}
+
+struct P_DeclarationList
+{
+  P_Declaration *first_declaration;
+  P_Declaration *last_declaration;
+};
+
+struct P_ParameterList
+{
+  P_DeclarationList parameters;
+  bool has_varargs;
+};
+struct P_DeclaratorList
+{
+  P_Declarator *first_declarator;
+  P_Declarator *last_declarator;
+};
+typedef enum
+{
+  P_DECLARATION_TYPE_DECLARATION,
+  P_DECLARATION_TYPE_STATIC_ASSERT,
+} P_DeclarationType;
+
+
+typedef enum
+{
+  P_DECLARATOR_TYPE_NAME,
+  P_DECLARATOR_TYPE_POINTER,
+  P_DECLARATOR_TYPE_ARRAY,
+  P_DECLARATOR_TYPE_VARLEN_ARRAY,
+  P_DECLARATOR_TYPE_BITFIELD,
+  P_DECLARATOR_TYPE_FUNCTION,
+  P_DECLARATOR_TYPE_KR_FUNCTION,
+  P_DECLARATOR_TYPE_PARENTHESIZED       // usually ignored; distinguishes return-value and name in function-type declarators
+} P_DeclaratorType;
+
+struct P_Declarator
+{
+  P_DeclaratorType declarator_type;
+  P_Declarator *prev, *next;            // only for toplevel declarator
+  DBCC_CodePosition *code_position;
+  union {
+    DBCC_Symbol *v_name;
+    struct {
+      DBCC_TypeQualifier qualifiers;
+      P_Declarator *target;
+    } v_pointer;
+    struct {
+      DBCC_TypeQualifier qualifiers;
+      P_Declarator *child;
+      DBCC_Expr *size;
+    } v_array;
+    struct {
+      DBCC_TypeQualifier qualifiers;
+      P_Declarator *child;
+    } v_varlen_array;
+    struct {
+      P_Declarator *child;
+      DBCC_Expr *bit_width;
+    } v_bitfield;
+    struct {
+      P_Declarator *child;
+      P_ParameterList parameters;
+    } v_function;
+    struct {
+      P_Declarator *child;
+      P_IdentifierList parameters;
+    } v_kr_function;
+    struct {
+      P_Declarator *child;
+    } v_parenthesized;
+  };
+  P_Initializer *initializer;
+};
+typedef enum
+{
+  P_TYPE_SPECIFIERS_INDEX_VOID      = 0,
+  P_TYPE_SPECIFIERS_INDEX_CHAR      = 1,
+  P_TYPE_SPECIFIERS_INDEX_INT       = 2,
+  P_TYPE_SPECIFIERS_INDEX_SHORT     = 3,
+  P_TYPE_SPECIFIERS_INDEX_LONG      = 4,
+  P_TYPE_SPECIFIERS_INDEX_UNSIGNED  = 5,
+  P_TYPE_SPECIFIERS_INDEX_SIGNED    = 6,
+  P_TYPE_SPECIFIERS_INDEX_FLOAT     = 7,
+  P_TYPE_SPECIFIERS_INDEX_DOUBLE    = 8,
+  P_TYPE_SPECIFIERS_INDEX_BOOL      = 9,
+  P_TYPE_SPECIFIERS_INDEX_ATOMIC    = 10,
+  P_TYPE_SPECIFIERS_INDEX_COMPLEX   = 11,
+  P_TYPE_SPECIFIERS_INDEX_IMAGINARY = 12,
+  P_TYPE_SPECIFIERS_INDEX_TYPEDEF   = 13,
+  P_TYPE_SPECIFIERS_INDEX_STRUCT    = 14,
+  P_TYPE_SPECIFIERS_INDEX_UNION     = 15,
+  P_TYPE_SPECIFIERS_INDEX_ENUM      = 16
+} P_TypeSpecifiersIndex;
+#define N_TYPE_SPECIFIER_KEYWORDS     17
+#define P_TYPE_SPECIFIER_KEYWORD_FOREACH(macro) \
+  macro(VOID)       \
+  macro(CHAR)       \
+  macro(INT)        \
+  macro(SHORT)      \
+  macro(LONG)       \
+  macro(UNSIGNED)   \
+  macro(SIGNED)     \
+  macro(FLOAT)      \
+  macro(DOUBLE)     \
+  macro(BOOL)       \
+  macro(ATOMIC)     \
+  macro(COMPLEX)    \
+  macro(IMAGINARY)  \
+  macro(TYPEDEF)    \
+  macro(STRUCT)     \
+  macro(UNION)      \
+  macro(ENUM)
+
+static uint8_t max_instances_of_counts[N_TYPE_SPECIFIER_KEYWORDS] =
+{
+  1,
+  1,
+  1,
+  1,
+  2,            // long long is allowed, the only allowed repeated keyword
+  1,
+  1,
+  1,
+  1,
+  1,
+  1,
+  1,
+  1,
+  1,
+  1,
+  1,
+  1,
+};
+#define CONFLICTS_WITH(type1, braced_list) \
+static P_TypeSpecifiersIndex conflicts_with_##type1[] = braced_list;
+#define TYPE_SPECIFIERS_LIST(...) { __VA_ARGS__ }
+
+CONFLICTS_WITH(VOID, TYPE_SPECIFIERS_LIST(
+  P_TYPE_SPECIFIERS_INDEX_CHAR,
+  P_TYPE_SPECIFIERS_INDEX_INT,
+  P_TYPE_SPECIFIERS_INDEX_SHORT,
+  P_TYPE_SPECIFIERS_INDEX_LONG,
+  P_TYPE_SPECIFIERS_INDEX_UNSIGNED,
+  P_TYPE_SPECIFIERS_INDEX_SIGNED,
+  P_TYPE_SPECIFIERS_INDEX_FLOAT,
+  P_TYPE_SPECIFIERS_INDEX_DOUBLE,
+  P_TYPE_SPECIFIERS_INDEX_BOOL,
+  P_TYPE_SPECIFIERS_INDEX_COMPLEX,
+  P_TYPE_SPECIFIERS_INDEX_IMAGINARY,
+  P_TYPE_SPECIFIERS_INDEX_TYPEDEF,
+  P_TYPE_SPECIFIERS_INDEX_STRUCT,
+  P_TYPE_SPECIFIERS_INDEX_UNION,
+  P_TYPE_SPECIFIERS_INDEX_ENUM
+  ))
+CONFLICTS_WITH(CHAR, TYPE_SPECIFIERS_LIST(
+  P_TYPE_SPECIFIERS_INDEX_INT,
+  P_TYPE_SPECIFIERS_INDEX_SHORT,
+  P_TYPE_SPECIFIERS_INDEX_LONG,
+  P_TYPE_SPECIFIERS_INDEX_FLOAT,
+  P_TYPE_SPECIFIERS_INDEX_DOUBLE,
+  P_TYPE_SPECIFIERS_INDEX_BOOL,
+  P_TYPE_SPECIFIERS_INDEX_TYPEDEF,
+  P_TYPE_SPECIFIERS_INDEX_STRUCT,
+  P_TYPE_SPECIFIERS_INDEX_UNION,
+  P_TYPE_SPECIFIERS_INDEX_ENUM
+))
+CONFLICTS_WITH(INT, TYPE_SPECIFIERS_LIST(
+  P_TYPE_SPECIFIERS_INDEX_FLOAT,
+  P_TYPE_SPECIFIERS_INDEX_DOUBLE,
+  P_TYPE_SPECIFIERS_INDEX_BOOL,
+  P_TYPE_SPECIFIERS_INDEX_TYPEDEF,
+  P_TYPE_SPECIFIERS_INDEX_STRUCT,
+  P_TYPE_SPECIFIERS_INDEX_UNION,
+  P_TYPE_SPECIFIERS_INDEX_ENUM
+))
+CONFLICTS_WITH(SHORT, TYPE_SPECIFIERS_LIST(
+  P_TYPE_SPECIFIERS_INDEX_LONG,
+  P_TYPE_SPECIFIERS_INDEX_FLOAT,
+  P_TYPE_SPECIFIERS_INDEX_DOUBLE,
+  P_TYPE_SPECIFIERS_INDEX_BOOL,
+  P_TYPE_SPECIFIERS_INDEX_TYPEDEF,
+  P_TYPE_SPECIFIERS_INDEX_STRUCT,
+  P_TYPE_SPECIFIERS_INDEX_UNION,
+  P_TYPE_SPECIFIERS_INDEX_ENUM
+))
+CONFLICTS_WITH(LONG, TYPE_SPECIFIERS_LIST(
+  P_TYPE_SPECIFIERS_INDEX_FLOAT,
+  P_TYPE_SPECIFIERS_INDEX_BOOL,
+  P_TYPE_SPECIFIERS_INDEX_TYPEDEF,
+  P_TYPE_SPECIFIERS_INDEX_STRUCT,
+  P_TYPE_SPECIFIERS_INDEX_UNION,
+  P_TYPE_SPECIFIERS_INDEX_ENUM
+))
+CONFLICTS_WITH(FLOAT, TYPE_SPECIFIERS_LIST(
+  P_TYPE_SPECIFIERS_INDEX_SIGNED,
+  P_TYPE_SPECIFIERS_INDEX_UNSIGNED,
+  P_TYPE_SPECIFIERS_INDEX_DOUBLE,
+  P_TYPE_SPECIFIERS_INDEX_BOOL,
+  P_TYPE_SPECIFIERS_INDEX_TYPEDEF,
+  P_TYPE_SPECIFIERS_INDEX_STRUCT,
+  P_TYPE_SPECIFIERS_INDEX_UNION,
+  P_TYPE_SPECIFIERS_INDEX_ENUM
+))
+CONFLICTS_WITH(DOUBLE, TYPE_SPECIFIERS_LIST(
+  P_TYPE_SPECIFIERS_INDEX_SIGNED,
+  P_TYPE_SPECIFIERS_INDEX_UNSIGNED,
+  P_TYPE_SPECIFIERS_INDEX_BOOL,
+  P_TYPE_SPECIFIERS_INDEX_TYPEDEF,
+  P_TYPE_SPECIFIERS_INDEX_STRUCT,
+  P_TYPE_SPECIFIERS_INDEX_UNION,
+  P_TYPE_SPECIFIERS_INDEX_ENUM
+))
+CONFLICTS_WITH(SIGNED, TYPE_SPECIFIERS_LIST(
+  P_TYPE_SPECIFIERS_INDEX_UNSIGNED,
+  P_TYPE_SPECIFIERS_INDEX_TYPEDEF,
+  P_TYPE_SPECIFIERS_INDEX_STRUCT,
+  P_TYPE_SPECIFIERS_INDEX_UNION,
+  P_TYPE_SPECIFIERS_INDEX_ENUM
+))
+CONFLICTS_WITH(UNSIGNED, TYPE_SPECIFIERS_LIST(
+  P_TYPE_SPECIFIERS_INDEX_SIGNED,
+  P_TYPE_SPECIFIERS_INDEX_TYPEDEF,
+  P_TYPE_SPECIFIERS_INDEX_STRUCT,
+  P_TYPE_SPECIFIERS_INDEX_UNION,
+  P_TYPE_SPECIFIERS_INDEX_ENUM
+))
+CONFLICTS_WITH(BOOL, TYPE_SPECIFIERS_LIST(
+  P_TYPE_SPECIFIERS_INDEX_COMPLEX,
+  P_TYPE_SPECIFIERS_INDEX_IMAGINARY,
+  P_TYPE_SPECIFIERS_INDEX_TYPEDEF,
+  P_TYPE_SPECIFIERS_INDEX_STRUCT,
+  P_TYPE_SPECIFIERS_INDEX_UNION,
+  P_TYPE_SPECIFIERS_INDEX_ENUM
+))
+CONFLICTS_WITH(COMPLEX, TYPE_SPECIFIERS_LIST(
+  P_TYPE_SPECIFIERS_INDEX_IMAGINARY,
+  P_TYPE_SPECIFIERS_INDEX_TYPEDEF,
+  P_TYPE_SPECIFIERS_INDEX_STRUCT,
+  P_TYPE_SPECIFIERS_INDEX_UNION,
+  P_TYPE_SPECIFIERS_INDEX_ENUM
+))
+CONFLICTS_WITH(IMAGINARY, TYPE_SPECIFIERS_LIST(
+  P_TYPE_SPECIFIERS_INDEX_TYPEDEF,
+  P_TYPE_SPECIFIERS_INDEX_STRUCT,
+  P_TYPE_SPECIFIERS_INDEX_UNION,
+  P_TYPE_SPECIFIERS_INDEX_ENUM
+))
+CONFLICTS_WITH(ATOMIC, TYPE_SPECIFIERS_LIST())
+CONFLICTS_WITH(TYPEDEF, TYPE_SPECIFIERS_LIST(
+  P_TYPE_SPECIFIERS_INDEX_STRUCT,
+  P_TYPE_SPECIFIERS_INDEX_UNION,
+  P_TYPE_SPECIFIERS_INDEX_ENUM
+))
+CONFLICTS_WITH(STRUCT, TYPE_SPECIFIERS_LIST(
+  P_TYPE_SPECIFIERS_INDEX_UNION,
+  P_TYPE_SPECIFIERS_INDEX_ENUM
+))
+CONFLICTS_WITH(UNION, TYPE_SPECIFIERS_LIST(
+  P_TYPE_SPECIFIERS_INDEX_ENUM
+))
+CONFLICTS_WITH(ENUM, TYPE_SPECIFIERS_LIST())
+static struct { size_t n_conflicts;
+                P_TypeSpecifiersIndex *conflicts; } conflict_table[N_TYPE_SPECIFIER_KEYWORDS] =
+{
+#define emit_conflict_table_entry(shortname) \
+  { sizeof(conflicts_with_##shortname)/sizeof(conflicts_with_##shortname[0]), \
+    conflicts_with_##shortname },
+  P_TYPE_SPECIFIER_KEYWORD_FOREACH(emit_conflict_table_entry)
+};
+#undef emit_conflict_table_entry
+
+
+static const char *
+count_index_to_keyword (unsigned i)
+{
+  switch (i)
+    {
+    case P_TYPE_SPECIFIERS_INDEX_VOID: return "void";
+    case P_TYPE_SPECIFIERS_INDEX_CHAR: return "char";
+    case P_TYPE_SPECIFIERS_INDEX_INT: return "int";
+    case P_TYPE_SPECIFIERS_INDEX_SHORT: return "short";
+    case P_TYPE_SPECIFIERS_INDEX_LONG: return "long";
+    case P_TYPE_SPECIFIERS_INDEX_UNSIGNED: return "unsigned";
+    case P_TYPE_SPECIFIERS_INDEX_SIGNED: return "signed";
+    case P_TYPE_SPECIFIERS_INDEX_FLOAT: return "float";
+    case P_TYPE_SPECIFIERS_INDEX_DOUBLE: return "double";
+    case P_TYPE_SPECIFIERS_INDEX_BOOL: return "bool";
+    case P_TYPE_SPECIFIERS_INDEX_ATOMIC: return "_Atomic";
+    case P_TYPE_SPECIFIERS_INDEX_COMPLEX: return "_Complex";
+    case P_TYPE_SPECIFIERS_INDEX_IMAGINARY: return "_Imaginary";
+    case P_TYPE_SPECIFIERS_INDEX_TYPEDEF: return "typedef";
+    case P_TYPE_SPECIFIERS_INDEX_STRUCT: return "struct";
+    case P_TYPE_SPECIFIERS_INDEX_UNION: return "union";
+    case P_TYPE_SPECIFIERS_INDEX_ENUM: return "enum";
+    default: return "unknSown-type-specifier";
+    }
+}
+
+typedef struct
+{
+  uint8_t counts[N_TYPE_SPECIFIER_KEYWORDS];
+  DBCC_Symbol *symbol;
+  DBCC_Symbol *id;              // for named structs, unions, enums
+  bool is_stub;                 // for forward-declared structs+unions+enums
+
+  // for enum, atomic, typedef, struct, union: this is the actual (un-qualified) tyype)
+  DBCC_Type *type;              
+} P_TypeSpecifiers;
+
+#define P_TYPE_SPECIFIERS_INIT \
+    (P_TypeSpecifiers) \
+        {{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},NULL,NULL,false,NULL}
+
+static bool
+p_type_specifiers_combine (P_Context *context,
+                           P_TypeSpecifiers *in_out,
+                           P_TypeSpecifiers *modifier)
+{
+  for (unsigned i = 0; i < N_TYPE_SPECIFIER_KEYWORDS; i++)
+    {
+      uint8_t sum = in_out->counts[i] + modifier->counts[i];
+      if (sum < in_out->counts[i]
+       || sum > max_instances_of_counts[i])
+        {
+          context->error = dbcc_error_new (DBCC_ERROR_TOO_MANY_TYPE_SPECIFIERS,
+                                           "too many repeated qualifiers: at %s",
+                                           count_index_to_keyword (i));
+          return false;
+        }
+      in_out->counts[i] = sum;
+    }
+  for (unsigned i = 0; i < N_TYPE_SPECIFIER_KEYWORDS; i++)
+    if (in_out->counts[i] != 0)
+      {
+        unsigned nc = conflict_table[i].n_conflicts;
+        const P_TypeSpecifiersIndex *c = conflict_table[i].conflicts;
+        for (unsigned j = 0; j < nc; j++)
+          if (in_out->counts[c[j]] != 0)
+            {
+              context->error = dbcc_error_new (DBCC_ERROR_CONFLICTING_QUALIFIERS,
+                                               "'%s' is not allowed with '%s'",
+                                               count_index_to_keyword (i),
+                                               count_index_to_keyword (c[j]));
+              return false;
+            }
+      }
+  return true;
+}
+
+#if 0
+static bool
+p_type_specifiers_init_struct_or_union
+                              (P_TypeSpecifiers  *to_init,
+                               P_Context         *context,
+                               bool               is_struct,   // else union
+                               DBCC_Symbol       *opt_tag,
+                               P_DeclarationList *declaration_list)
+{
+  P_TypeSpecifiers rv = P_TYPE_SPECIFIERS_INIT;
+  rv.symbol = opt_tag;
+  rv.counts[P_TYPE_SPECIFIERS_INDEX_STRUCT] = 1;
+  
+  size_t n_params;
+  DBCC_Param *params;
+
+  if (!declaration_list_to_params (context, declaration_list, &n_params, &params))
+    return false;
+
+  if (is_struct)
+    to_init->type = dbcc_type_new_struct (opt_tag, n_params, params, &context->error);
+  else
+    to_init->type = dbcc_type_new_union (opt_tag, n_params, params, &context->error);
+
+  return to_init->type != NULL;
+}
+#endif
+
+static void
+p_type_specifiers_clear (P_TypeSpecifiers *ts)
+{
+  (void) ts;
+  //if (ts->type != NULL)
+    //dbcc_type_unref (ts->type);
+}
+
+struct P_Declaration
+{
+  P_DeclarationType type;
+  P_Declaration *next;
+  union {
+    struct {
+      DBCC_StorageClassSpecifier storage_class_specifiers;
+      DBCC_FunctionSpecifiers function_specifiers;
+      DBCC_TypeQualifier qualifiers;
+      P_AlignmentSpecifier *alignment_specifier;
+      P_TypeSpecifiers specifiers;
+      P_DeclaratorList declarators;
+      DBCC_Statement *body;             // for functions (which must be a the sole declarator)
+    } v_declaration;
+    struct {
+      DBCC_Expr *constant_expr;
+      DBCC_String message;
+    } v_static_assertion;
+  };
+};
+
+static P_Declaration *
+p_declaration_new (void)
+{
+  P_Declaration *rv = malloc (sizeof (P_Declaration));
+  rv->type = P_DECLARATION_TYPE_DECLARATION;
+  rv->next = NULL;
+  rv->v_declaration.qualifiers = 0;
+  rv->v_declaration.storage_class_specifiers = 0;
+  rv->v_declaration.function_specifiers = 0;
+  rv->v_declaration.specifiers = P_TYPE_SPECIFIERS_INIT;
+  rv->v_declaration.declarators.first_declarator = NULL;
+  rv->v_declaration.declarators.last_declarator = NULL;
+  rv->v_declaration.alignment_specifier = NULL;
+  rv->v_declaration.body = NULL;
+  return rv;
+}
+static P_Declaration *
+p_static_assertion_new (DBCC_Expr *expr, DBCC_String *explanation)
+{
+  P_Declaration *rv = malloc (sizeof (P_Declaration));
+  rv->type = P_DECLARATION_TYPE_STATIC_ASSERT;
+  rv->next = NULL;
+  rv->v_static_assertion.constant_expr = expr;
+  rv->v_static_assertion.message = *explanation;
+  return rv;
+}
+
+static P_Declarator *
+p_declarator_new_pointer (DBCC_TypeQualifier qualifiers,
+                          P_Declarator *child,
+                          DBCC_CodePosition *cp)
+{
+  P_Declarator *rv = malloc (sizeof(P_Declarator));
+  rv->declarator_type = P_DECLARATOR_TYPE_POINTER;
+  rv->code_position = cp;
+  rv->prev = rv->next = NULL;
+  rv->v_pointer.qualifiers = qualifiers;
+  rv->v_pointer.target = child;
+  rv->initializer = NULL;
+  return rv;
+}
+
+static P_Declarator *
+p_declarator_new_array   (DBCC_TypeQualifier qualifiers,
+                          DBCC_Expr    *size,
+                          P_Declarator *child)
+{
+  P_Declarator *rv = malloc (sizeof(P_Declarator));
+  rv->declarator_type = P_DECLARATOR_TYPE_ARRAY;
+  rv->code_position = dbcc_code_position_ref (child->code_position);
+  rv->prev = rv->next = NULL;
+  rv->v_array.qualifiers = qualifiers;
+  rv->v_array.child = child;
+  rv->v_array.size = size;
+  rv->initializer = NULL;
+  return rv;
+}
+
+static P_Declarator *
+p_declarator_new_varlen_array   (DBCC_TypeQualifier qualifiers,
+                                 P_Declarator *child)
+{
+  P_Declarator *rv = malloc (sizeof(P_Declarator));
+  rv->declarator_type = P_DECLARATOR_TYPE_VARLEN_ARRAY;
+  rv->prev = rv->next = NULL;
+  rv->v_varlen_array.qualifiers = qualifiers;
+  rv->v_varlen_array.child = child;
+  rv->initializer = NULL;
+  return rv;
+}
+
+static P_Declarator *
+p_declarator_new_name    (DBCC_Symbol  *symbol)
+{
+  P_Declarator *rv = malloc (sizeof(P_Declarator));
+  rv->declarator_type = P_DECLARATOR_TYPE_NAME;
+  rv->prev = rv->next = NULL;
+  rv->v_name = symbol;
+  rv->initializer = NULL;
+  return rv;
+}
+
+static P_Declarator *
+p_declarator_new_bitfield    (P_Declarator *child,
+                              DBCC_Expr    *bit_width)
+{
+  P_Declarator *rv = malloc (sizeof(P_Declarator));
+  rv->declarator_type = P_DECLARATOR_TYPE_BITFIELD;
+  rv->next = NULL;
+  rv->v_bitfield.bit_width = bit_width;
+  rv->v_bitfield.child = child;
+  rv->initializer = NULL;
+  return rv;
+}
+
+static P_Declarator *
+p_declarator_new_function    (P_Declarator *child,
+                              P_ParameterList *args)
+{
+  P_Declarator *rv = malloc (sizeof(P_Declarator));
+  rv->declarator_type = P_DECLARATOR_TYPE_FUNCTION;
+  rv->next = NULL;
+  if (args != NULL)
+    rv->v_function.parameters = *args;
+  else
+    {
+      rv->v_function.parameters.parameters.first_declaration = NULL;
+      rv->v_function.parameters.parameters.last_declaration = NULL;
+      rv->v_function.parameters.has_varargs = false;
+    }
+  rv->v_function.child = child;
+  rv->initializer = NULL;
+  return rv;
+}
+static P_Declarator *
+p_declarator_new_function_kr (P_Declarator *child,
+                              P_IdentifierList *args)
+{
+  P_Declarator *rv = malloc (sizeof(P_Declarator));
+  rv->declarator_type = P_DECLARATOR_TYPE_KR_FUNCTION;
+  rv->next = NULL;
+  if (args != NULL)
+    {
+      rv->v_kr_function.parameters = *args;
+    }
+  else
+    {
+      rv->v_kr_function.parameters.first = NULL;
+      rv->v_kr_function.parameters.last = NULL;
+    }
+  rv->v_function.child = child;
+  rv->initializer = NULL;
+  return rv;
+}
+
+
+
+static void
+p_declarator_destroy     (P_Declarator *d)
+{
+  switch (d->declarator_type)
+    {
+    case P_DECLARATOR_TYPE_POINTER:
+      p_declarator_destroy (d->v_pointer.target);
+      break;
+    case P_DECLARATOR_TYPE_ARRAY:
+      p_declarator_destroy (d->v_array.child);
+      dbcc_expr_destroy (d->v_array.size);
+      break;
+    case P_DECLARATOR_TYPE_VARLEN_ARRAY:
+      p_declarator_destroy (d->v_varlen_array.child);
+      break;
+    case P_DECLARATOR_TYPE_NAME:
+      break;
+    default:
+      assert(0);
+    }
+  free (d);
+}
+
+
+static void
+p_declaration_append_declarator (P_Declaration *parent,
+                                 P_Declarator  *child)
+{
+  assert(parent->type == P_DECLARATION_TYPE_DECLARATION);
+  if (parent->v_declaration.declarators.first_declarator == NULL)
+    parent->v_declaration.declarators.first_declarator = child;
+  else
+    parent->v_declaration.declarators.last_declarator->next = child;
+  parent->v_declaration.declarators.last_declarator = child;
+  child->next = NULL;
+}
+
+static void p_declarator_list_clear (P_DeclaratorList *list);
+static void p_declaration_destroy (P_Declaration *decl)
+{
+  switch (decl->type)
+    {
+    case P_DECLARATION_TYPE_STATIC_ASSERT:
+      dbcc_expr_destroy (decl->v_static_assertion.constant_expr);
+      dbcc_string_clear (&decl->v_static_assertion.message);
+      break;
+    case P_DECLARATION_TYPE_DECLARATION:
+      p_type_specifiers_clear (&decl->v_declaration.specifiers);
+      p_declarator_list_clear (&decl->v_declaration.declarators);
+      break;
+    default:
+      assert(0);
+    }
+  free (decl);
+}
+static void
+p_declaration_list_clear (P_DeclarationList *list)
+{
+  while (list->first_declaration != NULL)
+    {
+      P_Declaration *kill = list->first_declaration;
+      list->first_declaration = kill->next;
+      p_declaration_destroy (kill);
+    }
+  list->last_declaration = NULL;
+}
+static void
+p_declarator_list_clear (P_DeclaratorList *list)
+{
+  while (list->first_declarator != NULL)
+    {
+      P_Declarator *kill = list->first_declarator;
+      list->first_declarator = kill->next;
+      p_declarator_destroy (kill);
+    }
+  list->last_declarator = NULL;
+}
+static void
+p_parameter_list_clear (P_ParameterList *list)
+{
+  p_declaration_list_clear(&list->parameters);
+}
+
+typedef struct P_ExprList P_ExprList;
+typedef struct P_ExprNode P_ExprNode;
+struct P_ExprList
+{
+  P_ExprNode *first, *last;
+};
+struct P_ExprNode
+{
+  DBCC_Expr *expr;
+  P_ExprNode *next;
+};
+static P_ExprNode *p_expr_node_new (DBCC_Expr *expr)
+{
+  P_ExprNode *rv = malloc (sizeof (P_ExprNode));
+  rv->expr = expr;
+  rv->next = NULL;
+  return rv;
+}
+static void
+p_expr_node_destroy (P_ExprNode *node)
+{
+  dbcc_expr_destroy (node->expr);
+  free (node);
+}
+static void
+p_expr_list_clear (P_ExprList *list)
+{
+  while (list->first != NULL)
+    {
+      P_ExprNode *kill = list->first;
+      list->first= kill->next;
+      p_expr_node_destroy (kill);
+    }
+  list->last = NULL;
+}
+
+typedef struct P_StatementList P_StatementList;
+typedef struct P_StatementNode P_StatementNode;
+struct P_StatementList
+{
+  P_StatementNode *first, *last;
+};
+struct P_StatementNode
+{
+  DBCC_Statement *statement;
+  P_StatementNode *prev, *next;
+};
+static void
+p_statement_node_destroy (P_StatementNode *node)
+{
+  dbcc_statement_destroy (node->statement);
+  free (node);
+}
+static void
+p_statement_list_clear (P_StatementList *list)
+{
+  while (list->first != NULL)
+    {
+      P_StatementNode *kill = list->first;
+      list->first= kill->next;
+      p_statement_node_destroy (kill);
+    }
+  list->last = NULL;
+}
+
+static void
+p_statement_list_init_empty (P_StatementList *init)
+{
+  init->first = init->last = NULL;
+}
+static void
+p_statement_list_init1 (P_StatementList *init, DBCC_Statement *stmt)
+{
+  P_StatementNode *node = malloc (sizeof (P_StatementNode));
+  node->next = NULL;
+  node->statement = stmt;
+  init->first = init->last = node;
+}
+static void
+p_statement_list_append (P_StatementList *list, DBCC_Statement *stmt)
+{
+
+  P_StatementNode *node = malloc (sizeof (P_StatementNode));
+  node->next = NULL;
+  node->statement = stmt;
+  if (list->last == NULL)
+    list->first = node;
+  else
+    list->last->next = node;
+  list->last = node;
+}
+static void
+p_statement_list_append_list (P_StatementList *list, P_StatementList *add)
+{
+  if (add->first == NULL)
+    return;
+  if (list->first == NULL)
+    {
+      *list = *add;
+      return;
+    }
+  list->last->next = add->first;
+  list->last = add->last;
+}
+
+static DBCC_Statement *
+statement_from_list (P_StatementList *list)
+{
+  if (list->first == NULL)
+    return dbcc_statement_new_empty();
+  if (list->first->next == NULL)
+    return list->first->statement;
+  unsigned n_stmts = 0;
+  for (P_StatementNode *at = list->first; at != NULL; at = at->next)
+    n_stmts++;
+  DBCC_Statement **stmts = malloc (sizeof(DBCC_Statement*) * n_stmts);
+  unsigned i = 0;
+  for (P_StatementNode *at = list->first; at != NULL; at = at->next, i++)
+    stmts[i] = at->statement;
+  while (list->first != NULL)
+    {
+      P_StatementNode *kill = list->first;
+      list->first = kill->next;
+      free (kill);
+    }
+  return dbcc_statement_new_compound(n_stmts, stmts, false);
+}
+
+#if 0
+static P_AlignmentSpecifier *
+p_alignment_specifier_new_by_type (DBCC_Type *type)
+{
+  P_AlignmentSpecifier *rv = malloc (sizeof (P_AlignmentSpecifier));
+  rv->specifier_type = P_ALIGNMENT_SPECIFIER_BY_TYPE;
+  rv->v_type = type;
+  return rv;
+}
+static P_AlignmentSpecifier *
+p_alignment_specifier_new_by_expr (DBCC_Expr *expr)
+{
+  P_AlignmentSpecifier *rv = malloc (sizeof (P_AlignmentSpecifier));
+  rv->specifier_type = P_ALIGNMENT_SPECIFIER_BY_EXPR;
+  rv->v_expr = expr;
+  return rv;
+}
+#endif
+  
+static void
+p_alignment_specifier_destroy (P_AlignmentSpecifier *spec)
+{
+  switch (spec->specifier_type)
+    {
+    case P_ALIGNMENT_SPECIFIER_BY_TYPE:
+      dbcc_type_unref (spec->v_type);
+      spec->v_type = NULL;
+      break;
+    case P_ALIGNMENT_SPECIFIER_BY_EXPR:
+      dbcc_expr_destroy (spec->v_expr);
+      spec->v_type = NULL;
+      break;
+    }
+  free (spec);
+}
+
+
+// A designator is how by-name structure members or array elements are initialized.
+// Note that there's a list of these b/c you can do things like:
+//     Obj a = { .x.value[4] = 42 };
+struct P_Designator
+{
+  bool is_array;
+  union {
+    DBCC_Expr *v_array_index;
+    DBCC_Symbol *v_struct_member;
+  };
+  P_Designator *next;
+};
+static void 
+p_designator_destroy (P_Designator *p)
+{
+  if (p->is_array)
+    {
+      if (p->v_array_index != NULL)
+        dbcc_expr_destroy (p->v_array_index);
+    }
+  else
+    {
+      //object_member
+    }
+  free (p);
+}
+static P_Designator *
+p_designator_new_array_index (DBCC_Expr *expr)
+{
+  P_Designator *rv = malloc (sizeof (P_Designator));
+  rv->is_array = true;
+  rv->v_array_index = expr;
+  rv->next = NULL;
+  return rv;
+}
+static P_Designator *
+p_designator_new_struct_member (DBCC_Symbol *name)
+{
+  P_Designator *rv = malloc (sizeof (P_Designator));
+  rv->is_array = false;
+  rv->v_struct_member = name;
+  rv->next = NULL;
+  return rv;
+}
+  
+static void
+p_designator_list_clear (P_DesignatorList *list)
+{
+  while (list->first != NULL)
+    {
+      P_Designator *kill = list->first;
+      list->first = kill->next;
+      p_designator_destroy (kill);
+    }
+  list->last = NULL;
+}
+
+
+static void
+structured_initializer_from_p_initializer_list (P_InitializerList *list,
+                                                DBCC_StructuredInitializer *out);
+static void
+structured_initializer_piece_from_p_initializer (P_Initializer *zer,
+                                                 DBCC_StructuredInitializerPiece *out)
+{
+  size_t n_designators = 0;
+  for (P_Designator *at = zer->designators.first; at; at = at->next)
+    n_designators++;
+  DBCC_Designator *designators;
+  if (n_designators == 0)
+    designators = NULL;
+  else
+    designators = malloc (sizeof (DBCC_Designator) * n_designators);
+  size_t di = 0;
+  for (P_Designator *at = zer->designators.first; at != NULL; at = at->next, di++)
+    {
+      if (at->is_array)
+        {
+          designators[di].type = DBCC_DESIGNATOR_INDEX;
+          designators[di].v_index = at->v_array_index;
+        }
+      else
+        {
+          designators[di].type = DBCC_DESIGNATOR_MEMBER;
+          designators[di].v_member = at->v_struct_member;
+        }
+    }
+  out->n_designators = n_designators;
+  out->designators = designators;
+  switch (zer->initializer_type)
+    {
+    case P_INITIALIZER_TYPE_STRUCTURED:
+      structured_initializer_from_p_initializer_list (&zer->v_structured, &out->v_structured_initializer);
+      out->is_expr = false;
+      break;
+    case P_INITIALIZER_TYPE_EXPR:
+      out->v_expr = zer->v_expr;
+      out->is_expr = true;
+      break;
+    }
+}
+static void
+structured_initializer_from_p_initializer_list (P_InitializerList *list,
+                                                DBCC_StructuredInitializer *out)
+{
+  size_t count = 0;
+  for (P_Initializer *init = list->first; init != NULL; init = init->next)
+    count++;
+  out->n_pieces = count;
+  out->pieces = malloc (count * sizeof (DBCC_StructuredInitializerPiece));
+  size_t i = 0;
+  for (P_Initializer *init = list->first; init != NULL; init = init->next)
+    {
+      structured_initializer_piece_from_p_initializer (init, out->pieces + i);
+      i++;
+    }
+}
+static DBCC_Type * type_from_parts (P_Context *context,
+                                    P_Declaration *declaration,
+                                    P_Declarator *declarator);
+
+static P_Declarator *
+declarator_find_parenthesized_part (P_Declarator *d)
+{
+  while (d != NULL)
+    {
+      switch (d->declarator_type)
+      {
+      case P_DECLARATOR_TYPE_NAME:
+        return NULL;
+      case P_DECLARATOR_TYPE_POINTER:
+        d = d->v_pointer.target;
+        break;
+      case P_DECLARATOR_TYPE_ARRAY:
+        d = d->v_array.child;
+        break;
+      case P_DECLARATOR_TYPE_VARLEN_ARRAY:
+        d = d->v_varlen_array.child;
+        break;
+      case P_DECLARATOR_TYPE_BITFIELD:
+        d = d->v_bitfield.child;
+        break;
+      case P_DECLARATOR_TYPE_FUNCTION:
+        d = d->v_function.child;
+        break;
+      case P_DECLARATOR_TYPE_KR_FUNCTION:
+        d = d->v_kr_function.child;
+        break;
+      case P_DECLARATOR_TYPE_PARENTHESIZED:
+        return d;
+      }
+    }
+  return NULL;
+}
+static DBCC_Symbol *
+name_from_declarator (P_Declarator *d)
+{
+  while (d != NULL)
+    {
+      switch (d->declarator_type)
+      {
+      case P_DECLARATOR_TYPE_NAME:
+        return d->v_name;
+      case P_DECLARATOR_TYPE_POINTER:
+        d = d->v_pointer.target;
+        break;
+      case P_DECLARATOR_TYPE_ARRAY:
+        d = d->v_array.child;
+        break;
+      case P_DECLARATOR_TYPE_VARLEN_ARRAY:
+        d = d->v_varlen_array.child;
+        break;
+      case P_DECLARATOR_TYPE_BITFIELD:
+        d = d->v_bitfield.child;
+        break;
+      case P_DECLARATOR_TYPE_FUNCTION:
+        d = d->v_function.child;
+        break;
+      case P_DECLARATOR_TYPE_KR_FUNCTION:
+        d = d->v_kr_function.child;
+        break;
+      case P_DECLARATOR_TYPE_PARENTHESIZED:
+        d = d->v_parenthesized.child;
+        break;
+      }
+    }
+  return NULL;
+}
+
+static DBCC_Type *
+declarator_modify_type (P_Context *context, 
+                        DBCC_Type *base_type,
+                        P_Declarator *declarator,
+                        bool          stop_at_parens)
+{
+  if (declarator == NULL)
+    return base_type;
+  switch (declarator->declarator_type)
+    {
+    case P_DECLARATOR_TYPE_NAME:
+      return base_type;
+    case P_DECLARATOR_TYPE_POINTER:
+      return dbcc_type_new_pointer (context->target_env,
+                                    base_type);
+    case P_DECLARATOR_TYPE_ARRAY:
+      {
+        size_t count = 0;
+        DBCC_Expr *size_expr = declarator->v_array.size;
+        if (size_expr != NULL)
+          {
+            if (size_expr->base.constant == NULL
+             || size_expr->base.constant->constant_type != DBCC_CONSTANT_TYPE_VALUE)
+              {
+                context->error = dbcc_error_new (DBCC_ERROR_CONSTANT_REQUIRED,
+                                     "size of array must be indicated by a numeric constant expression");
+                dbcc_error_add_code_position (context->error, size_expr->base.code_position);
+                return NULL;
+              }
+            if (!dbcc_cast_value (dbcc_namespace_get_size_type(context->globals), &count,
+                                  size_expr->base.value_type,
+                                  size_expr->base.constant->v_value.data))
+              {
+                context->error = dbcc_error_new (DBCC_ERROR_EXPECTED_INT,
+                                                 "bad expression type %s in array-size specifier",
+                                                 dbcc_symbol_get_string (size_expr->base.value_type->base.name));
+                return NULL;
+              }
+            return dbcc_type_new_array (context->target_env,
+                                        count,
+                                        base_type);
+          }
+      }
+    case P_DECLARATOR_TYPE_VARLEN_ARRAY:
+      return dbcc_type_new_varlen_array (context->target_env,
+                                         base_type);
+    case P_DECLARATOR_TYPE_BITFIELD:
+      {
+        DBCC_Expr *bw = declarator->v_bitfield.bit_width;
+        size_t width;
+        if (bw->base.constant == NULL
+         || bw->base.constant->constant_type != DBCC_CONSTANT_TYPE_VALUE)
+          {
+            context->error = dbcc_error_new (DBCC_ERROR_CONSTANT_REQUIRED,
+                                             "bitfield width must be an integer constant");
+            dbcc_error_add_code_position(context->error, bw->base.code_position);
+            return NULL;
+          }
+        if (!dbcc_cast_value (dbcc_namespace_get_size_type(context->globals), &width,
+                              bw->base.value_type, bw->base.constant->v_value.data))
+          {
+            context->error = dbcc_error_new (DBCC_ERROR_EXPECTED_INT,
+                                "bitfield width is not an integral type");
+            dbcc_error_add_code_position(context->error, bw->base.code_position);
+            return NULL;
+          }
+
+        // TODO: verify bitfield width is equal or smaller size of base_type
+        // (INCLUDE C11 SECTION REFERENCE)
+
+        //return dbcc_type_new_bitfield (width, base_type);
+        return base_type;
+      }
+    case P_DECLARATOR_TYPE_PARENTHESIZED:
+      {
+        if (stop_at_parens)
+          return base_type;
+        else
+          return declarator_modify_type (context, base_type, declarator->v_parenthesized.child, false);
+      }
+    case P_DECLARATOR_TYPE_FUNCTION:
+      {
+        P_Declarator *child = declarator->v_function.child;
+        DBCC_Type *rettype = declarator_modify_type (context, base_type, child, true);
+        if (rettype == NULL)
+          return NULL;
+
+        P_ParameterList plist = declarator->v_function.parameters;
+        DBCC_Param *params;
+        size_t n_params;
+        if (!declaration_list_to_params (context, &plist.parameters, &n_params, &params))
+          return NULL;
+
+        DBCC_Type *fct = dbcc_type_new_function (rettype, n_params, params, plist.has_varargs);
+        P_Declarator *subdecl = declarator_find_parenthesized_part (child);
+        return declarator_modify_type (context, fct, subdecl, false);
+      }
+    case P_DECLARATOR_TYPE_KR_FUNCTION:
+      {
+        assert(0);              // TODO
+        return NULL;
+      }
+    }
+}
+
+static DBCC_Type *
+type_specifiers_to_type (P_Context *context,
+                         P_TypeSpecifiers *specs)
+{
+  if (specs->counts[P_TYPE_SPECIFIERS_INDEX_COMPLEX])
+    {
+      if (specs->counts[P_TYPE_SPECIFIERS_INDEX_FLOAT])
+        return dbcc_namespace_get_complex_float_type (context->globals);
+      if (specs->counts[P_TYPE_SPECIFIERS_INDEX_DOUBLE])
+        {
+          if (specs->counts[P_TYPE_SPECIFIERS_INDEX_LONG])
+            return dbcc_namespace_get_complex_long_double_type (context->globals);
+          else
+            return dbcc_namespace_get_complex_double_type (context->globals);
+        }
+      context->error = dbcc_error_new (DBCC_ERROR_NO_COMPLEX_VARIANT,
+                                       "complex type of given base-type not allowed");
+      return NULL;
+    }
+  else if (specs->counts[P_TYPE_SPECIFIERS_INDEX_IMAGINARY])
+    {
+      if (specs->counts[P_TYPE_SPECIFIERS_INDEX_FLOAT])
+        return dbcc_namespace_get_imaginary_float_type (context->globals);
+      if (specs->counts[P_TYPE_SPECIFIERS_INDEX_DOUBLE])
+        {
+          if (specs->counts[P_TYPE_SPECIFIERS_INDEX_LONG])
+            return dbcc_namespace_get_imaginary_long_double_type (context->globals);
+          else
+            return dbcc_namespace_get_imaginary_double_type (context->globals);
+        }
+      context->error = dbcc_error_new (DBCC_ERROR_NO_COMPLEX_VARIANT,
+                                       "imaginary type of given base-type not allowed");
+      return NULL;
+    }
+  if (specs->counts[P_TYPE_SPECIFIERS_INDEX_UNSIGNED])
+    {
+      if (specs->counts[P_TYPE_SPECIFIERS_INDEX_CHAR])
+        return dbcc_namespace_get_unsigned_short_type(context->globals);
+      if (specs->counts[P_TYPE_SPECIFIERS_INDEX_SHORT])
+        return dbcc_namespace_get_unsigned_short_type(context->globals);
+      if (specs->counts[P_TYPE_SPECIFIERS_INDEX_LONG] == 2)
+        return dbcc_namespace_get_unsigned_long_long_type(context->globals);
+      if (specs->counts[P_TYPE_SPECIFIERS_INDEX_LONG] == 1)
+        return dbcc_namespace_get_unsigned_long_type(context->globals);
+      return dbcc_namespace_get_unsigned_int_type(context->globals);
+    }
+  else
+    {
+      if (specs->counts[P_TYPE_SPECIFIERS_INDEX_CHAR])
+        {
+          if (specs->counts[P_TYPE_SPECIFIERS_INDEX_SIGNED])
+            return dbcc_namespace_get_signed_char_type(context->globals);
+          else
+            return dbcc_namespace_get_char_type(context->globals);
+        }
+      if (specs->counts[P_TYPE_SPECIFIERS_INDEX_SHORT])
+        return dbcc_namespace_get_short_type(context->globals);
+      if (specs->counts[P_TYPE_SPECIFIERS_INDEX_LONG] == 2)
+        return dbcc_namespace_get_long_long_type(context->globals);
+      if (specs->counts[P_TYPE_SPECIFIERS_INDEX_LONG] == 1)
+        return dbcc_namespace_get_long_type(context->globals);
+      if (specs->counts[P_TYPE_SPECIFIERS_INDEX_INT])
+        return dbcc_namespace_get_int_type(context->globals);
+    }
+  if (specs->counts[P_TYPE_SPECIFIERS_INDEX_FLOAT])
+    {
+      return dbcc_namespace_get_float_type (context->globals);
+    }
+  if (specs->counts[P_TYPE_SPECIFIERS_INDEX_DOUBLE])
+    {
+      if (specs->counts[P_TYPE_SPECIFIERS_INDEX_LONG])
+        return dbcc_namespace_get_long_double_type (context->globals);
+      else
+        return dbcc_namespace_get_double_type (context->globals);
+    }
+  if (specs->counts[P_TYPE_SPECIFIERS_INDEX_TYPEDEF]
+   || specs->counts[P_TYPE_SPECIFIERS_INDEX_ENUM]
+   || specs->counts[P_TYPE_SPECIFIERS_INDEX_STRUCT]
+   || specs->counts[P_TYPE_SPECIFIERS_INDEX_UNION]
+   || specs->counts[P_TYPE_SPECIFIERS_INDEX_ATOMIC])
+    return specs->type;
+
+  assert(0);
+  return NULL;
+}
+
+static DBCC_Type *
+type_from_parts (P_Context *context,
+                 P_Declaration *declaration,
+                 P_Declarator *declarator)
+{
+  DBCC_Type *type = type_specifiers_to_type(context, &declaration->v_declaration.specifiers);
+  if (type == NULL)
+    return NULL;
+  DBCC_TypeQualifier q = declaration->v_declaration.qualifiers;
+  if (q != 0)
+    {
+      type = dbcc_type_new_qualified (context->target_env, type, q, &context->error);
+      if (type == NULL)
+        return NULL;
+    }
+
+  // storage-class-specifiers and function-specifiers do not make new types
+
+  return declarator_modify_type (context, type, declarator, false);
+}
+
+/* Put the names declared at file scope into the global namespace,
+ * so that later code can refer to them.  Typedefs are not
+ * handled yet.
+ */
+static bool
+p_context_declare_globals (P_Context *context, P_Declaration *decl)
+{
+  if (decl->type != P_DECLARATION_TYPE_DECLARATION
+   || (decl->v_declaration.storage_class_specifiers & DBCC_STORAGE_CLASS_SPECIFIER_TYPEDEF) != 0)
+    return true;
+  for (P_Declarator *declarator = decl->v_declaration.declarators.first_declarator;
+       declarator != NULL;
+       declarator = declarator->next)
+    {
+      DBCC_Symbol *name = name_from_declarator (declarator);
+      if (name == NULL)
+        continue;
+      DBCC_Type *type = type_from_parts (context, decl, declarator);
+      if (type == NULL)
+        return false;
+      dbcc_namespace_add_global (context->globals, name, type);
+    }
+  return true;
+}
+
+static bool
+declaration_to_statement_list (P_Context *context, P_Declaration *a, P_StatementList *rv)
+{
+  p_statement_list_init_empty (rv);
+  for (P_Declarator *declarator = a->v_declaration.declarators.first_declarator;
+       declarator != NULL;
+       declarator = declarator->next)
+    {
+      DBCC_Symbol *name = name_from_declarator (declarator);
+      assert(name != NULL);
+      DBCC_Type *type = type_from_parts (context, a, declarator);
+      if (type == NULL)
+        return false;
+      DBCC_Statement *stmt = dbcc_statement_new_declaration (a->v_declaration.storage_class_specifiers,
+                                                            type, name,
+                                                            declarator->code_position,
+                                                            &context->error);
+      if (stmt == NULL)
+        return false;
+      p_statement_list_append (rv, stmt);
+    }
+  return true;
+}
+#define ITERATE_DECLARATORS_OF_DECLARATION_LIST(list)               \
+    for (P_Declaration *declaration = (list)->first_declaration;      \
+         declaration != NULL;                                       \
+         declaration = declaration->next)                           \
+      for (P_Declarator *declarator = declaration->v_declaration.declarators.first_declarator;   \
+           declarator != NULL;                                     \
+           declarator = declarator->next)
+
+static size_t
+declaration_list_count_declarators (P_DeclarationList *list)
+{
+  size_t rv = 0;
+  ITERATE_DECLARATORS_OF_DECLARATION_LIST(list)
+    rv++;
+  return rv;
+}
+
+
+
+static bool
+declaration_list_to_params (P_Context *context, 
+                            P_DeclarationList *list,
+                            size_t *n_params_out,
+                            DBCC_Param **params_out)
+{
+  if (list == NULL)
+    {
+      *n_params_out = 0;
+      *params_out = NULL;
+      return true;
+    }
+  size_t n_params = declaration_list_count_declarators (list);
+  DBCC_Param *params = malloc (sizeof (DBCC_Param) * n_params);
+  size_t cur_n_params = 0;
+  ITERATE_DECLARATORS_OF_DECLARATION_LIST(list)
+    {
+      DBCC_Type *param_type = type_from_parts (context, declaration, declarator);
+      if (param_type == NULL)
+        {
+          free (params);        ///TODO other cleanup
+          return false;
+        }
+      params[cur_n_params].type = param_type;
+      params[cur_n_params].name = name_from_declarator (declarator);
+      params[cur_n_params].bit_width = -1;
+      cur_n_params++;
+    }
+  assert (cur_n_params == n_params);
+  *n_params_out = n_params;
+  *params_out = params;
+  return true;
+}
+
+static void
+error_set_code_location_from_expr (P_Context *context, DBCC_Expr *expr)
+{
+  if (expr->base.code_position != NULL)
+    dbcc_error_add_code_position (context->error, expr->base.code_position);
+}
+
+#define MK_BINARY(rv, SHORTNAME, a, b)                                        \
+  do{                                                                         \
+    rv = dbcc_expr_new_binary_operator(CONTEXT_NS,                            \
+                                       DBCC_BINARY_OPERATOR_##SHORTNAME,      \
+                                       a, b, &context->error);                \
+    if (rv == NULL)                                                           \
+      FAIL();                                                                 \
+  }while(0)
+
+#define MK_INPLACE_UNARY(rv, SHORTNAME, in)                                   \
+  do{                                                                         \
+    rv = dbcc_expr_new_inplace_unary(CONTEXT_NS,                              \
+                                     DBCC_INPLACE_UNARY_OPERATOR_##SHORTNAME, \
+                                     in, &context->error);                    \
+    if (rv == NULL)                                                           \
+      FAIL();                                                                 \
+  }while(0)
+#line 1783 "dbcc-parser-p.c"
+/**************** End of %include directives **********************************/
+/* These constants specify the various numeric values for terminal symbols
+** in a format understandable to "makeheaders".  This section is blank unless
+** "lemon" is run with the "-m" command-line option.
+***************** Begin makeheaders token definitions *************************/
+/**************** End makeheaders token definitions ***************************/
+
+/* The next sections is a series of control #defines.
+** various aspects of the generated parser.
+**    YYCODETYPE         is the data type used to store the integer codes
+**                       that represent terminal and non-terminal symbols.
+**                       "unsigned char" is used if there are fewer than
+**                       256 symbols.  Larger types otherwise.
+**    YYNOCODE           is a number of type YYCODETYPE that is not used for
+**                       any terminal or nonterminal symbol.
+**    YYFALLBACK         If defined, this indicates that one or more tokens
+**                       (also known as: "terminal symbols") have fall-back
+**                       values which should be used if the original symbol
+**                       would not parse.  This permits keywords to sometimes
+**                       be used as identifiers, for example.
+**    YYACTIONTYPE       is the data type used for "action codes" - numbers
+**                       that indicate what to do in response to the next
+**                       token.
+**    DBCC_Lemon_ParserTOKENTYPE     is the data type used for minor type for terminal
+**                       symbols.  Background: A "minor type" is a semantic
+**                       value associated with a terminal or non-terminal
+**                       symbols.  For example, for an "ID" terminal symbol,
+**                       the minor type might be the name of the identifier.
+**                       Each non-terminal can have a different minor type.
+**                       Terminal symbols all have the same minor type, though.
+**                       This macros defines the minor type for terminal 
+**                       symbols.
+**    YYMINORTYPE        is the data type used for all minor types.
+**                       This is typically a union of many types, one of
+**                       which is DBCC_Lemon_ParserTOKENTYPE.  The entry in the union
+**                       for terminal symbols is called "yy0".
+**    YYSTACKDEPTH       is the maximum depth of the parser's stack.  If
+**                       zero the stack is dynamically sized using realloc()
+**    DBCC_Lemon_ParserARG_SDECL     A static variable declaration for the %extra_argument
+**    DBCC_Lemon_ParserARG_PDECL     A parameter declaration for the %extra_argument
+**    DBCC_Lemon_ParserARG_STORE     Code to store %extra_argument into yypParser
+**    DBCC_Lemon_ParserARG_FETCH     Code to extract %extra_argument from yypParser
+**    YYERRORSYMBOL      is the code number of the error symbol.  If not
+**                       defined, then do no error processing.
+**    YYNSTATE           the combined number of states.
+**    YYNRULE            the number of rules in the grammar
+**    YYNTOKEN           Number of terminal symbols
+**    YY_MAX_SHIFT       Maximum value for shift actions
+**    YY_MIN_SHIFTREDUCE Minimum value for shift-reduce actions
+**    YY_MAX_SHIFTREDUCE Maximum value for shift-reduce actions
+**    YY_ERROR_ACTION    The yy_action[] code for syntax error
+**    YY_ACCEPT_ACTION   The yy_action[] code for accept
+**    YY_NO_ACTION       The yy_action[] code for no-op
+**    YY_MIN_REDUCE      Minimum value for reduce actions
+**    YY_MAX_REDUCE      Maximum value for reduce actions
+*/
+#ifndef INTERFACE
+# define INTERFACE 1
+#endif
+/************* Begin control #defines *****************************************/
+#define YYCODETYPE unsigned char
+#define YYNOCODE 189
+#define YYACTIONTYPE unsigned short int
+#define DBCC_Lemon_ParserTOKENTYPE P_Token
+typedef union {
+  int yyinit;
+  DBCC_Lemon_ParserTOKENTYPE yy0;
+  P_GenericAssociationList yy2;
+  DBCC_FunctionSpecifiers yy7;
+  P_EnumValueList yy34;
+  DBCC_Symbol * yy76;
+  DBCC_String yy83;
+  bool yy89;
+  int yy92;
+  DBCC_StorageClassSpecifier yy97;
+  DBCC_Type * yy100;
+  DBCC_Expr * yy101;
+  P_InitializerList yy116;
+  DBCC_TypeQualifier yy120;
+  DBCC_InplaceBinaryOperator yy149;
+  P_Designator * yy154;
+  P_Pointer yy197;
+  P_Declaration * yy212;
+  P_DeclaratorList yy217;
+  P_DeclarationList yy234;
+  P_AlignmentSpecifier * yy239;
+  P_StatementList yy245;
+  P_GenericAssociation * yy260;
+  DBCC_EnumValue * yy276;
+  P_ParameterList yy293;
+  DBCC_UnaryOperator yy295;
+  P_DesignatorList yy304;
+  P_Declarator * yy307;
+  P_ExprList yy308;
+  P_TypeSpecifiers yy335;
+  P_IdentifierList yy351;
+  P_Initializer * yy358;
+} YYMINORTYPE;
+#ifndef YYSTACKDEPTH
+#define YYSTACKDEPTH 100
+#endif
+#define DBCC_Lemon_ParserARG_SDECL P_Context *context;
+#define DBCC_Lemon_ParserARG_PDECL ,P_Context *context
+#define DBCC_Lemon_ParserARG_FETCH P_Context *context = yypParser->context
+#define DBCC_Lemon_ParserARG_STORE yypParser->context = context
+#define YYNSTATE             258
+#define YYNRULE              260
+#define YYNTOKEN             102
+#define YY_MAX_SHIFT         257
+#define YY_MIN_SHIFTREDUCE   461
+#define YY_MAX_SHIFTREDUCE   720
+#define YY_ERROR_ACTION      721
+#define YY_ACCEPT_ACTION     722
+#define YY_NO_ACTION         723
+#define YY_MIN_REDUCE        724
+#define YY_MAX_REDUCE        983
+/************* End control #defines *******************************************/
+
+/* Define the yytestcase() macro to be a no-op if is not already defined
+** otherwise.
+**
+** Applications can choose to define yytestcase() in the %include section
+** to a macro that can assist in verifying code coverage.  For production
+** code the yytestcase() macro should be turned off.  But it is useful
+** for testing.
+*/
+#ifndef yytestcase
+# define yytestcase(X)
+#endif
+
+
+/* Next are the tables used to determine what action to take based on the
+** current state and lookahead token.  These tables are used to implement
+** functions that take a state number and lookahead value and return an
+** action integer.  
+**
+** Suppose the action integer is N.  Then the action is determined as
+** follows
+**
+**   0 <= N <= YY_MAX_SHIFT             Shift N.  That is, push the lookahead
+**                                      token onto the stack and goto state N.
+**
+**   N between YY_MIN_SHIFTREDUCE       Shift to an arbitrary state then
+**     and YY_MAX_SHIFTREDUCE           reduce by rule N-YY_MIN_SHIFTREDUCE.
+**
+**   N == YY_ERROR_ACTION               A syntax error has occurred.
+**
+**   N == YY_ACCEPT_ACTION              The parser accepts its input.
+**
+**   N == YY_NO_ACTION                  No such action.  Denotes unused
+**                                      slots in the yy_action[] table.
+**
+**   N between YY_MIN_REDUCE            Reduce by rule N-YY_MIN_REDUCE
+**     and YY_MAX_REDUCE
+**
+** The action table is constructed as a single large table named yy_action[].
+** Given state S and lookahead X, the action is computed as either:
+**
+**    (A)   N = yy_action[ yy_shift_ofst[S] + X ]
+**    (B)   N = yy_default[S]
+**
+** The (A) formula is preferred.  The B formula is used instead if
+** yy_lookahead[yy_shift_ofst[S]+X] is not equal to X.
+**
+** The formulas above are for computing the action when the lookahead is
+** a terminal symbol.  If the lookahead is a non-terminal (as occurs after
+** a reduce action) then the yy_reduce_ofst[] array is used in place of
+** the yy_shift_ofst[] array.
+**
+** The following are the tables generated in this section:
+**
+**  yy_action[]        A single table containing all actions.
+**  yy_lookahead[]     A table containing the lookahead for each entry in
+**                     yy_action.  Used to detect hash collisions.
+**  yy_shift_ofst[]    For each state, the offset into yy_action for
+**                     shifting terminals.
+**  yy_reduce_ofst[]   For each state, the offset into yy_action for
+**                     shifting non-terminals after a reduce.
+**  yy_default[]       Default action for each state.
+**
+*********** Begin parsing tables **********************************************/
+#define YY_ACTTAB_COUNT (3564)
+static const YYACTIONTYPE yy_action[] = {
+ /*     0 */    49,  192,  462,  463,  464,  465,   16,  469,  470,  471,
+ /*    10 */   256,  110,  914,  190,  218,  130,  899,   33,  127,  899,
+ /*    20 */     1,  687,   97,   96,   95,  248,  495,  496,  497,  498,
+ /*    30 */   499,  500,   75,   74,  848,  823,   77,   76,  847,  817,
+ /*    40 */   822,   75,   74,  848,  823,   77,   76,  847,  817,  821,
+ /*    50 */    72,   71,   70,   69,   34,  128,  899,   39,  693,  198,
+ /*    60 */   565,  566,  567,  568,  569,  570,  571,  572,  573,  574,
+ /*    70 */   575,  576,  577,  578,  579,  580,  581,  582,  246,  586,
+ /*    80 */   139,  138,  137,  612,  613,  614,  616,  617,  224,  590,
+ /*    90 */   204,   36,  189,  900,  187,  186,    6,  182,  179,  177,
+ /*   100 */   176,   22,  192,  462,  463,  464,  465,   16,   63,  470,
+ /*   110 */   471,  256,  615,   39,  190,  198,  113,  612,  613,  614,
+ /*   120 */   983,    1,  688,   97,   96,   95,  248,  495,  496,  497,
+ /*   130 */   498,  499,  500,  937,  571,  572,  573,  574,  575,  576,
+ /*   140 */   577,  578,  579,  580,  581,  582,  246,  586,  139,  138,
+ /*   150 */   137,  612,  613,  614,   35,  129,  899,    1,  204,  693,
+ /*   160 */   157,  565,  566,  567,  568,  569,  570,  571,  572,  573,
+ /*   170 */   574,  575,  576,  577,  578,  579,  580,  581,  582,  246,
+ /*   180 */   586,  139,  138,  137,  612,  613,  614,  616,  617,  224,
+ /*   190 */   588,  204,   36,  189,  975,  187,  186,    6,  182,  179,
+ /*   200 */   177,  176,   22,  461,  462,  463,  464,  465,   16,  107,
+ /*   210 */   470,  471,  256,  535,  536,  537,  538,  539,  540,  541,
+ /*   220 */   542,  543,  544,  545,   97,   96,   95,  248,  495,  496,
+ /*   230 */   497,  498,  499,  500,  197,  571,  572,  573,  574,  575,
+ /*   240 */   576,  577,  578,  579,  580,  581,  582,  246,  586,  139,
+ /*   250 */   138,  137,  612,  613,  614,  135,  130,  899,  114,  204,
+ /*   260 */   693,  895,  565,  566,  567,  568,  569,  570,  571,  572,
+ /*   270 */   573,  574,  575,  576,  577,  578,  579,  580,  581,  582,
+ /*   280 */   246,  586,  139,  138,  137,  612,  613,  614,  616,  617,
+ /*   290 */   224,  954,  204,  125,  816,   75,   74,  848,  823,   77,
+ /*   300 */    76,  847,  817,  820,   41,  130,  899,  226,  153,  169,
+ /*   310 */   240,  809,  766,  796,  607,  161,  239,  237,  235,  159,
+ /*   320 */   147,  141,  740,  144,  168,  126,  731,  121,  130,  899,
+ /*   330 */     2,   75,   74,  848,  823,   77,   76,  847,  817,  819,
+ /*   340 */    43,  130,  899,  141,  740,  227,   92,  755,  731,  110,
+ /*   350 */   914,   75,   74,  848,  823,   77,   76,  847,  101,  895,
+ /*   360 */   955,  952,  942,  943,  945,  946,  941,  944,   92,  729,
+ /*   370 */   242,  461,  462,  463,  464,  465,   16,  622,  470,  471,
+ /*   380 */   256,   39,   55,  198,  123,  130,  899,  241,  980,  244,
+ /*   390 */   111,  729,   97,   96,   95,  248,  495,  496,  497,  498,
+ /*   400 */   499,  500,  243,  116,   47,  130,  899,  565,  566,  567,
+ /*   410 */   568,  569,  570,  571,  572,  573,  574,  575,  576,  577,
+ /*   420 */   578,  579,  580,  581,  582,  246,  586,  139,  138,  137,
+ /*   430 */   612,  613,  614,  616,  617,  224,  571,  572,  573,  574,
+ /*   440 */   575,  576,  577,  578,  579,  580,  581,  582,  246,  586,
+ /*   450 */   139,  138,  137,  612,  613,  614,  214,  166,  954,  156,
+ /*   460 */   766,  816,  110,  912,   39,  225,  198,  132,  147,  141,
+ /*   470 */   740,   53,   54,  764,  731,  153,  169,  240,  809,  766,
+ /*   480 */   796,  871,  161,  239,  237,  235,  159,  147,  141,  740,
+ /*   490 */   144,  168,  126,  731,   92,  124,   91,   53,  245,  225,
+ /*   500 */   108,   90,   89,  974,  970,   98,  816,  848,  136,  672,
+ /*   510 */    99,  847,  183,   92,  973,  872,   53,  729,   75,   74,
+ /*   520 */   848,  823,   77,   76,  847,  101,  904,  955,  953,  942,
+ /*   530 */   943,  945,  946,  941,  944,  622,  729,  622,  232,   58,
+ /*   540 */    55,  156,  120,  864,  706,  251,   53,  111,  111,  132,
+ /*   550 */   461,  462,  463,  464,  465,   16,  479,  470,  471,  256,
+ /*   560 */   116,  116,    4,   75,   74,  848,  823,   77,   76,  847,
+ /*   570 */   103,   97,   96,   95,  248,  495,  496,  497,  498,  499,
+ /*   580 */   500,  704,   62,  722,   75,   74,  848,  823,   77,   76,
+ /*   590 */   847,  102,  178,  694,  565,  566,  567,  568,  569,  570,
+ /*   600 */   571,  572,  573,  574,  575,  576,  577,  578,  579,  580,
+ /*   610 */   581,  582,  246,  586,  139,  138,  137,  612,  613,  614,
+ /*   620 */   616,  617,  224,  192,  462,  463,  464,  465,   16,  703,
+ /*   630 */   470,  471,  256,   64,   53,  190,  702,   18,  478,    7,
+ /*   640 */   816,  112,    1,   53,   97,   96,   95,  248,  495,  496,
+ /*   650 */   497,  498,  499,  500,  153,  169,  240,  809,  766,  796,
+ /*   660 */   115,  161,  239,  237,  235,  159,  147,  141,  740,  144,
+ /*   670 */   168,  126,  731,   53,  124,    8,  615,  247,    5,   53,
+ /*   680 */   693,  612,  613,  614,   98,    3,  848,   58,  699,   99,
+ /*   690 */   847,   27,   92,   56,   31,  111,  184,   75,   74,  848,
+ /*   700 */   823,   77,   76,  847,  101,  615,   67,   66,  118,   19,
+ /*   710 */   612,  613,  614,   36,  189,  729,  187,  186,    6,  182,
+ /*   720 */   179,  177,  176,   22,   28,   23,   84,   83,  905,  110,
+ /*   730 */   906,  156,   29,   32,  978,  196,  195,  483,  484,  132,
+ /*   740 */     9,  565,  566,  567,  568,  569,  570,  571,  572,  573,
+ /*   750 */   574,  575,  576,  577,  578,  579,  580,  581,  582,  246,
+ /*   760 */   586,  139,  138,  137,  612,  613,  614,  616,  617,  224,
+ /*   770 */   972,   79,   78,   26,  565,  566,  567,  568,  569,  570,
+ /*   780 */   571,  572,  573,  574,  575,  576,  577,  578,  579,  580,
+ /*   790 */   581,  582,  246,  586,  139,  138,  137,  612,  613,  614,
+ /*   800 */   616,  617,  224,  647,  204,   30,   11,   12,   13,  630,
+ /*   810 */   571,  572,  573,  574,  575,  576,  577,  578,  579,  580,
+ /*   820 */   581,  582,  246,  586,  139,  138,  137,  612,  613,  614,
+ /*   830 */   565,  566,  567,  568,  569,  570,  571,  572,  573,  574,
+ /*   840 */   575,  576,  577,  578,  579,  580,  581,  582,  246,  586,
+ /*   850 */   139,  138,  137,  612,  613,  614,  616,  617,  224,   88,
+ /*   860 */   204,   37,  565,  566,  567,  568,  569,  570,  571,  572,
+ /*   870 */   573,  574,  575,  576,  577,  578,  579,  580,  581,  582,
+ /*   880 */   246,  586,  139,  138,  137,  612,  613,  614,  616,  617,
+ /*   890 */   224,  565,  566,  567,  568,  569,  570,  571,  572,  573,
+ /*   900 */   574,  575,  576,  577,  578,  579,  580,  581,  582,  246,
+ /*   910 */   586,  139,  138,  137,  612,  613,  614,  616,  617,  224,
+ /*   920 */   482,  204,  481,  565,  566,  567,  568,  569,  570,  571,
+ /*   930 */   572,  573,  574,  575,  576,  577,  578,  579,  580,  581,
+ /*   940 */   582,  246,  586,  139,  138,  137,  612,  613,  614,  616,
+ /*   950 */   617,  224,  638,  666,  676,  153,  169,  240,  809,  766,
+ /*   960 */   796,  117,  161,  239,  237,  235,  159,  147,  141,  740,
+ /*   970 */   144,  168,  126,  731,   10,  677,  675,  615,   53,   25,
+ /*   980 */   933,  936,  612,  613,  614,  200,  202,  153,  169,  240,
+ /*   990 */   809,  766,  796,   92,  161,  239,  237,  235,  159,  147,
+ /*  1000 */   141,  740,  144,  168,  126,  731,  201,  964,  131,  942,
+ /*  1010 */   943,  945,  946,  941,  944,   40,  729,  648,  629,  153,
+ /*  1020 */   169,  240,  809,  766,  796,   92,  161,  239,  237,  235,
+ /*  1030 */   159,  147,  141,  740,  144,  168,  126,  731,  665,  963,
+ /*  1040 */   664,  942,  943,  945,  946,  941,  944,  656,  729,  658,
+ /*  1050 */   655,  153,  169,  240,  809,  766,  796,   92,  161,  239,
+ /*  1060 */   237,  235,  159,  147,  141,  740,  144,  168,  126,  731,
+ /*  1070 */   657,  185,  653,  942,  943,  945,  946,  941,  944,  623,
+ /*  1080 */   729,   73,  663,  153,  169,  240,  809,  766,  796,   92,
+ /*  1090 */   161,  239,  237,  235,  159,  147,  141,  740,  144,  168,
+ /*  1100 */   126,  731,  216,  961,  217,  942,  943,  945,  946,  941,
+ /*  1110 */   944,  661,  729,  660,  662,  153,  169,  240,  809,  766,
+ /*  1120 */   796,   92,  161,  239,  237,  235,  159,  147,  141,  740,
+ /*  1130 */   144,  168,  126,  731,  619,  960,  618,  942,  943,  945,
+ /*  1140 */   946,  941,  944,   17,  729,   45,  605,  153,  169,  240,
+ /*  1150 */   809,  766,  796,   92,  161,  239,  237,  235,  159,  147,
+ /*  1160 */   141,  740,  144,  168,  126,  731,  122,  958,  626,  942,
+ /*  1170 */   943,  945,  946,  941,  944,  625,  729,  627,  628,  153,
+ /*  1180 */   169,  240,  809,  766,  796,   92,  161,  239,  237,  235,
+ /*  1190 */   159,  147,  141,  740,  144,  168,  126,  731,   48,  188,
+ /*  1200 */    57,  942,  943,  945,  946,  941,  944,   59,  729,   60,
+ /*  1210 */    65,  153,  169,  240,  809,  766,  796,   92,  161,  239,
+ /*  1220 */   237,  235,  159,  147,  141,  740,  144,  168,  126,  731,
+ /*  1230 */    80,  949,  870,  942,  943,  945,  946,  941,  944,   81,
+ /*  1240 */   729,  583,   93,  153,  169,  240,  809,  766,  796,   92,
+ /*  1250 */   161,  239,  237,  235,  159,  147,  141,  740,  144,  168,
+ /*  1260 */   126,  731,  494,  948,   94,  942,  943,  945,  946,  941,
+ /*  1270 */   944,  105,  729,  249,  485,  173,  169,  240,  809,  766,
+ /*  1280 */   796,   92,  161,  239,  237,  235,  159,  147,  141,  740,
+ /*  1290 */   144,  168,  126,  731,  119,  947,  252,  942,  943,  945,
+ /*  1300 */   946,  941,  944,  257,  729,  480,  156,  825,  124,   38,
+ /*  1310 */   615,  250,   51,   92,  132,  612,  613,  614,   98,   82,
+ /*  1320 */   848,  631,  106,   99,  847,  205,   52,   24,  933,  936,
+ /*  1330 */   173,  169,  240,  809,  766,  796,  729,  161,  239,  237,
+ /*  1340 */   235,  159,  147,  141,  740,  144,  168,  126,  731,   26,
+ /*  1350 */   974,  971,  723,  816,  472,  723,  131,  723,   87,  232,
+ /*  1360 */   134,  973,  156,  124,  863,  723,  253,  467,   92,  594,
+ /*  1370 */   132,   53,  723,   98,  723,  848,  723,  977,   99,  847,
+ /*  1380 */   816,  723,  109,  723,  723,  173,  169,  240,  809,  766,
+ /*  1390 */   796,  729,  161,  239,  237,  235,  159,  147,  141,  740,
+ /*  1400 */   144,  168,  126,  731,   42,  723,  170,  723,  723,  723,
+ /*  1410 */    75,   74,  848,  823,   77,   76,  847,  103,  124,  622,
+ /*  1420 */   615,  193,  723,   92,  120,  612,  613,  614,   98,  552,
+ /*  1430 */   848,  723,  723,   99,  847,  723,  723,   75,   74,  848,
+ /*  1440 */   823,   77,   76,  847,  101,  114,  729,  723,  169,  240,
+ /*  1450 */    44,  766,  811,  222,  161,  239,  237,  235,  159,  147,
+ /*  1460 */   141,  740,  144,  168,  764,  731,  615,   58,  723,  723,
+ /*  1470 */   723,  612,  613,  614,  723,  111,  551,  723,  723,  723,
+ /*  1480 */   124,  723,  723,  223,  723,   92,  723,  723,  118,  723,
+ /*  1490 */    98,  723,  848,  723,  723,   99,  847,  723,  723,  858,
+ /*  1500 */   854,  723,  153,  169,  240,  809,  766,  796,  729,  161,
+ /*  1510 */   239,  237,  235,  159,  147,  141,  740,  144,  168,  126,
+ /*  1520 */   731,  153,  169,  240,  809,  766,  796,   46,  161,  239,
+ /*  1530 */   237,  235,  159,  147,  141,  740,  144,  168,  126,  731,
+ /*  1540 */    92,  723,  723,  615,  723,  723,  100,   85,  612,  613,
+ /*  1550 */   614,  723,  723,  723,  723,  861,   98,   20,  848,   92,
+ /*  1560 */   723,   99,  847,  729,  723,   98,  723,  848,  723,  723,
+ /*  1570 */    99,  847,  723,  723,  723,  723,   21,  723,  723,  723,
+ /*  1580 */   723,  723,  729,  181,  169,  240,  809,  766,  796,  723,
+ /*  1590 */   161,  239,  237,  235,  159,  147,  141,  740,  144,  168,
+ /*  1600 */   126,  731,  175,  461,  462,  463,  464,  465,   16,  723,
+ /*  1610 */   470,  471,  256,  723,  723,  858,  854,  723,  723,  976,
+ /*  1620 */   723,   92,  816,  723,   97,   96,   95,  248,  495,  496,
+ /*  1630 */   497,  498,  499,  500,  723,  737,  723,  723,  181,  169,
+ /*  1640 */   240,  809,  766,  796,  729,  161,  239,  237,  235,  159,
+ /*  1650 */   147,  141,  740,  144,  168,  126,  731,  180,  723,   68,
+ /*  1660 */   693,  622,  100,   86,  723,  133,  120,  723,  723,  723,
+ /*  1670 */   723,  723,   98,  723,  848,  723,   92,   99,  847,   75,
+ /*  1680 */    74,  848,  823,   77,   76,  847,  101,  114,  124,  723,
+ /*  1690 */   194,  254,  723,  723,  723,  723,  723,  723,   98,  729,
+ /*  1700 */   848,  723,  723,   99,  847,  571,  572,  573,  574,  575,
+ /*  1710 */   576,  577,  578,  579,  580,  581,  582,  246,  586,  139,
+ /*  1720 */   138,  137,  612,  613,  614,  723,  723,  723,  723,  204,
+ /*  1730 */   723,  723,  723,  723,  723,  723,  723,  723,  723,  723,
+ /*  1740 */   723,  723,  723,  571,  572,  573,  574,  575,  576,  577,
+ /*  1750 */   578,  579,  580,  581,  582,  246,  586,  139,  138,  137,
+ /*  1760 */   612,  613,  614,  461,  462,  463,  464,  465,   16,  723,
+ /*  1770 */   470,  471,  256,  461,  462,  463,  464,  465,   16,  723,
+ /*  1780 */   470,  471,  256,  723,   97,   96,   95,  248,  495,  496,
+ /*  1790 */   497,  498,  499,  500,   97,   96,   95,  248,  495,  496,
+ /*  1800 */   497,  498,  499,  500,  723,  723,  723,  723,  723,  723,
+ /*  1810 */   723,  723,  723,  723,  148,  169,  240,  809,  766,  796,
+ /*  1820 */   705,  161,  239,  237,  235,  159,  147,  141,  740,  144,
+ /*  1830 */   168,  126,  731,  169,  240,  749,  766,  796,  723,  161,
+ /*  1840 */   239,  237,  235,  159,  147,  141,  740,  144,  168,  126,
+ /*  1850 */   731,  723,   92,  154,  723,  461,  462,  463,  464,  465,
+ /*  1860 */    16,  622,  470,  471,  256,  723,  120,  723,  723,  723,
+ /*  1870 */    92,  723,   50,  723,  104,  729,   97,   96,   95,  248,
+ /*  1880 */   495,  496,  497,  498,  499,  500,  723,  114,  169,  240,
+ /*  1890 */   930,  766,  796,  729,  161,  239,  237,  235,  159,  147,
+ /*  1900 */   141,  740,  144,  168,  126,  731,  723,  931,  723,  461,
+ /*  1910 */   462,  463,  464,  465,   16,  622,  470,  471,  256,  723,
+ /*  1920 */   120,  723,  723,  654,  723,   92,   50,  723,  723,  723,
+ /*  1930 */    97,   96,   95,  248,  495,  211,  497,  498,  499,  500,
+ /*  1940 */   723,  114,  723,  169,  240,  930,  766,  796,  729,  161,
+ /*  1950 */   239,  237,  235,  159,  147,  141,  740,  144,  168,  126,
+ /*  1960 */   731,  723,  932,  723,   24,  933,  936,  723,  723,  723,
+ /*  1970 */   723,  723,  593,  723,  723,  169,  240,  930,  766,  796,
+ /*  1980 */    92,  161,  239,  237,  235,  159,  147,  141,  740,  144,
+ /*  1990 */   168,  126,  731,  131,  826,  723,  723,  140,  723,  723,
+ /*  2000 */   723,  723,  723,  729,  723,  723,  149,  169,  240,  809,
+ /*  2010 */   766,  796,   92,  161,  239,  237,  235,  159,  147,  141,
+ /*  2020 */   740,  144,  168,  126,  731,  461,  462,  463,  464,  465,
+ /*  2030 */    16,  723,  470,  471,  256,  729,  723,  723,  723,  659,
+ /*  2040 */   723,  723,  723,  723,   92,  723,   97,   96,   95,  248,
+ /*  2050 */   495,  496,  497,  498,  499,  500,  723,  723,  723,  723,
+ /*  2060 */   723,  723,  723,  723,  723,  723,  723,  729,  150,  169,
+ /*  2070 */   240,  809,  766,  796,  723,  161,  239,  237,  235,  159,
+ /*  2080 */   147,  141,  740,  144,  168,  126,  731,  257,  723,  723,
+ /*  2090 */   156,  824,  723,  723,  723,  723,  723,  723,  132,  723,
+ /*  2100 */   151,  169,  240,  809,  766,  796,   92,  161,  239,  237,
+ /*  2110 */   235,  159,  147,  141,  740,  144,  168,  126,  731,  723,
+ /*  2120 */   723,  723,  723,  723,  723,  723,  174,  723,  723,  729,
+ /*  2130 */   723,  723,  152,  169,  240,  809,  766,  796,   92,  161,
+ /*  2140 */   239,  237,  235,  159,  147,  141,  740,  144,  168,  126,
+ /*  2150 */   731,  461,  462,  463,  464,  465,   16,  723,  470,  471,
+ /*  2160 */   256,  729,  723,  723,  723,  624,  723,  723,  723,  723,
+ /*  2170 */    92,  723,   97,   96,   95,  248,  495,  231,  497,  498,
+ /*  2180 */   499,  500,  723,  723,  723,  723,  723,  723,  723,  723,
+ /*  2190 */   723,  723,  723,  729,  158,  169,  240,  809,  766,  796,
+ /*  2200 */   723,  161,  239,  237,  235,  159,  147,  141,  740,  144,
+ /*  2210 */   168,  126,  731,   61,  723,  723,  156,  824,  723,  723,
+ /*  2220 */   723,  723,  723,  723,  132,  723,  171,  169,  240,  809,
+ /*  2230 */   766,  796,   92,  161,  239,  237,  235,  159,  147,  141,
+ /*  2240 */   740,  144,  168,  126,  731,  723,  723,  723,  723,  723,
+ /*  2250 */   723,  723,  174,  723,  723,  729,  723,  723,  723,  723,
+ /*  2260 */   723,  723,  723,  723,   92,  169,  240,  210,  766,  796,
+ /*  2270 */   723,  161,  239,  237,  235,  159,  147,  141,  740,  144,
+ /*  2280 */   168,  126,  731,  723,  723,  723,  723,  729,  723,  461,
+ /*  2290 */   462,  463,  464,  465,   16,  723,  470,  471,  256,  723,
+ /*  2300 */   723,  723,   92,  723,  723,  723,  723,  723,  105,  723,
+ /*  2310 */    97,   96,   95,  248,  495,  496,  497,  498,  499,  500,
+ /*  2320 */   169,  240,  220,  766,  796,  729,  161,  239,  237,  235,
+ /*  2330 */   159,  147,  141,  740,  144,  168,  126,  731,  723,  723,
+ /*  2340 */   723,  723,  723,  723,  723,  723,  723,  723,  723,  723,
+ /*  2350 */   723,  723,  169,  240,  230,  766,  796,   92,  161,  239,
+ /*  2360 */   237,  235,  159,  147,  141,  740,  144,  168,  126,  731,
+ /*  2370 */   723,  723,  723,  723,  723,  723,  723,  723,  723,  723,
+ /*  2380 */   729,  723,  723,  723,  723,  723,  723,  723,  723,   92,
+ /*  2390 */   169,  240,  723,  766,  811,  191,  161,  239,  237,  235,
+ /*  2400 */   159,  147,  141,  740,  144,  168,  764,  731,  723,  723,
+ /*  2410 */   723,  723,  729,  723,  723,  723,  723,  723,  723,  723,
+ /*  2420 */   723,  723,  169,  240,  739,  766,  796,   92,  161,  239,
+ /*  2430 */   237,  235,  159,  147,  141,  740,  144,  168,  126,  731,
+ /*  2440 */   723,  723,  723,  723,  723,  723,  723,  723,  723,  723,
+ /*  2450 */   729,  723,  723,  723,  169,  240,  750,  766,  796,   92,
+ /*  2460 */   161,  239,  237,  235,  159,  147,  141,  740,  144,  168,
+ /*  2470 */   126,  731,  723,  723,  723,  723,  723,  723,  723,  723,
+ /*  2480 */   723,  723,  729,  723,  723,  723,  723,  723,  723,  169,
+ /*  2490 */   240,   92,  766,  811,  199,  161,  239,  237,  235,  159,
+ /*  2500 */   147,  141,  740,  144,  168,  764,  731,  723,  723,  723,
+ /*  2510 */   723,  723,  723,  723,  729,  723,  723,  723,  723,  723,
+ /*  2520 */   723,  723,  723,  723,  169,  240,   92,  766,  811,  203,
+ /*  2530 */   161,  239,  237,  235,  159,  147,  141,  740,  144,  168,
+ /*  2540 */   764,  731,  723,  723,  723,  723,  723,  723,  723,  729,
+ /*  2550 */   723,  723,  723,  723,  723,  723,  169,  240,  209,  766,
+ /*  2560 */   796,   92,  161,  239,  237,  235,  159,  147,  141,  740,
+ /*  2570 */   144,  168,  126,  731,  723,  723,  723,  723,  723,  723,
+ /*  2580 */   723,  723,  723,  723,  729,  723,  723,  723,  169,  240,
+ /*  2590 */   212,  766,  796,   92,  161,  239,  237,  235,  159,  147,
+ /*  2600 */   141,  740,  144,  168,  126,  731,  723,  723,  723,  723,
+ /*  2610 */   723,  723,  723,  723,  723,  723,  729,  723,  723,  723,
+ /*  2620 */   169,  240,  219,  766,  796,   92,  161,  239,  237,  235,
+ /*  2630 */   159,  147,  141,  740,  144,  168,  126,  731,  723,  723,
+ /*  2640 */   723,  723,  723,  723,  723,  723,  723,  723,  729,  723,
+ /*  2650 */   723,  723,  169,  240,  221,  766,  796,   92,  161,  239,
+ /*  2660 */   237,  235,  159,  147,  141,  740,  144,  168,  126,  731,
+ /*  2670 */   723,  723,  723,  723,  723,  723,  723,  723,  723,  723,
+ /*  2680 */   729,  723,  723,  723,  723,  723,  723,  169,  240,   92,
+ /*  2690 */   766,  811,  873,  161,  239,  237,  235,  159,  147,  141,
+ /*  2700 */   740,  144,  168,  764,  731,  723,  723,  723,  723,  723,
+ /*  2710 */   723,  723,  729,  723,  723,  723,  723,  723,  723,  169,
+ /*  2720 */   240,  228,  766,  796,   92,  161,  239,  237,  235,  159,
+ /*  2730 */   147,  141,  740,  144,  168,  126,  731,  723,  723,  723,
+ /*  2740 */   723,  723,  723,  723,  723,  723,  723,  729,  723,  723,
+ /*  2750 */   723,  169,  240,  229,  766,  796,   92,  161,  239,  237,
+ /*  2760 */   235,  159,  147,  141,  740,  144,  168,  126,  731,  723,
+ /*  2770 */   723,  723,  723,  723,  723,  723,  723,  723,  723,  729,
+ /*  2780 */   723,  723,  723,  723,  723,  723,  169,  240,   92,  766,
+ /*  2790 */   811,  866,  161,  239,  237,  235,  159,  147,  141,  740,
+ /*  2800 */   144,  168,  764,  731,  723,  723,  723,  723,  723,  723,
+ /*  2810 */   723,  729,  723,  723,  723,  723,  723,  723,  169,  240,
+ /*  2820 */   797,  766,  796,   92,  161,  239,  237,  235,  159,  147,
+ /*  2830 */   141,  740,  144,  168,  126,  731,  723,  723,  723,  723,
+ /*  2840 */   723,  723,  723,  723,  723,  723,  729,  723,  723,  723,
+ /*  2850 */   723,  723,  723,  169,  240,   92,  766,  811,  865,  161,
+ /*  2860 */   239,  237,  235,  159,  147,  141,  740,  144,  168,  764,
+ /*  2870 */   731,  723,  723,  723,  723,  723,  723,  723,  729,  723,
+ /*  2880 */   723,  723,  723,  723,  723,  169,  240,  738,  766,  796,
+ /*  2890 */    92,  161,  239,  237,  235,  159,  147,  141,  740,  144,
+ /*  2900 */   168,  126,  731,  723,  723,  723,  723,  723,  723,  723,
+ /*  2910 */   723,  723,  723,  729,  723,  723,  723,  169,  240,  255,
+ /*  2920 */   766,  796,   92,  161,  239,  237,  235,  159,  147,  141,
+ /*  2930 */   740,  144,  168,  126,  731,  723,  723,  723,  723,  723,
+ /*  2940 */   723,  723,  723,  723,  723,  729,  723,  723,  723,  169,
+ /*  2950 */   240,  810,  766,  796,   92,  161,  239,  237,  235,  159,
+ /*  2960 */   147,  141,  740,  144,  168,  126,  731,  461,  462,  463,
+ /*  2970 */   464,  465,   14,  723,  470,  471,  256,  729,  723,  723,
+ /*  2980 */   723,  723,  723,  723,  723,  723,   92,  723,   97,   96,
+ /*  2990 */    95,  248,  495,  496,  497,  498,  499,  500,  461,  462,
+ /*  3000 */   463,  464,  465,   15,  723,  470,  471,  256,  723,  729,
+ /*  3010 */   723,  723,  723,  723,  723,  723,  723,  723,  723,   97,
+ /*  3020 */    96,   95,  248,  495,  496,  497,  498,  499,  500,  723,
+ /*  3030 */   723,  723,  723,  858,  855,  723,  723,  723,  169,  240,
+ /*  3040 */   723,  766,  795,  723,  161,  239,  237,  235,  159,  147,
+ /*  3050 */   141,  740,  144,  168,  764,  731,  723,  723,  903,  723,
+ /*  3060 */   723,  214,  110,  213,  156,  723,  723,  723,  723,  723,
+ /*  3070 */   169,  240,  132,  766,  723,   92,  161,  239,  237,  233,
+ /*  3080 */   100,  147,  141,  740,  144,  168,  764,  731,  723,  723,
+ /*  3090 */    98,  723,  848,  723,  723,   99,  847,  723,  729,  723,
+ /*  3100 */   723,  723,  723,  215,  908,  208,  903,   92,  723,  723,
+ /*  3110 */   110,  213,  723,  723,  723,  723,   75,   74,  848,  823,
+ /*  3120 */    77,   76,  847,  102,  723,  169,  240,  723,  766,  723,
+ /*  3130 */   729,  161,  239,  234,  859,  723,  147,  141,  740,  144,
+ /*  3140 */   168,  764,  731,  723,   98,  723,  848,  723,  723,   99,
+ /*  3150 */   847,  215,  908,  208,  723,  723,  723,  723,  723,  723,
+ /*  3160 */   723,  723,   92,  723,   75,   74,  848,  823,   77,   76,
+ /*  3170 */   847,  102,  723,  723,  723,  169,  240,  723,  766,  723,
+ /*  3180 */   723,  161,  236,  723,  903,  729,  147,  141,  740,  144,
+ /*  3190 */   168,  764,  731,  723,  723,  723,  723,  723,  723,  723,
+ /*  3200 */   723,  723,  169,  238,  723,  766,  723,  903,  161,  723,
+ /*  3210 */   723,  723,   92,  147,  141,  740,  144,  168,  764,  731,
+ /*  3220 */   723,  723,  723,  765,  723,  723,  723,  723,  723,  215,
+ /*  3230 */   206,  723,  141,  740,  723,  729,  764,  731,  155,   92,
+ /*  3240 */   723,  723,   75,   74,  848,  823,   77,   76,  847,  102,
+ /*  3250 */   723,  723,  215,  908,  207,  723,  723,   92,  723,  723,
+ /*  3260 */   723,  723,  729,  723,  769,   75,   74,  848,  823,   77,
+ /*  3270 */    76,  847,  102,  141,  740,  723,  169,  764,  731,  766,
+ /*  3280 */   729,  723,  160,  723,  723,  723,  723,  147,  141,  740,
+ /*  3290 */   144,  168,  764,  731,  169,  723,  723,  766,   92,  723,
+ /*  3300 */   723,  723,  723,  723,  723,  147,  141,  740,  142,  168,
+ /*  3310 */   764,  731,  169,   92,  723,  766,  723,  723,  723,  723,
+ /*  3320 */   723,  729,  723,  147,  141,  740,  143,  168,  764,  731,
+ /*  3330 */   169,   92,  723,  766,  723,  723,  729,  723,  723,  723,
+ /*  3340 */   723,  147,  141,  740,  723,  162,  764,  731,  723,   92,
+ /*  3350 */   723,  723,  723,  723,  729,  723,  723,  723,  723,  723,
+ /*  3360 */   723,  723,  723,  169,  723,  723,  766,   92,  723,  723,
+ /*  3370 */   169,  723,  729,  766,  147,  141,  740,  723,  163,  764,
+ /*  3380 */   731,  147,  141,  740,  723,  164,  764,  731,  723,  723,
+ /*  3390 */   729,  723,  723,  723,  723,  723,  723,  723,  723,  723,
+ /*  3400 */    92,  169,  723,  723,  766,  723,  723,   92,  723,  736,
+ /*  3410 */   723,  723,  147,  141,  740,  723,  165,  764,  731,  766,
+ /*  3420 */   723,  723,  723,  729,  723,  723,  768,  145,  141,  740,
+ /*  3430 */   729,  167,  764,  731,  766,  141,  740,  723,   92,  764,
+ /*  3440 */   731,  723,  147,  141,  740,  141,  740,  764,  731,  753,
+ /*  3450 */   731,  723,  723,   92,  723,  172,  723,  723,  723,  723,
+ /*  3460 */    92,  729,  124,  723,  723,  254,  723,  723,   92,  723,
+ /*  3470 */    92,  766,   98,  723,  848,  723,  729,   99,  847,  146,
+ /*  3480 */   141,  740,  723,  729,  764,  731,  723,  723,  723,  723,
+ /*  3490 */   723,  729,  723,  729,  723,  723,  723,  723,  767,  723,
+ /*  3500 */   754,  723,  723,  723,  723,   92,  723,  141,  740,  141,
+ /*  3510 */   740,  764,  731,  764,  731,  141,  740,  723,  723,  752,
+ /*  3520 */   731,  723,  723,  723,  723,  723,  723,  723,  729,  723,
+ /*  3530 */   723,  723,   92,  723,   92,  723,  723,  723,  723,  723,
+ /*  3540 */    92,  723,  723,  723,  723,  723,  723,  723,  723,  723,
+ /*  3550 */   723,  723,  723,  723,  723,  729,  723,  729,  723,  723,
+ /*  3560 */   723,  723,  723,  729,
+};
+static const YYCODETYPE yy_lookahead[] = {
+ /*     0 */   160,    1,    2,    3,    4,    5,    6,    1,    8,    9,
+ /*    10 */    10,  112,  113,   13,  164,  165,  166,  164,  165,  166,
+ /*    20 */    20,   21,   22,   23,   24,   25,   26,   27,   28,   29,
+ /*    30 */    30,   31,  166,  167,  168,  169,  170,  171,  172,  173,
+ /*    40 */   174,  166,  167,  168,  169,  170,  171,  172,  173,  174,
+ /*    50 */    36,   37,   38,   39,  164,  165,  166,   14,   58,   16,
+ /*    60 */    60,   61,   62,   63,   64,   65,   66,   67,   68,   69,
+ /*    70 */    70,   71,   72,   73,   74,   75,   76,   77,   78,   79,
+ /*    80 */    80,   81,   82,   83,   84,   85,   86,   87,   88,   21,
+ /*    90 */    90,   91,   92,  166,   94,   95,   96,   97,   98,   99,
+ /*   100 */   100,  101,    1,    2,    3,    4,    5,    6,    6,    8,
+ /*   110 */     9,   10,   78,   14,   13,   16,   14,   83,   84,   85,
+ /*   120 */    21,   20,   21,   22,   23,   24,   25,   26,   27,   28,
+ /*   130 */    29,   30,   31,  120,   66,   67,   68,   69,   70,   71,
+ /*   140 */    72,   73,   74,   75,   76,   77,   78,   79,   80,   81,
+ /*   150 */    82,   83,   84,   85,  164,  165,  166,   20,   90,   58,
+ /*   160 */   114,   60,   61,   62,   63,   64,   65,   66,   67,   68,
+ /*   170 */    69,   70,   71,   72,   73,   74,   75,   76,   77,   78,
+ /*   180 */    79,   80,   81,   82,   83,   84,   85,   86,   87,   88,
+ /*   190 */    21,   90,   91,   92,  177,   94,   95,   96,   97,   98,
+ /*   200 */    99,  100,  101,    1,    2,    3,    4,    5,    6,   11,
+ /*   210 */     8,    9,   10,   47,   48,   49,   50,   51,   52,   53,
+ /*   220 */    54,   55,   56,   57,   22,   23,   24,   25,   26,   27,
+ /*   230 */    28,   29,   30,   31,  187,   66,   67,   68,   69,   70,
+ /*   240 */    71,   72,   73,   74,   75,   76,   77,   78,   79,   80,
+ /*   250 */    81,   82,   83,   84,   85,  164,  165,  166,   27,   90,
+ /*   260 */    58,  122,   60,   61,   62,   63,   64,   65,   66,   67,
+ /*   270 */    68,   69,   70,   71,   72,   73,   74,   75,   76,   77,
+ /*   280 */    78,   79,   80,   81,   82,   83,   84,   85,   86,   87,
+ /*   290 */    88,  106,   90,   11,  109,  166,  167,  168,  169,  170,
+ /*   300 */   171,  172,  173,  174,  164,  165,  166,  187,  123,  124,
+ /*   310 */   125,  126,  127,  128,    1,  130,  131,  132,  133,  134,
+ /*   320 */   135,  136,  137,  138,  139,  140,  141,  164,  165,  166,
+ /*   330 */   145,  166,  167,  168,  169,  170,  171,  172,  173,  174,
+ /*   340 */   164,  165,  166,  136,  137,  163,  161,  140,  141,  112,
+ /*   350 */   113,  166,  167,  168,  169,  170,  171,  172,  173,  122,
+ /*   360 */   175,  176,  177,  178,  179,  180,  181,  182,  161,  184,
+ /*   370 */     1,    1,    2,    3,    4,    5,    6,    1,    8,    9,
+ /*   380 */    10,   14,    6,   16,  164,  165,  166,  163,   21,    1,
+ /*   390 */    14,  184,   22,   23,   24,   25,   26,   27,   28,   29,
+ /*   400 */    30,   31,  163,   27,  164,  165,  166,   60,   61,   62,
+ /*   410 */    63,   64,   65,   66,   67,   68,   69,   70,   71,   72,
+ /*   420 */    73,   74,   75,   76,   77,   78,   79,   80,   81,   82,
+ /*   430 */    83,   84,   85,   86,   87,   88,   66,   67,   68,   69,
+ /*   440 */    70,   71,   72,   73,   74,   75,   76,   77,   78,   79,
+ /*   450 */    80,   81,   82,   83,   84,   85,  111,  124,  106,  114,
+ /*   460 */   127,  109,  112,  113,   14,  105,   16,  122,  135,  136,
+ /*   470 */   137,   11,   12,  140,  141,  123,  124,  125,  126,  127,
+ /*   480 */   128,  121,  130,  131,  132,  133,  134,  135,  136,  137,
+ /*   490 */   138,  139,  140,  141,  161,  156,   27,   11,  159,  105,
+ /*   500 */    11,   32,   33,  106,  107,  166,  109,  168,  148,   59,
+ /*   510 */   171,  172,    7,  161,  117,  121,   11,  184,  166,  167,
+ /*   520 */   168,  169,  170,  171,  172,  173,  108,  175,  176,  177,
+ /*   530 */   178,  179,  180,  181,  182,    1,  184,    1,  111,    6,
+ /*   540 */     6,  114,    6,  116,   58,  104,   11,   14,   14,  122,
+ /*   550 */     1,    2,    3,    4,    5,    6,    7,    8,    9,   10,
+ /*   560 */    27,   27,    7,  166,  167,  168,  169,  170,  171,  172,
+ /*   570 */   173,   22,   23,   24,   25,   26,   27,   28,   29,   30,
+ /*   580 */    31,   58,  185,  186,  166,  167,  168,  169,  170,  171,
+ /*   590 */   172,  173,    1,   58,   60,   61,   62,   63,   64,   65,
+ /*   600 */    66,   67,   68,   69,   70,   71,   72,   73,   74,   75,
+ /*   610 */    76,   77,   78,   79,   80,   81,   82,   83,   84,   85,
+ /*   620 */    86,   87,   88,    1,    2,    3,    4,    5,    6,   58,
+ /*   630 */     8,    9,   10,    6,   11,   13,   58,  106,   15,    7,
+ /*   640 */   109,   14,   20,   11,   22,   23,   24,   25,   26,   27,
+ /*   650 */    28,   29,   30,   31,  123,  124,  125,  126,  127,  128,
+ /*   660 */    62,  130,  131,  132,  133,  134,  135,  136,  137,  138,
+ /*   670 */   139,  140,  141,   11,  156,    7,   78,  159,    7,   11,
+ /*   680 */    58,   83,   84,   85,  166,    6,  168,    6,   58,  171,
+ /*   690 */   172,    6,  161,   45,   46,   14,   95,  166,  167,  168,
+ /*   700 */   169,  170,  171,  172,  173,   78,   40,   41,   27,  178,
+ /*   710 */    83,   84,   85,   91,   92,  184,   94,   95,   96,   97,
+ /*   720 */    98,   99,  100,  101,    6,    6,   28,   29,  111,  112,
+ /*   730 */   113,  114,    6,   14,   20,   16,   17,   18,   19,  122,
+ /*   740 */    93,   60,   61,   62,   63,   64,   65,   66,   67,   68,
+ /*   750 */    69,   70,   71,   72,   73,   74,   75,   76,   77,   78,
+ /*   760 */    79,   80,   81,   82,   83,   84,   85,   86,   87,   88,
+ /*   770 */     0,   34,   35,   59,   60,   61,   62,   63,   64,   65,
+ /*   780 */    66,   67,   68,   69,   70,   71,   72,   73,   74,   75,
+ /*   790 */    76,   77,   78,   79,   80,   81,   82,   83,   84,   85,
+ /*   800 */    86,   87,   88,    1,   90,    6,   12,   12,   12,    7,
+ /*   810 */    66,   67,   68,   69,   70,   71,   72,   73,   74,   75,
+ /*   820 */    76,   77,   78,   79,   80,   81,   82,   83,   84,   85,
+ /*   830 */    60,   61,   62,   63,   64,   65,   66,   67,   68,   69,
+ /*   840 */    70,   71,   72,   73,   74,   75,   76,   77,   78,   79,
+ /*   850 */    80,   81,   82,   83,   84,   85,   86,   87,   88,    7,
+ /*   860 */    90,   12,   60,   61,   62,   63,   64,   65,   66,   67,
+ /*   870 */    68,   69,   70,   71,   72,   73,   74,   75,   76,   77,
+ /*   880 */    78,   79,   80,   81,   82,   83,   84,   85,   86,   87,
+ /*   890 */    88,   60,   61,   62,   63,   64,   65,   66,   67,   68,
+ /*   900 */    69,   70,   71,   72,   73,   74,   75,   76,   77,   78,
+ /*   910 */    79,   80,   81,   82,   83,   84,   85,   86,   87,   88,
+ /*   920 */     1,   90,    1,   60,   61,   62,   63,   64,   65,   66,
+ /*   930 */    67,   68,   69,   70,   71,   72,   73,   74,   75,   76,
+ /*   940 */    77,   78,   79,   80,   81,   82,   83,   84,   85,   86,
+ /*   950 */    87,   88,   89,   21,    1,  123,  124,  125,  126,  127,
+ /*   960 */   128,   62,  130,  131,  132,  133,  134,  135,  136,  137,
+ /*   970 */   138,  139,  140,  141,    7,   58,   15,   78,   11,  118,
+ /*   980 */   119,  120,   83,   84,   85,    7,   11,  123,  124,  125,
+ /*   990 */   126,  127,  128,  161,  130,  131,  132,  133,  134,  135,
+ /*  1000 */   136,  137,  138,  139,  140,  141,    8,  175,  147,  177,
+ /*  1010 */   178,  179,  180,  181,  182,    6,  184,    1,    7,  123,
+ /*  1020 */   124,  125,  126,  127,  128,  161,  130,  131,  132,  133,
+ /*  1030 */   134,  135,  136,  137,  138,  139,  140,  141,    7,  175,
+ /*  1040 */     7,  177,  178,  179,  180,  181,  182,   15,  184,   15,
+ /*  1050 */    15,  123,  124,  125,  126,  127,  128,  161,  130,  131,
+ /*  1060 */   132,  133,  134,  135,  136,  137,  138,  139,  140,  141,
+ /*  1070 */    15,  175,    7,  177,  178,  179,  180,  181,  182,    7,
+ /*  1080 */   184,   11,   15,  123,  124,  125,  126,  127,  128,  161,
+ /*  1090 */   130,  131,  132,  133,  134,  135,  136,  137,  138,  139,
+ /*  1100 */   140,  141,   27,  175,   14,  177,  178,  179,  180,  181,
+ /*  1110 */   182,   15,  184,   15,   15,  123,  124,  125,  126,  127,
+ /*  1120 */   128,  161,  130,  131,  132,  133,  134,  135,  136,  137,
+ /*  1130 */   138,  139,  140,  141,    7,  175,    7,  177,  178,  179,
+ /*  1140 */   180,  181,  182,    6,  184,   59,   21,  123,  124,  125,
+ /*  1150 */   126,  127,  128,  161,  130,  131,  132,  133,  134,  135,
+ /*  1160 */   136,  137,  138,  139,  140,  141,   20,  175,   15,  177,
+ /*  1170 */   178,  179,  180,  181,  182,   15,  184,   15,   15,  123,
+ /*  1180 */   124,  125,  126,  127,  128,  161,  130,  131,  132,  133,
+ /*  1190 */   134,  135,  136,  137,  138,  139,  140,  141,   12,  175,
+ /*  1200 */    44,  177,  178,  179,  180,  181,  182,   43,  184,   42,
+ /*  1210 */    26,  123,  124,  125,  126,  127,  128,  161,  130,  131,
+ /*  1220 */   132,  133,  134,  135,  136,  137,  138,  139,  140,  141,
+ /*  1230 */    20,  175,   20,  177,  178,  179,  180,  181,  182,   20,
+ /*  1240 */   184,    7,    6,  123,  124,  125,  126,  127,  128,  161,
+ /*  1250 */   130,  131,  132,  133,  134,  135,  136,  137,  138,  139,
+ /*  1260 */   140,  141,    7,  175,    6,  177,  178,  179,  180,  181,
+ /*  1270 */   182,   20,  184,    7,   21,  123,  124,  125,  126,  127,
+ /*  1280 */   128,  161,  130,  131,  132,  133,  134,  135,  136,  137,
+ /*  1290 */   138,  139,  140,  141,   62,  175,    7,  177,  178,  179,
+ /*  1300 */   180,  181,  182,  111,  184,    7,  114,  115,  156,   11,
+ /*  1310 */    78,  159,   12,  161,  122,   83,   84,   85,  166,   11,
+ /*  1320 */   168,    7,   11,  171,  172,   11,    6,  118,  119,  120,
+ /*  1330 */   123,  124,  125,  126,  127,  128,  184,  130,  131,  132,
+ /*  1340 */   133,  134,  135,  136,  137,  138,  139,  140,  141,   59,
+ /*  1350 */   106,  107,  188,  109,    7,  188,  147,  188,   11,  111,
+ /*  1360 */   151,  117,  114,  156,  116,  188,  159,    7,  161,   58,
+ /*  1370 */   122,   11,  188,  166,  188,  168,  188,  106,  171,  172,
+ /*  1380 */   109,  188,   11,  188,  188,  123,  124,  125,  126,  127,
+ /*  1390 */   128,  184,  130,  131,  132,  133,  134,  135,  136,  137,
+ /*  1400 */   138,  139,  140,  141,   62,  188,  158,  188,  188,  188,
+ /*  1410 */   166,  167,  168,  169,  170,  171,  172,  173,  156,    1,
+ /*  1420 */    78,  159,  188,  161,    6,   83,   84,   85,  166,   58,
+ /*  1430 */   168,  188,  188,  171,  172,  188,  188,  166,  167,  168,
+ /*  1440 */   169,  170,  171,  172,  173,   27,  184,  188,  124,  125,
+ /*  1450 */    62,  127,  128,  129,  130,  131,  132,  133,  134,  135,
+ /*  1460 */   136,  137,  138,  139,  140,  141,   78,    6,  188,  188,
+ /*  1470 */   188,   83,   84,   85,  188,   14,   58,  188,  188,  188,
+ /*  1480 */   156,  188,  188,  159,  188,  161,  188,  188,   27,  188,
+ /*  1490 */   166,  188,  168,  188,  188,  171,  172,  188,  188,  109,
+ /*  1500 */   110,  188,  123,  124,  125,  126,  127,  128,  184,  130,
+ /*  1510 */   131,  132,  133,  134,  135,  136,  137,  138,  139,  140,
+ /*  1520 */   141,  123,  124,  125,  126,  127,  128,   62,  130,  131,
+ /*  1530 */   132,  133,  134,  135,  136,  137,  138,  139,  140,  141,
+ /*  1540 */   161,  188,  188,   78,  188,  188,  156,  157,   83,   84,
+ /*  1550 */    85,  188,  188,  188,  188,  156,  166,  178,  168,  161,
+ /*  1560 */   188,  171,  172,  184,  188,  166,  188,  168,  188,  188,
+ /*  1570 */   171,  172,  188,  188,  188,  188,  178,  188,  188,  188,
+ /*  1580 */   188,  188,  184,  123,  124,  125,  126,  127,  128,  188,
+ /*  1590 */   130,  131,  132,  133,  134,  135,  136,  137,  138,  139,
+ /*  1600 */   140,  141,  142,    1,    2,    3,    4,    5,    6,  188,
+ /*  1610 */     8,    9,   10,  188,  188,  109,  110,  188,  188,  106,
+ /*  1620 */   188,  161,  109,  188,   22,   23,   24,   25,   26,   27,
+ /*  1630 */    28,   29,   30,   31,  188,  103,  188,  188,  123,  124,
+ /*  1640 */   125,  126,  127,  128,  184,  130,  131,  132,  133,  134,
+ /*  1650 */   135,  136,  137,  138,  139,  140,  141,  142,  188,  146,
+ /*  1660 */    58,    1,  156,  157,  188,  152,    6,  188,  188,  188,
+ /*  1670 */   188,  188,  166,  188,  168,  188,  161,  171,  172,  166,
+ /*  1680 */   167,  168,  169,  170,  171,  172,  173,   27,  156,  188,
+ /*  1690 */    13,  159,  188,  188,  188,  188,  188,  188,  166,  184,
+ /*  1700 */   168,  188,  188,  171,  172,   66,   67,   68,   69,   70,
+ /*  1710 */    71,   72,   73,   74,   75,   76,   77,   78,   79,   80,
+ /*  1720 */    81,   82,   83,   84,   85,  188,  188,  188,  188,   90,
+ /*  1730 */   188,  188,  188,  188,  188,  188,  188,  188,  188,  188,
+ /*  1740 */   188,  188,  188,   66,   67,   68,   69,   70,   71,   72,
+ /*  1750 */    73,   74,   75,   76,   77,   78,   79,   80,   81,   82,
+ /*  1760 */    83,   84,   85,    1,    2,    3,    4,    5,    6,  188,
+ /*  1770 */     8,    9,   10,    1,    2,    3,    4,    5,    6,  188,
+ /*  1780 */     8,    9,   10,  188,   22,   23,   24,   25,   26,   27,
+ /*  1790 */    28,   29,   30,   31,   22,   23,   24,   25,   26,   27,
+ /*  1800 */    28,   29,   30,   31,  188,  188,  188,  188,  188,  188,
+ /*  1810 */   188,  188,  188,  188,  123,  124,  125,  126,  127,  128,
+ /*  1820 */    58,  130,  131,  132,  133,  134,  135,  136,  137,  138,
+ /*  1830 */   139,  140,  141,  124,  125,  126,  127,  128,  188,  130,
+ /*  1840 */   131,  132,  133,  134,  135,  136,  137,  138,  139,  140,
+ /*  1850 */   141,  188,  161,  144,  188,    1,    2,    3,    4,    5,
+ /*  1860 */     6,    1,    8,    9,   10,  188,    6,  188,  188,  188,
+ /*  1870 */   161,  188,   12,  188,   20,  184,   22,   23,   24,   25,
+ /*  1880 */    26,   27,   28,   29,   30,   31,  188,   27,  124,  125,
+ /*  1890 */   126,  127,  128,  184,  130,  131,  132,  133,  134,  135,
+ /*  1900 */   136,  137,  138,  139,  140,  141,  188,  143,  188,    1,
+ /*  1910 */     2,    3,    4,    5,    6,    1,    8,    9,   10,  188,
+ /*  1920 */     6,  188,  188,   15,  188,  161,   12,  188,  188,  188,
+ /*  1930 */    22,   23,   24,   25,   26,   27,   28,   29,   30,   31,
+ /*  1940 */   188,   27,  188,  124,  125,  126,  127,  128,  184,  130,
+ /*  1950 */   131,  132,  133,  134,  135,  136,  137,  138,  139,  140,
+ /*  1960 */   141,  188,  143,  188,  118,  119,  120,  188,  188,  188,
+ /*  1970 */   188,  188,   58,  188,  188,  124,  125,  126,  127,  128,
+ /*  1980 */   161,  130,  131,  132,  133,  134,  135,  136,  137,  138,
+ /*  1990 */   139,  140,  141,  147,  143,  188,  188,  151,  188,  188,
+ /*  2000 */   188,  188,  188,  184,  188,  188,  123,  124,  125,  126,
+ /*  2010 */   127,  128,  161,  130,  131,  132,  133,  134,  135,  136,
+ /*  2020 */   137,  138,  139,  140,  141,    1,    2,    3,    4,    5,
+ /*  2030 */     6,  188,    8,    9,   10,  184,  188,  188,  188,   15,
+ /*  2040 */   188,  188,  188,  188,  161,  188,   22,   23,   24,   25,
+ /*  2050 */    26,   27,   28,   29,   30,   31,  188,  188,  188,  188,
+ /*  2060 */   188,  188,  188,  188,  188,  188,  188,  184,  123,  124,
+ /*  2070 */   125,  126,  127,  128,  188,  130,  131,  132,  133,  134,
+ /*  2080 */   135,  136,  137,  138,  139,  140,  141,  111,  188,  188,
+ /*  2090 */   114,  115,  188,  188,  188,  188,  188,  188,  122,  188,
+ /*  2100 */   123,  124,  125,  126,  127,  128,  161,  130,  131,  132,
+ /*  2110 */   133,  134,  135,  136,  137,  138,  139,  140,  141,  188,
+ /*  2120 */   188,  188,  188,  188,  188,  188,  150,  188,  188,  184,
+ /*  2130 */   188,  188,  123,  124,  125,  126,  127,  128,  161,  130,
+ /*  2140 */   131,  132,  133,  134,  135,  136,  137,  138,  139,  140,
+ /*  2150 */   141,    1,    2,    3,    4,    5,    6,  188,    8,    9,
+ /*  2160 */    10,  184,  188,  188,  188,   15,  188,  188,  188,  188,
+ /*  2170 */   161,  188,   22,   23,   24,   25,   26,   27,   28,   29,
+ /*  2180 */    30,   31,  188,  188,  188,  188,  188,  188,  188,  188,
+ /*  2190 */   188,  188,  188,  184,  123,  124,  125,  126,  127,  128,
+ /*  2200 */   188,  130,  131,  132,  133,  134,  135,  136,  137,  138,
+ /*  2210 */   139,  140,  141,  111,  188,  188,  114,  115,  188,  188,
+ /*  2220 */   188,  188,  188,  188,  122,  188,  123,  124,  125,  126,
+ /*  2230 */   127,  128,  161,  130,  131,  132,  133,  134,  135,  136,
+ /*  2240 */   137,  138,  139,  140,  141,  188,  188,  188,  188,  188,
+ /*  2250 */   188,  188,  150,  188,  188,  184,  188,  188,  188,  188,
+ /*  2260 */   188,  188,  188,  188,  161,  124,  125,  126,  127,  128,
+ /*  2270 */   188,  130,  131,  132,  133,  134,  135,  136,  137,  138,
+ /*  2280 */   139,  140,  141,  188,  188,  188,  188,  184,  188,    1,
+ /*  2290 */     2,    3,    4,    5,    6,  188,    8,    9,   10,  188,
+ /*  2300 */   188,  188,  161,  188,  188,  188,  188,  188,   20,  188,
+ /*  2310 */    22,   23,   24,   25,   26,   27,   28,   29,   30,   31,
+ /*  2320 */   124,  125,  126,  127,  128,  184,  130,  131,  132,  133,
+ /*  2330 */   134,  135,  136,  137,  138,  139,  140,  141,  188,  188,
+ /*  2340 */   188,  188,  188,  188,  188,  188,  188,  188,  188,  188,
+ /*  2350 */   188,  188,  124,  125,  126,  127,  128,  161,  130,  131,
+ /*  2360 */   132,  133,  134,  135,  136,  137,  138,  139,  140,  141,
+ /*  2370 */   188,  188,  188,  188,  188,  188,  188,  188,  188,  188,
+ /*  2380 */   184,  188,  188,  188,  188,  188,  188,  188,  188,  161,
+ /*  2390 */   124,  125,  188,  127,  128,  129,  130,  131,  132,  133,
+ /*  2400 */   134,  135,  136,  137,  138,  139,  140,  141,  188,  188,
+ /*  2410 */   188,  188,  184,  188,  188,  188,  188,  188,  188,  188,
+ /*  2420 */   188,  188,  124,  125,  126,  127,  128,  161,  130,  131,
+ /*  2430 */   132,  133,  134,  135,  136,  137,  138,  139,  140,  141,
+ /*  2440 */   188,  188,  188,  188,  188,  188,  188,  188,  188,  188,
+ /*  2450 */   184,  188,  188,  188,  124,  125,  126,  127,  128,  161,
+ /*  2460 */   130,  131,  132,  133,  134,  135,  136,  137,  138,  139,
+ /*  2470 */   140,  141,  188,  188,  188,  188,  188,  188,  188,  188,
+ /*  2480 */   188,  188,  184,  188,  188,  188,  188,  188,  188,  124,
+ /*  2490 */   125,  161,  127,  128,  129,  130,  131,  132,  133,  134,
+ /*  2500 */   135,  136,  137,  138,  139,  140,  141,  188,  188,  188,
+ /*  2510 */   188,  188,  188,  188,  184,  188,  188,  188,  188,  188,
+ /*  2520 */   188,  188,  188,  188,  124,  125,  161,  127,  128,  129,
+ /*  2530 */   130,  131,  132,  133,  134,  135,  136,  137,  138,  139,
+ /*  2540 */   140,  141,  188,  188,  188,  188,  188,  188,  188,  184,
+ /*  2550 */   188,  188,  188,  188,  188,  188,  124,  125,  126,  127,
+ /*  2560 */   128,  161,  130,  131,  132,  133,  134,  135,  136,  137,
+ /*  2570 */   138,  139,  140,  141,  188,  188,  188,  188,  188,  188,
+ /*  2580 */   188,  188,  188,  188,  184,  188,  188,  188,  124,  125,
+ /*  2590 */   126,  127,  128,  161,  130,  131,  132,  133,  134,  135,
+ /*  2600 */   136,  137,  138,  139,  140,  141,  188,  188,  188,  188,
+ /*  2610 */   188,  188,  188,  188,  188,  188,  184,  188,  188,  188,
+ /*  2620 */   124,  125,  126,  127,  128,  161,  130,  131,  132,  133,
+ /*  2630 */   134,  135,  136,  137,  138,  139,  140,  141,  188,  188,
+ /*  2640 */   188,  188,  188,  188,  188,  188,  188,  188,  184,  188,
+ /*  2650 */   188,  188,  124,  125,  126,  127,  128,  161,  130,  131,
+ /*  2660 */   132,  133,  134,  135,  136,  137,  138,  139,  140,  141,
+ /*  2670 */   188,  188,  188,  188,  188,  188,  188,  188,  188,  188,
+ /*  2680 */   184,  188,  188,  188,  188,  188,  188,  124,  125,  161,
+ /*  2690 */   127,  128,  129,  130,  131,  132,  133,  134,  135,  136,
+ /*  2700 */   137,  138,  139,  140,  141,  188,  188,  188,  188,  188,
+ /*  2710 */   188,  188,  184,  188,  188,  188,  188,  188,  188,  124,
+ /*  2720 */   125,  126,  127,  128,  161,  130,  131,  132,  133,  134,
+ /*  2730 */   135,  136,  137,  138,  139,  140,  141,  188,  188,  188,
+ /*  2740 */   188,  188,  188,  188,  188,  188,  188,  184,  188,  188,
+ /*  2750 */   188,  124,  125,  126,  127,  128,  161,  130,  131,  132,
+ /*  2760 */   133,  134,  135,  136,  137,  138,  139,  140,  141,  188,
+ /*  2770 */   188,  188,  188,  188,  188,  188,  188,  188,  188,  184,
+ /*  2780 */   188,  188,  188,  188,  188,  188,  124,  125,  161,  127,
+ /*  2790 */   128,  129,  130,  131,  132,  133,  134,  135,  136,  137,
+ /*  2800 */   138,  139,  140,  141,  188,  188,  188,  188,  188,  188,
+ /*  2810 */   188,  184,  188,  188,  188,  188,  188,  188,  124,  125,
+ /*  2820 */   126,  127,  128,  161,  130,  131,  132,  133,  134,  135,
+ /*  2830 */   136,  137,  138,  139,  140,  141,  188,  188,  188,  188,
+ /*  2840 */   188,  188,  188,  188,  188,  188,  184,  188,  188,  188,
+ /*  2850 */   188,  188,  188,  124,  125,  161,  127,  128,  129,  130,
+ /*  2860 */   131,  132,  133,  134,  135,  136,  137,  138,  139,  140,
+ /*  2870 */   141,  188,  188,  188,  188,  188,  188,  188,  184,  188,
+ /*  2880 */   188,  188,  188,  188,  188,  124,  125,  126,  127,  128,
+ /*  2890 */   161,  130,  131,  132,  133,  134,  135,  136,  137,  138,
+ /*  2900 */   139,  140,  141,  188,  188,  188,  188,  188,  188,  188,
+ /*  2910 */   188,  188,  188,  184,  188,  188,  188,  124,  125,  126,
+ /*  2920 */   127,  128,  161,  130,  131,  132,  133,  134,  135,  136,
+ /*  2930 */   137,  138,  139,  140,  141,  188,  188,  188,  188,  188,
+ /*  2940 */   188,  188,  188,  188,  188,  184,  188,  188,  188,  124,
+ /*  2950 */   125,  126,  127,  128,  161,  130,  131,  132,  133,  134,
+ /*  2960 */   135,  136,  137,  138,  139,  140,  141,    1,    2,    3,
+ /*  2970 */     4,    5,    6,  188,    8,    9,   10,  184,  188,  188,
+ /*  2980 */   188,  188,  188,  188,  188,  188,  161,  188,   22,   23,
+ /*  2990 */    24,   25,   26,   27,   28,   29,   30,   31,    1,    2,
+ /*  3000 */     3,    4,    5,    6,  188,    8,    9,   10,  188,  184,
+ /*  3010 */   188,  188,  188,  188,  188,  188,  188,  188,  188,   22,
+ /*  3020 */    23,   24,   25,   26,   27,   28,   29,   30,   31,  188,
+ /*  3030 */   188,  188,  188,  109,  110,  188,  188,  188,  124,  125,
+ /*  3040 */   188,  127,  128,  188,  130,  131,  132,  133,  134,  135,
+ /*  3050 */   136,  137,  138,  139,  140,  141,  188,  188,  108,  188,
+ /*  3060 */   188,  111,  112,  113,  114,  188,  188,  188,  188,  188,
+ /*  3070 */   124,  125,  122,  127,  188,  161,  130,  131,  132,  133,
+ /*  3080 */   156,  135,  136,  137,  138,  139,  140,  141,  188,  188,
+ /*  3090 */   166,  188,  168,  188,  188,  171,  172,  188,  184,  188,
+ /*  3100 */   188,  188,  188,  153,  154,  155,  108,  161,  188,  188,
+ /*  3110 */   112,  113,  188,  188,  188,  188,  166,  167,  168,  169,
+ /*  3120 */   170,  171,  172,  173,  188,  124,  125,  188,  127,  188,
+ /*  3130 */   184,  130,  131,  132,  156,  188,  135,  136,  137,  138,
+ /*  3140 */   139,  140,  141,  188,  166,  188,  168,  188,  188,  171,
+ /*  3150 */   172,  153,  154,  155,  188,  188,  188,  188,  188,  188,
+ /*  3160 */   188,  188,  161,  188,  166,  167,  168,  169,  170,  171,
+ /*  3170 */   172,  173,  188,  188,  188,  124,  125,  188,  127,  188,
+ /*  3180 */   188,  130,  131,  188,  108,  184,  135,  136,  137,  138,
+ /*  3190 */   139,  140,  141,  188,  188,  188,  188,  188,  188,  188,
+ /*  3200 */   188,  188,  124,  125,  188,  127,  188,  108,  130,  188,
+ /*  3210 */   188,  188,  161,  135,  136,  137,  138,  139,  140,  141,
+ /*  3220 */   188,  188,  188,  127,  188,  188,  188,  188,  188,  153,
+ /*  3230 */   154,  188,  136,  137,  188,  184,  140,  141,  162,  161,
+ /*  3240 */   188,  188,  166,  167,  168,  169,  170,  171,  172,  173,
+ /*  3250 */   188,  188,  153,  154,  155,  188,  188,  161,  188,  188,
+ /*  3260 */   188,  188,  184,  188,  127,  166,  167,  168,  169,  170,
+ /*  3270 */   171,  172,  173,  136,  137,  188,  124,  140,  141,  127,
+ /*  3280 */   184,  188,  130,  188,  188,  188,  188,  135,  136,  137,
+ /*  3290 */   138,  139,  140,  141,  124,  188,  188,  127,  161,  188,
+ /*  3300 */   188,  188,  188,  188,  188,  135,  136,  137,  138,  139,
+ /*  3310 */   140,  141,  124,  161,  188,  127,  188,  188,  188,  188,
+ /*  3320 */   188,  184,  188,  135,  136,  137,  138,  139,  140,  141,
+ /*  3330 */   124,  161,  188,  127,  188,  188,  184,  188,  188,  188,
+ /*  3340 */   188,  135,  136,  137,  188,  139,  140,  141,  188,  161,
+ /*  3350 */   188,  188,  188,  188,  184,  188,  188,  188,  188,  188,
+ /*  3360 */   188,  188,  188,  124,  188,  188,  127,  161,  188,  188,
+ /*  3370 */   124,  188,  184,  127,  135,  136,  137,  188,  139,  140,
+ /*  3380 */   141,  135,  136,  137,  188,  139,  140,  141,  188,  188,
+ /*  3390 */   184,  188,  188,  188,  188,  188,  188,  188,  188,  188,
+ /*  3400 */   161,  124,  188,  188,  127,  188,  188,  161,  188,  103,
+ /*  3410 */   188,  188,  135,  136,  137,  188,  139,  140,  141,  127,
+ /*  3420 */   188,  188,  188,  184,  188,  188,  127,  135,  136,  137,
+ /*  3430 */   184,  124,  140,  141,  127,  136,  137,  188,  161,  140,
+ /*  3440 */   141,  188,  135,  136,  137,  136,  137,  140,  141,  140,
+ /*  3450 */   141,  188,  188,  161,  188,  149,  188,  188,  188,  188,
+ /*  3460 */   161,  184,  156,  188,  188,  159,  188,  188,  161,  188,
+ /*  3470 */   161,  127,  166,  188,  168,  188,  184,  171,  172,  135,
+ /*  3480 */   136,  137,  188,  184,  140,  141,  188,  188,  188,  188,
+ /*  3490 */   188,  184,  188,  184,  188,  188,  188,  188,  127,  188,
+ /*  3500 */   127,  188,  188,  188,  188,  161,  188,  136,  137,  136,
+ /*  3510 */   137,  140,  141,  140,  141,  136,  137,  188,  188,  140,
+ /*  3520 */   141,  188,  188,  188,  188,  188,  188,  188,  184,  188,
+ /*  3530 */   188,  188,  161,  188,  161,  188,  188,  188,  188,  188,
+ /*  3540 */   161,  188,  188,  188,  188,  188,  188,  188,  188,  188,
+ /*  3550 */   188,  188,  188,  188,  188,  184,  188,  184,  188,  188,
+ /*  3560 */   188,  188,  188,  184,
+};
+#define YY_SHIFT_COUNT    (257)
+#define YY_SHIFT_MIN      (0)
+#define YY_SHIFT_MAX      (2997)
+static const unsigned short int yy_shift_ofst[] = {
+ /*     0 */   831,    0,  101,  202,  622,  622,  622,  622,  622,  622,
+ /*    10 */   622,  622,  622,  622,  370,  370,  370,  370, 1602, 1602,
+ /*    20 */  1772, 1772, 1762,  549, 1854, 1854, 1854, 1772, 1772, 1772,
+ /*    30 */  1772, 1772, 1772, 1908, 2024, 2150, 1772, 1772, 1772, 1772,
+ /*    40 */  1772, 1772, 1772, 1772, 1772, 1772, 1772, 1772, 1772, 1772,
+ /*    50 */  1772, 1772, 1772, 1772, 1772,  534, 1772, 1772,  681, 1772,
+ /*    60 */  1772,  714,  770,  802,  347, 1772, 1772, 1772,  831, 1772,
+ /*    70 */  1772, 1772, 1772,  863,  347,  347,  347,  347, 1772, 1772,
+ /*    80 */  1639, 1639, 1677, 1772, 1772,   68,  169, 1677, 2288, 1772,
+ /*    90 */  1772, 1772, 1772,  744,  744, 2966, 2997, 2997,  744,  744,
+ /*   100 */  1914, 1418,  376, 1418,   43,   43, 1860,   99,  367, 1660,
+ /*   110 */   627,  598,  899, 1232,   34,   34,   34,   34,   34,   34,
+ /*   120 */  1660,  533,    6, 1461, 1461,    6,  166, 1342, 1388, 1465,
+ /*   130 */    34,  450,  536,  137,  198,  231,  282,  313,  369,  388,
+ /*   140 */   489,  719,   14,   14,   14,  469,  469,  469,  486,  505,
+ /*   150 */   632,  668,  967,  535, 1298, 1314,  102,  102,  460,  648,
+ /*   160 */   666,  666,  737,  737,  737,  737,  698,  698,  737,  698,
+ /*   170 */  1311,  623, 1347, 1360, 1371,  555,  523,  571,  578,  591,
+ /*   180 */   671,  662,  679,  630,  685,  601,  718,  726,  647,  799,
+ /*   190 */   794,  795,  796,  852,  849,  919,  921,  932,  953,  961,
+ /*   200 */   917,  978,  998,  975, 1009, 1016, 1011, 1031, 1033, 1032,
+ /*   210 */  1034, 1035, 1055, 1065, 1072, 1070, 1067, 1075, 1090, 1096,
+ /*   220 */  1098, 1099, 1127, 1129, 1137, 1086, 1125, 1146, 1153, 1160,
+ /*   230 */  1162, 1163, 1186, 1156, 1164, 1156, 1167, 1164, 1184, 1167,
+ /*   240 */  1184, 1210, 1212, 1219, 1212, 1234, 1236, 1255, 1258, 1251,
+ /*   250 */  1266, 1253, 1251, 1289, 1300, 1308, 1320, 1290,
+};
+#define YY_REDUCE_COUNT (140)
+#define YY_REDUCE_MIN   (-160)
+#define YY_REDUCE_MAX   (3379)
+static const short yy_reduce_ofst[] = {
+ /*     0 */   397,  185,  352,  531,  832,  864,  896,  928,  960,  992,
+ /*    10 */  1024, 1056, 1088, 1120, 1152, 1207, 1262, 1324, 1379, 1398,
+ /*    20 */  1460, 1515, 1691, 1709, 1764, 1819, 1851, 1883, 1945, 1977,
+ /*    30 */  2009, 2071, 2103, 2141, 2196, 2228, 2266, 2298, 2330, 2365,
+ /*    40 */  2400, 2432, 2464, 2496, 2528, 2563, 2595, 2627, 2662, 2694,
+ /*    50 */  2729, 2761, 2793, 2825, 2914, 2950, 2946, 3001, 2998, 3051,
+ /*    60 */  3078, 1513, 1244, 3076, 3099, 3152, 3170, 3188, 1271, 3206,
+ /*    70 */  3239, 3246, 3277,  418, -134, -125,  129,  165,  333, 3307,
+ /*    80 */  1390, 1506, 3306, 3292, 3344, 2924, 2924, 1532, 3096, 3137,
+ /*    90 */  3299, 3371, 3373,  339,  518,  207, 3309, 3379, 1399, 2978,
+ /*   100 */  1248, 1976,  617, 2102, 1209, 1846,  427,  861,  861, 1192,
+ /*   110 */  -150, -147, -110,  -10,   91,  140,  163,  176,  220,  240,
+ /*   120 */   345,  237,  360, -101,  350,  394, -160,  -73,  -73,  -73,
+ /*   130 */   -73,   13,   46,   17,   47,  139,  120,  182,  224,  239,
+ /*   140 */   441,
+};
+static const YYACTIONTYPE yy_default[] = {
+ /*     0 */   721,  721,  721,  721,  721,  721,  721,  721,  721,  721,
+ /*    10 */   721,  721,  721,  721,  721,  721,  721,  721,  721,  721,
+ /*    20 */   813,  813,  721,  721,  721,  721,  721,  721,  721,  721,
+ /*    30 */   721,  721,  721,  721,  721,  721,  721,  721,  721,  721,
+ /*    40 */   721,  721,  721,  721,  721,  721,  721,  721,  721,  721,
+ /*    50 */   721,  721,  721,  721,  721,  909,  721,  721,  909,  721,
+ /*    60 */   721,  827,  721,  721,  909,  721,  721,  721,  979,  721,
+ /*    70 */   721,  721,  721,  721,  818,  818,  818,  818,  721,  721,
+ /*    80 */   721,  721,  721,  721,  721,  721,  721,  721,  721,  721,
+ /*    90 */   721,  721,  721,  721,  721,  721,  721,  721,  862,  860,
+ /*   100 */   721,  721,  907,  721,  934,  934,  721,  934,  934,  721,
+ /*   110 */   915,  897,  897,  897,  897,  897,  897,  897,  897,  897,
+ /*   120 */   721,  896,  721,  721,  913,  983,  764,  898,  898,  898,
+ /*   130 */   898,  721,  721,  721,  982,  896,  982,  869,  869,  869,
+ /*   140 */   981,  751,  783,  782,  781,  772,  771,  770,  721,  721,
+ /*   150 */   721,  721,  721,  721,  721,  721,  884,  883,  721,  794,
+ /*   160 */   785,  784,  780,  779,  778,  777,  775,  774,  776,  773,
+ /*   170 */   721,  721,  721,  721,  721,  721,  721,  721,  721,  721,
+ /*   180 */   721,  812,  721,  721,  721,  721,  721,  721,  959,  721,
+ /*   190 */   721,  721,  724,  721,  721,  721,  721,  721,  721,  721,
+ /*   200 */   721,  721,  721,  721,  721,  721,  721,  721,  721,  721,
+ /*   210 */   721,  759,  721,  721,  721,  902,  721,  721,  721,  721,
+ /*   220 */   721,  721,  721,  721,  721,  874,  721,  721,  721,  721,
+ /*   230 */   721,  759,  867,  793,  791,  792,  789,  790,  787,  788,
+ /*   240 */   786,  721,  852,  721,  850,  721,  878,  721,  721,  756,
+ /*   250 */   721,  721,  721,  721,  721,  721,  721,  827,
+};
+/********** End of lemon-generated parsing tables *****************************/
+
+/* The next table maps tokens (terminal symbols) into fallback tokens.  
+** If a construct like the following:
+** 
+**      %fallback ID X Y Z.
+**
+** appears in the grammar, then ID becomes a fallback token for X, Y,
+** and Z.  Whenever one of the tokens X, Y, or Z is input to the parser
+** but it does not parse, the type of the token is changed to ID and
+** the parse is retried before an error is thrown.
+**
+** This feature can be used, for example, to cause some keywords in a language
+** to revert to identifiers if they keyword does not apply in the context where
+** it appears.
+*/
+#ifdef YYFALLBACK
+static const YYCODETYPE yyFallback[] = {
+};
+#endif /* YYFALLBACK */
+
+/* The following structure represents a single element of the
+** parser's stack.  Information stored includes:
+**
+**   +  The state number for the parser at this level of the stack.
+**
+**   +  The value of the token stored at this level of the stack.
+**      (In other words, the "major" token.)
+**
+**   +  The semantic value stored at this level of the stack.  This is
+**      the information used by the action routines in the grammar.
+**      It is sometimes called the "minor" token.
+**
+** After the "shift" half of a SHIFTREDUCE action, the stateno field
+** actually contains the reduce action for the second half of the
+** SHIFTREDUCE.
+*/
+struct yyStackEntry {
+  YYACTIONTYPE stateno;  /* The state-number, or reduce action in SHIFTREDUCE */
+  YYCODETYPE major;      /* The major token value.  This is the code
+                         ** number for the token at this stack level */
+  YYMINORTYPE minor;     /* The user-supplied minor token value.  This
+                         ** is the value of the token  */
+};
+typedef struct yyStackEntry yyStackEntry;
+
+/* The state of the parser is completely contained in an instance of
+** the following structure */
+struct yyParser {
+  yyStackEntry *yytos;          /* Pointer to top element of the stack */
+#ifdef YYTRACKMAXSTACKDEPTH
+  int yyhwm;                    /* High-water mark of the stack */
+#endif
+#ifndef YYNOERRORRECOVERY
+  int yyerrcnt;                 /* Shifts left before out of the error */
+#endif
+  DBCC_Lemon_ParserARG_SDECL                /* A place to hold %extra_argument */
+#if YYSTACKDEPTH<=0
+  int yystksz;                  /* Current side of the stack */
+  yyStackEntry *yystack;        /* The parser's stack */
+  yyStackEntry yystk0;          /* First stack entry */
+#else
+  yyStackEntry yystack[YYSTACKDEPTH];  /* The parser's stack */
+  yyStackEntry *yystackEnd;            /* Last entry in the stack */
+#endif
+};
+typedef struct yyParser yyParser;
+
+#ifndef NDEBUG
+#include <stdio.h>
+static FILE *yyTraceFILE = 0;
+static char *yyTracePrompt = 0;
+#endif /* NDEBUG */
+
+#ifndef NDEBUG
+/* 
+** Turn parser tracing on by giving a stream to which to write the trace
+** and a prompt to preface each trace message.  Tracing is turned off
+** by making either argument NULL 
+**
+** Inputs:
+** <ul>
+** <li> A FILE* to which trace output should be written.
+**      If NULL, then tracing is turned off.
+** <li> A prefix string written at the beginning of every
+**      line of trace output.  If NULL, then tracing is
+**      turned off.
+** </ul>
+**
+** Outputs:
+** None.
+*/
+void DBCC_Lemon_ParserTrace(FILE *TraceFILE, char *zTracePrompt){
+  yyTraceFILE = TraceFILE;
+  yyTracePrompt = zTracePrompt;
+  if( yyTraceFILE==0 ) yyTracePrompt = 0;
+  else if( yyTracePrompt==0 ) yyTraceFILE = 0;
+}
+#endif /* NDEBUG */
+
+#if defined(YYCOVERAGE) || !defined(NDEBUG)
+/* For tracing shifts, the names of all terminals and nonterminals
+** are required.  The following table supplies these names */
+static const char *const yyTokenName[] = { 
+  /*    0 */ "$",
+  /*    1 */ "IDENTIFIER",
+  /*    2 */ "I_CONSTANT",
+  /*    3 */ "F_CONSTANT",
+  /*    4 */ "ENUMERATION_CONSTANT",
+  /*    5 */ "CHAR_CONSTANT",
+  /*    6 */ "LPAREN",
+  /*    7 */ "RPAREN",
+  /*    8 */ "STRING_LITERAL",
+  /*    9 */ "FUNC_NAME",
+  /*   10 */ "GENERIC",
+  /*   11 */ "COMMA",
+  /*   12 */ "COLON",
+  /*   13 */ "DEFAULT",
+  /*   14 */ "LBRACKET",
+  /*   15 */ "RBRACKET",
+  /*   16 */ "PERIOD",
+  /*   17 */ "POINTER_ACCESS",
+  /*   18 */ "INCREMENT",
+  /*   19 */ "DECREMENT",
+  /*   20 */ "LBRACE",
+  /*   21 */ "RBRACE",
+  /*   22 */ "INC_OP",
+  /*   23 */ "DEC_OP",
+  /*   24 */ "SIZEOF",
+  /*   25 */ "ALIGNOF",
+  /*   26 */ "AMPERSAND",
+  /*   27 */ "ASTERISK",
+  /*   28 */ "PLUS",
+  /*   29 */ "MINUS",
+  /*   30 */ "TILDE",
+  /*   31 */ "EXCLAMATION_POINT",
+  /*   32 */ "SLASH",
+  /*   33 */ "PERCENT",
+  /*   34 */ "SHIFT_LEFT",
+  /*   35 */ "SHIFT_RIGHT",
+  /*   36 */ "LESS_THAN",
+  /*   37 */ "GREATER_THAN",
+  /*   38 */ "LE",
+  /*   39 */ "GE",
+  /*   40 */ "IS_EQUAL_TO",
+  /*   41 */ "NOT_EQUAL_TO",
+  /*   42 */ "CARAT",
+  /*   43 */ "VERTICAL_BAR",
+  /*   44 */ "LOGICAL_AND",
+  /*   45 */ "LOGICAL_OR",
+  /*   46 */ "QUESTION_MARK",
+  /*   47 */ "EQUAL_SIGN",
+  /*   48 */ "MULTIPLY_ASSIGN",
+  /*   49 */ "DIVIDE_ASSIGN",
+  /*   50 */ "REMAINDER_ASSIGN",
+  /*   51 */ "ADD_ASSIGN",
+  /*   52 */ "SUBTRACT_ASSIGN",
+  /*   53 */ "SHIFT_LEFT_ASSIGN",
+  /*   54 */ "SHIFT_RIGHT_ASSIGN",
+  /*   55 */ "BITWISE_AND_ASSIGN",
+  /*   56 */ "BITWISE_XOR_ASSIGN",
+  /*   57 */ "BITWISE_OR_ASSIGN",
+  /*   58 */ "SEMICOLON",
+  /*   59 */ "EQUALS",
+  /*   60 */ "TYPEDEF",
+  /*   61 */ "EXTERN",
+  /*   62 */ "STATIC",
+  /*   63 */ "THREAD_LOCAL",
+  /*   64 */ "AUTO",
+  /*   65 */ "REGISTER",
+  /*   66 */ "VOID",
+  /*   67 */ "CHAR",
+  /*   68 */ "INT",
+  /*   69 */ "SHORT",
+  /*   70 */ "LONG",
+  /*   71 */ "FLOAT",
+  /*   72 */ "DOUBLE",
+  /*   73 */ "SIGNED",
+  /*   74 */ "UNSIGNED",
+  /*   75 */ "BOOL",
+  /*   76 */ "COMPLEX",
+  /*   77 */ "IMAGINARY",
+  /*   78 */ "ATOMIC",
+  /*   79 */ "TYPEDEF_NAME",
+  /*   80 */ "STRUCT",
+  /*   81 */ "UNION",
+  /*   82 */ "ENUM",
+  /*   83 */ "CONST",
+  /*   84 */ "RESTRICT",
+  /*   85 */ "VOLATILE",
+  /*   86 */ "INLINE",
+  /*   87 */ "NORETURN",
+  /*   88 */ "ALIGNAS",
+  /*   89 */ "ELLIPSIS",
+  /*   90 */ "STATIC_ASSERT",
+  /*   91 */ "CASE",
+  /*   92 */ "IF",
+  /*   93 */ "ELSE",
+  /*   94 */ "SWITCH",
+  /*   95 */ "WHILE",
+  /*   96 */ "DO",
+  /*   97 */ "FOR",
+  /*   98 */ "GOTO",
+  /*   99 */ "CONTINUE",
+  /*  100 */ "BREAK",
+  /*  101 */ "RETURN",
+  /*  102 */ "error",
+  /*  103 */ "generic_association",
+  /*  104 */ "optional_comma",
+  /*  105 */ "enumeration_constant",
+  /*  106 */ "declaration",
+  /*  107 */ "external_declaration",
+  /*  108 */ "parameter_declaration",
+  /*  109 */ "static_assert_declaration",
+  /*  110 */ "struct_declaration",
+  /*  111 */ "declarator",
+  /*  112 */ "direct_abstract_declarator",
+  /*  113 */ "abstract_declarator",
+  /*  114 */ "direct_declarator",
+  /*  115 */ "init_declarator",
+  /*  116 */ "struct_declarator",
+  /*  117 */ "function_definition",
+  /*  118 */ "opt_designation",
+  /*  119 */ "designation",
+  /*  120 */ "designator",
+  /*  121 */ "enumerator",
+  /*  122 */ "pointer",
+  /*  123 */ "expression",
+  /*  124 */ "additive_expression",
+  /*  125 */ "and_expression",
+  /*  126 */ "assignment_expression",
+  /*  127 */ "cast_expression",
+  /*  128 */ "conditional_expression",
+  /*  129 */ "constant_expression",
+  /*  130 */ "equality_expression",
+  /*  131 */ "exclusive_or_expression",
+  /*  132 */ "inclusive_or_expression",
+  /*  133 */ "logical_and_expression",
+  /*  134 */ "logical_or_expression",
+  /*  135 */ "multiplicative_expression",
+  /*  136 */ "postfix_expression",
+  /*  137 */ "primary_expression",
+  /*  138 */ "relational_expression",
+  /*  139 */ "shift_expression",
+  /*  140 */ "unary_expression",
+  /*  141 */ "generic_selection",
+  /*  142 */ "opt_expression",
+  /*  143 */ "initializer",
+  /*  144 */ "argument_expression_list",
+  /*  145 */ "block_item_list",
+  /*  146 */ "declaration_list",
+  /*  147 */ "designator_list",
+  /*  148 */ "enumerator_list",
+  /*  149 */ "generic_assoc_list",
+  /*  150 */ "init_declarator_list",
+  /*  151 */ "initializer_list",
+  /*  152 */ "opt_declaration_list",
+  /*  153 */ "parameter_list",
+  /*  154 */ "parameter_type_list",
+  /*  155 */ "opt_parameter_type_list",
+  /*  156 */ "specifier_qualifier_list",
+  /*  157 */ "struct_declaration_list",
+  /*  158 */ "struct_declarator_list",
+  /*  159 */ "type_name",
+  /*  160 */ "assignment_operator",
+  /*  161 */ "unary_operator",
+  /*  162 */ "identifier_list",
+  /*  163 */ "opt_identifier",
+  /*  164 */ "opt_type_qualifier_list",
+  /*  165 */ "type_qualifier_list",
+  /*  166 */ "type_qualifier",
+  /*  167 */ "alignment_specifier",
+  /*  168 */ "enum_specifier",
+  /*  169 */ "function_specifier",
+  /*  170 */ "storage_class_specifier",
+  /*  171 */ "type_specifier",
+  /*  172 */ "struct_or_union_specifier",
+  /*  173 */ "declaration_specifiers",
+  /*  174 */ "opt_declaration_specifiers",
+  /*  175 */ "statement",
+  /*  176 */ "block_item",
+  /*  177 */ "compound_statement",
+  /*  178 */ "expression_statement",
+  /*  179 */ "iteration_statement",
+  /*  180 */ "jump_statement",
+  /*  181 */ "labeled_statement",
+  /*  182 */ "selection_statement",
+  /*  183 */ "opt_static",
+  /*  184 */ "string",
+  /*  185 */ "external_declaration_list",
+  /*  186 */ "translation_unit",
+  /*  187 */ "opt_comma",
+};
+#endif /* defined(YYCOVERAGE) || !defined(NDEBUG) */
+
+#ifndef NDEBUG
+/* For tracing reduce actions, the names of all rules are required.
+*/
+static const char *const yyRuleName[] = {
+ /*   0 */ "primary_expression ::= IDENTIFIER",
+ /*   1 */ "primary_expression ::= I_CONSTANT",
+ /*   2 */ "primary_expression ::= F_CONSTANT",
+ /*   3 */ "primary_expression ::= ENUMERATION_CONSTANT",
+ /*   4 */ "primary_expression ::= CHAR_CONSTANT",
+ /*   5 */ "primary_expression ::= string",
+ /*   6 */ "primary_expression ::= LPAREN expression RPAREN",
+ /*   7 */ "primary_expression ::= generic_selection",
+ /*   8 */ "enumeration_constant ::= IDENTIFIER",
+ /*   9 */ "string ::= STRING_LITERAL",
+ /*  10 */ "string ::= FUNC_NAME",
+ /*  11 */ "generic_selection ::= GENERIC LPAREN assignment_expression COMMA generic_assoc_list RPAREN",
+ /*  12 */ "generic_assoc_list ::= generic_association",
+ /*  13 */ "generic_assoc_list ::= generic_assoc_list COMMA generic_association",
+ /*  14 */ "generic_association ::= type_name COLON assignment_expression",
+ /*  15 */ "generic_association ::= DEFAULT COLON assignment_expression",
+ /*  16 */ "postfix_expression ::= primary_expression",
+ /*  17 */ "postfix_expression ::= postfix_expression LBRACKET expression RBRACKET",
+ /*  18 */ "postfix_expression ::= postfix_expression LPAREN RPAREN",
+ /*  19 */ "postfix_expression ::= postfix_expression LPAREN argument_expression_list RPAREN",
+ /*  20 */ "postfix_expression ::= postfix_expression PERIOD IDENTIFIER",
+ /*  21 */ "postfix_expression ::= postfix_expression POINTER_ACCESS IDENTIFIER",
+ /*  22 */ "postfix_expression ::= postfix_expression INCREMENT",
+ /*  23 */ "postfix_expression ::= postfix_expression DECREMENT",
+ /*  24 */ "postfix_expression ::= LPAREN type_name RPAREN LBRACE initializer_list optional_comma RBRACE",
+ /*  25 */ "argument_expression_list ::= assignment_expression",
+ /*  26 */ "argument_expression_list ::= argument_expression_list COMMA assignment_expression",
+ /*  27 */ "unary_expression ::= postfix_expression",
+ /*  28 */ "unary_expression ::= INC_OP unary_expression",
+ /*  29 */ "unary_expression ::= DEC_OP unary_expression",
+ /*  30 */ "unary_expression ::= unary_operator cast_expression",
+ /*  31 */ "unary_expression ::= SIZEOF unary_expression",
+ /*  32 */ "unary_expression ::= SIZEOF LPAREN type_name RPAREN",
+ /*  33 */ "unary_expression ::= ALIGNOF LPAREN type_name RPAREN",
+ /*  34 */ "unary_operator ::= AMPERSAND",
+ /*  35 */ "unary_operator ::= ASTERISK",
+ /*  36 */ "unary_operator ::= PLUS",
+ /*  37 */ "unary_operator ::= MINUS",
+ /*  38 */ "unary_operator ::= TILDE",
+ /*  39 */ "unary_operator ::= EXCLAMATION_POINT",
+ /*  40 */ "cast_expression ::= unary_expression",
+ /*  41 */ "cast_expression ::= LPAREN type_name RPAREN cast_expression",
+ /*  42 */ "multiplicative_expression ::= cast_expression",
+ /*  43 */ "multiplicative_expression ::= multiplicative_expression ASTERISK cast_expression",
+ /*  44 */ "multiplicative_expression ::= multiplicative_expression SLASH cast_expression",
+ /*  45 */ "multiplicative_expression ::= multiplicative_expression PERCENT cast_expression",
+ /*  46 */ "additive_expression ::= multiplicative_expression",
+ /*  47 */ "additive_expression ::= additive_expression PLUS multiplicative_expression",
+ /*  48 */ "additive_expression ::= additive_expression MINUS multiplicative_expression",
+ /*  49 */ "shift_expression ::= additive_expression",
+ /*  50 */ "shift_expression ::= shift_expression SHIFT_LEFT additive_expression",
+ /*  51 */ "shift_expression ::= shift_expression SHIFT_RIGHT additive_expression",
+ /*  52 */ "relational_expression ::= shift_expression",
+ /*  53 */ "relational_expression ::= relational_expression LESS_THAN shift_expression",
+ /*  54 */ "relational_expression ::= relational_expression GREATER_THAN shift_expression",
+ /*  55 */ "relational_expression ::= relational_expression LE shift_expression",
+ /*  56 */ "relational_expression ::= relational_expression GE shift_expression",
+ /*  57 */ "equality_expression ::= relational_expression",
+ /*  58 */ "equality_expression ::= equality_expression IS_EQUAL_TO relational_expression",
+ /*  59 */ "equality_expression ::= equality_expression NOT_EQUAL_TO relational_expression",
+ /*  60 */ "and_expression ::= equality_expression",
+ /*  61 */ "and_expression ::= and_expression AMPERSAND equality_expression",
+ /*  62 */ "exclusive_or_expression ::= and_expression",
+ /*  63 */ "exclusive_or_expression ::= exclusive_or_expression CARAT and_expression",
+ /*  64 */ "inclusive_or_expression ::= exclusive_or_expression",
+ /*  65 */ "inclusive_or_expression ::= inclusive_or_expression VERTICAL_BAR exclusive_or_expression",
+ /*  66 */ "logical_and_expression ::= inclusive_or_expression",
+ /*  67 */ "logical_and_expression ::= logical_and_expression LOGICAL_AND inclusive_or_expression",
+ /*  68 */ "logical_or_expression ::= logical_and_expression",
+ /*  69 */ "logical_or_expression ::= logical_or_expression LOGICAL_OR logical_and_expression",
+ /*  70 */ "conditional_expression ::= logical_or_expression",
+ /*  71 */ "conditional_expression ::= logical_or_expression QUESTION_MARK expression COLON conditional_expression",
+ /*  72 */ "assignment_expression ::= conditional_expression",
+ /*  73 */ "assignment_expression ::= unary_expression assignment_operator assignment_expression",
+ /*  74 */ "assignment_operator ::= EQUAL_SIGN",
+ /*  75 */ "assignment_operator ::= MULTIPLY_ASSIGN",
+ /*  76 */ "assignment_operator ::= DIVIDE_ASSIGN",
+ /*  77 */ "assignment_operator ::= REMAINDER_ASSIGN",
+ /*  78 */ "assignment_operator ::= ADD_ASSIGN",
+ /*  79 */ "assignment_operator ::= SUBTRACT_ASSIGN",
+ /*  80 */ "assignment_operator ::= SHIFT_LEFT_ASSIGN",
+ /*  81 */ "assignment_operator ::= SHIFT_RIGHT_ASSIGN",
+ /*  82 */ "assignment_operator ::= BITWISE_AND_ASSIGN",
+ /*  83 */ "assignment_operator ::= BITWISE_XOR_ASSIGN",
+ /*  84 */ "assignment_operator ::= BITWISE_OR_ASSIGN",
+ /*  85 */ "expression ::= assignment_expression",
+ /*  86 */ "expression ::= expression COMMA assignment_expression",
+ /*  87 */ "constant_expression ::= conditional_expression",
+ /*  88 */ "opt_expression ::= expression",
+ /*  89 */ "opt_expression ::=",
+ /*  90 */ "declaration ::= declaration_specifiers SEMICOLON",
+ /*  91 */ "declaration ::= declaration_specifiers init_declarator_list SEMICOLON",
+ /*  92 */ "declaration ::= static_assert_declaration",
+ /*  93 */ "opt_declaration_specifiers ::= declaration_specifiers",
+ /*  94 */ "opt_declaration_specifiers ::=",
+ /*  95 */ "declaration_specifiers ::= storage_class_specifier opt_declaration_specifiers",
+ /*  96 */ "declaration_specifiers ::= type_specifier opt_declaration_specifiers",
+ /*  97 */ "declaration_specifiers ::= type_qualifier opt_declaration_specifiers",
+ /*  98 */ "declaration_specifiers ::= alignment_specifier opt_declaration_specifiers",
+ /*  99 */ "declaration_specifiers ::= function_specifier",
+ /* 100 */ "init_declarator_list ::= init_declarator",
+ /* 101 */ "init_declarator_list ::= init_declarator_list COMMA init_declarator",
+ /* 102 */ "init_declarator ::= declarator EQUALS initializer",
+ /* 103 */ "init_declarator ::= declarator",
+ /* 104 */ "storage_class_specifier ::= TYPEDEF",
+ /* 105 */ "storage_class_specifier ::= EXTERN",
+ /* 106 */ "storage_class_specifier ::= STATIC",
+ /* 107 */ "storage_class_specifier ::= THREAD_LOCAL",
+ /* 108 */ "storage_class_specifier ::= AUTO",
+ /* 109 */ "storage_class_specifier ::= REGISTER",
+ /* 110 */ "type_specifier ::= VOID",
+ /* 111 */ "type_specifier ::= CHAR",
+ /* 112 */ "type_specifier ::= INT",
+ /* 113 */ "type_specifier ::= SHORT",
+ /* 114 */ "type_specifier ::= LONG",
+ /* 115 */ "type_specifier ::= FLOAT",
+ /* 116 */ "type_specifier ::= DOUBLE",
+ /* 117 */ "type_specifier ::= SIGNED",
+ /* 118 */ "type_specifier ::= UNSIGNED",
+ /* 119 */ "type_specifier ::= BOOL",
+ /* 120 */ "type_specifier ::= COMPLEX",
+ /* 121 */ "type_specifier ::= IMAGINARY",
+ /* 122 */ "type_specifier ::= ATOMIC LPAREN type_name RPAREN",
+ /* 123 */ "type_specifier ::= struct_or_union_specifier",
+ /* 124 */ "type_specifier ::= enum_specifier",
+ /* 125 */ "type_specifier ::= TYPEDEF_NAME",
+ /* 126 */ "struct_or_union_specifier ::= STRUCT IDENTIFIER",
+ /* 127 */ "struct_or_union_specifier ::= STRUCT opt_identifier LBRACE struct_declaration_list RBRACE",
+ /* 128 */ "struct_or_union_specifier ::= UNION IDENTIFIER",
+ /* 129 */ "struct_or_union_specifier ::= UNION opt_identifier LBRACE struct_declaration_list RBRACE",
+ /* 130 */ "struct_declaration_list ::= struct_declaration",
+ /* 131 */ "struct_declaration_list ::= struct_declaration_list struct_declaration",
+ /* 132 */ "struct_declaration ::= specifier_qualifier_list SEMICOLON",
+ /* 133 */ "struct_declaration ::= specifier_qualifier_list struct_declarator_list SEMICOLON",
+ /* 134 */ "struct_declaration ::= static_assert_declaration",
+ /* 135 */ "specifier_qualifier_list ::= type_specifier specifier_qualifier_list",
+ /* 136 */ "specifier_qualifier_list ::= type_specifier",
+ /* 137 */ "specifier_qualifier_list ::= type_qualifier specifier_qualifier_list",
+ /* 138 */ "specifier_qualifier_list ::= type_qualifier",
+ /* 139 */ "struct_declarator_list ::= struct_declarator",
+ /* 140 */ "struct_declarator_list ::= struct_declarator_list COMMA struct_declarator",
+ /* 141 */ "struct_declarator ::= COLON constant_expression",
+ /* 142 */ "struct_declarator ::= declarator COLON constant_expression",
+ /* 143 */ "struct_declarator ::= declarator",
+ /* 144 */ "enum_specifier ::= ENUM opt_identifier LBRACE enumerator_list opt_comma RBRACE",
+ /* 145 */ "opt_identifier ::=",
+ /* 146 */ "opt_identifier ::= IDENTIFIER",
+ /* 147 */ "enumerator_list ::= enumerator",
+ /* 148 */ "enumerator_list ::= enumerator_list COMMA enumerator",
+ /* 149 */ "enumerator ::= enumeration_constant EQUALS constant_expression",
+ /* 150 */ "enumerator ::= enumeration_constant",
+ /* 151 */ "type_qualifier ::= CONST",
+ /* 152 */ "type_qualifier ::= RESTRICT",
+ /* 153 */ "type_qualifier ::= VOLATILE",
+ /* 154 */ "type_qualifier ::= ATOMIC",
+ /* 155 */ "function_specifier ::= INLINE",
+ /* 156 */ "function_specifier ::= NORETURN",
+ /* 157 */ "alignment_specifier ::= ALIGNAS LPAREN type_name RPAREN",
+ /* 158 */ "alignment_specifier ::= ALIGNAS LPAREN constant_expression RPAREN",
+ /* 159 */ "declarator ::= pointer direct_declarator",
+ /* 160 */ "declarator ::= direct_declarator",
+ /* 161 */ "direct_declarator ::= IDENTIFIER",
+ /* 162 */ "direct_declarator ::= LPAREN declarator RPAREN",
+ /* 163 */ "direct_declarator ::= direct_declarator LBRACKET opt_type_qualifier_list RBRACKET",
+ /* 164 */ "direct_declarator ::= direct_declarator LBRACKET STATIC opt_type_qualifier_list assignment_expression RBRACKET",
+ /* 165 */ "direct_declarator ::= direct_declarator LBRACKET type_qualifier_list STATIC assignment_expression RBRACKET",
+ /* 166 */ "direct_declarator ::= direct_declarator LBRACKET opt_type_qualifier_list assignment_expression RBRACKET",
+ /* 167 */ "direct_declarator ::= direct_declarator LBRACKET opt_type_qualifier_list ASTERISK RBRACKET",
+ /* 168 */ "direct_declarator ::= direct_declarator LPAREN parameter_type_list RPAREN",
+ /* 169 */ "direct_declarator ::= direct_declarator LPAREN RPAREN",
+ /* 170 */ "direct_declarator ::= direct_declarator LPAREN identifier_list RPAREN",
+ /* 171 */ "pointer ::= ASTERISK opt_type_qualifier_list pointer",
+ /* 172 */ "pointer ::= ASTERISK opt_type_qualifier_list",
+ /* 173 */ "opt_type_qualifier_list ::=",
+ /* 174 */ "opt_type_qualifier_list ::= type_qualifier_list",
+ /* 175 */ "type_qualifier_list ::= type_qualifier",
+ /* 176 */ "type_qualifier_list ::= type_qualifier_list type_qualifier",
+ /* 177 */ "parameter_type_list ::= parameter_list COMMA ELLIPSIS",
+ /* 178 */ "parameter_type_list ::= parameter_list",
+ /* 179 */ "parameter_list ::= parameter_declaration",
+ /* 180 */ "parameter_list ::= parameter_list COMMA parameter_declaration",
+ /* 181 */ "parameter_declaration ::= declaration_specifiers declarator",
+ /* 182 */ "parameter_declaration ::= declaration_specifiers abstract_declarator",
+ /* 183 */ "parameter_declaration ::= declaration_specifiers",
+ /* 184 */ "opt_parameter_type_list ::= parameter_type_list",
+ /* 185 */ "opt_parameter_type_list ::=",
+ /* 186 */ "identifier_list ::= IDENTIFIER",
+ /* 187 */ "identifier_list ::= identifier_list COMMA IDENTIFIER",
+ /* 188 */ "type_name ::= specifier_qualifier_list abstract_declarator",
+ /* 189 */ "type_name ::= specifier_qualifier_list",
+ /* 190 */ "abstract_declarator ::= ASTERISK opt_type_qualifier_list abstract_declarator",
+ /* 191 */ "abstract_declarator ::= direct_abstract_declarator",
+ /* 192 */ "direct_abstract_declarator ::= LPAREN abstract_declarator RPAREN",
+ /* 193 */ "direct_abstract_declarator ::= LBRACKET opt_type_qualifier_list RBRACKET",
+ /* 194 */ "direct_abstract_declarator ::= LBRACKET opt_type_qualifier_list ASTERISK RBRACKET",
+ /* 195 */ "direct_abstract_declarator ::= LBRACKET STATIC opt_type_qualifier_list assignment_expression RBRACKET",
+ /* 196 */ "direct_abstract_declarator ::= LBRACKET type_qualifier_list STATIC assignment_expression RBRACKET",
+ /* 197 */ "direct_abstract_declarator ::= LBRACKET opt_type_qualifier_list assignment_expression RBRACKET",
+ /* 198 */ "direct_abstract_declarator ::= direct_abstract_declarator LBRACKET opt_type_qualifier_list RBRACKET",
+ /* 199 */ "direct_abstract_declarator ::= direct_abstract_declarator LBRACKET opt_type_qualifier_list assignment_expression RBRACKET",
+ /* 200 */ "direct_abstract_declarator ::= direct_abstract_declarator LBRACKET STATIC opt_type_qualifier_list assignment_expression RBRACKET",
+ /* 201 */ "direct_abstract_declarator ::= direct_abstract_declarator LBRACKET type_qualifier_list STATIC assignment_expression RBRACKET",
+ /* 202 */ "direct_abstract_declarator ::= direct_abstract_declarator opt_type_qualifier_list LBRACKET ASTERISK RBRACKET",
+ /* 203 */ "direct_abstract_declarator ::= LPAREN opt_parameter_type_list RPAREN",
+ /* 204 */ "direct_abstract_declarator ::= direct_abstract_declarator LPAREN opt_parameter_type_list RPAREN",
+ /* 205 */ "initializer ::= LBRACE initializer_list opt_comma RBRACE",
+ /* 206 */ "initializer ::= assignment_expression",
+ /* 207 */ "initializer_list ::= opt_designation initializer",
+ /* 208 */ "initializer_list ::= initializer_list COMMA opt_designation initializer",
+ /* 209 */ "opt_designation ::= designation",
+ /* 210 */ "opt_designation ::=",
+ /* 211 */ "designation ::= designator_list EQUALS",
+ /* 212 */ "designator_list ::= designator",
+ /* 213 */ "designator_list ::= designator_list designator",
+ /* 214 */ "designator ::= LBRACKET constant_expression RBRACKET",
+ /* 215 */ "designator ::= PERIOD IDENTIFIER",
+ /* 216 */ "static_assert_declaration ::= STATIC_ASSERT LPAREN constant_expression COMMA STRING_LITERAL RPAREN SEMICOLON",
+ /* 217 */ "statement ::= labeled_statement",
+ /* 218 */ "statement ::= compound_statement",
+ /* 219 */ "statement ::= expression_statement",
+ /* 220 */ "statement ::= selection_statement",
+ /* 221 */ "statement ::= iteration_statement",
+ /* 222 */ "statement ::= jump_statement",
+ /* 223 */ "labeled_statement ::= IDENTIFIER COLON statement",
+ /* 224 */ "labeled_statement ::= CASE constant_expression COLON statement",
+ /* 225 */ "labeled_statement ::= DEFAULT COLON statement",
+ /* 226 */ "compound_statement ::= LBRACE RBRACE",
+ /* 227 */ "compound_statement ::= LBRACE block_item_list RBRACE",
+ /* 228 */ "block_item_list ::= block_item",
+ /* 229 */ "block_item_list ::= block_item_list block_item",
+ /* 230 */ "block_item ::= declaration",
+ /* 231 */ "block_item ::= statement",
+ /* 232 */ "expression_statement ::= SEMICOLON",
+ /* 233 */ "expression_statement ::= expression SEMICOLON",
+ /* 234 */ "selection_statement ::= IF LPAREN expression RPAREN statement ELSE statement",
+ /* 235 */ "selection_statement ::= IF LPAREN expression RPAREN statement",
+ /* 236 */ "selection_statement ::= SWITCH LPAREN expression RPAREN statement",
+ /* 237 */ "iteration_statement ::= WHILE LPAREN expression RPAREN statement",
+ /* 238 */ "iteration_statement ::= DO statement WHILE LPAREN expression RPAREN SEMICOLON",
+ /* 239 */ "iteration_statement ::= FOR LPAREN expression_statement expression_statement opt_expression RPAREN statement",
+ /* 240 */ "iteration_statement ::= FOR LPAREN declaration expression_statement opt_expression RPAREN statement",
+ /* 241 */ "jump_statement ::= GOTO IDENTIFIER SEMICOLON",
+ /* 242 */ "jump_statement ::= CONTINUE SEMICOLON",
+ /* 243 */ "jump_statement ::= BREAK SEMICOLON",
+ /* 244 */ "jump_statement ::= RETURN SEMICOLON",
+ /* 245 */ "jump_statement ::= RETURN expression SEMICOLON",
+ /* 246 */ "external_declaration_list ::= external_declaration",
+ /* 247 */ "external_declaration_list ::= external_declaration_list external_declaration",
+ /* 248 */ "translation_unit ::= external_declaration_list",
+ /* 249 */ "external_declaration ::= function_definition",
+ /* 250 */ "external_declaration ::= declaration",
+ /* 251 */ "function_definition ::= declaration_specifiers declarator opt_declaration_list compound_statement",
+ /* 252 */ "declaration_list ::= declaration",
+ /* 253 */ "declaration_list ::= declaration_list declaration",
+ /* 254 */ "opt_declaration_list ::=",
+ /* 255 */ "opt_declaration_list ::= declaration_list",
+ /* 256 */ "optional_comma ::= COMMA",
+ /* 257 */ "optional_comma ::=",
+ /* 258 */ "opt_comma ::=",
+ /* 259 */ "opt_comma ::= COMMA",
+};
+#endif /* NDEBUG */
+
+
+#if YYSTACKDEPTH<=0
+/*
+** Try to increase the size of the parser stack.  Return the number
+** of errors.  Return 0 on success.
+*/
+static int yyGrowStack(yyParser *p){
+  int newSize;
+  int idx;
+  yyStackEntry *pNew;
+
+  newSize = p->yystksz*2 + 100;
+  idx = p->yytos ? (int)(p->yytos - p->yystack) : 0;
+  if( p->yystack==&p->yystk0 ){
+    pNew = malloc(newSize*sizeof(pNew[0]));
+    if( pNew ) pNew[0] = p->yystk0;
+  }else{
+    pNew = realloc(p->yystack, newSize*sizeof(pNew[0]));
+  }
+  if( pNew ){
+    p->yystack = pNew;
+    p->yytos = &p->yystack[idx];
+#ifndef NDEBUG
+    if( yyTraceFILE ){
+      fprintf(yyTraceFILE,"%sStack grows from %d to %d entries.\n",
+              yyTracePrompt, p->yystksz, newSize);
+    }
+#endif
+    p->yystksz = newSize;
+  }
+  return pNew==0; 
+}
+#endif
+
+/* Datatype of the argument to the memory allocated passed as the
+** second argument to DBCC_Lemon_ParserAlloc() below.  This can be changed by
+** putting an appropriate #define in the %include section of the input
+** grammar.
+*/
+#ifndef YYMALLOCARGTYPE
+# define YYMALLOCARGTYPE size_t
+#endif
+
+/* Initialize a new parser that has already been allocated.
+*/
+void DBCC_Lemon_ParserInit(void *yypParser){
+  yyParser *pParser = (yyParser*)yypParser;
+#ifdef YYTRACKMAXSTACKDEPTH
+  pParser->yyhwm = 0;
+#endif
+#if YYSTACKDEPTH<=0
+  pParser->yytos = NULL;
+  pParser->yystack = NULL;
+  pParser->yystksz = 0;
+  if( yyGrowStack(pParser) ){
+    pParser->yystack = &pParser->yystk0;
+    pParser->yystksz = 1;
+  }
+#endif
+#ifndef YYNOERRORRECOVERY
+  pParser->yyerrcnt = -1;
+#endif
+  pParser->yytos = pParser->yystack;
+  pParser->yystack[0].stateno = 0;
+  pParser->yystack[0].major = 0;
+#if YYSTACKDEPTH>0
+  pParser->yystackEnd = &pParser->yystack[YYSTACKDEPTH-1];
+#endif
+}
+
+#ifndef DBCC_Lemon_Parser_ENGINEALWAYSONSTACK
+/* 
+** This function allocates a new parser.
+** The only argument is a pointer to a function which works like
+** malloc.
+**
+** Inputs:
+** A pointer to the function used to allocate memory.
+**
+** Outputs:
+** A pointer to a parser.  This pointer is used in subsequent calls
+** to DBCC_Lemon_Parser and DBCC_Lemon_ParserFree.
+*/
+void *DBCC_Lemon_ParserAlloc(void *(*mallocProc)(YYMALLOCARGTYPE)){
+  yyParser *pParser;
+  pParser = (yyParser*)(*mallocProc)( (YYMALLOCARGTYPE)sizeof(yyParser) );
+  if( pParser ) DBCC_Lemon_ParserInit(pParser);
+  return pParser;
+}
+#endif /* DBCC_Lemon_Parser_ENGINEALWAYSONSTACK */
+
+
+/* The following function deletes the "minor type" or semantic value
+** associated with a symbol.  The symbol can be either a terminal
+** or nonterminal. "yymajor" is the symbol code, and "yypminor" is
+** a pointer to the value to be deleted.  The code used to do the 
+** deletions is derived from the %destructor and/or %token_destructor
+** directives of the input grammar.
+*/
+static void yy_destructor(
+  yyParser *yypParser,    /* The parser */
+  YYCODETYPE yymajor,     /* Type code for object to destroy */
+  YYMINORTYPE *yypminor   /* The object to be destroyed */
+){
+  DBCC_Lemon_ParserARG_FETCH;
+  switch( yymajor ){
+    /* Here is inserted the actions which take place when a
+    ** terminal or non-terminal is destroyed.  This can happen
+    ** when the symbol is popped from the stack during a
+    ** reduce or during error processing or when a parser is 
+    ** being destroyed before it is finished parsing.
+    **
+    ** Note: during a reduce, the only symbols destroyed are those
+    ** which appear on the RHS of the rule, but which are *not* used
+    ** inside the C code.
+    */
+/********* Begin destructor definitions ***************************************/
+    case 103: /* generic_association */
+{
+#line 1957 "dbcc-parser-p.lemon"
+p_generic_association_destroy((yypminor->yy260));
+#line 3446 "dbcc-parser-p.c"
+}
+      break;
+    case 106: /* declaration */
+    case 107: /* external_declaration */
+    case 108: /* parameter_declaration */
+    case 109: /* static_assert_declaration */
+    case 110: /* struct_declaration */
+    case 117: /* function_definition */
+    case 156: /* specifier_qualifier_list */
+    case 173: /* declaration_specifiers */
+    case 174: /* opt_declaration_specifiers */
+{
+#line 1958 "dbcc-parser-p.lemon"
+p_declaration_destroy((yypminor->yy212));
+#line 3461 "dbcc-parser-p.c"
+}
+      break;
+    case 111: /* declarator */
+    case 112: /* direct_abstract_declarator */
+    case 113: /* abstract_declarator */
+    case 114: /* direct_declarator */
+    case 115: /* init_declarator */
+    case 116: /* struct_declarator */
+{
+#line 1964 "dbcc-parser-p.lemon"
+p_declarator_destroy((yypminor->yy307));
+#line 3473 "dbcc-parser-p.c"
+}
+      break;
+    case 118: /* opt_designation */
+    case 119: /* designation */
+    case 147: /* designator_list */
+{
+#line 1972 "dbcc-parser-p.lemon"
+p_designator_list_clear(&(yypminor->yy304));
+#line 3482 "dbcc-parser-p.c"
+}
+      break;
+    case 120: /* designator */
+{
+#line 1974 "dbcc-parser-p.lemon"
+p_designator_destroy((yypminor->yy154));
+#line 3489 "dbcc-parser-p.c"
+}
+      break;
+    case 121: /* enumerator */
+{
+#line 1975 "dbcc-parser-p.lemon"
+free((yypminor->yy276));
+#line 3496 "dbcc-parser-p.c"
+}
+      break;
+    case 123: /* expression */
+    case 124: /* additive_expression */
+    case 125: /* and_expression */
+    case 126: /* assignment_expression */
+    case 127: /* cast_expression */
+    case 128: /* conditional_expression */
+    case 129: /* constant_expression */
+    case 130: /* equality_expression */
+    case 131: /* exclusive_or_expression */
+    case 132: /* inclusive_or_expression */
+    case 133: /* logical_and_expression */
+    case 134: /* logical_or_expression */
+    case 135: /* multiplicative_expression */
+    case 136: /* postfix_expression */
+    case 137: /* primary_expression */
+    case 138: /* relational_expression */
+    case 139: /* shift_expression */
+    case 140: /* unary_expression */
+    case 141: /* generic_selection */
+{
+#line 1977 "dbcc-parser-p.lemon"
+dbcc_expr_destroy((yypminor->yy101));
+#line 3521 "dbcc-parser-p.c"
+}
+      break;
+    case 142: /* opt_expression */
+{
+#line 1998 "dbcc-parser-p.lemon"
+if ((yypminor->yy101)) dbcc_expr_destroy((yypminor->yy101));
+#line 3528 "dbcc-parser-p.c"
+}
+      break;
+    case 143: /* initializer */
+{
+#line 2000 "dbcc-parser-p.lemon"
+p_initializer_destroy((yypminor->yy358));
+#line 3535 "dbcc-parser-p.c"
+}
+      break;
+    case 144: /* argument_expression_list */
+{
+#line 2001 "dbcc-parser-p.lemon"
+p_expr_list_clear(&(yypminor->yy308));
+#line 3542 "dbcc-parser-p.c"
+}
+      break;
+    case 145: /* block_item_list */
+    case 175: /* statement */
+    case 176: /* block_item */
+    case 177: /* compound_statement */
+    case 178: /* expression_statement */
+    case 179: /* iteration_statement */
+    case 180: /* jump_statement */
+    case 181: /* labeled_statement */
+    case 182: /* selection_statement */
+{
+#line 2002 "dbcc-parser-p.lemon"
+p_statement_list_clear(&(yypminor->yy245));
+#line 3557 "dbcc-parser-p.c"
+}
+      break;
+    case 146: /* declaration_list */
+    case 152: /* opt_declaration_list */
+    case 153: /* parameter_list */
+    case 157: /* struct_declaration_list */
+    case 185: /* external_declaration_list */
+{
+#line 2003 "dbcc-parser-p.lemon"
+p_declaration_list_clear(&(yypminor->yy234));
+#line 3568 "dbcc-parser-p.c"
+}
+      break;
+    case 148: /* enumerator_list */
+{
+#line 2005 "dbcc-parser-p.lemon"
+p_enumerator_list_clear(&(yypminor->yy34));
+#line 3575 "dbcc-parser-p.c"
+}
+      break;
+    case 149: /* generic_assoc_list */
+{
+#line 2006 "dbcc-parser-p.lemon"
+p_generic_association_list_clear(&(yypminor->yy2));
+#line 3582 "dbcc-parser-p.c"
+}
+      break;
+    case 150: /* init_declarator_list */
+    case 158: /* struct_declarator_list */
+{
+#line 2007 "dbcc-parser-p.lemon"
+p_declarator_list_clear(&(yypminor->yy217));
+#line 3590 "dbcc-parser-p.c"
+}
+      break;
+    case 151: /* initializer_list */
+{
+#line 2008 "dbcc-parser-p.lemon"
+p_initializer_list_clear(&(yypminor->yy116));
+#line 3597 "dbcc-parser-p.c"
+}
+      break;
+    case 154: /* parameter_type_list */
+{
+#line 2013 "dbcc-parser-p.lemon"
+p_parameter_list_clear(&(yypminor->yy293));
+#line 3604 "dbcc-parser-p.c"
+}
+      break;
+    case 159: /* type_name */
+    case 168: /* enum_specifier */
+    case 172: /* struct_or_union_specifier */
+{
+#line 2018 "dbcc-parser-p.lemon"
+dbcc_type_unref((yypminor->yy100));
+#line 3613 "dbcc-parser-p.c"
+}
+      break;
+    case 162: /* identifier_list */
+{
+#line 2019 "dbcc-parser-p.lemon"
+p_identifier_list_clear(&(yypminor->yy351));
+#line 3620 "dbcc-parser-p.c"
+}
+      break;
+    case 163: /* opt_identifier */
+{
+#line 2020 "dbcc-parser-p.lemon"
+
+#line 3627 "dbcc-parser-p.c"
+}
+      break;
+    case 167: /* alignment_specifier */
+{
+#line 2022 "dbcc-parser-p.lemon"
+p_alignment_specifier_destroy((yypminor->yy239));
+#line 3634 "dbcc-parser-p.c"
+}
+      break;
+    case 171: /* type_specifier */
+{
+#line 2024 "dbcc-parser-p.lemon"
+p_type_specifiers_clear(&(yypminor->yy335));
+#line 3641 "dbcc-parser-p.c"
+}
+      break;
+    case 184: /* string */
+{
+#line 2036 "dbcc-parser-p.lemon"
+dbcc_string_clear(&(yypminor->yy83));
+#line 3648 "dbcc-parser-p.c"
+}
+      break;
+    case 186: /* translation_unit */
+{
+#line 2038 "dbcc-parser-p.lemon"
+(void)context;
+                                           p_declaration_list_clear(&(yypminor->yy234));
+#line 3656 "dbcc-parser-p.c"
+}
+      break;
+/********* End destructor definitions *****************************************/
+    default:  break;   /* If no destructor action specified: do nothing */
+  }
+}
+
+/*
+** Pop the parser's stack once.
+**
+** If there is a destructor routine associated with the token which
+** is popped from the stack, then call it.
+*/
+static void yy_pop_parser_stack(yyParser *pParser){
+  yyStackEntry *yytos;
+  assert( pParser->yytos!=0 );
+  assert( pParser->yytos > pParser->yystack );
+  yytos = pParser->yytos--;
+#ifndef NDEBUG
+  if( yyTraceFILE ){
+    fprintf(yyTraceFILE,"%sPopping %s\n",
+      yyTracePrompt,
+      yyTokenName[yytos->major]);
+  }
+#endif
+  yy_destructor(pParser, yytos->major, &yytos->minor);
+}
+
+/*
+** Clear all secondary memory allocations from the parser
+*/
+void DBCC_Lemon_ParserFinalize(void *p){
+  yyParser *pParser = (yyParser*)p;
+  while( pParser->yytos>pParser->yystack ) yy_pop_parser_stack(pParser);
+#if YYSTACKDEPTH<=0
+  if( pParser->yystack!=&pParser->yystk0 ) free(pParser->yystack);
+#endif
+}
+
+#ifndef DBCC_Lemon_Parser_ENGINEALWAYSONSTACK
+/* 
+** Deallocate and destroy a parser.  Destructors are called for
+** all stack elements before shutting the parser down.
+**
+** If the YYPARSEFREENEVERNULL macro exists (for example because it
+** is defined in a %include section of the input grammar) then it is
+** assumed that the input pointer is never NULL.
+*/
+void DBCC_Lemon_ParserFree(
+  void *p,                    /* The parser to be deleted */
+  void (*freeProc)(void*)     /* Function used to reclaim memory */
+){
+#ifndef YYPARSEFREENEVERNULL
+  if( p==0 ) return;
+#endif
+  DBCC_Lemon_ParserFinalize(p);
+  (*freeProc)(p);
+}
+#endif /* DBCC_Lemon_Parser_ENGINEALWAYSONSTACK */
+
+/*
+** Return the peak depth of the stack for a parser.
+*/
+#ifdef YYTRACKMAXSTACKDEPTH
+int DBCC_Lemon_ParserStackPeak(void *p){
+  yyParser *pParser = (yyParser*)p;
+  return pParser->yyhwm;
+}
+#endif
+
+/* This array of booleans keeps track of the parser statement
+** coverage.  The element yycoverage[X][Y] is set when the parser
+** is in state X and has a lookahead token Y.  In a well-tested
+** systems, every element of this matrix should end up being set.
+*/
+#if defined(YYCOVERAGE)
+static unsigned char yycoverage[YYNSTATE][YYNTOKEN];
+#endif
+
+/*
+** Write into out a description of every state/lookahead combination that
+**
+**   (1)  has not been used by the parser, and
+**   (2)  is not a syntax error.
+**
+** Return the number of missed state/lookahead combinations.
+*/
+#if defined(YYCOVERAGE)
+int DBCC_Lemon_ParserCoverage(FILE *out){
+  int stateno, iLookAhead, i;
+  int nMissed = 0;
+  for(stateno=0; stateno<YYNSTATE; stateno++){
+    i = yy_shift_ofst[stateno];
+    for(iLookAhead=0; iLookAhead<YYNTOKEN; iLookAhead++){
+      if( yy_lookahead[i+iLookAhead]!=iLookAhead ) continue;
+      if( yycoverage[stateno][iLookAhead]==0 ) nMissed++;
+      if( out ){
+        fprintf(out,"State %d lookahead %s %s\n", stateno,
+                yyTokenName[iLookAhead],
+                yycoverage[stateno][iLookAhead] ? "ok" : "missed");
+      }
+    }
+  }
+  return nMissed;
+}
+#endif
+
+/*
+** Find the appropriate action for a parser given the terminal
+** look-ahead token iLookAhead.
+*/
+static unsigned int yy_find_shift_action(
+  yyParser *pParser,        /* The parser */
+  YYCODETYPE iLookAhead     /* The look-ahead token */
+){
+  int i;
+  int stateno = pParser->yytos->stateno;
+ 
+  if( stateno>YY_MAX_SHIFT ) return stateno;
+  assert( stateno <= YY_SHIFT_COUNT );
+#if defined(YYCOVERAGE)
+  yycoverage[stateno][iLookAhead] = 1;
+#endif
+  do{
+    i = yy_shift_ofst[stateno];
+    assert( i>=0 );
+    assert( (int)(i+YYNTOKEN)<=(int)(sizeof(yy_lookahead)/sizeof(yy_lookahead[0])) );
+    assert( iLookAhead!=YYNOCODE );
+    assert( iLookAhead < YYNTOKEN );
+    i += iLookAhead;
+    if( yy_lookahead[i]!=iLookAhead ){
+#ifdef YYFALLBACK
+      YYCODETYPE iFallback;            /* Fallback token */
+      if( iLookAhead<sizeof(yyFallback)/sizeof(yyFallback[0])
+             && (iFallback = yyFallback[iLookAhead])!=0 ){
+#ifndef NDEBUG
+        if( yyTraceFILE ){
+          fprintf(yyTraceFILE, "%sFALLBACK %s => %s\n",
+             yyTracePrompt, yyTokenName[iLookAhead], yyTokenName[iFallback]);
+        }
+#endif
+        assert( yyFallback[iFallback]==0 ); /* Fallback loop must terminate */
+        iLookAhead = iFallback;
+        continue;
+      }
+#endif
+#ifdef YYWILDCARD
+      {
+        int j = i - iLookAhead + YYWILDCARD;
+        if( 
+#if YY_SHIFT_MIN+YYWILDCARD<0
+          j>=0 &&
+#endif
+#if YY_SHIFT_MAX+YYWILDCARD>=YY_ACTTAB_COUNT
+          j<YY_ACTTAB_COUNT &&
+#endif
+          yy_lookahead[j]==YYWILDCARD && iLookAhead>0
+        ){
+#ifndef NDEBUG
+          if( yyTraceFILE ){
+            fprintf(yyTraceFILE, "%sWILDCARD %s => %s\n",
+               yyTracePrompt, yyTokenName[iLookAhead],
+               yyTokenName[YYWILDCARD]);
+          }
+#endif /* NDEBUG */
+          return yy_action[j];
+        }
+      }
+#endif /* YYWILDCARD */
+      return yy_default[stateno];
+    }else{
+      return yy_action[i];
+    }
+  }while(1);
+}
+
+/*
+** Find the appropriate action for a parser given the non-terminal
+** look-ahead token iLookAhead.
+*/
+static int yy_find_reduce_action(
+  int stateno,              /* Current state number */
+  YYCODETYPE iLookAhead     /* The look-ahead token */
+){
+  int i;
+#ifdef YYERRORSYMBOL
+  if( stateno>YY_REDUCE_COUNT ){
+    return yy_default[stateno];
+  }
+#else
+  assert( stateno<=YY_REDUCE_COUNT );
+#endif
+  i = yy_reduce_ofst[stateno];
+  assert( iLookAhead!=YYNOCODE );
+  i += iLookAhead;
+#ifdef YYERRORSYMBOL
+  if( i<0 || i>=YY_ACTTAB_COUNT || yy_lookahead[i]!=iLookAhead ){
+    return yy_default[stateno];
+  }
+#else
+  assert( i>=0 && i<YY_ACTTAB_COUNT );
+  assert( yy_lookahead[i]==iLookAhead );
+#endif
+  return yy_action[i];
+}
+
+/*
+** The following routine is called if the stack overflows.
+*/
+static void yyStackOverflow(yyParser *yypParser){
+   DBCC_Lemon_ParserARG_FETCH;
+#ifndef NDEBUG
+   if( yyTraceFILE ){
+     fprintf(yyTraceFILE,"%sStack Overflow!\n",yyTracePrompt);
+   }
+#endif
+   while( yypParser->yytos>yypParser->yystack ) yy_pop_parser_stack(yypParser);
+   /* Here code is inserted which will execute if the parser
+   ** stack every overflows */
+/******** Begin %stack_overflow code ******************************************/
+/******** End %stack_overflow code ********************************************/
+   DBCC_Lemon_ParserARG_STORE; /* Suppress warning about unused %extra_argument var */
+}
+
+/*
+** Print tracing information for a SHIFT action
+*/
+#ifndef NDEBUG
+static void yyTraceShift(yyParser *yypParser, int yyNewState, const char *zTag){
+  if( yyTraceFILE ){
+    if( yyNewState<YYNSTATE ){
+      fprintf(yyTraceFILE,"%s%s '%s', go to state %d\n",
+         yyTracePrompt, zTag, yyTokenName[yypParser->yytos->major],
+         yyNewState);
+    }else{
+      fprintf(yyTraceFILE,"%s%s '%s', pending reduce %d\n",
+         yyTracePrompt, zTag, yyTokenName[yypParser->yytos->major],
+         yyNewState - YY_MIN_REDUCE);
+    }
+  }
+}
+#else
+# define yyTraceShift(X,Y,Z)
+#endif
+
+/*
+** Perform a shift action.
+*/
+static void yy_shift(
+  yyParser *yypParser,          /* The parser to be shifted */
+  int yyNewState,               /* The new state to shift in */
+  int yyMajor,                  /* The major token to shift in */
+  DBCC_Lemon_ParserTOKENTYPE yyMinor        /* The minor token to shift in */
+){
+  yyStackEntry *yytos;
+  yypParser->yytos++;
+#ifdef YYTRACKMAXSTACKDEPTH
+  if( (int)(yypParser->yytos - yypParser->yystack)>yypParser->yyhwm ){
+    yypParser->yyhwm++;
+    assert( yypParser->yyhwm == (int)(yypParser->yytos - yypParser->yystack) );
+  }
+#endif
+#if YYSTACKDEPTH>0 
+  if( yypParser->yytos>yypParser->yystackEnd ){
+    yypParser->yytos--;
+    yyStackOverflow(yypParser);
+    return;
+  }
+#else
+  if( yypParser->yytos>=&yypParser->yystack[yypParser->yystksz] ){
+    if( yyGrowStack(yypParser) ){
+      yypParser->yytos--;
+      yyStackOverflow(yypParser);
+      return;
+    }
+  }
+#endif
+  if( yyNewState > YY_MAX_SHIFT ){
+    yyNewState += YY_MIN_REDUCE - YY_MIN_SHIFTREDUCE;
+  }
+  yytos = yypParser->yytos;
+  yytos->stateno = (YYACTIONTYPE)yyNewState;
+  yytos->major = (YYCODETYPE)yyMajor;
+  yytos->minor.yy0 = yyMinor;
+  yyTraceShift(yypParser, yyNewState, "Shift");
+}
+
+/* The following table contains information about every rule that
+** is used during the reduce.
+*/
+static const struct {
+  YYCODETYPE lhs;       /* Symbol on the left-hand side of the rule */
+  signed char nrhs;     /* Negative of the number of RHS symbols in the rule */
+} yyRuleInfo[] = {
+  {  137,   -1 }, /* (0) primary_expression ::= IDENTIFIER */
+  {  137,   -1 }, /* (1) primary_expression ::= I_CONSTANT */
+  {  137,   -1 }, /* (2) primary_expression ::= F_CONSTANT */
+  {  137,   -1 }, /* (3) primary_expression ::= ENUMERATION_CONSTANT */
+  {  137,   -1 }, /* (4) primary_expression ::= CHAR_CONSTANT */
+  {  137,   -1 }, /* (5) primary_expression ::= string */
+  {  137,   -3 }, /* (6) primary_expression ::= LPAREN expression RPAREN */
+  {  137,   -1 }, /* (7) primary_expression ::= generic_selection */
+  {  105,   -1 }, /* (8) enumeration_constant ::= IDENTIFIER */
+  {  184,   -1 }, /* (9) string ::= STRING_LITERAL */
+  {  184,   -1 }, /* (10) string ::= FUNC_NAME */
+  {  141,   -6 }, /* (11) generic_selection ::= GENERIC LPAREN assignment_expression COMMA generic_assoc_list RPAREN */
+  {  149,   -1 }, /* (12) generic_assoc_list ::= generic_association */
+  {  149,   -3 }, /* (13) generic_assoc_list ::= generic_assoc_list COMMA generic_association */
+  {  103,   -3 }, /* (14) generic_association ::= type_name COLON assignment_expression */
+  {  103,   -3 }, /* (15) generic_association ::= DEFAULT COLON assignment_expression */
+  {  136,   -1 }, /* (16) postfix_expression ::= primary_expression */
+  {  136,   -4 }, /* (17) postfix_expression ::= postfix_expression LBRACKET expression RBRACKET */
+  {  136,   -3 }, /* (18) postfix_expression ::= postfix_expression LPAREN RPAREN */
+  {  136,   -4 }, /* (19) postfix_expression ::= postfix_expression LPAREN argument_expression_list RPAREN */
+  {  136,   -3 }, /* (20) postfix_expression ::= postfix_expression PERIOD IDENTIFIER */
+  {  136,   -3 }, /* (21) postfix_expression ::= postfix_expression POINTER_ACCESS IDENTIFIER */
+  {  136,   -2 }, /* (22) postfix_expression ::= postfix_expression INCREMENT */
+  {  136,   -2 }, /* (23) postfix_expression ::= postfix_expression DECREMENT */
+  {  136,   -7 }, /* (24) postfix_expression ::= LPAREN type_name RPAREN LBRACE initializer_list optional_comma RBRACE */
+  {  144,   -1 }, /* (25) argument_expression_list ::= assignment_expression */
+  {  144,   -3 }, /* (26) argument_expression_list ::= argument_expression_list COMMA assignment_expression */
+  {  140,   -1 }, /* (27) unary_expression ::= postfix_expression */
+  {  140,   -2 }, /* (28) unary_expression ::= INC_OP unary_expression */
+  {  140,   -2 }, /* (29) unary_expression ::= DEC_OP unary_expression */
+  {  140,   -2 }, /* (30) unary_expression ::= unary_operator cast_expression */
+  {  140,   -2 }, /* (31) unary_expression ::= SIZEOF unary_expression */
+  {  140,   -4 }, /* (32) unary_expression ::= SIZEOF LPAREN type_name RPAREN */
+  {  140,   -4 }, /* (33) unary_expression ::= ALIGNOF LPAREN type_name RPAREN */
+  {  161,   -1 }, /* (34) unary_operator ::= AMPERSAND */
+  {  161,   -1 }, /* (35) unary_operator ::= ASTERISK */
+  {  161,   -1 }, /* (36) unary_operator ::= PLUS */
+  {  161,   -1 }, /* (37) unary_operator ::= MINUS */
+  {  161,   -1 }, /* (38) unary_operator ::= TILDE */
+  {  161,   -1 }, /* (39) unary_operator ::= EXCLAMATION_POINT */
+  {  127,   -1 }, /* (40) cast_expression ::= unary_expression */
+  {  127,   -4 }, /* (41) cast_expression ::= LPAREN type_name RPAREN cast_expression */
+  {  135,   -1 }, /* (42) multiplicative_expression ::= cast_expression */
+  {  135,   -3 }, /* (43) multiplicative_expression ::= multiplicative_expression ASTERISK cast_expression */
+  {  135,   -3 }, /* (44) multiplicative_expression ::= multiplicative_expression SLASH cast_expression */
+  {  135,   -3 }, /* (45) multiplicative_expression ::= multiplicative_expression PERCENT cast_expression */
+  {  124,   -1 }, /* (46) additive_expression ::= multiplicative_expression */
+  {  124,   -3 }, /* (47) additive_expression ::= additive_expression PLUS multiplicative_expression */
+  {  124,   -3 }, /* (48) additive_expression ::= additive_expression MINUS multiplicative_expression */
+  {  139,   -1 }, /* (49) shift_expression ::= additive_expression */
+  {  139,   -3 }, /* (50) shift_expression ::= shift_expression SHIFT_LEFT additive_expression */
+  {  139,   -3 }, /* (51) shift_expression ::= shift_expression SHIFT_RIGHT additive_expression */
+  {  138,   -1 }, /* (52) relational_expression ::= shift_expression */
+  {  138,   -3 }, /* (53) relational_expression ::= relational_expression LESS_THAN shift_expression */
+  {  138,   -3 }, /* (54) relational_expression ::= relational_expression GREATER_THAN shift_expression */
+  {  138,   -3 }, /* (55) relational_expression ::= relational_expression LE shift_expression */
+  {  138,   -3 }, /* (56) relational_expression ::= relational_expression GE shift_expression */
+  {  130,   -1 }, /* (57) equality_expression ::= relational_expression */
+  {  130,   -3 }, /* (58) equality_expression ::= equality_expression IS_EQUAL_TO relational_expression */
+  {  130,   -3 }, /* (59) equality_expression ::= equality_expression NOT_EQUAL_TO relational_expression */
+  {  125,   -1 }, /* (60) and_expression ::= equality_expression */
+  {  125,   -3 }, /* (61) and_expression ::= and_expression AMPERSAND equality_expression */
+  {  131,   -1 }, /* (62) exclusive_or_expression ::= and_expression */
+  {  131,   -3 }, /* (63) exclusive_or_expression ::= exclusive_or_expression CARAT and_expression */
+  {  132,   -1 }, /* (64) inclusive_or_expression ::= exclusive_or_expression */
+  {  132,   -3 }, /* (65) inclusive_or_expression ::= inclusive_or_expression VERTICAL_BAR exclusive_or_expression */
+  {  133,   -1 }, /* (66) logical_and_expression ::= inclusive_or_expression */
+  {  133,   -3 }, /* (67) logical_and_expression ::= logical_and_expression LOGICAL_AND inclusive_or_expression */
+  {  134,   -1 }, /* (68) logical_or_expression ::= logical_and_expression */
+  {  134,   -3 }, /* (69) logical_or_expression ::= logical_or_expression LOGICAL_OR logical_and_expression */
+  {  128,   -1 }, /* (70) conditional_expression ::= logical_or_expression */
+  {  128,   -5 }, /* (71) conditional_expression ::= logical_or_expression QUESTION_MARK expression COLON conditional_expression */
+  {  126,   -1 }, /* (72) assignment_expression ::= conditional_expression */
+  {  126,   -3 }, /* (73) assignment_expression ::= unary_expression assignment_operator assignment_expression */
+  {  160,   -1 }, /* (74) assignment_operator ::= EQUAL_SIGN */
+  {  160,   -1 }, /* (75) assignment_operator ::= MULTIPLY_ASSIGN */
+  {  160,   -1 }, /* (76) assignment_operator ::= DIVIDE_ASSIGN */
+  {  160,   -1 }, /* (77) assignment_operator ::= REMAINDER_ASSIGN */
+  {  160,   -1 }, /* (78) assignment_operator ::= ADD_ASSIGN */
+  {  160,   -1 }, /* (79) assignment_operator ::= SUBTRACT_ASSIGN */
+  {  160,   -1 }, /* (80) assignment_operator ::= SHIFT_LEFT_ASSIGN */
+  {  160,   -1 }, /* (81) assignment_operator ::= SHIFT_RIGHT_ASSIGN */
+  {  160,   -1 }, /* (82) assignment_operator ::= BITWISE_AND_ASSIGN */
+  {  160,   -1 }, /* (83) assignment_operator ::= BITWISE_XOR_ASSIGN */
+  {  160,   -1 }, /* (84) assignment_operator ::= BITWISE_OR_ASSIGN */
+  {  123,   -1 }, /* (85) expression ::= assignment_expression */
+  {  123,   -3 }, /* (86) expression ::= expression COMMA assignment_expression */
+  {  129,   -1 }, /* (87) constant_expression ::= conditional_expression */
+  {  142,   -1 }, /* (88) opt_expression ::= expression */
+  {  142,    0 }, /* (89) opt_expression ::= */
+  {  106,   -2 }, /* (90) declaration ::= declaration_specifiers SEMICOLON */
+  {  106,   -3 }, /* (91) declaration ::= declaration_specifiers init_declarator_list SEMICOLON */
+  {  106,   -1 }, /* (92) declaration ::= static_assert_declaration */
+  {  174,   -1 }, /* (93) opt_declaration_specifiers ::= declaration_specifiers */
+  {  174,    0 }, /* (94) opt_declaration_specifiers ::= */
+  {  173,   -2 }, /* (95) declaration_specifiers ::= storage_class_specifier opt_declaration_specifiers */
+  {  173,   -2 }, /* (96) declaration_specifiers ::= type_specifier opt_declaration_specifiers */
+  {  173,   -2 }, /* (97) declaration_specifiers ::= type_qualifier opt_declaration_specifiers */
+  {  173,   -2 }, /* (98) declaration_specifiers ::= alignment_specifier opt_declaration_specifiers */
+  {  173,   -1 }, /* (99) declaration_specifiers ::= function_specifier */
+  {  150,   -1 }, /* (100) init_declarator_list ::= init_declarator */
+  {  150,   -3 }, /* (101) init_declarator_list ::= init_declarator_list COMMA init_declarator */
+  {  115,   -3 }, /* (102) init_declarator ::= declarator EQUALS initializer */
+  {  115,   -1 }, /* (103) init_declarator ::= declarator */
+  {  170,   -1 }, /* (104) storage_class_specifier ::= TYPEDEF */
+  {  170,   -1 }, /* (105) storage_class_specifier ::= EXTERN */
+  {  170,   -1 }, /* (106) storage_class_specifier ::= STATIC */
+  {  170,   -1 }, /* (107) storage_class_specifier ::= THREAD_LOCAL */
+  {  170,   -1 }, /* (108) storage_class_specifier ::= AUTO */
+  {  170,   -1 }, /* (109) storage_class_specifier ::= REGISTER */
+  {  171,   -1 }, /* (110) type_specifier ::= VOID */
+  {  171,   -1 }, /* (111) type_specifier ::= CHAR */
+  {  171,   -1 }, /* (112) type_specifier ::= INT */
+  {  171,   -1 }, /* (113) type_specifier ::= SHORT */
+  {  171,   -1 }, /* (114) type_specifier ::= LONG */
+  {  171,   -1 }, /* (115) type_specifier ::= FLOAT */
+  {  171,   -1 }, /* (116) type_specifier ::= DOUBLE */
+  {  171,   -1 }, /* (117) type_specifier ::= SIGNED */
+  {  171,   -1 }, /* (118) type_specifier ::= UNSIGNED */
+  {  171,   -1 }, /* (119) type_specifier ::= BOOL */
+  {  171,   -1 }, /* (120) type_specifier ::= COMPLEX */
+  {  171,   -1 }, /* (121) type_specifier ::= IMAGINARY */
+  {  171,   -4 }, /* (122) type_specifier ::= ATOMIC LPAREN type_name RPAREN */
+  {  171,   -1 }, /* (123) type_specifier ::= struct_or_union_specifier */
+  {  171,   -1 }, /* (124) type_specifier ::= enum_specifier */
+  {  171,   -1 }, /* (125) type_specifier ::= TYPEDEF_NAME */
+  {  172,   -2 }, /* (126) struct_or_union_specifier ::= STRUCT IDENTIFIER */
+  {  172,   -5 }, /* (127) struct_or_union_specifier ::= STRUCT opt_identifier LBRACE struct_declaration_list RBRACE */
+  {  172,   -2 }, /* (128) struct_or_union_specifier ::= UNION IDENTIFIER */
+  {  172,   -5 }, /* (129) struct_or_union_specifier ::= UNION opt_identifier LBRACE struct_declaration_list RBRACE */
+  {  157,   -1 }, /* (130) struct_declaration_list ::= struct_declaration */
+  {  157,   -2 }, /* (131) struct_declaration_list ::= struct_declaration_list struct_declaration */
+  {  110,   -2 }, /* (132) struct_declaration ::= specifier_qualifier_list SEMICOLON */
+  {  110,   -3 }, /* (133) struct_declaration ::= specifier_qualifier_list struct_declarator_list SEMICOLON */
+  {  110,   -1 }, /* (134) struct_declaration ::= static_assert_declaration */
+  {  156,   -2 }, /* (135) specifier_qualifier_list ::= type_specifier specifier_qualifier_list */
+  {  156,   -1 }, /* (136) specifier_qualifier_list ::= type_specifier */
+  {  156,   -2 }, /* (137) specifier_qualifier_list ::= type_qualifier specifier_qualifier_list */
+  {  156,   -1 }, /* (138) specifier_qualifier_list ::= type_qualifier */
+  {  158,   -1 }, /* (139) struct_declarator_list ::= struct_declarator */
+  {  158,   -3 }, /* (140) struct_declarator_list ::= struct_declarator_list COMMA struct_declarator */
+  {  116,   -2 }, /* (141) struct_declarator ::= COLON constant_expression */
+  {  116,   -3 }, /* (142) struct_declarator ::= declarator COLON constant_expression */
+  {  116,   -1 }, /* (143) struct_declarator ::= declarator */
+  {  168,   -6 }, /* (144) enum_specifier ::= ENUM opt_identifier LBRACE enumerator_list opt_comma RBRACE */
+  {  163,    0 }, /* (145) opt_identifier ::= */
+  {  163,   -1 }, /* (146) opt_identifier ::= IDENTIFIER */
+  {  148,   -1 }, /* (147) enumerator_list ::= enumerator */
+  {  148,   -3 }, /* (148) enumerator_list ::= enumerator_list COMMA enumerator */
+  {  121,   -3 }, /* (149) enumerator ::= enumeration_constant EQUALS constant_expression */
+  {  121,   -1 }, /* (150) enumerator ::= enumeration_constant */
+  {  166,   -1 }, /* (151) type_qualifier ::= CONST */
+  {  166,   -1 }, /* (152) type_qualifier ::= RESTRICT */
+  {  166,   -1 }, /* (153) type_qualifier ::= VOLATILE */
+  {  166,   -1 }, /* (154) type_qualifier ::= ATOMIC */
+  {  169,   -1 }, /* (155) function_specifier ::= INLINE */
+  {  169,   -1 }, /* (156) function_specifier ::= NORETURN */
+  {  167,   -4 }, /* (157) alignment_specifier ::= ALIGNAS LPAREN type_name RPAREN */
+  {  167,   -4 }, /* (158) alignment_specifier ::= ALIGNAS LPAREN constant_expression RPAREN */
+  {  111,   -2 }, /* (159) declarator ::= pointer direct_declarator */
+  {  111,   -1 }, /* (160) declarator ::= direct_declarator */
+  {  114,   -1 }, /* (161) direct_declarator ::= IDENTIFIER */
+  {  114,   -3 }, /* (162) direct_declarator ::= LPAREN declarator RPAREN */
+  {  114,   -4 }, /* (163) direct_declarator ::= direct_declarator LBRACKET opt_type_qualifier_list RBRACKET */
+  {  114,   -6 }, /* (164) direct_declarator ::= direct_declarator LBRACKET STATIC opt_type_qualifier_list assignment_expression RBRACKET */
+  {  114,   -6 }, /* (165) direct_declarator ::= direct_declarator LBRACKET type_qualifier_list STATIC assignment_expression RBRACKET */
+  {  114,   -5 }, /* (166) direct_declarator ::= direct_declarator LBRACKET opt_type_qualifier_list assignment_expression RBRACKET */
+  {  114,   -5 }, /* (167) direct_declarator ::= direct_declarator LBRACKET opt_type_qualifier_list ASTERISK RBRACKET */
+  {  114,   -4 }, /* (168) direct_declarator ::= direct_declarator LPAREN parameter_type_list RPAREN */
+  {  114,   -3 }, /* (169) direct_declarator ::= direct_declarator LPAREN RPAREN */
+  {  114,   -4 }, /* (170) direct_declarator ::= direct_declarator LPAREN identifier_list RPAREN */
+  {  122,   -3 }, /* (171) pointer ::= ASTERISK opt_type_qualifier_list pointer */
+  {  122,   -2 }, /* (172) pointer ::= ASTERISK opt_type_qualifier_list */
+  {  164,    0 }, /* (173) opt_type_qualifier_list ::= */
+  {  164,   -1 }, /* (174) opt_type_qualifier_list ::= type_qualifier_list */
+  {  165,   -1 }, /* (175) type_qualifier_list ::= type_qualifier */
+  {  165,   -2 }, /* (176) type_qualifier_list ::= type_qualifier_list type_qualifier */
+  {  154,   -3 }, /* (177) parameter_type_list ::= parameter_list COMMA ELLIPSIS */
+  {  154,   -1 }, /* (178) parameter_type_list ::= parameter_list */
+  {  153,   -1 }, /* (179) parameter_list ::= parameter_declaration */
+  {  153,   -3 }, /* (180) parameter_list ::= parameter_list COMMA parameter_declaration */
+  {  108,   -2 }, /* (181) parameter_declaration ::= declaration_specifiers declarator */
+  {  108,   -2 }, /* (182) parameter_declaration ::= declaration_specifiers abstract_declarator */
+  {  108,   -1 }, /* (183) parameter_declaration ::= declaration_specifiers */
+  {  155,   -1 }, /* (184) opt_parameter_type_list ::= parameter_type_list */
+  {  155,    0 }, /* (185) opt_parameter_type_list ::= */
+  {  162,   -1 }, /* (186) identifier_list ::= IDENTIFIER */
+  {  162,   -3 }, /* (187) identifier_list ::= identifier_list COMMA IDENTIFIER */
+  {  159,   -2 }, /* (188) type_name ::= specifier_qualifier_list abstract_declarator */
+  {  159,   -1 }, /* (189) type_name ::= specifier_qualifier_list */
+  {  113,   -3 }, /* (190) abstract_declarator ::= ASTERISK opt_type_qualifier_list abstract_declarator */
+  {  113,   -1 }, /* (191) abstract_declarator ::= direct_abstract_declarator */
+  {  112,   -3 }, /* (192) direct_abstract_declarator ::= LPAREN abstract_declarator RPAREN */
+  {  112,   -3 }, /* (193) direct_abstract_declarator ::= LBRACKET opt_type_qualifier_list RBRACKET */
+  {  112,   -4 }, /* (194) direct_abstract_declarator ::= LBRACKET opt_type_qualifier_list ASTERISK RBRACKET */
+  {  112,   -5 }, /* (195) direct_abstract_declarator ::= LBRACKET STATIC opt_type_qualifier_list assignment_expression RBRACKET */
+  {  112,   -5 }, /* (196) direct_abstract_declarator ::= LBRACKET type_qualifier_list STATIC assignment_expression RBRACKET */
+  {  112,   -4 }, /* (197) direct_abstract_declarator ::= LBRACKET opt_type_qualifier_list assignment_expression RBRACKET */
+  {  112,   -4 }, /* (198) direct_abstract_declarator ::= direct_abstract_declarator LBRACKET opt_type_qualifier_list RBRACKET */
+  {  112,   -5 }, /* (199) direct_abstract_declarator ::= direct_abstract_declarator LBRACKET opt_type_qualifier_list assignment_expression RBRACKET */
+  {  112,   -6 }, /* (200) direct_abstract_declarator ::= direct_abstract_declarator LBRACKET STATIC opt_type_qualifier_list assignment_expression RBRACKET */
+  {  112,   -6 }, /* (201) direct_abstract_declarator ::= direct_abstract_declarator LBRACKET type_qualifier_list STATIC assignment_expression RBRACKET */
+  {  112,   -5 }, /* (202) direct_abstract_declarator ::= direct_abstract_declarator opt_type_qualifier_list LBRACKET ASTERISK RBRACKET */
+  {  112,   -3 }, /* (203) direct_abstract_declarator ::= LPAREN opt_parameter_type_list RPAREN */
+  {  112,   -4 }, /* (204) direct_abstract_declarator ::= direct_abstract_declarator LPAREN opt_parameter_type_list RPAREN */
+  {  143,   -4 }, /* (205) initializer ::= LBRACE initializer_list opt_comma RBRACE */
+  {  143,   -1 }, /* (206) initializer ::= assignment_expression */
+  {  151,   -2 }, /* (207) initializer_list ::= opt_designation initializer */
+  {  151,   -4 }, /* (208) initializer_list ::= initializer_list COMMA opt_designation initializer */
+  {  118,   -1 }, /* (209) opt_designation ::= designation */
+  {  118,    0 }, /* (210) opt_designation ::= */
+  {  119,   -2 }, /* (211) designation ::= designator_list EQUALS */
+  {  147,   -1 }, /* (212) designator_list ::= designator */
+  {  147,   -2 }, /* (213) designator_list ::= designator_list designator */
+  {  120,   -3 }, /* (214) designator ::= LBRACKET constant_expression RBRACKET */
+  {  120,   -2 }, /* (215) designator ::= PERIOD IDENTIFIER */
+  {  109,   -7 }, /* (216) static_assert_declaration ::= STATIC_ASSERT LPAREN constant_expression COMMA STRING_LITERAL RPAREN SEMICOLON */
+  {  175,   -1 }, /* (217) statement ::= labeled_statement */
+  {  175,   -1 }, /* (218) statement ::= compound_statement */
+  {  175,   -1 }, /* (219) statement ::= expression_statement */
+  {  175,   -1 }, /* (220) statement ::= selection_statement */
+  {  175,   -1 }, /* (221) statement ::= iteration_statement */
+  {  175,   -1 }, /* (222) statement ::= jump_statement */
+  {  181,   -3 }, /* (223) labeled_statement ::= IDENTIFIER COLON statement */
+  {  181,   -4 }, /* (224) labeled_statement ::= CASE constant_expression COLON statement */
+  {  181,   -3 }, /* (225) labeled_statement ::= DEFAULT COLON statement */
+  {  177,   -2 }, /* (226) compound_statement ::= LBRACE RBRACE */
+  {  177,   -3 }, /* (227) compound_statement ::= LBRACE block_item_list RBRACE */
+  {  145,   -1 }, /* (228) block_item_list ::= block_item */
+  {  145,   -2 }, /* (229) block_item_list ::= block_item_list block_item */
+  {  176,   -1 }, /* (230) block_item ::= declaration */
+  {  176,   -1 }, /* (231) block_item ::= statement */
+  {  178,   -1 }, /* (232) expression_statement ::= SEMICOLON */
+  {  178,   -2 }, /* (233) expression_statement ::= expression SEMICOLON */
+  {  182,   -7 }, /* (234) selection_statement ::= IF LPAREN expression RPAREN statement ELSE statement */
+  {  182,   -5 }, /* (235) selection_statement ::= IF LPAREN expression RPAREN statement */
+  {  182,   -5 }, /* (236) selection_statement ::= SWITCH LPAREN expression RPAREN statement */
+  {  179,   -5 }, /* (237) iteration_statement ::= WHILE LPAREN expression RPAREN statement */
+  {  179,   -7 }, /* (238) iteration_statement ::= DO statement WHILE LPAREN expression RPAREN SEMICOLON */
+  {  179,   -7 }, /* (239) iteration_statement ::= FOR LPAREN expression_statement expression_statement opt_expression RPAREN statement */
+  {  179,   -7 }, /* (240) iteration_statement ::= FOR LPAREN declaration expression_statement opt_expression RPAREN statement */
+  {  180,   -3 }, /* (241) jump_statement ::= GOTO IDENTIFIER SEMICOLON */
+  {  180,   -2 }, /* (242) jump_statement ::= CONTINUE SEMICOLON */
+  {  180,   -2 }, /* (243) jump_statement ::= BREAK SEMICOLON */
+  {  180,   -2 }, /* (244) jump_statement ::= RETURN SEMICOLON */
+  {  180,   -3 }, /* (245) jump_statement ::= RETURN expression SEMICOLON */
+  {  185,   -1 }, /* (246) external_declaration_list ::= external_declaration */
+  {  185,   -2 }, /* (247) external_declaration_list ::= external_declaration_list external_declaration */
+  {  186,   -1 }, /* (248) translation_unit ::= external_declaration_list */
+  {  107,   -1 }, /* (249) external_declaration ::= function_definition */
+  {  107,   -1 }, /* (250) external_declaration ::= declaration */
+  {  117,   -4 }, /* (251) function_definition ::= declaration_specifiers declarator opt_declaration_list compound_statement */
+  {  146,   -1 }, /* (252) declaration_list ::= declaration */
+  {  146,   -2 }, /* (253) declaration_list ::= declaration_list declaration */
+  {  152,    0 }, /* (254) opt_declaration_list ::= */
+  {  152,   -1 }, /* (255) opt_declaration_list ::= declaration_list */
+  {  104,   -1 }, /* (256) optional_comma ::= COMMA */
+  {  104,    0 }, /* (257) optional_comma ::= */
+  {  187,    0 }, /* (258) opt_comma ::= */
+  {  187,   -1 }, /* (259) opt_comma ::= COMMA */
+};
+
+static void yy_accept(yyParser*);  /* Forward Declaration */
+
+/*
+** Perform a reduce action and the shift that must immediately
+** follow the reduce.
+**
+** The yyLookahead and yyLookaheadToken parameters provide reduce actions
+** access to the lookahead token (if any).  The yyLookahead will be YYNOCODE
+** if the lookahead token has already been consumed.  As this procedure is
+** only called from one place, optimizing compilers will in-line it, which
+** means that the extra parameters have no performance impact.
+*/
+static void yy_reduce(
+  yyParser *yypParser,         /* The parser */
+  unsigned int yyruleno,       /* Number of the rule by which to reduce */
+  int yyLookahead,             /* Lookahead token, or YYNOCODE if none */
+  DBCC_Lemon_ParserTOKENTYPE yyLookaheadToken  /* Value of the lookahead token */
+){
+  int yygoto;                     /* The next state */
+  int yyact;                      /* The next action */
+  yyStackEntry *yymsp;            /* The top of the parser's stack */
+  int yysize;                     /* Amount to pop the stack */
+  DBCC_Lemon_ParserARG_FETCH;
+  (void)yyLookahead;
+  (void)yyLookaheadToken;
+  yymsp = yypParser->yytos;
+#ifndef NDEBUG
+  if( yyTraceFILE && yyruleno<(int)(sizeof(yyRuleName)/sizeof(yyRuleName[0])) ){
+    yysize = yyRuleInfo[yyruleno].nrhs;
+    if( yysize ){
+      fprintf(yyTraceFILE, "%sReduce %d [%s], go to state %d.\n",
+        yyTracePrompt,
+        yyruleno, yyRuleName[yyruleno], yymsp[yysize].stateno);
+    }else{
+      fprintf(yyTraceFILE, "%sReduce %d [%s].\n",
+        yyTracePrompt, yyruleno, yyRuleName[yyruleno]);
+    }
+  }
+#endif /* NDEBUG */
+
+  /* Check that the stack is large enough to grow by a single entry
+  ** if the RHS of the rule is empty.  This ensures that there is room
+  ** enough on the stack to push the LHS value */
+  if( yyRuleInfo[yyruleno].nrhs==0 ){
+#ifdef YYTRACKMAXSTACKDEPTH
+    if( (int)(yypParser->yytos - yypParser->yystack)>yypParser->yyhwm ){
+      yypParser->yyhwm++;
+      assert( yypParser->yyhwm == (int)(yypParser->yytos - yypParser->yystack));
+    }
+#endif
+#if YYSTACKDEPTH>0 
+    if( yypParser->yytos>=yypParser->yystackEnd ){
+      yyStackOverflow(yypParser);
+      return;
+    }
+#else
+    if( yypParser->yytos>=&yypParser->yystack[yypParser->yystksz-1] ){
+      if( yyGrowStack(yypParser) ){
+        yyStackOverflow(yypParser);
+        return;
+      }
+      yymsp = yypParser->yytos;
+    }
+#endif
+  }
+
+  switch( yyruleno ){
+  /* Beginning here are the reduction cases.  A typical example
+  ** follows:
+  **   case 0:
+  **  #line <lineno> <grammarfile>
+  **     { ... }           // User supplied code
+  **  #line <lineno> <thisfile>
+  **     break;
+  */
+/********** Begin reduce actions **********************************************/
+        YYMINORTYPE yylhsminor;
+      case 0: /* primary_expression ::= IDENTIFIER */
+#line 2043 "dbcc-parser-p.lemon"
+{ DBCC_NamespaceEntry ns_entry;
+          if (!p_context_lookup (context, yymsp[0].minor.yy0.v_identifier, yymsp[0].minor.yy0.code_position, &ns_entry))
+            FAIL();             /// error set by p_context_lookup
+
+          // for purposes for the grammar,
+          //     DBCC_NAMESPACE_ENTRY_ENUM_VALUE
+          // and 
+          //     DBCC_NAMESPACE_ENTRY_TYPEDEF
+          // should already have been handled at lexing time.
+          assert(ns_entry.entry_type == DBCC_NAMESPACE_ENTRY_GLOBAL);
+
+          yylhsminor.yy101 = dbcc_expr_new_identifier (NULL, yymsp[0].minor.yy0.v_identifier, &context->error);
+          yylhsminor.yy101->base.code_position = dbcc_code_position_ref (yymsp[0].minor.yy0.code_position);
+
+
+        }
+#line 4308 "dbcc-parser-p.c"
+  yymsp[0].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 1: /* primary_expression ::= I_CONSTANT */
+#line 2060 "dbcc-parser-p.lemon"
+{ DBCC_Type *t = dbcc_namespace_get_integer_type (context->globals,
+                                                          yymsp[0].minor.yy0.v_i_constant.is_signed,
+                                                          yymsp[0].minor.yy0.v_i_constant.sizeof_value);
+          yylhsminor.yy101 = dbcc_expr_new_int_constant (t, yymsp[0].minor.yy0.v_i_constant.v_uint64);
+          dbcc_expr_add_code_position (yylhsminor.yy101, yymsp[0].minor.yy0.code_position); }
+#line 4318 "dbcc-parser-p.c"
+  yymsp[0].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 2: /* primary_expression ::= F_CONSTANT */
+#line 2066 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_float_constant (context->globals, 
+                                             yymsp[0].minor.yy0.v_f_constant.float_type,
+                                             yymsp[0].minor.yy0.v_f_constant.v_long_double);
+          dbcc_expr_add_code_position (yylhsminor.yy101, yymsp[0].minor.yy0.code_position); }
+#line 4327 "dbcc-parser-p.c"
+  yymsp[0].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 3: /* primary_expression ::= ENUMERATION_CONSTANT */
+#line 2071 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_enum_constant (yymsp[0].minor.yy0.v_enum_value.type, yymsp[0].minor.yy0.v_enum_value.enum_value); }
+#line 4333 "dbcc-parser-p.c"
+  yymsp[0].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 4: /* primary_expression ::= CHAR_CONSTANT */
+#line 2073 "dbcc-parser-p.lemon"
+{ 
+          DBCC_Type *t = dbcc_namespace_get_constant_char_type (yymsp[0].minor.yy0.v_char_constant.prefix);
+          yylhsminor.yy101 = dbcc_expr_new_char_constant (t, yymsp[0].minor.yy0.v_char_constant.code);
+          dbcc_expr_add_code_position (yylhsminor.yy101, yymsp[0].minor.yy0.code_position); }
+#line 4342 "dbcc-parser-p.c"
+  yymsp[0].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 5: /* primary_expression ::= string */
+#line 2078 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_string_constant (context->globals, &yymsp[0].minor.yy83);
+          yymsp[0].minor.yy83.str = NULL; }
+#line 4349 "dbcc-parser-p.c"
+  yymsp[0].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 6: /* primary_expression ::= LPAREN expression RPAREN */
+#line 2081 "dbcc-parser-p.lemon"
+{ yymsp[-2].minor.yy101 = yymsp[-1].minor.yy101; yymsp[-1].minor.yy101 = NULL; }
+#line 4355 "dbcc-parser-p.c"
+        break;
+      case 7: /* primary_expression ::= generic_selection */
+      case 16: /* postfix_expression ::= primary_expression */ yytestcase(yyruleno==16);
+      case 27: /* unary_expression ::= postfix_expression */ yytestcase(yyruleno==27);
+      case 40: /* cast_expression ::= unary_expression */ yytestcase(yyruleno==40);
+      case 42: /* multiplicative_expression ::= cast_expression */ yytestcase(yyruleno==42);
+      case 46: /* additive_expression ::= multiplicative_expression */ yytestcase(yyruleno==46);
+      case 49: /* shift_expression ::= additive_expression */ yytestcase(yyruleno==49);
+      case 52: /* relational_expression ::= shift_expression */ yytestcase(yyruleno==52);
+      case 57: /* equality_expression ::= relational_expression */ yytestcase(yyruleno==57);
+      case 60: /* and_expression ::= equality_expression */ yytestcase(yyruleno==60);
+      case 62: /* exclusive_or_expression ::= and_expression */ yytestcase(yyruleno==62);
+      case 64: /* inclusive_or_expression ::= exclusive_or_expression */ yytestcase(yyruleno==64);
+      case 66: /* logical_and_expression ::= inclusive_or_expression */ yytestcase(yyruleno==66);
+      case 68: /* logical_or_expression ::= logical_and_expression */ yytestcase(yyruleno==68);
+      case 70: /* conditional_expression ::= logical_or_expression */ yytestcase(yyruleno==70);
+      case 72: /* assignment_expression ::= conditional_expression */ yytestcase(yyruleno==72);
+      case 85: /* expression ::= assignment_expression */ yytestcase(yyruleno==85);
+      case 88: /* opt_expression ::= expression */ yytestcase(yyruleno==88);
+#line 2083 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = yymsp[0].minor.yy101; yymsp[0].minor.yy101 = NULL; }
+#line 4377 "dbcc-parser-p.c"
+  yymsp[0].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 8: /* enumeration_constant ::= IDENTIFIER */
+#line 2087 "dbcc-parser-p.lemon"
+{ 
+          assert(yymsp[0].minor.yy0.v_identifier != NULL);
+          yylhsminor.yy76 = yymsp[0].minor.yy0.v_identifier;
+        }
+#line 4386 "dbcc-parser-p.c"
+  yymsp[0].minor.yy76 = yylhsminor.yy76;
+        break;
+      case 9: /* string ::= STRING_LITERAL */
+#line 2093 "dbcc-parser-p.lemon"
+{ yylhsminor.yy83 = yymsp[0].minor.yy0.v_string_literal; }
+#line 4392 "dbcc-parser-p.c"
+  yymsp[0].minor.yy83 = yylhsminor.yy83;
+        break;
+      case 10: /* string ::= FUNC_NAME */
+#line 2096 "dbcc-parser-p.lemon"
+{ yylhsminor.yy83.str = strdup (dbcc_symbol_get_string (yymsp[0].minor.yy0.v_func_name));
+          yylhsminor.yy83.length = yymsp[0].minor.yy0.v_func_name->length;
+          yylhsminor.yy83.sizeof_elt = 1;
+          yylhsminor.yy83.is_wchar = false;
+        }
+#line 4402 "dbcc-parser-p.c"
+  yymsp[0].minor.yy83 = yylhsminor.yy83;
+        break;
+      case 11: /* generic_selection ::= GENERIC LPAREN assignment_expression COMMA generic_assoc_list RPAREN */
+#line 2103 "dbcc-parser-p.lemon"
+{ DBCC_Expr *def_expr = NULL;
+          unsigned count = 0;
+          for (P_GenericAssociation *ass = yymsp[-1].minor.yy2.first; ass != NULL; ass = ass->next)
+            if (ass->type == NULL)
+              def_expr = ass->expr;
+            else
+              count++;
+          unsigned i = 0;
+          DBCC_GenericAssociation *assocs = malloc (sizeof (DBCC_GenericAssociation) * count);
+
+          for (P_GenericAssociation *ass = yymsp[-1].minor.yy2.first; ass != NULL; ass = ass->next)
+            if (ass->type != NULL)
+              {
+                assocs[i].type = ass->type;
+                assocs[i].expr = ass->expr;
+                i++;
+              }
+          while (yymsp[-1].minor.yy2.first != NULL)
+            {
+              P_GenericAssociation *a = yymsp[-1].minor.yy2.first;
+              yymsp[-1].minor.yy2.first = a->next;
+              free (a);
+            }
+          yymsp[-1].minor.yy2.last = NULL;
+          yymsp[-5].minor.yy101 = dbcc_expr_new_generic_selection (CONTEXT_NS,
+                                                yymsp[-3].minor.yy101, count, assocs, def_expr,
+                                                &context->error);
+          if (yymsp[-5].minor.yy101 == NULL)
+            FAIL();
+        }
+#line 4437 "dbcc-parser-p.c"
+        break;
+      case 12: /* generic_assoc_list ::= generic_association */
+#line 2135 "dbcc-parser-p.lemon"
+{ yylhsminor.yy2.first = yylhsminor.yy2.last = yymsp[0].minor.yy260; yymsp[0].minor.yy260->next = NULL; yymsp[0].minor.yy260 = NULL; }
+#line 4442 "dbcc-parser-p.c"
+  yymsp[0].minor.yy2 = yylhsminor.yy2;
+        break;
+      case 13: /* generic_assoc_list ::= generic_assoc_list COMMA generic_association */
+#line 2137 "dbcc-parser-p.lemon"
+{ yylhsminor.yy2 = yymsp[-2].minor.yy2;
+          yylhsminor.yy2.last->next = yymsp[0].minor.yy260;
+          yymsp[0].minor.yy260->next = NULL;
+          yylhsminor.yy2.last = yymsp[0].minor.yy260; }
+#line 4451 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy2 = yylhsminor.yy2;
+        break;
+      case 14: /* generic_association ::= type_name COLON assignment_expression */
+#line 2143 "dbcc-parser-p.lemon"
+{ yylhsminor.yy260 = p_generic_association_new (yymsp[-2].minor.yy100, yymsp[0].minor.yy101); }
+#line 4457 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy260 = yylhsminor.yy260;
+        break;
+      case 15: /* generic_association ::= DEFAULT COLON assignment_expression */
+#line 2145 "dbcc-parser-p.lemon"
+{ yymsp[-2].minor.yy260 = p_generic_association_new (NULL, yymsp[0].minor.yy101); }
+#line 4463 "dbcc-parser-p.c"
+        break;
+      case 17: /* postfix_expression ::= postfix_expression LBRACKET expression RBRACKET */
+#line 2150 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_subscript (CONTEXT_NS, yymsp[-3].minor.yy101, yymsp[-1].minor.yy101, &context->error);
+        }
+#line 4469 "dbcc-parser-p.c"
+  yymsp[-3].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 18: /* postfix_expression ::= postfix_expression LPAREN RPAREN */
+#line 2153 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_call (CONTEXT_NS,
+                                   yymsp[-2].minor.yy101, 0, NULL,
+                                   &context->error);
+          if (yylhsminor.yy101 == NULL)
+            FAIL();
+        }
+#line 4480 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 19: /* postfix_expression ::= postfix_expression LPAREN argument_expression_list RPAREN */
+#line 2161 "dbcc-parser-p.lemon"
+{ size_t count = 0;
+          for (P_ExprNode *at = yymsp[-1].minor.yy308.first; at != NULL; at = at->next)
+            count++;
+          DBCC_Expr **args = malloc (sizeof (DBCC_Expr *) * count);
+          unsigned i = 0;
+          while (yymsp[-1].minor.yy308.first != NULL)
+            {
+              P_ExprNode *kill = yymsp[-1].minor.yy308.first;
+              args[i++] = kill->expr;
+              yymsp[-1].minor.yy308.first = kill->next;
+              free(kill);
+            }
+          yylhsminor.yy101 = dbcc_expr_new_call (CONTEXT_NS,
+                                   yymsp[-3].minor.yy101, count, args,
+                                   &context->error);
+          if (yylhsminor.yy101 == NULL)
+            FAIL();
+        }
+#line 4503 "dbcc-parser-p.c"
+  yymsp[-3].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 20: /* postfix_expression ::= postfix_expression PERIOD IDENTIFIER */
+#line 2181 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_access(CONTEXT_NS,
+                                    false,              // yymsp[-2].minor.yy101 is not a expected to a pointer
+                                    yymsp[-2].minor.yy101, yymsp[0].minor.yy0.v_identifier,
+                                    &context->error);
+          if (yylhsminor.yy101 == NULL)
+            FAIL();
+        }
+#line 4515 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 21: /* postfix_expression ::= postfix_expression POINTER_ACCESS IDENTIFIER */
+#line 2190 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_access(CONTEXT_NS,
+                                    true,               // yymsp[-2].minor.yy101 is expected to a pointer
+                                    yymsp[-2].minor.yy101, yymsp[0].minor.yy0.v_identifier,
+                                    &context->error);
+          if (yylhsminor.yy101 == NULL)
+            FAIL();
+        }
+#line 4527 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 22: /* postfix_expression ::= postfix_expression INCREMENT */
+#line 2198 "dbcc-parser-p.lemon"
+{ MK_INPLACE_UNARY(yylhsminor.yy101, POST_INCR, yymsp[-1].minor.yy101); }
+#line 4533 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 23: /* postfix_expression ::= postfix_expression DECREMENT */
+#line 2200 "dbcc-parser-p.lemon"
+{ MK_INPLACE_UNARY(yylhsminor.yy101, POST_DECR, yymsp[-1].minor.yy101); }
+#line 4539 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 24: /* postfix_expression ::= LPAREN type_name RPAREN LBRACE initializer_list optional_comma RBRACE */
+#line 2202 "dbcc-parser-p.lemon"
+{ DBCC_StructuredInitializer sinit;
+          structured_initializer_from_p_initializer_list (&yymsp[-2].minor.yy116, &sinit);
+          yymsp[-6].minor.yy101 = dbcc_expr_new_structured_initializer(&sinit);  }
+#line 4547 "dbcc-parser-p.c"
+        break;
+      case 25: /* argument_expression_list ::= assignment_expression */
+#line 2210 "dbcc-parser-p.lemon"
+{ P_ExprNode *n = p_expr_node_new (yymsp[0].minor.yy101);
+          yylhsminor.yy308.first = yylhsminor.yy308.last = n; }
+#line 4553 "dbcc-parser-p.c"
+  yymsp[0].minor.yy308 = yylhsminor.yy308;
+        break;
+      case 26: /* argument_expression_list ::= argument_expression_list COMMA assignment_expression */
+#line 2213 "dbcc-parser-p.lemon"
+{ yylhsminor.yy308 = yymsp[-2].minor.yy308;
+          P_ExprNode *n = p_expr_node_new (yymsp[0].minor.yy101);
+          yylhsminor.yy308.last->next = n;
+          yylhsminor.yy308.last = n; }
+#line 4562 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy308 = yylhsminor.yy308;
+        break;
+      case 28: /* unary_expression ::= INC_OP unary_expression */
+#line 2222 "dbcc-parser-p.lemon"
+{ MK_INPLACE_UNARY (yymsp[-1].minor.yy101, PRE_INCR, yymsp[0].minor.yy101); }
+#line 4568 "dbcc-parser-p.c"
+        break;
+      case 29: /* unary_expression ::= DEC_OP unary_expression */
+#line 2224 "dbcc-parser-p.lemon"
+{ MK_INPLACE_UNARY (yymsp[-1].minor.yy101, PRE_DECR, yymsp[0].minor.yy101); }
+#line 4573 "dbcc-parser-p.c"
+        break;
+      case 30: /* unary_expression ::= unary_operator cast_expression */
+#line 2226 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_unary(CONTEXT_NS, yymsp[-1].minor.yy295, yymsp[0].minor.yy101, &context->error);
+          if (yylhsminor.yy101 == NULL)
+            FAIL();
+        }
+#line 4581 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 31: /* unary_expression ::= SIZEOF unary_expression */
+#line 2231 "dbcc-parser-p.lemon"
+{ yymsp[-1].minor.yy101 = dbcc_expr_new_sizeof_expr(CONTEXT_NS, yymsp[0].minor.yy101, &context->error); 
+          if (yymsp[-1].minor.yy101 == NULL)
+            FAIL();
+        }
+#line 4590 "dbcc-parser-p.c"
+        break;
+      case 32: /* unary_expression ::= SIZEOF LPAREN type_name RPAREN */
+#line 2236 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_sizeof_type(CONTEXT_NS,
+                                         yymsp[-3].minor.yy0.code_position,
+                                         yymsp[-1].minor.yy100,
+                                         &context->error);
+          if (yylhsminor.yy101 == NULL) FAIL();
+        }
+#line 4600 "dbcc-parser-p.c"
+  yymsp[-3].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 33: /* unary_expression ::= ALIGNOF LPAREN type_name RPAREN */
+#line 2243 "dbcc-parser-p.lemon"
+{ yymsp[-3].minor.yy101 = dbcc_expr_new_alignof_type(context->globals, yymsp[-1].minor.yy100, &context->error);
+          if (yymsp[-3].minor.yy101 == NULL) FAIL();
+        }
+#line 4608 "dbcc-parser-p.c"
+        break;
+      case 34: /* unary_operator ::= AMPERSAND */
+#line 2248 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy295 = DBCC_UNARY_OPERATOR_REFERENCE; }
+#line 4613 "dbcc-parser-p.c"
+        break;
+      case 35: /* unary_operator ::= ASTERISK */
+#line 2250 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy295 = DBCC_UNARY_OPERATOR_DEREFERENCE; }
+#line 4618 "dbcc-parser-p.c"
+        break;
+      case 36: /* unary_operator ::= PLUS */
+#line 2252 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy295 = DBCC_UNARY_OPERATOR_NOOP; }
+#line 4623 "dbcc-parser-p.c"
+        break;
+      case 37: /* unary_operator ::= MINUS */
+#line 2254 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy295 = DBCC_UNARY_OPERATOR_NEGATE; }
+#line 4628 "dbcc-parser-p.c"
+        break;
+      case 38: /* unary_operator ::= TILDE */
+#line 2256 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy295 = DBCC_UNARY_OPERATOR_BITWISE_NOT; }
+#line 4633 "dbcc-parser-p.c"
+        break;
+      case 39: /* unary_operator ::= EXCLAMATION_POINT */
+#line 2258 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy295 = DBCC_UNARY_OPERATOR_LOGICAL_NOT; }
+#line 4638 "dbcc-parser-p.c"
+        break;
+      case 41: /* cast_expression ::= LPAREN type_name RPAREN cast_expression */
+#line 2263 "dbcc-parser-p.lemon"
+{ yymsp[-3].minor.yy101 = dbcc_expr_new_cast (CONTEXT_NS, yymsp[-2].minor.yy100, yymsp[0].minor.yy101, &context->error);
+          if (yymsp[-3].minor.yy101 == NULL)
+            FAIL();
+        }
+#line 4646 "dbcc-parser-p.c"
+        break;
+      case 43: /* multiplicative_expression ::= multiplicative_expression ASTERISK cast_expression */
+#line 2271 "dbcc-parser-p.lemon"
+{ MK_BINARY (yylhsminor.yy101, MUL, yymsp[-2].minor.yy101, yymsp[0].minor.yy101); }
+#line 4651 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 44: /* multiplicative_expression ::= multiplicative_expression SLASH cast_expression */
+#line 2273 "dbcc-parser-p.lemon"
+{ MK_BINARY (yylhsminor.yy101, DIV, yymsp[-2].minor.yy101, yymsp[0].minor.yy101); }
+#line 4657 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 45: /* multiplicative_expression ::= multiplicative_expression PERCENT cast_expression */
+#line 2275 "dbcc-parser-p.lemon"
+{ MK_BINARY (yylhsminor.yy101, REM, yymsp[-2].minor.yy101, yymsp[0].minor.yy101); }
+#line 4663 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 47: /* additive_expression ::= additive_expression PLUS multiplicative_expression */
+#line 2280 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_binary_operator (context->globals, DBCC_BINARY_OPERATOR_ADD, yymsp[-2].minor.yy101, yymsp[0].minor.yy101, &context->error);
+          if (yylhsminor.yy101 == NULL)
+            FAIL(); }
+#line 4671 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 48: /* additive_expression ::= additive_expression MINUS multiplicative_expression */
+#line 2284 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_binary_operator (context->globals, DBCC_BINARY_OPERATOR_SUB, yymsp[-2].minor.yy101, yymsp[0].minor.yy101, &context->error);
+          if (yylhsminor.yy101 == NULL)
+            FAIL(); }
+#line 4679 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 50: /* shift_expression ::= shift_expression SHIFT_LEFT additive_expression */
+#line 2291 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_binary_operator (context->globals, DBCC_BINARY_OPERATOR_SHIFT_LEFT, yymsp[-2].minor.yy101, yymsp[0].minor.yy101, &context->error);
+          if (yylhsminor.yy101 == NULL)
+            FAIL(); }
+#line 4687 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 51: /* shift_expression ::= shift_expression SHIFT_RIGHT additive_expression */
+#line 2295 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_binary_operator (context->globals, DBCC_BINARY_OPERATOR_SHIFT_RIGHT, yymsp[-2].minor.yy101, yymsp[0].minor.yy101, &context->error);
+          if (yylhsminor.yy101 == NULL)
+            FAIL(); }
+#line 4695 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 53: /* relational_expression ::= relational_expression LESS_THAN shift_expression */
+#line 2302 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_binary_operator (context->globals, DBCC_BINARY_OPERATOR_LT, yymsp[-2].minor.yy101, yymsp[0].minor.yy101, &context->error);
+          if (yylhsminor.yy101 == NULL)
+            FAIL(); }
+#line 4703 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 54: /* relational_expression ::= relational_expression GREATER_THAN shift_expression */
+#line 2306 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_binary_operator (context->globals, DBCC_BINARY_OPERATOR_GT, yymsp[-2].minor.yy101, yymsp[0].minor.yy101, &context->error);
+          if (yylhsminor.yy101 == NULL)
+            FAIL(); }
+#line 4711 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 55: /* relational_expression ::= relational_expression LE shift_expression */
+#line 2310 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_binary_operator (context->globals, DBCC_BINARY_OPERATOR_LTEQ, yymsp[-2].minor.yy101, yymsp[0].minor.yy101, &context->error);
+          yymsp[-2].minor.yy101 = yymsp[0].minor.yy101 = NULL; }
+#line 4718 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 56: /* relational_expression ::= relational_expression GE shift_expression */
+#line 2313 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_binary_operator (context->globals, DBCC_BINARY_OPERATOR_GTEQ, yymsp[-2].minor.yy101, yymsp[0].minor.yy101, &context->error);
+          yymsp[-2].minor.yy101 = yymsp[0].minor.yy101 = NULL; }
+#line 4725 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 58: /* equality_expression ::= equality_expression IS_EQUAL_TO relational_expression */
+#line 2320 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_binary_operator (context->globals, DBCC_BINARY_OPERATOR_EQ, yymsp[-2].minor.yy101, yymsp[0].minor.yy101, &context->error);
+          yymsp[-2].minor.yy101 = yymsp[0].minor.yy101 = NULL; }
+#line 4732 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 59: /* equality_expression ::= equality_expression NOT_EQUAL_TO relational_expression */
+#line 2324 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_binary_operator (context->globals, DBCC_BINARY_OPERATOR_NE, yymsp[-2].minor.yy101, yymsp[0].minor.yy101, &context->error);
+          yymsp[-2].minor.yy101 = yymsp[0].minor.yy101 = NULL; }
+#line 4739 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 61: /* and_expression ::= and_expression AMPERSAND equality_expression */
+#line 2330 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_binary_operator (context->globals, DBCC_BINARY_OPERATOR_BITWISE_AND, yymsp[-2].minor.yy101, yymsp[0].minor.yy101, &context->error);
+          yymsp[-2].minor.yy101 = yymsp[0].minor.yy101 = NULL; }
+#line 4746 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 63: /* exclusive_or_expression ::= exclusive_or_expression CARAT and_expression */
+#line 2336 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_binary_operator (context->globals, DBCC_BINARY_OPERATOR_BITWISE_XOR, yymsp[-2].minor.yy101, yymsp[0].minor.yy101, &context->error);
+          yymsp[-2].minor.yy101 = yymsp[0].minor.yy101 = NULL; }
+#line 4753 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 65: /* inclusive_or_expression ::= inclusive_or_expression VERTICAL_BAR exclusive_or_expression */
+#line 2342 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_binary_operator (context->globals, DBCC_BINARY_OPERATOR_BITWISE_OR, yymsp[-2].minor.yy101, yymsp[0].minor.yy101, &context->error);
+          yymsp[-2].minor.yy101 = yymsp[0].minor.yy101 = NULL; }
+#line 4760 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 67: /* logical_and_expression ::= logical_and_expression LOGICAL_AND inclusive_or_expression */
+#line 2348 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_binary_operator (context->globals, DBCC_BINARY_OPERATOR_LOGICAL_AND, yymsp[-2].minor.yy101, yymsp[0].minor.yy101, &context->error);
+          yymsp[-2].minor.yy101 = yymsp[0].minor.yy101 = NULL; }
+#line 4767 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 69: /* logical_or_expression ::= logical_or_expression LOGICAL_OR logical_and_expression */
+#line 2354 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_binary_operator (context->globals, DBCC_BINARY_OPERATOR_LOGICAL_OR, yymsp[-2].minor.yy101, yymsp[0].minor.yy101, &context->error);
+          yymsp[-2].minor.yy101 = yymsp[0].minor.yy101 = NULL; }
+#line 4774 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 71: /* conditional_expression ::= logical_or_expression QUESTION_MARK expression COLON conditional_expression */
+#line 2360 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_ternary (context->globals, yymsp[-4].minor.yy101, yymsp[-2].minor.yy101, yymsp[0].minor.yy101, &context->error);
+          if (!yylhsminor.yy101)
+            FAIL();
+        }
+#line 4783 "dbcc-parser-p.c"
+  yymsp[-4].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 73: /* assignment_expression ::= unary_expression assignment_operator assignment_expression */
+#line 2368 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = dbcc_expr_new_inplace_binary (context->globals, yymsp[-1].minor.yy149, yymsp[-2].minor.yy101, yymsp[0].minor.yy101, &context->error);
+          if (!yylhsminor.yy101)
+            FAIL();
+        }
+#line 4792 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 74: /* assignment_operator ::= EQUAL_SIGN */
+#line 2374 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy149 = DBCC_INPLACE_BINARY_OPERATOR_ASSIGN; }
+#line 4798 "dbcc-parser-p.c"
+        break;
+      case 75: /* assignment_operator ::= MULTIPLY_ASSIGN */
+#line 2376 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy149 = DBCC_INPLACE_BINARY_OPERATOR_MUL_ASSIGN; }
+#line 4803 "dbcc-parser-p.c"
+        break;
+      case 76: /* assignment_operator ::= DIVIDE_ASSIGN */
+#line 2378 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy149 = DBCC_INPLACE_BINARY_OPERATOR_DIV_ASSIGN; }
+#line 4808 "dbcc-parser-p.c"
+        break;
+      case 77: /* assignment_operator ::= REMAINDER_ASSIGN */
+#line 2380 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy149 = DBCC_INPLACE_BINARY_OPERATOR_REM_ASSIGN; }
+#line 4813 "dbcc-parser-p.c"
+        break;
+      case 78: /* assignment_operator ::= ADD_ASSIGN */
+#line 2382 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy149 = DBCC_INPLACE_BINARY_OPERATOR_ADD_ASSIGN; }
+#line 4818 "dbcc-parser-p.c"
+        break;
+      case 79: /* assignment_operator ::= SUBTRACT_ASSIGN */
+#line 2384 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy149 = DBCC_INPLACE_BINARY_OPERATOR_SUB_ASSIGN; }
+#line 4823 "dbcc-parser-p.c"
+        break;
+      case 80: /* assignment_operator ::= SHIFT_LEFT_ASSIGN */
+#line 2386 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy149 = DBCC_INPLACE_BINARY_OPERATOR_LEFT_SHIFT_ASSIGN; }
+#line 4828 "dbcc-parser-p.c"
+        break;
+      case 81: /* assignment_operator ::= SHIFT_RIGHT_ASSIGN */
+#line 2388 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy149 = DBCC_INPLACE_BINARY_OPERATOR_RIGHT_SHIFT_ASSIGN; }
+#line 4833 "dbcc-parser-p.c"
+        break;
+      case 82: /* assignment_operator ::= BITWISE_AND_ASSIGN */
+#line 2390 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy149 = DBCC_INPLACE_BINARY_OPERATOR_AND_ASSIGN; }
+#line 4838 "dbcc-parser-p.c"
+        break;
+      case 83: /* assignment_operator ::= BITWISE_XOR_ASSIGN */
+#line 2392 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy149 = DBCC_INPLACE_BINARY_OPERATOR_XOR_ASSIGN; }
+#line 4843 "dbcc-parser-p.c"
+        break;
+      case 84: /* assignment_operator ::= BITWISE_OR_ASSIGN */
+#line 2394 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy149 = DBCC_INPLACE_BINARY_OPERATOR_OR_ASSIGN; }
+#line 4848 "dbcc-parser-p.c"
+        break;
+      case 86: /* expression ::= expression COMMA assignment_expression */
+#line 2399 "dbcc-parser-p.lemon"
+{ MK_BINARY(yylhsminor.yy101, COMMA, yymsp[-2].minor.yy101, yymsp[0].minor.yy101); }
+#line 4853 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 87: /* constant_expression ::= conditional_expression */
+#line 2402 "dbcc-parser-p.lemon"
+{ yylhsminor.yy101 = yymsp[0].minor.yy101;
+#if 0
+          if (yylhsminor.yy101->base.constant == NULL)
+            {
+              context->error = dbcc_error_new (DBCC_ERROR_CONSTANT_REQUIRED,
+                                 "constant value required");
+              error_set_code_location_from_expr (context, yymsp[0].minor.yy101);
+              FAIL();
+            }
+#endif
+        }
+#line 4869 "dbcc-parser-p.c"
+  yymsp[0].minor.yy101 = yylhsminor.yy101;
+        break;
+      case 89: /* opt_expression ::= */
+#line 2417 "dbcc-parser-p.lemon"
+{ yymsp[1].minor.yy101 = NULL; }
+#line 4875 "dbcc-parser-p.c"
+        break;
+      case 90: /* declaration ::= declaration_specifiers SEMICOLON */
+#line 2420 "dbcc-parser-p.lemon"
+{ yylhsminor.yy212 = yymsp[-1].minor.yy212; 
+          yymsp[-1].minor.yy212 = NULL; }
+#line 4881 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy212 = yylhsminor.yy212;
+        break;
+      case 91: /* declaration ::= declaration_specifiers init_declarator_list SEMICOLON */
+#line 2423 "dbcc-parser-p.lemon"
+{ yylhsminor.yy212 = yymsp[-2].minor.yy212;
+          while (yymsp[-1].minor.yy217.first_declarator != NULL)
+            {
+              P_Declarator *n = yymsp[-1].minor.yy217.first_declarator;
+              yymsp[-1].minor.yy217.first_declarator = n->next;
+              n->next = NULL;
+              p_declaration_append_declarator (yylhsminor.yy212, n);
+            }
+        }
+#line 4895 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy212 = yylhsminor.yy212;
+        break;
+      case 92: /* declaration ::= static_assert_declaration */
+      case 93: /* opt_declaration_specifiers ::= declaration_specifiers */ yytestcase(yyruleno==93);
+      case 183: /* parameter_declaration ::= declaration_specifiers */ yytestcase(yyruleno==183);
+#line 2433 "dbcc-parser-p.lemon"
+{ yylhsminor.yy212 = yymsp[0].minor.yy212; }
+#line 4903 "dbcc-parser-p.c"
+  yymsp[0].minor.yy212 = yylhsminor.yy212;
+        break;
+      case 94: /* opt_declaration_specifiers ::= */
+#line 2438 "dbcc-parser-p.lemon"
+{ yymsp[1].minor.yy212 = p_declaration_new (); }
+#line 4909 "dbcc-parser-p.c"
+        break;
+      case 95: /* declaration_specifiers ::= storage_class_specifier opt_declaration_specifiers */
+#line 2441 "dbcc-parser-p.lemon"
+{ yylhsminor.yy212 = yymsp[0].minor.yy212;
+          yylhsminor.yy212->v_declaration.storage_class_specifiers |= yymsp[-1].minor.yy97; }
+#line 4915 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy212 = yylhsminor.yy212;
+        break;
+      case 96: /* declaration_specifiers ::= type_specifier opt_declaration_specifiers */
+#line 2444 "dbcc-parser-p.lemon"
+{ yylhsminor.yy212 = yymsp[0].minor.yy212; yymsp[0].minor.yy212 = NULL;
+          if (!p_type_specifiers_combine (context, &yylhsminor.yy212->v_declaration.specifiers, &yymsp[-1].minor.yy335))
+            FAIL();
+        }
+#line 4924 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy212 = yylhsminor.yy212;
+        break;
+      case 97: /* declaration_specifiers ::= type_qualifier opt_declaration_specifiers */
+      case 137: /* specifier_qualifier_list ::= type_qualifier specifier_qualifier_list */ yytestcase(yyruleno==137);
+#line 2449 "dbcc-parser-p.lemon"
+{ yylhsminor.yy212 = yymsp[0].minor.yy212;
+          yylhsminor.yy212->v_declaration.qualifiers |= yymsp[-1].minor.yy120; }
+#line 4932 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy212 = yylhsminor.yy212;
+        break;
+      case 98: /* declaration_specifiers ::= alignment_specifier opt_declaration_specifiers */
+#line 2452 "dbcc-parser-p.lemon"
+{ yylhsminor.yy212 = yymsp[0].minor.yy212;
+          if (yylhsminor.yy212->v_declaration.alignment_specifier != NULL)
+            {
+              context->error = dbcc_error_new (DBCC_ERROR_DUPLICATE,
+                                               "multiple alignment specifies given: not allowed");
+              FAIL();
+            }
+          yylhsminor.yy212->v_declaration.alignment_specifier = yymsp[-1].minor.yy239; }
+#line 4945 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy212 = yylhsminor.yy212;
+        break;
+      case 99: /* declaration_specifiers ::= function_specifier */
+#line 2461 "dbcc-parser-p.lemon"
+{ yylhsminor.yy212->v_declaration.function_specifiers |= yymsp[0].minor.yy7; }
+#line 4951 "dbcc-parser-p.c"
+  yymsp[0].minor.yy212 = yylhsminor.yy212;
+        break;
+      case 100: /* init_declarator_list ::= init_declarator */
+      case 139: /* struct_declarator_list ::= struct_declarator */ yytestcase(yyruleno==139);
+#line 2464 "dbcc-parser-p.lemon"
+{ yylhsminor.yy217.first_declarator = yylhsminor.yy217.last_declarator = yymsp[0].minor.yy307;
+          yymsp[0].minor.yy307->next = NULL; }
+#line 4959 "dbcc-parser-p.c"
+  yymsp[0].minor.yy217 = yylhsminor.yy217;
+        break;
+      case 101: /* init_declarator_list ::= init_declarator_list COMMA init_declarator */
+#line 2467 "dbcc-parser-p.lemon"
+{ yylhsminor.yy217 = yymsp[-2].minor.yy217;
+          yymsp[0].minor.yy307->next = NULL;               // unneeded
+          yylhsminor.yy217.last_declarator->next = yymsp[0].minor.yy307;
+          yylhsminor.yy217.last_declarator = yymsp[0].minor.yy307; }
+#line 4968 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy217 = yylhsminor.yy217;
+        break;
+      case 102: /* init_declarator ::= declarator EQUALS initializer */
+#line 2473 "dbcc-parser-p.lemon"
+{ assert(yymsp[-2].minor.yy307->initializer == NULL);
+          yymsp[-2].minor.yy307->initializer = yymsp[0].minor.yy358;
+          yylhsminor.yy307 = yymsp[-2].minor.yy307;
+          yymsp[-2].minor.yy307 = NULL;
+          yymsp[0].minor.yy358 = NULL; }
+#line 4978 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 103: /* init_declarator ::= declarator */
+#line 2479 "dbcc-parser-p.lemon"
+{ yylhsminor.yy307 = yymsp[0].minor.yy307;
+          yymsp[0].minor.yy307 = NULL; }
+#line 4985 "dbcc-parser-p.c"
+  yymsp[0].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 104: /* storage_class_specifier ::= TYPEDEF */
+#line 2483 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy97 = DBCC_STORAGE_CLASS_SPECIFIER_TYPEDEF; }
+#line 4991 "dbcc-parser-p.c"
+        break;
+      case 105: /* storage_class_specifier ::= EXTERN */
+#line 2485 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy97 = DBCC_STORAGE_CLASS_SPECIFIER_EXTERN; }
+#line 4996 "dbcc-parser-p.c"
+        break;
+      case 106: /* storage_class_specifier ::= STATIC */
+#line 2487 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy97 = DBCC_STORAGE_CLASS_SPECIFIER_STATIC; }
+#line 5001 "dbcc-parser-p.c"
+        break;
+      case 107: /* storage_class_specifier ::= THREAD_LOCAL */
+#line 2489 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy97 = DBCC_STORAGE_CLASS_SPECIFIER_THREAD_LOCAL; }
+#line 5006 "dbcc-parser-p.c"
+        break;
+      case 108: /* storage_class_specifier ::= AUTO */
+#line 2491 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy97 = DBCC_STORAGE_CLASS_SPECIFIER_AUTO; }
+#line 5011 "dbcc-parser-p.c"
+        break;
+      case 109: /* storage_class_specifier ::= REGISTER */
+#line 2493 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy97 = DBCC_STORAGE_CLASS_SPECIFIER_REGISTER; }
+#line 5016 "dbcc-parser-p.c"
+        break;
+      case 110: /* type_specifier ::= VOID */
+#line 2496 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy335 = P_TYPE_SPECIFIERS_INIT;
+          yymsp[0].minor.yy335.counts[P_TYPE_SPECIFIERS_INDEX_VOID] = 1; }
+#line 5022 "dbcc-parser-p.c"
+        break;
+      case 111: /* type_specifier ::= CHAR */
+      case 112: /* type_specifier ::= INT */ yytestcase(yyruleno==112);
+      case 114: /* type_specifier ::= LONG */ yytestcase(yyruleno==114);
+      case 115: /* type_specifier ::= FLOAT */ yytestcase(yyruleno==115);
+      case 116: /* type_specifier ::= DOUBLE */ yytestcase(yyruleno==116);
+      case 117: /* type_specifier ::= SIGNED */ yytestcase(yyruleno==117);
+      case 118: /* type_specifier ::= UNSIGNED */ yytestcase(yyruleno==118);
+      case 119: /* type_specifier ::= BOOL */ yytestcase(yyruleno==119);
+      case 120: /* type_specifier ::= COMPLEX */ yytestcase(yyruleno==120);
+      case 121: /* type_specifier ::= IMAGINARY */ yytestcase(yyruleno==121);
+#line 2499 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy335 = P_TYPE_SPECIFIERS_INIT;
+          yymsp[0].minor.yy335.counts[P_TYPE_SPECIFIERS_INDEX_CHAR] = 1; }
+#line 5037 "dbcc-parser-p.c"
+        break;
+      case 113: /* type_specifier ::= SHORT */
+#line 2505 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy335 = P_TYPE_SPECIFIERS_INIT;
+          yymsp[0].minor.yy335.counts[P_TYPE_SPECIFIERS_INDEX_SHORT] = 1; }
+#line 5043 "dbcc-parser-p.c"
+        break;
+      case 122: /* type_specifier ::= ATOMIC LPAREN type_name RPAREN */
+#line 2532 "dbcc-parser-p.lemon"
+{ yymsp[-3].minor.yy335 = P_TYPE_SPECIFIERS_INIT;
+          yymsp[-3].minor.yy335.counts[P_TYPE_SPECIFIERS_INDEX_ATOMIC]++;
+          yymsp[-3].minor.yy335.type = dbcc_type_new_qualified (context->target_env, yymsp[-1].minor.yy100, DBCC_TYPE_QUALIFIER_ATOMIC, &context->error);
+          if (yymsp[-3].minor.yy335.type == NULL)
+            {
+              FAIL();
+            }
+        }
+#line 5055 "dbcc-parser-p.c"
+        break;
+      case 123: /* type_specifier ::= struct_or_union_specifier */
+#line 2541 "dbcc-parser-p.lemon"
+{ yylhsminor.yy335 = P_TYPE_SPECIFIERS_INIT;
+          unsigned s_or_u_index = yymsp[0].minor.yy100->metatype == DBCC_TYPE_METATYPE_STRUCT
+                                ? P_TYPE_SPECIFIERS_INDEX_STRUCT
+                                : P_TYPE_SPECIFIERS_INDEX_UNION;
+          yylhsminor.yy335.counts[s_or_u_index] = 1;
+          yylhsminor.yy335.type = yymsp[0].minor.yy100; }
+#line 5065 "dbcc-parser-p.c"
+  yymsp[0].minor.yy335 = yylhsminor.yy335;
+        break;
+      case 124: /* type_specifier ::= enum_specifier */
+#line 2548 "dbcc-parser-p.lemon"
+{ yylhsminor.yy335 = P_TYPE_SPECIFIERS_INIT;
+          yylhsminor.yy335.counts[P_TYPE_SPECIFIERS_INDEX_ENUM] = 1;
+          yylhsminor.yy335.type = yymsp[0].minor.yy100; }
+#line 5073 "dbcc-parser-p.c"
+  yymsp[0].minor.yy335 = yylhsminor.yy335;
+        break;
+      case 125: /* type_specifier ::= TYPEDEF_NAME */
+#line 2552 "dbcc-parser-p.lemon"
+{ yylhsminor.yy335 = P_TYPE_SPECIFIERS_INIT;
+          yylhsminor.yy335.counts[P_TYPE_SPECIFIERS_INDEX_TYPEDEF] = 1;
+          yylhsminor.yy335.type = yymsp[0].minor.yy0.v_typedef_name.type; }
+#line 5081 "dbcc-parser-p.c"
+  yymsp[0].minor.yy335 = yylhsminor.yy335;
+        break;
+      case 126: /* struct_or_union_specifier ::= STRUCT IDENTIFIER */
+#line 2557 "dbcc-parser-p.lemon"
+{ yymsp[-1].minor.yy100 = context_new_struct_stub (context,
+                                        yymsp[0].minor.yy0.v_identifier,
+                                        yymsp[0].minor.yy0.code_position);
+          if (yymsp[-1].minor.yy100 == NULL) 
+            FAIL();
+        }
+#line 5092 "dbcc-parser-p.c"
+        break;
+      case 127: /* struct_or_union_specifier ::= STRUCT opt_identifier LBRACE struct_declaration_list RBRACE */
+#line 2564 "dbcc-parser-p.lemon"
+{ size_t n_params;
+          DBCC_Param *params;
+          if (!declaration_list_to_params (context, &yymsp[-1].minor.yy234, &n_params, &params))
+            FAIL();
+          yylhsminor.yy100 = context_new_struct (context,
+                                   yymsp[-3].minor.yy76,
+                                   yymsp[-4].minor.yy0.code_position,
+                                   n_params, params);
+          if (yylhsminor.yy100 == NULL) 
+            FAIL();
+        }
+#line 5107 "dbcc-parser-p.c"
+  yymsp[-4].minor.yy100 = yylhsminor.yy100;
+        break;
+      case 128: /* struct_or_union_specifier ::= UNION IDENTIFIER */
+#line 2576 "dbcc-parser-p.lemon"
+{ yymsp[-1].minor.yy100 = context_new_union_stub (context,
+                                       yymsp[0].minor.yy0.v_identifier,
+                                       yymsp[0].minor.yy0.code_position);
+          if (yymsp[-1].minor.yy100 == NULL) 
+            FAIL();
+        }
+#line 5118 "dbcc-parser-p.c"
+        break;
+      case 129: /* struct_or_union_specifier ::= UNION opt_identifier LBRACE struct_declaration_list RBRACE */
+#line 2583 "dbcc-parser-p.lemon"
+{ 
+          size_t n_params;
+          DBCC_Param *params;
+          if (!declaration_list_to_params (context, &yymsp[-1].minor.yy234, &n_params, &params))
+            FAIL();
+          yylhsminor.yy100 = context_new_union  (context,
+                                   yymsp[-3].minor.yy76,
+                                   yymsp[-4].minor.yy0.code_position,
+                                   n_params, params);
+          if (yylhsminor.yy100 == NULL) 
+            FAIL();
+        }
+#line 5134 "dbcc-parser-p.c"
+  yymsp[-4].minor.yy100 = yylhsminor.yy100;
+        break;
+      case 130: /* struct_declaration_list ::= struct_declaration */
+      case 179: /* parameter_list ::= parameter_declaration */ yytestcase(yyruleno==179);
+#line 2597 "dbcc-parser-p.lemon"
+{ yylhsminor.yy234.first_declaration = yylhsminor.yy234.last_declaration = yymsp[0].minor.yy212;
+          yymsp[0].minor.yy212->next = NULL; }
+#line 5142 "dbcc-parser-p.c"
+  yymsp[0].minor.yy234 = yylhsminor.yy234;
+        break;
+      case 131: /* struct_declaration_list ::= struct_declaration_list struct_declaration */
+#line 2600 "dbcc-parser-p.lemon"
+{ yylhsminor.yy234 = yymsp[-1].minor.yy234;
+          yylhsminor.yy234.last_declaration->next = yymsp[0].minor.yy212;
+          yylhsminor.yy234.last_declaration = yymsp[0].minor.yy212;
+          yymsp[0].minor.yy212->next = NULL; }
+#line 5151 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy234 = yylhsminor.yy234;
+        break;
+      case 132: /* struct_declaration ::= specifier_qualifier_list SEMICOLON */
+#line 2606 "dbcc-parser-p.lemon"
+{
+          assert(yymsp[-1].minor.yy212->v_declaration.specifiers.counts[P_TYPE_SPECIFIERS_INDEX_STRUCT] > 0
+              || yymsp[-1].minor.yy212->v_declaration.specifiers.counts[P_TYPE_SPECIFIERS_INDEX_UNION] > 0);
+          yylhsminor.yy212 = yymsp[-1].minor.yy212;
+        }
+#line 5161 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy212 = yylhsminor.yy212;
+        break;
+      case 133: /* struct_declaration ::= specifier_qualifier_list struct_declarator_list SEMICOLON */
+#line 2612 "dbcc-parser-p.lemon"
+{
+          assert(yymsp[-2].minor.yy212->v_declaration.declarators.first_declarator == NULL);
+          yymsp[-2].minor.yy212->v_declaration.declarators = yymsp[-1].minor.yy217;
+          yylhsminor.yy212 = yymsp[-2].minor.yy212;
+        }
+#line 5171 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy212 = yylhsminor.yy212;
+        break;
+      case 134: /* struct_declaration ::= static_assert_declaration */
+#line 2618 "dbcc-parser-p.lemon"
+{
+          yylhsminor.yy212 = yymsp[0].minor.yy212;
+          yymsp[0].minor.yy212 = NULL;
+	}
+#line 5180 "dbcc-parser-p.c"
+  yymsp[0].minor.yy212 = yylhsminor.yy212;
+        break;
+      case 135: /* specifier_qualifier_list ::= type_specifier specifier_qualifier_list */
+#line 2624 "dbcc-parser-p.lemon"
+{ yylhsminor.yy212 = yymsp[0].minor.yy212; 
+          if (!p_type_specifiers_combine (context, &yylhsminor.yy212->v_declaration.specifiers, &yymsp[-1].minor.yy335))
+            FAIL();
+        }
+#line 5189 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy212 = yylhsminor.yy212;
+        break;
+      case 136: /* specifier_qualifier_list ::= type_specifier */
+#line 2630 "dbcc-parser-p.lemon"
+{ yylhsminor.yy212 = p_declaration_new ();
+          yylhsminor.yy212->v_declaration.specifiers = yymsp[0].minor.yy335; }
+#line 5196 "dbcc-parser-p.c"
+  yymsp[0].minor.yy212 = yylhsminor.yy212;
+        break;
+      case 138: /* specifier_qualifier_list ::= type_qualifier */
+#line 2637 "dbcc-parser-p.lemon"
+{ yylhsminor.yy212 = p_declaration_new ();
+          yylhsminor.yy212->v_declaration.qualifiers |= yymsp[0].minor.yy120; }
+#line 5203 "dbcc-parser-p.c"
+  yymsp[0].minor.yy212 = yylhsminor.yy212;
+        break;
+      case 140: /* struct_declarator_list ::= struct_declarator_list COMMA struct_declarator */
+#line 2647 "dbcc-parser-p.lemon"
+{ yylhsminor.yy217 = yymsp[-2].minor.yy217;
+          yylhsminor.yy217.last_declarator->next = yymsp[0].minor.yy307;
+          yylhsminor.yy217.last_declarator = yymsp[0].minor.yy307;
+          yymsp[0].minor.yy307->next = NULL; }
+#line 5212 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy217 = yylhsminor.yy217;
+        break;
+      case 141: /* struct_declarator ::= COLON constant_expression */
+#line 2653 "dbcc-parser-p.lemon"
+{ yymsp[-1].minor.yy307 = p_declarator_new_bitfield (NULL, yymsp[0].minor.yy101); }
+#line 5218 "dbcc-parser-p.c"
+        break;
+      case 142: /* struct_declarator ::= declarator COLON constant_expression */
+#line 2655 "dbcc-parser-p.lemon"
+{ yylhsminor.yy307 = p_declarator_new_bitfield (yymsp[-2].minor.yy307, yymsp[0].minor.yy101); }
+#line 5223 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 143: /* struct_declarator ::= declarator */
+      case 160: /* declarator ::= direct_declarator */ yytestcase(yyruleno==160);
+#line 2657 "dbcc-parser-p.lemon"
+{ yylhsminor.yy307 = yymsp[0].minor.yy307; }
+#line 5230 "dbcc-parser-p.c"
+  yymsp[0].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 144: /* enum_specifier ::= ENUM opt_identifier LBRACE enumerator_list opt_comma RBRACE */
+#line 2660 "dbcc-parser-p.lemon"
+{ unsigned n_values = 0;
+          for (P_EnumValueNode *e = yymsp[-2].minor.yy34.first; e != NULL; e = e->next)
+            n_values++;
+          unsigned i = 0;
+          DBCC_EnumValue *evalues = DBCC_NEW_ARRAY(n_values, DBCC_EnumValue);
+          for (P_EnumValueNode *e = yymsp[-2].minor.yy34.first; e != NULL; e = e->next, i++)
+            evalues[i] = *e->enum_value;
+          DBCC_Error *error = NULL;
+          yymsp[-5].minor.yy100 = dbcc_type_new_enum (context->globals, yymsp[-4].minor.yy76, n_values, evalues, &error);
+          p_enumerator_list_clear (&yymsp[-2].minor.yy34);
+        }
+#line 5246 "dbcc-parser-p.c"
+        break;
+      case 145: /* opt_identifier ::= */
+#line 2673 "dbcc-parser-p.lemon"
+{ yymsp[1].minor.yy76 = NULL; }
+#line 5251 "dbcc-parser-p.c"
+        break;
+      case 146: /* opt_identifier ::= IDENTIFIER */
+#line 2675 "dbcc-parser-p.lemon"
+{ yylhsminor.yy76 = yymsp[0].minor.yy0.v_identifier; }
+#line 5256 "dbcc-parser-p.c"
+  yymsp[0].minor.yy76 = yylhsminor.yy76;
+        break;
+      case 147: /* enumerator_list ::= enumerator */
+#line 2678 "dbcc-parser-p.lemon"
+{ P_EnumValueNode *node = malloc (sizeof (P_EnumValueNode));
+          node->enum_value = yymsp[0].minor.yy276;
+          node->next =  NULL;
+          yylhsminor.yy34.first = yylhsminor.yy34.last = node; }
+#line 5265 "dbcc-parser-p.c"
+  yymsp[0].minor.yy34 = yylhsminor.yy34;
+        break;
+      case 148: /* enumerator_list ::= enumerator_list COMMA enumerator */
+#line 2683 "dbcc-parser-p.lemon"
+{ P_EnumValueNode *node = malloc (sizeof (P_EnumValueNode));
+          node->enum_value = yymsp[0].minor.yy276;
+          node->next =  NULL;
+          if (yymsp[-2].minor.yy34.first == NULL)
+            yymsp[-2].minor.yy34.first = node;
+          else
+            yymsp[-2].minor.yy34.last->next = node;
+          yymsp[-2].minor.yy34.last = node;
+          yylhsminor.yy34 = yymsp[-2].minor.yy34; }
+#line 5279 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy34 = yylhsminor.yy34;
+        break;
+      case 149: /* enumerator ::= enumeration_constant EQUALS constant_expression */
+#line 2701 "dbcc-parser-p.lemon"
+{ 
+          int value;
+          /* 6.7.2.2.2.  The expression that defines the value of an enumeration constant
+                         shall be an integer constant expression that has a value representable
+                         as an int. */
+          if (yymsp[0].minor.yy101->base.constant == NULL)
+            {
+              context->error = dbcc_error_new (DBCC_ERROR_CONSTANT_REQUIRED,
+                                 "constant value required");
+              error_set_code_location_from_expr (context, yymsp[0].minor.yy101);
+              FAIL();
+            }
+          if (!dbcc_cast_value (dbcc_namespace_get_int_type (context->globals),
+                                &value,
+                                yymsp[0].minor.yy101->base.value_type,
+                                yymsp[0].minor.yy101->base.constant->v_value.data))
+            {
+              DBCC_Symbol *type_name = yymsp[0].minor.yy101->base.value_type->base.name;
+              context->error = dbcc_error_new (DBCC_ERROR_EXPECTED_INT,
+                                               "enumeration value expression must be an int, got %s (for %s)",
+                                               type_name ? dbcc_symbol_get_string(type_name) : "<anonymous-type>",
+                                               dbcc_symbol_get_string(yymsp[-2].minor.yy76));
+              FAIL();
+            }
+          context->next_enum_value = value + 1;
+          yylhsminor.yy276 = dbcc_enum_value_new (yymsp[-2].minor.yy76, value);
+        }
+#line 5311 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy276 = yylhsminor.yy276;
+        break;
+      case 150: /* enumerator ::= enumeration_constant */
+#line 2729 "dbcc-parser-p.lemon"
+{ 
+          int value = context->next_enum_value;
+          context->next_enum_value = value + 1;
+          yylhsminor.yy276 = dbcc_enum_value_new (yymsp[0].minor.yy76, value);
+        }
+#line 5321 "dbcc-parser-p.c"
+  yymsp[0].minor.yy276 = yylhsminor.yy276;
+        break;
+      case 151: /* type_qualifier ::= CONST */
+#line 2736 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy120 = DBCC_TYPE_QUALIFIER_CONST; }
+#line 5327 "dbcc-parser-p.c"
+        break;
+      case 152: /* type_qualifier ::= RESTRICT */
+#line 2738 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy120 = DBCC_TYPE_QUALIFIER_RESTRICT; }
+#line 5332 "dbcc-parser-p.c"
+        break;
+      case 153: /* type_qualifier ::= VOLATILE */
+#line 2740 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy120 = DBCC_TYPE_QUALIFIER_VOLATILE; }
+#line 5337 "dbcc-parser-p.c"
+        break;
+      case 154: /* type_qualifier ::= ATOMIC */
+#line 2742 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy120 = DBCC_TYPE_QUALIFIER_ATOMIC; }
+#line 5342 "dbcc-parser-p.c"
+        break;
+      case 155: /* function_specifier ::= INLINE */
+#line 2745 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy7 = DBCC_FUNCTION_SPECIFIER_INLINE; }
+#line 5347 "dbcc-parser-p.c"
+        break;
+      case 156: /* function_specifier ::= NORETURN */
+#line 2747 "dbcc-parser-p.lemon"
+{ yymsp[0].minor.yy7 = DBCC_FUNCTION_SPECIFIER_NORETURN; }
+#line 5352 "dbcc-parser-p.c"
+        break;
+      case 157: /* alignment_specifier ::= ALIGNAS LPAREN type_name RPAREN */
+#line 2750 "dbcc-parser-p.lemon"
+{ yymsp[-3].minor.yy239 = malloc (sizeof (P_AlignmentSpecifier));
+          yymsp[-3].minor.yy239->specifier_type = P_ALIGNMENT_SPECIFIER_BY_TYPE;
+          yymsp[-3].minor.yy239->v_type = yymsp[-1].minor.yy100; }
+#line 5359 "dbcc-parser-p.c"
+        break;
+      case 158: /* alignment_specifier ::= ALIGNAS LPAREN constant_expression RPAREN */
+#line 2754 "dbcc-parser-p.lemon"
+{ yymsp[-3].minor.yy239 = malloc (sizeof (P_AlignmentSpecifier));
+          yymsp[-3].minor.yy239->specifier_type = P_ALIGNMENT_SPECIFIER_BY_EXPR;
+          yymsp[-3].minor.yy239->v_expr = yymsp[-1].minor.yy101; }
+#line 5366 "dbcc-parser-p.c"
+        break;
+      case 159: /* declarator ::= pointer direct_declarator */
+#line 2759 "dbcc-parser-p.lemon"
+{ P_Declarator *cur = yymsp[0].minor.yy307;
+          for (unsigned i = 0; i < yymsp[-1].minor.yy197.n_ptr; i++)
+            cur = p_declarator_new_pointer(yymsp[-1].minor.yy197.ptr_type_qualifiers[i], cur, yymsp[-1].minor.yy197.code_position);
+          yylhsminor.yy307 = cur; }
+#line 5374 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 161: /* direct_declarator ::= IDENTIFIER */
+#line 2767 "dbcc-parser-p.lemon"
+{ yylhsminor.yy307 = p_declarator_new_name (yymsp[0].minor.yy0.v_identifier); }
+#line 5380 "dbcc-parser-p.c"
+  yymsp[0].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 162: /* direct_declarator ::= LPAREN declarator RPAREN */
+#line 2770 "dbcc-parser-p.lemon"
+{ yymsp[-2].minor.yy307 = yymsp[-1].minor.yy307; }
+#line 5386 "dbcc-parser-p.c"
+        break;
+      case 163: /* direct_declarator ::= direct_declarator LBRACKET opt_type_qualifier_list RBRACKET */
+#line 2772 "dbcc-parser-p.lemon"
+{ yylhsminor.yy307 = p_declarator_new_array(yymsp[-1].minor.yy120, NULL, yymsp[-3].minor.yy307); }
+#line 5391 "dbcc-parser-p.c"
+  yymsp[-3].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 164: /* direct_declarator ::= direct_declarator LBRACKET STATIC opt_type_qualifier_list assignment_expression RBRACKET */
+#line 2775 "dbcc-parser-p.lemon"
+{ yylhsminor.yy307 = p_declarator_new_array(yymsp[-2].minor.yy120, yymsp[-1].minor.yy101, yymsp[-5].minor.yy307); }
+#line 5397 "dbcc-parser-p.c"
+  yymsp[-5].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 165: /* direct_declarator ::= direct_declarator LBRACKET type_qualifier_list STATIC assignment_expression RBRACKET */
+#line 2777 "dbcc-parser-p.lemon"
+{ yylhsminor.yy307 = p_declarator_new_array(yymsp[-3].minor.yy120, yymsp[-1].minor.yy101, yymsp[-5].minor.yy307); }
+#line 5403 "dbcc-parser-p.c"
+  yymsp[-5].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 166: /* direct_declarator ::= direct_declarator LBRACKET opt_type_qualifier_list assignment_expression RBRACKET */
+#line 2779 "dbcc-parser-p.lemon"
+{ yylhsminor.yy307 = p_declarator_new_array(yymsp[-2].minor.yy120, yymsp[-1].minor.yy101, yymsp[-4].minor.yy307); }
+#line 5409 "dbcc-parser-p.c"
+  yymsp[-4].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 167: /* direct_declarator ::= direct_declarator LBRACKET opt_type_qualifier_list ASTERISK RBRACKET */
+#line 2781 "dbcc-parser-p.lemon"
+{ yylhsminor.yy307 = p_declarator_new_varlen_array(yymsp[-2].minor.yy120, yymsp[-4].minor.yy307); }
+#line 5415 "dbcc-parser-p.c"
+  yymsp[-4].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 168: /* direct_declarator ::= direct_declarator LPAREN parameter_type_list RPAREN */
+      case 204: /* direct_abstract_declarator ::= direct_abstract_declarator LPAREN opt_parameter_type_list RPAREN */ yytestcase(yyruleno==204);
+#line 2783 "dbcc-parser-p.lemon"
+{ yylhsminor.yy307 = p_declarator_new_function(yymsp[-3].minor.yy307, &yymsp[-1].minor.yy293); }
+#line 5422 "dbcc-parser-p.c"
+  yymsp[-3].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 169: /* direct_declarator ::= direct_declarator LPAREN RPAREN */
+#line 2785 "dbcc-parser-p.lemon"
+{ yylhsminor.yy307 = p_declarator_new_function(yymsp[-2].minor.yy307, NULL); }
+#line 5428 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 170: /* direct_declarator ::= direct_declarator LPAREN identifier_list RPAREN */
+#line 2787 "dbcc-parser-p.lemon"
+{ yylhsminor.yy307 = p_declarator_new_function_kr (yymsp[-3].minor.yy307, &yymsp[-1].minor.yy351); }
+#line 5434 "dbcc-parser-p.c"
+  yymsp[-3].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 171: /* pointer ::= ASTERISK opt_type_qualifier_list pointer */
+#line 2793 "dbcc-parser-p.lemon"
+{ yymsp[-2].minor.yy197.n_ptr = yymsp[0].minor.yy197.n_ptr + 1;
+          yymsp[-2].minor.yy197.ptr_type_qualifiers = malloc (sizeof(DBCC_TypeQualifier) * yymsp[-2].minor.yy197.n_ptr);
+          yymsp[-2].minor.yy197.ptr_type_qualifiers[0] = yymsp[-1].minor.yy120;
+          yymsp[-2].minor.yy197.code_position = yymsp[0].minor.yy197.code_position;
+          memcpy (yymsp[-2].minor.yy197.ptr_type_qualifiers + 1, yymsp[0].minor.yy197.ptr_type_qualifiers, sizeof(DBCC_TypeQualifier) * yymsp[0].minor.yy197.n_ptr);
+          free (yymsp[0].minor.yy197.ptr_type_qualifiers); }
+#line 5445 "dbcc-parser-p.c"
+        break;
+      case 172: /* pointer ::= ASTERISK opt_type_qualifier_list */
+#line 2800 "dbcc-parser-p.lemon"
+{ yylhsminor.yy197.n_ptr = 1;
+          yylhsminor.yy197.ptr_type_qualifiers = malloc (sizeof(DBCC_TypeQualifier));
+          yylhsminor.yy197.ptr_type_qualifiers[0] = yymsp[0].minor.yy120;
+          yylhsminor.yy197.code_position = yymsp[-1].minor.yy0.code_position;
+        }
+#line 5454 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy197 = yylhsminor.yy197;
+        break;
+      case 173: /* opt_type_qualifier_list ::= */
+#line 2807 "dbcc-parser-p.lemon"
+{ yymsp[1].minor.yy120 = 0; }
+#line 5460 "dbcc-parser-p.c"
+        break;
+      case 174: /* opt_type_qualifier_list ::= type_qualifier_list */
+      case 175: /* type_qualifier_list ::= type_qualifier */ yytestcase(yyruleno==175);
+#line 2809 "dbcc-parser-p.lemon"
+{ yylhsminor.yy120 = yymsp[0].minor.yy120; }
+#line 5466 "dbcc-parser-p.c"
+  yymsp[0].minor.yy120 = yylhsminor.yy120;
+        break;
+      case 176: /* type_qualifier_list ::= type_qualifier_list type_qualifier */
+#line 2814 "dbcc-parser-p.lemon"
+{ yylhsminor.yy120 = yymsp[-1].minor.yy120 | yymsp[0].minor.yy120; }
+#line 5472 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy120 = yylhsminor.yy120;
+        break;
+      case 177: /* parameter_type_list ::= parameter_list COMMA ELLIPSIS */
+#line 2818 "dbcc-parser-p.lemon"
+{ yylhsminor.yy293.parameters = yymsp[-2].minor.yy234;
+          yylhsminor.yy293.has_varargs = true; }
+#line 5479 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy293 = yylhsminor.yy293;
+        break;
+      case 178: /* parameter_type_list ::= parameter_list */
+#line 2821 "dbcc-parser-p.lemon"
+{ yylhsminor.yy293.parameters = yymsp[0].minor.yy234;
+          yylhsminor.yy293.has_varargs = false; }
+#line 5486 "dbcc-parser-p.c"
+  yymsp[0].minor.yy293 = yylhsminor.yy293;
+        break;
+      case 180: /* parameter_list ::= parameter_list COMMA parameter_declaration */
+#line 2828 "dbcc-parser-p.lemon"
+{ yymsp[-2].minor.yy234.last_declaration->next = yymsp[0].minor.yy212;
+          yymsp[-2].minor.yy234.last_declaration = yymsp[0].minor.yy212;
+          yymsp[0].minor.yy212->next = NULL;
+          yylhsminor.yy234 = yymsp[-2].minor.yy234; }
+#line 5495 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy234 = yylhsminor.yy234;
+        break;
+      case 181: /* parameter_declaration ::= declaration_specifiers declarator */
+#line 2834 "dbcc-parser-p.lemon"
+{ yylhsminor.yy212 = yymsp[-1].minor.yy212;
+          p_declaration_append_declarator (yylhsminor.yy212, yymsp[0].minor.yy307); }
+#line 5502 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy212 = yylhsminor.yy212;
+        break;
+      case 182: /* parameter_declaration ::= declaration_specifiers abstract_declarator */
+#line 2837 "dbcc-parser-p.lemon"
+{ yylhsminor.yy212 = yymsp[-1].minor.yy212;
+          p_declaration_append_declarator(yylhsminor.yy212, yymsp[0].minor.yy307); }
+#line 5509 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy212 = yylhsminor.yy212;
+        break;
+      case 184: /* opt_parameter_type_list ::= parameter_type_list */
+#line 2843 "dbcc-parser-p.lemon"
+{ yylhsminor.yy293 = yymsp[0].minor.yy293; }
+#line 5515 "dbcc-parser-p.c"
+  yymsp[0].minor.yy293 = yylhsminor.yy293;
+        break;
+      case 185: /* opt_parameter_type_list ::= */
+#line 2845 "dbcc-parser-p.lemon"
+{ yymsp[1].minor.yy293.parameters.first_declaration = NULL;
+          yymsp[1].minor.yy293.parameters.last_declaration = NULL;
+          yymsp[1].minor.yy293.has_varargs = false; }
+#line 5523 "dbcc-parser-p.c"
+        break;
+      case 186: /* identifier_list ::= IDENTIFIER */
+#line 2850 "dbcc-parser-p.lemon"
+{ yylhsminor.yy351.first = yylhsminor.yy351.last = NULL;
+          p_identifier_list_append (&yylhsminor.yy351, yymsp[0].minor.yy0.v_identifier); }
+#line 5529 "dbcc-parser-p.c"
+  yymsp[0].minor.yy351 = yylhsminor.yy351;
+        break;
+      case 187: /* identifier_list ::= identifier_list COMMA IDENTIFIER */
+#line 2853 "dbcc-parser-p.lemon"
+{ yylhsminor.yy351 = yymsp[-2].minor.yy351;
+          p_identifier_list_append (&yylhsminor.yy351, yymsp[0].minor.yy0.v_identifier); }
+#line 5536 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy351 = yylhsminor.yy351;
+        break;
+      case 188: /* type_name ::= specifier_qualifier_list abstract_declarator */
+#line 2857 "dbcc-parser-p.lemon"
+{ yylhsminor.yy100 = type_from_parts (context, yymsp[-1].minor.yy212, yymsp[0].minor.yy307); }
+#line 5542 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy100 = yylhsminor.yy100;
+        break;
+      case 189: /* type_name ::= specifier_qualifier_list */
+#line 2859 "dbcc-parser-p.lemon"
+{ yylhsminor.yy100 = type_from_parts (context, yymsp[0].minor.yy212, NULL); }
+#line 5548 "dbcc-parser-p.c"
+  yymsp[0].minor.yy100 = yylhsminor.yy100;
+        break;
+      case 190: /* abstract_declarator ::= ASTERISK opt_type_qualifier_list abstract_declarator */
+#line 2862 "dbcc-parser-p.lemon"
+{ yylhsminor.yy307 = p_declarator_new_pointer (yymsp[-1].minor.yy120, yymsp[0].minor.yy307, yymsp[-2].minor.yy0.code_position);
+          yymsp[0].minor.yy307 = NULL; }
+#line 5555 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 191: /* abstract_declarator ::= direct_abstract_declarator */
+#line 2866 "dbcc-parser-p.lemon"
+{ yylhsminor.yy307 = yymsp[0].minor.yy307; yymsp[0].minor.yy307 = NULL; }
+#line 5561 "dbcc-parser-p.c"
+  yymsp[0].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 192: /* direct_abstract_declarator ::= LPAREN abstract_declarator RPAREN */
+#line 2869 "dbcc-parser-p.lemon"
+{ yymsp[-2].minor.yy307 = yymsp[-1].minor.yy307; yymsp[-1].minor.yy307 = NULL; }
+#line 5567 "dbcc-parser-p.c"
+        break;
+      case 193: /* direct_abstract_declarator ::= LBRACKET opt_type_qualifier_list RBRACKET */
+#line 2872 "dbcc-parser-p.lemon"
+{ yymsp[-2].minor.yy307 = p_declarator_new_array (yymsp[-1].minor.yy120, NULL, p_declarator_new_name(NULL)); }
+#line 5572 "dbcc-parser-p.c"
+        break;
+      case 194: /* direct_abstract_declarator ::= LBRACKET opt_type_qualifier_list ASTERISK RBRACKET */
+#line 2875 "dbcc-parser-p.lemon"
+{ yymsp[-3].minor.yy307 = p_declarator_new_varlen_array (yymsp[-2].minor.yy120, p_declarator_new_name(NULL)); }
+#line 5577 "dbcc-parser-p.c"
+        break;
+      case 195: /* direct_abstract_declarator ::= LBRACKET STATIC opt_type_qualifier_list assignment_expression RBRACKET */
+#line 2878 "dbcc-parser-p.lemon"
+{ yymsp[-4].minor.yy307 = p_declarator_new_array (yymsp[-2].minor.yy120, yymsp[-1].minor.yy101, p_declarator_new_name(NULL));
+          yymsp[-1].minor.yy101 = NULL; }
+#line 5583 "dbcc-parser-p.c"
+        break;
+      case 196: /* direct_abstract_declarator ::= LBRACKET type_qualifier_list STATIC assignment_expression RBRACKET */
+#line 2881 "dbcc-parser-p.lemon"
+{ yymsp[-4].minor.yy307 = p_declarator_new_array (yymsp[-3].minor.yy120, yymsp[-1].minor.yy101, p_declarator_new_name(NULL));
+          yymsp[-1].minor.yy101 = NULL; }
+#line 5589 "dbcc-parser-p.c"
+        break;
+      case 197: /* direct_abstract_declarator ::= LBRACKET opt_type_qualifier_list assignment_expression RBRACKET */
+#line 2884 "dbcc-parser-p.lemon"
+{ yymsp[-3].minor.yy307 = p_declarator_new_array (yymsp[-2].minor.yy120, yymsp[-1].minor.yy101, p_declarator_new_name(NULL));
+          yymsp[-1].minor.yy101 = NULL; }
+#line 5595 "dbcc-parser-p.c"
+        break;
+      case 198: /* direct_abstract_declarator ::= direct_abstract_declarator LBRACKET opt_type_qualifier_list RBRACKET */
+#line 2888 "dbcc-parser-p.lemon"
+{ yylhsminor.yy307 = p_declarator_new_array(yymsp[-1].minor.yy120, NULL, yymsp[-3].minor.yy307);
+          yymsp[-3].minor.yy307 = NULL; }
+#line 5601 "dbcc-parser-p.c"
+  yymsp[-3].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 199: /* direct_abstract_declarator ::= direct_abstract_declarator LBRACKET opt_type_qualifier_list assignment_expression RBRACKET */
+#line 2891 "dbcc-parser-p.lemon"
+{ yylhsminor.yy307 = p_declarator_new_array(yymsp[-2].minor.yy120, yymsp[-1].minor.yy101, yymsp[-4].minor.yy307);
+          yymsp[-4].minor.yy307 = NULL;
+          yymsp[-1].minor.yy101 = NULL; }
+#line 5609 "dbcc-parser-p.c"
+  yymsp[-4].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 200: /* direct_abstract_declarator ::= direct_abstract_declarator LBRACKET STATIC opt_type_qualifier_list assignment_expression RBRACKET */
+#line 2895 "dbcc-parser-p.lemon"
+{ yylhsminor.yy307 = p_declarator_new_array(yymsp[-2].minor.yy120, yymsp[-1].minor.yy101, yymsp[-5].minor.yy307);
+          yymsp[-5].minor.yy307 = NULL;
+          yymsp[-1].minor.yy101 = NULL; }
+#line 5617 "dbcc-parser-p.c"
+  yymsp[-5].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 201: /* direct_abstract_declarator ::= direct_abstract_declarator LBRACKET type_qualifier_list STATIC assignment_expression RBRACKET */
+#line 2899 "dbcc-parser-p.lemon"
+{ yylhsminor.yy307 = p_declarator_new_array(yymsp[-3].minor.yy120, yymsp[-1].minor.yy101, yymsp[-5].minor.yy307);
+          yymsp[-5].minor.yy307 = NULL;
+          yymsp[-1].minor.yy101 = NULL; }
+#line 5625 "dbcc-parser-p.c"
+  yymsp[-5].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 202: /* direct_abstract_declarator ::= direct_abstract_declarator opt_type_qualifier_list LBRACKET ASTERISK RBRACKET */
+#line 2903 "dbcc-parser-p.lemon"
+{ yylhsminor.yy307 = p_declarator_new_varlen_array(yymsp[-3].minor.yy120, yymsp[-4].minor.yy307);
+          yymsp[-4].minor.yy307 = NULL; }
+#line 5632 "dbcc-parser-p.c"
+  yymsp[-4].minor.yy307 = yylhsminor.yy307;
+        break;
+      case 203: /* direct_abstract_declarator ::= LPAREN opt_parameter_type_list RPAREN */
+#line 2906 "dbcc-parser-p.lemon"
+{ yymsp[-2].minor.yy307 = p_declarator_new_function(p_declarator_new_name(NULL), &yymsp[-1].minor.yy293); }
+#line 5638 "dbcc-parser-p.c"
+        break;
+      case 205: /* initializer ::= LBRACE initializer_list opt_comma RBRACE */
+#line 2911 "dbcc-parser-p.lemon"
+{ yymsp[-3].minor.yy358 = p_initializer_new_structured (&yymsp[-2].minor.yy116); }
+#line 5643 "dbcc-parser-p.c"
+        break;
+      case 206: /* initializer ::= assignment_expression */
+#line 2913 "dbcc-parser-p.lemon"
+{ yylhsminor.yy358 = p_initializer_new_expr (yymsp[0].minor.yy101); }
+#line 5648 "dbcc-parser-p.c"
+  yymsp[0].minor.yy358 = yylhsminor.yy358;
+        break;
+      case 207: /* initializer_list ::= opt_designation initializer */
+#line 2916 "dbcc-parser-p.lemon"
+{ assert(yymsp[0].minor.yy358->designators.first == NULL);
+          yymsp[0].minor.yy358->designators = yymsp[-1].minor.yy304;
+          yylhsminor.yy116.first = yylhsminor.yy116.last = yymsp[0].minor.yy358; }
+#line 5656 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy116 = yylhsminor.yy116;
+        break;
+      case 208: /* initializer_list ::= initializer_list COMMA opt_designation initializer */
+#line 2921 "dbcc-parser-p.lemon"
+{ assert(yymsp[0].minor.yy358->designators.first == NULL);
+          yymsp[0].minor.yy358->designators = yymsp[-1].minor.yy304;
+          yymsp[-3].minor.yy116.last->next = yymsp[0].minor.yy358;
+          yymsp[0].minor.yy358->next = NULL;
+          yymsp[-3].minor.yy116.last = yymsp[0].minor.yy358;
+          yylhsminor.yy116 = yymsp[-3].minor.yy116; }
+#line 5667 "dbcc-parser-p.c"
+  yymsp[-3].minor.yy116 = yylhsminor.yy116;
+        break;
+      case 209: /* opt_designation ::= designation */
+#line 2929 "dbcc-parser-p.lemon"
+{ yylhsminor.yy304 = yymsp[0].minor.yy304; yymsp[0].minor.yy304.first = yymsp[0].minor.yy304.last = NULL; }
+#line 5673 "dbcc-parser-p.c"
+  yymsp[0].minor.yy304 = yylhsminor.yy304;
+        break;
+      case 210: /* opt_designation ::= */
+#line 2931 "dbcc-parser-p.lemon"
+{ yymsp[1].minor.yy304.first = yymsp[1].minor.yy304.last = NULL; }
+#line 5679 "dbcc-parser-p.c"
+        break;
+      case 211: /* designation ::= designator_list EQUALS */
+#line 2934 "dbcc-parser-p.lemon"
+{ yylhsminor.yy304 = yymsp[-1].minor.yy304;
+          yymsp[-1].minor.yy304.first = yymsp[-1].minor.yy304.last = NULL; }
+#line 5685 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy304 = yylhsminor.yy304;
+        break;
+      case 212: /* designator_list ::= designator */
+#line 2938 "dbcc-parser-p.lemon"
+{ yylhsminor.yy304.first = yylhsminor.yy304.last = yymsp[0].minor.yy154;
+          yymsp[0].minor.yy154->next = NULL; }
+#line 5692 "dbcc-parser-p.c"
+  yymsp[0].minor.yy304 = yylhsminor.yy304;
+        break;
+      case 213: /* designator_list ::= designator_list designator */
+#line 2941 "dbcc-parser-p.lemon"
+{ yylhsminor.yy304 = yymsp[-1].minor.yy304; yymsp[-1].minor.yy304.first = yymsp[-1].minor.yy304.last = NULL;
+          yylhsminor.yy304.last->next = yymsp[0].minor.yy154;
+          yymsp[0].minor.yy154->next = NULL;
+          yylhsminor.yy304.last = yymsp[0].minor.yy154; }
+#line 5701 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy304 = yylhsminor.yy304;
+        break;
+      case 214: /* designator ::= LBRACKET constant_expression RBRACKET */
+#line 2947 "dbcc-parser-p.lemon"
+{ yymsp[-2].minor.yy154 = p_designator_new_array_index (yymsp[-1].minor.yy101);
+          yymsp[-1].minor.yy101 = NULL; }
+#line 5708 "dbcc-parser-p.c"
+        break;
+      case 215: /* designator ::= PERIOD IDENTIFIER */
+#line 2950 "dbcc-parser-p.lemon"
+{ yymsp[-1].minor.yy154 = p_designator_new_struct_member (yymsp[0].minor.yy0.v_identifier); }
+#line 5713 "dbcc-parser-p.c"
+        break;
+      case 216: /* static_assert_declaration ::= STATIC_ASSERT LPAREN constant_expression COMMA STRING_LITERAL RPAREN SEMICOLON */
+#line 2953 "dbcc-parser-p.lemon"
+{ yymsp[-6].minor.yy212 = p_static_assertion_new (yymsp[-4].minor.yy101, &yymsp[-2].minor.yy0.v_string_literal); }
+#line 5718 "dbcc-parser-p.c"
+        break;
+      case 217: /* statement ::= labeled_statement */
+      case 218: /* statement ::= compound_statement */ yytestcase(yyruleno==218);
+      case 219: /* statement ::= expression_statement */ yytestcase(yyruleno==219);
+      case 220: /* statement ::= selection_statement */ yytestcase(yyruleno==220);
+      case 221: /* statement ::= iteration_statement */ yytestcase(yyruleno==221);
+      case 222: /* statement ::= jump_statement */ yytestcase(yyruleno==222);
+      case 228: /* block_item_list ::= block_item */ yytestcase(yyruleno==228);
+      case 231: /* block_item ::= statement */ yytestcase(yyruleno==231);
+#line 2956 "dbcc-parser-p.lemon"
+{ yylhsminor.yy245 = yymsp[0].minor.yy245; }
+#line 5730 "dbcc-parser-p.c"
+  yymsp[0].minor.yy245 = yylhsminor.yy245;
+        break;
+      case 223: /* labeled_statement ::= IDENTIFIER COLON statement */
+#line 2969 "dbcc-parser-p.lemon"
+{ p_statement_list_init1 (&yylhsminor.yy245, dbcc_statement_new_label (yymsp[-2].minor.yy0.v_identifier));
+          p_statement_list_append_list (&yylhsminor.yy245, &yymsp[0].minor.yy245); }
+#line 5737 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy245 = yylhsminor.yy245;
+        break;
+      case 224: /* labeled_statement ::= CASE constant_expression COLON statement */
+#line 2972 "dbcc-parser-p.lemon"
+{ p_statement_list_init1 (&yymsp[-3].minor.yy245, dbcc_statement_new_case (yymsp[-2].minor.yy101));
+          p_statement_list_append_list (&yymsp[-3].minor.yy245, &yymsp[0].minor.yy245); }
+#line 5744 "dbcc-parser-p.c"
+        break;
+      case 225: /* labeled_statement ::= DEFAULT COLON statement */
+#line 2975 "dbcc-parser-p.lemon"
+{ p_statement_list_init1 (&yylhsminor.yy245, dbcc_statement_new_default (yymsp[-2].minor.yy0.code_position));
+          p_statement_list_append_list (&yylhsminor.yy245, &yymsp[0].minor.yy245); }
+#line 5750 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy245 = yylhsminor.yy245;
+        break;
+      case 226: /* compound_statement ::= LBRACE RBRACE */
+#line 2979 "dbcc-parser-p.lemon"
+{ p_statement_list_init_empty (&yymsp[-1].minor.yy245); }
+#line 5756 "dbcc-parser-p.c"
+        break;
+      case 227: /* compound_statement ::= LBRACE block_item_list RBRACE */
+#line 2981 "dbcc-parser-p.lemon"
+{ size_t n_child = 0;
+          for (P_StatementNode *at = yymsp[-1].minor.yy245.first; at != NULL; at = at->next)
+            n_child++;
+          DBCC_Statement **children = malloc (sizeof (DBCC_Statement *) * n_child);
+          size_t i = 0;
+          for (P_StatementNode *at = yymsp[-1].minor.yy245.first; at != NULL; at = at->next)
+            children[i++] = at->statement;
+          p_statement_list_init1 (&yymsp[-2].minor.yy245, dbcc_statement_new_compound (n_child, children, true));
+        }
+#line 5769 "dbcc-parser-p.c"
+        break;
+      case 229: /* block_item_list ::= block_item_list block_item */
+#line 2994 "dbcc-parser-p.lemon"
+{ yylhsminor.yy245 = yymsp[-1].minor.yy245;
+          p_statement_list_append_list (&yylhsminor.yy245, &yymsp[0].minor.yy245); }
+#line 5775 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy245 = yylhsminor.yy245;
+        break;
+      case 230: /* block_item ::= declaration */
+#line 2998 "dbcc-parser-p.lemon"
+{ declaration_to_statement_list (context, yymsp[0].minor.yy212, &yylhsminor.yy245); }
+#line 5781 "dbcc-parser-p.c"
+  yymsp[0].minor.yy245 = yylhsminor.yy245;
+        break;
+      case 232: /* expression_statement ::= SEMICOLON */
+#line 3003 "dbcc-parser-p.lemon"
+{ p_statement_list_init1 (&yymsp[0].minor.yy245, dbcc_statement_new_empty ()); }
+#line 5787 "dbcc-parser-p.c"
+        break;
+      case 233: /* expression_statement ::= expression SEMICOLON */
+#line 3005 "dbcc-parser-p.lemon"
+{ p_statement_list_init1 (&yylhsminor.yy245, dbcc_statement_new_expr (yymsp[-1].minor.yy101)); }
+#line 5792 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy245 = yylhsminor.yy245;
+        break;
+      case 234: /* selection_statement ::= IF LPAREN expression RPAREN statement ELSE statement */
+#line 3008 "dbcc-parser-p.lemon"
+{ DBCC_Statement *s = dbcc_statement_new_if (yymsp[-4].minor.yy101,
+                                                     statement_from_list (&yymsp[-2].minor.yy245),
+                                                     statement_from_list (&yymsp[0].minor.yy245),
+                                                     yymsp[-6].minor.yy0.code_position,
+                                                     &context->error);
+          if (s == NULL)
+            FAIL();
+          p_statement_list_init1 (&yylhsminor.yy245, s); }
+#line 5805 "dbcc-parser-p.c"
+  yymsp[-6].minor.yy245 = yylhsminor.yy245;
+        break;
+      case 235: /* selection_statement ::= IF LPAREN expression RPAREN statement */
+#line 3017 "dbcc-parser-p.lemon"
+{ DBCC_Statement *s = dbcc_statement_new_if (yymsp[-2].minor.yy101,
+                                                     statement_from_list (&yymsp[0].minor.yy245),
+                                                     NULL,
+                                                     yymsp[-4].minor.yy0.code_position,
+                                                     &context->error);
+          if (s == NULL)
+            FAIL();
+          p_statement_list_init1 (&yylhsminor.yy245, s); }
+#line 5818 "dbcc-parser-p.c"
+  yymsp[-4].minor.yy245 = yylhsminor.yy245;
+        break;
+      case 236: /* selection_statement ::= SWITCH LPAREN expression RPAREN statement */
+#line 3026 "dbcc-parser-p.lemon"
+{ DBCC_Statement *s = dbcc_statement_new_switch (yymsp[-2].minor.yy101,
+                                                         statement_from_list (&yymsp[0].minor.yy245),
+                                                         yymsp[-4].minor.yy0.code_position,
+                                                         &context->error);
+          if (s == NULL)
+            FAIL();
+          p_statement_list_init1 (&yylhsminor.yy245, s); }
+#line 5830 "dbcc-parser-p.c"
+  yymsp[-4].minor.yy245 = yylhsminor.yy245;
+        break;
+      case 237: /* iteration_statement ::= WHILE LPAREN expression RPAREN statement */
+#line 3035 "dbcc-parser-p.lemon"
+{ DBCC_Statement *w = dbcc_statement_new_while (yymsp[-2].minor.yy101,
+                                                        statement_from_list (&yymsp[0].minor.yy245),
+                                                        yymsp[-4].minor.yy0.code_position,
+                                                        &context->error);
+          if (w == NULL)
+            FAIL();
+          p_statement_list_init1 (&yylhsminor.yy245, w);
+        }
+#line 5843 "dbcc-parser-p.c"
+  yymsp[-4].minor.yy245 = yylhsminor.yy245;
+        break;
+      case 238: /* iteration_statement ::= DO statement WHILE LPAREN expression RPAREN SEMICOLON */
+#line 3045 "dbcc-parser-p.lemon"
+{ DBCC_Statement *dw = dbcc_statement_new_do_while (statement_from_list (&yymsp[-5].minor.yy245),
+                                                            yymsp[-2].minor.yy101,
+                                                            yymsp[-6].minor.yy0.code_position,
+                                                            &context->error);
+          if (dw == NULL) 
+            FAIL();
+          p_statement_list_init1 (&yylhsminor.yy245, dw); }
+#line 5855 "dbcc-parser-p.c"
+  yymsp[-6].minor.yy245 = yylhsminor.yy245;
+        break;
+      case 239: /* iteration_statement ::= FOR LPAREN expression_statement expression_statement opt_expression RPAREN statement */
+#line 3053 "dbcc-parser-p.lemon"
+{ DBCC_Expr *expr = NULL;
+          if (yymsp[-3].minor.yy245.first != NULL)
+            {
+              if (yymsp[-3].minor.yy245.first->next != NULL)
+                assert(0);
+
+              DBCC_Statement *cond_stmt = yymsp[-3].minor.yy245.first->statement;
+              if (cond_stmt->type == DBCC_STATEMENT_EXPR)
+                expr = cond_stmt->v_expr.expr;
+              else
+                {
+                  context->error = dbcc_error_new (DBCC_ERROR_EXPECTED_EXPRESSION,
+                                                   "non-expression in condition for 'for' loop");
+                  dbcc_error_add_code_position (context->error, cond_stmt->base.code_position);
+                  FAIL();
+                }
+            }
+          DBCC_Statement *adv = yymsp[-2].minor.yy101 == NULL ? NULL : dbcc_statement_new_expr (yymsp[-2].minor.yy101);
+          DBCC_Statement *f = dbcc_statement_new_for (statement_from_list (&yymsp[-4].minor.yy245),
+                                                      expr,
+                                                      adv,
+                                                      statement_from_list(&yymsp[0].minor.yy245),
+                                                      yymsp[-6].minor.yy0.code_position,
+                                                      &context->error);
+          if (f == NULL) 
+            FAIL();
+          p_statement_list_init1 (&yylhsminor.yy245, f); }
+#line 5887 "dbcc-parser-p.c"
+  yymsp[-6].minor.yy245 = yylhsminor.yy245;
+        break;
+      case 240: /* iteration_statement ::= FOR LPAREN declaration expression_statement opt_expression RPAREN statement */
+#line 3082 "dbcc-parser-p.lemon"
+{ DBCC_Expr *expr = NULL;
+          if (yymsp[-3].minor.yy245.first != NULL)
+            {
+              if (yymsp[-3].minor.yy245.first->next != NULL)
+                assert(0);
+
+              DBCC_Statement *cond_stmt = yymsp[-3].minor.yy245.first->statement;
+              if (cond_stmt->type == DBCC_STATEMENT_EXPR)
+                expr = cond_stmt->v_expr.expr;
+              else
+                {
+                  context->error = dbcc_error_new (DBCC_ERROR_EXPECTED_EXPRESSION,
+                                                   "non-expression in condition for 'for' loop");
+                  dbcc_error_add_code_position (context->error, cond_stmt->base.code_position);
+                  FAIL();
+                }
+            }
+
+          DBCC_Statement *adv = yymsp[-2].minor.yy101 == NULL ? NULL : dbcc_statement_new_expr (yymsp[-2].minor.yy101);
+          P_StatementList init;
+          declaration_to_statement_list (context, yymsp[-4].minor.yy212, &init);
+          DBCC_Statement *f = dbcc_statement_new_for (statement_from_list(&init),
+                                                      expr,
+                                                      adv,
+                                                      statement_from_list(&yymsp[0].minor.yy245),
+                                                      yymsp[-6].minor.yy0.code_position,
+                                                      &context->error);
+          if (f == NULL)
+            FAIL();
+          p_statement_list_init1 (&yylhsminor.yy245, f); }
+#line 5922 "dbcc-parser-p.c"
+  yymsp[-6].minor.yy245 = yylhsminor.yy245;
+        break;
+      case 241: /* jump_statement ::= GOTO IDENTIFIER SEMICOLON */
+#line 3113 "dbcc-parser-p.lemon"
+{ p_statement_list_init1 (&yylhsminor.yy245, dbcc_statement_new_goto (yymsp[-1].minor.yy0.v_identifier, yymsp[-2].minor.yy0.code_position)); }
+#line 5928 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy245 = yylhsminor.yy245;
+        break;
+      case 242: /* jump_statement ::= CONTINUE SEMICOLON */
+#line 3115 "dbcc-parser-p.lemon"
+{ p_statement_list_init1 (&yylhsminor.yy245, dbcc_statement_new_continue (yymsp[-1].minor.yy0.code_position)); }
+#line 5934 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy245 = yylhsminor.yy245;
+        break;
+      case 243: /* jump_statement ::= BREAK SEMICOLON */
+#line 3117 "dbcc-parser-p.lemon"
+{ p_statement_list_init1 (&yylhsminor.yy245, dbcc_statement_new_break (yymsp[-1].minor.yy0.code_position)); }
+#line 5940 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy245 = yylhsminor.yy245;
+        break;
+      case 244: /* jump_statement ::= RETURN SEMICOLON */
+#line 3119 "dbcc-parser-p.lemon"
+{ DBCC_Statement *statement = dbcc_statement_new_return (NULL, yymsp[-1].minor.yy0.code_position, &context->error);
+          if (statement == NULL)
+            FAIL();
+          p_statement_list_init1 (&yylhsminor.yy245, statement); }
+#line 5949 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy245 = yylhsminor.yy245;
+        break;
+      case 245: /* jump_statement ::= RETURN expression SEMICOLON */
+#line 3124 "dbcc-parser-p.lemon"
+{ DBCC_Statement *statement = dbcc_statement_new_return (yymsp[-1].minor.yy101, yymsp[-2].minor.yy0.code_position, &context->error);
+          if (statement == NULL)
+            FAIL();
+          p_statement_list_init1 (&yylhsminor.yy245, statement); }
+#line 5958 "dbcc-parser-p.c"
+  yymsp[-2].minor.yy245 = yylhsminor.yy245;
+        break;
+      case 246: /* external_declaration_list ::= external_declaration */
+      case 252: /* declaration_list ::= declaration */ yytestcase(yyruleno==252);
+#line 3130 "dbcc-parser-p.lemon"
+{ yylhsminor.yy234.first_declaration = yylhsminor.yy234.last_declaration = yymsp[0].minor.yy212; }
+#line 5965 "dbcc-parser-p.c"
+  yymsp[0].minor.yy234 = yylhsminor.yy234;
+        break;
+      case 247: /* external_declaration_list ::= external_declaration_list external_declaration */
+      case 253: /* declaration_list ::= declaration_list declaration */ yytestcase(yyruleno==253);
+#line 3132 "dbcc-parser-p.lemon"
+{ yylhsminor.yy234 = yymsp[-1].minor.yy234;
+          yylhsminor.yy234.last_declaration->next = yymsp[0].minor.yy212;
+          yylhsminor.yy234.last_declaration = yymsp[0].minor.yy212; }
+#line 5974 "dbcc-parser-p.c"
+  yymsp[-1].minor.yy234 = yylhsminor.yy234;
+        break;
+      case 248: /* translation_unit ::= external_declaration_list */
+      case 255: /* opt_declaration_list ::= declaration_list */ yytestcase(yyruleno==255);
+#line 3137 "dbcc-parser-p.lemon"
+{ yylhsminor.yy234 = yymsp[0].minor.yy234; }
+#line 5981 "dbcc-parser-p.c"
+  yymsp[0].minor.yy234 = yylhsminor.yy234;
+        break;
+      case 249: /* external_declaration ::= function_definition */
+      case 250: /* external_declaration ::= declaration */ yytestcase(yyruleno==250);
+#line 3140 "dbcc-parser-p.lemon"
+{ yylhsminor.yy212 = yymsp[0].minor.yy212;
+          if (!p_context_declare_globals (context, yylhsminor.yy212))
+            FAIL(); }
+#line 5990 "dbcc-parser-p.c"
+  yymsp[0].minor.yy212 = yylhsminor.yy212;
+        break;
+      case 251: /* function_definition ::= declaration_specifiers declarator opt_declaration_list compound_statement */
+#line 3150 "dbcc-parser-p.lemon"
+{ yylhsminor.yy212 = yymsp[-3].minor.yy212;
+          p_declaration_append_declarator(yylhsminor.yy212, yymsp[-2].minor.yy307);
+          yymsp[-3].minor.yy212 = NULL;
+          if (yymsp[-1].minor.yy234.first_declaration != NULL)
+            {
+              assert(0);  // K+R not supported yet
+              //... function must have identifier-list (not declarator list)
+              //... names must match
+              //... convert function arg-list into declration_list
+            }
+          assert(yylhsminor.yy212->v_declaration.body == NULL);
+          assert(yymsp[0].minor.yy245.first != NULL);
+          assert(yymsp[0].minor.yy245.first->next == NULL);
+          DBCC_Statement *body_stmt = yymsp[0].minor.yy245.first->statement;
+          assert(body_stmt->type == DBCC_STATEMENT_COMPOUND);
+          yylhsminor.yy212->v_declaration.body = body_stmt;
+        }
+#line 6012 "dbcc-parser-p.c"
+  yymsp[-3].minor.yy212 = yylhsminor.yy212;
+        break;
+      case 254: /* opt_declaration_list ::= */
+#line 3177 "dbcc-parser-p.lemon"
+{ yymsp[1].minor.yy234.first_declaration = yymsp[1].minor.yy234.last_declaration = NULL; }
+#line 6018 "dbcc-parser-p.c"
+        break;
+      default:
+      /* (256) optional_comma ::= COMMA */ yytestcase(yyruleno==256);
+      /* (257) optional_comma ::= */ yytestcase(yyruleno==257);
+      /* (258) opt_comma ::= */ yytestcase(yyruleno==258);
+      /* (259) opt_comma ::= COMMA */ yytestcase(yyruleno==259);
+        break;
+/********** End reduce actions ************************************************/
+  };
+  assert( yyruleno<sizeof(yyRuleInfo)/sizeof(yyRuleInfo[0]) );
+  yygoto = yyRuleInfo[yyruleno].lhs;
+  yysize = yyRuleInfo[yyruleno].nrhs;
+  yyact = yy_find_reduce_action(yymsp[yysize].stateno,(YYCODETYPE)yygoto);
+
+  /* There are no SHIFTREDUCE actions on nonterminals because the table
+  ** generator has simplified them to pure REDUCE actions. */
+  assert( !(yyact>YY_MAX_SHIFT && yyact<=YY_MAX_SHIFTREDUCE) );
+
+  /* It is not possible for a REDUCE to be followed by an error */
+  assert( yyact!=YY_ERROR_ACTION );
+
+  yymsp += yysize+1;
+  yypParser->yytos = yymsp;
+  yymsp->stateno = (YYACTIONTYPE)yyact;
+  yymsp->major = (YYCODETYPE)yygoto;
+  yyTraceShift(yypParser, yyact, "... then shift");
+}
+
+/*
+** The following code executes when the parse fails
+*/
+#ifndef YYNOERRORRECOVERY
+static void yy_parse_failed(
+  yyParser *yypParser           /* The parser */
+){
+  DBCC_Lemon_ParserARG_FETCH;
+#ifndef NDEBUG
+  if( yyTraceFILE ){
+    fprintf(yyTraceFILE,"%sFail!\n",yyTracePrompt);
+  }
+#endif
+  while( yypParser->yytos>yypParser->yystack ) yy_pop_parser_stack(yypParser);
+  /* Here code is inserted which will be executed whenever the
+  ** parser fails */
+/************ Begin %parse_failure code ***************************************/
+/************ End %parse_failure code *****************************************/
+  DBCC_Lemon_ParserARG_STORE; /* Suppress warning about unused %extra_argument variable */
+}
+#endif /* YYNOERRORRECOVERY */
+
+/*
+** The following code executes when a syntax error first occurs.
+*/
+static void yy_syntax_error(
+  yyParser *yypParser,           /* The parser */
+  int yymajor,                   /* The major type of the error token */
+  DBCC_Lemon_ParserTOKENTYPE yyminor         /* The minor type of the error token */
+){
+  DBCC_Lemon_ParserARG_FETCH;
+#define TOKEN yyminor
+/************ Begin %syntax_error code ****************************************/
+#line 88 "dbcc-parser-p.lemon"
+
+  (void) yymajor;
+  if (context->error == NULL)
+    {
+      context->error = dbcc_error_new (DBCC_ERROR_SYNTAX, "syntax error");
+      if (yyminor.code_position != NULL)
+        dbcc_error_add_code_position (context->error, yyminor.code_position);
+    }
+#line 6089 "dbcc-parser-p.c"
+/************ End %syntax_error code ******************************************/
+  DBCC_Lemon_ParserARG_STORE; /* Suppress warning about unused %extra_argument variable */
+}
+
+/*
+** The following is executed when the parser accepts
+*/
+static void yy_accept(
+  yyParser *yypParser           /* The parser */
+){
+  DBCC_Lemon_ParserARG_FETCH;
+#ifndef NDEBUG
+  if( yyTraceFILE ){
+    fprintf(yyTraceFILE,"%sAccept!\n",yyTracePrompt);
+  }
+#endif
+#ifndef YYNOERRORRECOVERY
+  yypParser->yyerrcnt = -1;
+#endif
+  assert( yypParser->yytos==yypParser->yystack );
+  /* Here code is inserted which will be executed whenever the
+  ** parser accepts */
+/*********** Begin %parse_accept code *****************************************/
+/*********** End %parse_accept code *******************************************/
+  DBCC_Lemon_ParserARG_STORE; /* Suppress warning about unused %extra_argument variable */
+}
+
+/* The main parser program.
+** The first argument is a pointer to a structure obtained from
+** "DBCC_Lemon_ParserAlloc" which describes the current state of the parser.
+** The second argument is the major token number.  The third is
+** the minor token.  The fourth optional argument is whatever the
+** user wants (and specified in the grammar) and is available for
+** use by the action routines.
+**
+** Inputs:
+** <ul>
+** <li> A pointer to the parser (an opaque structure.)
+** <li> The major token number.
+** <li> The minor token number.
+** <li> An option argument of a grammar-specified type.
+** </ul>
+**
+** Outputs:
+** None.
+*/
+void DBCC_Lemon_Parser(
+  void *yyp,                   /* The parser */
+  int yymajor,                 /* The major token code number */
+  DBCC_Lemon_ParserTOKENTYPE yyminor       /* The value for the token */
+  DBCC_Lemon_ParserARG_PDECL               /* Optional %extra_argument parameter */
+){
+  YYMINORTYPE yyminorunion;
+  unsigned int yyact;   /* The parser action. */
+#if !defined(YYERRORSYMBOL) && !defined(YYNOERRORRECOVERY)
+  int yyendofinput;     /* True if we are at the end of input */
+#endif
+#ifdef YYERRORSYMBOL
+  int yyerrorhit = 0;   /* True if yymajor has invoked an error */
+#endif
+  yyParser *yypParser;  /* The parser */
+
+  yypParser = (yyParser*)yyp;
+  assert( yypParser->yytos!=0 );
+#if !defined(YYERRORSYMBOL) && !defined(YYNOERRORRECOVERY)
+  yyendofinput = (yymajor==0);
+#endif
+  DBCC_Lemon_ParserARG_STORE;
+
+#ifndef NDEBUG
+  if( yyTraceFILE ){
+    int stateno = yypParser->yytos->stateno;
+    if( stateno < YY_MIN_REDUCE ){
+      fprintf(yyTraceFILE,"%sInput '%s' in state %d\n",
+              yyTracePrompt,yyTokenName[yymajor],stateno);
+    }else{
+      fprintf(yyTraceFILE,"%sInput '%s' with pending reduce %d\n",
+              yyTracePrompt,yyTokenName[yymajor],stateno-YY_MIN_REDUCE);
+    }
+  }
+#endif
+
+  do{
+    yyact = yy_find_shift_action(yypParser,(YYCODETYPE)yymajor);
+    if( yyact >= YY_MIN_REDUCE ){
+      yy_reduce(yypParser,yyact-YY_MIN_REDUCE,yymajor,yyminor);
+    }else if( yyact <= YY_MAX_SHIFTREDUCE ){
+      yy_shift(yypParser,yyact,yymajor,yyminor);
+#ifndef YYNOERRORRECOVERY
+      yypParser->yyerrcnt--;
+#endif
+      yymajor = YYNOCODE;
+    }else if( yyact==YY_ACCEPT_ACTION ){
+      yypParser->yytos--;
+      yy_accept(yypParser);
+      return;
+    }else{
+      assert( yyact == YY_ERROR_ACTION );
+      yyminorunion.yy0 = yyminor;
+#ifdef YYERRORSYMBOL
+      int yymx;
+#endif
+#ifndef NDEBUG
+      if( yyTraceFILE ){
+        fprintf(yyTraceFILE,"%sSyntax Error!\n",yyTracePrompt);
+      }
+#endif
+#ifdef YYERRORSYMBOL
+      /* A syntax error has occurred.
+      ** The response to an error depends upon whether or not the
+      ** grammar defines an error token "ERROR".  
+      **
+      ** This is what we do if the grammar does define ERROR:
+      **
+      **  * Call the %syntax_error function.
+      **
+      **  * Begin popping the stack until we enter a state where
+      **    it is legal to shift the error symbol, then shift
+      **    the error symbol.
+      **
+      **  * Set the error count to three.
+      **
+      **  * Begin accepting and shifting new tokens.  No new error
+      **    processing will occur until three tokens have been
+      **    shifted successfully.
+      **
+      */
+      if( yypParser->yyerrcnt<0 ){
+        yy_syntax_error(yypParser,yymajor,yyminor);
+      }
+      yymx = yypParser->yytos->major;
+      if( yymx==YYERRORSYMBOL || yyerrorhit ){
+#ifndef NDEBUG
+        if( yyTraceFILE ){
+          fprintf(yyTraceFILE,"%sDiscard input token %s\n",
+             yyTracePrompt,yyTokenName[yymajor]);
+        }
+#endif
+        yy_destructor(yypParser, (YYCODETYPE)yymajor, &yyminorunion);
+        yymajor = YYNOCODE;
+      }else{
+        while( yypParser->yytos >= yypParser->yystack
+            && yymx != YYERRORSYMBOL
+            && (yyact = yy_find_reduce_action(
+                        yypParser->yytos->stateno,
+                        YYERRORSYMBOL)) >= YY_MIN_REDUCE
+        ){
+          yy_pop_parser_stack(yypParser);
+        }
+        if( yypParser->yytos < yypParser->yystack || yymajor==0 ){
+          yy_destructor(yypParser,(YYCODETYPE)yymajor,&yyminorunion);
+          yy_parse_failed(yypParser);
+#ifndef YYNOERRORRECOVERY
+          yypParser->yyerrcnt = -1;
+#endif
+          yymajor = YYNOCODE;
+        }else if( yymx!=YYERRORSYMBOL ){
+          yy_shift(yypParser,yyact,YYERRORSYMBOL,yyminor);
+        }
+      }
+      yypParser->yyerrcnt = 3;
+      yyerrorhit = 1;
+#elif defined(YYNOERRORRECOVERY)
+      /* If the YYNOERRORRECOVERY macro is defined, then do not attempt to
+      ** do any kind of error recovery.  Instead, simply invoke the syntax
+      ** error routine and continue going as if nothing had happened.
+      **
+      ** Applications can set this macro (for example inside %include) if
+      ** they intend to abandon the parse upon the first syntax error seen.
+      */
+      yy_syntax_error(yypParser,yymajor, yyminor);
+      yy_destructor(yypParser,(YYCODETYPE)yymajor,&yyminorunion);
+      yymajor = YYNOCODE;
+      
+#else  /* YYERRORSYMBOL is not defined */
+      /* This is what we do if the grammar does not define ERROR:
+      **
+      **  * Report an error message, and throw away the input token.
+      **
+      **  * If the input token is $, then fail the parse.
+      **
+      ** As before, subsequent error messages are suppressed until
+      ** three input tokens have been successfully shifted.
+      */
+      if( yypParser->yyerrcnt<=0 ){
+        yy_syntax_error(yypParser,yymajor, yyminor);
+      }
+      yypParser->yyerrcnt = 3;
+      yy_destructor(yypParser,(YYCODETYPE)yymajor,&yyminorunion);
+      if( yyendofinput ){
+        yy_parse_failed(yypParser);
+#ifndef YYNOERRORRECOVERY
+        yypParser->yyerrcnt = -1;
+#endif
+      }
+      yymajor = YYNOCODE;
+#endif
+    }
+  }while( yymajor!=YYNOCODE && yypParser->yytos>yypParser->yystack );
+#ifndef NDEBUG
+  if( yyTraceFILE ){
+    yyStackEntry *i;
+    char cDiv = '[';
+    fprintf(yyTraceFILE,"%sReturn. Stack=",yyTracePrompt);
+    for(i=&yypParser->yystack[1]; i<=yypParser->yytos; i++){
+      fprintf(yyTraceFILE,"%c%s", cDiv, yyTokenName[i->major]);
+      cDiv = ' ';
+    }
+    fprintf(yyTraceFILE,"]\n");
+  }
+#endif
+  return;
+}
@@ -0,0 +1,101 @@
+#define P_TOKEN_IDENTIFIER                       1
+#define P_TOKEN_I_CONSTANT                       2
+#define P_TOKEN_F_CONSTANT                       3
+#define P_TOKEN_ENUMERATION_CONSTANT             4
+#define P_TOKEN_CHAR_CONSTANT                    5
+#define P_TOKEN_LPAREN                           6
+#define P_TOKEN_RPAREN                           7
+#define P_TOKEN_STRING_LITERAL                   8
+#define P_TOKEN_FUNC_NAME                        9
+#define P_TOKEN_GENERIC                         10
+#define P_TOKEN_COMMA                           11
+#define P_TOKEN_COLON                           12
+#define P_TOKEN_DEFAULT                         13
+#define P_TOKEN_LBRACKET                        14
+#define P_TOKEN_RBRACKET                        15
+#define P_TOKEN_PERIOD                          16
+#define P_TOKEN_POINTER_ACCESS                  17
+#define P_TOKEN_INCREMENT                       18
+#define P_TOKEN_DECREMENT                       19
+#define P_TOKEN_LBRACE                          20
+#define P_TOKEN_RBRACE                          21
+#define P_TOKEN_INC_OP                          22
+#define P_TOKEN_DEC_OP                          23
+#define P_TOKEN_SIZEOF                          24
+#define P_TOKEN_ALIGNOF                         25
+#define P_TOKEN_AMPERSAND                       26
+#define P_TOKEN_ASTERISK                        27
+#define P_TOKEN_PLUS                            28
+#define P_TOKEN_MINUS                           29
+#define P_TOKEN_TILDE                           30
+#define P_TOKEN_EXCLAMATION_POINT               31
+#define P_TOKEN_SLASH                           32
+#define P_TOKEN_PERCENT                         33
+#define P_TOKEN_SHIFT_LEFT                      34
+#define P_TOKEN_SHIFT_RIGHT                     35
+#define P_TOKEN_LESS_THAN                       36
+#define P_TOKEN_GREATER_THAN                    37
+#define P_TOKEN_LE                              38
+#define P_TOKEN_GE                              39
+#define P_TOKEN_IS_EQUAL_TO                     40
+#define P_TOKEN_NOT_EQUAL_TO                    41
+#define P_TOKEN_CARAT                           42
+#define P_TOKEN_VERTICAL_BAR                    43
+#define P_TOKEN_LOGICAL_AND                     44
+#define P_TOKEN_LOGICAL_OR                      45
+#define P_TOKEN_QUESTION_MARK                   46
+#define P_TOKEN_EQUAL_SIGN                      47
+#define P_TOKEN_MULTIPLY_ASSIGN                 48
+#define P_TOKEN_DIVIDE_ASSIGN                   49
+#define P_TOKEN_REMAINDER_ASSIGN                50
+#define P_TOKEN_ADD_ASSIGN                      51
+#define P_TOKEN_SUBTRACT_ASSIGN                 52
+#define P_TOKEN_SHIFT_LEFT_ASSIGN               53
+#define P_TOKEN_SHIFT_RIGHT_ASSIGN              54
+#define P_TOKEN_BITWISE_AND_ASSIGN              55
+#define P_TOKEN_BITWISE_XOR_ASSIGN              56
+#define P_TOKEN_BITWISE_OR_ASSIGN               57
+#define P_TOKEN_SEMICOLON                       58
+#define P_TOKEN_EQUALS                          59
+#define P_TOKEN_TYPEDEF                         60
+#define P_TOKEN_EXTERN                          61
+#define P_TOKEN_STATIC                          62
+#define P_TOKEN_THREAD_LOCAL                    63
+#define P_TOKEN_AUTO                            64
+#define P_TOKEN_REGISTER                        65
+#define P_TOKEN_VOID                            66
+#define P_TOKEN_CHAR                            67
+#define P_TOKEN_INT                             68
+#define P_TOKEN_SHORT                           69
+#define P_TOKEN_LONG                            70
+#define P_TOKEN_FLOAT                           71
+#define P_TOKEN_DOUBLE                          72
+#define P_TOKEN_SIGNED                          73
+#define P_TOKEN_UNSIGNED                        74
+#define P_TOKEN_BOOL                            75
+#define P_TOKEN_COMPLEX                         76
+#define P_TOKEN_IMAGINARY                       77
+#define P_TOKEN_ATOMIC                          78
+#define P_TOKEN_TYPEDEF_NAME                    79
+#define P_TOKEN_STRUCT                          80
+#define P_TOKEN_UNION                           81
+#define P_TOKEN_ENUM                            82
+#define P_TOKEN_CONST                           83
+#define P_TOKEN_RESTRICT                        84
+#define P_TOKEN_VOLATILE                        85
+#define P_TOKEN_INLINE                          86
+#define P_TOKEN_NORETURN                        87
+#define P_TOKEN_ALIGNAS                         88
+#define P_TOKEN_ELLIPSIS                        89
+#define P_TOKEN_STATIC_ASSERT                   90
+#define P_TOKEN_CASE                            91
+#define P_TOKEN_IF                              92
+#define P_TOKEN_ELSE                            93
+#define P_TOKEN_SWITCH                          94
+#define P_TOKEN_WHILE                           95
+#define P_TOKEN_DO                              96
+#define P_TOKEN_FOR                             97
+#define P_TOKEN_GOTO                            98
+#define P_TOKEN_CONTINUE                        99
+#define P_TOKEN_BREAK                          100
+#define P_TOKEN_RETURN                         101
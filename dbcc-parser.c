@@ -6,7 +6,8 @@
  * See the C11 Spec 5.1.1.2, but here's a
  * brief descriptions of the phases:
  *     1.  Character set handling, newline normalizing, and trigraph sequences.
- *     2.  backslash-newline:  this is handled as a line continuation character.
+ *     2.  backslash-newline:  this is handled as a line continuation character,
+ *         without copying the file (see "Phase 2: line splicing").
  *     3.  whitespace normalization and comments.
  *     4.  preprocessing directives, _Pragma expressions, #include.
  *     5.  conversion from source character set to target character set
@@ -90,10 +91,8 @@ typedef enum
   CPP_TOKEN_MACRO_ARGUMENT
 } CPP_TokenType;
 
-#define DUMP_CPP_TOKENS 1
+#define DUMP_CPP_TOKENS 0
 
-
-#if DUMP_CPP_TOKENS
 static const char *cpp_token_type_name (CPP_TokenType type)
 {
   switch (type)
@@ -111,7 +110,6 @@ static const char *cpp_token_type_name (CPP_TokenType type)
     default:  return "*unknown-cpp-token-type*";
     }
 }
-#endif
 
 typedef struct CPP_Token CPP_Token;
 typedef struct CPP_Macro CPP_Macro;
@@ -140,8 +138,13 @@ struct CPP_TokenArray
   unsigned n;
   CPP_Token *tokens;
   unsigned tokens_alloced;
+
+  /* copies of tokens interrupted by a backslash-newline;
+     see tokenize_directive_line() */
+  char *spliced;
+  size_t n_spliced;
 };
-#define CPP_TOKEN_ARRAY_INIT {0,NULL,0}
+#define CPP_TOKEN_ARRAY_INIT {0,NULL,0,NULL,0}
 
 static void
 cpp_token_array_append (CPP_TokenArray *arr, CPP_Token *token)
@@ -192,6 +195,130 @@ struct CPP_Expr
 };
 static CPP_Expr *copy_cpp_expr_densely (CPP_Expr *expr);
 
+/* A function definition whose parsing has been deferred;
+ * see lazy_filter_token().
+ */
+/* What a bareword in a deferred definition named in the global
+ * namespace when the definition was seen:  typedefs and enum values
+ * declared later in the file must not change how it parses.
+ */
+typedef struct LazyBareword LazyBareword;
+struct LazyBareword
+{
+  bool is_bound;
+  DBCC_NamespaceEntry ns_entry;
+};
+
+typedef struct LazyFunctionBody LazyFunctionBody;
+struct LazyFunctionBody
+{
+  DBCC_Symbol *name;
+  bool is_static;
+  bool needed;
+  bool emitted;
+  unsigned n_tokens;            /* entire definition, including declarator */
+  CPP_Token *tokens;            /* followed by 'barewords', then the tokens' strings */
+  LazyBareword *barewords;      /* parallel to 'tokens' */
+};
+
+typedef enum
+{
+  LAZY_MODE_PENDING,            /* buffering a toplevel declaration */
+  LAZY_MODE_PASS_BODY,          /* function body that can't be deferred */
+  LAZY_MODE_CAPTURE_BODY,       /* saving a deferred function body */
+} LazyMode;
+
+typedef struct LazyState LazyState;
+struct LazyState
+{
+  LazyMode mode;
+  CPP_TokenArray pending;
+  unsigned brace_depth;
+  unsigned paren_depth;
+  bool saw_equals;
+  DBCC_Symbol *capturing_name;
+  bool capturing_is_static;
+
+  DBCC_PtrTable bodies_by_name;         /* name => latest LazyFunctionBody */
+
+  /* Names used by code passed to the parser, including names
+   * whose definitions have not been seen yet. */
+  DBCC_PtrTable referenced;
+  DBCC_Symbol *declaring_name;          /* not a use, while set */
+  size_t n_bodies;
+  LazyFunctionBody **bodies;
+  size_t bodies_alloced;
+
+  /* for dbcc_parser_get_stats() */
+  size_t n_deferred;
+  size_t n_materialized;
+};
+
+/* A compiled #if/#elif expression, in postfix form.
+ * Identifiers are kept as symbols, so that a cached compilation
+ * stays valid as macros are defined and undefined.
+ */
+typedef enum
+{
+  CPP_OP_CONST,
+  CPP_OP_DEFINED,               /* 1 if v_symbol is a macro */
+  CPP_OP_MACRO_VALUE,           /* integer value of v_symbol, or 0 */
+  CPP_OP_NEGATE,
+  CPP_OP_BANG,
+  CPP_OP_TILDE,
+  CPP_OP_STAR,
+  CPP_OP_SLASH,
+  CPP_OP_PERCENT,
+  CPP_OP_PLUS,
+  CPP_OP_MINUS,
+  CPP_OP_LTLT,
+  CPP_OP_GTGT,
+  CPP_OP_LT,
+  CPP_OP_GT,
+  CPP_OP_LTEQ,
+  CPP_OP_GTEQ,
+  CPP_OP_EQ,
+  CPP_OP_NEQ,
+  CPP_OP_BITWISE_AND,
+  CPP_OP_BITWISE_XOR,
+  CPP_OP_BITWISE_OR,
+  CPP_OP_LOGICAL_AND,
+  CPP_OP_LOGICAL_OR,
+} CPP_OpCode;
+
+typedef struct CPP_Op CPP_Op;
+struct CPP_Op
+{
+  CPP_OpCode opcode;
+  union {
+    int64_t v_const;
+    DBCC_Symbol *v_symbol;
+  };
+};
+
+typedef struct CPP_CompiledExpr CPP_CompiledExpr;
+struct CPP_CompiledExpr
+{
+  /* cache key: location of the first token of the expression */
+  DBCC_Symbol *filename;
+  unsigned byte_offset;
+
+  /* The expression's tokens, each followed by '\n'.
+   * A file that is parsed again (eg an edited document)
+   * may have a different expression at the same offset. */
+  size_t text_length;
+  char *text;
+
+  /* n_ops==0 means the expression could not be compiled,
+   * so eval_cpp_expr_boolean() must always take the slow path. */
+  unsigned n_ops;
+  CPP_Op *ops;
+  unsigned max_stack;
+
+  CPP_CompiledExpr *left, *right, *parent;
+  bool is_red;
+};
+
 struct DBCC_Parser
 {
   unsigned magic;
@@ -209,8 +336,28 @@ struct DBCC_Parser
   size_t include_dirs_alloced;
 
   CPP_Macro *macro_tree;
+
+  /* Files that are entirely wrapped in an #ifndef X ... #endif
+   * map filename-symbol => the guard macro X; files with
+   * #pragma once map to their own filename-symbol.
+   * Either way, they need not be reread while the guard holds.
+   */
+  DBCC_PtrTable include_guards;
+
+  /* #if/#elif expressions compiled to postfix, by (filename, offset) */
+  CPP_CompiledExpr *compiled_expr_tree;
+
+  bool lazy_function_bodies;
+  LazyState lazy;
+
+  /* filename-symbol => DBCC_ParserDocument, for incremental reparsing */
+  DBCC_PtrTable documents;
+
+  /* Nodes built while parsing; current only inside dbcc_parser_parse_file() */
+  DBCC_Region *region;
 };
-#define COMPARE_CPP_MACROS(a,b, rv) rv = (a<b) ? -1 : (a>b) ? 1 : 0
+#define COMPARE_CPP_MACROS(a,b, rv) \
+  rv = ((a)->name < (b)->name) ? -1 : ((a)->name > (b)->name) ? 1 : 0
 #define GET_MACRO_TREE(parser) \
  (parser)->macro_tree,         \
  CPP_Macro *,                  \
@@ -218,6 +365,19 @@ struct DBCC_Parser
  DSK_STD_SET_IS_RED,           \
  parent, left, right,          \
  COMPARE_CPP_MACROS
+#define COMPARE_COMPILED_EXPRS(a,b, rv) \
+  rv = ((a)->filename < (b)->filename) ? -1   \
+     : ((a)->filename > (b)->filename) ? 1    \
+     : ((a)->byte_offset < (b)->byte_offset) ? -1 \
+     : ((a)->byte_offset > (b)->byte_offset) ? 1 \
+     : 0
+#define GET_COMPILED_EXPR_TREE(parser) \
+ (parser)->compiled_expr_tree,         \
+ CPP_CompiledExpr *,                   \
+ DSK_STD_GET_IS_RED,                   \
+ DSK_STD_SET_IS_RED,                   \
+ parent, left, right,                  \
+ COMPARE_COMPILED_EXPRS
 
 #define parser_get_ns(parser)      ((parser)->globals)
 
@@ -232,12 +392,25 @@ dbcc_parser_new             (DBCC_Parser_NewOptions *new_options)
   rv->handlers.handle_destroy = new_options->handle_destroy;
   rv->handler_data = new_options->handler_data;
   dsk_buffer_init (&rv->buffer);
-  rv->globals = dbcc_namespace_new_global (new_options->target_env);
+  rv->globals = dbcc_namespace_new_global (new_options->target_env,
+                                           new_options->symbol_space);
   rv->context = p_context_new (rv->globals);
   rv->lemon_parser = DBCC_Lemon_ParserAlloc(malloc);
+  rv->symbol_space = rv->globals->symbol_space;
+  rv->target_environment = new_options->target_env;
   rv->n_include_dirs = 0;
   rv->include_dirs = NULL;
   rv->include_dirs_alloced = 0;
+  rv->macro_tree = NULL;
+  dbcc_ptr_table_init (&rv->include_guards);
+  rv->compiled_expr_tree = NULL;
+  rv->lazy_function_bodies = new_options->lazy_function_bodies;
+  memset (&rv->lazy, 0, sizeof (LazyState));
+  rv->lazy.mode = LAZY_MODE_PENDING;
+  dbcc_ptr_table_init (&rv->lazy.bodies_by_name);
+  dbcc_ptr_table_init (&rv->lazy.referenced);
+  dbcc_ptr_table_init (&rv->documents);
+  rv->region = dbcc_region_new ();
   return rv;
 }
 
@@ -262,6 +435,7 @@ dbcc_parser_add_include_dir (DBCC_Parser   *parser,
   parser->include_dirs[parser->n_include_dirs++] = strdup(dir);
 }
 
+/* On success, *str_inout is just past the closing star-slash. */
 static bool
 scan_multiline_comment_body (const char **str_inout,
                              const char  *end,
@@ -278,11 +452,19 @@ scan_multiline_comment_body (const char **str_inout,
     {
       if (*str == '*' && str + 1 < end && str[1] == '/')
         {
-          *str_inout = str;
+          *str_inout = str + 2;
           *line_no_out = line;
-          *column_out = col;
+          *column_out = col + 2;
           return true;
         }
+      if (*str == '\n')
+        {
+          line++;
+          col = 1;
+        }
+      else
+        col++;
+      str++;
     }
   return false;
 }
@@ -367,9 +549,15 @@ try_number(const char     *str,
                 RETURN_NUMBER(HEXADECIMAL_CONSTANT);
             }
           if (*at == '.')
-            goto got_binary_point;
+            {
+              at++;
+              goto got_binary_point;
+            }
           else if (*at == 'p' || *at == 'P')
-            goto got_p;
+            {
+              at++;
+              goto got_p;
+            }
           GOTO_END_OF_NUMBER(HEXADECIMAL_CONSTANT);
         }
       else if ('0' <= *at && *at <= '7')
@@ -451,7 +639,7 @@ got_decimal_point:
       at++;
       goto got_e;
     }
-  RETURN_NUMBER(DECIMAL_FLOATING_CONSTANT);
+  GOTO_END_OF_NUMBER(DECIMAL_FLOATING_CONSTANT);
 
 got_e:
   if (at == end)
@@ -500,13 +688,38 @@ got_p:
   GOTO_END_OF_NUMBER(HEXADECIMAL_FLOATING_CONSTANT);
 
 end_number:
-  if (at >= end)
-    return result;
-  if (isalnum (*at))
+  /* 6.4.4.1p1 integer-suffix:  u or U, and l, L, ll or LL, in either order.
+   * 6.4.4.2p1 floating-suffix:  one of f, F, l, L. */
+  switch (result.v_number.number_type)
     {
-      RETURN_ERROR(BAD_NUMBER_CONSTANT, "unexpected character after number");
-      ///XXX: error
+    case CPP_NUMBER_DECIMAL_CONSTANT:
+    case CPP_NUMBER_OCTAL_CONSTANT:
+    case CPP_NUMBER_HEXADECIMAL_CONSTANT:
+      {
+        bool got_u = false;
+        if (at < end && (*at == 'u' || *at == 'U'))
+          {
+            at++;
+            got_u = true;
+          }
+        if (at < end && (*at == 'l' || *at == 'L'))
+          {
+            if (at + 1 < end && at[1] == at[0])
+              at++;
+            at++;
+            if (!got_u && at < end && (*at == 'u' || *at == 'U'))
+              at++;
+          }
+      }
+      break;
+    default:
+      if (at < end && (*at == 'f' || *at == 'F' || *at == 'l' || *at == 'L'))
+        at++;
+      break;
     }
+  result.v_number.number_length = at - str;
+  if (at < end && (isalnum (*at) || *at == '_'))
+    RETURN_ERROR(BAD_NUMBER_CONSTANT, "unexpected character after number");
   return result;
 }
 
@@ -529,8 +742,8 @@ scan_bareword (const char *str, const char *end)
   while (at < end &&
       (*at == '_' ||
        ('0' <= *at && *at <= '9') ||
-       ('a' <= *at && *at <= 'f') ||
-       ('A' <= *at && *at <= 'F')))
+       ('a' <= *at && *at <= 'z') ||
+       ('A' <= *at && *at <= 'Z')))
     {
       at++;
     }
@@ -834,11 +1047,13 @@ scan_punctuator (const char *str, const char *end)
   do{ res.type = SCAN_PUNCTUATOR_RESULT_SUCCESS; \
       res.v_success.length = (n); \
       res.v_success.token_type = CPP_TOKEN_##tok_shortname; \
+      return res; \
     }while(0)
 #define RETURN_DIGRAPH(n, tok_shortname) \
   do{ res.type = SCAN_PUNCTUATOR_RESULT_SUCCESS_DIGRAPH; \
       res.v_success_digraph.length = (n); \
       res.v_success_digraph.token_type = CPP_TOKEN_##tok_shortname; \
+      return res; \
     }while(0)
   switch (*str)
     {
@@ -862,7 +1077,7 @@ scan_punctuator (const char *str, const char *end)
           case '=': RETURN(2, OPERATOR);
           case '>': RETURN_DIGRAPH(2, OPERATOR);
           case ':':  // either # or ## ... as digraphs
-            if (str + 3 < end && str[2] == '%' && str[2] == ':')
+            if (str + 3 < end && str[2] == '%' && str[3] == ':')
               // %:%:   which is equivalent to ##
               RETURN_DIGRAPH(4, CONCATENATE);
             else
@@ -971,7 +1186,7 @@ scan_punctuator (const char *str, const char *end)
       return res;
     }
 #undef RETURN
-#undef RETURN_TYPE
+#undef RETURN_DIGRAPH
 }
 
 static bool
@@ -1068,7 +1283,7 @@ lookup_macro (DBCC_Parser *parser,
               DBCC_Symbol *symbol)
 { 
 #define COMPARE_SYMBOL_TO_NODE(sym, node, rv) \
-  rv = (symbol < node->name) ? -1 : (symbol < node->name) ? 1 : 0
+  rv = (sym < node->name) ? -1 : (sym > node->name) ? 1 : 0
   CPP_Macro *rvmacro;
   DSK_RBTREE_LOOKUP_COMPARATOR(GET_MACRO_TREE(parser), symbol, COMPARE_SYMBOL_TO_NODE, rvmacro);
   return rvmacro;
@@ -1135,8 +1350,14 @@ scan_one_actual_macro_arg (unsigned       n_tokens,
   return false;
 }
 
+static CPP_MacroExpansionResult
+expand_macros (DBCC_Parser *parser,
+               unsigned     n_tokens,
+               CPP_Token   *tokens);
+
 static bool
-expand_1_function_macro (CPP_Macro   *macro,
+expand_1_function_macro (DBCC_Parser *parser,
+                         CPP_Macro   *macro,
                          unsigned    *i_inout,
                          unsigned     n_tokens,
                          CPP_Token   *tokens,
@@ -1162,6 +1383,21 @@ expand_1_function_macro (CPP_Macro   *macro,
       
   // parse actual arguments
   unsigned arg_index;
+  if (macro->arity == 0)
+    {
+      if (i >= n_tokens
+       || tokens[i].type != CPP_TOKEN_OPERATOR
+       || tokens[i].length != 1
+       || tokens[i].str[0] != ')')
+        {
+          *error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_MACRO_INVOCATION,
+                                   "macro %s takes no arguments",
+                                   dbcc_symbol_get_string(macro->name));
+          dbcc_error_add_code_position (*error, tokens[i < n_tokens ? i : i - 1].code_position);
+          return false;
+        }
+      i++;
+    }
   for (arg_index = 0; arg_index < macro->arity; arg_index++)
     {
       unsigned n_used;
@@ -1209,12 +1445,37 @@ expand_1_function_macro (CPP_Macro   *macro,
         {
           ArgSlice *slice = actual_args + macro->tokens[m_at].alt_int_value;
           CPP_Token *tok = tokens + slice->start;
+
+          /* Arguments are fully macro-expanded before substitution,
+           * unless they are the operand of # or ## (6.10.3.1). */
+          bool raw = (m_at > 0
+                      && (macro->tokens[m_at-1].type == CPP_TOKEN_HASH
+                       || macro->tokens[m_at-1].type == CPP_TOKEN_CONCATENATE))
+                  || (m_at + 1 < macro->n_tokens
+                      && macro->tokens[m_at+1].type == CPP_TOKEN_CONCATENATE);
+          if (!raw)
+            {
+              CPP_MacroExpansionResult res = expand_macros (parser, slice->count, tok);
+              if (res.type == CPP_MACRO_EXPANSION_RESULT_ERROR)
+                {
+                  *error = res.v_error.error;
+                  return false;
+                }
+              if (res.type == CPP_MACRO_EXPANSION_RESULT_SUCCESS)
+                {
+                  for (unsigned s_at = 0; s_at < res.v_success.n_expanded_tokens; s_at++)
+                    cpp_token_array_append (out, res.v_success.expanded_tokens + s_at);
+                  free (res.v_success.expanded_tokens);
+                  continue;
+                }
+            }
           for (unsigned s_at = 0; s_at < slice->count; s_at++, tok++)
             cpp_token_array_append (out, tok);
         }
       else
         cpp_token_array_append (out, macro->tokens + m_at);
     }
+  *i_inout = i;
   return true;
 }
 
@@ -1225,179 +1486,239 @@ can_concatenate_token_type (CPP_TokenType tt)
       || tt == CPP_TOKEN_NUMBER;
 }
 
+/* Is tokens[i] the name of a macro that should be expanded?
+ * The name of a function-like macro is only an invocation
+ * if it is followed by a left-paren (6.10.3p10).
+ */
+static CPP_Macro *
+get_expandable_macro (DBCC_Parser *parser,
+                      unsigned     i,
+                      unsigned     n_tokens,
+                      CPP_Token   *tokens)
+{
+  DBCC_Symbol *sym;
+  CPP_Macro *macro;
+  if (tokens[i].type != CPP_TOKEN_BAREWORD
+   || (sym=dbcc_symbol_space_try_len (parser->symbol_space, tokens[i].length, tokens[i].str)) == NULL
+   || (macro=lookup_macro (parser, sym)) == NULL
+   || macro->is_expanding)
+    return NULL;
+  if (macro->function_macro
+   && (i + 1 >= n_tokens
+    || tokens[i+1].type != CPP_TOKEN_OPERATOR
+    || tokens[i+1].length != 1
+    || tokens[i+1].str[0] != '('))
+    return NULL;
+  return macro;
+}
+
 static CPP_MacroExpansionResult
 expand_macros (DBCC_Parser *parser,
                unsigned     n_tokens,
                CPP_Token   *tokens)
 {
   CPP_MacroExpansionResult res;
-  DBCC_Symbol *sym;
-  CPP_Macro *macro = NULL;
+  CPP_Macro *macro;
   unsigned i, j;
   CPP_TokenArray token_array = CPP_TOKEN_ARRAY_INIT;
   for (i = 0; i < n_tokens; i++)
-    if (tokens[i].type == CPP_TOKEN_BAREWORD
-     && (sym=dbcc_symbol_space_try_len (parser->symbol_space, tokens[i].length, tokens[i].str)) != NULL
-     && (macro=lookup_macro (parser, sym)) != NULL
-     && !macro->is_expanding)
+    if (get_expandable_macro (parser, i, n_tokens, tokens) != NULL)
       break;
   if (i == n_tokens)
     {
       res.type = CPP_MACRO_EXPANSION_RESULT_NO_CHANGE;
       return res;
     }
-  assert(macro != NULL);
   for (j = 0; j < i; j++)
     cpp_token_array_append (&token_array, tokens + j);
-  for (    ; i < n_tokens; i++)
+  while (i < n_tokens)
     {
-      if (macro == NULL)
-        {
-          // is the current token a macro?
-          if (tokens[i].type == CPP_TOKEN_BAREWORD
-           && (sym=dbcc_symbol_space_try_len (parser->symbol_space, tokens[i].length, tokens[i].str)) != NULL
-           && (macro=lookup_macro (parser, sym)) != NULL
-           && !macro->is_expanding)
-            {
-              break;
-            }
-        }
-
+      macro = get_expandable_macro (parser, i, n_tokens, tokens);
       if (macro == NULL)
         {
           /* pass through */
           cpp_token_array_append (&token_array, tokens + i);
+          i++;
+          continue;
         }
-      else 
+
+      CPP_TokenArray sub = CPP_TOKEN_ARRAY_INIT;
+      if (macro->function_macro)
         {
-          CPP_TokenArray sub = CPP_TOKEN_ARRAY_INIT;
-          if (macro->function_macro)
-            {
-              DBCC_Error *error = NULL;
-              if (!expand_1_function_macro (macro, &i, n_tokens, tokens, &sub, &error))
-                {
-                  res.type = CPP_MACRO_EXPANSION_RESULT_ERROR;
-                  res.v_error.error = error;
-                  return res;
-                }
-            }
-          else
-            {
-              // single-token macro
-              for (unsigned m_at = 0; m_at < macro->n_tokens; m_at++)
-                cpp_token_array_append (&sub, macro->tokens + m_at);
-              i++;
-            }
-          
-          // Expand macros recursively,
-          // except we deliberately guard against literally
-          // recursing on the current macro.
-          assert(!macro->is_expanding);
-          macro->is_expanding = true;
-          res = expand_macros (parser, sub.n, sub.tokens);
-          macro->is_expanding = false;
-          switch (res.type)
+          DBCC_Error *error = NULL;
+          if (!expand_1_function_macro (parser, macro, &i, n_tokens, tokens, &sub, &error))
             {
-            case CPP_MACRO_EXPANSION_RESULT_SUCCESS:
-              for (unsigned t = 0; t < res.v_success.n_expanded_tokens; t++)
-                cpp_token_array_append (&token_array, &res.v_success.expanded_tokens[t]);
-              free (res.v_success.expanded_tokens);
-              break;
-            case CPP_MACRO_EXPANSION_RESULT_NO_CHANGE:
-              break;
-            case CPP_MACRO_EXPANSION_RESULT_ERROR:
+              free (sub.tokens);
+              free (token_array.tokens);
+              res.type = CPP_MACRO_EXPANSION_RESULT_ERROR;
+              res.v_error.error = error;
               return res;
             }
+        }
+      else
+        {
+          // single-token macro
+          for (unsigned m_at = 0; m_at < macro->n_tokens; m_at++)
+            cpp_token_array_append (&sub, macro->tokens + m_at);
+          i++;
+        }
 
-          unsigned t;
-          for (t = 0; t + 1 < sub.n; )
+      /* Handle stringification (#) and concatenation (##). */
+      CPP_TokenArray pasted = CPP_TOKEN_ARRAY_INIT;
+      unsigned t;
+      for (t = 0; t + 1 < sub.n; )
+        {
+          if (sub.tokens[t].type == CPP_TOKEN_HASH
+           && sub.tokens[t+1].type == CPP_TOKEN_BAREWORD)
             {
-              if (sub.tokens[t].type == CPP_TOKEN_HASH
-               && sub.tokens[t+1].type == CPP_TOKEN_BAREWORD)
-                {
-                  /* convert to literal string */
-                  CPP_Token toke = {
-                    CPP_TOKEN_STRING,
-                    sub.tokens[t+1].code_position,
-                    sub.tokens[t+1].str,
-                    sub.tokens[t+1].length,
-                    1                   // string is unquoted
-                  };
-                  cpp_token_array_append (&token_array, &toke);
-                  t += 2;
-                }
-              else if (can_concatenate_token_type (sub.tokens[t].type)
-                    && sub.tokens[t+1].type == CPP_TOKEN_CONCATENATE)
+              /* convert to literal string */
+              CPP_Token toke = {
+                CPP_TOKEN_STRING,
+                sub.tokens[t+1].code_position,
+                sub.tokens[t+1].str,
+                sub.tokens[t+1].length,
+                1                   // string is unquoted
+              };
+              cpp_token_array_append (&pasted, &toke);
+              t += 2;
+            }
+          else if (can_concatenate_token_type (sub.tokens[t].type)
+                && sub.tokens[t+1].type == CPP_TOKEN_CONCATENATE)
+            {
+              /* concatenate into a single token */
+              bool all_numbers = sub.tokens[t].type == CPP_TOKEN_NUMBER;
+              unsigned total_length = sub.tokens[t].length;
+              unsigned n_parts = 2;
+              for (;;)
                 {
-                  /* concatenate into a single token */
-                  bool all_numbers = sub.tokens[t].type == CPP_TOKEN_NUMBER;
-                  unsigned total_length = sub.tokens[t].length;
-                  unsigned n_parts = 2;
-                  for (;;)
+                  unsigned a = t + n_parts * 2 - 2;
+                  if (a >= sub.n)
                     {
-                      unsigned a = t + n_parts * 2 - 2;
-                      if (a >= sub.n)
-                        {
-                          res.type = CPP_MACRO_EXPANSION_RESULT_ERROR;
-                          res.v_error.error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_CONCATENATION,
-                                                              "'##' cannot appear at end of macro expansion");
-                          dbcc_error_add_code_position (res.v_error.error, sub.tokens[a].code_position);
-                          return res;
-                        }
-                      else if (!can_concatenate_token_type (sub.tokens[a].type))
-                        {
-                          res.type = CPP_MACRO_EXPANSION_RESULT_ERROR;
-                          res.v_error.error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_CONCATENATION,
-                                                              "invalid token type for ##");
-                          dbcc_error_add_code_position (res.v_error.error, sub.tokens[a].code_position);
-                          return res;
-                        }
-                      else
-                        {
-                          /* is ok */
-                          total_length += sub.tokens[a].length;
-                          if (all_numbers && sub.tokens[a].type != CPP_TOKEN_NUMBER)
-                            all_numbers = false;
-                        }
-
-                      if (a + 1 < sub.n
-                        && sub.tokens[a + 1].type == CPP_TOKEN_CONCATENATE)
-                        n_parts++;
-                      else
-                        break;
+                      res.type = CPP_MACRO_EXPANSION_RESULT_ERROR;
+                      res.v_error.error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_CONCATENATION,
+                                                          "'##' cannot appear at end of macro expansion");
+                      dbcc_error_add_code_position (res.v_error.error, sub.tokens[a < sub.n ? a : sub.n - 1].code_position);
+                      free (sub.tokens);
+                      free (pasted.tokens);
+                      free (token_array.tokens);
+                      return res;
                     }
-                  char *concat = malloc (total_length + 1);
-                  char *at = concat;
-                  unsigned tt;
-                  for (tt = 0; tt < n_parts; tt++)
+                  else if (!can_concatenate_token_type (sub.tokens[a].type))
                     {
-                      CPP_Token *tok = tokens + t + 2 * tt;
-                      memcpy (at, tok->str, tok->length);
-                      at += tok->length;
+                      res.type = CPP_MACRO_EXPANSION_RESULT_ERROR;
+                      res.v_error.error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_CONCATENATION,
+                                                          "invalid token type for ##");
+                      dbcc_error_add_code_position (res.v_error.error, sub.tokens[a < sub.n ? a : sub.n - 1].code_position);
+                      free (sub.tokens);
+                      free (pasted.tokens);
+                      free (token_array.tokens);
+                      return res;
                     }
-                  *at = 0;
-                  CPP_Token new_token = {
-                    all_numbers ? CPP_TOKEN_NUMBER : CPP_TOKEN_BAREWORD,
-                    sub.tokens[t].code_position,
-                    concat,
-                    total_length,
-                    0
-                  };
-                  cpp_token_array_append (&token_array, &new_token);
-                  t += n_parts * 2 - 1;
+                  else
+                    {
+                      /* is ok */
+                      total_length += sub.tokens[a].length;
+                      if (all_numbers && sub.tokens[a].type != CPP_TOKEN_NUMBER)
+                        all_numbers = false;
+                    }
+
+                  if (a + 1 < sub.n
+                    && sub.tokens[a + 1].type == CPP_TOKEN_CONCATENATE)
+                    n_parts++;
+                  else
+                    break;
                 }
-              else
+              char *concat = malloc (total_length + 1);
+              char *at = concat;
+              unsigned tt;
+              for (tt = 0; tt < n_parts; tt++)
                 {
-                  cpp_token_array_append (&token_array, sub.tokens+t);
-                  t++;
+                  CPP_Token *tok = sub.tokens + t + 2 * tt;
+                  memcpy (at, tok->str, tok->length);
+                  at += tok->length;
                 }
+              *at = 0;
+              CPP_Token new_token = {
+                all_numbers ? CPP_TOKEN_NUMBER : CPP_TOKEN_BAREWORD,
+                sub.tokens[t].code_position,
+                concat,
+                total_length,
+                0
+              };
+              cpp_token_array_append (&pasted, &new_token);
+              t += n_parts * 2 - 1;
             }
-          while (t < sub.n)
+          else
             {
-              cpp_token_array_append (&token_array, sub.tokens+t);
+              cpp_token_array_append (&pasted, sub.tokens+t);
               t++;
             }
         }
+      while (t < sub.n)
+        {
+          cpp_token_array_append (&pasted, sub.tokens+t);
+          t++;
+        }
+      free (sub.tokens);
+
+      // Expand macros recursively,
+      // except we deliberately guard against literally
+      // recursing on the current macro.
+      assert(!macro->is_expanding);
+      macro->is_expanding = true;
+      res = expand_macros (parser, pasted.n, pasted.tokens);
+      macro->is_expanding = false;
+      switch (res.type)
+        {
+        case CPP_MACRO_EXPANSION_RESULT_SUCCESS:
+          for (unsigned t = 0; t < res.v_success.n_expanded_tokens; t++)
+            cpp_token_array_append (&token_array, &res.v_success.expanded_tokens[t]);
+          free (res.v_success.expanded_tokens);
+          break;
+        case CPP_MACRO_EXPANSION_RESULT_NO_CHANGE:
+          for (unsigned t = 0; t < pasted.n; t++)
+            cpp_token_array_append (&token_array, pasted.tokens + t);
+          break;
+        case CPP_MACRO_EXPANSION_RESULT_ERROR:
+          free (pasted.tokens);
+          free (token_array.tokens);
+          return res;
+        }
+      free (pasted.tokens);
+
+      /* If the replacement ends with the name of a function-like
+       * macro, its arguments come from the rest of the line,
+       * e.g. "#define H F" then "H(1,2)". */
+      if (token_array.n > 0
+       && get_expandable_macro (parser, 0, 1, token_array.tokens + token_array.n - 1) == NULL)
+        {
+          CPP_TokenArray tail = CPP_TOKEN_ARRAY_INIT;
+          cpp_token_array_append (&tail, token_array.tokens + token_array.n - 1);
+          for (j = i; j < n_tokens; j++)
+            cpp_token_array_append (&tail, tokens + j);
+          if (get_expandable_macro (parser, 0, tail.n, tail.tokens) != NULL)
+            {
+              token_array.n--;
+              res = expand_macros (parser, tail.n, tail.tokens);
+              switch (res.type)
+                {
+                case CPP_MACRO_EXPANSION_RESULT_SUCCESS:
+                  for (unsigned t = 0; t < res.v_success.n_expanded_tokens; t++)
+                    cpp_token_array_append (&token_array, &res.v_success.expanded_tokens[t]);
+                  free (res.v_success.expanded_tokens);
+                  break;
+                case CPP_MACRO_EXPANSION_RESULT_NO_CHANGE:
+                  assert(0);
+                  break;
+                case CPP_MACRO_EXPANSION_RESULT_ERROR:
+                  free (tail.tokens);
+                  free (token_array.tokens);
+                  return res;
+                }
+              i = n_tokens;
+            }
+          free (tail.tokens);
+        }
     }
   res.type = CPP_MACRO_EXPANSION_RESULT_SUCCESS;
   res.v_success.n_expanded_tokens = token_array.n;
@@ -1439,7 +1760,7 @@ tokens_to_boolean_value (DBCC_TargetEnvironment *target_env,
                                                   error))
               {
                 dbcc_error_add_code_position (*error, tokens[i].code_position);
-                return false;
+                goto failed;
               }
             res.v_int64 = v;
             DBCC_CPPExpr_Evaluator(lemon_parser, CPP_EXPR_NUMBER, res, &eval_result);
@@ -1453,17 +1774,17 @@ tokens_to_boolean_value (DBCC_TargetEnvironment *target_env,
                 *error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_INTEGERS_ONLY,
                                          "preprocessor will not handle floating-point number");
                 dbcc_error_add_code_position (*error, tokens[i].code_position);
-                return false;
+                goto failed;
               }
             else if (!dbcc_common_number_parse_int64 (tokens[i].length, tokens[i].str, &val, error))
               {
                 dbcc_error_add_code_position (*error, tokens[i].code_position);
-                return false;
+                goto failed;
               }
             else
               {
                 res.v_int64 = val;
-                DBCC_CPPExpr_Evaluator(lemon_parser, CPP_TOKEN_NUMBER, res, &eval_result);
+                DBCC_CPPExpr_Evaluator(lemon_parser, CPP_EXPR_NUMBER, res, &eval_result);
               }
             break;
           }
@@ -1477,6 +1798,7 @@ tokens_to_boolean_value (DBCC_TargetEnvironment *target_env,
                   {
                   case '|': et = CPP_EXPR_BITWISE_OR; break;
                   case '&': et = CPP_EXPR_BITWISE_AND; break;
+                  case '^': et = CPP_EXPR_BITWISE_XOR; break;
                   case '+': et = CPP_EXPR_PLUS; break;
                   case '-': et = CPP_EXPR_MINUS; break;
                   case '*': et = CPP_EXPR_STAR; break;
@@ -1504,8 +1826,10 @@ tokens_to_boolean_value (DBCC_TargetEnvironment *target_env,
                   case COMBINE_2_CHARS('!', '='): et = CPP_EXPR_NEQ; break;
                   default: goto invalid_operator;
                   }
+                break;
               default: goto invalid_operator;
               }
+            DBCC_CPPExpr_Evaluator(lemon_parser, et, res, &eval_result);
             break;
           }
 
@@ -1522,20 +1846,22 @@ tokens_to_boolean_value (DBCC_TargetEnvironment *target_env,
                                    "unexpected token-type should not have reached here (%u)",
                                    tokens[i].type);
           dbcc_error_add_code_position (*error, tokens[i].code_position);
-          return false;
+          goto failed;
         }
     }
 
   // end parsing
   CPP_Expr_Result res = { CPP_EXPR_RESULT_INT64, .v_int64 = 0 };
   DBCC_CPPExpr_Evaluator(lemon_parser, 0, res, &eval_result);
-  if (res.type == CPP_EXPR_RESULT_FAIL)
+  DBCC_CPPExpr_EvaluatorFree(lemon_parser, free);
+  if (eval_result.result.type == CPP_EXPR_RESULT_FAIL)
     {
-      *error = res.v_error;
+      *error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_SYNTAX,
+                               "error evaluating preprocessor expression");
+      if (n_tokens > 0)
+        dbcc_error_add_code_position (*error, tokens[0].code_position);
       return false;
     }
-  assert(eval_result.finished);
-  DBCC_CPPExpr_EvaluatorFree(lemon_parser, free);
   *result_out = eval_result.result.v_int64 != 0;
   return true;
 
@@ -1544,89 +1870,569 @@ invalid_operator:
   *error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_INVALID_OPERATOR,
                            "not a valid operator in a preprocessor subexpression");
   dbcc_error_add_code_position (*error, tokens[i].code_position);
+failed:
+  DBCC_CPPExpr_EvaluatorFree(lemon_parser, free);
   return false;
 }
 
-static bool
-eval_cpp_expr_boolean (DBCC_Parser *parser,
-                       CPP_Expr    *expr,
-                       bool        *result_out,
-                       DBCC_Error **error_out)
+/* --- Compiled #if expressions ---
+ *
+ * The first time an #if/#elif is seen, it is compiled
+ * (before macro-expansion) by precedence climbing into
+ * a postfix program.  Later evaluations of the same directive,
+ * such as from a header included many times, just run the program.
+ * Programs are found by file and offset, and are recompiled
+ * if the expression there has changed.
+ *
+ * Anything the compiler doesn't understand (function-like macro
+ * invocations, ?:, etc) makes the expression uncompilable,
+ * and likewise any evaluation whose macros don't have plain integer
+ * values falls back to expand_macros() + tokens_to_boolean_value(),
+ * which is also responsible for reporting all errors.
+ */
+typedef struct CPP_ExprCompiler CPP_ExprCompiler;
+struct CPP_ExprCompiler
 {
-  CPP_MacroExpansionResult res;
-  DBCC_Symbol *kw;
+  DBCC_Parser *parser;
+  unsigned n_tokens;
+  CPP_Token *tokens;
+  unsigned at;
+  unsigned n_ops;
+  CPP_Op *ops;
+  unsigned ops_alloced;
+  unsigned stack_depth;
+  unsigned max_stack;
+};
 
-  switch (expr->expr_type)
+static void
+cpp_expr_compiler_emit (CPP_ExprCompiler *compiler,
+                        CPP_OpCode        opcode,
+                        int               stack_delta)
+{
+  if (compiler->n_ops == compiler->ops_alloced)
     {
-    case CPP_EXPR_IFNDEF:
-      assert(expr->n_tokens == 1);
-      assert(expr->tokens[0].type == CPP_TOKEN_BAREWORD);
-      kw = dbcc_symbol_space_force_len (parser->symbol_space,
-                                    expr->tokens[0].length,
-                                    expr->tokens[0].str);
-      *result_out = lookup_macro (parser, kw) == NULL;
-      return true;
+      compiler->ops_alloced = compiler->ops_alloced ? compiler->ops_alloced * 2 : 16;
+      compiler->ops = realloc (compiler->ops, sizeof (CPP_Op) * compiler->ops_alloced);
+    }
+  compiler->ops[compiler->n_ops].opcode = opcode;
+  compiler->ops[compiler->n_ops].v_const = 0;
+  compiler->n_ops++;
+  compiler->stack_depth += stack_delta;
+  if (compiler->stack_depth > compiler->max_stack)
+    compiler->max_stack = compiler->stack_depth;
+}
 
-    case CPP_EXPR_IFDEF:
-      assert(expr->n_tokens == 1);
-      assert(expr->tokens[0].type == CPP_TOKEN_BAREWORD);
-      kw = dbcc_symbol_space_force_len (parser->symbol_space,
-                                    expr->tokens[0].length,
-                                    expr->tokens[0].str);
-      *result_out = lookup_macro (parser, kw) != NULL;
-      return true;
+static inline bool
+cpp_expr_compiler_peek_operator (CPP_ExprCompiler *compiler,
+                                 const char       *op)
+{
+  if (compiler->at >= compiler->n_tokens)
+    return false;
+  CPP_Token *token = compiler->tokens + compiler->at;
+  size_t len = strlen (op);
+  return token->type == CPP_TOKEN_OPERATOR
+      && token->length == len
+      && memcmp (token->str, op, len) == 0;
+}
 
-    case CPP_EXPR_IF:
-      break;
-    }
+static bool compile_cpp_subexpr (CPP_ExprCompiler *compiler, unsigned min_prec);
 
-  // Handle 'defined(Keyword)' (parens are optional),
-  // because we must handle it before macro expansion.
-  unsigned i;
-  for (i = 0; i < expr->n_tokens; )
+static bool
+compile_cpp_primary (CPP_ExprCompiler *compiler)
+{
+  if (compiler->at >= compiler->n_tokens)
+    return false;
+  CPP_Token *token = compiler->tokens + compiler->at;
+  switch (token->type)
     {
-      if (expr->tokens[i].type == CPP_TOKEN_BAREWORD
-       && expr->tokens[i].length == 7
-       && memcmp (expr->tokens[i].str, "defined", 7) == 0)
+    case CPP_TOKEN_NUMBER:
+      {
+        int64_t v;
+        DBCC_Error *error = NULL;
+        if (!dbcc_common_number_is_integral (token->length, token->str))
+          return false;
+        if (!dbcc_common_number_parse_int64 (token->length, token->str, &v, &error))
+          {
+            dbcc_error_unref (error);
+            return false;
+          }
+        cpp_expr_compiler_emit (compiler, CPP_OP_CONST, 1);
+        compiler->ops[compiler->n_ops - 1].v_const = v;
+        compiler->at++;
+        return true;
+      }
+
+    case CPP_TOKEN_CHAR:
+      {
+        uint32_t v;
+        size_t sizeof_char;
+        DBCC_Error *error = NULL;
+        if (!dbcc_common_char_constant_value (compiler->parser->target_environment,
+                                              token->length, token->str,
+                                              &v, &sizeof_char, &error))
+          {
+            dbcc_error_unref (error);
+            return false;
+          }
+        cpp_expr_compiler_emit (compiler, CPP_OP_CONST, 1);
+        compiler->ops[compiler->n_ops - 1].v_const = v;
+        compiler->at++;
+        return true;
+      }
+
+    case CPP_TOKEN_BAREWORD:
+      {
+        DBCC_Symbol *symbol;
+        compiler->at++;
+        if (token->length == 7 && memcmp (token->str, "defined", 7) == 0)
+          {
+            bool paren = cpp_expr_compiler_peek_operator (compiler, "(");
+            if (paren)
+              compiler->at++;
+            if (compiler->at >= compiler->n_tokens
+             || compiler->tokens[compiler->at].type != CPP_TOKEN_BAREWORD)
+              return false;
+            token = compiler->tokens + compiler->at++;
+            if (paren)
+              {
+                if (!cpp_expr_compiler_peek_operator (compiler, ")"))
+                  return false;
+                compiler->at++;
+              }
+            symbol = dbcc_symbol_space_force_len (compiler->parser->symbol_space,
+                                                  token->length, token->str);
+            cpp_expr_compiler_emit (compiler, CPP_OP_DEFINED, 1);
+            compiler->ops[compiler->n_ops - 1].v_symbol = symbol;
+            return true;
+          }
+
+        /* Might be a function-like macro invocation. */
+        if (cpp_expr_compiler_peek_operator (compiler, "("))
+          return false;
+
+        symbol = dbcc_symbol_space_force_len (compiler->parser->symbol_space,
+                                              token->length, token->str);
+        cpp_expr_compiler_emit (compiler, CPP_OP_MACRO_VALUE, 1);
+        compiler->ops[compiler->n_ops - 1].v_symbol = symbol;
+        return true;
+      }
+
+    case CPP_TOKEN_OPERATOR:
+      if (token->length != 1)
+        return false;
+      compiler->at++;
+      switch (token->str[0])
         {
-          if (i + 3 < expr->n_tokens 
-           && expr->tokens[i+1].type == CPP_TOKEN_OPERATOR
-           && expr->tokens[i+1].length == 1
-           && expr->tokens[i+1].str[0] == '('
-           && expr->tokens[i+2].type == CPP_TOKEN_BAREWORD
-           && expr->tokens[i+3].type == CPP_TOKEN_OPERATOR
-           && expr->tokens[i+3].length == 1
-           && expr->tokens[i+3].str[0] == ')')
-            {
-              DBCC_Symbol *s = dbcc_symbol_space_try_len (parser->symbol_space, expr->tokens[i+2].length, expr->tokens[i+2].str);
-              bool val = (s != NULL && lookup_macro (parser, s) != NULL);
-              CPP_Token replace = {
-                CPP_TOKEN_NUMBER,
-                expr->tokens[i+2].code_position,
-                val ? "1" : "0",
-                1,
-                0
-              };
-              dbcc_code_position_unref (expr->tokens[i].code_position);
-              dbcc_code_position_unref (expr->tokens[i+1].code_position);
-              dbcc_code_position_unref (expr->tokens[i+3].code_position);
-              expr->tokens[i] = replace;
-              memmove (expr->tokens + i + 1,
-                       expr->tokens + i + 4,
-                       (expr->n_tokens - i - 4) * sizeof (CPP_Token));
-              expr->n_tokens -= 3;
-            }
-          else if (i + 1 < expr->n_tokens
-            && expr->tokens[i+1].type == CPP_TOKEN_BAREWORD)
-            {
-              DBCC_Symbol *s = dbcc_symbol_space_try_len (parser->symbol_space, expr->tokens[i+1].length, expr->tokens[i+1].str);
-              bool val = (s != NULL && lookup_macro (parser, s) != NULL);
-              CPP_Token replace = {
-                CPP_TOKEN_NUMBER,
-                expr->tokens[i+1].code_position,
-                val ? "1" : "0",
-                1,
-                0
+        case '(':
+          if (!compile_cpp_subexpr (compiler, 1))
+            return false;
+          if (!cpp_expr_compiler_peek_operator (compiler, ")"))
+            return false;
+          compiler->at++;
+          return true;
+        case '!':
+          if (!compile_cpp_primary (compiler))
+            return false;
+          cpp_expr_compiler_emit (compiler, CPP_OP_BANG, 0);
+          return true;
+        case '~':
+          if (!compile_cpp_primary (compiler))
+            return false;
+          cpp_expr_compiler_emit (compiler, CPP_OP_TILDE, 0);
+          return true;
+        case '-':
+          if (!compile_cpp_primary (compiler))
+            return false;
+          cpp_expr_compiler_emit (compiler, CPP_OP_NEGATE, 0);
+          return true;
+        case '+':
+          return compile_cpp_primary (compiler);
+        default:
+          return false;
+        }
+
+    default:
+      return false;
+    }
+}
+
+/* Binary operators, with precedences from 6.5.5 - 6.5.14. */
+static bool
+get_cpp_binary_operator (CPP_Token  *token,
+                         CPP_OpCode *opcode_out,
+                         unsigned   *prec_out)
+{
+  if (token->type != CPP_TOKEN_OPERATOR)
+    return false;
+  if (token->length == 1)
+    switch (token->str[0])
+      {
+      case '*': *opcode_out = CPP_OP_STAR;        *prec_out = 10; return true;
+      case '/': *opcode_out = CPP_OP_SLASH;       *prec_out = 10; return true;
+      case '%': *opcode_out = CPP_OP_PERCENT;     *prec_out = 10; return true;
+      case '+': *opcode_out = CPP_OP_PLUS;        *prec_out = 9; return true;
+      case '-': *opcode_out = CPP_OP_MINUS;       *prec_out = 9; return true;
+      case '<': *opcode_out = CPP_OP_LT;          *prec_out = 7; return true;
+      case '>': *opcode_out = CPP_OP_GT;          *prec_out = 7; return true;
+      case '&': *opcode_out = CPP_OP_BITWISE_AND; *prec_out = 5; return true;
+      case '^': *opcode_out = CPP_OP_BITWISE_XOR; *prec_out = 4; return true;
+      case '|': *opcode_out = CPP_OP_BITWISE_OR;  *prec_out = 3; return true;
+      default: return false;
+      }
+  if (token->length == 2)
+    switch (COMBINE_2_CHARS(token->str[0], token->str[1]))
+      {
+      case COMBINE_2_CHARS('<', '<'): *opcode_out = CPP_OP_LTLT;        *prec_out = 8; return true;
+      case COMBINE_2_CHARS('>', '>'): *opcode_out = CPP_OP_GTGT;        *prec_out = 8; return true;
+      case COMBINE_2_CHARS('<', '='): *opcode_out = CPP_OP_LTEQ;        *prec_out = 7; return true;
+      case COMBINE_2_CHARS('>', '='): *opcode_out = CPP_OP_GTEQ;        *prec_out = 7; return true;
+      case COMBINE_2_CHARS('=', '='): *opcode_out = CPP_OP_EQ;          *prec_out = 6; return true;
+      case COMBINE_2_CHARS('!', '='): *opcode_out = CPP_OP_NEQ;         *prec_out = 6; return true;
+      case COMBINE_2_CHARS('&', '&'): *opcode_out = CPP_OP_LOGICAL_AND; *prec_out = 2; return true;
+      case COMBINE_2_CHARS('|', '|'): *opcode_out = CPP_OP_LOGICAL_OR;  *prec_out = 1; return true;
+      default: return false;
+      }
+  return false;
+}
+
+static bool
+compile_cpp_subexpr (CPP_ExprCompiler *compiler, unsigned min_prec)
+{
+  if (!compile_cpp_primary (compiler))
+    return false;
+  while (compiler->at < compiler->n_tokens)
+    {
+      CPP_OpCode opcode;
+      unsigned prec;
+      if (!get_cpp_binary_operator (compiler->tokens + compiler->at, &opcode, &prec))
+        break;
+      if (prec < min_prec)
+        break;
+      compiler->at++;
+      if (!compile_cpp_subexpr (compiler, prec + 1))
+        return false;
+      cpp_expr_compiler_emit (compiler, opcode, -1);
+    }
+  return true;
+}
+
+static bool
+compiled_cpp_expr_text_matches (CPP_CompiledExpr *compiled,
+                                CPP_Expr         *expr)
+{
+  size_t at = 0;
+  for (unsigned i = 0; i < expr->n_tokens; i++)
+    {
+      unsigned len = expr->tokens[i].length;
+      if (at + len + 1 > compiled->text_length
+       || memcmp (compiled->text + at, expr->tokens[i].str, len) != 0
+       || compiled->text[at + len] != '\n')
+        return false;
+      at += len + 1;
+    }
+  return at == compiled->text_length;
+}
+
+static void
+compile_cpp_expr (DBCC_Parser      *parser,
+                  CPP_Expr         *expr,
+                  CPP_CompiledExpr *out)
+{
+  size_t text_length = 0;
+  for (unsigned i = 0; i < expr->n_tokens; i++)
+    text_length += expr->tokens[i].length + 1;
+  out->text_length = text_length;
+  out->text = malloc (text_length);
+  char *at = out->text;
+  for (unsigned i = 0; i < expr->n_tokens; i++)
+    {
+      memcpy (at, expr->tokens[i].str, expr->tokens[i].length);
+      at += expr->tokens[i].length;
+      *at++ = '\n';
+    }
+
+  CPP_ExprCompiler compiler = {
+    parser, expr->n_tokens, expr->tokens,
+    0, 0, NULL, 0, 0, 0
+  };
+  if (compile_cpp_subexpr (&compiler, 1) && compiler.at == compiler.n_tokens)
+    {
+      out->n_ops = compiler.n_ops;
+      out->ops = realloc (compiler.ops, sizeof (CPP_Op) * compiler.n_ops);
+      out->max_stack = compiler.max_stack;
+    }
+  else
+    {
+      free (compiler.ops);
+      out->n_ops = 0;
+      out->ops = NULL;
+      out->max_stack = 0;
+    }
+}
+
+static CPP_CompiledExpr *
+force_compiled_cpp_expr (DBCC_Parser *parser,
+                         CPP_Expr    *expr)
+{
+  CPP_CompiledExpr key;
+  CPP_CompiledExpr *rv;
+  key.filename = expr->tokens[0].code_position->filename;
+  key.byte_offset = expr->tokens[0].code_position->byte_offset;
+  DSK_RBTREE_LOOKUP (GET_COMPILED_EXPR_TREE (parser), &key, rv);
+  if (rv != NULL)
+    {
+      if (!compiled_cpp_expr_text_matches (rv, expr))
+        {
+          free (rv->ops);
+          free (rv->text);
+          compile_cpp_expr (parser, expr, rv);
+        }
+      return rv;
+    }
+
+  rv = malloc (sizeof (CPP_CompiledExpr));
+  rv->filename = key.filename;
+  rv->byte_offset = key.byte_offset;
+  compile_cpp_expr (parser, expr, rv);
+  CPP_CompiledExpr *conflict;
+  DSK_RBTREE_INSERT (GET_COMPILED_EXPR_TREE (parser), rv, conflict);
+  assert (conflict == NULL);
+  return rv;
+}
+
+/* Like the lemon evaluator, failure (division by zero)
+ * propagates, except through the short-circuit operators.
+ */
+typedef struct {
+  bool failed;
+  int64_t v;
+} CPP_ExprValue;
+
+/* Returns false if the slow path must be used instead. */
+static bool
+run_compiled_cpp_expr (DBCC_Parser      *parser,
+                       CPP_CompiledExpr *compiled,
+                       bool             *result_out)
+{
+  CPP_ExprValue stack_buf[32];
+  CPP_ExprValue *stack = compiled->max_stack <= DSK_N_ELEMENTS (stack_buf)
+                       ? stack_buf
+                       : malloc (sizeof (CPP_ExprValue) * compiled->max_stack);
+  unsigned sp = 0;
+  bool rv = false;
+  for (unsigned i = 0; i < compiled->n_ops; i++)
+    {
+      CPP_Op *op = compiled->ops + i;
+      CPP_ExprValue *b = sp >= 1 ? stack + sp - 1 : NULL;
+      CPP_ExprValue *a = sp >= 2 ? stack + sp - 2 : NULL;
+      switch (op->opcode)
+        {
+        case CPP_OP_CONST:
+          stack[sp++] = (CPP_ExprValue) { false, op->v_const };
+          continue;
+        case CPP_OP_DEFINED:
+          stack[sp++] = (CPP_ExprValue) { false, lookup_macro (parser, op->v_symbol) != NULL };
+          continue;
+        case CPP_OP_MACRO_VALUE:
+          {
+            CPP_Macro *macro = lookup_macro (parser, op->v_symbol);
+            int64_t v = 0;
+            if (macro != NULL && !macro->function_macro)
+              {
+                DBCC_Error *error = NULL;
+                if (macro->n_tokens != 1
+                 || macro->tokens[0].type != CPP_TOKEN_NUMBER
+                 || !dbcc_common_number_is_integral (macro->tokens[0].length,
+                                                     macro->tokens[0].str))
+                  goto done;
+                if (!dbcc_common_number_parse_int64 (macro->tokens[0].length,
+                                                     macro->tokens[0].str,
+                                                     &v, &error))
+                  {
+                    dbcc_error_unref (error);
+                    goto done;
+                  }
+              }
+            stack[sp++] = (CPP_ExprValue) { false, v };
+            continue;
+          }
+
+        case CPP_OP_NEGATE:
+          b->v = cpp_expr_neg (b->v);
+          continue;
+        case CPP_OP_BANG:
+          b->v = b->v == 0;
+          continue;
+        case CPP_OP_TILDE:
+          b->v = ~b->v;
+          continue;
+
+        case CPP_OP_LOGICAL_AND:
+          if (!a->failed && a->v == 0)
+            *a = (CPP_ExprValue) { false, 0 };
+          else
+            *a = (CPP_ExprValue) { a->failed || b->failed, b->v != 0 };
+          sp--;
+          continue;
+        case CPP_OP_LOGICAL_OR:
+          if (!a->failed && a->v != 0)
+            *a = (CPP_ExprValue) { false, 1 };
+          else
+            *a = (CPP_ExprValue) { a->failed || b->failed, b->v != 0 };
+          sp--;
+          continue;
+
+        default:
+          break;
+        }
+
+      /* remaining binary operators are strict */
+      sp--;
+      a->failed = a->failed || b->failed;
+      if (a->failed)
+        continue;
+      switch (op->opcode)
+        {
+        case CPP_OP_STAR:        a->v = cpp_expr_mul (a->v, b->v); break;
+        case CPP_OP_SLASH:
+        case CPP_OP_PERCENT:
+          if (b->v == 0)
+            a->failed = true;
+          else
+            a->v = op->opcode == CPP_OP_SLASH ? cpp_expr_div (a->v, b->v)
+                                              : cpp_expr_mod (a->v, b->v);
+          break;
+        case CPP_OP_PLUS:        a->v = cpp_expr_add (a->v, b->v); break;
+        case CPP_OP_MINUS:       a->v = cpp_expr_sub (a->v, b->v); break;
+        case CPP_OP_LTLT:        a->v = cpp_expr_shift_left (a->v, b->v); break;
+        case CPP_OP_GTGT:        a->v = cpp_expr_shift_right (a->v, b->v); break;
+        case CPP_OP_LT:          a->v = a->v < b->v; break;
+        case CPP_OP_GT:          a->v = a->v > b->v; break;
+        case CPP_OP_LTEQ:        a->v = a->v <= b->v; break;
+        case CPP_OP_GTEQ:        a->v = a->v >= b->v; break;
+        case CPP_OP_EQ:          a->v = a->v == b->v; break;
+        case CPP_OP_NEQ:         a->v = a->v != b->v; break;
+        case CPP_OP_BITWISE_AND: a->v = a->v & b->v; break;
+        case CPP_OP_BITWISE_XOR: a->v = a->v ^ b->v; break;
+        case CPP_OP_BITWISE_OR:  a->v = a->v | b->v; break;
+        default: assert (0);
+        }
+    }
+  assert (sp == 1);
+
+  /* leave error reporting to the slow path */
+  if (!stack[0].failed)
+    {
+      *result_out = stack[0].v != 0;
+      rv = true;
+    }
+
+done:
+  if (stack != stack_buf)
+    free (stack);
+  return rv;
+}
+
+static void
+free_compiled_expr_tree (CPP_CompiledExpr *node)
+{
+  if (node == NULL)
+    return;
+  free_compiled_expr_tree (node->left);
+  free_compiled_expr_tree (node->right);
+  free (node->ops);
+  free (node->text);
+  free (node);
+}
+
+static bool
+eval_cpp_expr_boolean (DBCC_Parser *parser,
+                       CPP_Expr    *expr,
+                       bool        *result_out,
+                       DBCC_Error **error_out)
+{
+  CPP_MacroExpansionResult res;
+  DBCC_Symbol *kw;
+
+  switch (expr->expr_type)
+    {
+    case CPP_EXPR_IFNDEF:
+      assert(expr->n_tokens == 1);
+      assert(expr->tokens[0].type == CPP_TOKEN_BAREWORD);
+      kw = dbcc_symbol_space_force_len (parser->symbol_space,
+                                    expr->tokens[0].length,
+                                    expr->tokens[0].str);
+      *result_out = lookup_macro (parser, kw) == NULL;
+      return true;
+
+    case CPP_EXPR_IFDEF:
+      assert(expr->n_tokens == 1);
+      assert(expr->tokens[0].type == CPP_TOKEN_BAREWORD);
+      kw = dbcc_symbol_space_force_len (parser->symbol_space,
+                                    expr->tokens[0].length,
+                                    expr->tokens[0].str);
+      *result_out = lookup_macro (parser, kw) != NULL;
+      return true;
+
+    case CPP_EXPR_IF:
+      break;
+    }
+
+  if (expr->n_tokens > 0 && expr->tokens[0].code_position != NULL)
+    {
+      CPP_CompiledExpr *compiled = force_compiled_cpp_expr (parser, expr);
+      if (compiled->n_ops > 0
+       && run_compiled_cpp_expr (parser, compiled, result_out))
+        return true;
+    }
+
+  // Handle 'defined(Keyword)' (parens are optional),
+  // because we must handle it before macro expansion.
+  unsigned i;
+  for (i = 0; i < expr->n_tokens; )
+    {
+      if (expr->tokens[i].type == CPP_TOKEN_BAREWORD
+       && expr->tokens[i].length == 7
+       && memcmp (expr->tokens[i].str, "defined", 7) == 0)
+        {
+          if (i + 3 < expr->n_tokens 
+           && expr->tokens[i+1].type == CPP_TOKEN_OPERATOR
+           && expr->tokens[i+1].length == 1
+           && expr->tokens[i+1].str[0] == '('
+           && expr->tokens[i+2].type == CPP_TOKEN_BAREWORD
+           && expr->tokens[i+3].type == CPP_TOKEN_OPERATOR
+           && expr->tokens[i+3].length == 1
+           && expr->tokens[i+3].str[0] == ')')
+            {
+              DBCC_Symbol *s = dbcc_symbol_space_try_len (parser->symbol_space, expr->tokens[i+2].length, expr->tokens[i+2].str);
+              bool val = (s != NULL && lookup_macro (parser, s) != NULL);
+              CPP_Token replace = {
+                CPP_TOKEN_NUMBER,
+                expr->tokens[i+2].code_position,
+                val ? "1" : "0",
+                1,
+                0
+              };
+              dbcc_code_position_unref (expr->tokens[i].code_position);
+              dbcc_code_position_unref (expr->tokens[i+1].code_position);
+              dbcc_code_position_unref (expr->tokens[i+3].code_position);
+              expr->tokens[i] = replace;
+              memmove (expr->tokens + i + 1,
+                       expr->tokens + i + 4,
+                       (expr->n_tokens - i - 4) * sizeof (CPP_Token));
+              expr->n_tokens -= 3;
+            }
+          else if (i + 1 < expr->n_tokens
+            && expr->tokens[i+1].type == CPP_TOKEN_BAREWORD)
+            {
+              DBCC_Symbol *s = dbcc_symbol_space_try_len (parser->symbol_space, expr->tokens[i+1].length, expr->tokens[i+1].str);
+              bool val = (s != NULL && lookup_macro (parser, s) != NULL);
+              CPP_Token replace = {
+                CPP_TOKEN_NUMBER,
+                expr->tokens[i+1].code_position,
+                val ? "1" : "0",
+                1,
+                0
               };
               dbcc_code_position_unref (expr->tokens[i].code_position);
               expr->tokens[i] = replace;
@@ -1667,6 +2473,8 @@ eval_cpp_expr_boolean (DBCC_Parser *parser,
         return false;
     }
   bool rv = tokens_to_boolean_value (parser->target_environment, n_tokens, tokens, result_out, error_out);
+  if (res.type == CPP_MACRO_EXPANSION_RESULT_SUCCESS)
+    free (res.v_success.expanded_tokens);
   return rv;
 }
 
@@ -2074,280 +2882,2608 @@ static CPP_Expr *copy_cpp_expr_densely (CPP_Expr *expr)
   return rv;
 }
 
-bool
-dbcc_parser_parse_file      (DBCC_Parser   *parser,
-                             const char    *filename)
+/* --- Macro definitions --- */
+
+/* A macro, its tokens, and the tokens' strings are allocated
+ * as a single block; only the argument-names are separate.
+ */
+static void
+cpp_macro_free (CPP_Macro *macro)
 {
-  DskError *error = NULL;
-  size_t size;
-  DBCC_Symbol *filename_symbol = dbcc_symbol_space_force (parser->symbol_space, filename);
-  uint8_t *contents = dsk_file_get_contents (filename, &size, &error);
-  if (contents == NULL)
+  for (unsigned i = 0; i < macro->n_tokens; i++)
+    if (macro->tokens[i].code_position != NULL)
+      dbcc_code_position_unref (macro->tokens[i].code_position);
+  free (macro->args);
+  free (macro);
+}
+
+static inline bool
+is_single_char_operator (const CPP_Token *token, char c)
+{
+  return token->type == CPP_TOKEN_OPERATOR
+      && token->length == 1
+      && token->str[0] == c;
+}
+
+static void
+undefine_macro (DBCC_Parser *parser,
+                DBCC_Symbol *name)
+{
+  CPP_Macro *macro = lookup_macro (parser, name);
+  if (macro != NULL)
     {
-      DBCC_Error *e = dbcc_error_new (DBCC_ERROR_READING_FILE,
-                                      "%s", error->message);
-      dsk_error_unref (error);
-      parser->handlers.handle_error (e, parser->handler_data);
-      return false;
+      DSK_RBTREE_REMOVE (GET_MACRO_TREE (parser), macro);
+      cpp_macro_free (macro);
     }
+}
 
-  unsigned preproc_conditional_stack_alloced = 32;
-  CPP_StackFrameStatus *preproc_conditional_stack = malloc (sizeof (CPP_StackFrameStatus) * preproc_conditional_stack_alloced);
-  unsigned preproc_conditional_level = 0;
-#define PREPROC_TOP   preproc_conditional_stack[preproc_conditional_level-1]
-#define PREPROC_NEXT_TOP   preproc_conditional_stack[preproc_conditional_level]
-  
-  /* Step 1: convert file into a sequence of "preprocessor tokens".
-   * These tokens "point into" the raw file contents, to minimize extra copies.
-   */
-  const char *str = (const char *) contents;
-  const char *end = str + size;
-  unsigned line_no = 1;
-  unsigned column = 1;
-#define CREATE_CP()                                                     \
-  dbcc_code_position_new(NULL, NULL,                                    \
-                         filename_symbol,                               \
-                         line_no, column, str - (char*)contents + 1)
-  size_t cpp_tokens_alloced = 1024;
-  CPP_Token *cpp_tokens = malloc (sizeof (CPP_Token) * cpp_tokens_alloced);
-  size_t n_cpp_tokens = 0;
-#define APPEND_TOKEN(token)                                             \
-  do{                                                                   \
-    if (n_cpp_tokens == cpp_tokens_alloced)                             \
-      {                                                                 \
-        cpp_tokens_alloced *= 2;                                        \
-        cpp_tokens = realloc (cpp_tokens,                               \
-                              sizeof (CPP_Token) * cpp_tokens_alloced); \
-        cpp_tokens[n_cpp_tokens++] = (token);                           \
-      }                                                                 \
-  } while(0)
-#define APPEND_CPP_TOKEN(typeshort, cp, str, length)                    \
-  APPEND_TOKEN(CPP_TOKEN(typeshort, cp, str, length))
-  const char *last_newline = NULL;
-  while (str < end)
+static void
+free_macro_tree (CPP_Macro *macro)
+{
+  if (macro == NULL)
+    return;
+  free_macro_tree (macro->left);
+  free_macro_tree (macro->right);
+  cpp_macro_free (macro);
+}
+
+/* Handle the body of a #define directive (6.10.3):
+ * 'tokens' are the tokens after "define", up to but not including
+ * the terminating newline.
+ */
+static bool
+define_macro (DBCC_Parser *parser,
+              unsigned     n_tokens,
+              CPP_Token   *tokens,
+              DBCC_Error **error)
+{
+  if (n_tokens == 0 || tokens[0].type != CPP_TOKEN_BAREWORD)
     {
-      const char *end_line = memchr (str, '\n', end - str);
-      if (end_line == NULL)
-        {
-          DBCC_Error *error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_INCOMPLETE_LINE,
-                                              "line without terminating newline");
-          parser->handlers.handle_error (error, parser->handler_data);
-          return false;
-        }
-      while (str < end && *str != '\n')
-        {
-          if (*str == '#')
-            {
-              if (last_newline == NULL || is_whitespace (last_newline+1, str))
-                {
-                  scan_maybe_hash_line (parser, str, end_line,
-                                        &filename_symbol,
-                                        &line_no, &column);
-                }
-              /* handle preprocessor directive. */
-              APPEND_TOKEN(CPP_TOKEN(
-                HASH,
-                CREATE_CP(),
-                str,
-                1
-              ));
-              column++;
+      *error = dbcc_error_new (DBCC_ERROR_BAD_PREPROCESSOR_DIRECTIVE,
+                               "missing name after #define");
+      if (n_tokens > 0)
+        dbcc_error_add_code_position (*error, tokens[0].code_position);
+      return false;
+    }
+  DBCC_Symbol *name = dbcc_symbol_space_force_len (parser->symbol_space,
+                                                   tokens[0].length,
+                                                   tokens[0].str);
+
+  /* A function-like macro has its left-paren immediately
+   * after the name, without any intervening whitespace. */
+  bool function_macro = n_tokens > 1
+                     && is_single_char_operator (&tokens[1], '(')
+                     && tokens[1].str == tokens[0].str + tokens[0].length;
+  DBCC_Symbol **args = NULL;
+  unsigned arity = 0;
+  bool has_ellipsis = false;
+  unsigned i = 1;
+  if (function_macro)
+    {
+      args = malloc (sizeof (DBCC_Symbol *) * n_tokens);
+      i = 2;
+      if (i < n_tokens && is_single_char_operator (&tokens[i], ')'))
+        i++;
+      else
+        for (;;)
+          {
+            if (i < n_tokens && tokens[i].type == CPP_TOKEN_BAREWORD)
+              {
+                args[arity++] = dbcc_symbol_space_force_len (parser->symbol_space,
+                                                             tokens[i].length,
+                                                             tokens[i].str);
+                i++;
+              }
+            else if (i + 2 < n_tokens
+                  && is_single_char_operator (&tokens[i], '.')
+                  && is_single_char_operator (&tokens[i+1], '.')
+                  && is_single_char_operator (&tokens[i+2], '.'))
+              {
+                args[arity++] = dbcc_symbol_space_force (parser->symbol_space,
+                                                         "__VA_ARGS__");
+                has_ellipsis = true;
+                i += 3;
+              }
+            else
+              goto bad_arg_list;
+
+            if (i < n_tokens && is_single_char_operator (&tokens[i], ')') )
+              {
+                i++;
+                break;
+              }
+            if (has_ellipsis
+             || i == n_tokens
+             || !is_single_char_operator (&tokens[i], ','))
+              goto bad_arg_list;
+            i++;
+          }
+    }
+
+  unsigned n_body = n_tokens - i;
+  size_t string_space = 0;
+  for (unsigned t = i; t < n_tokens; t++)
+    string_space += tokens[t].length + 1;
+  CPP_Macro *macro = malloc (sizeof (CPP_Macro)
+                             + sizeof (CPP_Token) * n_body
+                             + string_space);
+  macro->name = name;
+  macro->function_macro = function_macro;
+  macro->arity = arity;
+  macro->has_ellipsis = has_ellipsis;
+  macro->args = args;
+  macro->n_tokens = n_body;
+  macro->tokens = (CPP_Token *) (macro + 1);
+  macro->is_expanding = false;
+  char *str_at = (char *) (macro->tokens + n_body);
+  for (unsigned t = 0; t < n_body; t++)
+    {
+      CPP_Token *in = tokens + i + t;
+      CPP_Token *out = macro->tokens + t;
+      *out = *in;
+      out->str = str_at;
+      memcpy (str_at, in->str, in->length);
+      str_at[in->length] = 0;
+      str_at += in->length + 1;
+      if (out->code_position != NULL)
+        dbcc_code_position_ref (out->code_position);
+      if (function_macro && in->type == CPP_TOKEN_BAREWORD)
+        {
+          DBCC_Symbol *s = dbcc_symbol_space_try_len (parser->symbol_space,
+                                                      in->length, in->str);
+          for (unsigned a = 0; s != NULL && a < arity; a++)
+            if (args[a] == s)
+              {
+                out->type = CPP_TOKEN_MACRO_ARGUMENT;
+                out->alt_int_value = a;
+                break;
+              }
+        }
+    }
+
+  /* Redefinition replaces the old macro. */
+  undefine_macro (parser, name);
+  CPP_Macro *conflict;
+  DSK_RBTREE_INSERT (GET_MACRO_TREE (parser), macro, conflict);
+  assert (conflict == NULL);
+  return true;
+
+bad_arg_list:
+  *error = dbcc_error_new (DBCC_ERROR_BAD_PREPROCESSOR_DIRECTIVE,
+                           "bad argument list for macro %s",
+                           dbcc_symbol_get_string (name));
+  dbcc_error_add_code_position (*error, tokens[i < n_tokens ? i : 0].code_position);
+  free (args);
+  return false;
+}
+
+/* --- Directive-only lexing --- */
+
+/* Find the end of the logical line that starts at 'str':
+ * backslash-newline continues the line (phase 2),
+ * and newlines inside a multiline comment do not end it (phase 3).
+ *
+ * Returns a pointer to the terminating newline, or 'end'.
+ * *has_content_out is set if anything besides whitespace
+ * and comments was found.
+ */
+static const char *
+scan_logical_line (const char  *str,
+                   const char  *end,
+                   unsigned    *line_no_inout,
+                   bool        *has_content_out)
+{
+  unsigned line_no = *line_no_inout;
+  bool has_content = false;
+  while (str < end)
+    {
+      switch (*str)
+        {
+        case '\n':
+          goto done;
+
+        case ' ': case '\t': case '\r': case '\f': case '\v':
+          str++;
+          break;
+
+        case '\\':
+          if (str + 1 < end && str[1] == '\n')
+            {
+              str += 2;
+              line_no++;
+              break;
             }
-          else if (str[0] == '/' && str + 1 < end && str[1] == '*')
+          has_content = true;
+          str++;
+          break;
+
+        case '/':
+          if (str + 1 < end && str[1] == '*')
             {
               str += 2;
-              column += 2;
-              if (!scan_multiline_comment_body (&str, end, &line_no, &column))
+              while (str + 1 < end && !(str[0] == '*' && str[1] == '/'))
                 {
-                  /* unterminated comment (line_no and column should
-                     refer to the start of the comment). */
-                  DBCC_Error *error;
-                  error = dbcc_error_new (DBCC_ERROR_UNTERMINATED_MULTILINE_COMMENT,
-                                          "multiline-style comment unterminated (missing `*/')");
-                  dbcc_error_add_code_position (error, CREATE_CP());
-                  parser->handlers.handle_error (error, parser->handler_data);
-                  return false;
+                  if (*str == '\n')
+                    line_no++;
+                  str++;
                 }
+              str = str + 1 < end ? str + 2 : end;
+              break;
             }
-          else if (str[0] == '/' && str + 1 < end && str[1] == '/')
+          if (str + 1 < end && str[1] == '/')
             {
-              const char *endline = str;
-              while (endline < end && *endline != '\n')
-                endline++;
-              if (endline == end)
+              str += 2;
+              while (str < end && *str != '\n')
                 {
-                  DBCC_Error *error;
-                  error = dbcc_error_new (DBCC_ERROR_MISSING_LINE_TERMINATOR,
-                                          "//-style comment not terminated by a newline");
-                  dbcc_error_add_code_position (error, CREATE_CP());
-                  parser->handlers.handle_error (error, parser->handler_data);
-                  return false;
+                  if (*str == '\\' && str + 1 < end && str[1] == '\n')
+                    {
+                      line_no++;
+                      str++;
+                    }
+                  str++;
                 }
-              str = endline + 1;
-              column = 1;
-              line_no++;
+              goto done;
             }
-          else if (*str == ' ' || *str == '\t')
+          has_content = true;
+          str++;
+          break;
+
+        case '"': case '\'':
+          {
+            char quote = *str++;
+            has_content = true;
+            while (str < end && *str != quote && *str != '\n')
+              {
+                if (*str == '\\' && str + 1 < end)
+                  {
+                    if (str[1] == '\n')
+                      line_no++;
+                    str++;
+                  }
+                str++;
+              }
+            if (str < end && *str == quote)
+              str++;
+            break;
+          }
+
+        default:
+          has_content = true;
+          str++;
+          break;
+        }
+    }
+
+done:
+  *line_no_inout = line_no;
+  *has_content_out = has_content;
+  return str;
+}
+
+/* --- Phase 2: line splicing ---
+ *
+ * The file is never copied to remove backslash-newlines.  Tokens
+ * point into the raw contents, and a splice between two tokens is
+ * skipped like whitespace.  Only a token that a splice actually
+ * interrupts ("FO\<newline>O", or a literal continued across lines)
+ * is copied, without its splices, into the token array's
+ * 'spliced' buffer.
+ */
+static inline bool
+is_line_splice (const char *at, const char *end)
+{
+  return at + 1 < end && at[0] == '\\' && at[1] == '\n';
+}
+
+static const char *
+find_line_splice (const char *str, const char *end)
+{
+  while (str < end)
+    {
+      const char *bs = memchr (str, '\\', end - str);
+      if (bs == NULL)
+        return NULL;
+      if (is_line_splice (bs, end))
+        return bs;
+      str = bs + 1;
+    }
+  return NULL;
+}
+
+/* Copy [str, end) to 'out', dropping splices.  Returns the length copied. */
+static size_t
+copy_spliced (const char *str, const char *end, char *out)
+{
+  char *at = out;
+  while (str < end)
+    {
+      const char *splice = find_line_splice (str, end);
+      const char *stop = splice ? splice : end;
+      memcpy (at, str, stop - str);
+      at += stop - str;
+      str = splice ? splice + 2 : end;
+    }
+  return at - out;
+}
+
+/* Returns the raw position of the 'n'th spliced character after 'str'. */
+static const char *
+skip_spliced (const char *str, const char *end, size_t n)
+{
+  for (;;)
+    {
+      while (is_line_splice (str, end))
+        str += 2;
+      if (n == 0)
+        return str;
+      str++;
+      n--;
+    }
+}
+
+/* Lex the token at 'str', which isn't whitespace or a comment.
+ * Returns the end of the token, or NULL on error.
+ */
+static const char *
+lex_directive_token (const char        *str,
+                     const char        *end,
+                     DBCC_CodePosition *cp,
+                     CPP_Token         *token_out,
+                     DBCC_Error       **error)
+{
+  unsigned dummy_line = 1, dummy_column = 1;
+  DBCC_ErrorCode code;
+  const char *start = str;
+  CPP_Token token;
+
+  if ((*str == 'L' || *str == 'u' || *str == 'U')
+   && str + 1 < end && str[1] == '\'')
+    goto character;
+  if (*str == 'L' && str + 1 < end && str[1] == '"')
+    goto string;
+
+  if (is_initial_identifer_char (*str))
+    {
+      str += scan_bareword (str, end);
+      token = CPP_TOKEN (BAREWORD, cp, start, str - start);
+    }
+  else if (*str == '"')
+    {
+string:
+      if (!scan_string (&str, &dummy_line, &dummy_column, end, &code))
+        goto lex_error;
+      token = CPP_TOKEN (STRING, cp, start, str - start);
+    }
+  else if (*str == '\'')
+    {
+character:
+      if (!scan_character (&str, &dummy_column, &dummy_line, end, &code))
+        goto lex_error;
+      token = CPP_TOKEN (CHAR, cp, start, str - start);
+    }
+  else
+    {
+      CPP_NumberParseResult num_res = try_number (str, end);
+      if (num_res.type == CPP_NUMBER_PARSE_BAD_NUMBER)
+        {
+          *error = dbcc_error_new (num_res.v_bad_number.error,
+                                   "bad numeric constant: %s",
+                                   num_res.v_bad_number.message);
+          dbcc_error_add_code_position (*error, cp);
+          return NULL;
+        }
+      if (num_res.type == CPP_NUMBER_PARSE_GOT_NUMBER)
+        {
+          str += num_res.v_number.number_length;
+          token = CPP_TOKEN (NUMBER, cp, start, str - start);
+        }
+      else
+        {
+          ScanPunctuatorResult punc_res = scan_punctuator (str, end);
+          switch (punc_res.type)
             {
-              column++;
+            case SCAN_PUNCTUATOR_RESULT_NO:
+              *error = dbcc_error_new (DBCC_ERROR_UNEXPECTED_CHARACTER,
+                                       "unexpected character/byte 0x%02x (%s)",
+                                       *str, dsk_ascii_byte_name (*str));
+              dbcc_error_add_code_position (*error, cp);
+              return NULL;
+            case SCAN_PUNCTUATOR_RESULT_SUCCESS:
+              str += punc_res.v_success.length;
+              token = CPP_TOKEN (OPERATOR, cp, start, str - start);
+              token.type = punc_res.v_success.token_type;
+              break;
+            case SCAN_PUNCTUATOR_RESULT_SUCCESS_DIGRAPH:
+              str += punc_res.v_success_digraph.length;
+              token = CPP_TOKEN (OPERATOR_DIGRAPH, cp, start, str - start);
+              if (punc_res.v_success_digraph.token_type != CPP_TOKEN_OPERATOR)
+                token.type = punc_res.v_success_digraph.token_type;
+              break;
+            }
+        }
+    }
+  *token_out = token;
+  return str;
+
+lex_error:
+  *error = dbcc_error_new (code, "error scanning token");
+  dbcc_error_add_code_position (*error, cp);
+  return NULL;
+}
+
+/* 6.4.7 Header names:  after "#include", "<...>" is a single
+ * token, kept as a STRING token starting with '<',
+ * so that spaces in the name survive.
+ */
+static const char *
+lex_header_name (const char        *str,
+                 const char        *end,
+                 DBCC_CodePosition *cp,
+                 CPP_Token         *token_out,
+                 DBCC_Error       **error)
+{
+  const char *close = memchr (str + 1, '>', end - (str + 1));
+  if (close == NULL)
+    {
+      *error = dbcc_error_new (DBCC_ERROR_BAD_PREPROCESSOR_DIRECTIVE,
+                               "missing '>' after #include <FILENAME");
+      dbcc_error_add_code_position (*error, cp);
+      return NULL;
+    }
+  *token_out = CPP_TOKEN (STRING, cp, str, close + 1 - str);
+  return close + 1;
+}
+
+static inline bool
+is_header_name_start (const char *str, const CPP_TokenArray *line)
+{
+  return *str == '<'
+      && line->n == 2
+      && line->tokens[1].type == CPP_TOKEN_BAREWORD
+      && line->tokens[1].length == 7
+      && memcmp (line->tokens[1].str, "include", 7) == 0;
+}
+
+/* Tokenize the logical line [str, end), which should come
+ * from scan_logical_line().  Comments and backslash-newlines
+ * are skipped.  The tokens point into the line, except those
+ * interrupted by a backslash-newline, which point into out->spliced;
+ * either way, they are valid until cpp_token_array_reset().
+ * Each token holds a reference to 'cp'.
+ */
+static bool
+tokenize_directive_line (const char        *str,
+                         const char        *end,
+                         DBCC_CodePosition *cp,
+                         CPP_TokenArray    *out,
+                         DBCC_Error       **error)
+{
+  const char *line_start = str;
+  const char *splice = find_line_splice (str, end);
+  while (str < end)
+    {
+      const char *start = str;
+      CPP_Token token;
+      if (*str == ' ' || *str == '\t' || *str == '\r' || *str == '\f' || *str == '\v')
+        {
+          str++;
+          continue;
+        }
+      if (is_line_splice (str, end))
+        {
+          str += 2;
+          continue;
+        }
+      if (*str == '/' && str + 1 < end && str[1] == '*')
+        {
+          str += 2;
+          while (str + 1 < end && !(str[0] == '*' && str[1] == '/'))
+            str++;
+          str = str + 1 < end ? str + 2 : end;
+          continue;
+        }
+      if (*str == '/' && str + 1 < end && str[1] == '/')
+        break;
+
+      bool is_header_name = is_header_name_start (start, out);
+      if (is_header_name)
+        str = lex_header_name (start, end, cp, &token, error);
+      else
+        str = lex_directive_token (start, end, cp, &token, error);
+
+      if (splice != NULL && splice < start)
+        splice = find_line_splice (start, end);
+      if (str == NULL)
+        {
+          /* A literal interrupted by a splice may not lex raw
+             ('a\<newline>'):  it is only an error if the spliced
+             text doesn't lex either. */
+          if (splice == NULL)
+            return false;
+          dbcc_error_unref (*error);
+          *error = NULL;
+        }
+      if (str == NULL || (splice != NULL && splice <= str))
+        {
+          /* The token runs into a splice:  lex it again from a
+             spliced copy of the rest of the line.  Every copy is
+             no longer than the raw text it came from, so the
+             line's copies fit in one buffer of the line's size. */
+          if (out->spliced == NULL)
+            {
+              out->spliced = malloc (end - line_start);
+              out->n_spliced = 0;
+            }
+          char *copy = out->spliced + out->n_spliced;
+          size_t copy_len = copy_spliced (start, end, copy);
+          if ((is_header_name
+               ? lex_header_name (copy, copy + copy_len, cp, &token, error)
+               : lex_directive_token (copy, copy + copy_len, cp, &token, error)) == NULL)
+            return false;
+          str = skip_spliced (start, end, token.length);
+          out->n_spliced += token.length;
+        }
+      dbcc_code_position_ref (cp);
+      cpp_token_array_append (out, &token);
+    }
+  return true;
+}
+
+static void
+cpp_token_array_reset (CPP_TokenArray *arr)
+{
+  for (unsigned i = 0; i < arr->n; i++)
+    dbcc_code_position_unref (arr->tokens[i].code_position);
+  arr->n = 0;
+  free (arr->spliced);
+  arr->spliced = NULL;
+  arr->n_spliced = 0;
+}
+
+/* --- Dependency scanning --- */
+typedef struct DependencyScan DependencyScan;
+struct DependencyScan
+{
+  DBCC_Parser *parser;
+  DBCC_PtrTable seen;                   /* filename-symbol => itself */
+  size_t n_deps;
+  DBCC_Symbol **deps;
+  size_t deps_alloced;
+  DBCC_Error *error;
+};
+
+#define MAX_INCLUDE_DEPTH     200
+
+static DBCC_Symbol *
+try_include_path (DBCC_Parser *parser,
+                  size_t       dir_len,
+                  const char  *dir,
+                  size_t       name_len,
+                  const char  *name)
+{
+  char *path = malloc (dir_len + 1 + name_len + 1);
+  size_t at = 0;
+  if (dir_len > 0)
+    {
+      memcpy (path, dir, dir_len);
+      at = dir_len;
+      if (path[at - 1] != '/')
+        path[at++] = '/';
+    }
+  memcpy (path + at, name, name_len);
+  path[at + name_len] = 0;
+  DBCC_Symbol *rv = NULL;
+  if (dsk_file_test_exists (path))
+    rv = dbcc_symbol_space_force (parser->symbol_space, path);
+  free (path);
+  return rv;
+}
+
+/* Search for an #include'd file:  quoted names are first
+ * looked up relative to the including file (6.10.2p3),
+ * then both forms search the include-dirs in order.
+ */
+static DBCC_Symbol *
+resolve_include (DBCC_Parser *parser,
+                 DBCC_Symbol *including_file,
+                 bool         is_quoted,
+                 size_t       name_len,
+                 const char  *name)
+{
+  DBCC_Symbol *rv;
+  if (name_len > 0 && name[0] == '/')
+    return try_include_path (parser, 0, NULL, name_len, name);
+  if (is_quoted)
+    {
+      const char *inc = dbcc_symbol_get_string (including_file);
+      const char *slash = strrchr (inc, '/');
+      rv = try_include_path (parser, slash ? (size_t)(slash - inc) : 0, inc,
+                             name_len, name);
+      if (rv != NULL)
+        return rv;
+    }
+  for (size_t i = 0; i < parser->n_include_dirs; i++)
+    {
+      const char *dir = parser->include_dirs[i];
+      rv = try_include_path (parser, strlen (dir), dir, name_len, name);
+      if (rv != NULL)
+        return rv;
+    }
+  return NULL;
+}
+
+/* Extract the header-name from the tokens after "#include",
+ * macro-expanding them if needed (6.10.2p4).
+ * The returned name must be freed.
+ */
+static char *
+get_include_name (DBCC_Parser *parser,
+                  unsigned     n_tokens,
+                  CPP_Token   *tokens,
+                  bool        *is_quoted_out,
+                  DBCC_Error **error)
+{
+  CPP_MacroExpansionResult res = expand_macros (parser, n_tokens, tokens);
+  char *rv = NULL;
+  switch (res.type)
+    {
+    case CPP_MACRO_EXPANSION_RESULT_NO_CHANGE:
+      break;
+    case CPP_MACRO_EXPANSION_RESULT_SUCCESS:
+      n_tokens = res.v_success.n_expanded_tokens;
+      tokens = res.v_success.expanded_tokens;
+      break;
+    case CPP_MACRO_EXPANSION_RESULT_ERROR:
+      *error = res.v_error.error;
+      return NULL;
+    }
+  if (n_tokens >= 1 && tokens[0].type == CPP_TOKEN_STRING
+   && (tokens[0].str[0] == '"' || tokens[0].str[0] == '<')
+   && tokens[0].length >= 2)
+    {
+      *is_quoted_out = tokens[0].str[0] == '"';
+      rv = strndup (tokens[0].str + 1, tokens[0].length - 2);
+    }
+  else if (n_tokens >= 2 && is_single_char_operator (&tokens[0], '<'))
+    {
+      DskBuffer name = DSK_BUFFER_INIT;
+      unsigned i;
+      for (i = 1; i < n_tokens && !is_single_char_operator (&tokens[i], '>'); i++)
+        dsk_buffer_append (&name, tokens[i].length, tokens[i].str);
+      if (i < n_tokens)
+        {
+          *is_quoted_out = false;
+          rv = dsk_buffer_empty_to_string (&name);
+        }
+      else
+        dsk_buffer_clear (&name);
+    }
+  if (rv == NULL)
+    {
+      *error = dbcc_error_new (DBCC_ERROR_BAD_PREPROCESSOR_DIRECTIVE,
+                               "#include expects \"FILENAME\" or <FILENAME>");
+      if (n_tokens > 0)
+        dbcc_error_add_code_position (*error, tokens[0].code_position);
+    }
+  if (res.type == CPP_MACRO_EXPANSION_RESULT_SUCCESS)
+    free (res.v_success.expanded_tokens);
+  return rv;
+}
+
+static inline bool
+directive_name_is (size_t len, const char *str, const char *name)
+{
+  return strlen (name) == len && memcmp (str, name, len) == 0;
+}
+
+typedef enum
+{
+  GUARD_STATE_AT_START,
+  GUARD_STATE_INSIDE,
+  GUARD_STATE_CLOSED,
+  GUARD_STATE_NONE
+} GuardState;
+
+static bool
+scan_dependencies_in_file (DependencyScan    *scan,
+                           DBCC_Symbol       *filename,
+                           DBCC_CodePosition *included_from,
+                           unsigned           depth)
+{
+  DBCC_Parser *parser = scan->parser;
+  DskError *dsk_error = NULL;
+  size_t size;
+  uint8_t *contents = dsk_file_get_contents (dbcc_symbol_get_string (filename),
+                                             &size, &dsk_error);
+  if (contents == NULL)
+    {
+      scan->error = dbcc_error_new (DBCC_ERROR_READING_FILE,
+                                    "%s", dsk_error->message);
+      if (included_from != NULL)
+        dbcc_error_add_code_position (scan->error, included_from);
+      dsk_error_unref (dsk_error);
+      return false;
+    }
+
+  unsigned stack_alloced = 32;
+  CPP_StackFrameStatus *stack = malloc (sizeof (CPP_StackFrameStatus) * stack_alloced);
+  unsigned level = 0;
+  GuardState guard_state = GUARD_STATE_AT_START;
+  DBCC_Symbol *guard = NULL;
+  CPP_TokenArray line_tokens = CPP_TOKEN_ARRAY_INIT;
+  DBCC_Error *error = NULL;
+
+  const char *str = (const char *) contents;
+  const char *end = str + size;
+  unsigned line_no = 1;
+  while (str < end)
+    {
+      const char *at = str;
+      unsigned directive_line_no = line_no;
+      bool active = level == 0 || is_active_cpp_stack_state (stack[level-1]);
+      bool has_content;
+      while (at < end && (*at == ' ' || *at == '\t' || *at == '\r' || *at == '\f' || *at == '\v'))
+        at++;
+      const char *line_end = scan_logical_line (at, end, &line_no, &has_content);
+
+      if (at == line_end || *at != '#')
+        {
+          /* Non-directive lines are skipped without being tokenized. */
+          if (has_content && level == 0)
+            guard_state = GUARD_STATE_NONE;
+          goto next_line;
+        }
+
+      /* Directive name, read directly from the source
+         unless a backslash-newline interrupts it. */
+      const char *name = at + 1;
+      while (name < line_end && (*name == ' ' || *name == '\t'
+                                 || is_line_splice (name, line_end)))
+        name += *name == '\\' ? 2 : 1;
+      const char *name_end = name;
+      while (name_end < line_end && is_initial_identifer_char (*name_end))
+        name_end++;
+      size_t name_len = name_end - name;
+      char spliced_name[16];
+      if (is_line_splice (name_end, line_end))
+        {
+          const char *in = name;
+          name_len = 0;
+          for (;;)
+            {
+              while (is_line_splice (in, line_end))
+                in += 2;
+              if (in == line_end || !is_initial_identifer_char (*in)
+               || name_len == sizeof (spliced_name))
+                break;
+              spliced_name[name_len++] = *in++;
             }
-          else if (is_initial_identifer_char (*str))
+          name = spliced_name;
+        }
+
+      bool is_if = directive_name_is (name_len, name, "if");
+      bool is_ifdef = directive_name_is (name_len, name, "ifdef");
+      bool is_ifndef = directive_name_is (name_len, name, "ifndef");
+      bool is_elif = directive_name_is (name_len, name, "elif");
+      if (level == 0 && !is_ifndef)
+        guard_state = GUARD_STATE_NONE;
+
+      /* In inactive regions, only conditional nesting matters. */
+      if (!active)
+        {
+          if (is_if || is_ifdef || is_ifndef)
             {
-              unsigned bw_len = scan_bareword (str, end);
-              if (bw_len == 0)
+              if (level == stack_alloced)
                 {
-                  assert(0);
+                  stack_alloced *= 2;
+                  stack = realloc (stack, sizeof (CPP_StackFrameStatus) * stack_alloced);
                 }
-              APPEND_CPP_TOKEN(
-                BAREWORD,
-                CREATE_CP(),
-                str,
-                1
-              );
+              stack[level++] = CPP_STACK_INACTIVE_PARENT;
+              goto next_line;
             }
-          else if (*str == '"'
-                || (*str == 'L' && str + 1 < end && str[1] == '"'))
+          if (!is_elif
+           && !directive_name_is (name_len, name, "else")
+           && !directive_name_is (name_len, name, "endif"))
+            goto next_line;
+        }
+
+      DBCC_CodePosition *cp = dbcc_code_position_new (NULL, included_from, filename,
+                                                      directive_line_no,
+                                                      at - str + 1,
+                                                      at - (const char *) contents);
+      bool ok = tokenize_directive_line (at, line_end, cp, &line_tokens, &error);
+      dbcc_code_position_unref (cp);
+      if (!ok)
+        goto failed;
+      CPP_Token *args = line_tokens.tokens + 2;
+      unsigned n_args = line_tokens.n >= 2 ? line_tokens.n - 2 : 0;
+
+      if (is_if || is_ifdef || is_ifndef || is_elif)
+        {
+          CPP_Expr cpp_expr;
+          bool result = false;
+          cpp_expr.expr_type = is_ifdef ? CPP_EXPR_IFDEF
+                             : is_ifndef ? CPP_EXPR_IFNDEF
+                             : CPP_EXPR_IF;
+          cpp_expr.n_tokens = n_args;
+          cpp_expr.tokens = args;
+          if ((is_ifdef || is_ifndef)
+           && (n_args != 1 || args[0].type != CPP_TOKEN_BAREWORD))
             {
-              DBCC_ErrorCode code;
-              const char *str_start = str;
-              if (!scan_string (&str, &line_no, &column, end, &code))
-                {
-                  assert(0);
-                }
-              APPEND_TOKEN(CPP_TOKEN(
-                STRING,
-                CREATE_CP(),
-                str_start,
-                str - str_start
-              ));
+              error = dbcc_error_new (DBCC_ERROR_BAD_PREPROCESSOR_DIRECTIVE,
+                                      "#ifdef/#ifndef must be followed by exactly one identifier");
+              dbcc_error_add_code_position (error, line_tokens.tokens[0].code_position);
+              goto failed;
             }
-          else if (*str == '\'')
+          if (is_elif && level == 0)
             {
-              DBCC_ErrorCode code;
-              const char *str_start = str;
-              if (!scan_character (&str, &column, &line_no, end, &code))
-                {
-                  assert(0);
-                }
-              APPEND_TOKEN(CPP_TOKEN(
-                CHAR,
-                CREATE_CP(),
-                str_start,
-                str - str_start
-              ));
+              error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_ELSE_NOT_ALLOWED,
+                                      "#elif encountered at toplevel");
+              dbcc_error_add_code_position (error, line_tokens.tokens[0].code_position);
+              goto failed;
             }
-          else 
+          if (is_elif)
             {
-              CPP_NumberParseResult res = try_number (str, end);
-              switch (res.type)
+              switch (stack[level-1])
                 {
-                case CPP_NUMBER_PARSE_NOTHING:
+                case CPP_STACK_ACTIVE:
+                  stack[level-1] = CPP_STACK_INACTIVE_BUT_HAS_BEEN_ACTIVE;
+                  break;
+                case CPP_STACK_INACTIVE_SO_FAR:
+                  ok = eval_cpp_expr_boolean (parser, &cpp_expr, &result, &error);
+                  line_tokens.n = cpp_expr.n_tokens + 2;
+                  if (!ok)
+                    goto failed;
+                  if (result)
+                    stack[level-1] = CPP_STACK_ACTIVE;
                   break;
-                case CPP_NUMBER_PARSE_BAD_NUMBER:
+                case CPP_STACK_ACTIVE_ELSE:
+                case CPP_STACK_INACTIVE_BUT_HAS_BEEN_ACTIVE_ELSE:
+                  error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_ELSE_NOT_ALLOWED,
+                                          "#elif after #else");
+                  dbcc_error_add_code_position (error, line_tokens.tokens[0].code_position);
+                  goto failed;
+                default:
+                  break;
+                }
+            }
+          else
+            {
+              /* eval_cpp_expr_boolean() may have folded 'defined X' tokens,
+                 releasing the ones it dropped, even if it then fails */
+              ok = eval_cpp_expr_boolean (parser, &cpp_expr, &result, &error);
+              line_tokens.n = cpp_expr.n_tokens + 2;
+              if (!ok)
+                goto failed;
+
+              if (level == 0 && is_ifndef && guard_state == GUARD_STATE_AT_START)
+                {
+                  guard = dbcc_symbol_space_force_len (parser->symbol_space,
+                                                       args[0].length,
+                                                       args[0].str);
+                  guard_state = GUARD_STATE_INSIDE;
+                }
+              else if (level == 0)
+                guard_state = GUARD_STATE_NONE;
+              if (level == stack_alloced)
+                {
+                  stack_alloced *= 2;
+                  stack = realloc (stack, sizeof (CPP_StackFrameStatus) * stack_alloced);
+                }
+              stack[level++] = result ? CPP_STACK_ACTIVE : CPP_STACK_INACTIVE_SO_FAR;
+            }
+        }
+      else if (directive_name_is (name_len, name, "else"))
+        {
+          if (level == 0)
+            {
+              error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_UNMATCHED_ELSE,
+                                      "got #else directive without corresponding #if");
+              dbcc_error_add_code_position (error, line_tokens.tokens[0].code_position);
+              goto failed;
+            }
+          switch (stack[level-1])
+            {
+            case CPP_STACK_INACTIVE_PARENT:
+              break;
+            case CPP_STACK_INACTIVE_SO_FAR:
+              stack[level-1] = CPP_STACK_ACTIVE_ELSE;
+              break;
+            case CPP_STACK_ACTIVE:
+            case CPP_STACK_INACTIVE_BUT_HAS_BEEN_ACTIVE:
+              stack[level-1] = CPP_STACK_INACTIVE_BUT_HAS_BEEN_ACTIVE_ELSE;
+              break;
+            case CPP_STACK_ACTIVE_ELSE:
+            case CPP_STACK_INACTIVE_BUT_HAS_BEEN_ACTIVE_ELSE:
+              error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_ELSE_NOT_ALLOWED,
+                                      "already had #else directive");
+              dbcc_error_add_code_position (error, line_tokens.tokens[0].code_position);
+              goto failed;
+            }
+        }
+      else if (directive_name_is (name_len, name, "endif"))
+        {
+          if (level == 0)
+            {
+              error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_UNMATCHED_ENDIF,
+                                      "#endif without corresponding #if");
+              dbcc_error_add_code_position (error, line_tokens.tokens[0].code_position);
+              goto failed;
+            }
+          level--;
+          if (level == 0 && guard_state == GUARD_STATE_INSIDE)
+            guard_state = GUARD_STATE_CLOSED;
+        }
+      else if (directive_name_is (name_len, name, "define"))
+        {
+          if (!define_macro (parser, n_args, args, &error))
+            goto failed;
+        }
+      else if (directive_name_is (name_len, name, "undef"))
+        {
+          if (n_args != 1 || args[0].type != CPP_TOKEN_BAREWORD)
+            {
+              error = dbcc_error_new (DBCC_ERROR_BAD_PREPROCESSOR_DIRECTIVE,
+                                      "#undef must be followed by exactly one identifier");
+              dbcc_error_add_code_position (error, line_tokens.tokens[0].code_position);
+              goto failed;
+            }
+          DBCC_Symbol *sym = dbcc_symbol_space_try_len (parser->symbol_space,
+                                                        args[0].length, args[0].str);
+          if (sym != NULL)
+            undefine_macro (parser, sym);
+        }
+      else if (directive_name_is (name_len, name, "include")
+            || directive_name_is (name_len, name, "include_next"))
+        {
+          bool is_quoted;
+          char *inc_name = get_include_name (parser, n_args, args, &is_quoted, &error);
+          if (inc_name == NULL)
+            goto failed;
+          DBCC_Symbol *inc = resolve_include (parser, filename, is_quoted,
+                                              strlen (inc_name), inc_name);
+          if (inc == NULL)
+            {
+              error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_INCLUDE_NOT_FOUND,
+                                      "%s: file not found", inc_name);
+              dbcc_error_add_code_position (error, line_tokens.tokens[0].code_position);
+              free (inc_name);
+              goto failed;
+            }
+          free (inc_name);
+
+          bool created;
+          DBCC_PtrTable_Entry *entry = dbcc_ptr_table_force (&scan->seen, inc, &created);
+          if (created)
+            {
+              entry->value = inc;
+              if (scan->n_deps == scan->deps_alloced)
+                {
+                  scan->deps_alloced = scan->deps_alloced ? scan->deps_alloced * 2 : 16;
+                  scan->deps = realloc (scan->deps, sizeof (DBCC_Symbol *) * scan->deps_alloced);
+                }
+              scan->deps[scan->n_deps++] = inc;
+            }
+
+          /* Files already read in this scan whose guard still holds
+           * need not be reread:  their dependencies are known. */
+          DBCC_Symbol *inc_guard = created ? NULL : dbcc_ptr_table_lookup_value (&parser->include_guards, inc);
+          if (inc_guard == inc
+           || (inc_guard != NULL && lookup_macro (parser, inc_guard) != NULL))
+            goto next_directive;
+
+          if (depth + 1 >= MAX_INCLUDE_DEPTH)
+            {
+              error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_INCLUDE_DEPTH,
+                                      "#include nested too deeply (%u levels)",
+                                      depth + 1);
+              dbcc_error_add_code_position (error, line_tokens.tokens[0].code_position);
+              goto failed;
+            }
+          if (!scan_dependencies_in_file (scan, inc,
+                                          line_tokens.tokens[0].code_position,
+                                          depth + 1))
+            goto failed_in_include;
+        }
+      else if (directive_name_is (name_len, name, "pragma"))
+        {
+          if (n_args == 1
+           && args[0].type == CPP_TOKEN_BAREWORD
+           && args[0].length == 4
+           && memcmp (args[0].str, "once", 4) == 0)
+            dbcc_ptr_table_set (&parser->include_guards, filename, filename);
+        }
+      else if (directive_name_is (name_len, name, "error"))
+        {
+          error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_HASH_ERROR,
+                                  "#error processed: %.*s",
+                                  (int)(line_end - name_end), name_end);
+          dbcc_error_add_code_position (error, line_tokens.tokens[0].code_position);
+          goto failed;
+        }
+      /* #line, #warning, #ident and unknown #pragmas do not affect dependencies. */
+
+next_directive:
+      cpp_token_array_reset (&line_tokens);
+
+next_line:
+      if (line_end < end)
+        {
+          line_end++;
+          line_no++;
+        }
+      str = line_end;
+    }
+
+  if (guard_state == GUARD_STATE_CLOSED)
+    dbcc_ptr_table_set (&parser->include_guards, filename, guard);
+  cpp_token_array_reset (&line_tokens);
+  free (line_tokens.tokens);
+  free (stack);
+  free (contents);
+  return true;
+
+failed:
+  scan->error = error;
+failed_in_include:
+  cpp_token_array_reset (&line_tokens);
+  free (line_tokens.tokens);
+  free (stack);
+  free (contents);
+  return false;
+}
+
+/* Make-style escaping of filenames:  spaces are backslashed,
+ * and dollar-signs are doubled.
+ */
+static void
+append_make_escaped (DskBuffer *out, const char *str)
+{
+  for (; *str; str++)
+    {
+      if (*str == ' ' || *str == '#')
+        dsk_buffer_append_byte (out, '\\');
+      else if (*str == '$')
+        dsk_buffer_append_byte (out, '$');
+      dsk_buffer_append_byte (out, *str);
+    }
+}
+
+static void
+append_json_quoted (DskBuffer *out, const char *str)
+{
+  dsk_buffer_append_byte (out, '"');
+  for (; *str; str++)
+    {
+      if (*str == '"' || *str == '\\')
+        {
+          dsk_buffer_append_byte (out, '\\');
+          dsk_buffer_append_byte (out, *str);
+        }
+      else if ((uint8_t) *str < 32)
+        dsk_buffer_printf (out, "\\u%04x", (uint8_t) *str);
+      else
+        dsk_buffer_append_byte (out, *str);
+    }
+  dsk_buffer_append_byte (out, '"');
+}
+
+bool
+dbcc_parser_scan_dependencies (DBCC_Parser          *parser,
+                               const char           *filename,
+                               const char           *target,
+                               DBCC_DependencyFormat format,
+                               DskBuffer            *out)
+{
+  DependencyScan scan;
+  scan.parser = parser;
+  dbcc_ptr_table_init (&scan.seen);
+  scan.n_deps = 0;
+  scan.deps = NULL;
+  scan.deps_alloced = 0;
+  scan.error = NULL;
+
+  /* Each file is its own translation unit:  forget the macros
+     and include guards left by the previous scan. */
+  free_macro_tree (parser->macro_tree);
+  parser->macro_tree = NULL;
+  dbcc_ptr_table_clear (&parser->include_guards);
+
+  DBCC_Symbol *filename_symbol = dbcc_symbol_space_force (parser->symbol_space, filename);
+  if (!scan_dependencies_in_file (&scan, filename_symbol, NULL, 0))
+    {
+      parser->handlers.handle_error (scan.error, parser->handler_data);
+      dbcc_ptr_table_clear (&scan.seen);
+      free (scan.deps);
+      return false;
+    }
+
+  /* Default target:  foo/bar.c => bar.o, as cc -M does. */
+  char *default_target = NULL;
+  if (target == NULL)
+    {
+      const char *base = strrchr (filename, '/');
+      base = base ? base + 1 : filename;
+      const char *dot = strrchr (base, '.');
+      size_t stem_len = dot ? (size_t)(dot - base) : strlen (base);
+      default_target = malloc (stem_len + 3);
+      memcpy (default_target, base, stem_len);
+      memcpy (default_target + stem_len, ".o", 3);
+      target = default_target;
+    }
+
+  switch (format)
+    {
+    case DBCC_DEPENDENCY_FORMAT_MAKE:
+      append_make_escaped (out, target);
+      dsk_buffer_append_string (out, ": ");
+      append_make_escaped (out, filename);
+      for (size_t i = 0; i < scan.n_deps; i++)
+        {
+          dsk_buffer_append_string (out, " \\\n  ");
+          append_make_escaped (out, dbcc_symbol_get_string (scan.deps[i]));
+        }
+      dsk_buffer_append_byte (out, '\n');
+      break;
+
+    case DBCC_DEPENDENCY_FORMAT_JSON:
+      dsk_buffer_append_string (out, "{\"target\":");
+      append_json_quoted (out, target);
+      dsk_buffer_append_string (out, ",\"source\":");
+      append_json_quoted (out, filename);
+      dsk_buffer_append_string (out, ",\"dependencies\":[");
+      for (size_t i = 0; i < scan.n_deps; i++)
+        {
+          if (i > 0)
+            dsk_buffer_append_byte (out, ',');
+          append_json_quoted (out, dbcc_symbol_get_string (scan.deps[i]));
+        }
+      dsk_buffer_append_string (out, "]}\n");
+      break;
+    }
+
+  free (default_target);
+  dbcc_ptr_table_clear (&scan.seen);
+  free (scan.deps);
+  return true;
+}
+
+/* 'ns_entry' is what 'symbol' names in the global namespace,
+ * or NULL if nothing.
+ */
+static P_Token
+bareword_to_ptoken (DBCC_CodePosition         *cp,
+                    DBCC_Symbol               *symbol,
+                    const DBCC_NamespaceEntry *ns_entry)
+{
+  P_Token pt;
+  if (ns_entry == NULL)
+    {
+      // fallback to IDENTIFIER
+      pt = (P_Token) {.code_position = cp,
+                      .token_type = P_TOKEN_IDENTIFIER,
+                      .v_identifier = symbol};
+    }
+  else
+    switch (ns_entry->entry_type)
+      {
+      case DBCC_NAMESPACE_ENTRY_TYPEDEF:
+        pt = (P_Token) {.code_position = cp,
+                        .token_type = P_TOKEN_TYPEDEF_NAME,
+                        .v_typedef_name.type = ns_entry->v_typedef,
+                        .v_typedef_name.name = symbol };
+        break;
+      case DBCC_NAMESPACE_ENTRY_GLOBAL:
+        pt = (P_Token) {.code_position = cp,
+                        .token_type = P_TOKEN_IDENTIFIER,
+                        .v_identifier = symbol};
+        break;
+      case DBCC_NAMESPACE_ENTRY_ENUM_VALUE:
+        pt = (P_Token) {.code_position = cp,
+                        .token_type = P_TOKEN_ENUMERATION_CONSTANT,
+                        .v_enum_value.type = ns_entry->v_enum_value.enum_type,
+                        .v_enum_value.enum_value = ns_entry->v_enum_value.enum_value};
+        break;
+      default:
+        assert(0);
+      }
+  return pt;
+}
+
+/* Convert a preprocessed token into the token-type the lemon parser
+ * wants.  Barewords are classified as reserved words, typedef-names,
+ * enum values or identifiers according to the current namespace.
+ */
+static bool
+cpp_token_to_ptoken (DBCC_Parser *parser,
+                     CPP_Token   *token,
+                     P_Token     *out,
+                     DBCC_Error **error_out)
+{
+  DBCC_CodePosition *cp = token->code_position;
+  P_Token pt;
+  DBCC_Error *error = NULL;
+  switch (token->type)
+    {
+    case CPP_TOKEN_HASH:
+      assert(false);
+    case CPP_TOKEN_CONCATENATE:              /* ## */
+      assert(false);
+    case CPP_TOKEN_MACRO_ARGUMENT:
+    case CPP_TOKEN_NEWLINE:
+      assert(false);
+    case CPP_TOKEN_STRING:
+      pt = P_TOKEN_INIT(STRING_LITERAL, cp);
+      if (!dbcc_common_string_literal_value (token->length,
+                                             token->str,
+                                             &pt.v_string_literal,
+                                             &error))
+       {
+         dbcc_error_add_code_position (error, token->code_position);
+         *error_out = error;
+         return false;
+       }
+      pt.v_string_literal.is_wchar = token->str[0] == 'L';
+      *out = pt;
+      break;
+    case CPP_TOKEN_CHAR:
+      {
+        uint32_t value;
+        size_t sizeof_char;
+        if (!dbcc_common_char_constant_value (parser->target_environment,
+                                              token->length,
+                                              token->str,
+                                              &value,
+                                              &sizeof_char,
+                                              &error))
+          {
+            dbcc_error_add_code_position (error, token->code_position);
+            *error_out = error;
+            return false;
+          }
+        P_Token t = {
+          .code_position = token->code_position,
+          .token_type = P_TOKEN_I_CONSTANT,
+          .v_i_constant.sizeof_value = sizeof_char,
+          .v_i_constant.is_signed = false,
+          .v_i_constant.v_uint64 = value,
+        };
+        *out = t;
+      }
+      break;
+    case CPP_TOKEN_NUMBER:
+      {
+        if (dbcc_common_number_is_integral (token->length,
+                                            token->str))
+          {
+            size_t sizeof_int_type;
+            bool is_signed;
+            if (!dbcc_common_integer_get_info (parser->target_environment,
+                                               token->length,
+                                               token->str,
+                                               &sizeof_int_type,
+                                               &is_signed,
+                                               &error))
+              {
+                dbcc_error_add_code_position (error, token->code_position);
+                *error_out = error;
+                return false;
+              }
+
+            if (is_signed)
+              {
+                char *end;
+                int64_t v = strtoll (token->str, &end, 0);
+                if (token->str == end)
                   {
-                    DBCC_Error *error = dbcc_error_new (res.v_bad_number.error,
-                                                        "bad numeric constant: %s",
-                                                        res.v_bad_number.message);
-                    dbcc_error_add_code_position (error, CREATE_CP());
-                    parser->handlers.handle_error(error, parser->handler_data);
-                    dbcc_error_unref (error);
+                    error = dbcc_error_new (DBCC_ERROR_PARSING_INTEGER,
+                                            "error parsing signed integer");
+                    dbcc_error_add_code_position (error, token->code_position);
+                    *error_out = error;
                     return false;
                   }
-                case CPP_NUMBER_PARSE_GOT_NUMBER:
+                P_Token t = {
+                  .code_position = token->code_position,
+                  .token_type = P_TOKEN_I_CONSTANT,
+                  .v_i_constant.sizeof_value = sizeof_int_type,
+                  .v_i_constant.is_signed = is_signed,
+                  .v_i_constant.v_int64 = v,
+                };
+                *out = t;
+              }
+            else
+              {
+                char *end;
+                uint64_t v = strtoull (token->str, &end, 0);
+                if (token->str == end)
                   {
-                    APPEND_TOKEN(CPP_TOKEN(
-                      NUMBER,
-                      CREATE_CP(),
-                      str,
-                      res.v_number.number_length
-                    ));
-                    str += res.v_number.number_length;
-                    column += res.v_number.number_length;
+                    error = dbcc_error_new (DBCC_ERROR_PARSING_INTEGER,
+                                            "error parsing unsigned integer");
+                    dbcc_error_add_code_position (error, token->code_position);
+                    *error_out = error;
+                    return false;
                   }
+                P_Token t = {
+                  .code_position = token->code_position,
+                  .token_type = P_TOKEN_I_CONSTANT,
+                  .v_i_constant.sizeof_value = sizeof_int_type,
+                  .v_i_constant.is_signed = is_signed,
+                  .v_i_constant.v_uint64 = v,
+                };
+                *out = t;
+              }
+          }
+        else
+          {
+            char *end;
+            long double v = strtold(token->str, &end);
+            if (token->str == end)
+              {
+                error = dbcc_error_new (DBCC_ERROR_PARSING_FLOAT,
+                                        "error parsing floating-pointer number");
+                dbcc_error_add_code_position (error, token->code_position);
+                *error_out = error;
+                return false;
+              }
+            DBCC_FloatType float_type;
+            if (!dbcc_common_floating_point_get_info(parser->target_environment,
+                                            token->length,
+                                            token->str,
+                                            &float_type,
+                                            &error))
+              {
+                dbcc_error_add_code_position (error, token->code_position);
+                *error_out = error;
+                return false;
+              }
+            P_Token t = {
+              .code_position = token->code_position,
+              .token_type = P_TOKEN_F_CONSTANT,
+              .v_f_constant.float_type = float_type,
+              .v_f_constant.v_long_double = v,
+            };
+            *out = t;
+          }
+      }
+      break;
+
+    case CPP_TOKEN_OPERATOR:
+      {
+        memset (&pt, 0, sizeof (P_Token));
+        if (!convert_cpp_token_operator_to_ptokentype (token, &pt.token_type, &error))
+          {
+            *error_out = error;
+            return false;
+          }
+        pt.code_position = cp;
+        *out = pt;
+        break;
+      }
+
+    case CPP_TOKEN_OPERATOR_DIGRAPH:
+      {
+        memset (&pt, 0, sizeof (P_Token));
+        if (!convert_cpp_token_digraph_operator_to_ptokentype (token, &pt.token_type, &error))
+          {
+            *error_out = error;
+            return false;
+          }
+        pt.code_position = cp;
+        *out = pt;
+        break;
+      }
+
+    case CPP_TOKEN_BAREWORD:
+      {
+        int token_type;
+        DBCC_Symbol *symbol = dbcc_symbol_space_force_len (parser->symbol_space,
+                                                           token->length,
+                                                           token->str);
+        if (is_reserved_word (symbol, &token_type))
+          {
+            // known reserved word
+            pt = (P_Token) {.code_position = token->code_position,
+                            .token_type = token_type};
+          }
+        else
+          {
+            DBCC_NamespaceEntry ns_entry;
+            bool found = dbcc_namespace_lookup (parser_get_ns (parser),
+                                                symbol,
+                                                &ns_entry);
+            pt = bareword_to_ptoken (token->code_position, symbol,
+                                     found ? &ns_entry : NULL);
+          }
+        *out = pt;
+        break;
+      }
+    }
+  return true;
+}
+
+static bool
+emit_ptoken (DBCC_Parser *parser,
+             P_Token      pt,
+             DBCC_Error **error)
+{
+  if (parser->lazy_function_bodies
+   && pt.token_type == P_TOKEN_IDENTIFIER
+   && pt.v_identifier != parser->lazy.declaring_name)
+    {
+      LazyState *lazy = &parser->lazy;
+      if (dbcc_ptr_table_lookup_value (&lazy->referenced, pt.v_identifier) == NULL)
+        dbcc_ptr_table_set (&lazy->referenced, pt.v_identifier, pt.v_identifier);
+      LazyFunctionBody *body = dbcc_ptr_table_lookup_value (&lazy->bodies_by_name,
+                                                            pt.v_identifier);
+      if (body != NULL)
+        body->needed = true;
+    }
+  DBCC_Lemon_Parser (parser->lemon_parser, pt.token_type, pt, parser->context);
+  *error = p_context_take_error (parser->context);
+  return *error == NULL;
+}
+
+static bool
+emit_cpp_token (DBCC_Parser *parser,
+                CPP_Token   *token,
+                DBCC_Error **error)
+{
+  P_Token pt;
+  if (!cpp_token_to_ptoken (parser, token, &pt, error))
+    return false;
+  return emit_ptoken (parser, pt, error);
+}
+
+/* --- Lazy function bodies ---
+ *
+ * Toplevel tokens are held back until the end of each declaration.
+ * If the declaration turns out to be a function definition
+ * with a simple declarator, only its prototype is passed to the parser,
+ * and the whole definition is saved.  Saved definitions are parsed
+ * at the end of the translation unit, if they are non-static
+ * or if their name was referenced by code that was parsed.
+ * Their barewords are classified as they were when the definition
+ * was saved, not by the namespace at the end of the file.
+ */
+static inline char
+single_char_operator (const CPP_Token *token)
+{
+  return token->type == CPP_TOKEN_OPERATOR && token->length == 1 ? token->str[0] : 0;
+}
+
+static inline bool
+is_attribute_keyword (const CPP_Token *token)
+{
+  return token->type == CPP_TOKEN_BAREWORD
+      && ((token->length == 13 && memcmp (token->str, "__attribute__", 13) == 0)
+       || (token->length == 11 && memcmp (token->str, "__attribute", 11) == 0));
+}
+
+/* If 'decl' is "... NAME ( ... )", return NAME.
+ * GNU attribute lists are skipped.  If 'is_static_out' is non-NULL,
+ * it is set if "static" is among the declaration-specifiers
+ * (before NAME, and not inside parentheses).
+ */
+static DBCC_Symbol *
+lazy_function_definition_name (DBCC_Parser    *parser,
+                               CPP_TokenArray *decl,
+                               bool           *is_static_out)
+{
+  unsigned depth = 0;
+  unsigned lparen = 0;
+  for (unsigned i = 0; i < decl->n; i++)
+    {
+      if (is_attribute_keyword (&decl->tokens[i])
+       && i + 1 < decl->n
+       && single_char_operator (&decl->tokens[i+1]) == '(')
+        {
+          /* skip to the matching ')' */
+          unsigned attr_depth = 0;
+          for (i++; i < decl->n; i++)
+            {
+              char op = single_char_operator (&decl->tokens[i]);
+              if (op == '(')
+                attr_depth++;
+              else if (op == ')' && --attr_depth == 0)
+                break;
+            }
+          if (depth == 0 && i + 1 >= decl->n)
+            return NULL;                /* declarator doesn't end with ')' */
+          continue;
+        }
+
+      char op = single_char_operator (&decl->tokens[i]);
+      if (op == '(')
+        {
+          if (depth++ == 0 && lparen == 0)
+            lparen = i;
+        }
+      else if (op == ')')
+        {
+          if (depth > 0 && --depth == 0 && lparen > 0 && i + 1 != decl->n)
+            return NULL;                /* eg function returning function-pointer */
+        }
+    }
+  if (lparen == 0 || decl->tokens[lparen-1].type != CPP_TOKEN_BAREWORD)
+    return NULL;
+
+  CPP_Token *name = decl->tokens + lparen - 1;
+  DBCC_Symbol *symbol = dbcc_symbol_space_force_len (parser->symbol_space,
+                                                     name->length, name->str);
+  int token_type;
+  if (is_reserved_word (symbol, &token_type))
+    return NULL;
+
+  if (is_static_out != NULL)
+    {
+      *is_static_out = false;
+      depth = 0;
+      for (unsigned i = 0; i + 1 < lparen; i++)
+        {
+          CPP_Token *t = decl->tokens + i;
+          char op = single_char_operator (t);
+          if (is_attribute_keyword (t))
+            continue;
+          if (op == '(')
+            depth++;
+          else if (op == ')' && depth > 0)
+            depth--;
+          else if (depth == 0
+                && t->type == CPP_TOKEN_BAREWORD
+                && t->length == 6
+                && memcmp (t->str, "static", 6) == 0)
+            *is_static_out = true;
+        }
+    }
+  return symbol;
+}
+
+static bool
+lazy_flush_pending (DBCC_Parser *parser,
+                    DBCC_Error **error)
+{
+  LazyState *lazy = &parser->lazy;
+
+  /* In a prototype, "... NAME ( ... ) ;", NAME is not a use. */
+  if (!lazy->saw_equals
+   && lazy->pending.n > 0
+   && single_char_operator (&lazy->pending.tokens[lazy->pending.n - 1]) == ';')
+    {
+      lazy->pending.n--;
+      lazy->declaring_name = lazy_function_definition_name (parser, &lazy->pending, NULL);
+      lazy->pending.n++;
+    }
+  bool rv = true;
+  for (unsigned i = 0; rv && i < lazy->pending.n; i++)
+    rv = emit_cpp_token (parser, lazy->pending.tokens + i, error);
+  lazy->declaring_name = NULL;
+  cpp_token_array_reset (&lazy->pending);
+  lazy->saw_equals = false;
+  return rv;
+}
+
+/* Take over the captured definition in lazy->pending. */
+static void
+lazy_save_function_body (DBCC_Parser *parser)
+{
+  LazyState *lazy = &parser->lazy;
+  size_t string_space = 0;
+  for (unsigned i = 0; i < lazy->pending.n; i++)
+    string_space += lazy->pending.tokens[i].length;
+  LazyFunctionBody *body = malloc (sizeof (LazyFunctionBody)
+                                   + sizeof (CPP_Token) * lazy->pending.n
+                                   + sizeof (LazyBareword) * lazy->pending.n
+                                   + string_space);
+  body->name = lazy->capturing_name;
+  body->is_static = lazy->capturing_is_static;
+  body->needed = dbcc_ptr_table_lookup_value (&lazy->referenced, body->name) != NULL;
+  body->emitted = false;
+  body->n_tokens = lazy->pending.n;
+  body->tokens = (CPP_Token *) (body + 1);
+  body->barewords = (LazyBareword *) (body->tokens + body->n_tokens);
+  char *str_at = (char *) (body->barewords + body->n_tokens);
+  for (unsigned i = 0; i < body->n_tokens; i++)
+    {
+      /* code-position references are transferred */
+      CPP_Token *token = lazy->pending.tokens + i;
+      body->tokens[i] = *token;
+      memcpy (str_at, token->str, token->length);
+      body->tokens[i].str = str_at;
+      str_at += token->length;
+
+      body->barewords[i].is_bound = false;
+      if (token->type == CPP_TOKEN_BAREWORD)
+        {
+          DBCC_Symbol *symbol = dbcc_symbol_space_force_len (parser->symbol_space,
+                                                             token->length, token->str);
+          body->barewords[i].is_bound = dbcc_namespace_lookup (parser_get_ns (parser),
+                                                               symbol,
+                                                               &body->barewords[i].ns_entry);
+        }
+    }
+  lazy->pending.n = 0;
+
+  dbcc_ptr_table_set (&lazy->bodies_by_name, body->name, body);
+  if (lazy->n_bodies == lazy->bodies_alloced)
+    {
+      lazy->bodies_alloced = lazy->bodies_alloced ? lazy->bodies_alloced * 2 : 64;
+      lazy->bodies = realloc (lazy->bodies, sizeof (LazyFunctionBody *) * lazy->bodies_alloced);
+    }
+  lazy->bodies[lazy->n_bodies++] = body;
+  lazy->n_deferred++;
+}
+
+static bool
+lazy_filter_token (DBCC_Parser *parser,
+                   CPP_Token   *token,
+                   DBCC_Error **error)
+{
+  LazyState *lazy = &parser->lazy;
+  char op = single_char_operator (token);
+  switch (lazy->mode)
+    {
+    case LAZY_MODE_PASS_BODY:
+      if (op == '{')
+        lazy->brace_depth++;
+      else if (op == '}' && --lazy->brace_depth == 0)
+        lazy->mode = LAZY_MODE_PENDING;
+      return emit_cpp_token (parser, token, error);
+
+    case LAZY_MODE_CAPTURE_BODY:
+      dbcc_code_position_ref (token->code_position);
+      cpp_token_array_append (&lazy->pending, token);
+      if (op == '{')
+        lazy->brace_depth++;
+      else if (op == '}' && --lazy->brace_depth == 0)
+        {
+          lazy_save_function_body (parser);
+          lazy->mode = LAZY_MODE_PENDING;
+        }
+      return true;
+
+    case LAZY_MODE_PENDING:
+      break;
+    }
+
+  if (op == '{'
+   && lazy->brace_depth == 0
+   && lazy->paren_depth == 0
+   && !lazy->saw_equals
+   && lazy->pending.n > 0
+   && single_char_operator (&lazy->pending.tokens[lazy->pending.n - 1]) == ')')
+    {
+      /* function definition */
+      bool is_static;
+      DBCC_Symbol *name = lazy_function_definition_name (parser, &lazy->pending,
+                                                         &is_static);
+      if (name == NULL)
+        {
+          if (!lazy_flush_pending (parser, error))
+            return false;
+          lazy->mode = LAZY_MODE_PASS_BODY;
+          lazy->brace_depth = 1;
+          return emit_cpp_token (parser, token, error);
+        }
+
+      /* Emit the prototype, but keep the declarator tokens
+       * as the start of the saved definition. */
+      lazy->capturing_name = name;
+      lazy->capturing_is_static = is_static;
+      lazy->declaring_name = name;
+      for (unsigned i = 0; i < lazy->pending.n; i++)
+        if (!emit_cpp_token (parser, lazy->pending.tokens + i, error))
+          {
+            lazy->declaring_name = NULL;
+            return false;
+          }
+      lazy->declaring_name = NULL;
+      CPP_Token semicolon = CPP_TOKEN (OPERATOR, token->code_position, ";", 1);
+      if (!emit_cpp_token (parser, &semicolon, error))
+        return false;
+      lazy->saw_equals = false;
+      dbcc_code_position_ref (token->code_position);
+      cpp_token_array_append (&lazy->pending, token);
+      lazy->mode = LAZY_MODE_CAPTURE_BODY;
+      lazy->brace_depth = 1;
+      return true;
+    }
+
+  dbcc_code_position_ref (token->code_position);
+  cpp_token_array_append (&lazy->pending, token);
+  switch (op)
+    {
+    case '(': lazy->paren_depth++; break;
+    case ')': if (lazy->paren_depth > 0) lazy->paren_depth--; break;
+    case '{': lazy->brace_depth++; break;
+    case '}': if (lazy->brace_depth > 0) lazy->brace_depth--; break;
+    case '=':
+      if (lazy->brace_depth == 0 && lazy->paren_depth == 0)
+        lazy->saw_equals = true;
+      break;
+    case ';':
+      if (lazy->brace_depth == 0 && lazy->paren_depth == 0)
+        return lazy_flush_pending (parser, error);
+      break;
+    }
+  return true;
+}
+
+static bool
+emit_saved_token (DBCC_Parser      *parser,
+                  LazyFunctionBody *body,
+                  unsigned          index,
+                  DBCC_Error      **error)
+{
+  CPP_Token *token = body->tokens + index;
+  if (token->type == CPP_TOKEN_BAREWORD)
+    {
+      int token_type;
+      DBCC_Symbol *symbol = dbcc_symbol_space_force_len (parser->symbol_space,
+                                                         token->length, token->str);
+      if (!is_reserved_word (symbol, &token_type))
+        {
+          LazyBareword *bw = body->barewords + index;
+          return emit_ptoken (parser,
+                              bareword_to_ptoken (token->code_position, symbol,
+                                                  bw->is_bound ? &bw->ns_entry : NULL),
+                              error);
+        }
+    }
+  return emit_cpp_token (parser, token, error);
+}
+
+/* Free the saved definitions and forget the names seen,
+ * at the end of a translation unit (or after an error).
+ */
+static void
+lazy_discard (DBCC_Parser *parser)
+{
+  LazyState *lazy = &parser->lazy;
+  for (size_t i = 0; i < lazy->n_bodies; i++)
+    {
+      LazyFunctionBody *body = lazy->bodies[i];
+      for (unsigned t = 0; t < body->n_tokens; t++)
+        dbcc_code_position_unref (body->tokens[t].code_position);
+      free (body);
+    }
+  lazy->n_bodies = 0;
+  dbcc_ptr_table_clear (&lazy->bodies_by_name);
+  dbcc_ptr_table_clear (&lazy->referenced);
+  cpp_token_array_reset (&lazy->pending);
+  lazy->mode = LAZY_MODE_PENDING;
+  lazy->brace_depth = lazy->paren_depth = 0;
+  lazy->saw_equals = false;
+}
+
+/* Parse every saved definition that is non-static or was referenced;
+ * parsing one definition may make others needed.
+ */
+static bool
+lazy_finish_translation_unit (DBCC_Parser *parser,
+                              DBCC_Error **error)
+{
+  LazyState *lazy = &parser->lazy;
+  bool rv = lazy_flush_pending (parser, error);
+  bool progress = rv;
+  while (progress)
+    {
+      progress = false;
+      for (size_t i = 0; rv && i < lazy->n_bodies; i++)
+        {
+          LazyFunctionBody *body = lazy->bodies[i];
+          if (body->emitted || (body->is_static && !body->needed))
+            continue;
+          body->emitted = true;
+          lazy->n_materialized++;
+          progress = true;
+          for (unsigned t = 0; rv && t < body->n_tokens; t++)
+            rv = emit_saved_token (parser, body, t, error);
+        }
+    }
+  lazy_discard (parser);
+  return rv;
+}
+
+/* --- Incremental reparsing support ---
+ *
+ * An open document keeps its text and its division into toplevel
+ * declarations (and directive lines).  After an edit, only the text
+ * from the first damaged declaration is rescanned, and only until the
+ * declaration boundaries line up with the old ones again.
+ * The rescanned declarations are lexed again, and a declaration is
+ * unchanged only if its tokens are byte-for-byte the same.
+ */
+
+/* The tokens of a span, each followed by '\n', and the
+ * identifiers among them (not reserved words), sorted by
+ * address and without duplicates. */
+typedef struct DocumentSpanTokens DocumentSpanTokens;
+struct DocumentSpanTokens
+{
+  unsigned line_no;
+  size_t text_length;
+  char *text;
+  size_t n_names;
+  DBCC_Symbol **names;
+};
+
+struct DBCC_ParserDocument
+{
+  DBCC_Symbol *filename;
+  char *contents;
+  size_t size;
+  size_t contents_alloced;
+  size_t n_spans;
+  DBCC_ParserDeclSpan *spans;
+  DocumentSpanTokens *span_tokens;      /* parallel to spans */
+  size_t spans_alloced;
+};
+
+static inline bool
+is_identifier_char (char c)
+{
+  return is_initial_identifer_char (c) || ('0' <= c && c <= '9');
+}
+
+#define FNV_32_PRIME    16777619u
+#define FNV_32_INIT     2166136261u
+#define FNV_32_STEP(h, c) (((h) ^ (uint8_t)(c)) * FNV_32_PRIME)
+
+/* Skip whitespace, comments and backslash-newlines. */
+static size_t
+skip_span_whitespace (const char *base,
+                      size_t      pos,
+                      size_t      size)
+{
+  while (pos < size)
+    {
+      char c = base[pos];
+      if (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v')
+        pos++;
+      else if (c == '\\' && pos + 1 < size && base[pos+1] == '\n')
+        pos += 2;
+      else if (c == '/' && pos + 1 < size && base[pos+1] == '*')
+        {
+          pos += 2;
+          while (pos + 1 < size && !(base[pos] == '*' && base[pos+1] == '/'))
+            pos++;
+          pos = pos + 1 < size ? pos + 2 : size;
+        }
+      else if (c == '/' && pos + 1 < size && base[pos+1] == '/')
+        {
+          const char *nl = memchr (base + pos, '\n', size - pos);
+          pos = nl ? (size_t)(nl - base) : size;
+        }
+      else
+        break;
+    }
+  return pos;
+}
+
+/* Find the toplevel declaration or directive line starting
+ * at or after 'pos'.  Returns the position after it;
+ * out->length==0 means the end of the document was reached.
+ * Its hash is set by lex_decl_span().
+ */
+static size_t
+scan_decl_span (DBCC_Parser         *parser,
+                const char          *base,
+                size_t               pos,
+                size_t               size,
+                DBCC_ParserDeclSpan *out)
+{
+  pos = skip_span_whitespace (base, pos, size);
+  out->start = pos;
+  out->length = 0;
+  out->hash = 0;
+  out->declared_name = NULL;
+  out->is_directive = false;
+  out->dirty = true;
+  if (pos == size)
+    return pos;
+
+  if (base[pos] == '#')
+    {
+      unsigned line_no = 0;
+      bool has_content;
+      const char *line_end = scan_logical_line (base + pos, base + size,
+                                                &line_no, &has_content);
+      out->is_directive = true;
+      out->length = line_end - (base + pos);
+      return line_end - base;
+    }
+
+  unsigned paren_depth = 0, brace_depth = 0;
+  bool function_body = false;
+  bool name_final = false;
+  const char *name = NULL;
+  size_t name_len = 0;
+  char last = 0;
+  while (pos < size)
+    {
+      pos = skip_span_whitespace (base, pos, size);
+      if (pos == size)
+        break;
+
+      char c = base[pos];
+      if (c == '#' && (pos == 0 || base[pos-1] == '\n'))
+        {
+          /* directive nested in a declaration */
+          unsigned line_no = 0;
+          bool has_content;
+          const char *line_end = scan_logical_line (base + pos, base + size,
+                                                    &line_no, &has_content);
+          pos = line_end - base;
+          continue;
+        }
+      if (c == '"' || c == '\'')
+        {
+          pos++;
+          while (pos < size && base[pos] != c && base[pos] != '\n')
+            pos += (base[pos] == '\\' && pos + 1 < size) ? 2 : 1;
+          if (pos < size && base[pos] == c)
+            pos++;
+          last = c;
+          continue;
+        }
+      if (is_identifier_char (c))
+        {
+          size_t word_start = pos;
+          while (pos < size && is_identifier_char (base[pos]))
+            pos++;
+          if (!name_final
+           && paren_depth == 0 && brace_depth == 0
+           && is_initial_identifer_char (c))
+            {
+              name = base + word_start;
+              name_len = pos - word_start;
+            }
+          last = 'a';
+          continue;
+        }
+
+      pos++;
+      switch (c)
+        {
+        case '(':
+        case '[':
+        case '=':
+          if (paren_depth == 0 && brace_depth == 0)
+            name_final = true;
+          if (c != '=')
+            paren_depth++;
+          break;
+        case ')':
+        case ']':
+          if (paren_depth > 0)
+            paren_depth--;
+          break;
+        case '{':
+          if (paren_depth == 0 && brace_depth == 0 && last == ')')
+            function_body = true;
+          if (paren_depth == 0 && brace_depth == 0)
+            name_final = true;
+          brace_depth++;
+          break;
+        case '}':
+          if (brace_depth > 0 && --brace_depth == 0 && function_body)
+            goto done;
+          break;
+        case ';':
+          if (paren_depth == 0 && brace_depth == 0)
+            goto done;
+          break;
+        }
+      last = c;
+    }
+
+done:
+  out->length = pos - out->start;
+  if (name != NULL)
+    out->declared_name = dbcc_symbol_space_force_len (parser->symbol_space,
+                                                      name_len, name);
+  return pos;
+}
+
+static void
+span_tokens_append (DocumentSpanTokens *out,
+                    size_t             *alloced_inout,
+                    size_t              length,
+                    const char         *str)
+{
+  if (out->text_length + length + 1 > *alloced_inout)
+    {
+      *alloced_inout = (out->text_length + length + 1) * 2;
+      out->text = realloc (out->text, *alloced_inout);
+    }
+  memcpy (out->text + out->text_length, str, length);
+  out->text_length += length;
+  out->text[out->text_length++] = '\n';
+}
+
+/* Count the newlines in [str, end). */
+static unsigned
+count_newlines (const char *str,
+                const char *end)
+{
+  unsigned n = 0;
+  while ((str = memchr (str, '\n', end - str)) != NULL)
+    {
+      n++;
+      str++;
+    }
+  return n;
+}
+
+static int
+compare_symbol_ptrs (const void *a, const void *b)
+{
+  DBCC_Symbol *sa = * (DBCC_Symbol * const *) a;
+  DBCC_Symbol *sb = * (DBCC_Symbol * const *) b;
+  return sa < sb ? -1 : sa > sb ? 1 : 0;
+}
+
+/* Lex 'span', which starts on line 'line_no', one logical line
+ * at a time, and set its hash.  A lexing error is passed
+ * to the error handler, and the line is kept as raw text.
+ * Directive lines get an empty token after them,
+ * so that a line break after a directive is a change.
+ */
+static void
+lex_decl_span (DBCC_Parser         *parser,
+               DBCC_ParserDocument *doc,
+               DBCC_ParserDeclSpan *span,
+               unsigned             line_no,
+               DocumentSpanTokens  *out)
+{
+  const char *at = doc->contents + span->start;
+  const char *end = at + span->length;
+  size_t text_alloced = 0, names_alloced = 0;
+  CPP_TokenArray tokens = CPP_TOKEN_ARRAY_INIT;
+  out->text_length = 0;
+  out->text = NULL;
+  out->n_names = 0;
+  out->names = NULL;
+  out->line_no = line_no;
+  while (at < end)
+    {
+      unsigned next_line_no = line_no;
+      bool has_content;
+      const char *line_end = scan_logical_line (at, end, &next_line_no, &has_content);
+      if (has_content)
+        {
+          DBCC_CodePosition *cp = dbcc_code_position_new (NULL, NULL, doc->filename,
+                                                          line_no, 1,
+                                                          at - doc->contents + 1);
+          DBCC_Error *error = NULL;
+          if (!tokenize_directive_line (at, line_end, cp, &tokens, &error))
+            {
+              parser->handlers.handle_error (error, parser->handler_data);
+              span_tokens_append (out, &text_alloced, line_end - at, at);
+            }
+          else
+            {
+              for (unsigned i = 0; i < tokens.n; i++)
+                {
+                  CPP_Token *token = tokens.tokens + i;
+                  span_tokens_append (out, &text_alloced, token->length, token->str);
+                  if (token->type != CPP_TOKEN_BAREWORD)
+                    continue;
+                  int token_type;
+                  DBCC_Symbol *symbol = dbcc_symbol_space_force_len (parser->symbol_space,
+                                                                     token->length,
+                                                                     token->str);
+                  if (is_reserved_word (symbol, &token_type))
+                    continue;
+                  if (out->n_names == names_alloced)
+                    {
+                      names_alloced = names_alloced ? names_alloced * 2 : 16;
+                      out->names = realloc (out->names, sizeof (DBCC_Symbol *) * names_alloced);
+                    }
+                  out->names[out->n_names++] = symbol;
                 }
+              if (tokens.n > 0 && single_char_operator (&tokens.tokens[0]) == '#')
+                span_tokens_append (out, &text_alloced, 0, "");
+            }
+          cpp_token_array_reset (&tokens);
+          dbcc_code_position_unref (cp);
+        }
+      line_no = next_line_no + 1;
+      at = line_end < end ? line_end + 1 : end;
+    }
+  free (tokens.tokens);
+
+  if (out->n_names > 1)
+    {
+      qsort (out->names, out->n_names, sizeof (DBCC_Symbol *), compare_symbol_ptrs);
+      size_t n_unique = 1;
+      for (size_t i = 1; i < out->n_names; i++)
+        if (out->names[i] != out->names[n_unique - 1])
+          out->names[n_unique++] = out->names[i];
+      out->n_names = n_unique;
+    }
+
+  span->hash = FNV_32_INIT;
+  for (size_t i = 0; i < out->text_length; i++)
+    span->hash = FNV_32_STEP (span->hash, out->text[i]);
+}
+
+static bool
+span_tokens_equal (const DocumentSpanTokens *a,
+                   const DocumentSpanTokens *b)
+{
+  return a->text_length == b->text_length
+      && memcmp (a->text, b->text, a->text_length) == 0;
+}
+
+static void
+span_tokens_clear (DocumentSpanTokens *tokens)
+{
+  free (tokens->text);
+  free (tokens->names);
+}
+
+static void
+document_reserve_spans (DBCC_ParserDocument *doc,
+                        size_t               n_spans)
+{
+  if (n_spans > doc->spans_alloced)
+    {
+      doc->spans_alloced = doc->spans_alloced ? doc->spans_alloced * 2 : 64;
+      if (doc->spans_alloced < n_spans)
+        doc->spans_alloced = n_spans;
+      doc->spans = realloc (doc->spans, sizeof (DBCC_ParserDeclSpan) * doc->spans_alloced);
+      doc->span_tokens = realloc (doc->span_tokens,
+                                  sizeof (DocumentSpanTokens) * doc->spans_alloced);
+    }
+}
+
+static DBCC_ParserDocument *
+lookup_document (DBCC_Parser *parser,
+                 const char  *filename)
+{
+  DBCC_Symbol *symbol = dbcc_symbol_space_try (parser->symbol_space, filename);
+  if (symbol == NULL)
+    return NULL;
+  return dbcc_ptr_table_lookup_value (&parser->documents, symbol);
+}
+
+bool
+dbcc_parser_open_document   (DBCC_Parser   *parser,
+                             const char    *filename,
+                             size_t         size,
+                             const uint8_t *data)
+{
+  DBCC_Symbol *symbol = dbcc_symbol_space_force (parser->symbol_space, filename);
+  dbcc_parser_close_document (parser, filename);
+
+  DBCC_ParserDocument *doc = malloc (sizeof (DBCC_ParserDocument));
+  doc->filename = symbol;
+  doc->contents_alloced = size + 1;
+  doc->contents = malloc (doc->contents_alloced);
+  memcpy (doc->contents, data, size);
+  doc->contents[size] = 0;
+  doc->size = size;
+  doc->n_spans = 0;
+  doc->spans = NULL;
+  doc->span_tokens = NULL;
+  doc->spans_alloced = 0;
+
+  size_t pos = 0;
+  size_t line_pos = 0;
+  unsigned line_no = 1;
+  for (;;)
+    {
+      DBCC_ParserDeclSpan span;
+      pos = scan_decl_span (parser, doc->contents, pos, size, &span);
+      if (span.length == 0)
+        break;
+      line_no += count_newlines (doc->contents + line_pos, doc->contents + span.start);
+      line_pos = span.start;
+      document_reserve_spans (doc, doc->n_spans + 1);
+      lex_decl_span (parser, doc, &span, line_no, doc->span_tokens + doc->n_spans);
+      doc->spans[doc->n_spans++] = span;
+    }
+  dbcc_ptr_table_set (&parser->documents, symbol, doc);
+  return true;
+}
 
-#if SUPPORT_TRIGRAPHS
-              if (str[0] == '?' && str + 2 < end && str[1] == '?')
-                {
-                  /*
-                    ??=      #           
-                    ??(      [           
-                    ??<      { 
-                    ??/      \
-                    ??)      ]           
-                    ??>      }
-                    ??’      ˆ           
-                    ??!      |           
-                    ??-      ˜
-                   */
-                  trigraph characters
-                }
-#endif
+/* Does the span mention any of 'names'? */
+static bool
+span_references_names (const DocumentSpanTokens *tokens,
+                       size_t                    n_names,
+                       DBCC_Symbol             **names)
+{
+  for (size_t i = 0; i < n_names; i++)
+    if (bsearch (names + i, tokens->names, tokens->n_names,
+                 sizeof (DBCC_Symbol *), compare_symbol_ptrs) != NULL)
+      return true;
+  return false;
+}
 
-              ScanPunctuatorResult punc_res = scan_punctuator (str, end);
-              switch (punc_res.type)
-                {
-                case SCAN_PUNCTUATOR_RESULT_NO:
-                  break;
-                case SCAN_PUNCTUATOR_RESULT_SUCCESS:
-                  {
-                    unsigned len = punc_res.v_success.length;
-                    CPP_Token token = CPP_TOKEN(
-                      OPERATOR,
-                      CREATE_CP(),
-                      str,
-                      len
-                    );
-                    if (len == 1 && str[0] == '#')
-                      token.type = CPP_TOKEN_HASH;
-                    else if (len == 2 && str[0] == '#' && str[1] == '#')
-                      token.type = CPP_TOKEN_CONCATENATE;
-                    APPEND_TOKEN(token);
-                    str += punc_res.v_success.length;
-                    column += punc_res.v_success.length;
-                    break;
-                  }
-                case SCAN_PUNCTUATOR_RESULT_SUCCESS_DIGRAPH:
-                  {
-                    unsigned len = punc_res.v_success_digraph.length;
-                    CPP_Token token = CPP_TOKEN(
-                      OPERATOR_DIGRAPH,
-                      CREATE_CP(),
-                      str,
-                      len
-                    );
-                    if (len == 2 && str[0] == '%' && str[1] == ':')
-                      token.type = CPP_TOKEN_HASH;
-                    if (len == 4 && str[0] == '%' && str[1] == ':' 
-                                 && str[2] == '%' && str[3] == ':')
-                      token.type = CPP_TOKEN_CONCATENATE;
-                    APPEND_TOKEN(token);
-                    str += len;
-                    column += len;
-                    continue;             // TODO: replace with goto
-                  }
-                }
-              DBCC_Error *e = dbcc_error_new (DBCC_ERROR_UNEXPECTED_CHARACTER,
-                                              "unexpected character/byte 0x%02x (%s)",
-                                              *str, dsk_ascii_byte_name (*str));
-              dbcc_error_add_code_position (e, CREATE_CP());
-              parser->handlers.handle_error(e, parser->handler_data);
-              return false;
+bool
+dbcc_parser_apply_edit      (DBCC_Parser           *parser,
+                             const char            *filename,
+                             const DBCC_ParserEdit *edit)
+{
+  DBCC_ParserDocument *doc = lookup_document (parser, filename);
+  if (doc == NULL || edit->offset > doc->size || edit->old_length > doc->size - edit->offset)
+    {
+      DBCC_Error *error = dbcc_error_new (DBCC_ERROR_BAD_EDIT,
+                                          doc == NULL ? "no open document named %s"
+                                                      : "edit out of range for %s",
+                                          filename);
+      parser->handlers.handle_error (error, parser->handler_data);
+      return false;
+    }
+
+  /* Splice the text. */
+  int line_delta = (int) count_newlines (edit->new_text, edit->new_text + edit->new_length)
+                 - (int) count_newlines (doc->contents + edit->offset,
+                                         doc->contents + edit->offset + edit->old_length);
+  size_t new_size = doc->size - edit->old_length + edit->new_length;
+  if (new_size + 1 > doc->contents_alloced)
+    {
+      doc->contents_alloced = (new_size + 1) * 2;
+      doc->contents = realloc (doc->contents, doc->contents_alloced);
+    }
+  memmove (doc->contents + edit->offset + edit->new_length,
+           doc->contents + edit->offset + edit->old_length,
+           doc->size - edit->offset - edit->old_length + 1);
+  memcpy (doc->contents + edit->offset, edit->new_text, edit->new_length);
+  doc->size = new_size;
+  int64_t delta = (int64_t) edit->new_length - (int64_t) edit->old_length;
+  size_t old_edit_end = edit->offset + edit->old_length;
+  size_t new_edit_end = edit->offset + edit->new_length;
+
+  for (size_t i = 0; i < doc->n_spans; i++)
+    doc->spans[i].dirty = false;
+
+  /* First damaged span: the last one starting at or before the edit,
+   * since an edit just after a span might join onto it. */
+  size_t first = 0;
+  while (first + 1 < doc->n_spans && doc->spans[first + 1].start <= edit->offset)
+    first++;
+  size_t rescan_from = doc->n_spans > 0 && doc->spans[first].start <= edit->offset
+                     ? doc->spans[first].start
+                     : 0;
+
+  /* Rescan until a new span ends exactly where an undamaged old span
+   * ended, after the edit.  Old spans [first, resync) get replaced. */
+  DBCC_ParserDeclSpan *new_spans = NULL;
+  DocumentSpanTokens *new_tokens = NULL;
+  size_t n_new = 0, new_alloced = 0;
+  size_t resync = first;
+  size_t pos = rescan_from;
+  size_t line_pos = 0;
+  unsigned line_no = 1;
+  if (rescan_from > 0)
+    {
+      line_pos = rescan_from;
+      line_no = doc->span_tokens[first].line_no;
+    }
+  for (;;)
+    {
+      DBCC_ParserDeclSpan span;
+      pos = scan_decl_span (parser, doc->contents, pos, doc->size, &span);
+      if (span.length == 0)
+        {
+          resync = doc->n_spans;
+          break;
+        }
+      if (n_new == new_alloced)
+        {
+          new_alloced = new_alloced ? new_alloced * 2 : 16;
+          new_spans = realloc (new_spans, sizeof (DBCC_ParserDeclSpan) * new_alloced);
+          new_tokens = realloc (new_tokens, sizeof (DocumentSpanTokens) * new_alloced);
+        }
+      line_no += count_newlines (doc->contents + line_pos, doc->contents + span.start);
+      line_pos = span.start;
+      lex_decl_span (parser, doc, &span, line_no, new_tokens + n_new);
+      new_spans[n_new++] = span;
+      if (pos < new_edit_end)
+        continue;
+
+      size_t old_pos = pos - delta;
+      while (resync < doc->n_spans
+          && doc->spans[resync].start + doc->spans[resync].length < old_pos)
+        resync++;
+      if (resync < doc->n_spans
+       && doc->spans[resync].start >= old_edit_end
+       && doc->spans[resync].start + doc->spans[resync].length == old_pos)
+        {
+          /* The remaining spans are unaffected, except that they moved. */
+          resync++;
+          break;
+        }
+      if (resync < doc->n_spans
+       && doc->spans[resync].start >= old_edit_end
+       && doc->spans[resync].start == old_pos)
+        break;
+    }
+
+  /* A new span is unchanged if one of the replaced old spans
+   * had the same tokens.  Unmatched old spans were deleted. */
+  DBCC_Symbol **changed_names = NULL;
+  size_t n_changed_names = 0, changed_names_alloced = 0;
+#define ADD_CHANGED_NAME(symbol)                                        \
+  do{                                                                   \
+    if (n_changed_names == changed_names_alloced)                       \
+      {                                                                 \
+        changed_names_alloced = changed_names_alloced ? changed_names_alloced * 2 : 8; \
+        changed_names = realloc (changed_names,                         \
+                                 sizeof (DBCC_Symbol *) * changed_names_alloced); \
+      }                                                                 \
+    changed_names[n_changed_names++] = (symbol);                        \
+  } while(0)
+  bool directive_changed = false;
+  size_t n_old = resync - first;
+  bool *old_matched = calloc (n_old + 1, sizeof (bool));
+  for (size_t i = 0; i < n_new; i++)
+    {
+      new_spans[i].dirty = true;
+      for (size_t o = 0; o < n_old; o++)
+        {
+          DBCC_ParserDeclSpan *old = doc->spans + first + o;
+          if (!old_matched[o]
+           && old->hash == new_spans[i].hash
+           && old->declared_name == new_spans[i].declared_name
+           && span_tokens_equal (doc->span_tokens + first + o, new_tokens + i))
+            {
+              old_matched[o] = true;
+              new_spans[i].dirty = false;
+              break;
             }
         }
+      if (new_spans[i].dirty)
+        {
+          if (new_spans[i].is_directive)
+            directive_changed = true;
+          if (new_spans[i].declared_name != NULL)
+            ADD_CHANGED_NAME (new_spans[i].declared_name);
+        }
+    }
+  for (size_t o = 0; o < n_old; o++)
+    if (!old_matched[o])
+      {
+        DBCC_ParserDeclSpan *old = doc->spans + first + o;
+        if (old->is_directive)
+          directive_changed = true;
+        if (old->declared_name != NULL)
+          ADD_CHANGED_NAME (old->declared_name);
+      }
+  free (old_matched);
+
+  /* Replace spans [first, resync) with the new spans,
+   * and shift the ones after. */
+  for (size_t o = first; o < resync; o++)
+    span_tokens_clear (doc->span_tokens + o);
+  size_t n_after = doc->n_spans - resync;
+  size_t n_total = first + n_new + n_after;
+  document_reserve_spans (doc, n_total);
+  memmove (doc->spans + first + n_new, doc->spans + resync,
+           sizeof (DBCC_ParserDeclSpan) * n_after);
+  memmove (doc->span_tokens + first + n_new, doc->span_tokens + resync,
+           sizeof (DocumentSpanTokens) * n_after);
+  memcpy (doc->spans + first, new_spans, sizeof (DBCC_ParserDeclSpan) * n_new);
+  memcpy (doc->span_tokens + first, new_tokens, sizeof (DocumentSpanTokens) * n_new);
+  doc->n_spans = n_total;
+  for (size_t i = first + n_new; i < n_total; i++)
+    {
+      doc->spans[i].start += delta;
+      doc->span_tokens[i].line_no += line_delta;
+    }
+  free (new_spans);
+  free (new_tokens);
+
+  /* Declarations that use a changed name, or that follow a
+   * changed directive (which may be a #define), depend on the edit. */
+  bool after_directive = false;
+  for (size_t i = 0; i < n_total; i++)
+    {
+      DBCC_ParserDeclSpan *span = doc->spans + i;
+      if (span->dirty)
+        {
+          after_directive |= span->is_directive;
+          continue;
+        }
+      if ((directive_changed && after_directive)
+       || (n_changed_names > 0
+           && span_references_names (doc->span_tokens + i, n_changed_names, changed_names)))
+        span->dirty = true;
+    }
+  free (changed_names);
+#undef ADD_CHANGED_NAME
+  return true;
+}
+
+const DBCC_ParserDeclSpan *
+dbcc_parser_peek_decl_spans (DBCC_Parser   *parser,
+                             const char    *filename,
+                             size_t        *n_spans_out)
+{
+  DBCC_ParserDocument *doc = lookup_document (parser, filename);
+  if (doc == NULL)
+    {
+      *n_spans_out = 0;
+      return NULL;
+    }
+  *n_spans_out = doc->n_spans;
+  return doc->spans;
+}
+
+const char *
+dbcc_parser_peek_document_text (DBCC_Parser   *parser,
+                                const char    *filename,
+                                size_t        *size_out)
+{
+  DBCC_ParserDocument *doc = lookup_document (parser, filename);
+  if (doc == NULL)
+    {
+      *size_out = 0;
+      return NULL;
+    }
+  *size_out = doc->size;
+  return doc->contents;
+}
+
+static void
+document_free (DBCC_ParserDocument *doc)
+{
+  for (size_t i = 0; i < doc->n_spans; i++)
+    span_tokens_clear (doc->span_tokens + i);
+  free (doc->contents);
+  free (doc->spans);
+  free (doc->span_tokens);
+  free (doc);
+}
+
+static void
+document_free_entry (DBCC_PtrTable_Entry *entry, void *visit_data)
+{
+  (void) visit_data;
+  if (entry->value != NULL)
+    document_free (entry->value);
+}
+
+void
+dbcc_parser_close_document  (DBCC_Parser   *parser,
+                             const char    *filename)
+{
+  DBCC_ParserDocument *doc = lookup_document (parser, filename);
+  if (doc == NULL)
+    return;
+  dbcc_ptr_table_set (&parser->documents, doc->filename, NULL);
+  document_free (doc);
+}
+
+static bool
+parse_file_in_region        (DBCC_Parser   *parser,
+                             const char    *filename)
+{
+  DskError *error = NULL;
+  size_t size;
+  DBCC_Symbol *filename_symbol = dbcc_symbol_space_force (parser->symbol_space, filename);
+  uint8_t *contents = dsk_file_get_contents (filename, &size, &error);
+  if (contents == NULL)
+    {
+      DBCC_Error *e = dbcc_error_new (DBCC_ERROR_READING_FILE,
+                                      "%s", error->message);
+      dsk_error_unref (error);
+      parser->handlers.handle_error (e, parser->handler_data);
+      return false;
+    }
+
+  // This will be set non-NULL if there is an #if/#ifdef/#ifndef at start of file,
+  // and there are no #else/#elif's at top-level, and there is nothing
+  // after the final #endif
+  CPP_Expr *guard = NULL;
+  unsigned preproc_conditional_stack_alloced = 32;
+  CPP_StackFrameStatus *preproc_conditional_stack = malloc (sizeof (CPP_StackFrameStatus) * preproc_conditional_stack_alloced);
+  unsigned preproc_conditional_level = 0;
+#define PREPROC_TOP   preproc_conditional_stack[preproc_conditional_level-1]
+#define PREPROC_NEXT_TOP   preproc_conditional_stack[preproc_conditional_level]
+  
+  /* Step 1: convert file into a sequence of "preprocessor tokens".
+   * These tokens "point into" the raw file contents, to minimize extra copies.
+   */
+  const char *str = (const char *) contents;
+  const char *end = str + size;
+  unsigned line_no = 1;
+  unsigned column = 1;
+#define CREATE_CP()                                                     \
+  dbcc_code_position_new(NULL, NULL,                                    \
+                         filename_symbol,                               \
+                         line_no, column, str - (char*)contents + 1)
+  size_t cpp_tokens_alloced = 1024;
+  CPP_Token *cpp_tokens = malloc (sizeof (CPP_Token) * cpp_tokens_alloced);
+  size_t n_cpp_tokens = 0;
+#define APPEND_TOKEN(token)                                             \
+  do{                                                                   \
+    if (n_cpp_tokens == cpp_tokens_alloced)                             \
+      {                                                                 \
+        cpp_tokens_alloced *= 2;                                        \
+        cpp_tokens = realloc (cpp_tokens,                               \
+                              sizeof (CPP_Token) * cpp_tokens_alloced); \
+      }                                                                 \
+    cpp_tokens[n_cpp_tokens++] = (token);                               \
+  } while(0)
+#define APPEND_CPP_TOKEN(typeshort, cp, str, length)                    \
+  APPEND_TOKEN(CPP_TOKEN(typeshort, cp, str, length))
+  if (size > 0 && contents[size - 1] != '\n')
+    {
+      DBCC_Error *error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_INCOMPLETE_LINE,
+                                          "line without terminating newline");
+      parser->handlers.handle_error (error, parser->handler_data);
+      goto failed;
+    }
+  const char *line_start = str;
+  while (str < end)
+    {
       if (*str == '\n')
         {
-          APPEND_CPP_TOKEN(
-            NEWLINE,
-            CREATE_CP(),
-            str,
-            1
-          );
+          APPEND_CPP_TOKEN(NEWLINE, CREATE_CP(), str, 1);
           column = 1;
-          last_newline = str;
           line_no++;
           str++;
+          line_start = str;
+          continue;
+        }
+      if (*str == ' ' || *str == '\t' || *str == '\r' || *str == '\f' || *str == '\v')
+        {
+          str++;
+          column++;
+          continue;
+        }
+      if (is_line_splice (str, end))
+        {
+          str += 2;
+          column = 1;
+          line_no++;
+          continue;
+        }
+      if (str[0] == '/' && str + 1 < end && str[1] == '*')
+        {
+          DBCC_CodePosition *comment_cp = CREATE_CP();
+          if (!scan_multiline_comment_body (&str, end, &line_no, &column))
+            {
+              /* unterminated comment (reported at the start of the comment). */
+              DBCC_Error *error;
+              error = dbcc_error_new (DBCC_ERROR_UNTERMINATED_MULTILINE_COMMENT,
+                                      "multiline-style comment unterminated (missing `*/')");
+              dbcc_error_add_code_position (error, comment_cp);
+              dbcc_code_position_unref (comment_cp);
+              parser->handlers.handle_error (error, parser->handler_data);
+              goto failed;
+            }
+          dbcc_code_position_unref (comment_cp);
+          continue;
+        }
+      if (str[0] == '/' && str + 1 < end && str[1] == '/')
+        {
+          /* the newline ends the comment, and is a token itself */
+          str = memchr (str, '\n', end - str);
+          continue;
+        }
+
+      if (*str == '#' && is_whitespace (line_start, str))
+        scan_maybe_hash_line (parser, str, memchr (str, '\n', end - str),
+                              &filename_symbol,
+                              &line_no, &column);
+
+      CPP_Token token;
+      DBCC_Error *error = NULL;
+      DBCC_CodePosition *cp = CREATE_CP();
+      const char *token_end = lex_directive_token (str, end, cp, &token, &error);
+      if (token_end == NULL)
+        {
+          dbcc_code_position_unref (cp);
+          parser->handlers.handle_error (error, parser->handler_data);
+          goto failed;
         }
+      APPEND_TOKEN(token);
+      column += token_end - str;
+      str = token_end;
     }
 
 #if DUMP_CPP_TOKENS
@@ -2374,26 +5510,28 @@ dbcc_parser_parse_file      (DBCC_Parser   *parser,
    *   (3) #include directives are handled by recursion
    */
   bool at_line_start = true;
-  // This will be set true if there is an #if/#ifdef/#ifndef at start of file,
-  // and there are no #else/#elif's at top-level, and there is nothing
-  // after the final #endif
-  CPP_Expr *guard = NULL;
   bool is_first = true;
   bool past_last_endif = false;
   
   unsigned at = 0;
 
-#define EMIT_PTOKEN_TO_PARSER(token) \
-  do{ \
-    DBCC_Lemon_Parser(parser->lemon_parser, \
-                      (token).token_type, token, \
-                      parser->context); \
-  }while(0)
-
   while (at < n_cpp_tokens)
     {
       if (cpp_tokens[at].type == CPP_TOKEN_NEWLINE)
-        at++;
+        {
+          at_line_start = true;
+          at++;
+          continue;
+        }
+      bool active = preproc_conditional_level == 0
+                 || is_active_cpp_stack_state (PREPROC_TOP);
+      if (at_line_start && cpp_tokens[at].type == CPP_TOKEN_HASH
+       && (at + 1 == n_cpp_tokens || cpp_tokens[at+1].type == CPP_TOKEN_NEWLINE))
+        {
+          /* null directive (6.10.7) */
+          at++;
+          continue;
+        }
       /* Some semantics of if-then-else directives is found in 6.10.1p6 */
       if (at_line_start && cpp_tokens[at].type == CPP_TOKEN_HASH
        && at + 1 < n_cpp_tokens
@@ -2409,7 +5547,7 @@ dbcc_parser_parse_file      (DBCC_Parser   *parser,
               if (n_expr_tokens == 0)
                 {
                   parser->handlers.handle_error (error, parser->handler_data);
-                  return false;
+                  goto failed;
                 }
               at += n_expr_tokens + 2;  /* expression tokens plus '#' and if/ifdef/ifndef */
 
@@ -2424,9 +5562,15 @@ dbcc_parser_parse_file      (DBCC_Parser   *parser,
               if (!eval_cpp_expr_boolean (parser, &cpp_expr, &result, &error))
                 {
                   parser->handlers.handle_error (error, parser->handler_data);
-                  return false;
+                  goto failed;
                 }
 
+              if (preproc_conditional_level == preproc_conditional_stack_alloced)
+                {
+                  preproc_conditional_stack_alloced *= 2;
+                  preproc_conditional_stack = realloc (preproc_conditional_stack,
+                                                       sizeof (CPP_StackFrameStatus) * preproc_conditional_stack_alloced);
+                }
               if (preproc_conditional_level > 0 && !is_active_cpp_stack_state(PREPROC_TOP))
                 PREPROC_NEXT_TOP = CPP_STACK_INACTIVE_PARENT;
               else if (result)
@@ -2444,7 +5588,7 @@ dbcc_parser_parse_file      (DBCC_Parser   *parser,
                                            "incomplete line after #else");
                   dbcc_error_add_code_position (error, cpp_tokens[at+1].code_position);
                   parser->handlers.handle_error (error, parser->handler_data);
-                  return false;
+                  goto failed;
                 }
               if (cpp_tokens[at+2].type != CPP_TOKEN_NEWLINE)
                 {
@@ -2453,7 +5597,7 @@ dbcc_parser_parse_file      (DBCC_Parser   *parser,
                                            cpp_token_type_name (cpp_tokens[at+2].type));
                   dbcc_error_add_code_position (error, cpp_tokens[at+1].code_position);
                   parser->handlers.handle_error (error, parser->handler_data);
-                  return false;
+                  goto failed;
                 }
               if (preproc_conditional_level == 0)
                 {
@@ -2461,7 +5605,7 @@ dbcc_parser_parse_file      (DBCC_Parser   *parser,
                                                       "got #else directive without corresponding #if");
                   dbcc_error_add_code_position (error, cpp_tokens[at].code_position);
                   parser->handlers.handle_error (error, parser->handler_data);
-                  return false;
+                  goto failed;
                 }
               at += 3;
               switch (PREPROC_TOP)
@@ -2486,7 +5630,7 @@ dbcc_parser_parse_file      (DBCC_Parser   *parser,
                     dbcc_error_add_code_position (error, cpp_tokens[at+1].code_position);
                     parser->handlers.handle_error (error, parser->handler_data);
                   }
-                  return false;
+                  goto failed;
                 }
             }
           else if (cpp_tokens[at+1].length == 4
@@ -2500,7 +5644,7 @@ dbcc_parser_parse_file      (DBCC_Parser   *parser,
               if (n_expr_tokens == 0)
                 {
                   parser->handlers.handle_error (error, parser->handler_data);
-                  return false;
+                  goto failed;
                 }
               if (preproc_conditional_level == 0)
                 {
@@ -2508,7 +5652,7 @@ dbcc_parser_parse_file      (DBCC_Parser   *parser,
                                           "#elif encountered at toplevel");
                   dbcc_error_add_code_position (error, cpp_tokens[at+1].code_position);
                   parser->handlers.handle_error (error, parser->handler_data);
-                  return false;
+                  goto failed;
                 }
               at += n_expr_tokens + 2;  /* expression tokens plus '#' and if/ifdef/ifndef */
 
@@ -2525,7 +5669,7 @@ dbcc_parser_parse_file      (DBCC_Parser   *parser,
                   if (!eval_cpp_expr_boolean (parser, &cpp_expr, &result, &error))
                     {
                       parser->handlers.handle_error (error, parser->handler_data);
-                      return false;
+                      goto failed;
                     }
                   if (result)
                     PREPROC_TOP = CPP_STACK_ACTIVE;
@@ -2544,7 +5688,7 @@ dbcc_parser_parse_file      (DBCC_Parser   *parser,
                                            "already had #else directive");
                   dbcc_error_add_code_position (error, cpp_tokens[at+1].code_position);
                   parser->handlers.handle_error (error, parser->handler_data);
-                  return false;
+                  goto failed;
                 }
             }
           else if (cpp_tokens[at+1].length == 6
@@ -2557,7 +5701,7 @@ dbcc_parser_parse_file      (DBCC_Parser   *parser,
                                            "missing name after #define");
                   dbcc_error_add_code_position (error, cpp_tokens[at+1].code_position);
                   parser->handlers.handle_error (error, parser->handler_data);
-                  return false;
+                  goto failed;
                 }
               if (cpp_tokens[at + 2].type != CPP_TOKEN_BAREWORD)
                 {
@@ -2567,8 +5711,21 @@ dbcc_parser_parse_file      (DBCC_Parser   *parser,
                                            cpp_token_type_name (cpp_tokens[at + 2].type));
                   dbcc_error_add_code_position (error, cpp_tokens[at+1].code_position);
                   parser->handlers.handle_error (error, parser->handler_data);
-                  return false;
+                  goto failed;
+                }
+              size_t def_end = at + 2;
+              while (def_end < n_cpp_tokens
+                  && cpp_tokens[def_end].type != CPP_TOKEN_NEWLINE)
+                def_end++;
+              DBCC_Error *error = NULL;
+              if (active
+               && !define_macro (parser, def_end - (at + 2), cpp_tokens + at + 2, &error))
+                {
+                  parser->handlers.handle_error (error, parser->handler_data);
+                  goto failed;
                 }
+              at = def_end < n_cpp_tokens ? def_end + 1 : def_end;
+              continue;
             }
           else if (cpp_tokens[at+1].length == 5
                &&  memcmp (cpp_tokens[at+1].str, "endif", 5) == 0)
@@ -2580,9 +5737,10 @@ dbcc_parser_parse_file      (DBCC_Parser   *parser,
                                           "no #if/ifdef/ifndef for #endif");
                   dbcc_error_add_code_position (error, cpp_tokens[at+1].code_position);
                   parser->handlers.handle_error (error, parser->handler_data);
-                  return false;
+                  goto failed;
                 }
-              if (cpp_tokens[at+2].type == CPP_TOKEN_NEWLINE)
+              if (at + 2 < n_cpp_tokens
+               && cpp_tokens[at+2].type != CPP_TOKEN_NEWLINE)
                 {
                   DBCC_Error *error;
                   error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_SYNTAX,
@@ -2590,7 +5748,7 @@ dbcc_parser_parse_file      (DBCC_Parser   *parser,
                                           cpp_token_type_name (cpp_tokens[at+2].type));
                   dbcc_error_add_code_position (error, cpp_tokens[at+2].code_position);
                   parser->handlers.handle_error (error, parser->handler_data);
-                  return false;
+                  goto failed;
                 }
 
               preproc_conditional_level--;
@@ -2601,52 +5759,61 @@ dbcc_parser_parse_file      (DBCC_Parser   *parser,
                   continue;
                 }
             }
-          else if (cpp_tokens[at+1].length == 4
-               &&  memcmp (cpp_tokens[at+1].str, "line", 4) == 0)
-            {
-              /* #line is handled earlier */
-            }
-          else if (cpp_tokens[at+1].length == 5
-               &&  memcmp (cpp_tokens[at+1].str, "error", 5) == 0)
-            {
-              /* Section 6.10.5 Error directive */
-              const char *msg = cpp_tokens[at+1].str + 5;
-              while (*msg != '\n' && isspace (*msg))
-                msg++;
-              const char *end_msg = strchr (msg, '\n');
-              if (end_msg == NULL)
-                end_msg = strchr (msg, 0);
-              DBCC_Error *error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_HASH_ERROR,
-                                  "#error processed: %.*s",
-                                  (int)(end_msg - msg), msg);
-              dbcc_error_add_code_position (error, cpp_tokens[at+1].code_position);
-              parser->handlers.handle_error (error, parser->handler_data);
-              return false;
-            }
-          else if (cpp_tokens[at+1].length == 5
-               &&  memcmp (cpp_tokens[at+1].str, "endif", 5) == 0)
+          else
             {
-              if (cpp_tokens[at+2].type != CPP_TOKEN_NEWLINE)
+              /* The rest of the directives take the whole line.
+               * #line was handled while tokenizing, and #pragma is ignored. */
+              size_t line_end = at + 2;
+              while (line_end < n_cpp_tokens
+                  && cpp_tokens[line_end].type != CPP_TOKEN_NEWLINE)
+                line_end++;
+              CPP_Token *name = cpp_tokens + at + 1;
+              DBCC_Error *error = NULL;
+              if (!active
+               || directive_name_is (name->length, name->str, "line")
+               || directive_name_is (name->length, name->str, "pragma"))
+                ;
+              else if (directive_name_is (name->length, name->str, "undef"))
                 {
-                  DBCC_Error *error;
-                  error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_SYNTAX,
-                                          "unexpected identifier after #endif");
-                  dbcc_error_add_code_position (error, cpp_tokens[at+2].code_position);
-                  parser->handlers.handle_error (error, parser->handler_data);
-                  return false;
+                  if (line_end != at + 3 || cpp_tokens[at+2].type != CPP_TOKEN_BAREWORD)
+                    error = dbcc_error_new (DBCC_ERROR_BAD_PREPROCESSOR_DIRECTIVE,
+                                            "#undef must be followed by exactly one identifier");
+                  else
+                    {
+                      DBCC_Symbol *sym = dbcc_symbol_space_try_len (parser->symbol_space,
+                                                                    cpp_tokens[at+2].length,
+                                                                    cpp_tokens[at+2].str);
+                      if (sym != NULL)
+                        undefine_macro (parser, sym);
+                    }
                 }
-              if (preproc_conditional_level == 0)
+              else if (directive_name_is (name->length, name->str, "error"))
                 {
-                  DBCC_Error *error;
-                  error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_UNMATCHED_ENDIF,
-                                          "#endif without corresponding #if");
-                  dbcc_error_add_code_position (error, cpp_tokens[at+1].code_position);
+                  /* Section 6.10.5 Error directive */
+                  const char *msg = name->str + 5;
+                  while (*msg != '\n' && isspace (*msg))
+                    msg++;
+                  const char *end_msg = strchr (msg, '\n');
+                  if (end_msg == NULL)
+                    end_msg = strchr (msg, 0);
+                  error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_HASH_ERROR,
+                                          "#error processed: %.*s",
+                                          (int)(end_msg - msg), msg);
+                }
+              else if (directive_name_is (name->length, name->str, "include"))
+                error = dbcc_error_new (DBCC_ERROR_BAD_PREPROCESSOR_DIRECTIVE,
+                                        "#include is not supported by dbcc_parser_parse_file() yet");
+              else
+                error = dbcc_error_new (DBCC_ERROR_BAD_PREPROCESSOR_DIRECTIVE,
+                                        "unknown preprocessor directive #%.*s",
+                                        (int) name->length, name->str);
+              if (error != NULL)
+                {
+                  dbcc_error_add_code_position (error, name->code_position);
                   parser->handlers.handle_error (error, parser->handler_data);
-                  return false;
+                  goto failed;
                 }
-              preproc_conditional_level -= 1;
-              if (preproc_conditional_level == 0)
-                past_last_endif = true;
+              at = line_end;
             }
           is_first = false;
           if (past_last_endif && guard != NULL)
@@ -2659,235 +5826,32 @@ dbcc_parser_parse_file      (DBCC_Parser   *parser,
         {
           if (cpp_tokens[at].type != CPP_TOKEN_NEWLINE)
             {
-              if (preproc_conditional_level == 0 || is_active_cpp_stack_state (PREPROC_TOP))
+              at_line_start = false;
+              if (active
+               && (cpp_tokens[at].type == CPP_TOKEN_HASH
+                || cpp_tokens[at].type == CPP_TOKEN_CONCATENATE))
+                {
+                  DBCC_Error *error = dbcc_error_new (DBCC_ERROR_PREPROCESSOR_SYNTAX,
+                                                      "stray '%.*s' outside a directive",
+                                                      (int) cpp_tokens[at].length,
+                                                      cpp_tokens[at].str);
+                  dbcc_error_add_code_position (error, cpp_tokens[at].code_position);
+                  parser->handlers.handle_error (error, parser->handler_data);
+                  goto failed;
+                }
+              if (active)
                 {
-                  DBCC_CodePosition *cp = cpp_tokens[at].code_position;
-                  P_Token pt;
                   DBCC_Error *error = NULL;
-                  switch (cpp_tokens[at].type)
+                  bool ok = parser->lazy_function_bodies
+                          ? lazy_filter_token (parser, cpp_tokens + at, &error)
+                          : emit_cpp_token (parser, cpp_tokens + at, &error);
+                  if (!ok)
                     {
-                    case CPP_TOKEN_HASH:
-                      assert(false);
-                    case CPP_TOKEN_CONCATENATE:              /* ## */
-                      assert(false);
-                    case CPP_TOKEN_MACRO_ARGUMENT:
-                    case CPP_TOKEN_NEWLINE:
-                      assert(false);
-                    case CPP_TOKEN_STRING:
-                      pt = P_TOKEN_INIT(STRING_LITERAL, cp);
-                      if (!dbcc_common_string_literal_value (cpp_tokens[at].length,
-                                                             cpp_tokens[at].str,
-                                                             &pt.v_string_literal,
-                                                             &error))
-                       {
-                         dbcc_error_add_code_position (error, cpp_tokens[at].code_position);
-                         parser->handlers.handle_error (error, parser->handler_data);
-                         return false;
-                       }
-                      EMIT_PTOKEN_TO_PARSER(pt);
-                      break;
-                    case CPP_TOKEN_CHAR:
-                      {
-                        uint32_t value;
-                        size_t sizeof_char;
-                        if (!dbcc_common_char_constant_value (parser->target_environment,
-                                                              cpp_tokens[at].length,
-                                                              cpp_tokens[at].str,
-                                                              &value,
-                                                              &sizeof_char,
-                                                              &error))
-                          {
-                            dbcc_error_add_code_position (error, cpp_tokens[at].code_position);
-                            parser->handlers.handle_error (error, parser->handler_data);
-                            return false;
-                          }
-                        P_Token t = {
-                          .code_position = cpp_tokens[at].code_position,
-                          .token_type = P_TOKEN_I_CONSTANT,
-                          .v_i_constant.sizeof_value = sizeof_char,
-                          .v_i_constant.is_signed = false,
-                          .v_i_constant.v_uint64 = value,
-                        };
-                        EMIT_PTOKEN_TO_PARSER(t);
-                      }
-                    case CPP_TOKEN_NUMBER:
-                      {
-                        if (dbcc_common_number_is_integral (cpp_tokens[at].length,
-                                                            cpp_tokens[at].str))
-                          {
-                            size_t sizeof_int_type;
-                            bool is_signed;
-                            if (!dbcc_common_integer_get_info (parser->target_environment,
-                                                               cpp_tokens[at].length,
-                                                               cpp_tokens[at].str,
-                                                               &sizeof_int_type,
-                                                               &is_signed,
-                                                               &error))
-                              {
-                                dbcc_error_add_code_position (error, cpp_tokens[at].code_position);
-                                parser->handlers.handle_error (error, parser->handler_data);
-                                return false;
-                              }
-
-                            if (is_signed)
-                              {
-                                char *end;
-                                int64_t v = strtoll (cpp_tokens[at].str, &end, 0);
-                                if (cpp_tokens[at].str == end)
-                                  {
-                                    error = dbcc_error_new (DBCC_ERROR_PARSING_INTEGER,
-                                                            "error parsing signed integer");
-                                    dbcc_error_add_code_position (error, cpp_tokens[at].code_position);
-                                    parser->handlers.handle_error (error, parser->handler_data);
-                                    return false;
-                                  }
-                                P_Token t = {
-                                  .code_position = cpp_tokens[at].code_position,
-                                  .token_type = P_TOKEN_I_CONSTANT,
-                                  .v_i_constant.sizeof_value = sizeof_int_type,
-                                  .v_i_constant.is_signed = is_signed,
-                                  .v_i_constant.v_int64 = v,
-                                };
-                                EMIT_PTOKEN_TO_PARSER(t);
-                              }
-                            else
-                              {
-                                char *end;
-                                uint64_t v = strtoull (cpp_tokens[at].str, &end, 0);
-                                if (cpp_tokens[at].str == end)
-                                  {
-                                    error = dbcc_error_new (DBCC_ERROR_PARSING_INTEGER,
-                                                            "error parsing unsigned integer");
-                                    dbcc_error_add_code_position (error, cpp_tokens[at].code_position);
-                                    parser->handlers.handle_error (error, parser->handler_data);
-                                    return false;
-                                  }
-                                P_Token t = {
-                                  .code_position = cpp_tokens[at].code_position,
-                                  .token_type = P_TOKEN_I_CONSTANT,
-                                  .v_i_constant.sizeof_value = sizeof_int_type,
-                                  .v_i_constant.is_signed = is_signed,
-                                  .v_i_constant.v_uint64 = v,
-                                };
-                                EMIT_PTOKEN_TO_PARSER(t);
-                              }
-                          }
-                        else
-                          {
-                            char *end;
-                            long double v = strtold(cpp_tokens[at].str, &end);
-                            if (cpp_tokens[at].str == end)
-                              {
-                                error = dbcc_error_new (DBCC_ERROR_PARSING_FLOAT,
-                                                        "error parsing floating-pointer number");
-                                dbcc_error_add_code_position (error, cpp_tokens[at].code_position);
-                                parser->handlers.handle_error (error, parser->handler_data);
-                                return false;
-                              }
-                            DBCC_FloatType float_type;
-                            DBCC_Error *error = NULL;
-                            if (!dbcc_common_floating_point_get_info(parser->target_environment,
-                                                            cpp_tokens[at].length,
-                                                            cpp_tokens[at].str,
-                                                            &float_type,
-                                                            &error))
-                              {
-                                dbcc_error_add_code_position (error, cpp_tokens[at].code_position);
-                                parser->handlers.handle_error (error, parser->handler_data);
-                                return false;
-                              }
-                            P_Token t = {
-                              .code_position = cpp_tokens[at].code_position,
-                              .token_type = P_TOKEN_F_CONSTANT,
-                              .v_f_constant.float_type = float_type,
-                              .v_f_constant.v_long_double = v,
-                            };
-                            EMIT_PTOKEN_TO_PARSER(t);
-                          }
-                      }
-                      break;
-
-                    case CPP_TOKEN_OPERATOR:
-                      {
-                        DBCC_Error *error = NULL;
-                        memset (&pt, 0, sizeof (P_Token));
-                        if (!convert_cpp_token_operator_to_ptokentype (&cpp_tokens[at], &pt.token_type, &error))
-                          {
-                            parser->handlers.handle_error (error, parser->handler_data);
-                            return false;
-                          }
-                        pt.code_position = cp;
-                        EMIT_PTOKEN_TO_PARSER(pt);
-                        break;
-                      }
-
-                    case CPP_TOKEN_OPERATOR_DIGRAPH:
-                      {
-                        DBCC_Error *error = NULL;
-                        memset (&pt, 0, sizeof (P_Token));
-                        if (!convert_cpp_token_digraph_operator_to_ptokentype (&cpp_tokens[at], &pt.token_type, &error))
-                          {
-                            parser->handlers.handle_error (error, parser->handler_data);
-                            return false;
-                          }
-                        pt.code_position = cp;
-                        EMIT_PTOKEN_TO_PARSER(pt);
-                        break;
-                      }
-
-                    case CPP_TOKEN_BAREWORD:
-                      {
-                        int token_type;
-                        DBCC_Symbol *symbol = dbcc_symbol_space_force_len (parser->symbol_space,
-                                                                           cpp_tokens[at].length,
-                                                                           cpp_tokens[at].str);
-                        if (is_reserved_word (symbol, &token_type))
-                          {
-                            // known reserved word
-                            pt = (P_Token) {.code_position = cpp_tokens[at].code_position,
-                                            .token_type = token_type};
-                          }
-                        else
-                          {
-                            DBCC_NamespaceEntry ns_entry;
-                            if (!dbcc_namespace_lookup (parser_get_ns (parser),
-                                                        symbol,
-                                                        &ns_entry))
-                              {
-                                // fallback to IDENTIFIER
-                                pt = (P_Token) {.code_position = cpp_tokens[at].code_position,
-                                                .token_type = P_TOKEN_IDENTIFIER,
-                                                .v_identifier = symbol};
-                              }
-                            else
-                              switch (ns_entry.entry_type)
-                                {
-                                case DBCC_NAMESPACE_ENTRY_TYPEDEF:
-                                  pt = (P_Token) {.code_position = cpp_tokens[at].code_position,
-                                                  .token_type = P_TOKEN_TYPEDEF_NAME,
-                                                  .v_typedef_name.type = ns_entry.v_typedef,
-                                                  .v_typedef_name.name = symbol };
-                                  break;
-                                case DBCC_NAMESPACE_ENTRY_GLOBAL:
-                                  pt = (P_Token) {.code_position = cpp_tokens[at].code_position,
-                                                  .token_type = P_TOKEN_IDENTIFIER,
-                                                  .v_identifier = symbol};
-                                  break;
-                                case DBCC_NAMESPACE_ENTRY_ENUM_VALUE:
-                                  pt = (P_Token) {.code_position = cpp_tokens[at].code_position,
-                                                  .token_type = P_TOKEN_ENUMERATION_CONSTANT,
-                                                  .v_enum_value = ns_entry.v_enum_value.enum_value};
-                                  break;
-                                default:
-                                  assert(0);
-                                }
-                          }
-                        EMIT_PTOKEN_TO_PARSER(pt);
-                        break;
-                      }
+                      parser->handlers.handle_error (error, parser->handler_data);
+                      goto failed;
                     }
-
                 }
+              at++;
 
               is_first = false;
               if (past_last_endif && guard != NULL)
@@ -2898,20 +5862,110 @@ dbcc_parser_parse_file      (DBCC_Parser   *parser,
             }
         }
     }
+
+  if (preproc_conditional_level > 0)
+    {
+      DBCC_Error *error = dbcc_error_new (DBCC_ERROR_UNEXPECTED_EOF,
+                                          "missing #endif at end of file");
+      DBCC_CodePosition *cp = CREATE_CP();
+      dbcc_error_add_code_position (error, cp);
+      dbcc_code_position_unref (cp);
+      parser->handlers.handle_error (error, parser->handler_data);
+      goto failed;
+    }
+  if (parser->lazy_function_bodies)
+    {
+      DBCC_Error *error = NULL;
+      if (!lazy_finish_translation_unit (parser, &error))
+        {
+          parser->handlers.handle_error (error, parser->handler_data);
+          goto failed;
+        }
+    }
+
+  /* end of input:  reduce the translation-unit */
+  {
+    P_Token eof_token;
+    memset (&eof_token, 0, sizeof (eof_token));
+    DBCC_Lemon_Parser (parser->lemon_parser, 0, eof_token, parser->context);
+    DBCC_Error *error = p_context_take_error (parser->context);
+    if (error != NULL)
+      {
+        parser->handlers.handle_error (error, parser->handler_data);
+        goto failed;
+      }
+  }
+  free (guard);
+  free (preproc_conditional_stack);
+  free (cpp_tokens);
+  free (contents);
   return true;
 
+failed:
+  /* The lemon parser may be in the middle of a declaration;
+   * start over with a fresh one, and drop any saved function bodies. */
+  DBCC_Lemon_ParserFree (parser->lemon_parser, free);
+  parser->lemon_parser = DBCC_Lemon_ParserAlloc (malloc);
+  if (parser->lazy_function_bodies)
+    lazy_discard (parser);
+  free (guard);
+  free (preproc_conditional_stack);
+  free (cpp_tokens);
+  free (contents);
+  return false;
+
 #undef CREATE_CP
 #undef APPEND_TOKEN
 #undef APPEND_CPP_TOKEN
 #undef PREPROC_TOP
 #undef PREPROC_NEXT_TOP
-#undef EMIT_PTOKEN_TO_PARSER
+}
+
+bool
+dbcc_parser_parse_file      (DBCC_Parser   *parser,
+                             const char    *filename)
+{
+  DBCC_Region *old_region = dbcc_region_set_current (parser->region);
+  bool rv = parse_file_in_region (parser, filename);
+  dbcc_region_set_current (old_region);
+  return rv;
+}
+
+void
+dbcc_parser_get_stats       (DBCC_Parser      *parser,
+                             DBCC_ParserStats *stats_out)
+{
+  dbcc_namespace_global_get_constant_stats (parser->globals, &stats_out->constants);
+  stats_out->constant_bytes_saved = stats_out->constants.bytes_requested
+                                  - stats_out->constants.bytes_allocated;
+  dbcc_region_get_stats (parser->region, &stats_out->nodes);
+  stats_out->function_bodies_deferred = parser->lazy.n_deferred;
+  stats_out->function_bodies_materialized = parser->lazy.n_materialized;
 }
 
 void
 dbcc_parser_destroy         (DBCC_Parser   *parser)
 {
   DBCC_Lemon_ParserFree(parser->lemon_parser, free);
-  //TODO free other stuff
+  free_compiled_expr_tree (parser->compiled_expr_tree);
+  free_macro_tree (parser->macro_tree);
+  dbcc_ptr_table_clear (&parser->include_guards);
+
+  lazy_discard (parser);
+  free (parser->lazy.pending.tokens);
+  free (parser->lazy.bodies);
+
+  dbcc_ptr_table_foreach (&parser->documents, document_free_entry, NULL);
+  dbcc_ptr_table_clear (&parser->documents);
+
+  for (size_t i = 0; i < parser->n_include_dirs; i++)
+    free (parser->include_dirs[i]);
+  free (parser->include_dirs);
+
+  p_context_free (parser->context);
+  dsk_buffer_clear (&parser->buffer);
+  dbcc_region_destroy (parser->region);
+  if (parser->handlers.handle_destroy != NULL)
+    parser->handlers.handle_destroy (parser->handler_data);
   free (parser);
 }
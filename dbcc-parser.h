@@ -7,6 +7,12 @@ struct DBCC_Parser_NewOptions
 {
 
   DBCC_TargetEnvironment *target_env;
+
+  /* 'stmt' and everything it points to (expressions, types,
+   * code-positions) live in the parser's region until
+   * dbcc_parser_destroy(); dbcc_statement_destroy() is not needed.
+   * Errors that hold code-positions must be released before then too.
+   */
   void (*handle_statement)(DBCC_Statement *stmt,
                            void           *handler_data);
 
@@ -18,6 +24,19 @@ struct DBCC_Parser_NewOptions
   void (*handle_destroy)  (void           *handler_data);
 
   void *handler_data;
+
+  /* If set, function bodies are not parsed until the function
+   * is referenced, or until the end of the translation unit
+   * for non-static functions.  Unreferenced static functions
+   * (eg static inline functions from headers) are never parsed.
+   */
+  bool lazy_function_bodies;
+
+  /* Parsers on different threads may share a symbol space,
+   * so that their symbols compare equal by pointer.
+   * If NULL, the parser makes its own.
+   */
+  DBCC_SymbolSpace *symbol_space;
 };
 
 #define DBCC_PARSER_NEW_OPTIONS (DBCC_Parser_NewOptions) {  \
@@ -33,4 +52,103 @@ bool         dbcc_parser_parse_file_data (DBCC_Parser   *parser,
                                           const char    *filename,
                                           size_t         file_size,
                                           const uint8_t *file_data);
+
+/* Dependency scanning, as in "cc -M":  only the preprocessor
+ * directive layer is run, and the list of included files
+ * is written to 'out'.  Non-directive lines are never tokenized.
+ *
+ * If 'target' is NULL, it is derived from 'filename'
+ * (dir/foo.c => foo.o).
+ */
+typedef enum
+{
+  DBCC_DEPENDENCY_FORMAT_MAKE,
+  DBCC_DEPENDENCY_FORMAT_JSON
+} DBCC_DependencyFormat;
+
+bool         dbcc_parser_scan_dependencies (DBCC_Parser          *parser,
+                                            const char           *filename,
+                                            const char           *target,
+                                            DBCC_DependencyFormat format,
+                                            DskBuffer            *out);
+
+/* Incremental reparsing, for editors.
+ *
+ * An open document is divided into toplevel declarations and
+ * preprocessor directive lines ("spans").  After an edit, only the
+ * damaged part of the text is rescanned, and the rescanned spans
+ * are lexed again.  Spans whose tokens changed are marked dirty,
+ * as are spans that mention a name declared by a changed span,
+ * and all spans after a changed directive.
+ * Whitespace and comment changes do not dirty a span.
+ *
+ * Lexing errors go to handle_error; the edit is still applied,
+ * and the line with the error is compared as raw text.
+ *
+ * The dirty flags describe only the most recent edit.
+ */
+typedef struct DBCC_ParserDocument DBCC_ParserDocument;
+
+typedef struct DBCC_ParserDeclSpan DBCC_ParserDeclSpan;
+struct DBCC_ParserDeclSpan
+{
+  size_t start;
+  size_t length;
+  uint32_t hash;                        /* of tokens, not whitespace/comments */
+  DBCC_Symbol *declared_name;           /* best guess; may be NULL */
+  bool is_directive;
+  bool dirty;
+};
+
+typedef struct DBCC_ParserEdit DBCC_ParserEdit;
+struct DBCC_ParserEdit
+{
+  size_t offset;
+  size_t old_length;
+  size_t new_length;
+  const char *new_text;
+};
+
+bool         dbcc_parser_open_document   (DBCC_Parser   *parser,
+                                          const char    *filename,
+                                          size_t         size,
+                                          const uint8_t *data);
+bool         dbcc_parser_apply_edit      (DBCC_Parser           *parser,
+                                          const char            *filename,
+                                          const DBCC_ParserEdit *edit);
+const DBCC_ParserDeclSpan *
+             dbcc_parser_peek_decl_spans (DBCC_Parser   *parser,
+                                          const char    *filename,
+                                          size_t        *n_spans_out);
+const char * dbcc_parser_peek_document_text (DBCC_Parser   *parser,
+                                          const char    *filename,
+                                          size_t        *size_out);
+void         dbcc_parser_close_document  (DBCC_Parser   *parser,
+                                          const char    *filename);
+
+/* Compile statistics for the translation unit parsed so far.
+ * Getting them has no effect on the compile:  in particular
+ * the constant data section is not laid out.
+ */
+typedef struct DBCC_ParserStats DBCC_ParserStats;
+struct DBCC_ParserStats
+{
+  DBCC_ConstantPoolStats constants;
+
+  /* bytes_requested - bytes_allocated:  saved by sharing identical
+   * literals and by storing tails of literals inside longer ones. */
+  size_t constant_bytes_saved;
+
+  /* The region holding this parser's expressions, statements,
+   * types, constants and code-positions. */
+  DBCC_RegionStats nodes;
+
+  /* With lazy_function_bodies:  definitions whose parsing was
+   * deferred, and how many of those were parsed in the end. */
+  size_t function_bodies_deferred;
+  size_t function_bodies_materialized;
+};
+void         dbcc_parser_get_stats       (DBCC_Parser      *parser,
+                                          DBCC_ParserStats *stats_out);
+
 void         dbcc_parser_destroy         (DBCC_Parser   *parser);
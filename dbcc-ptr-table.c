@@ -64,7 +64,8 @@ dbcc_ptr_table_force   (DBCC_PtrTable *table,
       table->occupancy = 0;
       table->table = calloc (sizeof (DBCC_PtrTable_Entry *), table->size);
     }
-  else if ((uint64_t) table->size * MAX_OCC_DENOM >= table->occupancy * MAX_OCC_NUMER)
+  else if ((uint64_t) table->occupancy * MAX_OCC_DENOM >= (uint64_t) table->size * MAX_OCC_NUMER
+        && table->size_index + 1 < DSK_N_ELEMENTS (ptr_table_sizes))
     {
       size_t new_size = ptr_table_sizes[table->size_index + 1];
       DBCC_PtrTable_Entry **newtab = calloc (sizeof (DBCC_PtrTable_Entry *), new_size);
@@ -141,4 +142,8 @@ dbcc_ptr_table_clear   (DBCC_PtrTable *table)
         }
     }
   free (table->table);
+  table->table = NULL;
+  table->size = 0;
+  table->size_index = 0;
+  table->occupancy = 0;
 }
@@ -0,0 +1,129 @@
+#include "dbcc.h"
+
+/* Each chunk begins with one cache line holding the link to the
+ * next chunk, so that the nodes after it start line-aligned.
+ */
+#define CHUNK_HEADER_SIZE        DBCC_REGION_CACHE_LINE_SIZE
+#define CHUNK_GET_NEXT_PTR(chunk) (* (void **) (chunk))
+
+/* Bigger requests get a chunk of their own, so they don't
+ * waste the tail of the current chunk.
+ */
+#define MAX_SHARED_ALLOC         (DBCC_REGION_CHUNK_SIZE / 4)
+
+/* per-thread, so parsers on different threads (which may share
+ * a DBCC_SymbolSpace) each fill their own region */
+static _Thread_local DBCC_Region *current_region = NULL;
+
+static void *
+alloc_chunk (DBCC_Region *region, size_t size)
+{
+  void *chunk = aligned_alloc (DBCC_REGION_CACHE_LINE_SIZE, size);
+  if (chunk == NULL)
+    dsk_die ("out-of-memory allocating %u byte region chunk", (unsigned) size);
+  region->stats.n_chunks += 1;
+  region->stats.bytes_reserved += size;
+  return chunk;
+}
+
+DBCC_Region *
+dbcc_region_new        (void)
+{
+  DBCC_Region *region = DBCC_NEW (DBCC_Region);
+  memset (&region->stats, 0, sizeof (DBCC_RegionStats));
+  char *chunk = alloc_chunk (region, DBCC_REGION_CHUNK_SIZE);
+  CHUNK_GET_NEXT_PTR (chunk) = NULL;
+  region->chunk_list = chunk;
+  region->at = chunk + CHUNK_HEADER_SIZE;
+  region->end = chunk + DBCC_REGION_CHUNK_SIZE;
+  return region;
+}
+
+void *
+dbcc_region_alloc_slow (DBCC_Region      *region,
+                        size_t            size)
+{
+  size_t rounded = DBCC_ALIGN (size, DBCC_REGION_NODE_ALIGN);
+  char *chunk;
+  if (rounded > MAX_SHARED_ALLOC)
+    {
+      /* Link the dedicated chunk behind the current one. */
+      size_t chunk_size = DBCC_ALIGN (CHUNK_HEADER_SIZE + rounded,
+                                      DBCC_REGION_CACHE_LINE_SIZE);
+      chunk = alloc_chunk (region, chunk_size);
+      CHUNK_GET_NEXT_PTR (chunk) = CHUNK_GET_NEXT_PTR (region->chunk_list);
+      CHUNK_GET_NEXT_PTR (region->chunk_list) = chunk;
+      region->stats.n_allocs += 1;
+      region->stats.bytes_requested += size;
+      region->stats.bytes_used += rounded;
+      return chunk + CHUNK_HEADER_SIZE;
+    }
+
+  chunk = alloc_chunk (region, DBCC_REGION_CHUNK_SIZE);
+  CHUNK_GET_NEXT_PTR (chunk) = region->chunk_list;
+  region->chunk_list = chunk;
+  region->at = chunk + CHUNK_HEADER_SIZE;
+  region->end = chunk + DBCC_REGION_CHUNK_SIZE;
+  return dbcc_region_alloc (region, size);
+}
+
+void *
+dbcc_region_alloc0     (DBCC_Region      *region,
+                        size_t            size)
+{
+  return memset (dbcc_region_alloc (region, size), 0, size);
+}
+
+void
+dbcc_region_get_stats  (DBCC_Region      *region,
+                        DBCC_RegionStats *stats_out)
+{
+  *stats_out = region->stats;
+}
+
+/* Releases every node in the region.  The cost is one free()
+ * per chunk, independent of the number of nodes.
+ */
+void
+dbcc_region_destroy    (DBCC_Region      *region)
+{
+  assert (current_region != region);
+  void *chunk = region->chunk_list;
+  while (chunk != NULL)
+    {
+      void *next = CHUNK_GET_NEXT_PTR (chunk);
+      free (chunk);
+      chunk = next;
+    }
+  free (region);
+}
+
+DBCC_Region *
+dbcc_region_set_current(DBCC_Region      *region)
+{
+  DBCC_Region *old = current_region;
+  current_region = region;
+  return old;
+}
+
+DBCC_Region *
+dbcc_region_get_current(void)
+{
+  return current_region;
+}
+
+void *
+dbcc_node_alloc        (size_t            size)
+{
+  if (current_region != NULL)
+    return dbcc_region_alloc (current_region, size);
+  return malloc (size);
+}
+
+void *
+dbcc_node_alloc0       (size_t            size)
+{
+  if (current_region != NULL)
+    return dbcc_region_alloc0 (current_region, size);
+  return calloc (size, 1);
+}
@@ -0,0 +1,93 @@
+#ifndef __DBCC_REGION_H_
+#define __DBCC_REGION_H_
+
+/* A region is an allocate-only arena for the nodes of one
+ * translation unit:  expressions, statements, types, constants
+ * and code-positions.  Nothing in a region is freed individually;
+ * dbcc_region_destroy() releases the whole thing by handing back
+ * its chunks, without visiting any node.
+ *
+ * Node constructors draw from the calling thread's "current" region,
+ * which the parser sets while it works on a translation unit.
+ * With no current region, they fall back to malloc() as before,
+ * and the node is marked so its destroy/unref function frees it.
+ */
+
+typedef struct DBCC_Region DBCC_Region;
+typedef struct DBCC_RegionStats DBCC_RegionStats;
+
+#define DBCC_REGION_CACHE_LINE_SIZE    64
+#define DBCC_REGION_NODE_ALIGN         16
+#define DBCC_REGION_CHUNK_SIZE         (64 * 1024)
+
+struct DBCC_RegionStats
+{
+  size_t n_allocs;
+  size_t bytes_requested;       /* sum of sizes passed to alloc */
+  size_t bytes_used;            /* ... plus rounding and line padding */
+  size_t n_chunks;
+  size_t bytes_reserved;        /* sum of chunk sizes */
+};
+
+struct DBCC_Region
+{
+  /*< private >*/
+  void *chunk_list;
+  char *at;
+  char *end;
+  DBCC_RegionStats stats;
+};
+
+DBCC_Region *dbcc_region_new        (void);
+DBCC_INLINE void *
+             dbcc_region_alloc      (DBCC_Region      *region,
+                                     size_t            size);
+void        *dbcc_region_alloc0     (DBCC_Region      *region,
+                                     size_t            size);
+void         dbcc_region_get_stats  (DBCC_Region      *region,
+                                     DBCC_RegionStats *stats_out);
+void         dbcc_region_destroy    (DBCC_Region      *region);
+
+/* Returns the previously current region, which the caller
+ * must restore when it is done.
+ */
+DBCC_Region *dbcc_region_set_current(DBCC_Region      *region);
+DBCC_Region *dbcc_region_get_current(void);
+
+/* Allocate from the current region, or from the heap if there is none. */
+void        *dbcc_node_alloc        (size_t            size);
+void        *dbcc_node_alloc0       (size_t            size);
+#define dbcc_node_allocs_from_region()  (dbcc_region_get_current () != NULL)
+
+/* private */
+void        *dbcc_region_alloc_slow (DBCC_Region      *region,
+                                     size_t            size);
+
+/* Sizes are rounded to DBCC_REGION_NODE_ALIGN.  Nodes whose size
+ * divides the cache line (16, 32 or 64 bytes; DBCC_Expr is 64) never
+ * straddle two lines;  other sizes are packed densely instead.
+ */
+DBCC_INLINE void *
+dbcc_region_alloc      (DBCC_Region      *region,
+                        size_t            size)
+{
+  size_t rounded = DBCC_ALIGN (size, DBCC_REGION_NODE_ALIGN);
+  char *rv = region->at;
+  if (rounded <= DBCC_REGION_CACHE_LINE_SIZE
+   && (rounded & (rounded - 1)) == 0)
+    {
+      size_t line_left = DBCC_REGION_CACHE_LINE_SIZE
+                       - ((uintptr_t) rv & (DBCC_REGION_CACHE_LINE_SIZE - 1));
+      if (line_left < rounded)
+        rv += line_left;
+    }
+  if (rv + rounded > region->end)
+    return dbcc_region_alloc_slow (region, size);
+  region->stats.n_allocs += 1;
+  region->stats.bytes_requested += size;
+  region->stats.bytes_used += (rv + rounded) - region->at;
+  region->at = rv + rounded;
+  return rv;
+}
+
+#endif
@@ -4,8 +4,9 @@
 static inline DBCC_Statement *
 statement_alloc (DBCC_StatementType type)
 {
-  DBCC_Statement *rv = calloc (sizeof(DBCC_Statement), 1);
+  DBCC_Statement *rv = DBCC_NODE_NEW0 (DBCC_Statement);
   rv->type = type;
+  rv->base.from_region = dbcc_node_allocs_from_region ();
   return rv;
 }
 
@@ -344,8 +345,8 @@ dbcc_statement_new_switch         (DBCC_Expr          *expr,
   rv->v_switch.value_expr = expr;
   rv->v_switch.body = switch_body;
   rv->v_switch.n_cases = value_cases_count (smcd.tree_top);
-  rv->v_switch.cases = DBCC_NEW_ARRAY (rv->v_switch.n_cases,
-                                       DBCC_SwitchStatementCase);
+  rv->v_switch.cases = DBCC_NODE_NEW_ARRAY (rv->v_switch.n_cases,
+                                            DBCC_SwitchStatementCase);
   DBCC_SwitchStatementCase *at = rv->v_switch.cases;
   update_switch_cases_recursive (smcd.tree_top, &at);
   assert(at == rv->v_switch.cases + rv->v_switch.n_cases);
@@ -513,5 +514,6 @@ void dbcc_statement_destroy (DBCC_Statement *statement)
     }
   if (statement->base.code_position != NULL)
     dbcc_code_position_unref (statement->base.code_position);
-  free (statement);
+  if (!statement->base.from_region)
+    free (statement);
 }
@@ -40,6 +40,7 @@ typedef union DBCC_Statement DBCC_Statement;
 struct DBCC_Statement_Base
 {
   DBCC_StatementType type;
+  bool from_region;
   DBCC_CodePosition *code_position;
 };
 
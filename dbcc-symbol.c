@@ -1,15 +1,21 @@
 #include "dbcc.h"
 
-/* Resize if 
- *
- *        table size 
- *        ----------   < RESIZE_UPWARD_OCCUPANCY_RATE
- *         n symbols
- *
- * NOTE: NOT TESTED for OCCUPANCY_RATE==2 which is a
- * corner-case b/c table-size is a power-of-two.
+/* Double the number of buckets once there are more than
+ * this many symbols per bucket, on average.
  */
-#define RESIZE_UPWARD_OCCUPANCY_RATE      3
+#define MAX_SYMBOLS_PER_BUCKET            2
+
+#define FIRST_SEGMENT_SIZE  DBCC_SYMBOL_SPACE_FIRST_SEGMENT_SIZE
+#define FIRST_SEGMENT_LOG2  8
+
+/* The index starts with this many slots, and is replaced by one
+ * twice the size once there are more symbols than half its slots.
+ * A symbol goes in one of the INDEX_PROBES slots following its hash
+ * the first time a lookup has to find it on the list;  if those
+ * slots are taken it stays out of the index.
+ */
+#define INDEX_FIRST_SIZE    1024
+#define INDEX_PROBES        4
 
 /* Lookup3 - simplified version taken from 
  *    https://stackoverflow.com/questions/14409466/simple-hash-functions
@@ -84,16 +90,304 @@ uint32_t dbcc_symbol_hash_len (size_t len, const char *str)
   return lookup3(str, len, LOOKUP3_HASH_INITVAL);
 }
 
+static inline uint32_t
+reverse_bits_32 (uint32_t v)
+{
+  v = ((v >> 1) & 0x55555555) | ((v & 0x55555555) << 1);
+  v = ((v >> 2) & 0x33333333) | ((v & 0x33333333) << 2);
+  v = ((v >> 4) & 0x0f0f0f0f) | ((v & 0x0f0f0f0f) << 4);
+  v = ((v >> 8) & 0x00ff00ff) | ((v & 0x00ff00ff) << 8);
+  return (v >> 16) | (v << 16);
+}
+#define SYMBOL_ORDER_KEY(hash)   (((uint64_t) reverse_bits_32 (hash) << 1) | 1)
+#define MARKER_ORDER_KEY(bucket) ((uint64_t) reverse_bits_32 (bucket) << 1)
+#define IS_MARKER(link)          (((link)->order_key & 1) == 0)
+
+static inline unsigned
+floor_log2 (size_t v)
+{
+#if defined(__GNUC__)
+  return (sizeof (unsigned long long) * 8 - 1) - __builtin_clzll (v);
+#else
+  unsigned rv = 0;
+  while (v >>= 1)
+    rv++;
+  return rv;
+#endif
+}
+
+/* Find a bucket, allocating its segment if needed. */
+static DBCC_SymbolBucket *
+get_bucket (DBCC_SymbolSpace *ss, size_t bucket)
+{
+  unsigned seg;
+  size_t offset, seg_size;
+  if (bucket < FIRST_SEGMENT_SIZE)
+    {
+      seg = 0;
+      offset = bucket;
+      seg_size = FIRST_SEGMENT_SIZE;
+    }
+  else
+    {
+      seg = floor_log2 (bucket) - FIRST_SEGMENT_LOG2 + 1;
+      seg_size = (size_t) FIRST_SEGMENT_SIZE << (seg - 1);
+      offset = bucket - seg_size;
+    }
+  DBCC_SymbolBucket *segment = atomic_load_explicit (&ss->segments[seg],
+                                                     memory_order_acquire);
+  if (DSK_UNLIKELY (segment == NULL))
+    {
+      DBCC_SymbolBucket *expected = NULL;
+      DBCC_SymbolBucket *new_segment = calloc (seg_size, sizeof (DBCC_SymbolBucket));
+      if (atomic_compare_exchange_strong_explicit (&ss->segments[seg],
+                                                   &expected, new_segment,
+                                                   memory_order_acq_rel,
+                                                   memory_order_acquire))
+        segment = new_segment;
+      else
+        {
+          free (new_segment);
+          segment = expected;
+        }
+    }
+  return segment + offset;
+}
+
+static inline bool
+link_matches (DBCC_SymbolLink *at, size_t len, const char *str)
+{
+  if (IS_MARKER (at))
+    return true;
+  DBCC_Symbol *symbol = (DBCC_Symbol *) at;
+  return len == symbol->length
+      && memcmp (dbcc_symbol_get_string (symbol), str, len) == 0;
+}
+
+/* Search the list from '*start' (whose order_key must be <= key)
+ * for a node with this key and string.  If there is none and
+ * 'to_insert' is non-NULL, link it in and return it.
+ *
+ * Nodes are never unlinked, so after a failed compare-and-swap
+ * the search can resume from the last node passed.  For the same
+ * reason, a search that finds nothing leaves that node in '*start',
+ * where a following insert of the same key can begin.
+ */
+static DBCC_SymbolLink *
+list_find_or_insert (DBCC_SymbolLink **start,
+                     uint64_t          key,
+                     size_t            len,
+                     const char       *str,
+                     DBCC_SymbolLink  *to_insert)
+{
+  DBCC_SymbolLink *prev = *start;
+  for (;;)
+    {
+      DBCC_SymbolLink *at = atomic_load_explicit (&prev->next, memory_order_acquire);
+      while (at != NULL && at->order_key < key)
+        {
+          prev = at;
+          at = atomic_load_explicit (&at->next, memory_order_acquire);
+        }
+
+      /* Symbols whose hashes collide share a key;  check them all. */
+      DBCC_SymbolLink *last = prev;
+      while (at != NULL && at->order_key == key)
+        {
+          if (link_matches (at, len, str))
+            return at;
+          last = at;
+          at = atomic_load_explicit (&at->next, memory_order_acquire);
+        }
+      if (to_insert == NULL)
+        {
+          *start = prev;
+          return NULL;
+        }
+
+      atomic_store_explicit (&to_insert->next, at, memory_order_relaxed);
+      if (atomic_compare_exchange_strong_explicit (&last->next,
+                                                   &at, to_insert,
+                                                   memory_order_release,
+                                                   memory_order_relaxed))
+        return to_insert;
+    }
+}
+
+static DBCC_SymbolLink *get_bucket_marker (DBCC_SymbolSpace *ss, size_t bucket);
+
+/* Link a marker for a bucket that has none yet.  This is split from
+ * get_bucket_marker() so that the common case can be inlined.
+ */
+static DBCC_SymbolLink *
+init_bucket_marker (DBCC_SymbolSpace *ss, DBCC_SymbolBucket *b, size_t bucket)
+{
+  /* The parent bucket is the one this bucket split from:
+   * its marker precedes ours in the list. */
+  size_t parent = bucket & ~((size_t) 1 << floor_log2 (bucket));
+  DBCC_SymbolLink *parent_marker = get_bucket_marker (ss, parent);
+
+  bool claimed = false;
+  DBCC_SymbolLink *new_marker;
+  if (atomic_compare_exchange_strong (&b->inline_marker_claimed, &claimed, true))
+    new_marker = &b->inline_marker;
+  else
+    new_marker = DBCC_NEW (DBCC_SymbolLink);
+  atomic_init (&new_marker->next, NULL);
+  new_marker->order_key = MARKER_ORDER_KEY (bucket);
+
+  DBCC_SymbolLink *marker = list_find_or_insert (&parent_marker,
+                                                 new_marker->order_key,
+                                                 0, "", new_marker);
+  if (marker != new_marker && new_marker != &b->inline_marker)
+    free (new_marker);
+
+  /* Every thread that gets here stores the same marker. */
+  atomic_store_explicit (&b->marker, marker, memory_order_release);
+  return marker;
+}
+
+static inline DBCC_SymbolLink *
+get_bucket_marker (DBCC_SymbolSpace *ss, size_t bucket)
+{
+  DBCC_SymbolBucket *b = get_bucket (ss, bucket);
+  DBCC_SymbolLink *marker = atomic_load_explicit (&b->marker, memory_order_acquire);
+  if (DSK_LIKELY (marker != NULL))
+    return marker;
+  return init_bucket_marker (ss, b, bucket);
+}
+
+/* A slot's symbol is set (by compare-and-swap) before its hash,
+ * so a reader that sees the hash also sees the symbol.  Comparing
+ * the hash first means a probe only dereferences likely matches. */
+typedef struct IndexSlot IndexSlot;
+struct IndexSlot
+{
+  _Atomic(uint32_t) hash;
+  _Atomic(DBCC_Symbol *) symbol;
+};
+
+struct DBCC_SymbolIndex
+{
+  size_t mask;
+  DBCC_SymbolIndex *prev;               /* the one this replaced */
+  IndexSlot slots[];
+};
+
+static DBCC_SymbolIndex *
+index_new (size_t size, DBCC_SymbolIndex *prev)
+{
+  DBCC_SymbolIndex *index = calloc (1, sizeof (DBCC_SymbolIndex)
+                                       + size * sizeof (IndexSlot));
+  index->mask = size - 1;
+  index->prev = prev;
+  return index;
+}
+
+static inline DBCC_Symbol *
+index_lookup (DBCC_SymbolIndex *index, uint32_t h, size_t len, const char *str)
+{
+  for (unsigned i = 0; i < INDEX_PROBES; i++)
+    {
+      IndexSlot *slot = index->slots + ((h + i) & index->mask);
+      if (atomic_load_explicit (&slot->hash, memory_order_acquire) != h)
+        continue;
+      DBCC_Symbol *symbol = atomic_load_explicit (&slot->symbol, memory_order_relaxed);
+      if (symbol != NULL && link_matches (&symbol->link, len, str))
+        return symbol;
+    }
+  return NULL;
+}
+
+static void
+index_add (DBCC_SymbolIndex *index, uint32_t h, DBCC_Symbol *symbol)
+{
+  for (unsigned i = 0; i < INDEX_PROBES; i++)
+    {
+      IndexSlot *slot = index->slots + ((h + i) & index->mask);
+      DBCC_Symbol *expected = NULL;
+      if (atomic_compare_exchange_strong_explicit (&slot->symbol,
+                                                   &expected, symbol,
+                                                   memory_order_relaxed,
+                                                   memory_order_relaxed))
+        {
+          atomic_store_explicit (&slot->hash, h, memory_order_release);
+          return;
+        }
+      if (expected == symbol)
+        return;
+    }
+}
+
+/* Find a symbol, trying the index before the list.  If there is
+ * none, '*at_out' is where the list search stopped, for the insert.
+ */
+static DBCC_Symbol *
+space_lookup (DBCC_SymbolSpace *ss,
+              DBCC_SymbolIndex *index,
+              uint32_t          h,
+              size_t            len,
+              const char       *str,
+              DBCC_SymbolLink **at_out)
+{
+  DBCC_Symbol *symbol = index_lookup (index, h, len, str);
+  if (symbol != NULL)
+    return symbol;
+
+  size_t n_buckets = atomic_load_explicit (&ss->n_buckets, memory_order_relaxed);
+  *at_out = get_bucket_marker (ss, h & (n_buckets - 1));
+  symbol = (DBCC_Symbol *) list_find_or_insert (at_out, SYMBOL_ORDER_KEY (h),
+                                                len, str, NULL);
+  if (symbol != NULL)
+    index_add (index, h, symbol);
+  return symbol;
+}
+
 DBCC_SymbolSpace *
 dbcc_symbol_space_new(void)
 {
   DBCC_SymbolSpace *rv = malloc (sizeof (DBCC_SymbolSpace));
-  rv->ht_size_log2 = 8;
-  rv->ht = calloc (1 << rv->ht_size_log2, sizeof (DBCC_Symbol *));
-  rv->n_symbols = 0;
+  for (unsigned i = 0; i < DBCC_SYMBOL_SPACE_MAX_SEGMENTS; i++)
+    atomic_init (&rv->segments[i], NULL);
+  atomic_init (&rv->n_buckets, FIRST_SEGMENT_SIZE);
+  atomic_init (&rv->n_symbols, 0);
+  atomic_init (&rv->index, index_new (INDEX_FIRST_SIZE, NULL));
+
+  /* bucket 0's marker is the head of the list */
+  DBCC_SymbolBucket *b0 = get_bucket (rv, 0);
+  atomic_init (&b0->inline_marker_claimed, true);
+  atomic_init (&b0->inline_marker.next, NULL);
+  b0->inline_marker.order_key = MARKER_ORDER_KEY (0);
+  atomic_store_explicit (&b0->marker, &b0->inline_marker, memory_order_release);
   return rv;
 }
 
+void
+dbcc_symbol_space_destroy (DBCC_SymbolSpace *ns)
+{
+  /* Every symbol, and every marker not inline in its bucket,
+   * is on the list that bucket 0's marker heads. */
+  DBCC_SymbolLink *at = atomic_load (&get_bucket (ns, 0)->inline_marker.next);
+  while (at != NULL)
+    {
+      DBCC_SymbolLink *next = atomic_load (&at->next);
+      if (!IS_MARKER (at)
+       || at != &get_bucket (ns, reverse_bits_32 (at->order_key >> 1))->inline_marker)
+        free (at);
+      at = next;
+    }
+  for (unsigned i = 0; i < DBCC_SYMBOL_SPACE_MAX_SEGMENTS; i++)
+    free (atomic_load (&ns->segments[i]));
+  DBCC_SymbolIndex *index = atomic_load (&ns->index);
+  while (index != NULL)
+    {
+      DBCC_SymbolIndex *prev = index->prev;
+      free (index);
+      index = prev;
+    }
+  free (ns);
+}
+
 DBCC_Symbol *
 dbcc_symbol_space_force (DBCC_SymbolSpace *ns, const char *str)
 {
@@ -109,61 +403,62 @@ dbcc_symbol_space_try   (DBCC_SymbolSpace *ns, const char *str)
 DBCC_Symbol *
 dbcc_symbol_space_force_len (DBCC_SymbolSpace *ns, size_t len, const char *str)
 {
-  uint64_t h = dbcc_symbol_hash_len (len, str);
-  size_t bin = h & ((1<<ns->ht_size_log2) - 1);
-  for (DBCC_Symbol *at = ns->ht[bin]; at != NULL; at = at->hash_next)
-    if (strcmp (dbcc_symbol_get_string (at), str) == 0)
-      return at;
+  uint32_t h = dbcc_symbol_hash_len (len, str);
+  DBCC_SymbolIndex *index = atomic_load_explicit (&ns->index, memory_order_acquire);
+  DBCC_SymbolLink *at;
 
-  uint64_t min_ht_size = (uint64_t) ns->n_symbols * RESIZE_UPWARD_OCCUPANCY_RATE;
-  if ((1ULL << ns->ht_size_log2) < min_ht_size)
-    {
-      unsigned new_ht_size_log2 = ns->ht_size_log2 + 1;
-      while ((1ULL << new_ht_size_log2) < min_ht_size)
-        new_ht_size_log2++;
-      size_t new_ht_size = ((size_t) 1) << new_ht_size_log2;
-      DBCC_Symbol **new_ht = calloc (sizeof (DBCC_Symbol *), new_ht_size);
-      size_t old_ht_size = 1ULL << ns->ht_size_log2;
-      for (size_t i = 0; i < old_ht_size; i++)
-        {
-          DBCC_Symbol *at = ns->ht[i];
-          while (at != NULL)
-            {
-              size_t b = at->hash & (new_ht_size - 1);
-              DBCC_Symbol *next = at->hash_next;
-              at->hash_next = new_ht[b];
-              new_ht[b] = at;
-              at = next;
-            }
-        }
-      free (ns->ht);
-      ns->ht = new_ht;
-      ns->ht_size_log2 = new_ht_size_log2;
-
-      // sync bin with the new hash table size.
-      bin = h & ((1<<ns->ht_size_log2) - 1);
-    }
+  /* Look before allocating:  most calls find the symbol. */
+  DBCC_Symbol *found = space_lookup (ns, index, h, len, str, &at);
+  if (found != NULL)
+    return found;
 
   DBCC_Symbol *rv = malloc (sizeof (DBCC_Symbol) + len + 1);
+  rv->link.order_key = SYMBOL_ORDER_KEY (h);
   rv->hash = h;
   rv->length = len;
   rv->symbol_space = ns;
-  rv->hash_next = ns->ht[bin];
-  ns->ht[bin] = rv;
   memcpy ((char *) (rv + 1), str, len);
   ((char *) (rv + 1))[len] = '\0';
+  DBCC_SymbolLink *link = list_find_or_insert (&at, rv->link.order_key,
+                                               len, str, &rv->link);
+  if (link != &rv->link)
+    {
+      /* another thread added it first */
+      free (rv);
+      return (DBCC_Symbol *) link;
+    }
+
+  size_t n_symbols = atomic_fetch_add_explicit (&ns->n_symbols, 1,
+                                                memory_order_relaxed) + 1;
+  size_t n_buckets = atomic_load_explicit (&ns->n_buckets, memory_order_relaxed);
+  size_t max_buckets = (size_t) FIRST_SEGMENT_SIZE
+                    << (DBCC_SYMBOL_SPACE_MAX_SEGMENTS - 1);
+  if (n_symbols > n_buckets * MAX_SYMBOLS_PER_BUCKET
+   && n_buckets < max_buckets)
+    atomic_compare_exchange_strong_explicit (&ns->n_buckets,
+                                             &n_buckets, n_buckets * 2,
+                                             memory_order_relaxed,
+                                             memory_order_relaxed);
+
+  /* The new index starts empty:  it fills as symbols are looked up. */
+  if (n_symbols > (index->mask + 1) / 2)
+    {
+      DBCC_SymbolIndex *bigger = index_new ((index->mask + 1) * 2, index);
+      if (!atomic_compare_exchange_strong_explicit (&ns->index, &index, bigger,
+                                                    memory_order_release,
+                                                    memory_order_relaxed))
+        free (bigger);
+    }
   return rv;
 }
 
 DBCC_Symbol *
 dbcc_symbol_space_try_len   (DBCC_SymbolSpace *ns, size_t len, const char *str)
 {
-  uint64_t h = dbcc_symbol_hash_len (len, str);
-  size_t bin = h & ((1<<ns->ht_size_log2) - 1);
-  for (DBCC_Symbol *at = ns->ht[bin]; at != NULL; at = at->hash_next)
-    if (len == at->length && memcmp (dbcc_symbol_get_string (at), str, len) == 0)
-      return at;
-  return NULL;
+  uint32_t h = dbcc_symbol_hash_len (len, str);
+  DBCC_SymbolIndex *index = atomic_load_explicit (&ns->index, memory_order_acquire);
+  DBCC_SymbolLink *at;
+  return space_lookup (ns, index, h, len, str, &at);
 }
 
 #undef dbcc_symbol_ref
@@ -11,25 +11,76 @@
 
 typedef struct DBCC_Symbol DBCC_Symbol;
 typedef struct DBCC_SymbolSpace DBCC_SymbolSpace;
+typedef struct DBCC_SymbolLink DBCC_SymbolLink;
+typedef struct DBCC_SymbolBucket DBCC_SymbolBucket;
+typedef struct DBCC_SymbolIndex DBCC_SymbolIndex;
+
+/* A SymbolSpace may be shared by parsers running on different threads.
+ * Lookups and insertions are lock-free:  it is a split-ordered list
+ * (Shalev and Shavit, "Split-Ordered Lists: Lock-Free Extensible
+ * Hash Tables").  All symbols are on one linked list sorted by
+ * their bit-reversed hash, and each hash bucket has a marker node
+ * in that list.  Doubling the number of buckets never moves a
+ * symbol;  new buckets get their markers lazily.
+ * Symbols are never removed.
+ *
+ * Walking the list costs a cache miss per node, so lookups first
+ * try an index:  an open-addressed array of symbols found so far,
+ * filled with compare-and-swap.  The list stays the authority;
+ * a symbol missing from the index is just looked up the slow way.
+ */
+#define DBCC_SYMBOL_SPACE_FIRST_SEGMENT_SIZE  256
+#define DBCC_SYMBOL_SPACE_MAX_SEGMENTS        24
+
+struct DBCC_SymbolLink
+{
+  _Atomic(DBCC_SymbolLink *) next;
+
+  /* bit-reversed hash, shifted up one;  the low bit is set
+   * for symbols and clear for the bucket markers. */
+  uint64_t order_key;
+};
+
+struct DBCC_SymbolBucket
+{
+  _Atomic(DBCC_SymbolLink *) marker;    /* NULL until linked */
+
+  /* The first thread to set up the bucket links 'inline_marker',
+   * which shares a cache line with 'marker'.  Threads racing
+   * with it link a separately allocated marker;  the list
+   * keeps whichever lands first. */
+  _Atomic(bool) inline_marker_claimed;
+  DBCC_SymbolLink inline_marker;
+};
 
 struct DBCC_SymbolSpace
 {
-  unsigned ht_size_log2;
-  DBCC_Symbol **ht;
-  size_t n_symbols;
+  /* Bucket b lives in segment 0 if b < FIRST_SEGMENT_SIZE,
+   * otherwise in segment k, which holds the buckets in
+   * [FIRST_SEGMENT_SIZE << (k-1), FIRST_SEGMENT_SIZE << k). */
+  _Atomic(DBCC_SymbolBucket *) segments[DBCC_SYMBOL_SPACE_MAX_SEGMENTS];
+  _Atomic(size_t) n_buckets;
+  _Atomic(size_t) n_symbols;
+
+  /* Replaced by one twice the size as it fills;  the old ones
+   * are kept (threads may still be reading them) until destroy. */
+  _Atomic(DBCC_SymbolIndex *) index;
 };
 
 struct DBCC_Symbol
 {
+  DBCC_SymbolLink link;         /* must be first */
   uint64_t hash;
   size_t length;
   DBCC_SymbolSpace *symbol_space;
-  DBCC_Symbol *hash_next;
 
   /* NUL-terminated string follows immediately */
 };
 
 DBCC_SymbolSpace *dbcc_symbol_space_new (void);
+/* Frees the space and all its symbols;  no other thread
+ * may be using it. */
+void               dbcc_symbol_space_destroy   (DBCC_SymbolSpace *space);
 DBCC_Symbol       *dbcc_symbol_space_force     (DBCC_SymbolSpace *space,
                                                 const char *str);
 DBCC_Symbol       *dbcc_symbol_space_try       (DBCC_SymbolSpace *space,
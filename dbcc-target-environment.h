@@ -26,6 +26,12 @@ struct DBCC_TargetEnvironment
 
   uint8_t min_struct_alignof;
   uint8_t min_struct_sizeof;
+
+  // widest SIMD register in bytes, or 0 to never vectorize
+  uint8_t max_vector_size;
 };
 
+#define DBCC_TARGET_VECTOR_SIZE_SSE2    16
+#define DBCC_TARGET_VECTOR_SIZE_AVX2    32
+
 
@@ -70,17 +70,20 @@ dbcc_type_unref (DBCC_Type *type)
             {
               dbcc_type_unref (type->v_function.params[i].type);
             }
-          free (type->v_function.params);
+          if (!type->base.from_region)
+            free (type->v_function.params);
           break;
         case DBCC_TYPE_METATYPE_KR_FUNCTION:
           for (unsigned i = 0; i < type->v_function_kr.n_params; i++)
             dbcc_symbol_unref (type->v_function_kr.params[i]);
-          free (type->v_function_kr.params);
+          if (!type->base.from_region)
+            free (type->v_function_kr.params);
           break;
         }
       if (type->base.name != NULL)
         dbcc_symbol_unref (type->base.name);
-      free (type);
+      if (!type->base.from_region)
+        free (type);
     }
 }
 
@@ -279,8 +282,9 @@ dbcc_type_to_cstring (DBCC_Type *type)
 static inline DBCC_Type *
 new_type (DBCC_Type_Metatype t)
 {
-  DBCC_Type *rv = calloc (sizeof (DBCC_Type), 1);
+  DBCC_Type *rv = DBCC_NODE_NEW0 (DBCC_Type);
   rv->metatype = t;
+  rv->base.from_region = dbcc_node_allocs_from_region ();
   rv->base.ref_count = 1;
   return rv;
 }
@@ -323,9 +327,9 @@ dbcc_type_new_enum (DBCC_Namespace         *ns,
   DBCC_Type *t = NEW_TYPE(ENUM);
   t->v_enum.tag = optional_tag;
   t->v_enum.n_values = n_values;
-  t->v_enum.values = DBCC_NEW_ARRAY(n_values, DBCC_EnumValue);
+  t->v_enum.values = DBCC_NODE_NEW_ARRAY(n_values, DBCC_EnumValue);
   t->base.sizeof_instance = ns->target_env->sizeof_int;
-  t->v_enum.values_sorted_by_sym = malloc (sizeof (size_t) * n_values);
+  t->v_enum.values_sorted_by_sym = DBCC_NODE_NEW_ARRAY(n_values, size_t);
   for (size_t i = 0; i < n_values; i++)
     {
       t->v_enum.values[i] = values[i];
@@ -455,7 +459,7 @@ dbcc_type_new_function  (DBCC_Type          *rettype,
   if (n_params == 1 && params[0].name == NULL && params[0].type->metatype == DBCC_TYPE_METATYPE_VOID)
     n_params = 0;
   t->v_function.n_params = n_params;
-  t->v_function.params = DBCC_NEW_ARRAY(n_params, DBCC_TypeFunctionParam);
+  t->v_function.params = DBCC_NODE_NEW_ARRAY(n_params, DBCC_TypeFunctionParam);
   t->v_function.has_varargs = has_varargs;
   for (unsigned i = 0; i < n_params; i++)
     {
@@ -533,7 +537,7 @@ get_members_by_sym (size_t              n_members,
       return NULL;
     }
 
-  size_t *rv = DBCC_NEW_ARRAY(n_members, size_t);
+  size_t *rv = DBCC_NODE_NEW_ARRAY(n_members, size_t);
   for (size_t i = 0; i < n_members; i++)
     rv[i] = i;
 #define COMP_MIA(a,b, rv) { \
@@ -569,7 +573,7 @@ init_type_struct_members (DBCC_TargetEnvironment *env,
   size_t cur_offset = 0;
   size_t align = env->min_struct_alignof;
   t->v_struct.n_members = n_members;
-  t->v_struct.members = DBCC_NEW_ARRAY(n_members, DBCC_TypeStructMember);
+  t->v_struct.members = DBCC_NODE_NEW_ARRAY(n_members, DBCC_TypeStructMember);
   for (size_t i = 0; i < n_members; i++)
     {
       t->v_struct.members[i].name = members[i].name;
@@ -668,7 +672,7 @@ init_type_union_branches (DBCC_TargetEnvironment *env,
   size_t max_size = env->min_struct_sizeof;
   size_t align = env->min_struct_alignof;
   t->v_union.n_branches = n_members;
-  t->v_union.branches = DBCC_NEW_ARRAY(n_members, DBCC_TypeUnionBranch);
+  t->v_union.branches = DBCC_NODE_NEW_ARRAY(n_members, DBCC_TypeUnionBranch);
   for (size_t i = 0; i < n_members; i++)
     {
       t->v_union.branches[i].name = members[i].name;
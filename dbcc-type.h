@@ -41,6 +41,7 @@ const char * dbcc_type_metatype_name (DBCC_Type_Metatype metatype);
 struct DBCC_Type_Base
 {
   DBCC_Type_Metatype metatype;
+  bool from_region;
   DBCC_Symbol *name;
   char *private_cstring;
   size_t ref_count;
@@ -18,6 +18,7 @@ typedef struct DBCC_Constant DBCC_Constant;
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <string.h>
 #include "dsk/dsk.h"
@@ -32,6 +33,9 @@ typedef struct DBCC_Constant DBCC_Constant;
    ( ((offset) + (align) - 1) & (~(size_t)((align) - 1)) )
 #define DBCC_NEW_ARRAY(n, type)   ((type *)(malloc(sizeof(type) * (n))))
 #define DBCC_NEW(type)   ((type *)(malloc(sizeof(type))))
+/* Front-end nodes: from the current region if any (see dbcc-region.h) */
+#define DBCC_NODE_NEW0(type)   ((type *)(dbcc_node_alloc0(sizeof(type))))
+#define DBCC_NODE_NEW_ARRAY(n, type) ((type *)(dbcc_node_alloc(sizeof(type) * (n))))
 #define DBCC_MIN(a,b)    ((a) < (b) ? (a) : (b))
 #define DBCC_MAX(a,b)    ((a) > (b) ? (a) : (b))
 
@@ -142,13 +146,17 @@ struct DBCC_String
   // 1 (for utf-8), 2 (for utf-16), 4 (for utf-32)
   unsigned sizeof_elt;
 
+  // L"...":  the elements are wchar_t, whose signedness
+  // comes from the target;  char16_t and char32_t are unsigned.
+  bool is_wchar;
+
   void *str;
 };
 DBCC_INLINE void dbcc_string_clear (DBCC_String *clear)
 {
   if (clear->str)
     free (clear->str);
-  *clear = (DBCC_String){0, 1, NULL};
+  *clear = (DBCC_String){0, 1, false, NULL};
 }
 
 // for struct members, (formal) function parameters, union cases,
@@ -182,6 +190,7 @@ typedef enum
 struct DBCC_Constant
 {
   DBCC_ConstantType constant_type;
+  bool from_region;             /* also true of v_value.data */
   union {
     struct {
       void *data;
@@ -202,6 +211,7 @@ struct DBCC_Constant
     } v_offset;
   };
 };
+DBCC_Constant *dbcc_constant_alloc     (void);    /* uninitialized */
 DBCC_Constant *dbcc_constant_new_value (DBCC_Type *type,
                                         const void *optional_value);
 DBCC_Constant *dbcc_constant_new_value0(DBCC_Type *type);
@@ -211,11 +221,14 @@ void           dbcc_constant_free      (DBCC_Type *type,
                                         DBCC_Constant *to_free);
 
 
+#include "dbcc-region.h"
 #include "dbcc-type.h"
 #include "dbcc-expr.h"
 #include "dbcc-statement.h"
 #include "dbcc-namespace.h"
 #include "dbcc-common.h"
+#include "dbcc-ir.h"
+#include "dbcc-ast-file.h"
 #include "dbcc-parser.h"
 
 #endif
@@ -19,14 +19,23 @@
         daveb@ffem.org <Dave Benson>
 */
 
-/* Free blocks to hold around to avoid repeated mallocs... */
+#if defined(__linux__)
+#  define _GNU_SOURCE           /* for F_DUPFD_CLOEXEC and TCP_CORK */
+#endif
+
+/* Free blocks of the largest size to hold around (per thread)
+   to avoid repeated mallocs... */
 #define MAX_RECYCLED		16
 
-/* Size of allocations to make. */
+/* Size of the largest allocations to make. */
 #define BUF_CHUNK_SIZE		32768
 
-/* Max fragments in the iovector to writev. */
-#define MAX_FRAGMENTS_TO_WRITE	16
+/* Largest file-backed fragment:  each has its own mapping. */
+#define MAX_FILE_FRAGMENT_SIZE	(256*1024*1024)
+
+/* Max fragments in the iovector to one writev() (well under IOV_MAX):
+   the buffer may have more, they just take several calls. */
+#define MAX_FRAGMENTS_TO_WRITE	256
 
 /* This causes fragments not to be transferred from buffer to buffer,
  * and not to be allocated in pools.  The result is that stack-trace
@@ -40,8 +49,18 @@
 #include <alloca.h>
 #include <sys/types.h>
 #include <sys/uio.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <fcntl.h>
 #include <unistd.h>
+#if defined(__linux__)
+#  include <sys/sendfile.h>
+#  define HAVE_SENDFILE 1
+#endif
 #include <string.h>
+#include <limits.h>
 #include <stdio.h>      /* for vsnprintf() */
 #include <errno.h>
 #include "dsk.h"
@@ -63,31 +82,83 @@ dsk_buffer_fragment_end (DskBufferFragment *fragment)
   return fragment->buf + fragment->buf_start + fragment->buf_length;
 }
 
-/* --- DskBufferFragment recycling --- */
-#if !DSK_DEBUG_BUFFER_ALLOCATIONS
-static int num_recycled = 0;
-static DskBufferFragment* recycling_stack = 0;
+/* --- DskBufferFragment size classes and recycling ---
+ *
+ * Native fragments come in a few sizes, so that a buffer holding
+ * a short string doesn't pin down 32k, while a buffer that keeps
+ * growing moves up to the largest size after a couple of fragments.
+ *
+ * Each thread recycles fragments on its own per-class stacks,
+ * so allocation never takes a lock.  A fragment freed on another
+ * thread than the one that made it just joins the freeing thread's
+ * stacks.  A thread that exits should call
+ * _dsk_buffer_cleanup_recycling_bin() first, or its stacks leak.
+ */
+#define N_FRAGMENT_CLASSES      3
+static const unsigned fragment_class_sizes[N_FRAGMENT_CLASSES] = {
+  512, 4096, BUF_CHUNK_SIZE
+};
+#define FRAGMENT_CLASS_PAYLOAD(c) \
+  (fragment_class_sizes[c] - sizeof (DskBufferFragment))
+
+/* The smallest class that holds 'wanted' bytes, but at least one
+   class larger than the fragment the buffer is growing from. */
+static unsigned
+pick_fragment_class (size_t wanted, DskBufferFragment *prev)
+{
+  unsigned c = 0;
+  if (prev != NULL && !prev->is_foreign)
+    while (c < N_FRAGMENT_CLASSES - 1 && FRAGMENT_CLASS_PAYLOAD (c) <= prev->buf_max_size)
+      c++;
+  while (c < N_FRAGMENT_CLASSES - 1 && FRAGMENT_CLASS_PAYLOAD (c) < wanted)
+    c++;
+  return c;
+}
 
+#if !DSK_DEBUG_BUFFER_ALLOCATIONS
+typedef struct RecyclingStack RecyclingStack;
+struct RecyclingStack
+{
+  DskBufferFragment *top;
+  unsigned n;
+};
+
+/* Hold about the same number of bytes in each class. */
+static const unsigned fragment_class_max_recycled[N_FRAGMENT_CLASSES] = {
+  MAX_RECYCLED * 16, MAX_RECYCLED * 4, MAX_RECYCLED
+};
+static _Thread_local RecyclingStack recycling_stacks[N_FRAGMENT_CLASSES];
+
+static unsigned
+native_fragment_class (DskBufferFragment *fragment)
+{
+  unsigned c = 0;
+  while (FRAGMENT_CLASS_PAYLOAD (c) != fragment->buf_max_size)
+    c++;
+  return c;
+}
 #endif
 
 static DskBufferFragment *
-new_native_fragment()
+new_native_fragment (size_t wanted, DskBufferFragment *prev)
 {
   DskBufferFragment *fragment;
+  unsigned c = pick_fragment_class (wanted, prev);
 #if DSK_DEBUG_BUFFER_ALLOCATIONS
-  fragment = (DskBufferFragment *) dsk_malloc (BUF_CHUNK_SIZE);
-  fragment->buf_max_size = BUF_CHUNK_SIZE - sizeof (DskBufferFragment);
+  fragment = (DskBufferFragment *) dsk_malloc (fragment_class_sizes[c]);
+  fragment->buf_max_size = FRAGMENT_CLASS_PAYLOAD (c);
 #else  /* optimized (?) */
-  if (recycling_stack)
+  RecyclingStack *stack = recycling_stacks + c;
+  if (stack->top)
     {
-      fragment = recycling_stack;
-      recycling_stack = recycling_stack->next;
-      num_recycled--;
+      fragment = stack->top;
+      stack->top = fragment->next;
+      stack->n--;
     }
   else
     {
-      fragment = (DskBufferFragment *) dsk_malloc (BUF_CHUNK_SIZE);
-      fragment->buf_max_size = BUF_CHUNK_SIZE - sizeof (DskBufferFragment);
+      fragment = (DskBufferFragment *) dsk_malloc (fragment_class_sizes[c]);
+      fragment->buf_max_size = FRAGMENT_CLASS_PAYLOAD (c);
     }
 #endif	/* !DSK_DEBUG_BUFFER_ALLOCATIONS */
   fragment->buf_start = fragment->buf_length = 0;
@@ -116,6 +187,61 @@ new_foreign_fragment (unsigned             length,
   return fragment;
 }
 
+/* --- file-backed fragments ---
+ *
+ * A range of a file is appended as a foreign fragment over an mmap(2)
+ * of it, so everything that reads fragments works unchanged, but the
+ * pages are only faulted in if something actually looks at them.
+ * dsk_buffer_writev() recognizes these fragments and hands them
+ * to sendfile(2), which copies from the page cache straight
+ * to the destination.
+ */
+typedef struct _FileMapping FileMapping;
+struct _FileMapping
+{
+  int fd;                       /* our own dup() */
+  uint64_t map_offset;          /* file offset of 'map' */
+  void *map;
+  size_t map_size;
+};
+
+static void
+file_mapping_destroy (void *data)
+{
+  FileMapping *mapping = data;
+  munmap (mapping->map, mapping->map_size);
+  close (mapping->fd);
+  dsk_free (mapping);
+}
+
+static inline dsk_boolean
+fragment_is_file (const DskBufferFragment *fragment)
+{
+  return fragment->is_foreign && fragment->destroy == file_mapping_destroy;
+}
+
+#if HAVE_SENDFILE
+/* Returns -2 if sendfile() can't be used for this fd;  the caller
+   falls back to writev(), which works on the mapping. */
+static int
+fragment_sendfile (DskBufferFragment *fragment,
+                   int                fd,
+                   unsigned           max_bytes)
+{
+  FileMapping *mapping = fragment->destroy_data;
+  off_t offset = mapping->map_offset
+               + (fragment->buf - (uint8_t *) mapping->map)
+               + fragment->buf_start;
+  size_t length = fragment->buf_length;
+  if (length > max_bytes)
+    length = max_bytes;
+  ssize_t rv = sendfile (fd, mapping->fd, &offset, length);
+  if (rv < 0 && (errno == EINVAL || errno == ENOSYS))
+    return -2;
+  return rv;
+}
+#endif
+
 #if DSK_DEBUG_BUFFER_ALLOCATIONS
 #define recycle(fragment) do{ \
     if (fragment->is_foreign && fragment->destroy != NULL) \
@@ -133,16 +259,16 @@ recycle(DskBufferFragment* fragment)
       dsk_free (fragment);
       return;
     }
-#if defined(MAX_RECYCLED)
-  if (num_recycled >= MAX_RECYCLED)
+  unsigned c = native_fragment_class (fragment);
+  RecyclingStack *stack = recycling_stacks + c;
+  if (stack->n >= fragment_class_max_recycled[c])
     {
       dsk_free (fragment);
       return;
     }
-#endif
-  fragment->next = recycling_stack;
-  recycling_stack = fragment;
-  num_recycled++;
+  fragment->next = stack->top;
+  stack->top = fragment;
+  stack->n++;
 }
 #endif	/* !DSK_DEBUG_BUFFER_ALLOCATIONS */
 
@@ -150,21 +276,25 @@ recycle(DskBufferFragment* fragment)
 /**
  * _dsk_buffer_cleanup_recycling_bin:
  * 
- * Free unused buffer fragments.  (Normally some are
+ * Free the calling thread's unused buffer fragments.  (Normally some are
  * kept around to reduce strain on the global allocator.)
  */
 void
 _dsk_buffer_cleanup_recycling_bin ()
 {
 #if !DSK_DEBUG_BUFFER_ALLOCATIONS
-  while (recycling_stack != NULL)
+  for (unsigned c = 0; c < N_FRAGMENT_CLASSES; c++)
     {
-      DskBufferFragment *next;
-      next = recycling_stack->next;
-      dsk_free (recycling_stack);
-      recycling_stack = next;
+      RecyclingStack *stack = recycling_stacks + c;
+      while (stack->top != NULL)
+        {
+          DskBufferFragment *next;
+          next = stack->top->next;
+          dsk_free (stack->top);
+          stack->top = next;
+        }
+      stack->n = 0;
     }
-  num_recycled = 0;
 #endif
 }
       
@@ -222,7 +352,7 @@ dsk_buffer_append(DskBuffer    *buffer,
       unsigned avail;
       if (!buffer->last_frag)
 	{
-	  buffer->last_frag = buffer->first_frag = new_native_fragment ();
+	  buffer->last_frag = buffer->first_frag = new_native_fragment (length, NULL);
 	  avail = dsk_buffer_fragment_avail (buffer->last_frag);
 	}
       else
@@ -230,7 +360,7 @@ dsk_buffer_append(DskBuffer    *buffer,
 	  avail = dsk_buffer_fragment_avail (buffer->last_frag);
 	  if (avail <= 0)
 	    {
-	      buffer->last_frag->next = new_native_fragment ();
+	      buffer->last_frag->next = new_native_fragment (length, buffer->last_frag);
 	      avail = dsk_buffer_fragment_avail (buffer->last_frag);
 	      buffer->last_frag = buffer->last_frag->next;
 	    }
@@ -257,7 +387,7 @@ dsk_buffer_append_repeated_byte (DskBuffer    *buffer,
       unsigned avail;
       if (!buffer->last_frag)
 	{
-	  buffer->last_frag = buffer->first_frag = new_native_fragment ();
+	  buffer->last_frag = buffer->first_frag = new_native_fragment (count, NULL);
 	  avail = dsk_buffer_fragment_avail (buffer->last_frag);
 	}
       else
@@ -265,7 +395,7 @@ dsk_buffer_append_repeated_byte (DskBuffer    *buffer,
 	  avail = dsk_buffer_fragment_avail (buffer->last_frag);
 	  if (avail <= 0)
 	    {
-	      buffer->last_frag->next = new_native_fragment ();
+	      buffer->last_frag->next = new_native_fragment (count, buffer->last_frag);
 	      avail = dsk_buffer_fragment_avail (buffer->last_frag);
 	      buffer->last_frag = buffer->last_frag->next;
 	    }
@@ -594,32 +724,91 @@ int
 dsk_buffer_writev (DskBuffer       *read_from,
 		   int              fd)
 {
-  int rv;
-  struct iovec *iov;
-  int nfrag, i;
+  return dsk_buffer_writev_len (read_from, fd, UINT_MAX);
+}
+
+/* One writev(2) (or sendfile(2)) of up to 'max_bytes' from the start
+   of the buffer.  Sets *attempted_out to the number of bytes offered,
+   and *more_out if the batch stopped short of 'max_bytes' and the
+   end of the buffer (at a file fragment, or at MAX_FRAGMENTS_TO_WRITE). */
+static int
+write_one_batch (DskBuffer *read_from,
+                 int        fd,
+                 unsigned   max_bytes,
+                 unsigned  *attempted_out,
+                 dsk_boolean *more_out)
+{
+  struct iovec iov[MAX_FRAGMENTS_TO_WRITE];
   DskBufferFragment *frag_at = read_from->first_frag;
-  CHECK_INTEGRITY (read_from);
-  for (nfrag = 0; frag_at != NULL
-#ifdef MAX_FRAGMENTS_TO_WRITE
-       && nfrag < MAX_FRAGMENTS_TO_WRITE
+  unsigned bytes = max_bytes;
+  int n_iov = 0;
+#if HAVE_SENDFILE
+  if (fragment_is_file (frag_at))
+    {
+      int rv = fragment_sendfile (frag_at, fd, max_bytes);
+      if (rv != -2)
+        {
+          *attempted_out = DSK_MIN (max_bytes, frag_at->buf_length);
+          *more_out = frag_at->next != NULL && *attempted_out < max_bytes;
+          return rv;
+        }
+    }
+#endif
+  while (frag_at != NULL && bytes > 0 && n_iov < MAX_FRAGMENTS_TO_WRITE
+#if HAVE_SENDFILE
+         && (n_iov == 0 || !fragment_is_file (frag_at))
 #endif
-       ; nfrag++)
-    frag_at = frag_at->next;
-  iov = (struct iovec *) alloca (sizeof (struct iovec) * nfrag);
-  frag_at = read_from->first_frag;
-  for (i = 0; i < nfrag; i++)
+         )
     {
-      iov[i].iov_len = frag_at->buf_length;
-      iov[i].iov_base = dsk_buffer_fragment_start (frag_at);
+      unsigned frag_bytes = DSK_MIN (bytes, frag_at->buf_length);
+      iov[n_iov].iov_len = frag_bytes;
+      iov[n_iov].iov_base = dsk_buffer_fragment_start (frag_at);
+      n_iov++;
+      bytes -= frag_bytes;
       frag_at = frag_at->next;
     }
-  rv = writev (fd, iov, nfrag);
-  if (rv < 0 && (errno == EINTR || errno == EAGAIN))
-    return 0;
-  if (rv <= 0)
-    return rv;
-  dsk_buffer_discard (read_from, rv);
-  return rv;
+  *attempted_out = max_bytes - bytes;
+  *more_out = frag_at != NULL && bytes > 0;
+  return writev (fd, iov, n_iov);
+}
+
+/* TCP_CORK holds back partial packets while a write takes several
+   system calls, so that eg. headers and a sendfile()d body share
+   packets.  It fails harmlessly on anything but a TCP socket. */
+static inline dsk_boolean
+set_cork (int fd, int cork)
+{
+#if defined(TCP_CORK)
+  return setsockopt (fd, IPPROTO_TCP, TCP_CORK, &cork, sizeof (cork)) == 0;
+#else
+  (void) fd; (void) cork;
+  return DSK_FALSE;
+#endif
+}
+
+/* Whether writing up to 'max_bytes' takes more than one
+   write_one_batch(), if the fd takes all it is offered. */
+static dsk_boolean
+needs_several_batches (DskBuffer *buffer,
+                       unsigned   max_bytes)
+{
+  DskBufferFragment *prev = NULL;
+  DskBufferFragment *frag;
+  unsigned bytes = 0;
+  unsigned n = 0;
+  for (frag = buffer->first_frag; frag != NULL && bytes < max_bytes; frag = frag->next)
+    {
+      if (n == MAX_FRAGMENTS_TO_WRITE)
+        return DSK_TRUE;
+#if HAVE_SENDFILE
+      if (prev != NULL && (fragment_is_file (prev) || fragment_is_file (frag)))
+        return DSK_TRUE;
+#endif
+      bytes += frag->buf_length;
+      n++;
+      prev = frag;
+    }
+  return DSK_FALSE;
 }
 
 /**
@@ -633,6 +822,16 @@ dsk_buffer_writev (DskBuffer       *read_from,
  * function to deal with multiple fragments
  * efficiently, where available.
  *
+ * However many fragments the buffer has, batches of up to
+ * MAX_FRAGMENTS_TO_WRITE are written for as long as the
+ * kernel takes them whole;  a short write means the fd is
+ * full, so we stop there instead of trying again into EAGAIN.
+ * File-backed fragments (see dsk_buffer_append_file())
+ * are written by themselves, with sendfile(2).
+ * If that takes more than one call, a TCP socket is corked
+ * before the first, so that eg. headers in memory aren't sent
+ * as a packet of their own ahead of a sendfile()d body.
+ *
  * returns: the number of bytes transferred,
  * or -1 on a write error (consult errno).
  */
@@ -641,40 +840,38 @@ dsk_buffer_writev_len (DskBuffer *read_from,
 		       int        fd,
 		       unsigned      max_bytes)
 {
-  int rv;
-  struct iovec *iov;
-  int nfrag, i;
-  unsigned bytes;
-  DskBufferFragment *frag_at = read_from->first_frag;
+  unsigned total = 0;
+  dsk_boolean corked;
   CHECK_INTEGRITY (read_from);
-  for (nfrag = 0, bytes = 0; frag_at != NULL && bytes < max_bytes
-#ifdef MAX_FRAGMENTS_TO_WRITE
-       && nfrag < MAX_FRAGMENTS_TO_WRITE
-#endif
-       ; nfrag++)
-    {
-      bytes += frag_at->buf_length;
-      frag_at = frag_at->next;
-    }
-  iov = (struct iovec *) alloca (sizeof (struct iovec) * nfrag);
-  frag_at = read_from->first_frag;
-  for (bytes = max_bytes, i = 0; i < nfrag && bytes > 0; i++)
+  corked = needs_several_batches (read_from, max_bytes) && set_cork (fd, 1);
+  while (total < max_bytes && read_from->first_frag != NULL)
     {
-      unsigned frag_bytes = frag_at->buf_length;
-      if (frag_bytes > bytes)
-        frag_bytes = bytes;
-      iov[i].iov_len = frag_bytes;
-      iov[i].iov_base = dsk_buffer_fragment_start (frag_at);
-      frag_at = frag_at->next;
-      bytes -= frag_bytes;
+      unsigned attempted;
+      dsk_boolean more;
+      int rv = write_one_batch (read_from, fd, max_bytes - total,
+                                &attempted, &more);
+      if (rv < 0)
+        {
+          if (errno == EINTR || errno == EAGAIN || total > 0)
+            break;              /* report the error next time */
+          if (corked)
+            {
+              int e = errno;
+              set_cork (fd, 0);
+              errno = e;
+            }
+          return -1;
+        }
+      if (rv == 0)
+        break;
+      dsk_buffer_discard (read_from, rv);
+      total += rv;
+      if ((unsigned) rv < attempted || !more)
+        break;
     }
-  rv = writev (fd, iov, i);
-  if (rv < 0 && (errno == EINTR || errno == EAGAIN))
-    return 0;
-  if (rv <= 0)
-    return rv;
-  dsk_buffer_discard (read_from, rv);
-  return rv;
+  if (corked)
+    set_cork (fd, 0);
+  return total;
 }
 
 dsk_boolean
@@ -752,6 +949,126 @@ dsk_buffer_reset(DskBuffer *to_destroy)
 }
 
 
+/* --- searching ---
+ *
+ * Multi-byte searches find candidates a fragment at a time and
+ * then check them with fragment_has_bytes_at(), which follows
+ * a match across fragment boundaries.  With SSE2, candidates for
+ * a string are positions where both its first and last bytes match,
+ * 16 positions per step, so few are checked by hand;  elsewhere,
+ * memchr() finds the first byte.
+ */
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#  define HAVE_SSE2 1
+#endif
+
+/* Whether 'bytes' is at 'offset' in 'fragment',
+   perhaps continuing into the following fragments. */
+static dsk_boolean
+fragment_has_bytes_at (const DskBufferFragment *fragment,
+                       unsigned                 offset,
+                       const uint8_t           *bytes,
+                       size_t                   length)
+{
+  while (length > 0)
+    {
+      size_t test_len = fragment->buf_length - offset;
+      if (test_len > length)
+        test_len = length;
+      if (memcmp (bytes, fragment->buf + fragment->buf_start + offset, test_len) != 0)
+        return DSK_FALSE;
+      bytes += test_len;
+      length -= test_len;
+      if (length == 0)
+        return DSK_TRUE;
+      fragment = fragment->next;
+      if (fragment == NULL)
+        return DSK_FALSE;
+      offset = 0;
+    }
+  return DSK_TRUE;
+}
+
+/* The offset of the first match of 'bytes' starting in 'fragment', or -1. */
+static int
+fragment_find_bytes (const DskBufferFragment *fragment,
+                     const uint8_t           *bytes,
+                     size_t                   length)
+{
+  const uint8_t *start = fragment->buf + fragment->buf_start;
+  size_t n = fragment->buf_length;
+  size_t i = 0;
+#if HAVE_SSE2
+  if (length >= 2)
+    {
+      __m128i first = _mm_set1_epi8 ((char) bytes[0]);
+      __m128i last = _mm_set1_epi8 ((char) bytes[length - 1]);
+      for (; i + length - 1 + 16 <= n; i += 16)
+        {
+          __m128i a = _mm_loadu_si128 ((const __m128i *) (start + i));
+          __m128i b = _mm_loadu_si128 ((const __m128i *) (start + i + length - 1));
+          unsigned mask = _mm_movemask_epi8 (_mm_and_si128 (_mm_cmpeq_epi8 (a, first),
+                                                            _mm_cmpeq_epi8 (b, last)));
+          while (mask != 0)
+            {
+              unsigned bit = __builtin_ctz (mask);
+              if (memcmp (start + i + bit + 1, bytes + 1, length - 2) == 0)
+                return i + bit;
+              mask &= mask - 1;
+            }
+        }
+    }
+#endif
+  while (i < n)
+    {
+      const uint8_t *at = memchr (start + i, bytes[0], n - i);
+      if (at == NULL)
+        return -1;
+      i = at - start;
+      if (fragment_has_bytes_at (fragment, i, bytes, length))
+        return i;
+      i++;
+    }
+  return -1;
+}
+
+/* The first byte in [at, end) that is in 'map' (a 256-bit set),
+   or NULL.  'chars' lists the set, if it has at most 4 members. */
+static const uint8_t *
+find_first_of (const uint8_t *at,
+               const uint8_t *end,
+               const uint8_t *map,
+               const uint8_t *chars,
+               unsigned       n_chars)
+{
+  if (n_chars == 1)
+    return memchr (at, chars[0], end - at);
+#if HAVE_SSE2
+  if (n_chars <= 4)
+    {
+      __m128i c[4];
+      for (unsigned k = 0; k < 4; k++)
+        c[k] = _mm_set1_epi8 ((char) chars[k < n_chars ? k : 0]);
+      for (; end - at >= 16; at += 16)
+        {
+          __m128i v = _mm_loadu_si128 ((const __m128i *) at);
+          __m128i eq = _mm_or_si128 (_mm_or_si128 (_mm_cmpeq_epi8 (v, c[0]),
+                                                   _mm_cmpeq_epi8 (v, c[1])),
+                                     _mm_or_si128 (_mm_cmpeq_epi8 (v, c[2]),
+                                                   _mm_cmpeq_epi8 (v, c[3])));
+          unsigned mask = _mm_movemask_epi8 (eq);
+          if (mask != 0)
+            return at + __builtin_ctz (mask);
+        }
+    }
+#endif
+  for (; at < end; at++)
+    if (map[*at / 8] & (1 << (*at % 8)))
+      return at;
+  return NULL;
+}
+
 /**
  * dsk_buffer_index_of:
  * @buffer: buffer to scan.
@@ -793,55 +1110,17 @@ int
 dsk_buffer_str_index_of (DskBuffer *buffer,
                          const char *str_to_find)
 {
-  DskBufferFragment *fragment = buffer->first_frag;
+  size_t length = strlen (str_to_find);
+  DskBufferFragment *fragment;
   unsigned rv = 0;
+  if (length == 0)
+    return 0;
   for (fragment = buffer->first_frag; fragment; fragment = fragment->next)
     {
-      const uint8_t *frag_at = fragment->buf + fragment->buf_start;
-      unsigned frag_rem = fragment->buf_length;
-      while (frag_rem > 0)
-        {
-          DskBufferFragment *subfrag;
-          const uint8_t *subfrag_at;
-          unsigned subfrag_rem;
-          const char *str_at;
-          if (*frag_at != str_to_find[0])
-            {
-              frag_at++;
-              frag_rem--;
-              rv++;
-              continue;
-            }
-          subfrag = fragment;
-          subfrag_at = frag_at + 1;
-          subfrag_rem = frag_rem - 1;
-          str_at = str_to_find + 1;
-          if (*str_at == '\0')
-            return rv;
-          while (subfrag != NULL)
-            {
-              while (subfrag_rem == 0)
-                {
-                  subfrag = subfrag->next;
-                  if (subfrag == NULL)
-                    goto bad_guess;
-                  subfrag_at = subfrag->buf + subfrag->buf_start;
-                  subfrag_rem = subfrag->buf_length;
-                }
-              while (*str_at != '\0' && subfrag_rem != 0)
-                {
-                  if (*str_at++ != *subfrag_at++)
-                    goto bad_guess;
-                  subfrag_rem--;
-                }
-              if (*str_at == '\0')
-                return rv;
-            }
-bad_guess:
-          frag_at++;
-          frag_rem--;
-          rv++;
-        }
+      int at = fragment_find_bytes (fragment, (const uint8_t *) str_to_find, length);
+      if (at >= 0)
+        return rv + at;
+      rv += fragment->buf_length;
     }
   return -1;
 }
@@ -1036,70 +1315,123 @@ void dsk_buffer_append_foreign (DskBuffer        *buffer,
   CHECK_INTEGRITY (buffer);
 }
 
-/* --- dsk_buffer_polystr_index_of implementation --- */
-/* Test to see if a sequence of buffer fragments
- * starts with a particular NUL-terminated string.
+/**
+ * dsk_buffer_append_file:
+ * @buffer: the buffer to append into.
+ * @fd: the file to read from.  It is not closed, or moved.
+ * @offset: the position in the file of the data.
+ * @length: the number of bytes to append.
+ * @error: where to put an error, if the file can't be mapped.
+ *
+ * Appends a range of a regular file to the buffer without reading it.
+ * When the buffer is written to a file-descriptor with dsk_buffer_writev(),
+ * the range is sent with sendfile(2), so the data is never copied
+ * into user space.  The file must not shrink while the data is in
+ * the buffer.
+ *
+ * returns: whether the data was appended.  On failure,
+ * the buffer is left as it was.
  */
-static dsk_boolean
-fragment_n_str(DskBufferFragment   *fragment,
-               unsigned                frag_index,
-               const char          *string)
+dsk_boolean
+dsk_buffer_append_file         (DskBuffer    *buffer,
+                                int           fd,
+                                uint64_t      offset,
+                                uint64_t      length,
+                                DskError    **error)
 {
-  unsigned length = strlen (string);
-  for (;;)
+  size_t page_size = sysconf (_SC_PAGESIZE);
+  DskBufferFragment *old_last = buffer->last_frag;
+  unsigned old_size = buffer->size;
+  if (length > UINT_MAX - buffer->size)
     {
-      unsigned test_len = fragment->buf_length - frag_index;
-      if (test_len > length)
-        test_len = length;
-
-      if (memcmp (string,
-                  dsk_buffer_fragment_start (fragment) + frag_index,
-                  test_len) != 0)
-        return DSK_FALSE;
-
-      length -= test_len;
-      string += test_len;
-
-      if (length <= 0)
-        return DSK_TRUE;
-      frag_index += test_len;
-      if (frag_index >= fragment->buf_length)
+      dsk_set_error (error, "appending %llu bytes of file would overflow buffer",
+                     (unsigned long long) length);
+      return DSK_FALSE;
+    }
+  while (length > 0)
+    {
+      unsigned frag_length = length < MAX_FILE_FRAGMENT_SIZE ? length : MAX_FILE_FRAGMENT_SIZE;
+      uint64_t map_offset = offset - offset % page_size;
+      size_t map_size = frag_length + (offset - map_offset);
+      void *map = mmap (NULL, map_size, PROT_READ, MAP_SHARED, fd, map_offset);
+      if (map == MAP_FAILED)
         {
-          fragment = fragment->next;
-          if (fragment == NULL)
-            return DSK_FALSE;
+          dsk_set_error (error, "error mapping file (fd %d): %s",
+                         fd, strerror (errno));
+          goto failed;
         }
+#if defined(F_DUPFD_CLOEXEC)
+      int dup_fd = fcntl (fd, F_DUPFD_CLOEXEC, 0);
+#else
+      int dup_fd = dup (fd);
+      if (dup_fd >= 0)
+        fcntl (dup_fd, F_SETFD, FD_CLOEXEC);
+#endif
+      if (dup_fd < 0)
+        {
+          dsk_set_error (error, "error duplicating fd %d: %s",
+                         fd, strerror (errno));
+          munmap (map, map_size);
+          goto failed;
+        }
+      FileMapping *mapping = DSK_NEW (FileMapping);
+      mapping->fd = dup_fd;
+      mapping->map_offset = map_offset;
+      mapping->map = map;
+      mapping->map_size = map_size;
+      dsk_buffer_append_foreign (buffer, frag_length,
+                                 (uint8_t *) map + (offset - map_offset),
+                                 file_mapping_destroy, mapping);
+      offset += frag_length;
+      length -= frag_length;
     }
+  return DSK_TRUE;
+
+failed:
+  /* remove the fragments this call appended */
+  {
+    DskBufferFragment *at = old_last ? old_last->next : buffer->first_frag;
+    while (at)
+      {
+        DskBufferFragment *next = at->next;
+        recycle (at);
+        at = next;
+      }
+  }
+  if (old_last)
+    old_last->next = NULL;
+  else
+    buffer->first_frag = NULL;
+  buffer->last_frag = old_last;
+  buffer->size = old_size;
+  CHECK_INTEGRITY (buffer);
+  return DSK_FALSE;
 }
 
-/**
- * dsk_buffer_polystr_index_of:
- * @buffer: buffer to scan.
- * @strings: NULL-terminated set of string.
- *
- * Scans for the first instance of any of the strings
- * in the buffer.
- *
- * returns: the index of that instance, or -1 if not found.
- */
+/* --- dsk_buffer_polystr_index_of implementation --- */
 int     
 dsk_buffer_polystr_index_of    (DskBuffer    *buffer,
                                 char        **strings)
 {
-  uint8_t init_char_map[16];
-  int num_strings;
-  int num_bits = 0;
+  uint8_t init_char_map[32];
+  uint8_t init_chars[4];
+  unsigned num_bits = 0;
   int total_index = 0;
   DskBufferFragment *fragment;
+  char **test;
   memset (init_char_map, 0, sizeof (init_char_map));
-  for (num_strings = 0; strings[num_strings] != NULL; num_strings++)
+  for (test = strings; *test != NULL; test++)
     {
-      uint8_t c = strings[num_strings][0];
+      uint8_t c = (*test)[0];
       uint8_t mask = (1 << (c % 8));
       uint8_t *rack = init_char_map + (c / 8);
+      if (c == 0)
+        return 0;               /* the empty string matches at once */
       if ((*rack & mask) == 0)
         {
           *rack |= mask;
+          if (num_bits < DSK_N_ELEMENTS (init_chars))
+            init_chars[num_bits] = c;
           num_bits++;
         }
     }
@@ -1107,49 +1439,18 @@ dsk_buffer_polystr_index_of    (DskBuffer    *buffer,
     return 0;
   for (fragment = buffer->first_frag; fragment != NULL; fragment = fragment->next)
     {
-      const uint8_t *frag_start;
-      const uint8_t *at;
-      int remaining = fragment->buf_length;
-      frag_start = dsk_buffer_fragment_start (fragment);
-      at = frag_start;
-      while (at != NULL)
+      const uint8_t *frag_start = dsk_buffer_fragment_start (fragment);
+      const uint8_t *frag_end = frag_start + fragment->buf_length;
+      const uint8_t *at = frag_start;
+      while ((at = find_first_of (at, frag_end, init_char_map,
+                                  init_chars, num_bits)) != NULL)
         {
-          const uint8_t *start = at;
-          if (num_bits == 1)
-            {
-              at = memchr (start, strings[0][0], remaining);
-              if (at == NULL)
-                remaining = 0;
-              else
-                remaining -= (at - start);
-            }
-          else
-            {
-              while (remaining > 0)
-                {
-                  uint8_t i = (uint8_t) (*at);
-                  if (init_char_map[i / 8] & (1 << (i % 8)))
-                    break;
-                  remaining--;
-                  at++;
-                }
-              if (remaining == 0)
-                at = NULL;
-            }
-
-          if (at == NULL)
-            break;
-
           /* Now test each of the strings manually. */
-          {
-            char **test;
-            for (test = strings; *test != NULL; test++)
-              {
-                if (fragment_n_str(fragment, at - frag_start, *test))
-                  return total_index + (at - frag_start);
-              }
-            at++;
-          }
+          for (test = strings; *test != NULL; test++)
+            if (fragment_has_bytes_at (fragment, at - frag_start,
+                                       (const uint8_t *) *test, strlen (*test)))
+              return total_index + (at - frag_start);
+          at++;
         }
       total_index += fragment->buf_length;
     }
@@ -1181,7 +1482,7 @@ void     dsk_buffer_vprintf             (DskBuffer    *buffer,
     }
   if (rem == 0)
     {
-      frag = new_native_fragment ();
+      frag = new_native_fragment (strlen (format), buffer->last_frag);
       rem = dsk_buffer_fragment_avail (frag);
       at = dsk_buffer_fragment_end (frag);
     }
@@ -1580,7 +1881,7 @@ dsk_boolean dsk_buffer_fragment_advance (DskBufferFragment **frag_inout,
 void
 dsk_buffer_append_empty_fragment (DskBuffer *buffer)
 {
-  DskBufferFragment *fragment = new_native_fragment ();
+  DskBufferFragment *fragment = new_native_fragment (BUF_CHUNK_SIZE, NULL);
   if (buffer->last_frag)
     buffer->last_frag->next = fragment;
   else
@@ -1607,7 +1908,7 @@ void     dsk_buffer_append_placeholder  (DskBuffer    *buffer,
       unsigned avail;
       if (!buffer->last_frag)
 	{
-	  buffer->last_frag = buffer->first_frag = new_native_fragment ();
+	  buffer->last_frag = buffer->first_frag = new_native_fragment (length, NULL);
 	  avail = dsk_buffer_fragment_avail (buffer->last_frag);
 	}
       else
@@ -1615,7 +1916,7 @@ void     dsk_buffer_append_placeholder  (DskBuffer    *buffer,
 	  avail = dsk_buffer_fragment_avail (buffer->last_frag);
 	  if (avail <= 0)
 	    {
-	      buffer->last_frag->next = new_native_fragment ();
+	      buffer->last_frag->next = new_native_fragment (length, buffer->last_frag);
 	      avail = dsk_buffer_fragment_avail (buffer->last_frag);
 	      buffer->last_frag = buffer->last_frag->next;
 	    }
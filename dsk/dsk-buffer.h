@@ -80,6 +80,14 @@ void     dsk_buffer_append_foreign      (DskBuffer    *buffer,
 					 DskDestroyNotify destroy,
 					 void         *destroy_data);
 
+/* Append a range of a regular file, without reading it:
+   writing the buffer sends it with sendfile(2) where available. */
+dsk_boolean dsk_buffer_append_file      (DskBuffer    *buffer,
+                                         int           fd,
+                                         uint64_t      offset,
+                                         uint64_t      length,
+                                         DskError    **error);
+
 void     dsk_buffer_printf              (DskBuffer    *buffer,
 					 const char   *format,
 					 ...) DSK_GNUC_PRINTF(2,3);
@@ -150,7 +158,8 @@ DskBufferFragment *dsk_buffer_find_fragment (DskBuffer   *buffer,
                                              unsigned     offset,
                                              unsigned    *frag_offset_out);
 
-/* Free all unused buffer fragments. */
+/* Free the calling thread's unused buffer fragments;
+   threads should call this before exiting. */
 void     _dsk_buffer_cleanup_recycling_bin ();
 
 typedef enum {
@@ -170,6 +179,8 @@ dsk_boolean dsk_buffer_dump (DskBuffer          *buffer,
 
 /* misc */
 int dsk_buffer_index_of(DskBuffer *buffer, char char_to_find);
+int dsk_buffer_str_index_of (DskBuffer *buffer, const char *str_to_find);
+int dsk_buffer_polystr_index_of (DskBuffer *buffer, char **strings);
 
 unsigned dsk_buffer_fragment_peek (DskBufferFragment *fragment,
                                    unsigned           offset,
@@ -2,7 +2,6 @@
    not sure that "SOCKETs" are allocated nicely like
    file-descriptors are */
 /* TODO:
- *  * epoll() implementation
  *  * kqueue() implementation
  *  * windows port (yeah, right, volunteers are DEFINITELY needed for this one...)
  */
@@ -12,13 +11,16 @@
 
 /* This causes snprintf() to be undefined on Mac OS/X,
  * so don't define POSIX_C_SOURCE on OS/X */
-#ifndef __APPLE__
+#if defined(__linux__)
+#  define _GNU_SOURCE           /* for syscall(), used with io_uring */
+#elif !defined(__APPLE__)
 #  define _POSIX_C_SOURCE  1
 #endif
 
 #include <assert.h>
 #include <alloca.h>
 #include <sys/time.h>
+#include <time.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <unistd.h>
@@ -48,6 +50,44 @@
 #define DEBUG_DISPATCH_INTERNALS  0
 #define DEBUG_DISPATCH            0
 
+/* How often to check the time-of-day against the monotonic clock;
+   see "The clock" below. */
+#define WALL_CLOCK_SYNC_USECS     1000000
+
+/* Timing wheel geometry;  see "Timers" below. */
+#define TIMER_WHEEL_BITS          6
+#define TIMER_WHEEL_MASK          ((1 << TIMER_WHEEL_BITS) - 1)
+#define TIMER_WHEEL_LEVELS        7
+
+/* Use io_uring(7) instead of poll(2) in dsk_dispatch_run(),
+   if the running kernel allows it. */
+#ifndef DSK_USE_IO_URING
+# ifdef __linux__
+#  define DSK_USE_IO_URING        1
+# else
+#  define DSK_USE_IO_URING        0
+# endif
+#endif
+#if DSK_USE_IO_URING
+# include <stdint.h>
+# include <sys/mman.h>
+# include <sys/syscall.h>
+# include <linux/io_uring.h>
+#endif
+
+/* Where io_uring isn't allowed, use epoll(7), edge-triggered,
+   instead of poll(2). */
+#ifndef DSK_USE_EPOLL
+# ifdef __linux__
+#  define DSK_USE_EPOLL           1
+# else
+#  define DSK_USE_EPOLL           0
+# endif
+#endif
+#if DSK_USE_EPOLL
+# include <sys/epoll.h>
+#endif
+
 #ifndef HAVE_SMALL_FDS
 # define HAVE_SMALL_FDS           1
 #endif
@@ -65,6 +105,13 @@ struct _FDMap
   int notify_desired_index;     /* -1 if not an known fd */
   int change_index;             /* -1 if no prior change */
   int closed_since_notify_started;
+#if DSK_USE_IO_URING
+  int uring_armed_events;       /* -1 if no poll is in flight */
+  unsigned uring_generation;
+#endif
+#if DSK_USE_EPOLL
+  int epoll_batch_index;        /* -1 unless in epoll_notifies */
+#endif
 };
 
 #if !HAVE_SMALL_FDS
@@ -79,6 +126,12 @@ struct _FDMapNode
 #endif
 
 
+#if DSK_USE_IO_URING
+typedef struct _Uring Uring;
+static Uring *uring_new  (void);
+static void   uring_free (Uring *u);
+#endif
+
 typedef struct _RealDispatch RealDispatch;
 struct _RealDispatch
 {
@@ -94,17 +147,29 @@ struct _RealDispatch
 #endif
   dsk_boolean dispatching;
 
-  DskDispatchTimer *timer_tree;
+  DskDispatchTimer *timer_wheel[TIMER_WHEEL_LEVELS][TIMER_WHEEL_MASK + 1];
+  uint64_t timer_wheel_occupied[TIMER_WHEEL_LEVELS];    /* slot bitmaps */
+  uint64_t timer_tick;          /* milliseconds:  where the wheel is */
+  size_t n_timers;
+  uint64_t first_expire_usecs;  /* if base.has_timeout */
+
+  /* see "The clock" */
+  int64_t wall_offset_usecs;    /* time-of-day minus monotonic time */
+  uint64_t next_wall_sync_usecs;
   DskDispatchTimer *recycled_timeouts;
 
   DskDispatchSignal *signal_tree;
   int signal_pipe_fds[2];
 
-#if DSK_HAS_EPOLL
-  int epoll_fd;
+#if DSK_USE_EPOLL
+  int epoll_fd;                 /* -1 unless epoll(7) is used */
   unsigned max_epoll_events;
   struct epoll_event *epoll_events;
-  DskFileDescriptorNotify *epoll_dsk_events;
+  size_t n_epoll_notifies, epoll_notifies_alloced;
+  DskFileDescriptorNotify *epoll_notifies;      /* the last batch */
+#endif
+#if DSK_USE_IO_URING
+  Uring *uring;                 /* NULL to use poll(2) */
 #endif
 
   DskDispatchChild *child_tree;
@@ -119,13 +184,13 @@ struct _DskDispatchTimer
 {
   RealDispatch *dispatch;
 
-  /* the actual timeout time */
-  unsigned long timeout_secs;
-  unsigned timeout_usecs;
+  /* the actual timeout time, on the monotonic clock */
+  uint64_t expire_usecs;
 
-  /* red-black tree stuff */
-  DskDispatchTimer *left, *right, *parent;
-  unsigned is_red : 1;
+  /* timing wheel slot list (or expired / recycled list) */
+  DskDispatchTimer *prev, *next;
+  unsigned level : 3;
+  unsigned slot : TIMER_WHEEL_BITS;
   unsigned expired : 1;
 
   /* user callback */
@@ -173,21 +238,6 @@ struct _DskDispatchChild
 static DskDispatch *global_signal_dispatch;
 static int          global_signal_dispatch_fd;
 
-/* Define the tree of timers, as per dsk-rbtree-macros.h */
-#define TIMERS_COMPARE(a,b, rv) \
-  if (a->timeout_secs < b->timeout_secs) rv = -1; \
-  else if (a->timeout_secs > b->timeout_secs) rv = 1; \
-  else if (a->timeout_usecs < b->timeout_usecs) rv = -1; \
-  else if (a->timeout_usecs > b->timeout_usecs) rv = 1; \
-  else if (a < b) rv = -1; \
-  else if (a > b) rv = 1; \
-  else rv = 0;
-#define GET_TIMER_TREE(d) \
-  (d)->timer_tree, DskDispatchTimer *, \
-  DSK_STD_GET_IS_RED, DSK_STD_SET_IS_RED, \
-  parent, left, right, \
-  TIMERS_COMPARE
-
 #if !HAVE_SMALL_FDS
 #define FD_MAP_NODES_COMPARE(a,b, rv) \
   if (a->fd < b->fd) rv = -1; \
@@ -230,11 +280,51 @@ static int          global_signal_dispatch_fd;
   parent, left, right, \
   COMPARE_PROCESSES
 
+/* --- The clock ---
+ *
+ * Timers run on the monotonic clock, so that setting the time-of-day
+ * doesn't make them fire early or late.  Each iteration reads the
+ * monotonic clock once, and derives the cached time-of-day from it,
+ * checking the offset between the two with gettimeofday(2) only
+ * every WALL_CLOCK_SYNC_USECS.
+ */
+static inline uint64_t
+read_monotonic_usecs (void)
+{
+#if defined(CLOCK_MONOTONIC)
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+  struct timeval tv;
+  gettimeofday (&tv, NULL);
+  return (uint64_t) tv.tv_sec * 1000000 + tv.tv_usec;
+#endif
+}
+
+static void
+update_clock (RealDispatch *d)
+{
+  uint64_t now = read_monotonic_usecs ();
+  uint64_t wall;
+  if (now >= d->next_wall_sync_usecs)
+    {
+      struct timeval tv;
+      gettimeofday (&tv, NULL);
+      d->wall_offset_usecs = (int64_t) tv.tv_sec * 1000000 + tv.tv_usec
+                           - (int64_t) now;
+      d->next_wall_sync_usecs = now + WALL_CLOCK_SYNC_USECS;
+    }
+  wall = now + d->wall_offset_usecs;
+  d->base.last_dispatch_monotonic_usecs = now;
+  d->base.last_dispatch_secs = wall / 1000000;
+  d->base.last_dispatch_usecs = wall % 1000000;
+}
+
 /* Create or destroy a Dispatch */
 DskDispatch *dsk_dispatch_new (void)
 {
   RealDispatch *rv = DSK_NEW (RealDispatch);
-  struct timeval tv;
   rv->base.n_changes = 0;
   rv->notifies_desired_alloced = 8;
   rv->base.notifies_desired = DSK_NEW_ARRAY (rv->notifies_desired_alloced, DskFileDescriptorNotify);
@@ -249,7 +339,9 @@ DskDispatch *dsk_dispatch_new (void)
 #else
   rv->fd_map_tree = NULL;
 #endif
-  rv->timer_tree = NULL;
+  memset (rv->timer_wheel, 0, sizeof (rv->timer_wheel));
+  memset (rv->timer_wheel_occupied, 0, sizeof (rv->timer_wheel_occupied));
+  rv->n_timers = 0;
   rv->first_idle = rv->last_idle = NULL;
   rv->base.has_idle = DSK_FALSE;
   rv->base.has_timeout = DSK_FALSE;
@@ -267,16 +359,27 @@ DskDispatch *dsk_dispatch_new (void)
   rv->child_sig_handler = NULL;
   rv->idle_child_handler = NULL;
 
-  gettimeofday (&tv, NULL);
-  rv->base.last_dispatch_secs = tv.tv_sec;
-  rv->base.last_dispatch_usecs = tv.tv_usec;
-
-#if DSK_HAS_EPOLL
-  /* maybe this should default to the NRFILE or something. */
-  rv->epoll_fd = epoll_create (1024);
-  rv->max_epoll_events = 64;
-  rv->epoll_events = DSK_NEW (struct epoll_event, d->max_epoll_events);
-  rv->epoll_dsk_events = DSK_NEW (DskFileDescriptorNotify, d->max_epoll_events);
+  rv->next_wall_sync_usecs = 0;
+  update_clock (rv);
+  rv->timer_tick = rv->base.last_dispatch_monotonic_usecs / 1000;
+
+#if DSK_USE_IO_URING
+  rv->uring = uring_new ();
+#endif
+#if DSK_USE_EPOLL
+  rv->epoll_fd = -1;
+# if DSK_USE_IO_URING
+  if (rv->uring == NULL)
+# endif
+    rv->epoll_fd = epoll_create1 (EPOLL_CLOEXEC);
+  if (rv->epoll_fd >= 0)
+    {
+      rv->max_epoll_events = 64;
+      rv->epoll_events = DSK_NEW_ARRAY (rv->max_epoll_events, struct epoll_event);
+      rv->n_epoll_notifies = 0;
+      rv->epoll_notifies_alloced = 16;
+      rv->epoll_notifies = DSK_NEW_ARRAY (rv->epoll_notifies_alloced, DskFileDescriptorNotify);
+    }
 #endif
 
   return &rv->base;
@@ -294,17 +397,6 @@ free_fd_tree_recursive (FDMapNode          *node)
     }
 }
 #endif
-void free_timer_tree_recursive (DskDispatchTimer *node)
-{
-  if (node)
-    {
-      free_timer_tree_recursive (node->left);
-      free_timer_tree_recursive (node->right);
-      dsk_free (node);
-    }
-}
-
-/* XXX: leaking timer_tree seemingly? */
 void
 dsk_dispatch_free(DskDispatch *dispatch)
 {
@@ -312,7 +404,7 @@ dsk_dispatch_free(DskDispatch *dispatch)
   while (d->recycled_timeouts != NULL)
     {
       DskDispatchTimer *t = d->recycled_timeouts;
-      d->recycled_timeouts = t->right;
+      d->recycled_timeouts = t->next;
       dsk_free (t);
     }
   while (d->recycled_idles != NULL)
@@ -338,12 +430,32 @@ dsk_dispatch_free(DskDispatch *dispatch)
 #else
   free_fd_tree_recursive (d->fd_map_tree);
 #endif
-  free_timer_tree_recursive (d->timer_tree);
+  for (unsigned level = 0; level < TIMER_WHEEL_LEVELS; level++)
+    for (unsigned slot = 0; slot <= TIMER_WHEEL_MASK; slot++)
+      while (d->timer_wheel[level][slot] != NULL)
+        {
+          DskDispatchTimer *t = d->timer_wheel[level][slot];
+          d->timer_wheel[level][slot] = t->next;
+          dsk_free (t);
+        }
+#if DSK_USE_IO_URING
+  if (d->uring != NULL)
+    uring_free (d->uring);
+#endif
+#if DSK_USE_EPOLL
+  if (d->epoll_fd >= 0)
+    {
+      close (d->epoll_fd);
+      dsk_free (d->epoll_events);
+      dsk_free (d->epoll_notifies);
+    }
+#endif
   dsk_free (d);
 }
 
-/* TODO: perhaps thread-private dispatches make more sense? */
-static DskDispatch *def = NULL;
+/* Each thread has its own default dispatch, so that
+   one loop can be run per thread (see dsk_main_run_threads()). */
+static _Thread_local DskDispatch *def = NULL;
 DskDispatch  *dsk_dispatch_default (void)
 {
   if (def == NULL)
@@ -501,6 +613,483 @@ deallocate_notify_desired_index (RealDispatch *d,
   d->base.n_notifies_desired--;
 }
 
+static inline unsigned
+events_to_pollfd_events (unsigned ev)
+{
+  return  ((ev & DSK_EVENT_READABLE) ? POLLIN : 0)
+       |  ((ev & DSK_EVENT_WRITABLE) ? POLLOUT : 0)
+       ;
+}
+static inline unsigned
+pollfd_events_to_events (unsigned ev)
+{
+  return  ((ev & (POLLIN|POLLHUP)) ? DSK_EVENT_READABLE : 0)
+       |  ((ev & POLLOUT) ? DSK_EVENT_WRITABLE : 0)
+       ;
+}
+
+#if DSK_USE_IO_URING
+/* --- io_uring(7) backend ---
+ *
+ * Each watched fd has at most one one-shot IORING_OP_POLL_ADD
+ * in flight, tagged with the fd and a per-fd generation number.
+ * Changing or dropping the watch removes the old poll and bumps
+ * the generation, so late completions for it are recognized and
+ * ignored.  When a poll completes, the fd is re-armed at the start
+ * of the next iteration, if it is still watched; a level-triggered
+ * fd that is still ready completes again immediately.
+ *
+ * All of an iteration's poll changes, re-arms and its timeout
+ * are queued in the submission ring and handed to the kernel by
+ * the same io_uring_enter(2) that waits for completions, so a busy
+ * loop makes one system call per iteration instead of one per change.
+ */
+#define URING_ENTRIES           256
+#define URING_KEY(fd, gen)      (((uint64_t) (gen) << 32) | (uint32_t) (fd))
+#define URING_KEY_TIMEOUT       UINT64_MAX
+#define URING_KEY_REMOVE        (UINT64_MAX - 1)
+
+struct _Uring
+{
+  int fd;
+  unsigned *sq_head, *sq_tail, *sq_mask, *sq_array;
+  unsigned *cq_head, *cq_tail, *cq_mask;
+  struct io_uring_sqe *sqes;
+  struct io_uring_cqe *cqes;
+  unsigned sq_entries;
+  unsigned n_unsubmitted;
+
+  void *sq_map, *cq_map;
+  size_t sq_map_size, cq_map_size, sqes_map_size;
+
+  /* must stay put until the submission that reads it */
+  struct __kernel_timespec timeout;
+
+  /* fds whose poll completed, to re-arm next iteration */
+  size_t n_fired, fired_alloced;
+  DskFileDescriptor *fired;
+
+  size_t notifies_alloced;
+  DskFileDescriptorNotify *notifies;
+};
+
+static int
+uring_enter (Uring *u, unsigned to_submit, unsigned min_complete, unsigned flags)
+{
+  return syscall (__NR_io_uring_enter, u->fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+static void
+uring_free (Uring *u)
+{
+  if (u->sqes != NULL)
+    munmap (u->sqes, u->sqes_map_size);
+  if (u->cq_map != NULL && u->cq_map != u->sq_map)
+    munmap (u->cq_map, u->cq_map_size);
+  if (u->sq_map != NULL)
+    munmap (u->sq_map, u->sq_map_size);
+  close (u->fd);
+  dsk_free (u->fired);
+  dsk_free (u->notifies);
+  dsk_free (u);
+}
+
+/* Returns NULL if the kernel doesn't do io_uring (or forbids it),
+   in which case epoll(7) is used, or poll(2) if DSK_USE_EPOLL is 0. */
+static Uring *
+uring_new (void)
+{
+  struct io_uring_params params;
+  memset (&params, 0, sizeof (params));
+  int fd = syscall (__NR_io_uring_setup, URING_ENTRIES, &params);
+  if (fd < 0)
+    return NULL;
+
+  Uring *u = DSK_NEW0 (Uring);
+  u->fd = fd;
+  u->sq_entries = params.sq_entries;
+  u->sq_map_size = params.sq_off.array + params.sq_entries * sizeof (unsigned);
+  u->cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof (struct io_uring_cqe);
+  if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+      if (u->cq_map_size > u->sq_map_size)
+        u->sq_map_size = u->cq_map_size;
+      u->cq_map_size = u->sq_map_size;
+    }
+  u->sq_map = mmap (NULL, u->sq_map_size, PROT_READ|PROT_WRITE,
+                    MAP_SHARED|MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  if (u->sq_map == MAP_FAILED)
+    {
+      u->sq_map = NULL;
+      goto failed;
+    }
+  if (params.features & IORING_FEAT_SINGLE_MMAP)
+    u->cq_map = u->sq_map;
+  else
+    {
+      u->cq_map = mmap (NULL, u->cq_map_size, PROT_READ|PROT_WRITE,
+                        MAP_SHARED|MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+      if (u->cq_map == MAP_FAILED)
+        {
+          u->cq_map = NULL;
+          goto failed;
+        }
+    }
+  u->sqes_map_size = params.sq_entries * sizeof (struct io_uring_sqe);
+  u->sqes = mmap (NULL, u->sqes_map_size, PROT_READ|PROT_WRITE,
+                  MAP_SHARED|MAP_POPULATE, fd, IORING_OFF_SQES);
+  if (u->sqes == MAP_FAILED)
+    {
+      u->sqes = NULL;
+      goto failed;
+    }
+
+  char *sq = u->sq_map, *cq = u->cq_map;
+  u->sq_head = (unsigned *) (sq + params.sq_off.head);
+  u->sq_tail = (unsigned *) (sq + params.sq_off.tail);
+  u->sq_mask = (unsigned *) (sq + params.sq_off.ring_mask);
+  u->sq_array = (unsigned *) (sq + params.sq_off.array);
+  u->cq_head = (unsigned *) (cq + params.cq_off.head);
+  u->cq_tail = (unsigned *) (cq + params.cq_off.tail);
+  u->cq_mask = (unsigned *) (cq + params.cq_off.ring_mask);
+  u->cqes = (struct io_uring_cqe *) (cq + params.cq_off.cqes);
+
+  u->fired_alloced = 16;
+  u->fired = DSK_NEW_ARRAY (u->fired_alloced, DskFileDescriptor);
+  u->notifies_alloced = 16;
+  u->notifies = DSK_NEW_ARRAY (u->notifies_alloced, DskFileDescriptorNotify);
+  return u;
+
+failed:
+  uring_free (u);
+  return NULL;
+}
+
+/* Hand queued entries to the kernel without waiting. */
+static void
+uring_flush (Uring *u)
+{
+  while (u->n_unsubmitted > 0)
+    {
+      int rv = uring_enter (u, u->n_unsubmitted, 0, 0);
+      if (rv < 0)
+        {
+          if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+            continue;
+          dsk_warning ("io_uring_enter: %s", strerror (errno));
+          return;
+        }
+      u->n_unsubmitted -= rv;
+    }
+}
+
+static void
+uring_push (Uring    *u,
+            unsigned  opcode,
+            int       fd,
+            unsigned  poll_events,
+            uint64_t  addr,
+            uint64_t  user_data)
+{
+  unsigned tail = *u->sq_tail;
+  if (tail - __atomic_load_n (u->sq_head, __ATOMIC_ACQUIRE) == u->sq_entries)
+    uring_flush (u);
+  unsigned index = tail & *u->sq_mask;
+  struct io_uring_sqe *sqe = u->sqes + index;
+  memset (sqe, 0, sizeof (*sqe));
+  sqe->opcode = opcode;
+  sqe->fd = fd;
+  sqe->addr = addr;
+  sqe->user_data = user_data;
+  if (opcode == IORING_OP_POLL_ADD)
+    sqe->poll32_events = poll_events;
+  else if (opcode == IORING_OP_TIMEOUT)
+    {
+      sqe->len = 1;             /* one timespec */
+      sqe->off = 1;             /* ... or complete along with any event */
+    }
+  u->sq_array[index] = index;
+  __atomic_store_n (u->sq_tail, tail + 1, __ATOMIC_RELEASE);
+  u->n_unsubmitted++;
+}
+
+static inline unsigned
+events_to_uring_poll (unsigned ev)
+{
+  return ((ev & DSK_EVENT_READABLE) ? POLLIN : 0)
+       | ((ev & DSK_EVENT_WRITABLE) ? POLLOUT : 0);
+}
+
+/* Make 'fm's armed poll match 'events' (0 to disarm). */
+static void
+uring_arm (RealDispatch      *d,
+           DskFileDescriptor  fd,
+           FDMap             *fm,
+           unsigned           events)
+{
+  Uring *u = d->uring;
+  if (fm->uring_armed_events == (int) events)
+    return;
+  if (fm->uring_armed_events != -1)
+    {
+      uring_push (u, IORING_OP_POLL_REMOVE, -1, 0,
+                  URING_KEY (fd, fm->uring_generation), URING_KEY_REMOVE);
+      fm->uring_generation++;
+      fm->uring_armed_events = -1;
+    }
+  if (events != 0)
+    {
+      uring_push (u, IORING_OP_POLL_ADD, fd, events_to_uring_poll (events),
+                  0, URING_KEY (fd, fm->uring_generation));
+      fm->uring_armed_events = events;
+    }
+}
+
+/* Returns FALSE if interrupted by a signal. */
+static dsk_boolean
+uring_run (RealDispatch             *d,
+           int                       timeout,
+           size_t                   *n_events_out,
+           DskFileDescriptorNotify **events_out)
+{
+  Uring *u = d->uring;
+  DskDispatch *dispatch = &d->base;
+  unsigned i;
+
+  for (i = 0; i < dispatch->n_changes; i++)
+    {
+      DskFileDescriptorNotifyChange *c = &dispatch->changes[i];
+      uring_arm (d, c->fd, get_fd_map (d, c->fd), c->events);
+    }
+  for (i = 0; i < u->n_fired; i++)
+    {
+      DskFileDescriptor fd = u->fired[i];
+      FDMap *fm = get_fd_map (d, fd);
+      if (fm->notify_desired_index != -1 && fm->uring_armed_events == -1)
+        uring_arm (d, fd, fm, dispatch->notifies_desired[fm->notify_desired_index].events);
+    }
+  u->n_fired = 0;
+
+  unsigned min_complete = timeout == 0 ? 0 : 1;
+  if (timeout > 0)
+    {
+      u->timeout.tv_sec = timeout / 1000;
+      u->timeout.tv_nsec = (long long) (timeout % 1000) * 1000000;
+      uring_push (u, IORING_OP_TIMEOUT, -1, 0,
+                  (uintptr_t) &u->timeout, URING_KEY_TIMEOUT);
+    }
+  int rv = uring_enter (u, u->n_unsubmitted, min_complete, IORING_ENTER_GETEVENTS);
+  if (rv < 0)
+    {
+      if (errno != EINTR)
+        dsk_warning ("io_uring_enter: %s", strerror (errno));
+      /* the kernel consumes entries even when the wait fails */
+      u->n_unsubmitted = *u->sq_tail - __atomic_load_n (u->sq_head, __ATOMIC_ACQUIRE);
+      if (errno == EINTR)
+        return DSK_FALSE;
+    }
+  else
+    u->n_unsubmitted -= rv;
+
+  size_t n_events = 0;
+  unsigned head = *u->cq_head;
+  unsigned tail = __atomic_load_n (u->cq_tail, __ATOMIC_ACQUIRE);
+  for (; head != tail; head++)
+    {
+      struct io_uring_cqe *cqe = u->cqes + (head & *u->cq_mask);
+      uint64_t key = cqe->user_data;
+      if (key == URING_KEY_TIMEOUT || key == URING_KEY_REMOVE)
+        continue;
+      DskFileDescriptor fd = (uint32_t) key;
+      FDMap *fm = get_fd_map (d, fd);
+      if (fm == NULL || fm->uring_generation != (unsigned) (key >> 32))
+        continue;                       /* removed or re-armed since */
+      unsigned armed = fm->uring_armed_events;
+      fm->uring_armed_events = -1;
+      if (cqe->res < 0)
+        continue;                       /* eg EBADF:  leave it disarmed */
+
+      if (u->n_fired == u->fired_alloced)
+        {
+          u->fired_alloced *= 2;
+          u->fired = DSK_RENEW (DskFileDescriptor, u->fired, u->fired_alloced);
+        }
+      u->fired[u->n_fired++] = fd;
+
+      unsigned events = ((cqe->res & (POLLIN|POLLHUP)) ? DSK_EVENT_READABLE : 0)
+                      | ((cqe->res & POLLOUT) ? DSK_EVENT_WRITABLE : 0);
+      if (cqe->res & (POLLERR|POLLNVAL))
+        events |= armed;                /* let the callback see the error */
+      if (events == 0)
+        continue;
+      if (n_events == u->notifies_alloced)
+        {
+          u->notifies_alloced *= 2;
+          u->notifies = DSK_RENEW (DskFileDescriptorNotify, u->notifies, u->notifies_alloced);
+        }
+      u->notifies[n_events].fd = fd;
+      u->notifies[n_events].events = events;
+      n_events++;
+    }
+  __atomic_store_n (u->cq_head, head, __ATOMIC_RELEASE);
+
+  *n_events_out = n_events;
+  *events_out = u->notifies;
+  return DSK_TRUE;
+}
+#endif  /* DSK_USE_IO_URING */
+
+#if DSK_USE_EPOLL
+/* --- epoll(7) backend ---
+ *
+ * Each watched fd is registered once, edge-triggered, for every
+ * event;  narrowing or widening the events watched for is then
+ * done here, without a system call.
+ *
+ * Since callbacks needn't read or write until EAGAIN, the fds
+ * of each batch of events are checked again at the start of the
+ * next iteration, together with any fds newly watched for
+ * an event they may already be ready for:  one poll(2), with no
+ * timeout, for all of them.  Those still ready are the start of
+ * the next batch (and epoll_wait() then doesn't block);  the rest
+ * are left until the kernel reports an edge.
+ */
+static inline unsigned
+epoll_events_to_events (unsigned ev)
+{
+  unsigned rv = ((ev & (EPOLLIN|EPOLLHUP|EPOLLRDHUP)) ? DSK_EVENT_READABLE : 0)
+              | ((ev & EPOLLOUT) ? DSK_EVENT_WRITABLE : 0);
+  if (ev & EPOLLERR)
+    rv |= DSK_EVENT_READABLE | DSK_EVENT_WRITABLE;   /* let the callback see the error */
+  return rv;
+}
+
+/* Add 'fd' to the batch being built;  returns its notify. */
+static DskFileDescriptorNotify *
+epoll_batch_add (RealDispatch      *d,
+                 DskFileDescriptor  fd,
+                 FDMap             *fm)
+{
+  if (fm->epoll_batch_index != -1)
+    return d->epoll_notifies + fm->epoll_batch_index;
+  if (d->n_epoll_notifies == d->epoll_notifies_alloced)
+    {
+      d->epoll_notifies_alloced *= 2;
+      d->epoll_notifies = DSK_RENEW (DskFileDescriptorNotify,
+                                     d->epoll_notifies,
+                                     d->epoll_notifies_alloced);
+    }
+  fm->epoll_batch_index = d->n_epoll_notifies;
+  DskFileDescriptorNotify *n = d->epoll_notifies + d->n_epoll_notifies++;
+  n->fd = fd;
+  n->events = 0;
+  return n;
+}
+
+/* Returns FALSE if interrupted by a signal. */
+static dsk_boolean
+epoll_run (RealDispatch             *d,
+           int                       timeout,
+           size_t                   *n_events_out,
+           DskFileDescriptorNotify **events_out)
+{
+  DskDispatch *dispatch = &d->base;
+  struct pollfd *fds;
+  void *to_free = NULL;
+  size_t i, n_fds = 0;
+
+  for (i = 0; i < dispatch->n_changes; i++)
+    {
+      DskFileDescriptorNotifyChange *c = &dispatch->changes[i];
+      if (c->events == 0)
+        {
+          if (c->old_events != 0
+           && epoll_ctl (d->epoll_fd, EPOLL_CTL_DEL, c->fd, NULL) < 0
+           && errno != ENOENT && errno != EBADF && errno != EPERM)
+            dsk_warning ("epoll_ctl DEL %d failed: %s", c->fd, strerror (errno));
+          continue;
+        }
+      if (c->old_events == 0)
+        {
+          struct epoll_event e;
+          e.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+          e.data.fd = c->fd;
+          if (epoll_ctl (d->epoll_fd, EPOLL_CTL_ADD, c->fd, &e) == 0
+           || errno == EEXIST)
+            continue;           /* the kernel reports it if ready */
+          if (errno != EPERM)   /* EPERM:  eg a regular file; poll it */
+            {
+              dsk_warning ("epoll_ctl ADD %d failed: %s", c->fd, strerror (errno));
+              continue;
+            }
+        }
+      else if ((c->events & ~c->old_events) == 0)
+        continue;
+      epoll_batch_add (d, c->fd, get_fd_map (d, c->fd));
+    }
+
+  /* check the last batch again */
+  if (d->n_epoll_notifies < 128)
+    fds = alloca (sizeof (struct pollfd) * d->n_epoll_notifies);
+  else
+    to_free = fds = DSK_NEW_ARRAY (d->n_epoll_notifies, struct pollfd);
+  for (i = 0; i < d->n_epoll_notifies; i++)
+    {
+      DskFileDescriptor fd = d->epoll_notifies[i].fd;
+      FDMap *fm = get_fd_map (d, fd);
+      fm->epoll_batch_index = -1;
+      if (fm->notify_desired_index == -1)
+        continue;
+      fds[n_fds].fd = fd;
+      fds[n_fds].events = events_to_pollfd_events (dispatch->notifies_desired[fm->notify_desired_index].events);
+      fds[n_fds].revents = 0;
+      n_fds++;
+    }
+  d->n_epoll_notifies = 0;
+  if (n_fds > 0 && poll (fds, n_fds, 0) > 0)
+    for (i = 0; i < n_fds; i++)
+      if (fds[i].revents != 0)
+        {
+          unsigned events = pollfd_events_to_events (fds[i].revents);
+          if (fds[i].revents & (POLLERR|POLLNVAL))
+            events |= pollfd_events_to_events (fds[i].events);
+          if (events != 0)
+            epoll_batch_add (d, fds[i].fd, get_fd_map (d, fds[i].fd))->events = events;
+        }
+  if (to_free)
+    dsk_free (to_free);
+
+  /* ... and collect new edges */
+  if (d->n_epoll_notifies > 0)
+    timeout = 0;
+  int n = epoll_wait (d->epoll_fd, d->epoll_events, d->max_epoll_events, timeout);
+  if (n < 0)
+    {
+      if (errno != EINTR)
+        dsk_warning ("epoll_wait: %s", strerror (errno));
+      else if (d->n_epoll_notifies == 0)
+        return DSK_FALSE;
+      n = 0;
+    }
+  for (i = 0; i < (size_t) n; i++)
+    {
+      DskFileDescriptor fd = d->epoll_events[i].data.fd;
+      FDMap *fm = force_fd_map (d, fd);
+      epoll_batch_add (d, fd, fm)->events |= epoll_events_to_events (d->epoll_events[i].events);
+    }
+  if ((unsigned) n == d->max_epoll_events)
+    {
+      /* more may be waiting:  take bigger batches */
+      d->max_epoll_events *= 2;
+      d->epoll_events = DSK_RENEW (struct epoll_event, d->epoll_events, d->max_epoll_events);
+    }
+
+  *n_events_out = d->n_epoll_notifies;
+  *events_out = d->epoll_notifies;
+  return DSK_TRUE;
+}
+#endif  /* DSK_USE_EPOLL */
+
 /* Registering file-descriptors to watch. */
 void
 dsk_dispatch_watch_fd (DskDispatch *dispatch,
@@ -594,17 +1183,202 @@ dsk_dispatch_fd_closed(DskDispatch             *dispatch,
 #endif
   fm = force_fd_map (d, fd);
   fm->closed_since_notify_started = 1;
+#if DSK_USE_EPOLL
+  /* unregister it before it is closed, in case of dup()s */
+  if (d->epoll_fd >= 0
+   && (fm->change_index != -1
+       ? d->base.changes[fm->change_index].old_events != 0
+       : fm->notify_desired_index != -1))
+    epoll_ctl (d->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+#endif
   if (fm->change_index != -1)
     deallocate_change_index (d, fm);
   if (fm->notify_desired_index != -1)
     deallocate_notify_desired_index (d, fd, fm);
+#if DSK_USE_IO_URING
+  /* the kernel's poll holds the file open:  cancel it
+     (with the next batch of submissions) */
+  if (d->uring != NULL && fm->uring_armed_events != -1)
+    uring_arm (d, fd, fm, 0);
+#endif
+}
+
+/* --- Timers:  a hierarchical timing wheel ---
+ *
+ * Timers are bucketed by their expiration in milliseconds ("ticks")
+ * on the monotonic clock
+ * into TIMER_WHEEL_LEVELS levels of 64 slots.  A timer is on the
+ * lowest level whose higher-order bits of the tick match the
+ * current tick's:  level 0 holds the timers due in the current
+ * 64 ms, level 1 those due in the current 4096 ms, and so on;
+ * seven levels cover every tick a 32-bit time in seconds can name.
+ * When the current tick reaches a higher-level slot, its timers are
+ * cascaded to lower levels.
+ *
+ * Adding and removing a timer is O(1); the cost of firing is spread
+ * over the cascades.  A bitmap of occupied slots per level lets
+ * the wheel skip directly to the next slot with work in it, so
+ * long idle periods cost nothing, and finding the earliest timer
+ * only scans one slot.
+ */
+static void
+timer_wheel_insert (RealDispatch *d, DskDispatchTimer *timer)
+{
+  uint64_t tick = timer->expire_usecs / 1000;
+  unsigned level = 0, slot;
+  if (tick <= d->timer_tick)
+    slot = d->timer_tick & TIMER_WHEEL_MASK;    /* due:  fire next time */
+  else
+    {
+      while (level + 1 < TIMER_WHEEL_LEVELS
+          && (tick >> (TIMER_WHEEL_BITS * (level + 1)))
+             != (d->timer_tick >> (TIMER_WHEEL_BITS * (level + 1))))
+        level++;
+      slot = (tick >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK;
+    }
+  DskDispatchTimer **head = &d->timer_wheel[level][slot];
+  timer->level = level;
+  timer->slot = slot;
+  timer->prev = NULL;
+  timer->next = *head;
+  if (*head != NULL)
+    (*head)->prev = timer;
+  *head = timer;
+  d->timer_wheel_occupied[level] |= 1ULL << slot;
+  d->n_timers++;
+}
+
+static void
+timer_wheel_remove (RealDispatch *d, DskDispatchTimer *timer)
+{
+  if (timer->prev != NULL)
+    timer->prev->next = timer->next;
+  else
+    {
+      d->timer_wheel[timer->level][timer->slot] = timer->next;
+      if (timer->next == NULL)
+        d->timer_wheel_occupied[timer->level] &= ~(1ULL << timer->slot);
+    }
+  if (timer->next != NULL)
+    timer->next->prev = timer->prev;
+  d->n_timers--;
+}
+
+/* Finds the first occupied slot at or after the current tick.
+   Returns FALSE if there are no timers. */
+static dsk_boolean
+timer_wheel_next_slot (RealDispatch *d,
+                       unsigned     *level_out,
+                       unsigned     *slot_out,
+                       uint64_t     *tick_out)
+{
+  for (unsigned level = 0; level < TIMER_WHEEL_LEVELS; level++)
+    {
+      unsigned shift = TIMER_WHEEL_BITS * level;
+      unsigned digit = (d->timer_tick >> shift) & TIMER_WHEEL_MASK;
+      /* level 0 still holds the current tick's slot; above it,
+         the current slot has already been cascaded */
+      uint64_t later = level == 0 ? ~0ULL << digit
+                     : digit == TIMER_WHEEL_MASK ? 0 : ~0ULL << (digit + 1);
+      uint64_t occupied = d->timer_wheel_occupied[level] & later;
+      if (occupied != 0)
+        {
+          unsigned slot = __builtin_ctzll (occupied);
+          uint64_t block = d->timer_tick >> (shift + TIMER_WHEEL_BITS) << (shift + TIMER_WHEEL_BITS);
+          *level_out = level;
+          *slot_out = slot;
+          *tick_out = block | ((uint64_t) slot << shift);
+          return DSK_TRUE;
+        }
+    }
+  return DSK_FALSE;
+}
+
+/* Move the wheel up to 'now', putting the timers that are due
+   on 'expired_inout' (in order of expiration, to the millisecond). */
+static void
+timer_wheel_advance (RealDispatch      *d,
+                     uint64_t           now_usecs,
+                     DskDispatchTimer **expired_inout)
+{
+  uint64_t now_tick = now_usecs / 1000;
+  DskDispatchTimer **expired_tail = expired_inout;
+  while (*expired_tail != NULL)
+    expired_tail = &(*expired_tail)->next;
+  unsigned level, slot;
+  uint64_t tick;
+  while (timer_wheel_next_slot (d, &level, &slot, &tick) && tick <= now_tick)
+    {
+      if (tick > d->timer_tick)
+        d->timer_tick = tick;
+      DskDispatchTimer *list = d->timer_wheel[level][slot];
+      d->timer_wheel[level][slot] = NULL;
+      d->timer_wheel_occupied[level] &= ~(1ULL << slot);
+      dsk_boolean kept = DSK_FALSE;
+      while (list != NULL)
+        {
+          DskDispatchTimer *timer = list;
+          list = timer->next;
+          d->n_timers--;
+          if (level == 0 && timer->expire_usecs <= now_usecs)
+            {
+              timer->expired = DSK_TRUE;
+              timer->next = NULL;
+              *expired_tail = timer;
+              expired_tail = &timer->next;
+            }
+          else
+            {
+              /* cascade, or a timer later in the current millisecond */
+              timer_wheel_insert (d, timer);
+              if (level == 0)
+                kept = DSK_TRUE;
+            }
+        }
+      if (kept)
+        break;
+    }
+  if (now_tick > d->timer_tick)
+    d->timer_tick = now_tick;
+}
+
+/* The public members are in time-of-day. */
+static void
+set_public_timeout (RealDispatch *d, uint64_t expire_usecs)
+{
+  int64_t wall = (int64_t) expire_usecs + d->wall_offset_usecs;
+  if (wall < 0)
+    wall = 0;
+  d->first_expire_usecs = expire_usecs;
+  d->base.has_timeout = DSK_TRUE;
+  d->base.timeout_secs = wall / 1000000;
+  d->base.timeout_usecs = wall % 1000000;
+}
+
+/* Set the public 'has_timeout' and 'timeout_*' members
+   from the earliest timer. */
+static void
+update_public_timeout (RealDispatch *d)
+{
+  unsigned level, slot;
+  uint64_t tick;
+  if (!timer_wheel_next_slot (d, &level, &slot, &tick))
+    {
+      d->base.has_timeout = DSK_FALSE;
+      return;
+    }
+  DskDispatchTimer *min = d->timer_wheel[level][slot];
+  for (DskDispatchTimer *at = min->next; at != NULL; at = at->next)
+    if (at->expire_usecs < min->expire_usecs)
+      min = at;
+  set_public_timeout (d, min->expire_usecs);
 }
 
 static void
 free_timer (DskDispatchTimer *timer)
 {
   RealDispatch *d = timer->dispatch;
-  timer->right = d->recycled_timeouts;
+  timer->next = d->recycled_timeouts;
   d->recycled_timeouts = timer;
 }
 
@@ -616,13 +1390,10 @@ dsk_dispatch_dispatch (DskDispatch             *dispatch,
   RealDispatch *d = (RealDispatch *) dispatch;
   unsigned fd_max;
   unsigned i;
-  struct timeval tv;
 
-  /* Update the cached time-of-day. (this must be done before any
+  /* Update the cached time. (this must be done before any
    * callbacks are run.) */
-  gettimeofday (&tv, NULL);
-  dispatch->last_dispatch_secs = tv.tv_sec;
-  dispatch->last_dispatch_usecs = tv.tv_usec;
+  update_clock (d);
 
   /* If a notify comes in with a new file-descriptor (?? can it happen),
      that's bigger than our allocation size,
@@ -649,10 +1420,8 @@ dsk_dispatch_dispatch (DskDispatch             *dispatch,
         }
     }
 
-  /* clear changes */
-  for (i = 0; i < dispatch->n_changes; i++)
-    d->fd_map[dispatch->changes[i].fd].change_index = -1;
-  dispatch->n_changes = 0;
+  /* changes made by the callbacks are left for
+     the next dsk_dispatch_run() (or the embedder) to apply */
 
   /* handle idle functions */
   while (d->first_idle != NULL)
@@ -672,37 +1441,16 @@ dsk_dispatch_dispatch (DskDispatch             *dispatch,
 
   /* handle timers */
   DskDispatchTimer *expired = NULL;
-  while (d->timer_tree != NULL)
-    {
-      DskDispatchTimer *min_timer;
-      DSK_RBTREE_FIRST (GET_TIMER_TREE (d), min_timer);
-      if (min_timer->timeout_secs < (unsigned long) tv.tv_sec
-       || (min_timer->timeout_secs == (unsigned long) tv.tv_sec
-        && min_timer->timeout_usecs <= (unsigned) tv.tv_usec))
-        {
-          DSK_RBTREE_REMOVE (GET_TIMER_TREE (d), min_timer);
-          min_timer->left = expired;
-          min_timer->expired = DSK_TRUE;
-          expired = min_timer;
-        }
-      else
-        {
-          d->base.has_timeout = 1;
-          d->base.timeout_secs = min_timer->timeout_secs;
-          d->base.timeout_usecs = min_timer->timeout_usecs;
-          break;
-        }
-    }
+  timer_wheel_advance (d, dispatch->last_dispatch_monotonic_usecs, &expired);
   while (expired != NULL)
     {
       DskDispatchTimer *timer = expired;
-      expired = timer->left;
+      expired = timer->next;
       if (timer->func != NULL)
         timer->func (timer->func_data);
       free_timer (timer);
     }
-  if (d->timer_tree == NULL)
-    d->base.has_timeout = 0;
+  update_public_timeout (d);
   d->dispatching = DSK_FALSE;
 }
 
@@ -720,36 +1468,6 @@ dsk_dispatch_clear_changes (DskDispatch *dispatch)
   dispatch->n_changes = 0;
 }
 
-#if DSK_HAS_EPOLL
-static inline unsigned
-events_to_epoll_events (unsigned ev)
-{
-  return ((ev & DSK_EVENT_READABLE) ? (EPOLLIN|EPOLLHUP) : 0)
-       | ((ev & DSK_EVENT_WRITABLE) ? (EPOLLOUT) : 0);
-}
-static inline unsigned
-epoll_events_to_events (unsigned ev)
-{
-  return ((ev & (EPOLLIN|EPOLLHUP)) ? DSK_EVENT_READABLE : 0)
-       | ((ev & EPOLLOUT) ? DSK_EVENT_WRITABLE : 0);
-}
-#else
-static inline unsigned
-events_to_pollfd_events (unsigned ev)
-{
-  return  ((ev & DSK_EVENT_READABLE) ? POLLIN : 0)
-       |  ((ev & DSK_EVENT_WRITABLE) ? POLLOUT : 0)
-       ;
-}
-static inline unsigned
-pollfd_events_to_events (unsigned ev)
-{
-  return  ((ev & (POLLIN|POLLHUP)) ? DSK_EVENT_READABLE : 0)
-       |  ((ev & POLLOUT) ? DSK_EVENT_WRITABLE : 0)
-       ;
-}
-#endif
-
 void
 dsk_dispatch_run (DskDispatch *dispatch)
 {
@@ -767,71 +1485,40 @@ dsk_dispatch_run (DskDispatch *dispatch)
     timeout = -1;
   else
     {
-      struct timeval tv;
-      gettimeofday (&tv, NULL);
-      if (dispatch->timeout_secs < (unsigned long) tv.tv_sec
-       || (dispatch->timeout_secs == (unsigned long) tv.tv_sec
-        && dispatch->timeout_usecs <= (unsigned) tv.tv_usec))
+      uint64_t now = read_monotonic_usecs ();
+      uint64_t expire = ((RealDispatch *) dispatch)->first_expire_usecs;
+      if (expire <= now)
         timeout = 0;
+      else if ((expire - now) / 1000 >= INT_MAX)
+        timeout = INT_MAX;
       else
-        {
-          int du = dispatch->timeout_usecs - tv.tv_usec;
-          int ds = dispatch->timeout_secs - tv.tv_sec;
-          if (du < 0)
-            {
-              du += 1000000;
-              ds -= 1;
-            }
-          if (ds > INT_MAX / 1000)
-            timeout = INT_MAX / 1000 * 1000;
-          else
-            /* Round up, so that we ensure that something can run
-               if they just wait the full duration */
-            timeout = ds * 1000 + (du + 999) / 1000;
-        }
+        /* Round up, so that we ensure that something can run
+           if they just wait the full duration */
+        timeout = (expire - now + 999) / 1000;
     }
 
-#if DSK_HAS_EPOLL
-  RealDispatch *d = (RealDispatch *) dispatch;
-  int epoll_fd = d->epoll_fd;
-  for (i = 0; i < dispatch->n_changes; i++)
-    {
-      DskFileDescriptorNotifyChange *c = &dispatch->changes[i];
-      int op = c->old_events == 0 ? EPOLL_CTL_ADD
-             : c->events == 0 ? EPOLL_CTL_DEL
-             : EPOLL_CTL_MOD;
-      struct epoll_event e;
-      e.events = events_to_epoll_events (c->events);
-      e.data.fd = c->fd;
-      if (epoll_ctl (epoll_fd, op, c->fd, &e) < 0)
-        {
-          dsk_warning ("epoll_ctl %d op=0x%x events=0x%x failed: %s", c->fd, op, e.events, strerror (errno));
-        }
-    }
-  
-  int epoll_n_events = epoll_wait (epoll_fd, d->epoll_events, d->max_epoll_events, timeout);
-  if (epoll_n_events < 0)
-    {
-      dsk_warning ("epoll_wait: %s", strerror (errno));
-      epoll_n_events = 0;
-    }
-  else
+#if DSK_USE_IO_URING
+  if (((RealDispatch *) dispatch)->uring != NULL)
     {
-      if (epoll_n_events == d->max_epoll_events)
-        {
-          d->max_epoll_events *= 2;
-          d->epoll_events = DSK_RENEW (struct epoll_event, d->epoll_events, d->max_epoll_events);
-          d->epoll_dsk_events = DSK_RENEW (DskFileDescriptorNotify, d->epoll_events, d->max_epoll_events);
-        }
+      if (!uring_run ((RealDispatch *) dispatch, timeout, &n_events, &events))
+        return;   /* interrupted by a signal, as with poll() below */
+      dsk_dispatch_clear_changes (dispatch);
+      dsk_dispatch_dispatch (dispatch, n_events, events);
+      return;
     }
-  n_events = epoll_n_events;
-  events = d->epoll_dsk_events;
-  for (i = 0; i < n_events; i++)
+#endif
+#if DSK_USE_EPOLL
+  if (((RealDispatch *) dispatch)->epoll_fd >= 0)
     {
-      events[i].fd = d->epoll_events[i].data.fd;
-      events[i].events = epoll_events_to_events (d->epoll_events[i].events);
+      if (!epoll_run ((RealDispatch *) dispatch, timeout, &n_events, &events))
+        return;
+      dsk_dispatch_clear_changes (dispatch);
+      dsk_dispatch_dispatch (dispatch, n_events, events);
+      return;
     }
-#else  /* use poll(2) */
+#endif
+
+  /* use poll(2) */
   if (dispatch->n_notifies_desired < 128)
     fds = alloca (sizeof (struct pollfd) * dispatch->n_notifies_desired);
   else
@@ -871,7 +1558,6 @@ dsk_dispatch_run (DskDispatch *dispatch)
         if (events[n_events].events != 0)
           n_events++;
       }
-#endif
   dsk_dispatch_clear_changes (dispatch);
   dsk_dispatch_dispatch (dispatch, n_events, events);
   if (to_free)
@@ -880,112 +1566,90 @@ dsk_dispatch_run (DskDispatch *dispatch)
     dsk_free (to_free2);
 }
 
-DskDispatchTimer *
-dsk_dispatch_add_timer(DskDispatch *dispatch,
-                              unsigned            timeout_secs,
-                              unsigned            timeout_usecs,
-                              DskTimerFunc func,
-                              void               *func_data)
+/* Absolute times are converted to the monotonic clock when given. */
+static uint64_t
+wall_to_monotonic (RealDispatch *d,
+                   unsigned      secs,
+                   unsigned      usecs)
+{
+  int64_t rv = (int64_t) secs * 1000000 + usecs - d->wall_offset_usecs;
+  return rv < 0 ? 0 : rv;
+}
+
+static DskDispatchTimer *
+add_timer (RealDispatch *d,
+           uint64_t      expire_usecs,
+           DskTimerFunc  func,
+           void         *func_data)
 {
-  RealDispatch *d = (RealDispatch *) dispatch;
   DskDispatchTimer *rv;
-  DskDispatchTimer *at;
-  DskDispatchTimer *conflict;
   dsk_assert (func != NULL);
   if (d->recycled_timeouts != NULL)
     {
       rv = d->recycled_timeouts;
-      d->recycled_timeouts = rv->right;
+      d->recycled_timeouts = rv->next;
     }
   else
     {
       rv = DSK_NEW (DskDispatchTimer);
     }
-  rv->timeout_secs = timeout_secs;
-  rv->timeout_usecs = timeout_usecs;
+  rv->expire_usecs = expire_usecs;
   rv->func = func;
   rv->func_data = func_data;
   rv->dispatch = d;
   rv->expired = DSK_FALSE;
-  DSK_RBTREE_INSERT (GET_TIMER_TREE (d), rv, conflict);
-  (void) conflict;              /* suppress warnings */
-  
-  /* is this the first element in the tree */
-  for (at = rv; at != NULL; at = at->parent)
-    if (at->parent && at->parent->right == at)
-      break;
-  if (at == NULL)               /* yes, so set the public members */
-    {
-      dispatch->has_timeout = 1;
-      dispatch->timeout_secs = rv->timeout_secs;
-      dispatch->timeout_usecs = rv->timeout_usecs;
-    }
+  timer_wheel_insert (d, rv);
+
+  /* is this the first timer?  if so, set the public members */
+  if (!d->base.has_timeout || expire_usecs < d->first_expire_usecs)
+    set_public_timeout (d, expire_usecs);
   return rv;
 }
 
+DskDispatchTimer *
+dsk_dispatch_add_timer(DskDispatch *dispatch,
+                              unsigned            timeout_secs,
+                              unsigned            timeout_usecs,
+                              DskTimerFunc func,
+                              void               *func_data)
+{
+  RealDispatch *d = (RealDispatch *) dispatch;
+  return add_timer (d, wall_to_monotonic (d, timeout_secs, timeout_usecs),
+                    func, func_data);
+}
+
 DskDispatchTimer *
 dsk_dispatch_add_timer_millis (DskDispatch         *dispatch,
                                uint64_t             millis,
                                DskTimerFunc func,
                                void                *func_data)
 {
-  unsigned tsec = dispatch->last_dispatch_secs;
-  unsigned tusec = dispatch->last_dispatch_usecs;
-  tusec += 1000 * (millis % 1000);
-  tsec += millis / 1000;
-  if (tusec >= 1000*1000)
-    {
-      tusec -= 1000*1000;
-      tsec += 1;
-    }
-  return dsk_dispatch_add_timer (dispatch, tsec, tusec, func, func_data);
+  return add_timer ((RealDispatch *) dispatch,
+                    dispatch->last_dispatch_monotonic_usecs + millis * 1000,
+                    func, func_data);
 }
 void  dsk_dispatch_adjust_timer    (DskDispatchTimer *timer,
                                     unsigned           timeout_secs,
                                     unsigned           timeout_usecs)
 {
-  DskDispatchTimer *conflict;
   RealDispatch *d = timer->dispatch;
-  dsk_boolean was_first = DSK_FALSE;
-  if (d->first_idle == NULL)
-    {
-      DskDispatchTimer *first;
-      DSK_RBTREE_FIRST (GET_TIMER_TREE (d), first);
-      if (first == timer)
-        was_first = DSK_TRUE;
-    }
   dsk_assert (timer->func != NULL);
-  DSK_RBTREE_REMOVE (GET_TIMER_TREE (d), timer);
-  timer->timeout_secs = timeout_secs;
-  timer->timeout_usecs = timeout_usecs;
-  DSK_RBTREE_INSERT (GET_TIMER_TREE (d), timer, conflict);
-  dsk_assert (conflict == NULL);
-
-  if (d->first_idle == NULL)
-    {
-      DskDispatchTimer *first;
-      DSK_RBTREE_FIRST (GET_TIMER_TREE (d), first);
-      if (was_first || first == timer)
-        {
-          d->base.timeout_secs = first->timeout_secs;
-          d->base.timeout_usecs = first->timeout_usecs;
-        }
-    }
+  timer_wheel_remove (d, timer);
+  timer->expire_usecs = wall_to_monotonic (d, timeout_secs, timeout_usecs);
+  timer_wheel_insert (d, timer);
+  update_public_timeout (d);
 }
 
 void  dsk_dispatch_adjust_timer_millis (DskDispatchTimer *timer,
                                         uint64_t          milliseconds)
 {
-  unsigned tsec = timer->dispatch->base.last_dispatch_secs;
-  unsigned tusec = timer->dispatch->base.last_dispatch_usecs;
-  tusec += milliseconds % 1000 * 1000;
-  tsec += milliseconds / 1000;
-  if (tusec >= 1000*1000)
-    {
-      tusec -= 1000*1000;
-      tsec += 1;
-    }
-  dsk_dispatch_adjust_timer (timer, tsec, tusec);
+  RealDispatch *d = timer->dispatch;
+  dsk_assert (timer->func != NULL);
+  timer_wheel_remove (d, timer);
+  timer->expire_usecs = d->base.last_dispatch_monotonic_usecs
+                      + milliseconds * 1000;
+  timer_wheel_insert (d, timer);
+  update_public_timeout (d);
 }
 
 void  dsk_dispatch_remove_timer (DskDispatchTimer *timer)
@@ -999,23 +1663,12 @@ void  dsk_dispatch_remove_timer (DskDispatchTimer *timer)
       return;
     }
 
-  may_be_first = d->base.timeout_usecs == timer->timeout_usecs
-              && d->base.timeout_secs == timer->timeout_secs;
+  may_be_first = timer->expire_usecs == d->first_expire_usecs;
 
-  DSK_RBTREE_REMOVE (GET_TIMER_TREE (d), timer);
+  timer_wheel_remove (d, timer);
 
   if (may_be_first)
-    {
-      if (d->timer_tree == NULL)
-        d->base.has_timeout = 0;
-      else
-        {
-          DskDispatchTimer *min;
-          DSK_RBTREE_FIRST (GET_TIMER_TREE (d), min);
-          d->base.timeout_secs = min->timeout_secs;
-          d->base.timeout_usecs = min->timeout_usecs;
-        }
-    }
+    update_public_timeout (d);
   free_timer (timer);
 }
 DskDispatchIdle *
@@ -107,7 +107,8 @@ void  dsk_dispatch_remove_child (DskDispatchChild  *handler);
 /* Where you are happy just to run poll(2). */
 
 /* dsk_dispatch_run() 
- * Run one main-loop iteration, using poll(2) (or some system-level event system).
+ * Run one main-loop iteration, using poll(2) (or some system-level event system:
+ * io_uring(7) on linux, when the kernel allows it, otherwise epoll(7)).
  */
 void  dsk_dispatch_run      (DskDispatch *dispatch);
 
@@ -158,6 +159,9 @@ struct _DskDispatch
   unsigned long last_dispatch_secs;
   unsigned last_dispatch_usecs;
 
+  /* CLOCK_MONOTONIC at the same instant:  for measuring intervals */
+  uint64_t last_dispatch_monotonic_usecs;
+
   /* private data follows (see RealDispatch structure in .c file) */
 };
 
@@ -133,23 +133,25 @@ void    dsk_dns_lookup (const char       *name,
 } 
 
 /* --- globals --- */
-static DskUdpSocket *dns_udp_socket = NULL;
-static DskHookTrap *dns_udp_socket_trap = NULL;
-static DskDnsCacheEntry *dns_cache = NULL;
-static DskDnsCacheEntry *expiration_tree = NULL;
-static unsigned next_nameserver_index = 0;
-static DskDnsCacheEntryJob *first_waiting_to_send = NULL;
-static DskDnsCacheEntryJob *last_waiting_to_send = NULL;
+/* Each thread running a dispatch loop (see dsk_main_run_threads())
+   has its own socket, cache and configuration, so none of this is locked. */
+static _Thread_local DskUdpSocket *dns_udp_socket = NULL;
+static _Thread_local DskHookTrap *dns_udp_socket_trap = NULL;
+static _Thread_local DskDnsCacheEntry *dns_cache = NULL;
+static _Thread_local DskDnsCacheEntry *expiration_tree = NULL;
+static _Thread_local unsigned next_nameserver_index = 0;
+static _Thread_local DskDnsCacheEntryJob *first_waiting_to_send = NULL;
+static _Thread_local DskDnsCacheEntryJob *last_waiting_to_send = NULL;
 
 /* --- configuration --- */
-static unsigned n_resolv_conf_ns = 0;
-static NameserverInfo *resolv_conf_ns = NULL;
-static unsigned n_resolv_conf_search_paths = 0;
-static char **resolv_conf_search_paths = NULL;
-static unsigned max_resolv_conf_searchpath_len = 0;
-static DskDnsCacheEntry *etc_hosts_tree = NULL;
-static DskDnsConfigFlags config_flags = DSK_DNS_CONFIG_FLAGS_INIT;
-static dsk_boolean dns_initialized = DSK_FALSE;
+static _Thread_local unsigned n_resolv_conf_ns = 0;
+static _Thread_local NameserverInfo *resolv_conf_ns = NULL;
+static _Thread_local unsigned n_resolv_conf_search_paths = 0;
+static _Thread_local char **resolv_conf_search_paths = NULL;
+static _Thread_local unsigned max_resolv_conf_searchpath_len = 0;
+static _Thread_local DskDnsCacheEntry *etc_hosts_tree = NULL;
+static _Thread_local DskDnsConfigFlags config_flags = DSK_DNS_CONFIG_FLAGS_INIT;
+static _Thread_local dsk_boolean dns_initialized = DSK_FALSE;
 
 #define CACHE_ENTRY_NAME_IS_RED(n)  n->name_type_is_red
 #define CACHE_ENTRY_NAME_SET_IS_RED(n,v)  n->name_type_is_red=v
@@ -650,8 +652,8 @@ next:
   }while(0)
 
 /* --- expunging old records --- */
-static unsigned expunge_block_count = 0;
-static dsk_boolean blocked_expunge = DSK_FALSE;
+static _Thread_local unsigned expunge_block_count = 0;
+static _Thread_local dsk_boolean blocked_expunge = DSK_FALSE;
 static void
 expunge_old_cache_entries (void)
 {
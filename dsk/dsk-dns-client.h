@@ -103,6 +103,8 @@ typedef enum
   (DSK_DNS_CONFIG_USE_RESOLV_CONF_SEARCHPATH| \
    DSK_DNS_CONFIG_USE_RESOLV_CONF_NS| \
    DSK_DNS_CONFIG_USE_ETC_HOSTS)
+/* The client's cache and configuration belong to the calling thread:
+   configure it on each thread that does lookups. */
 void dsk_dns_client_config (DskDnsConfigFlags flags);
 void dsk_dns_client_add_nameserver (DskIpAddress *addr);
 void dsk_dns_config_dump (void);
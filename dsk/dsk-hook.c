@@ -8,9 +8,10 @@
 dsk_boolean dsk_debug_hooks;
 #endif
 
-static DskDispatchIdle *idle_handler = NULL;
-static DskHook *dsk_hook_idle_first = NULL;
-static DskHook *dsk_hook_idle_last = NULL;
+/* per-thread, like the default dispatch the idle handler runs on */
+static _Thread_local DskDispatchIdle *idle_handler = NULL;
+static _Thread_local DskHook *dsk_hook_idle_first = NULL;
+static _Thread_local DskHook *dsk_hook_idle_last = NULL;
 #define GET_IDLE_HOOK_LIST()    DskHook *, dsk_hook_idle_first, dsk_hook_idle_last, idle_prev, idle_next
 
 DskHookFuncs dsk_hook_funcs_default =
@@ -19,7 +20,7 @@ DskHookFuncs dsk_hook_funcs_default =
   (DskHookObjectFunc) dsk_object_unref_f,
   NULL
 };
-DskMemPoolFixed dsk_hook_trap_pool = DSK_MEM_POOL_FIXED_STATIC_INIT (sizeof (DskHookTrap));
+_Thread_local DskMemPoolFixed dsk_hook_trap_pool = DSK_MEM_POOL_FIXED_STATIC_INIT (sizeof (DskHookTrap));
 
 void
 dsk_hook_notify (DskHook *hook)
@@ -77,7 +77,7 @@ DSK_INLINE_FUNC void         dsk_hook_set_idle_notify(DskHook       *hook,
                 void         dsk_hook_clear        (DskHook       *hook);
 
 extern DskHookFuncs dsk_hook_funcs_default;
-extern DskMemPoolFixed dsk_hook_trap_pool;
+extern _Thread_local DskMemPoolFixed dsk_hook_trap_pool;
 
 void _dsk_hook_trap_count_nonzero (DskHook *);
 void _dsk_hook_trap_count_zero (DskHook *);
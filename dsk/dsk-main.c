@@ -1,3 +1,9 @@
+#if defined(__linux__)
+#  define _GNU_SOURCE           /* for pthread_setaffinity_np() */
+#endif
+#include <pthread.h>
+#include <unistd.h>
+#include <string.h>
 #include "dsk.h"
 
 void              dsk_main_watch_fd        (DskFileDescriptor   fd,
@@ -94,9 +100,11 @@ void              dsk_main_remove_child   (DskDispatchChild *child)
 
 /* program termination (terminate when ref-count gets to 0);
  * many programs leave 0 refs the whole time.
+ *
+ * Like the default dispatch, these are per-thread.
  */
-static unsigned main_n_refs = 0;
-static int main_exit_status = -1;
+static _Thread_local unsigned main_n_refs = 0;
+static _Thread_local int main_exit_status = -1;
 void              dsk_main_add_object      (void               *object)
 {
   dsk_main_add_ref ();
@@ -135,3 +143,82 @@ void              dsk_main_quit            (void)
 }
 
 
+
+/* --- one loop per core --- */
+typedef struct _MainThread MainThread;
+struct _MainThread
+{
+  pthread_t thread;
+  unsigned index;
+  unsigned n_cpus;
+  DskMainThreadInit init;
+  void *init_data;
+  int exit_status;
+};
+
+static void *
+main_thread_run (void *data)
+{
+  MainThread *t = data;
+#if defined(__linux__)
+  if (t->n_cpus > 1)
+    {
+      cpu_set_t cpus;
+      CPU_ZERO (&cpus);
+      CPU_SET (t->index % t->n_cpus, &cpus);
+      pthread_setaffinity_np (pthread_self (), sizeof (cpus), &cpus);
+    }
+#endif
+  t->init (t->index, t->init_data);
+  t->exit_status = dsk_main_run ();
+  if (t->index != 0)
+    {
+      dsk_dispatch_destroy_default ();
+      _dsk_buffer_cleanup_recycling_bin ();
+    }
+  return NULL;
+}
+
+int
+dsk_main_run_threads     (unsigned           n_threads,
+                          DskMainThreadInit  init,
+                          void              *init_data)
+{
+  long n_cpus = sysconf (_SC_NPROCESSORS_ONLN);
+  if (n_cpus < 1)
+    n_cpus = 1;
+  if (n_threads == 0)
+    n_threads = n_cpus;
+
+  MainThread *threads = DSK_NEW_ARRAY (n_threads, MainThread);
+  unsigned n_started = 1;
+  for (unsigned i = 0; i < n_threads; i++)
+    {
+      threads[i].index = i;
+      threads[i].n_cpus = n_cpus;
+      threads[i].init = init;
+      threads[i].init_data = init_data;
+      threads[i].exit_status = -1;
+    }
+  for (; n_started < n_threads; n_started++)
+    {
+      int err = pthread_create (&threads[n_started].thread, NULL,
+                                main_thread_run, threads + n_started);
+      if (err != 0)
+        {
+          dsk_warning ("error creating dispatch thread %u: %s",
+                       n_started, strerror (err));
+          break;
+        }
+    }
+
+  /* the calling thread runs loop 0 */
+  threads[0].thread = pthread_self ();
+  main_thread_run (threads + 0);
+
+  for (unsigned i = 1; i < n_started; i++)
+    pthread_join (threads[i].thread, NULL);
+  int rv = threads[0].exit_status;
+  dsk_free (threads);
+  return rv;
+}
@@ -50,3 +50,26 @@ void              dsk_main_exit            (int                exit_status);
 
 /* same as dsk_main_exit(0) -- useful as a callback */
 void              dsk_main_quit            (void);
+
+/* Running one loop per core.
+ *
+ * The dispatch, the ref-count and exit status above, and the dns
+ * client's cache and configuration are per-thread.
+ * This starts 'n_threads' threads (0 means one per online cpu),
+ * the calling thread being the first, and pins each to a cpu.
+ * Each thread calls init(thread_index, init_data), then dsk_main_run().
+ * dsk_main_exit() only ends the calling thread's loop.
+ *
+ * Objects belong to the thread that made them.  To share a port,
+ * have each thread's 'init' create its own listener with the
+ * 'reuse_port' option:  the kernel then spreads the connections
+ * over the threads, and no locking is needed.  Signals may only be
+ * handled by one of the loops.
+ *
+ * Returns the calling thread's exit status, after all threads are done.
+ */
+typedef void (*DskMainThreadInit) (unsigned  thread_index,
+                                   void     *init_data);
+int               dsk_main_run_threads     (unsigned           n_threads,
+                                            DskMainThreadInit  init,
+                                            void              *init_data);
@@ -1,3 +1,4 @@
+#include <pthread.h>
 #include "dsk-common.h"
 #include "dsk-object.h"
 #include "dsk-mem-pool.h"
@@ -10,7 +11,7 @@ dsk_boolean dsk_debug_object_lifetimes;
 #define ASSERT_OBJECT_CLASS_MAGIC(class) \
   dsk_assert ((class)->object_class_magic == DSK_OBJECT_CLASS_MAGIC)
 
-static DskMemPoolFixed weak_pointer_pool = DSK_MEM_POOL_FIXED_STATIC_INIT(sizeof (DskWeakPointer));
+static _Thread_local DskMemPoolFixed weak_pointer_pool = DSK_MEM_POOL_FIXED_STATIC_INIT(sizeof (DskWeakPointer));
 
 static void
 dsk_object_init (DskObject *object)
@@ -144,13 +145,22 @@ dsk_object_cast_get_class (void       *object,
 
 static const DskObjectClass *all_instantiated_classes = NULL;
 
+/* Classes are shared by all threads, so the first instance
+   of a class may be created in two threads at once. */
+static pthread_mutex_t first_instance_lock = PTHREAD_MUTEX_INITIALIZER;
+
 void _dsk_object_class_first_instance (const DskObjectClass *c)
 {
   const DskObjectClass *at;
   DskObjectInitFunc *iat, *fat;
   DskObjectClassCacheData *cd = (DskObjectClassCacheData *) c->cache_data;
   unsigned n_init = 0, n_finalize = 0;
-  dsk_assert (!cd->instantiated);
+  pthread_mutex_lock (&first_instance_lock);
+  if (cd->instantiated)
+    {
+      pthread_mutex_unlock (&first_instance_lock);
+      return;
+    }
   for (at = c; at; at = at->parent_class)
     {
       if (at->init)
@@ -171,10 +181,12 @@ void _dsk_object_class_first_instance (const DskObjectClass *c)
       if (at->finalize)
         *fat++ = at->finalize;
     }
-  cd->instantiated = DSK_TRUE;
-
   cd->prev_instantiated = all_instantiated_classes;
   all_instantiated_classes = c;
+
+  /* publish the funcs before the flag that dsk_object_new() tests */
+  __atomic_store_n (&cd->instantiated, DSK_TRUE, __ATOMIC_RELEASE);
+  pthread_mutex_unlock (&first_instance_lock);
 }
 
 
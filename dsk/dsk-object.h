@@ -135,7 +135,7 @@ DSK_INLINE_FUNC  void      *dsk_object_new   (const void *object_class)
   unsigned i, n;
   DskObjectInitFunc *funcs;
   _dsk_inline_assert (c->object_class_magic == DSK_OBJECT_CLASS_MAGIC);
-  if (!c->cache_data->instantiated)
+  if (!__atomic_load_n (&c->cache_data->instantiated, __ATOMIC_ACQUIRE))
     _dsk_object_class_first_instance (c);
   rv = dsk_malloc (c->sizeof_instance);
   rv->object_class = object_class;
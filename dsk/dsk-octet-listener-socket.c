@@ -248,6 +248,23 @@ retry_socket_syscall:
         /* ignore the failure. */
       }
   }
+  if (options->reuse_port && !options->is_local)
+    {
+#ifdef SO_REUSEPORT
+      int one = 1;
+      if (setsockopt (fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof (one)) < 0)
+        {
+          dsk_set_error (error, "setsockopt(SO_REUSEPORT) failed: %s",
+                         strerror (errno));
+          close (fd);
+          return NULL;
+        }
+#else
+      dsk_set_error (error, "SO_REUSEPORT not supported on this platform");
+      close (fd);
+      return NULL;
+#endif
+    }
 retry_bind_syscall:
   if (bind (fd, addr, addr_len) < 0)
     {
@@ -33,6 +33,11 @@ struct _DskOctetListenerSocketOptions
   int bind_port;
   const char *bind_iface;
   unsigned max_pending_connections;
+
+  /* Allow other sockets to bind the same port (SO_REUSEPORT);
+     the kernel spreads incoming connections across them.
+     Used for one listener per thread, see dsk_main_run_threads(). */
+  dsk_boolean reuse_port;
 };
 #define DSK_OCTET_LISTENER_SOCKET_OPTIONS_INIT               \
 {                                                               \
@@ -41,7 +46,8 @@ struct _DskOctetListenerSocketOptions
   DSK_IP_ADDRESS_INIT,               /* bind_address */      \
   0,                                    /* bind_port */         \
   NULL,                                 /* bind_iface */        \
-  128                                   /* max_pending_connections */ \
+  128,                                  /* max_pending_connections */ \
+  DSK_FALSE                             /* reuse_port */        \
 }
 
 DskOctetListener *dsk_octet_listener_socket_new (const DskOctetListenerSocketOptions *options,
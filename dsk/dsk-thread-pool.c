@@ -1 +1,371 @@
+#include <pthread.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+#include "dsk.h"
 
+/* --- the default class:  run in the foreground --- */
+static void
+dsk_thread_pool_foreground_run (DskThreadPool     *pool,
+                                DskThreadPoolFunc  background_func,
+                                DskThreadPoolResponseFunc done_func,
+                                void              *func_data)
+{
+  (void) pool;
+  void *result = background_func (func_data);
+  if (done_func != NULL)
+    done_func (result, func_data);
+}
+
+DSK_OBJECT_CLASS_DEFINE_CACHE_DATA(DskThreadPool);
+DskThreadPoolClass dsk_thread_pool_class =
+{
+  DSK_OBJECT_CLASS_DEFINE(DskThreadPool,
+                          &dsk_object_class,
+                          NULL,
+                          NULL),
+  dsk_thread_pool_foreground_run
+};
+
+void
+dsk_thread_pool_run (DskThreadPool     *pool,
+                     DskThreadPoolFunc  background_func,
+                     DskThreadPoolResponseFunc done_func,
+                     void              *func_data)
+{
+  DskThreadPoolClass *c = (DskThreadPoolClass *) pool->base_instance.object_class;
+  dsk_assert (background_func != NULL);
+  c->run (pool, background_func, done_func, func_data);
+}
+
+/* --- a work-stealing pool --- */
+typedef struct _Job Job;
+struct _Job
+{
+  DskThreadPoolFunc func;
+  DskThreadPoolResponseFunc done_func;
+  void *func_data;
+  void *result;
+  Job *next;                    /* in the done list */
+};
+
+/* A growable ring of jobs.  The owner pushes and pops at the
+   bottom;  thieves take from the top, so they get the oldest
+   (and typically largest) pieces of work. */
+typedef struct _Worker Worker;
+struct _Worker
+{
+  pthread_mutex_t lock;
+  Job **jobs;
+  size_t jobs_alloced;          /* a power of two */
+  size_t top;
+  size_t n_jobs;                /* written under the lock, peeked at without */
+
+  pthread_t thread;
+  struct _DskThreadPoolStealing *pool;
+  unsigned index;
+};
+
+typedef struct _DskThreadPoolStealingClass DskThreadPoolStealingClass;
+typedef struct _DskThreadPoolStealing DskThreadPoolStealing;
+struct _DskThreadPoolStealingClass
+{
+  DskThreadPoolClass base_class;
+};
+struct _DskThreadPoolStealing
+{
+  DskThreadPool base_instance;
+
+  unsigned n_workers;
+  Worker *workers;
+  unsigned next_worker;         /* for jobs from outside the pool */
+
+  /* sleeping */
+  pthread_mutex_t sleep_lock;
+  pthread_cond_t sleep_cond;
+  unsigned n_queued;            /* atomic */
+  unsigned n_sleeping;          /* atomic */
+  dsk_boolean shutting_down;
+
+  /* finished jobs, handed back to the dispatch through a pipe */
+  pthread_mutex_t done_lock;
+  Job *done_first, *done_last;
+  DskFileDescriptor wakeup_fds[2];
+  DskDispatch *dispatch;
+  unsigned n_pending;           /* atomic:  jobs whose done_func hasn't run */
+};
+
+static _Thread_local Worker *current_worker = NULL;
+
+static void
+worker_push (Worker *w, Job *job)
+{
+  pthread_mutex_lock (&w->lock);
+  if (w->n_jobs == w->jobs_alloced)
+    {
+      size_t new_alloced = w->jobs_alloced * 2;
+      Job **new_jobs = DSK_NEW_ARRAY (new_alloced, Job *);
+      for (size_t i = 0; i < w->n_jobs; i++)
+        new_jobs[i] = w->jobs[(w->top + i) & (w->jobs_alloced - 1)];
+      dsk_free (w->jobs);
+      w->jobs = new_jobs;
+      w->jobs_alloced = new_alloced;
+      w->top = 0;
+    }
+  w->jobs[(w->top + w->n_jobs) & (w->jobs_alloced - 1)] = job;
+  __atomic_store_n (&w->n_jobs, w->n_jobs + 1, __ATOMIC_RELAXED);
+  pthread_mutex_unlock (&w->lock);
+}
+
+static Job *
+worker_pop (Worker *w)
+{
+  Job *rv = NULL;
+  pthread_mutex_lock (&w->lock);
+  if (w->n_jobs > 0)
+    {
+      __atomic_store_n (&w->n_jobs, w->n_jobs - 1, __ATOMIC_RELAXED);
+      rv = w->jobs[(w->top + w->n_jobs) & (w->jobs_alloced - 1)];
+    }
+  pthread_mutex_unlock (&w->lock);
+  return rv;
+}
+
+static Job *
+worker_steal (Worker *w)
+{
+  Job *rv = NULL;
+  if (__atomic_load_n (&w->n_jobs, __ATOMIC_RELAXED) == 0)
+    return NULL;                /* don't bother locking */
+  pthread_mutex_lock (&w->lock);
+  if (w->n_jobs > 0)
+    {
+      rv = w->jobs[w->top];
+      w->top = (w->top + 1) & (w->jobs_alloced - 1);
+      __atomic_store_n (&w->n_jobs, w->n_jobs - 1, __ATOMIC_RELAXED);
+    }
+  pthread_mutex_unlock (&w->lock);
+  return rv;
+}
+
+static void
+pool_enqueue (DskThreadPoolStealing *pool, Worker *w, Job *job)
+{
+  worker_push (w, job);
+  __atomic_add_fetch (&pool->n_queued, 1, __ATOMIC_SEQ_CST);
+
+  /* A worker about to sleep counts itself as sleeping before it
+     looks at n_queued, so one of us sees the other. */
+  if (__atomic_load_n (&pool->n_sleeping, __ATOMIC_SEQ_CST) > 0)
+    {
+      pthread_mutex_lock (&pool->sleep_lock);
+      pthread_cond_signal (&pool->sleep_cond);
+      pthread_mutex_unlock (&pool->sleep_lock);
+    }
+}
+
+static Job *
+pool_take_job (DskThreadPoolStealing *pool, Worker *self)
+{
+  Job *job = worker_pop (self);
+  for (unsigned i = 1; job == NULL && i < pool->n_workers; i++)
+    job = worker_steal (pool->workers + (self->index + i) % pool->n_workers);
+  if (job != NULL)
+    __atomic_sub_fetch (&pool->n_queued, 1, __ATOMIC_SEQ_CST);
+  return job;
+}
+
+static void
+pool_finish_job (DskThreadPoolStealing *pool, Job *job)
+{
+  dsk_boolean was_empty;
+  job->next = NULL;
+  pthread_mutex_lock (&pool->done_lock);
+  was_empty = pool->done_first == NULL;
+  if (was_empty)
+    pool->done_first = job;
+  else
+    pool->done_last->next = job;
+  pool->done_last = job;
+  pthread_mutex_unlock (&pool->done_lock);
+
+  /* the dispatch drains the whole list, so one byte per batch will do */
+  if (was_empty)
+    {
+      char c = 0;
+      while (write (pool->wakeup_fds[1], &c, 1) < 0 && errno == EINTR)
+        ;
+    }
+}
+
+static void *
+worker_main (void *data)
+{
+  Worker *self = data;
+  DskThreadPoolStealing *pool = self->pool;
+  current_worker = self;
+  for (;;)
+    {
+      Job *job = pool_take_job (pool, self);
+      if (job != NULL)
+        {
+          job->result = job->func (job->func_data);
+          pool_finish_job (pool, job);
+          continue;
+        }
+
+      pthread_mutex_lock (&pool->sleep_lock);
+      __atomic_add_fetch (&pool->n_sleeping, 1, __ATOMIC_SEQ_CST);
+      while (__atomic_load_n (&pool->n_queued, __ATOMIC_SEQ_CST) == 0
+          && !pool->shutting_down)
+        pthread_cond_wait (&pool->sleep_cond, &pool->sleep_lock);
+      __atomic_sub_fetch (&pool->n_sleeping, 1, __ATOMIC_SEQ_CST);
+      dsk_boolean done = pool->shutting_down
+                      && __atomic_load_n (&pool->n_queued, __ATOMIC_SEQ_CST) == 0;
+      pthread_mutex_unlock (&pool->sleep_lock);
+      if (done)
+        break;
+    }
+  _dsk_buffer_cleanup_recycling_bin ();
+  return NULL;
+}
+
+static void
+handle_wakeup_fd_readable (DskFileDescriptor   fd,
+                           unsigned            events,
+                           void               *callback_data)
+{
+  DskThreadPoolStealing *pool = callback_data;
+  char buf[64];
+  Job *list;
+  (void) events;
+  while (read (fd, buf, sizeof (buf)) > 0)
+    ;
+
+  pthread_mutex_lock (&pool->done_lock);
+  list = pool->done_first;
+  pool->done_first = pool->done_last = NULL;
+  pthread_mutex_unlock (&pool->done_lock);
+
+  while (list != NULL)
+    {
+      Job *job = list;
+      list = job->next;
+      if (job->done_func != NULL)
+        job->done_func (job->result, job->func_data);
+      dsk_free (job);
+      if (__atomic_sub_fetch (&pool->n_pending, 1, __ATOMIC_ACQ_REL) == 0)
+        dsk_object_unref (pool);        /* may finalize the pool */
+    }
+}
+
+static void
+dsk_thread_pool_stealing_run (DskThreadPool     *pool,
+                              DskThreadPoolFunc  background_func,
+                              DskThreadPoolResponseFunc done_func,
+                              void              *func_data)
+{
+  DskThreadPoolStealing *p = (DskThreadPoolStealing *) pool;
+  Job *job = DSK_NEW (Job);
+  Worker *w = current_worker;
+  job->func = background_func;
+  job->done_func = done_func;
+  job->func_data = func_data;
+  job->result = NULL;
+
+  /* A worker's own job is pending while it runs, so n_pending
+     can only go from 0 (and take a ref) in the dispatch thread. */
+  if (__atomic_fetch_add (&p->n_pending, 1, __ATOMIC_ACQ_REL) == 0)
+    dsk_object_ref (p);
+  if (w == NULL || w->pool != p)
+    {
+      /* from the dispatch thread */
+      w = p->workers + p->next_worker;
+      p->next_worker = (p->next_worker + 1) % p->n_workers;
+    }
+  pool_enqueue (p, w, job);
+}
+
+static void
+dsk_thread_pool_stealing_init (DskThreadPoolStealing *pool)
+{
+  pthread_mutex_init (&pool->sleep_lock, NULL);
+  pthread_cond_init (&pool->sleep_cond, NULL);
+  pthread_mutex_init (&pool->done_lock, NULL);
+  pool->wakeup_fds[0] = pool->wakeup_fds[1] = -1;
+}
+
+static void
+dsk_thread_pool_stealing_finalize (DskThreadPoolStealing *pool)
+{
+  dsk_assert (pool->n_pending == 0);
+
+  pthread_mutex_lock (&pool->sleep_lock);
+  pool->shutting_down = DSK_TRUE;
+  pthread_cond_broadcast (&pool->sleep_cond);
+  pthread_mutex_unlock (&pool->sleep_lock);
+  for (unsigned i = 0; i < pool->n_workers; i++)
+    {
+      Worker *w = pool->workers + i;
+      pthread_join (w->thread, NULL);
+      pthread_mutex_destroy (&w->lock);
+      dsk_free (w->jobs);
+    }
+  dsk_free (pool->workers);
+
+  if (pool->wakeup_fds[0] >= 0)
+    {
+      dsk_dispatch_close_fd (pool->dispatch, pool->wakeup_fds[0]);
+      close (pool->wakeup_fds[1]);
+    }
+  pthread_mutex_destroy (&pool->sleep_lock);
+  pthread_cond_destroy (&pool->sleep_cond);
+  pthread_mutex_destroy (&pool->done_lock);
+}
+
+DSK_OBJECT_CLASS_DEFINE_CACHE_DATA(DskThreadPoolStealing);
+static DskThreadPoolStealingClass dsk_thread_pool_stealing_class =
+{
+  DSK_THREAD_POOL_CLASS_DEFINE(DskThreadPoolStealing, dsk_thread_pool_stealing)
+};
+
+DskThreadPool *
+dsk_thread_pool_new (unsigned n_threads)
+{
+  DskThreadPoolStealing *rv;
+  if (n_threads == 0)
+    {
+      long n_cpus = sysconf (_SC_NPROCESSORS_ONLN);
+      n_threads = n_cpus < 1 ? 1 : n_cpus;
+    }
+  rv = dsk_object_new (&dsk_thread_pool_stealing_class);
+  if (pipe (rv->wakeup_fds) < 0)
+    dsk_die ("error creating pipe for thread-pool: %s", strerror (errno));
+  dsk_fd_set_nonblocking (rv->wakeup_fds[0]);
+  dsk_fd_set_nonblocking (rv->wakeup_fds[1]);
+  dsk_fd_set_close_on_exec (rv->wakeup_fds[0]);
+  dsk_fd_set_close_on_exec (rv->wakeup_fds[1]);
+  rv->dispatch = dsk_dispatch_default ();
+  dsk_dispatch_watch_fd (rv->dispatch, rv->wakeup_fds[0], DSK_EVENT_READABLE,
+                         handle_wakeup_fd_readable, rv);
+
+  rv->n_workers = n_threads;
+  rv->workers = DSK_NEW0_ARRAY (n_threads, Worker);
+  for (unsigned i = 0; i < n_threads; i++)
+    {
+      Worker *w = rv->workers + i;
+      pthread_mutex_init (&w->lock, NULL);
+      w->jobs_alloced = 16;
+      w->jobs = DSK_NEW_ARRAY (w->jobs_alloced, Job *);
+      w->pool = rv;
+      w->index = i;
+    }
+  for (unsigned i = 0; i < n_threads; i++)
+    {
+      int err = pthread_create (&rv->workers[i].thread, NULL,
+                                worker_main, rv->workers + i);
+      if (err != 0)
+        dsk_die ("error creating thread-pool worker: %s", strerror (err));
+    }
+  return &rv->base_instance;
+}
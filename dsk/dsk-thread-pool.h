@@ -28,11 +28,26 @@ void dsk_thread_pool_run (DskThreadPool     *pool,
 // NOTE: the default class just runs background_func in
 // the foreground and is ONLY useful for debugging.
 
+// A pool of 'n_threads' workers (0 means one per online cpu).
+//
+// Each worker has its own deque of jobs:  it takes the newest job
+// from its own deque, and when that is empty, steals the oldest job
+// from another worker's.  Jobs submitted by a worker (from inside
+// a background_func) go onto that worker's deque; others are dealt
+// out round-robin.  Idle workers sleep.
+//
+// done_func is called from the dispatch of the thread that created
+// the pool, which is the only thread that may call dsk_thread_pool_run()
+// besides the workers.  The pool is kept alive while jobs are pending.
+DskThreadPool *dsk_thread_pool_new (unsigned n_threads);
+
+#define DSK_THREAD_POOL(object) DSK_OBJECT_CAST(DskThreadPool, object, &dsk_thread_pool_class)
+
 // macro for subclassing DskThreadPool
 #define DSK_THREAD_POOL_CLASS_DEFINE(name, lc_name)            \
   {                                                            \
     DSK_OBJECT_CLASS_DEFINE(name,                              \
-                            parent_class,                      \
+                            &dsk_thread_pool_class,            \
                             lc_name##_init,                    \
                             lc_name##_finalize),               \
     lc_name##_run                                              \
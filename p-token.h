@@ -11,6 +11,10 @@ typedef struct P_Context P_Context;
 
 P_Context * p_context_new (DBCC_Namespace *ns);
 
+/* The first syntax or semantic error since the last call, or NULL. */
+DBCC_Error *p_context_take_error (P_Context *context);
+void        p_context_free       (P_Context *context);
+
 struct P_Token
 {
   DBCC_CodePosition *code_position;
@@ -0,0 +1,308 @@
+/* Time the phases of the front end over a set of files.
+ *
+ * Each phase runs in a child process, so that its peak RSS
+ * can be reported separately (from wait4()).
+ *
+ *   scan-deps    directive layer only, as for "cc -M"
+ *   edit-replay  open each file as a document, then type and
+ *                delete a statement at 100 places, one
+ *                dbcc_parser_apply_edit() per keystroke
+ *
+ * and, with -p:
+ *
+ *   parse        full parse with type inference
+ *   parse-lazy   as parse, with lazy_function_bodies
+ *
+ * dbcc_parser_parse_file() can't get through ordinary code yet:
+ * it stops at the first #include, and function parameters are
+ * not in scope in the body.  So the parse phases time nothing
+ * useful on a corpus from mk-synthetic-corpus, and are only run
+ * when asked for.  The half-typed statements of edit-replay are
+ * expected to make some parse errors.
+ *
+ * A phase that runs longer than the timeout (-t, in seconds)
+ * is killed and reported as such.
+ *
+ * usage: bench-front-end [-p] [-n ITERATIONS] [-t SECONDS] [-I DIR]... FILE...
+ */
+#include "../dbcc.h"
+#include "../dsk/dsk.h"
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+typedef enum
+{
+  PHASE_SCAN_DEPS,
+  PHASE_PARSE,
+  PHASE_PARSE_LAZY,
+  PHASE_EDIT_REPLAY,
+} Phase;
+static const char *phase_names[] = { "scan-deps", "parse", "parse-lazy", "edit-replay" };
+#define N_PHASES 4
+
+/* x86-64 Linux */
+static DBCC_TargetEnvironment target_env = {
+  .is_char_signed = 1,
+  .is_wchar_signed = 1,
+  .sizeof_int = 4,
+  .sizeof_long_int = 8,
+  .sizeof_long_long_int = 8,
+  .sizeof_pointer = 8,
+  .alignof_int = 4,
+  .alignof_long_int = 8,
+  .alignof_long_long_int = 8,
+  .alignof_pointer = 8,
+  .sizeof_wchar = 4,
+  .alignof_int16 = 2,
+  .alignof_int32 = 4,
+  .alignof_int64 = 8,
+  .alignof_float = 4,
+  .alignof_double = 8,
+  .sizeof_long_double = 16,
+  .alignof_long_double = 16,
+  .sizeof_bool = 1,
+  .alignof_bool = 1,
+  .min_struct_alignof = 1,
+};
+
+static unsigned n_include_dirs = 0;
+static const char **include_dirs;
+static size_t n_errors;
+
+static void
+handle_statement (DBCC_Statement *stmt, void *handler_data)
+{
+  /* Statements live in the parser's region. */
+  (void) stmt;
+  (void) handler_data;
+}
+
+static void
+handle_error (DBCC_Error *error, void *handler_data)
+{
+  (void) handler_data;
+  if (n_errors++ == 0)
+    fprintf (stderr, "first error: %s\n", error->message);
+  dbcc_error_unref (error);
+}
+
+static DBCC_Parser *
+make_parser (Phase phase)
+{
+  DBCC_Parser_NewOptions options = DBCC_PARSER_NEW_OPTIONS;
+  options.target_env = &target_env;
+  options.handle_statement = handle_statement;
+  options.handle_error = handle_error;
+  options.lazy_function_bodies = (phase == PHASE_PARSE_LAZY);
+  DBCC_Parser *parser = dbcc_parser_new (&options);
+  for (unsigned i = 0; i < n_include_dirs; i++)
+    dbcc_parser_add_include_dir (parser, include_dirs[i]);
+  return parser;
+}
+
+static double
+now_seconds (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+typedef struct ReplayStats ReplayStats;
+struct ReplayStats
+{
+  size_t n_edits;
+  size_t n_dirty_spans;
+  double open_seconds;
+  double edit_seconds;
+  bool mismatch;
+};
+
+#define REPLAY_SITES 100
+
+static void
+replay_edits (DBCC_Parser *parser, const char *filename, ReplayStats *stats)
+{
+  DskError *error = NULL;
+  size_t size;
+  uint8_t *contents = dsk_file_get_contents (filename, &size, &error);
+  if (contents == NULL)
+    {
+      fprintf (stderr, "%s\n", error->message);
+      exit (1);
+    }
+  double start = now_seconds ();
+  dbcc_parser_open_document (parser, filename, size, contents);
+  stats->open_seconds += now_seconds () - start;
+
+  static const char typed[] = "n_edits += 1;\n";
+  size_t typed_len = sizeof (typed) - 1;
+  for (unsigned site = 0; site < REPLAY_SITES; site++)
+    {
+      size_t offset = (size_t) site * size / REPLAY_SITES;
+      while (offset > 0 && contents[offset - 1] != '\n')
+        offset--;
+
+      /* one character at a time, then delete the whole line */
+      for (size_t i = 0; i <= typed_len; i++)
+        {
+          DBCC_ParserEdit edit = i < typed_len
+                               ? (DBCC_ParserEdit) { offset + i, 0, 1, typed + i }
+                               : (DBCC_ParserEdit) { offset, typed_len, 0, "" };
+          start = now_seconds ();
+          dbcc_parser_apply_edit (parser, filename, &edit);
+          stats->edit_seconds += now_seconds () - start;
+          stats->n_edits++;
+
+          size_t n_spans;
+          const DBCC_ParserDeclSpan *spans = dbcc_parser_peek_decl_spans (parser, filename, &n_spans);
+          for (size_t s = 0; s < n_spans; s++)
+            if (spans[s].dirty)
+              stats->n_dirty_spans++;
+        }
+    }
+
+  /* The text is as it was, so the spans must match a fresh scan. */
+  size_t n_spans, n_fresh;
+  const DBCC_ParserDeclSpan *spans = dbcc_parser_peek_decl_spans (parser, filename, &n_spans);
+  dbcc_parser_open_document (parser, "(fresh)", size, contents);
+  const DBCC_ParserDeclSpan *fresh = dbcc_parser_peek_decl_spans (parser, "(fresh)", &n_fresh);
+  if (n_spans != n_fresh)
+    stats->mismatch = true;
+  for (size_t s = 0; !stats->mismatch && s < n_spans; s++)
+    if (spans[s].start != fresh[s].start
+     || spans[s].length != fresh[s].length
+     || spans[s].hash != fresh[s].hash
+     || spans[s].declared_name != fresh[s].declared_name)
+      stats->mismatch = true;
+  dbcc_parser_close_document (parser, "(fresh)");
+  dbcc_parser_close_document (parser, filename);
+  dsk_free (contents);
+}
+
+/* Runs in the child. */
+static void
+run_phase (Phase phase, unsigned n_iterations,
+           unsigned n_files, char **files)
+{
+  DBCC_ParserStats stats;
+  bool have_stats = false;
+  ReplayStats replay, best_replay;
+  double best = 0;
+  for (unsigned iter = 0; iter < n_iterations; iter++)
+    {
+      double start = now_seconds ();
+      memset (&replay, 0, sizeof (replay));
+      for (unsigned f = 0; f < n_files; f++)
+        {
+          DBCC_Parser *parser = make_parser (phase);
+          if (phase == PHASE_SCAN_DEPS)
+            {
+              DskBuffer out = DSK_BUFFER_INIT;
+              dbcc_parser_scan_dependencies (parser, files[f], NULL,
+                                             DBCC_DEPENDENCY_FORMAT_MAKE,
+                                             &out);
+              dsk_buffer_clear (&out);
+            }
+          else if (phase == PHASE_EDIT_REPLAY)
+            replay_edits (parser, files[f], &replay);
+          else
+            {
+              dbcc_parser_parse_file (parser, files[f]);
+              if (iter == 0 && f == 0)
+                {
+                  dbcc_parser_get_stats (parser, &stats);
+                  have_stats = true;
+                }
+            }
+          dbcc_parser_destroy (parser);
+        }
+      double elapsed = now_seconds () - start;
+      if (iter == 0 || elapsed < best)
+        {
+          best = elapsed;
+          best_replay = replay;
+        }
+    }
+
+  printf ("%-12s %10.3f ms", phase_names[phase], best * 1e3);
+  if (have_stats)
+    printf ("  %9zu nodes %9zu KiB in %zu chunks  %zu string bytes saved",
+            stats.nodes.n_allocs,
+            stats.nodes.bytes_used / 1024,
+            stats.nodes.n_chunks,
+            stats.constant_bytes_saved);
+  if (phase == PHASE_EDIT_REPLAY)
+    printf ("  open %.3f ms, %zu edits, %.2f us/edit, %.1f dirty spans/edit%s",
+            best_replay.open_seconds * 1e3,
+            best_replay.n_edits,
+            best_replay.edit_seconds * 1e6 / best_replay.n_edits,
+            (double) best_replay.n_dirty_spans / best_replay.n_edits,
+            best_replay.mismatch ? "  (SPANS DIFFER FROM A FRESH SCAN)" : "");
+  if (n_errors > 0)
+    printf ("  (%zu errors)", n_errors);
+  fflush (stdout);
+}
+
+int main(int argc, char **argv)
+{
+  unsigned n_iterations = 5;
+  unsigned timeout = 60;
+  bool parse_phases = false;
+  include_dirs = malloc (sizeof (char *) * argc);
+  int i;
+  for (i = 1; i < argc && argv[i][0] == '-'; i++)
+    {
+      if (strcmp (argv[i], "-n") == 0 && i + 1 < argc)
+        n_iterations = strtoul (argv[++i], NULL, 10);
+      else if (strcmp (argv[i], "-t") == 0 && i + 1 < argc)
+        timeout = strtoul (argv[++i], NULL, 10);
+      else if (strcmp (argv[i], "-p") == 0)
+        parse_phases = true;
+      else if (strcmp (argv[i], "-I") == 0 && i + 1 < argc)
+        include_dirs[n_include_dirs++] = argv[++i];
+      else
+        break;
+    }
+  if (i == argc || n_iterations == 0)
+    {
+      fprintf (stderr, "usage: %s [-p] [-n ITERATIONS] [-t SECONDS] [-I DIR]... FILE...\n", argv[0]);
+      return 1;
+    }
+
+  for (Phase phase = 0; phase < N_PHASES; phase++)
+    {
+      if (!parse_phases && (phase == PHASE_PARSE || phase == PHASE_PARSE_LAZY))
+        continue;
+      fflush (stdout);
+      pid_t pid = fork ();
+      if (pid < 0)
+        {
+          perror ("fork");
+          return 1;
+        }
+      if (pid == 0)
+        {
+          alarm (timeout);
+          run_phase (phase, n_iterations, argc - i, argv + i);
+          _exit (0);
+        }
+      int status;
+      struct rusage usage;
+      if (wait4 (pid, &status, 0, &usage) < 0)
+        {
+          perror ("wait4");
+          return 1;
+        }
+      if (WIFSIGNALED (status) && WTERMSIG (status) == SIGALRM)
+        printf ("%-12s timed out after %u s", phase_names[phase], timeout);
+      else if (!WIFEXITED (status) || WEXITSTATUS (status) != 0)
+        printf ("%-12s failed", phase_names[phase]);
+      printf ("  maxrss %ld KiB\n", usage.ru_maxrss);
+    }
+  return 0;
+}
@@ -0,0 +1,203 @@
+/* Generate a synthetic C translation unit for benchmarking the front end.
+ *
+ * The output is deterministic for a given seed, and is shaped like
+ * ordinary library code:  a main file including a set of headers,
+ * each with an include guard, object- and function-like macros,
+ * #if chains, typedefs, structs, enums and static inline helpers
+ * (most of which are never referenced), followed by function
+ * definitions with loops, switches, arithmetic and repeated
+ * string literals.
+ *
+ * usage: mk-synthetic-corpus DIR [N_FUNCTIONS [N_HEADERS [SEED]]]
+ *
+ * writes DIR/main.c and DIR/hdr-N.h.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+static uint64_t rand_state;
+
+static uint32_t
+rand_u32 (void)
+{
+  /* xorshift64* */
+  rand_state ^= rand_state >> 12;
+  rand_state ^= rand_state << 25;
+  rand_state ^= rand_state >> 27;
+  return (uint32_t) ((rand_state * 2685821657736338717ULL) >> 32);
+}
+
+static unsigned
+rand_range (unsigned n)
+{
+  return rand_u32 () % n;
+}
+
+static const char *binary_ops[] = { "+", "-", "*", "&", "|", "^", "<<", ">>" };
+#define N_BINARY_OPS (sizeof (binary_ops) / sizeof (binary_ops[0]))
+
+/* A few messages reused across the corpus, so that string pooling
+ * has something to find. */
+static const char *messages[] = {
+  "out of range",
+  "invalid argument",
+  "unexpected end of input",
+  "range",
+  "argument",
+};
+#define N_MESSAGES (sizeof (messages) / sizeof (messages[0]))
+
+static FILE *
+open_output (const char *dir, const char *name)
+{
+  char *path = malloc (strlen (dir) + strlen (name) + 2);
+  sprintf (path, "%s/%s", dir, name);
+  FILE *fp = fopen (path, "w");
+  if (fp == NULL)
+    {
+      fprintf (stderr, "error creating %s: %s\n", path, strerror (errno));
+      exit (1);
+    }
+  free (path);
+  return fp;
+}
+
+static void
+write_expr (FILE *fp, unsigned depth, unsigned n_vars)
+{
+  if (depth == 0 || rand_range (3) == 0)
+    {
+      if (rand_range (2) == 0)
+        fprintf (fp, "v%u", rand_range (n_vars));
+      else
+        fprintf (fp, "%u", rand_range (1000));
+      return;
+    }
+  fprintf (fp, "(");
+  write_expr (fp, depth - 1, n_vars);
+  fprintf (fp, " %s ", binary_ops[rand_range (N_BINARY_OPS)]);
+  write_expr (fp, depth - 1, n_vars);
+  fprintf (fp, ")");
+}
+
+static void
+write_header (const char *dir, unsigned h)
+{
+  char name[64];
+  sprintf (name, "hdr-%u.h", h);
+  FILE *fp = open_output (dir, name);
+
+  fprintf (fp, "#ifndef HDR_%u_H_\n#define HDR_%u_H_\n\n", h, h);
+  if (h > 0)
+    fprintf (fp, "#include \"hdr-%u.h\"\n\n", rand_range (h));
+
+  fprintf (fp, "#define H%u_LIMIT %u\n", h, 16 + rand_range (1000));
+  fprintf (fp, "#define H%u_SCALE(x) ((x) * %u + H%u_LIMIT)\n", h, 1 + rand_range (7), h);
+  fprintf (fp, "#if H%u_LIMIT > 500 && defined(HDR_%u_H_)\n", h, h);
+  fprintf (fp, "#  define H%u_BIG 1\n", h);
+  fprintf (fp, "#elif H%u_LIMIT > 100\n", h);
+  fprintf (fp, "#  define H%u_BIG 0\n", h);
+  fprintf (fp, "#else\n#  define H%u_BIG (-1)\n#endif\n\n", h);
+
+  fprintf (fp, "typedef enum\n{\n");
+  unsigned n_values = 3 + rand_range (8);
+  for (unsigned i = 0; i < n_values; i++)
+    fprintf (fp, "  H%u_KIND_%u,\n", h, i);
+  fprintf (fp, "} H%u_Kind;\n\n", h);
+
+  fprintf (fp, "typedef struct H%u_Node H%u_Node;\nstruct H%u_Node\n{\n", h, h, h);
+  fprintf (fp, "  H%u_Kind kind;\n  H%u_Node *next;\n", h, h);
+  unsigned n_members = 2 + rand_range (6);
+  for (unsigned i = 0; i < n_members; i++)
+    fprintf (fp, "  %s m%u;\n", rand_range (2) ? "int" : "unsigned long", i);
+  fprintf (fp, "};\n\n");
+
+  /* static inline helpers: typical of headers, mostly unused. */
+  unsigned n_inlines = 2 + rand_range (6);
+  for (unsigned i = 0; i < n_inlines; i++)
+    {
+      fprintf (fp, "static inline int\nh%u_helper%u (int v0, int v1, int v2)\n{\n", h, i);
+      fprintf (fp, "  int v3 = H%u_SCALE (v0);\n", h);
+      fprintf (fp, "  if (v3 > H%u_LIMIT)\n    return ", h);
+      write_expr (fp, 3, 4);
+      fprintf (fp, ";\n  return ");
+      write_expr (fp, 4, 4);
+      fprintf (fp, ";\n}\n\n");
+    }
+
+  fprintf (fp, "int h%u_process (H%u_Node *node, const char *why);\n\n", h, h);
+  fprintf (fp, "#endif\n");
+  fclose (fp);
+}
+
+static void
+write_function (FILE *fp, unsigned f, unsigned n_headers)
+{
+  unsigned h = rand_range (n_headers);
+  unsigned n_vars = 4 + rand_range (4);
+  fprintf (fp, "%sint\nfn%u (H%u_Node *node, int v0, int v1)\n{\n",
+           rand_range (4) == 0 ? "static " : "", f, h);
+  for (unsigned i = 2; i < n_vars; i++)
+    {
+      fprintf (fp, "  int v%u = ", i);
+      write_expr (fp, 2, i);
+      fprintf (fp, ";\n");
+    }
+  fprintf (fp, "  const char *msg = \"%s\";\n", messages[rand_range (N_MESSAGES)]);
+
+  fprintf (fp, "  for (int i = 0; i < H%u_LIMIT; i++)\n    {\n", h);
+  fprintf (fp, "      v%u += ", rand_range (n_vars));
+  write_expr (fp, 3, n_vars);
+  fprintf (fp, ";\n      if (v%u > %u)\n        break;\n    }\n", rand_range (n_vars), rand_range (10000));
+
+  fprintf (fp, "  switch (node->kind)\n    {\n");
+  fprintf (fp, "    case H%u_KIND_0:\n      v0 = h%u_helper0 (v0, v1, v2);\n      break;\n", h, h);
+  fprintf (fp, "    case H%u_KIND_1:\n      msg = \"%s\";\n      break;\n", h, messages[rand_range (N_MESSAGES)]);
+  fprintf (fp, "    default:\n      v1 = H%u_SCALE (v1);\n      break;\n    }\n", h);
+
+  fprintf (fp, "  while (node != 0 && v0 > 0)\n    {\n");
+  fprintf (fp, "      v0 -= node->m0 + 1;\n      node = node->next;\n    }\n");
+  fprintf (fp, "#if H%u_BIG > 0\n  v1 = h%u_process (node, msg);\n#endif\n", h, h);
+  fprintf (fp, "  return ");
+  write_expr (fp, 4, n_vars);
+  fprintf (fp, ";\n}\n\n");
+}
+
+int main(int argc, char **argv)
+{
+  if (argc < 2)
+    {
+      fprintf (stderr, "usage: %s DIR [N_FUNCTIONS [N_HEADERS [SEED]]]\n", argv[0]);
+      return 1;
+    }
+  const char *dir = argv[1];
+  unsigned n_functions = argc > 2 ? strtoul (argv[2], NULL, 10) : 1000;
+  unsigned n_headers = argc > 3 ? strtoul (argv[3], NULL, 10) : 20;
+  rand_state = argc > 4 ? strtoull (argv[4], NULL, 10) : 1;
+  if (rand_state == 0)
+    rand_state = 1;
+  if (n_headers == 0)
+    n_headers = 1;
+
+  if (mkdir (dir, 0777) < 0 && errno != EEXIST)
+    {
+      fprintf (stderr, "error creating %s: %s\n", dir, strerror (errno));
+      return 1;
+    }
+
+  for (unsigned h = 0; h < n_headers; h++)
+    write_header (dir, h);
+
+  FILE *fp = open_output (dir, "main.c");
+  for (unsigned h = 0; h < n_headers; h++)
+    fprintf (fp, "#include \"hdr-%u.h\"\n", h);
+  fprintf (fp, "\n");
+  for (unsigned f = 0; f < n_functions; f++)
+    write_function (fp, f, n_headers);
+  fclose (fp);
+  return 0;
+}
@@ -0,0 +1,212 @@
+#include "../dbcc.h"
+#include <stdio.h>
+#include <assert.h>
+#include <unistd.h>
+
+/* Write a small hand-built AST, map it back, and check that
+ * every field survives and that damaged files are refused.
+ *
+ *   struct node { struct node *next; int v; };
+ *   int x = 3 + 4;
+ *   f (x, x);
+ *   if (x) return x; else return 0;
+ */
+
+static DBCC_SymbolSpace *symbols;
+
+static DBCC_Symbol *
+sym (const char *name)
+{
+  return dbcc_symbol_space_force (symbols, name);
+}
+
+static DBCC_Type *
+new_type (DBCC_Type_Metatype metatype, const char *name, size_t size)
+{
+  DBCC_Type *type = calloc (1, sizeof (DBCC_Type));
+  type->metatype = metatype;
+  type->base.name = name ? sym (name) : NULL;
+  type->base.sizeof_instance = size;
+  type->base.alignof_instance = size;
+  return type;
+}
+
+static DBCC_Expr *
+new_expr (DBCC_Expr_Type expr_type, DBCC_Type *value_type)
+{
+  DBCC_Expr *expr = calloc (1, sizeof (DBCC_Expr));
+  expr->expr_type = expr_type;
+  expr->base.value_type = value_type;
+  return expr;
+}
+
+static DBCC_Expr *
+new_int (DBCC_Type *int_type, int32_t value)
+{
+  DBCC_Expr *expr = new_expr (DBCC_EXPR_TYPE_CONSTANT, int_type);
+  DBCC_Constant *c = calloc (1, sizeof (DBCC_Constant));
+  c->constant_type = DBCC_CONSTANT_TYPE_VALUE;
+  c->v_value.data = malloc (4);
+  memcpy (c->v_value.data, &value, 4);
+  expr->base.constant = c;
+  return expr;
+}
+
+static DBCC_Statement *
+new_statement (DBCC_StatementType type)
+{
+  DBCC_Statement *stmt = calloc (1, sizeof (DBCC_Statement));
+  stmt->type = type;
+  return stmt;
+}
+
+static int32_t
+get_int (const DBCC_AstFile *file, uint32_t index)
+{
+  const DBCC_AstFileNode *n = dbcc_ast_file_get_node (file, index);
+  assert (n->kind == DBCC_EXPR_TYPE_CONSTANT);
+  assert (n->flags & DBCC_AST_FILE_NODE_HAS_CONSTANT);
+  int32_t v;
+  memcpy (&v, file->constant_data + n->constant_offset, 4);
+  return v;
+}
+
+int main(void)
+{
+  static const char filename[] = "test-ast-file.ast";
+  symbols = dbcc_symbol_space_new ();
+
+  DBCC_Type *int_type = new_type (DBCC_TYPE_METATYPE_INT, "int", 4);
+  int_type->v_int.is_signed = true;
+  DBCC_Type *node_type = new_type (DBCC_TYPE_METATYPE_STRUCT, NULL, 16);
+  DBCC_Type *node_ptr_type = new_type (DBCC_TYPE_METATYPE_POINTER, NULL, 8);
+  node_ptr_type->v_pointer.target_type = node_type;
+  DBCC_TypeStructMember members[2] = {
+    { .type = node_ptr_type, .name = sym ("next"), .offset = 0 },
+    { .type = int_type, .name = sym ("v"), .offset = 8 },
+  };
+  node_type->v_struct.tag = sym ("node");
+  node_type->v_struct.n_members = 2;
+  node_type->v_struct.members = members;
+
+  DBCC_Statement *decl_node = new_statement (DBCC_STATEMENT_DECLARATION);
+  decl_node->v_declaration.type = node_type;
+
+  DBCC_Expr *sum = new_expr (DBCC_EXPR_TYPE_BINARY_OP, int_type);
+  sum->v_binary.op = DBCC_BINARY_OPERATOR_ADD;
+  sum->v_binary.a = new_int (int_type, 3);
+  sum->v_binary.b = new_int (int_type, 4);
+  DBCC_Statement *decl_x = new_statement (DBCC_STATEMENT_DECLARATION);
+  decl_x->v_declaration.type = int_type;
+  decl_x->v_declaration.name = sym ("x");
+  decl_x->v_declaration.opt_value = sum;
+  decl_x->v_declaration.storage_specs = DBCC_STORAGE_CLASS_SPECIFIER_STATIC;
+  DBCC_CodePosition cp = { .filename = sym ("t.c"), .line_no = 2, .column = 5 };
+  decl_x->base.code_position = &cp;
+
+  DBCC_Expr *x = new_expr (DBCC_EXPR_TYPE_IDENTIFIER, int_type);
+  x->v_identifier.name = sym ("x");
+  x->v_identifier.id_type = DBCC_IDENTIFIER_TYPE_GLOBAL;
+  DBCC_Expr *f = new_expr (DBCC_EXPR_TYPE_IDENTIFIER, NULL);
+  f->v_identifier.name = sym ("f");
+  DBCC_Expr *args[2] = { x, x };
+  DBCC_Expr *call = new_expr (DBCC_EXPR_TYPE_CALL, int_type);
+  call->v_call.head = f;
+  call->v_call.n_args = 2;
+  call->v_call.args = args;
+  DBCC_Statement *call_stmt = new_statement (DBCC_STATEMENT_EXPR);
+  call_stmt->v_expr.expr = call;
+
+  DBCC_Statement *ret_x = new_statement (DBCC_STATEMENT_RETURN);
+  ret_x->v_return.return_value = x;
+  DBCC_Statement *ret_0 = new_statement (DBCC_STATEMENT_RETURN);
+  ret_0->v_return.return_value = new_int (int_type, 0);
+  DBCC_Statement *if_stmt = new_statement (DBCC_STATEMENT_IF);
+  if_stmt->v_if.condition = x;
+  if_stmt->v_if.body = ret_x;
+  if_stmt->v_if.else_body = ret_0;
+  DBCC_Statement *stmts[2] = { call_stmt, if_stmt };
+  DBCC_Statement *block = new_statement (DBCC_STATEMENT_COMPOUND);
+  block->v_compound.n_statements = 2;
+  block->v_compound.statements = stmts;
+  block->v_compound.defines_scope = true;
+
+  DBCC_AstWriter *writer = dbcc_ast_writer_new ();
+  dbcc_ast_writer_add_statement (writer, decl_node);
+  dbcc_ast_writer_add_statement (writer, decl_x);
+  dbcc_ast_writer_add_statement (writer, block);
+  DBCC_Error *error = NULL;
+  assert (dbcc_ast_writer_write (writer, filename, &error));
+  dbcc_ast_writer_destroy (writer);
+
+  DBCC_AstFile *file = dbcc_ast_file_open (filename, &error);
+  assert (file != NULL);
+  assert (file->header->n_toplevel == 3);
+
+  /* struct node { struct node *next; int v; } */
+  const DBCC_AstFileNode *n = dbcc_ast_file_get_node (file, file->toplevel[0]);
+  assert (n->kind == DBCC_STATEMENT_DECLARATION);
+  const DBCC_AstFileType *t = dbcc_ast_file_get_type (file, n->type);
+  assert (t->metatype == DBCC_TYPE_METATYPE_STRUCT && t->count == 2);
+  assert (strcmp (dbcc_ast_file_get_string (file, t->name), "node") == 0);
+  const uint32_t *m = file->extra + t->extra;
+  const DBCC_AstFileType *next_type = dbcc_ast_file_get_type (file, m[0]);
+  assert (next_type->metatype == DBCC_TYPE_METATYPE_POINTER);
+  assert (next_type->target == n->type);                /* the cycle */
+  assert (strcmp (dbcc_ast_file_get_string (file, m[5]), "v") == 0);
+  assert (m[6] == 8);
+  assert (file->types[m[4]].flags & DBCC_AST_FILE_TYPE_SIGNED);
+
+  /* static int x = 3 + 4; */
+  n = dbcc_ast_file_get_node (file, file->toplevel[1]);
+  assert (n->kind == DBCC_STATEMENT_DECLARATION);
+  assert (n->op == DBCC_STORAGE_CLASS_SPECIFIER_STATIC);
+  assert (strcmp (dbcc_ast_file_get_string (file, n->name), "x") == 0);
+  assert (strcmp (dbcc_ast_file_get_string (file, n->filename), "t.c") == 0);
+  assert (n->line_no == 2 && n->column == 5);
+  const DBCC_AstFileNode *add = dbcc_ast_file_get_node (file, n->children[0]);
+  assert (add->kind == DBCC_EXPR_TYPE_BINARY_OP);
+  assert (add->op == DBCC_BINARY_OPERATOR_ADD);
+  assert (get_int (file, add->children[0]) == 3);
+  assert (get_int (file, add->children[1]) == 4);
+
+  /* { f (x, x);  if (x) return x; else return 0; } */
+  n = dbcc_ast_file_get_node (file, file->toplevel[2]);
+  assert (n->kind == DBCC_STATEMENT_COMPOUND && n->n_extra == 2);
+  assert (n->flags & DBCC_AST_FILE_NODE_DEFINES_SCOPE);
+  const uint32_t *body = dbcc_ast_file_get_node_extra (file, n);
+  const DBCC_AstFileNode *c = dbcc_ast_file_get_node (file, file->nodes[body[0]].children[0]);
+  assert (c->kind == DBCC_EXPR_TYPE_CALL && c->n_extra == 2);
+  const uint32_t *call_args = dbcc_ast_file_get_node_extra (file, c);
+  assert (call_args[0] == call_args[1]);                /* x, written once */
+  const DBCC_AstFileNode *xn = dbcc_ast_file_get_node (file, call_args[0]);
+  assert (xn->op == DBCC_IDENTIFIER_TYPE_GLOBAL);
+  const DBCC_AstFileNode *i = dbcc_ast_file_get_node (file, body[1]);
+  assert (i->kind == DBCC_STATEMENT_IF);
+  assert (i->children[0] == call_args[0]);
+  assert (file->nodes[i->children[1]].children[0] == call_args[0]);
+  assert (get_int (file, file->nodes[i->children[2]].children[0]) == 0);
+  dbcc_ast_file_close (file);
+
+  /* Damage a copy:  a child index pointing forward is refused. */
+  size_t size;
+  uint8_t *data = dsk_file_get_contents (filename, &size, NULL);
+  file = dbcc_ast_file_open_data (size, data, &error);
+  assert (file != NULL);
+  DBCC_AstFileNode *nodes = (DBCC_AstFileNode *) (data + file->header->nodes_offset);
+  uint32_t n_nodes = file->header->n_nodes;
+  dbcc_ast_file_close (file);
+  nodes[1].children[0] = n_nodes - 1;
+  assert (dbcc_ast_file_open_data (size, data, &error) == NULL);
+  assert (error->code == DBCC_ERROR_BAD_AST_FILE);
+  dbcc_error_unref (error);
+  error = NULL;
+  nodes[1].children[0] = 0;
+  assert (dbcc_ast_file_open_data (size - 8, data, &error) == NULL);
+  dbcc_error_unref (error);
+  free (data);
+  unlink (filename);
+
+  printf ("ast-file: ok\n");
+  return 0;
+}
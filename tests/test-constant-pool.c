@@ -0,0 +1,94 @@
+#include "../dbcc.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+/* Intern string literals in the global namespace's constant pool:
+ * duplicates share one entry, tails of longer literals are stored
+ * inside them, and the statistics agree with the layout.
+ */
+
+static DBCC_TargetEnvironment target_env = {
+  .is_char_signed = 1,
+  .is_wchar_signed = 1,
+  .sizeof_int = 4,
+  .sizeof_long_int = 8,
+  .sizeof_long_long_int = 8,
+  .sizeof_pointer = 8,
+  .alignof_int = 4,
+  .alignof_long_int = 8,
+  .alignof_long_long_int = 8,
+  .alignof_pointer = 8,
+  .sizeof_wchar = 4,
+  .alignof_int16 = 2,
+  .alignof_int32 = 4,
+  .alignof_int64 = 8,
+  .alignof_float = 4,
+  .alignof_double = 8,
+  .sizeof_long_double = 16,
+  .alignof_long_double = 16,
+  .sizeof_bool = 1,
+  .alignof_bool = 1,
+  .min_struct_alignof = 1,
+};
+
+static DBCC_Address *
+intern (DBCC_Namespace *ns, unsigned sizeof_elt, size_t length, const void *str)
+{
+  DBCC_String s = { length, sizeof_elt, false, (void *) str };
+  return dbcc_namespace_global_allocate_string (ns, &s);
+}
+
+static size_t
+offset_of (DBCC_Address *addr)
+{
+  return addr->v_global.address_offset;
+}
+
+int main()
+{
+  DBCC_SymbolSpace *space = dbcc_symbol_space_new ();
+  DBCC_Namespace *ns = dbcc_namespace_new_global (&target_env, space);
+  static const uint16_t u_ar[] = { 'a', 'r' };
+  DBCC_ConstantPoolStats stats;
+
+  DBCC_Address *foobar = intern (ns, 1, 6, "foobar");           /* 7 bytes */
+  assert (intern (ns, 1, 6, "foobar") == foobar);               /* 7 */
+  DBCC_Address *bar = intern (ns, 1, 3, "bar");                 /* 4, tail of foobar */
+  DBCC_Address *baz = intern (ns, 1, 3, "baz");                 /* 4 */
+  DBCC_Address *wide = intern (ns, 2, 2, u_ar);                 /* 6, other elt size */
+  assert (bar != foobar && baz != foobar && wide != bar);
+
+  dbcc_namespace_global_get_constant_stats (ns, &stats);
+  assert (stats.n_requests == 5);
+  assert (stats.n_unique == 4);
+  assert (stats.n_suffix_merged == 1);
+  assert (stats.bytes_requested == 7 + 7 + 4 + 4 + 6);
+  assert (stats.bytes_unique == 7 + 4 + 4 + 6);
+  assert (stats.bytes_allocated == 6 + 7 + 4);
+
+  /* getting the stats laid nothing out */
+  assert (offset_of (foobar) == 0 && offset_of (bar) == 0);
+  assert (offset_of (baz) == 0 && offset_of (wide) == 0);
+
+  assert (dbcc_namespace_global_layout_constants (ns) == stats.bytes_allocated);
+  assert (offset_of (bar) == offset_of (foobar) + 3);
+  assert (offset_of (baz) + 4 <= offset_of (foobar)
+       || offset_of (foobar) + 7 <= offset_of (baz));
+  assert (offset_of (wide) % 2 == 0);
+
+  /* a new tail after layout:  the stats count it,
+   * and the laid-out addresses stay as they were */
+  size_t foobar_offset = offset_of (foobar);
+  DBCC_Address *oobar = intern (ns, 1, 5, "oobar");
+  dbcc_namespace_global_get_constant_stats (ns, &stats);
+  assert (stats.n_unique == 5);
+  assert (stats.n_suffix_merged == 2);
+  assert (stats.bytes_requested == 28 + 6);
+  assert (stats.bytes_allocated == 17);
+  assert (offset_of (oobar) == 0);
+  assert (offset_of (foobar) == foobar_offset);
+
+  printf ("constant-pool: ok\n");
+  return 0;
+}
@@ -0,0 +1,342 @@
+#include "../dbcc.h"
+#include "../dsk/dsk.h"
+#include <stdio.h>
+#include <assert.h>
+
+/* Run dbcc_parser_scan_dependencies() over small files
+ * written to test-deps.tmp/, checking the dependency list,
+ * and so the #if evaluation that decides it.
+ */
+
+static const char dir[] = "test-deps.tmp";
+
+static DBCC_TargetEnvironment target_env = {
+  .is_char_signed = 1,
+  .is_wchar_signed = 1,
+  .sizeof_int = 4,
+  .sizeof_long_int = 8,
+  .sizeof_long_long_int = 8,
+  .sizeof_pointer = 8,
+  .alignof_int = 4,
+  .alignof_long_int = 8,
+  .alignof_long_long_int = 8,
+  .alignof_pointer = 8,
+  .sizeof_wchar = 4,
+  .alignof_int16 = 2,
+  .alignof_int32 = 4,
+  .alignof_int64 = 8,
+  .alignof_float = 4,
+  .alignof_double = 8,
+  .sizeof_long_double = 16,
+  .alignof_long_double = 16,
+  .sizeof_bool = 1,
+  .alignof_bool = 1,
+  .min_struct_alignof = 1,
+};
+
+static unsigned n_errors;
+
+static void
+handle_error (DBCC_Error *error, void *handler_data)
+{
+  (void) handler_data;
+  n_errors++;
+  dbcc_error_unref (error);
+}
+
+static void
+write_file (const char *name, const char *text)
+{
+  char *path = dsk_strdup_printf ("%s/%s", dir, name);
+  assert (dsk_file_set_contents (path, strlen (text), (const uint8_t *) text, NULL));
+  dsk_free (path);
+}
+
+static DBCC_Parser *
+new_parser (void)
+{
+  DBCC_Parser_NewOptions options = DBCC_PARSER_NEW_OPTIONS;
+  options.target_env = &target_env;
+  options.handle_error = handle_error;
+  DBCC_Parser *parser = dbcc_parser_new (&options);
+  char *inc = dsk_strdup_printf ("%s/inc", dir);
+  dbcc_parser_add_include_dir (parser, inc);
+  dsk_free (inc);
+  return parser;
+}
+
+/* Returns the make-format dependencies of 'name' as a string
+ * (which the caller must free), or NULL if the scan failed. */
+static char *
+scan (DBCC_Parser *parser, const char *name, DBCC_DependencyFormat format)
+{
+  char *path = dsk_strdup_printf ("%s/%s", dir, name);
+  DskBuffer out = DSK_BUFFER_INIT;
+  bool ok = dbcc_parser_scan_dependencies (parser, path, "t.o", format, &out);
+  dsk_free (path);
+  char *rv = dsk_buffer_empty_to_string (&out);
+  if (ok)
+    return rv;
+  free (rv);
+  return NULL;
+}
+
+static void
+assert_deps (DBCC_Parser *parser, const char *name, const char *expected)
+{
+  char *deps = scan (parser, name, DBCC_DEPENDENCY_FORMAT_MAKE);
+  if (deps == NULL || strcmp (deps, expected) != 0)
+    {
+      fprintf (stderr, "scanning %s:\ngot:\n%s\nexpected:\n%s\n",
+               name, deps ? deps : "(failed)", expected);
+      assert (0);
+    }
+  free (deps);
+}
+
+static void
+assert_scan_fails (DBCC_Parser *parser, const char *name)
+{
+  unsigned old_n_errors = n_errors;
+  char *deps = scan (parser, name, DBCC_DEPENDENCY_FORMAT_MAKE);
+  assert (deps == NULL);
+  assert (n_errors == old_n_errors + 1);
+}
+
+static void
+test_if_evaluation (DBCC_Parser *parser)
+{
+  write_file ("arith.c",
+              "#define N 3\n"
+              "#define TWICE(x) ((x) * 2)\n"
+              "#if N * 2 == 6 && TWICE(N) == 6 && -1 < 0 && (7 % 4) == 3\n"
+              "#include \"a.h\"\n"
+              "#endif\n"
+              "#if UNDEFINED_NAME || !defined N || (2 - 2)\n"
+              "#include \"b.h\"\n"
+              "#elif defined(TWICE) && 1 << 4 == 16\n"
+              "#include \"c.h\"\n"
+              "#else\n"
+              "#include \"b.h\"\n"
+              "#endif\n");
+  assert_deps (parser, "arith.c",
+               "t.o: test-deps.tmp/arith.c \\\n"
+               "  test-deps.tmp/a.h \\\n"
+               "  test-deps.tmp/c.h\n");
+
+  /* nested conditionals inside a false branch are skipped whole */
+  write_file ("nested.c",
+              "#if 0\n"
+              "# if 1\n"
+              "#include \"b.h\"\n"
+              "# endif\n"
+              "#elif 1\n"
+              "#include \"a.h\"\n"
+              "#endif\n");
+  assert_deps (parser, "nested.c",
+               "t.o: test-deps.tmp/nested.c \\\n"
+               "  test-deps.tmp/a.h\n");
+
+  /* integer suffixes, hex and octal */
+  write_file ("suffix.c",
+              "#if 10u == 10 && 1UL && 1L && 2ll == 2 && 5lu == 5 && 7LLU == 7\n"
+              "#if 0x10 == 16 && 0X1fULL == 31 && 010 == 8 && 0 == 0\n"
+              "#include \"a.h\"\n"
+              "#endif\n"
+              "#endif\n");
+  assert_deps (parser, "suffix.c",
+               "t.o: test-deps.tmp/suffix.c \\\n"
+               "  test-deps.tmp/a.h\n");
+
+  write_file ("bad-suffix.c", "#if 1f\n#endif\n");
+  assert_scan_fails (parser, "bad-suffix.c");
+  write_file ("float.c", "#if 1.5\n#endif\n");
+  assert_scan_fails (parser, "float.c");
+  write_file ("hex-float.c", "#if 0x1p3\n#endif\n");
+  assert_scan_fails (parser, "hex-float.c");
+
+  /* overflow and out-of-range shifts are defined, the same way by
+     the compiled form and by the slow path (taken for ID(...)) */
+  write_file ("overflow.c",
+              "#define MIN (-9223372036854775807 - 1)\n"
+              "#define ID(x) x\n"
+              "#if MIN / -1 == MIN && MIN % -1 == 0 && -MIN == MIN && MIN - 1 > 0 \\\n"
+              "    && 1 << 64 == 0 && -1 >> 70 == -1 && 1 << -1 == 0 && 8 >> -1 == 16\n"
+              "#include \"a.h\"\n"
+              "#endif\n"
+              "#if ID(MIN) / -1 == MIN && MIN % -1 == 0 && -MIN == MIN && MIN - 1 > 0 \\\n"
+              "    && 1 << 64 == 0 && -1 >> 70 == -1 && 1 << -1 == 0 && 8 >> -1 == 16\n"
+              "#include \"b.h\"\n"
+              "#endif\n");
+  assert_deps (parser, "overflow.c",
+               "t.o: test-deps.tmp/overflow.c \\\n"
+               "  test-deps.tmp/a.h \\\n"
+               "  test-deps.tmp/b.h\n");
+  write_file ("div-zero.c", "#if 1 / (2 - 2)\n#endif\n");
+  assert_scan_fails (parser, "div-zero.c");
+
+  /* 'defined E' is folded before the rest of the expression fails:
+     the tokens it released must not be released again */
+  write_file ("folded.c",
+              "#define E\n"
+              "#if defined(E) && 0x10 == 16\n"
+              "#include \"a.h\"\n"
+              "#endif\n");
+  assert_deps (parser, "folded.c",
+               "t.o: test-deps.tmp/folded.c \\\n"
+               "  test-deps.tmp/a.h\n");
+  write_file ("folded-bad.c",
+              "#define E\n"
+              "#if defined(E) && 1.5\n"
+              "#endif\n");
+  assert_scan_fails (parser, "folded-bad.c");
+  write_file ("folded-bad-elif.c",
+              "#define E\n"
+              "#if 0\n"
+              "#elif defined E && 1f\n"
+              "#endif\n");
+  assert_scan_fails (parser, "folded-bad-elif.c");
+}
+
+static void
+test_includes (DBCC_Parser *parser)
+{
+  /* header names keep their spaces */
+  write_file ("inc/with space.h", "");
+  write_file ("inc/sys.h", "#include <with space.h>\n");
+  write_file ("angle.c",
+              "#include <sys.h>\n"
+              "#define HDR \"a.h\"\n"
+              "#include HDR\n");
+  assert_deps (parser, "angle.c",
+               "t.o: test-deps.tmp/angle.c \\\n"
+               "  test-deps.tmp/inc/sys.h \\\n"
+               "  test-deps.tmp/inc/with\\ space.h \\\n"
+               "  test-deps.tmp/a.h\n");
+
+  /* an include-guarded header is listed once */
+  write_file ("twice.c",
+              "#include \"guarded.h\"\n"
+              "#include \"guarded.h\"\n");
+  assert_deps (parser, "twice.c",
+               "t.o: test-deps.tmp/twice.c \\\n"
+               "  test-deps.tmp/guarded.h \\\n"
+               "  test-deps.tmp/b.h\n");
+
+  write_file ("missing.c", "#include \"no-such-file.h\"\n");
+  assert_scan_fails (parser, "missing.c");
+
+  char *json = scan (parser, "nested.c", DBCC_DEPENDENCY_FORMAT_JSON);
+  assert (json != NULL);
+  assert (strcmp (json,
+                  "{\"target\":\"t.o\","
+                  "\"source\":\"test-deps.tmp/nested.c\","
+                  "\"dependencies\":[\"test-deps.tmp/a.h\"]}\n") == 0);
+  free (json);
+}
+
+/* Backslash-newlines may split any token of a directive line. */
+static void
+test_line_splices (DBCC_Parser *parser)
+{
+  write_file ("splices.c",
+              "#define LONG\\\n_NAME 4\\\n2\n"
+              "#if LONG_\\\nNAME == 4\\\n2 && 1 <\\\n< 3 == 8 && 'a\\\n' == 97\n"
+              "#inc\\\nlude \"a.\\\nh\"\n"
+              "#include <with \\\nspace.h>\n"
+              "#endif\n");
+  assert_deps (parser, "splices.c",
+               "t.o: test-deps.tmp/splices.c \\\n"
+               "  test-deps.tmp/a.h \\\n"
+               "  test-deps.tmp/inc/with\\ space.h\n");
+
+  /* the spliced text must still lex */
+  write_file ("bad-splice.c", "#if 'a\\\nb\n#endif\n");
+  assert_scan_fails (parser, "bad-splice.c");
+}
+
+/* Each scan is its own translation unit. */
+static void
+test_scans_are_independent (DBCC_Parser *parser)
+{
+  write_file ("defines.c",
+              "#define FOO 1\n"
+              "#include \"guarded.h\"\n");
+  write_file ("uses.c",
+              "#ifdef FOO\n"
+              "#include \"a.h\"\n"
+              "#endif\n"
+              "#include \"guarded.h\"\n");
+  assert_deps (parser, "defines.c",
+               "t.o: test-deps.tmp/defines.c \\\n"
+               "  test-deps.tmp/guarded.h \\\n"
+               "  test-deps.tmp/b.h\n");
+  assert_deps (parser, "uses.c",
+               "t.o: test-deps.tmp/uses.c \\\n"
+               "  test-deps.tmp/guarded.h \\\n"
+               "  test-deps.tmp/b.h\n");
+
+  /* The compiled form of foo-switch.h's #if is reused,
+     but evaluated against each file's macros. */
+  write_file ("foo-switch.h",
+              "#if FOO + 0 == 1\n"
+              "#include \"a.h\"\n"
+              "#else\n"
+              "#include \"b.h\"\n"
+              "#endif\n");
+  write_file ("switch-on.c",
+              "#define FOO 1\n"
+              "#include \"foo-switch.h\"\n");
+  write_file ("switch-off.c",
+              "#include \"foo-switch.h\"\n");
+  for (unsigned i = 0; i < 2; i++)
+    {
+      assert_deps (parser, "switch-on.c",
+                   "t.o: test-deps.tmp/switch-on.c \\\n"
+                   "  test-deps.tmp/foo-switch.h \\\n"
+                   "  test-deps.tmp/a.h\n");
+      assert_deps (parser, "switch-off.c",
+                   "t.o: test-deps.tmp/switch-off.c \\\n"
+                   "  test-deps.tmp/foo-switch.h \\\n"
+                   "  test-deps.tmp/b.h\n");
+    }
+
+  /* the same offset now holds a different expression */
+  write_file ("foo-switch.h",
+              "#if FOO + 0 != 1\n"
+              "#include \"a.h\"\n"
+              "#else\n"
+              "#include \"b.h\"\n"
+              "#endif\n");
+  assert_deps (parser, "switch-on.c",
+               "t.o: test-deps.tmp/switch-on.c \\\n"
+               "  test-deps.tmp/foo-switch.h \\\n"
+               "  test-deps.tmp/b.h\n");
+}
+
+int main()
+{
+  dsk_rm_rf (dir, NULL);
+  char *inc = dsk_strdup_printf ("%s/inc", dir);
+  assert (dsk_mkdir_recursive (inc, 0755, NULL));
+  dsk_free (inc);
+  write_file ("a.h", "");
+  write_file ("b.h", "");
+  write_file ("c.h", "");
+  write_file ("guarded.h",
+              "#ifndef GUARDED_H_\n"
+              "#define GUARDED_H_\n"
+              "#include \"b.h\"\n"
+              "#endif\n");
+
+  DBCC_Parser *parser = new_parser ();
+  test_if_evaluation (parser);
+  test_includes (parser);
+  test_line_splices (parser);
+  test_scans_are_independent (parser);
+  dbcc_parser_destroy (parser);
+
+  dsk_rm_rf (dir, NULL);
+  printf ("deps: ok\n");
+  return 0;
+}
@@ -0,0 +1,186 @@
+#include "../dbcc.h"
+#include "../dsk/dsk.h"
+#include <stdio.h>
+#include <assert.h>
+
+/* Edit an open document and check which declaration spans
+ * dbcc_parser_apply_edit() marks dirty.
+ */
+
+static const char filename[] = "doc.c";
+
+static DBCC_TargetEnvironment target_env = {
+  .is_char_signed = 1,
+  .is_wchar_signed = 1,
+  .sizeof_int = 4,
+  .sizeof_long_int = 8,
+  .sizeof_long_long_int = 8,
+  .sizeof_pointer = 8,
+  .alignof_int = 4,
+  .alignof_long_int = 8,
+  .alignof_long_long_int = 8,
+  .alignof_pointer = 8,
+  .sizeof_wchar = 4,
+  .alignof_int16 = 2,
+  .alignof_int32 = 4,
+  .alignof_int64 = 8,
+  .alignof_float = 4,
+  .alignof_double = 8,
+  .sizeof_long_double = 16,
+  .alignof_long_double = 16,
+  .sizeof_bool = 1,
+  .alignof_bool = 1,
+  .min_struct_alignof = 1,
+};
+
+static unsigned n_errors;
+
+static void
+handle_error (DBCC_Error *error, void *handler_data)
+{
+  (void) handler_data;
+  n_errors++;
+  dbcc_error_unref (error);
+}
+
+/* Replace the first occurrence of 'old' in the document. */
+static void
+edit (DBCC_Parser *parser, const char *old, const char *new_text)
+{
+  size_t size;
+  const char *text = dbcc_parser_peek_document_text (parser, filename, &size);
+  const char *at = strstr (text, old);
+  assert (at != NULL);
+  DBCC_ParserEdit e = { at - text, strlen (old), strlen (new_text), new_text };
+  assert (dbcc_parser_apply_edit (parser, filename, &e));
+}
+
+/* 'expected' lists the dirty spans by declared name
+ * ("#" for a directive), separated by spaces. */
+static void
+assert_dirty (DBCC_Parser *parser, const char *expected)
+{
+  size_t n_spans;
+  const DBCC_ParserDeclSpan *spans = dbcc_parser_peek_decl_spans (parser, filename, &n_spans);
+  DskBuffer buf = DSK_BUFFER_INIT;
+  for (size_t i = 0; i < n_spans; i++)
+    if (spans[i].dirty)
+      {
+        if (buf.size > 0)
+          dsk_buffer_append_byte (&buf, ' ');
+        dsk_buffer_append_string (&buf, spans[i].is_directive ? "#"
+                                  : spans[i].declared_name ? dbcc_symbol_get_string (spans[i].declared_name)
+                                  : "?");
+      }
+  char *dirty = dsk_buffer_empty_to_string (&buf);
+  if (strcmp (dirty, expected) != 0)
+    {
+      fprintf (stderr, "dirty spans: got \"%s\", expected \"%s\"\n", dirty, expected);
+      assert (0);
+    }
+  free (dirty);
+}
+
+static void
+open_document (DBCC_Parser *parser, const char *text)
+{
+  assert (dbcc_parser_open_document (parser, filename, strlen (text), (const uint8_t *) text));
+}
+
+static void
+test_changes (DBCC_Parser *parser)
+{
+  open_document (parser,
+                 "int a;\n"
+                 "int b = a;\n"
+                 "/* comment */\n"
+                 "int f(void) { return b; }\n"
+                 "const char *s = \"a b\";\n");
+  size_t n_spans;
+  dbcc_parser_peek_decl_spans (parser, filename, &n_spans);
+  assert (n_spans == 4);
+
+  /* whitespace and comments are not tokens */
+  edit (parser, "int b", "int   b");
+  assert_dirty (parser, "");
+  edit (parser, "comment", "longer comment");
+  assert_dirty (parser, "");
+  edit (parser, "}\nconst", "} // done\nconst");
+  assert_dirty (parser, "");
+
+  /* users of a changed declaration are dirty too;
+     names in string literals are not uses */
+  edit (parser, "= a;", "= a + 1;");
+  assert_dirty (parser, "b f");
+  edit (parser, "int a;", "long a;");
+  assert_dirty (parser, "a b");
+
+  /* a span that comes back unchanged is not dirty */
+  edit (parser, "long a;\n", "");
+  assert_dirty (parser, "b");
+  edit (parser, "int   b", "long a;\nint   b");
+  assert_dirty (parser, "a b");
+
+  /* splitting a token is a change, even with the same characters */
+  edit (parser, "return b;", "return b ;");
+  assert_dirty (parser, "");
+  edit (parser, "int f", "in t f");
+  assert_dirty (parser, "f");
+
+  dbcc_parser_close_document (parser, filename);
+}
+
+static void
+test_directives (DBCC_Parser *parser)
+{
+  open_document (parser,
+                 "int x;\n"
+                 "#define N 1\n"
+                 "int y = N;\n"
+                 "int z;\n");
+  edit (parser, "N 1", "N /* one */ 1");
+  assert_dirty (parser, "");
+  edit (parser, "N /* one */ 1", "N 2");
+  assert_dirty (parser, "# y z");
+  dbcc_parser_close_document (parser, filename);
+}
+
+/* Lexing errors are reported, but the edit is still applied. */
+static void
+test_lex_errors (DBCC_Parser *parser)
+{
+  open_document (parser,
+                 "int a;\n"
+                 "const char *s = \"x\";\n");
+  unsigned old_n_errors = n_errors;
+  edit (parser, "\"x\";", "\"x;");
+  assert (n_errors == old_n_errors + 1);
+  assert_dirty (parser, "s");
+  edit (parser, "\"x;", "\"x\";");
+  assert (n_errors == old_n_errors + 1);
+  assert_dirty (parser, "s");
+
+  size_t size;
+  const char *text = dbcc_parser_peek_document_text (parser, filename, &size);
+  assert (size == strlen (text));
+  assert (strcmp (text, "int a;\nconst char *s = \"x\";\n") == 0);
+
+  DBCC_ParserEdit bad = { size + 1, 0, 0, "" };
+  assert (!dbcc_parser_apply_edit (parser, filename, &bad));
+  assert (n_errors == old_n_errors + 2);
+  dbcc_parser_close_document (parser, filename);
+}
+
+int main()
+{
+  DBCC_Parser_NewOptions options = DBCC_PARSER_NEW_OPTIONS;
+  options.target_env = &target_env;
+  options.handle_error = handle_error;
+  DBCC_Parser *parser = dbcc_parser_new (&options);
+  test_changes (parser);
+  test_directives (parser);
+  test_lex_errors (parser);
+  dbcc_parser_destroy (parser);
+  printf ("document: ok\n");
+  return 0;
+}
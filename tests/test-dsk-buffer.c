@@ -0,0 +1,421 @@
+#include "../dsk/dsk.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+/* Writing DskBuffers to sockets, pipes and files, and searching them. */
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+#define FRAGMENT_SIZE 8
+
+static uint8_t
+pattern_byte (size_t i)
+{
+  return (uint8_t) (i * 7 + i / 251);
+}
+
+/* Append 'n' foreign fragments of FRAGMENT_SIZE bytes
+   (each its own fragment), holding pattern_byte(0...). */
+static uint8_t *
+append_foreign_fragments (DskBuffer *buffer, unsigned n)
+{
+  uint8_t *data = dsk_malloc (n * FRAGMENT_SIZE);
+  for (size_t i = 0; i < n * FRAGMENT_SIZE; i++)
+    data[i] = pattern_byte (i);
+  for (unsigned i = 0; i < n; i++)
+    dsk_buffer_append_foreign (buffer, FRAGMENT_SIZE, data + i * FRAGMENT_SIZE,
+                               NULL, NULL);
+  return data;
+}
+
+static void
+read_exactly (int fd, size_t length, uint8_t *out)
+{
+  size_t got = 0;
+  while (got < length)
+    {
+      ssize_t rv = read (fd, out + got, length - got);
+      assert (rv > 0);
+      got += rv;
+    }
+}
+
+static void
+assert_pattern (const uint8_t *data, size_t offset, size_t length)
+{
+  for (size_t i = 0; i < length; i++)
+    assert (data[i] == pattern_byte (offset + i));
+}
+
+/* More fragments than one writev() takes, and a limit that
+   ends inside a fragment:  exactly max_bytes are written, in order. */
+static void
+test_writev_batches (void)
+{
+  unsigned n_frags = IOV_MAX + 100;
+  size_t total = n_frags * FRAGMENT_SIZE;
+  unsigned max_bytes = total / 2 + 3;
+  int fds[2];
+  int rv = socketpair (AF_UNIX, SOCK_STREAM, 0, fds);
+  assert (rv == 0);
+
+  DskBuffer buffer = DSK_BUFFER_INIT;
+  uint8_t *data = append_foreign_fragments (&buffer, n_frags);
+  uint8_t *got = dsk_malloc (total);
+
+  rv = dsk_buffer_writev_len (&buffer, fds[0], max_bytes);
+  assert (rv == (int) max_bytes);
+  assert (buffer.size == total - max_bytes);
+  read_exactly (fds[1], max_bytes, got);
+  assert_pattern (got, 0, max_bytes);
+
+  uint8_t next;
+  assert (dsk_buffer_peek (&buffer, 1, &next) == 1);
+  assert (next == pattern_byte (max_bytes));
+
+  dsk_boolean ok = dsk_buffer_write_all_to_fd (&buffer, fds[0], NULL);
+  assert (ok);
+  read_exactly (fds[1], total - max_bytes, got);
+  assert_pattern (got, max_bytes, total - max_bytes);
+
+  dsk_free (got);
+  dsk_free (data);
+  close (fds[0]);
+  close (fds[1]);
+}
+
+/* A write that fails outright must not leave the socket corked. */
+static void
+test_uncork_after_error (void)
+{
+#ifdef TCP_CORK
+  struct sockaddr_in addr;
+  socklen_t addr_len = sizeof (addr);
+  memset (&addr, 0, sizeof (addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+  int listener = socket (AF_INET, SOCK_STREAM, 0);
+  if (listener < 0
+   || bind (listener, (struct sockaddr *) &addr, sizeof (addr)) < 0
+   || listen (listener, 1) < 0
+   || getsockname (listener, (struct sockaddr *) &addr, &addr_len) < 0)
+    {
+      fprintf (stderr, "no loopback TCP: skipping the cork test\n");
+      if (listener >= 0)
+        close (listener);
+      return;
+    }
+  int client = socket (AF_INET, SOCK_STREAM, 0);
+  int rv = connect (client, (struct sockaddr *) &addr, sizeof (addr));
+  assert (rv == 0);
+  int server = accept (listener, NULL, NULL);
+  assert (server >= 0);
+
+  /* reset the connection */
+  struct linger linger = { 1, 0 };
+  rv = setsockopt (server, SOL_SOCKET, SO_LINGER, &linger, sizeof (linger));
+  assert (rv == 0);
+  close (server);
+  usleep (10000);
+
+  DskBuffer buffer = DSK_BUFFER_INIT;
+  uint8_t *data = append_foreign_fragments (&buffer, IOV_MAX + 100);
+  rv = dsk_buffer_writev_len (&buffer, client, buffer.size);
+  assert (rv < 0);
+  assert (errno == ECONNRESET || errno == EPIPE);
+
+  int cork = -1;
+  socklen_t cork_len = sizeof (cork);
+  rv = getsockopt (client, IPPROTO_TCP, TCP_CORK, &cork, &cork_len);
+  assert (rv == 0);
+  assert (cork == 0);
+
+  dsk_buffer_clear (&buffer);
+  dsk_free (data);
+  close (client);
+  close (listener);
+#endif
+}
+
+/* --- file ranges --- */
+#define FILE_NAME       "test-dsk-buffer.tmp"
+#define FILE_SIZE       20000
+#define FILE_OFFSET     5001            /* not page-aligned */
+#define FILE_LENGTH     10000
+
+static const char head[] = "head:";
+static const char tail[] = ":tail";
+#define HEAD_LEN        (sizeof (head) - 1)
+#define TAIL_LEN        (sizeof (tail) - 1)
+#define TOTAL_LEN       (HEAD_LEN + FILE_LENGTH + TAIL_LEN)
+
+/* A file holding pattern_byte(0...FILE_SIZE-1). */
+static int
+open_pattern_file (void)
+{
+  uint8_t *data = dsk_malloc (FILE_SIZE);
+  for (size_t i = 0; i < FILE_SIZE; i++)
+    data[i] = pattern_byte (i);
+  int fd = open (FILE_NAME, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  assert (fd >= 0);
+  ssize_t rv = write (fd, data, FILE_SIZE);
+  assert (rv == FILE_SIZE);
+  dsk_free (data);
+  return fd;
+}
+
+/* The file range between two fragments in memory. */
+static void
+append_file_between (DskBuffer *buffer, int file_fd)
+{
+  dsk_buffer_append_string (buffer, head);
+  dsk_boolean ok = dsk_buffer_append_file (buffer, file_fd,
+                                           FILE_OFFSET, FILE_LENGTH, NULL);
+  assert (ok);
+  dsk_buffer_append_string (buffer, tail);
+  assert (buffer->size == TOTAL_LEN);
+}
+
+static void
+assert_file_between (const uint8_t *data)
+{
+  assert (memcmp (data, head, HEAD_LEN) == 0);
+  assert_pattern (data + HEAD_LEN, FILE_OFFSET, FILE_LENGTH);
+  assert (memcmp (data + HEAD_LEN + FILE_LENGTH, tail, TAIL_LEN) == 0);
+}
+
+/* Write it with a limit that ends inside the file range, then the
+   rest;  read it all back from 'read_fd'.  The file's own offset
+   is left alone. */
+static void
+write_file_between (int file_fd, int write_fd, int read_fd)
+{
+  DskBuffer buffer = DSK_BUFFER_INIT;
+  uint8_t *got = dsk_malloc (TOTAL_LEN);
+  unsigned max_bytes = HEAD_LEN + 100;
+  append_file_between (&buffer, file_fd);
+
+  int rv = dsk_buffer_writev_len (&buffer, write_fd, max_bytes);
+  assert (rv == (int) max_bytes);
+  assert (buffer.size == TOTAL_LEN - max_bytes);
+  dsk_boolean ok = dsk_buffer_write_all_to_fd (&buffer, write_fd, NULL);
+  assert (ok);
+  assert (buffer.size == 0);
+
+  read_exactly (read_fd, TOTAL_LEN, got);
+  assert_file_between (got);
+  assert (lseek (file_fd, 0, SEEK_CUR) == FILE_SIZE);
+  dsk_free (got);
+}
+
+/* To a socket, the range goes by sendfile(2). */
+static void
+test_file_to_socket (int file_fd)
+{
+  int fds[2];
+  int rv = socketpair (AF_UNIX, SOCK_STREAM, 0, fds);
+  assert (rv == 0);
+  write_file_between (file_fd, fds[0], fds[1]);
+  close (fds[0]);
+  close (fds[1]);
+}
+
+/* Linux takes sendfile(2) into a pipe too;  where it doesn't,
+   this goes the way of test_file_fallback(). */
+static void
+test_file_to_pipe (int file_fd)
+{
+  int fds[2];
+  int rv = pipe (fds);
+  assert (rv == 0);
+  write_file_between (file_fd, fds[1], fds[0]);
+  close (fds[0]);
+  close (fds[1]);
+}
+
+/* sendfile(2) refuses an O_APPEND destination,
+   so the range is written from its mapping instead. */
+static void
+test_file_fallback (int file_fd)
+{
+  int out_fd = open (FILE_NAME ".out", O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+  assert (out_fd >= 0);
+  int in_fd = open (FILE_NAME ".out", O_RDONLY);
+  assert (in_fd >= 0);
+  write_file_between (file_fd, out_fd, in_fd);
+  close (out_fd);
+  close (in_fd);
+  unlink (FILE_NAME ".out");
+}
+
+static void
+assert_append_file_fails (DskBuffer *buffer, int fd,
+                          uint64_t offset, uint64_t length)
+{
+  DskError *error = NULL;
+  unsigned old_size = buffer->size;
+  DskBufferFragment *old_last = buffer->last_frag;
+  assert (!dsk_buffer_append_file (buffer, fd, offset, length, &error));
+  assert (error != NULL);
+  dsk_error_unref (error);
+  assert (buffer->size == old_size);
+  assert (buffer->last_frag == old_last);
+  assert (old_last->next == NULL);
+}
+
+/* A failed append leaves the buffer as it was:  the memory and
+   file fragments already there are written out intact. */
+static void
+test_file_rollback (int file_fd)
+{
+  DskBuffer buffer = DSK_BUFFER_INIT;
+  int fds[2];
+  int rv = socketpair (AF_UNIX, SOCK_STREAM, 0, fds);
+  assert (rv == 0);
+
+  dsk_buffer_append_string (&buffer, head);
+  dsk_boolean ok = dsk_buffer_append_file (&buffer, file_fd,
+                                           FILE_OFFSET, FILE_LENGTH, NULL);
+  assert (ok);
+  assert_append_file_fails (&buffer, -1, 0, 100);               /* bad fd */
+  assert_append_file_fails (&buffer, fds[0], 0, 100);           /* can't be mapped */
+  assert_append_file_fails (&buffer, file_fd, 1ULL << 63, 100); /* bad offset */
+  assert_append_file_fails (&buffer, file_fd, 0, UINT_MAX);     /* overflow */
+  dsk_buffer_append_string (&buffer, tail);
+  assert (buffer.size == TOTAL_LEN);
+
+  uint8_t *got = dsk_malloc (TOTAL_LEN);
+  ok = dsk_buffer_write_all_to_fd (&buffer, fds[0], NULL);
+  assert (ok);
+  read_exactly (fds[1], TOTAL_LEN, got);
+  assert_file_between (got);
+  dsk_free (got);
+  close (fds[0]);
+  close (fds[1]);
+}
+
+/* --- searching --- */
+#define HAYSTACK_LEN    80
+
+/* Fragment lengths, ending with 0:  boundaries at, and either
+   side of, the 16-byte blocks the SSE2 search works in. */
+static const unsigned layouts[][8] = {
+  { 80, 0 },
+  { 16, 16, 16, 16, 16, 0 },
+  { 17, 15, 33, 15, 0 },
+  { 1, 47, 31, 1, 0 },
+  { 40, 40, 0 },
+};
+
+static const char *needles[] = { "ab", "aab", "abcdefghijklmnopq" };
+
+static int
+naive_index_of (const uint8_t *data, const char *str)
+{
+  size_t length = strlen (str);
+  for (size_t i = 0; i + length <= HAYSTACK_LEN; i++)
+    if (memcmp (data + i, str, length) == 0)
+      return i;
+  return -1;
+}
+
+/* The haystack in foreign fragments of the given lengths;  with
+   'native_head', the first of them is copied into the buffer. */
+static void
+append_layout (DskBuffer *buffer, const uint8_t *data,
+               const unsigned *layout, dsk_boolean native_head)
+{
+  size_t at = 0;
+  for (const unsigned *len = layout; *len != 0; len++)
+    {
+      if (native_head && len == layout)
+        dsk_buffer_append (buffer, *len, data);
+      else
+        dsk_buffer_append_foreign (buffer, *len, data + at, NULL, NULL);
+      at += *len;
+    }
+  assert (at == HAYSTACK_LEN);
+  assert (buffer->size == HAYSTACK_LEN);
+}
+
+/* Every needle at every position, in every layout (so at 15, 16
+   and 17 bytes from a fragment's end, and across boundaries),
+   over a background of stray first bytes:  the results agree
+   with a plain search of the flat haystack. */
+static void
+test_search (void)
+{
+  uint8_t data[HAYSTACK_LEN];
+  for (unsigned n = 0; n < DSK_N_ELEMENTS (needles); n++)
+    {
+      const char *needle = needles[n];
+      size_t length = strlen (needle);
+      char *one[] = { (char *) needle, NULL };
+      char *four[] = { "zq", "yq", "xq", (char *) needle, NULL };
+      char *five[] = { "zq", "yq", "xq", "wq", (char *) needle, NULL };
+      for (size_t pos = 0; pos + length <= HAYSTACK_LEN; pos++)
+        for (unsigned l = 0; l < DSK_N_ELEMENTS (layouts); l++)
+          for (int native_head = 0; native_head < 2; native_head++)
+            {
+              for (size_t i = 0; i < HAYSTACK_LEN; i++)
+                data[i] = i % 7 == 3 ? 'a' : '.';
+              memcpy (data + pos, needle, length);
+              int expected = naive_index_of (data, needle);
+              assert (expected >= 0 && expected <= (int) pos);
+
+              DskBuffer buffer = DSK_BUFFER_INIT;
+              append_layout (&buffer, data, layouts[l], native_head);
+              assert (dsk_buffer_str_index_of (&buffer, needle) == expected);
+              assert (dsk_buffer_polystr_index_of (&buffer, one) == expected);
+              assert (dsk_buffer_polystr_index_of (&buffer, four) == expected);
+              assert (dsk_buffer_polystr_index_of (&buffer, five) == expected);
+              assert (dsk_buffer_index_of (&buffer, needle[length - 1])
+                      == naive_index_of (data, needle + length - 1));
+              dsk_buffer_clear (&buffer);
+            }
+    }
+
+  /* and no match at all */
+  for (size_t i = 0; i < HAYSTACK_LEN; i++)
+    data[i] = i % 7 == 3 ? 'a' : '.';
+  for (unsigned l = 0; l < DSK_N_ELEMENTS (layouts); l++)
+    {
+      char *four[] = { "zq", "yq", "xq", "ab", NULL };
+      DskBuffer buffer = DSK_BUFFER_INIT;
+      append_layout (&buffer, data, layouts[l], DSK_FALSE);
+      assert (dsk_buffer_str_index_of (&buffer, "ab") == -1);
+      assert (dsk_buffer_polystr_index_of (&buffer, four) == -1);
+      dsk_buffer_clear (&buffer);
+    }
+}
+
+int main()
+{
+  signal (SIGPIPE, SIG_IGN);
+  test_writev_batches ();
+  test_uncork_after_error ();
+
+  int file_fd = open_pattern_file ();
+  test_file_to_socket (file_fd);
+  test_file_to_pipe (file_fd);
+  test_file_fallback (file_fd);
+  test_file_rollback (file_fd);
+  close (file_fd);
+  unlink (FILE_NAME);
+
+  test_search ();
+  printf ("dsk-buffer: ok\n");
+  return 0;
+}
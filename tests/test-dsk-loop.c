@@ -0,0 +1,178 @@
+#include "../dsk/dsk.h"
+#include <stdio.h>
+#include <assert.h>
+#include <unistd.h>
+
+/* Run the dsk main loop:  timers, fds watched from inside
+ * a callback, thread-pool jobs, and one loop per thread.
+ */
+
+/* dsk_main_run() only returns once per thread, and the main
+   thread's loop is run again by dsk_main_run_threads(). */
+static dsk_boolean done;
+
+static void
+run_until_done (void)
+{
+  done = DSK_FALSE;
+  while (!done)
+    dsk_main_run_once ();
+}
+
+/* --- timers --- */
+static unsigned timer_order[3];
+static unsigned n_timers_fired;
+
+static void
+handle_timer (void *data)
+{
+  timer_order[n_timers_fired++] = (unsigned) (size_t) data;
+  if (n_timers_fired == 3)
+    done = DSK_TRUE;
+}
+
+static void
+test_timers (void)
+{
+  dsk_main_add_timer_millis (30, handle_timer, (void *) 3);
+  dsk_main_add_timer_millis (10, handle_timer, (void *) 1);
+  DskDispatchTimer *removed = dsk_main_add_timer_millis (5, handle_timer, (void *) 9);
+  dsk_main_add_timer_millis (20, handle_timer, (void *) 2);
+  dsk_main_remove_timer (removed);
+  run_until_done ();
+  assert (n_timers_fired == 3);
+  assert (timer_order[0] == 1);
+  assert (timer_order[1] == 2);
+  assert (timer_order[2] == 3);
+}
+
+/* --- watching an fd from inside a callback --- */
+static int pipe_fds[2];
+static unsigned n_read;
+
+static void
+handle_readable (DskFileDescriptor fd, unsigned events, void *data)
+{
+  char c;
+  (void) data;
+  assert (events & DSK_EVENT_READABLE);
+  ssize_t n = read (fd, &c, 1);
+  assert (n == 1);
+  assert (c == 'x');
+  dsk_main_watch_fd (fd, 0, NULL, NULL);
+  n_read++;
+  done = DSK_TRUE;
+}
+
+static void
+handle_write_timer (void *data)
+{
+  (void) data;
+  dsk_main_watch_fd (pipe_fds[0], DSK_EVENT_READABLE, handle_readable, NULL);
+  ssize_t n = write (pipe_fds[1], "x", 1);
+  assert (n == 1);
+}
+
+static void
+test_watch_from_callback (void)
+{
+  int rv = pipe (pipe_fds);
+  assert (rv == 0);
+  dsk_fd_set_nonblocking (pipe_fds[0]);
+  dsk_main_add_timer_millis (1, handle_write_timer, NULL);
+  run_until_done ();
+  assert (n_read == 1);
+  dsk_main_close_fd (pipe_fds[0]);
+  close (pipe_fds[1]);
+}
+
+/* --- thread pool --- */
+#define N_JOBS 64
+#define N_SUBJOBS 4
+
+static DskThreadPool *pool;
+static unsigned n_done;
+static unsigned sum_done;
+
+static void *
+compute_square (void *data)
+{
+  size_t n = (size_t) data;
+  return (void *) (n * n);
+}
+
+static void
+handle_square_done (void *result, void *data)
+{
+  size_t n = (size_t) data;
+  assert ((size_t) result == n * n);
+  sum_done += (size_t) result;
+  if (++n_done == N_JOBS * (N_SUBJOBS + 1))
+    done = DSK_TRUE;
+}
+
+/* submits more jobs from inside a worker */
+static void *
+compute_and_spawn (void *data)
+{
+  for (size_t i = 0; i < N_SUBJOBS; i++)
+    dsk_thread_pool_run (pool, compute_square, handle_square_done, (void *) i);
+  return compute_square (data);
+}
+
+static void
+test_thread_pool (void)
+{
+  unsigned expected_sum = 0;
+  pool = dsk_thread_pool_new (4);
+  for (size_t i = 0; i < N_JOBS; i++)
+    {
+      dsk_thread_pool_run (pool, compute_and_spawn, handle_square_done, (void *) i);
+      expected_sum += i * i;
+      for (size_t j = 0; j < N_SUBJOBS; j++)
+        expected_sum += j * j;
+    }
+  run_until_done ();
+  assert (n_done == N_JOBS * (N_SUBJOBS + 1));
+  assert (sum_done == expected_sum);
+  dsk_object_unref (pool);
+}
+
+/* --- one loop per thread --- */
+#define N_LOOPS 3
+static unsigned n_loop_timers[N_LOOPS];
+
+static void
+handle_loop_timer (void *data)
+{
+  unsigned *count = data;
+  if (++*count < 3)
+    dsk_main_add_timer_millis (1, handle_loop_timer, count);
+  else
+    dsk_main_exit ((int) (count - n_loop_timers) + 10);
+}
+
+static void
+init_loop (unsigned thread_index, void *data)
+{
+  (void) data;
+  dsk_main_add_timer_millis (1, handle_loop_timer, n_loop_timers + thread_index);
+}
+
+static void
+test_run_threads (void)
+{
+  assert (dsk_main_run_threads (N_LOOPS, init_loop, NULL) == 10);
+  for (unsigned i = 0; i < N_LOOPS; i++)
+    assert (n_loop_timers[i] == 3);
+}
+
+int main()
+{
+  test_timers ();
+  test_watch_from_callback ();
+  test_thread_pool ();
+  test_run_threads ();
+  printf ("dsk-loop: ok\n");
+  return 0;
+}
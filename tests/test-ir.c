@@ -0,0 +1,923 @@
+#include "../dbcc.h"
+#include <stdio.h>
+#include <assert.h>
+#include <unistd.h>
+
+/* Build small functions by hand, run them with a tiny interpreter,
+ * and check that the passes keep their results while changing
+ * their shape.
+ */
+
+static DBCC_SymbolSpace *symbols;
+static DBCC_IR_Module *module;
+
+#define W       3                       /* 64-bit values throughout */
+#define R(r)    dbcc_location_reg (W, (r))
+#define I(v)    dbcc_location_immed (W, (v))
+
+static DBCC_Symbol *
+sym (const char *name)
+{
+  return dbcc_symbol_space_force (symbols, name);
+}
+
+/* --- Interpreter ---
+ *
+ * Registers are 8-byte slots;  a vector register is the run of
+ * consecutive slots starting at its number.
+ */
+static void *
+loc_address (int64_t *regs, const DBCC_Location *loc)
+{
+  switch (loc->type)
+    {
+    case DBCC_LOCATION_REG: return regs + loc->info.v_reg;
+    case DBCC_LOCATION_PTR: return (void *) (intptr_t) regs[loc->info.v_ptr];
+    default: assert (0); return NULL;
+    }
+}
+
+static int64_t
+sign_extend (const void *data, unsigned width)
+{
+  switch (width)
+    {
+    case 0: return * (const int8_t *) data;
+    case 1: { int16_t v; memcpy (&v, data, 2); return v; }
+    case 2: { int32_t v; memcpy (&v, data, 4); return v; }
+    case 3: { int64_t v; memcpy (&v, data, 8); return v; }
+    }
+  assert (0);
+  return 0;
+}
+
+static int64_t
+read_loc (int64_t *regs, const DBCC_Location *loc)
+{
+  if (loc->type == DBCC_LOCATION_IMMED)
+    return dbcc_location_get_immed (loc);
+  return sign_extend (loc_address (regs, loc), loc->width);
+}
+
+static void
+write_loc (int64_t *regs, const DBCC_Location *loc, int64_t v)
+{
+  if (loc->type == DBCC_LOCATION_REG)
+    regs[loc->info.v_reg] = sign_extend (&v, loc->width);
+  else
+    memcpy (loc_address (regs, loc), &v, 1 << loc->width);
+}
+
+static int64_t
+binop (DBCC_BinaryOperator op, int64_t a, int64_t b)
+{
+  switch (op)
+    {
+    case DBCC_BINARY_OPERATOR_ADD: return a + b;
+    case DBCC_BINARY_OPERATOR_SUB: return a - b;
+    case DBCC_BINARY_OPERATOR_MUL: return a * b;
+    case DBCC_BINARY_OPERATOR_DIV: return a / b;
+    case DBCC_BINARY_OPERATOR_REM: return a % b;
+    case DBCC_BINARY_OPERATOR_LT: return a < b;
+    case DBCC_BINARY_OPERATOR_LTEQ: return a <= b;
+    case DBCC_BINARY_OPERATOR_GT: return a > b;
+    case DBCC_BINARY_OPERATOR_GTEQ: return a >= b;
+    case DBCC_BINARY_OPERATOR_EQ: return a == b;
+    case DBCC_BINARY_OPERATOR_NE: return a != b;
+    case DBCC_BINARY_OPERATOR_SHIFT_LEFT: return a << b;
+    case DBCC_BINARY_OPERATOR_SHIFT_RIGHT: return a >> b;
+    case DBCC_BINARY_OPERATOR_BITWISE_AND: return a & b;
+    case DBCC_BINARY_OPERATOR_BITWISE_OR: return a | b;
+    case DBCC_BINARY_OPERATOR_BITWISE_XOR: return a ^ b;
+    default: assert (0); return 0;
+    }
+}
+
+
+static size_t n_executed;
+static DBCC_IR_Profile *profile_being_collected;
+
+static int64_t
+run (DBCC_Function *f, unsigned n_args, const int64_t *args)
+{
+  int64_t *regs = calloc (f->n_regs, sizeof (int64_t));
+  memcpy (regs, args, sizeof (int64_t) * n_args);
+  DBCC_BB *bb = f->entry;
+  DBCC_IR *ir = bb->first;
+  for (;;)
+    {
+      assert (ir != NULL);
+      n_executed++;
+      switch (ir->type)
+        {
+        case DBCC_IR_TYPE_UNARY:
+          {
+            DBCC_IR_Unary *u = (DBCC_IR_Unary *) ir;
+            if (u->dest.width > 3)
+              {
+                assert (u->op == DBCC_UNARY_OPERATOR_NOOP);
+                memcpy (loc_address (regs, &u->dest),
+                        loc_address (regs, &u->source),
+                        1 << u->dest.width);
+                break;
+              }
+            int64_t v = read_loc (regs, &u->source);
+            switch (u->op)
+              {
+              case DBCC_UNARY_OPERATOR_NOOP: break;
+              case DBCC_UNARY_OPERATOR_NEGATE: v = -v; break;
+              case DBCC_UNARY_OPERATOR_LOGICAL_NOT: v = !v; break;
+              case DBCC_UNARY_OPERATOR_BITWISE_NOT: v = ~v; break;
+              default: assert (0);
+              }
+            write_loc (regs, &u->dest, v);
+            break;
+          }
+        case DBCC_IR_TYPE_BINARY:
+          {
+            DBCC_IR_Binary *b = (DBCC_IR_Binary *) ir;
+            write_loc (regs, &b->dest, binop (b->op, read_loc (regs, &b->source1),
+                                              read_loc (regs, &b->source2)));
+            break;
+          }
+        case DBCC_IR_TYPE_VECTOR_BINARY:
+          {
+            DBCC_IR_VectorBinary *v = (DBCC_IR_VectorBinary *) ir;
+            unsigned ew = v->element_width, esize = 1 << ew;
+            uint8_t *dest = loc_address (regs, &v->dest);
+            const DBCC_Location *srcs[2] = { &v->source1, &v->source2 };
+            for (unsigned k = 0; k < (1U << v->dest.width) / esize; k++)
+              {
+                int64_t in[2];
+                for (unsigned s = 0; s < 2; s++)
+                  if (srcs[s]->width == v->dest.width)
+                    in[s] = sign_extend ((uint8_t *) loc_address (regs, srcs[s]) + k * esize, ew);
+                  else
+                    in[s] = read_loc (regs, srcs[s]);   /* broadcast */
+                int64_t out = binop (v->op, in[0], in[1]);
+                memcpy (dest + k * esize, &out, esize);
+              }
+            break;
+          }
+        case DBCC_IR_TYPE_JUMP:
+          ir = ((DBCC_IR_Jump *) ir)->dst->first;
+          continue;
+        case DBCC_IR_TYPE_JUMP_CONDITIONAL:
+          {
+            DBCC_IR_JumpConditional *j = (DBCC_IR_JumpConditional *) ir;
+            if (regs[j->reg] != 0)
+              {
+                ir = j->dst->first;
+                continue;
+              }
+            break;
+          }
+        case DBCC_IR_TYPE_CALL_BY_NAME:
+          {
+            DBCC_IR_CallByName *c = (DBCC_IR_CallByName *) ir;
+            if (c->name == sym (DBCC_IR_PROFILE_COUNT_FUNCTION))
+              {
+                dbcc_ir_profile_count (profile_being_collected,
+                                       read_loc (regs, c->args + 0),
+                                       read_loc (regs, c->args + 1));
+                break;
+              }
+            int64_t *call_args = calloc (c->n_args + 1, sizeof (int64_t));
+            for (unsigned i = 0; i < c->n_args; i++)
+              call_args[i] = read_loc (regs, c->args + i);
+            DBCC_Function *callee = dbcc_ir_module_lookup (module, c->name);
+            assert (callee != NULL);
+            int64_t rv = run (callee, c->n_args, call_args);
+            free (call_args);
+            if (c->has_result)
+              write_loc (regs, &c->result, rv);
+            break;
+          }
+        case DBCC_IR_TYPE_RETURN_VOID:
+          free (regs);
+          return 0;
+        case DBCC_IR_TYPE_RETURN_REG:
+          {
+            int64_t rv = regs[((DBCC_IR_ReturnReg *) ir)->reg];
+            free (regs);
+            return rv;
+          }
+        default:
+          assert (0);
+        }
+      ir = ir->next;
+    }
+}
+
+static int64_t
+run_by_name (const char *name, unsigned n_args, const int64_t *args)
+{
+  n_executed = 0;
+  return run (dbcc_ir_module_lookup (module, sym (name)), n_args, args);
+}
+
+static size_t
+count_calls (const char *name)
+{
+  DBCC_Function *f = dbcc_ir_module_lookup (module, sym (name));
+  size_t rv = 0;
+  for (unsigned i = 0; i < f->n_blocks; i++)
+    for (DBCC_IR *ir = f->blocks[i]->first; ir != NULL; ir = ir->next)
+      if (ir->type == DBCC_IR_TYPE_CALL_BY_NAME)
+        rv++;
+  return rv;
+}
+
+/* --- Functions under test --- */
+
+/* static inline int64 add1 (int64 x) { return x + 1; } */
+static void
+make_add1 (void)
+{
+  DBCC_Function *f = dbcc_function_new (sym ("add1"), 1,
+                                        DBCC_FUNCTION_FLAG_STATIC
+                                        | DBCC_FUNCTION_FLAG_INLINE_HINT);
+  DBCC_BB *bb = dbcc_function_add_block (f);
+  unsigned t = dbcc_function_add_reg (f);
+  dbcc_bb_append (bb, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, R(t), R(0), I(1)));
+  dbcc_bb_append (bb, dbcc_ir_new_return_reg (t));
+  dbcc_ir_module_add (module, f);
+}
+
+/* static int64 abs64 (int64 x) { if (x < 0) return -x; return x; } */
+static void
+make_abs (const char *name, DBCC_Function_Flags flags)
+{
+  DBCC_Function *f = dbcc_function_new (sym (name), 1, flags);
+  DBCC_BB *entry = dbcc_function_add_block (f);
+  DBCC_BB *neg = dbcc_function_add_block (f);
+  unsigned c = dbcc_function_add_reg (f);
+  unsigned t = dbcc_function_add_reg (f);
+  dbcc_bb_append (entry, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_LT, R(c), R(0), I(0)));
+  dbcc_bb_append (entry, dbcc_ir_new_jump_conditional (c, neg));
+  dbcc_bb_append (entry, dbcc_ir_new_return_reg (0));
+  dbcc_bb_append (neg, dbcc_ir_new_unary (DBCC_UNARY_OPERATOR_NEGATE, R(t), R(0)));
+  dbcc_bb_append (neg, dbcc_ir_new_return_reg (t));
+  dbcc_ir_module_add (module, f);
+}
+
+/* static int64 fact (int64 n) { return n <= 1 ? 1 : n * fact (n - 1); } */
+static void
+make_fact (void)
+{
+  DBCC_Function *f = dbcc_function_new (sym ("fact"), 1, DBCC_FUNCTION_FLAG_STATIC);
+  DBCC_BB *entry = dbcc_function_add_block (f);
+  DBCC_BB *base = dbcc_function_add_block (f);
+  unsigned c = dbcc_function_add_reg (f);
+  unsigned m = dbcc_function_add_reg (f);
+  unsigned r = dbcc_function_add_reg (f);
+  dbcc_bb_append (entry, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_LTEQ, R(c), R(0), I(1)));
+  dbcc_bb_append (entry, dbcc_ir_new_jump_conditional (c, base));
+  dbcc_bb_append (entry, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_SUB, R(m), R(0), I(1)));
+  DBCC_Location arg = R(m), result = R(r);
+  dbcc_bb_append (entry, dbcc_ir_new_call_by_name (sym ("fact"), 1, &arg, &result));
+  dbcc_bb_append (entry, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_MUL, R(r), R(r), R(0)));
+  dbcc_bb_append (entry, dbcc_ir_new_return_reg (r));
+  dbcc_bb_append (base, dbcc_ir_new_move (R(r), I(1)));
+  dbcc_bb_append (base, dbcc_ir_new_return_reg (r));
+  dbcc_ir_module_add (module, f);
+}
+
+/* A straight-line function of 'n_ops' additions. */
+static void
+make_big (const char *name, unsigned n_ops, DBCC_Function_Flags flags)
+{
+  DBCC_Function *f = dbcc_function_new (sym (name), 1, flags);
+  DBCC_BB *bb = dbcc_function_add_block (f);
+  unsigned t = dbcc_function_add_reg (f);
+  dbcc_bb_append (bb, dbcc_ir_new_move (R(t), R(0)));
+  for (unsigned i = 1; i < n_ops; i++)
+    dbcc_bb_append (bb, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, R(t), R(t), I(i)));
+  dbcc_bb_append (bb, dbcc_ir_new_return_reg (t));
+  dbcc_ir_module_add (module, f);
+}
+
+/* int64 NAME (int64 a) { return CALLEE (a) + 1; }  -- with a call to
+ * add1 after the call, to check the continuation block. */
+static void
+make_caller (const char *name, const char *callee)
+{
+  DBCC_Function *f = dbcc_function_new (sym (name), 1, 0);
+  DBCC_BB *bb = dbcc_function_add_block (f);
+  unsigned t = dbcc_function_add_reg (f);
+  unsigned u = dbcc_function_add_reg (f);
+  DBCC_Location arg = R(0), result = R(t);
+  dbcc_bb_append (bb, dbcc_ir_new_call_by_name (sym (callee), 1, &arg, &result));
+  arg = R(t);
+  result = R(u);
+  dbcc_bb_append (bb, dbcc_ir_new_call_by_name (sym ("add1"), 1, &arg, &result));
+  dbcc_bb_append (bb, dbcc_ir_new_return_reg (u));
+  dbcc_ir_module_add (module, f);
+}
+
+static void
+test_inline (void)
+{
+  module = dbcc_ir_module_new ();
+  make_add1 ();
+  make_abs ("abs64", DBCC_FUNCTION_FLAG_STATIC);
+  make_abs ("abs_noinline", DBCC_FUNCTION_FLAG_NOINLINE);
+  make_fact ();
+  make_big ("big_shared", 100, DBCC_FUNCTION_FLAG_STATIC);
+  make_big ("big_single", 100, DBCC_FUNCTION_FLAG_STATIC);
+  make_caller ("use_abs", "abs64");
+  make_caller ("use_noinline", "abs_noinline");
+  make_caller ("use_fact", "fact");
+  make_caller ("use_shared_1", "big_shared");
+  make_caller ("use_shared_2", "big_shared");
+  make_caller ("use_single", "big_single");
+
+  static const char *entry_points[] = {
+    "use_abs", "use_noinline", "use_fact",
+    "use_shared_1", "use_shared_2", "use_single"
+  };
+#define N_ENTRY_POINTS DSK_N_ELEMENTS (entry_points)
+  static const int64_t inputs[] = { -7, 0, 5 };
+#define N_INPUTS DSK_N_ELEMENTS (inputs)
+  int64_t expected[N_ENTRY_POINTS][N_INPUTS];
+  for (unsigned e = 0; e < N_ENTRY_POINTS; e++)
+    for (unsigned i = 0; i < N_INPUTS; i++)
+      expected[e][i] = run_by_name (entry_points[e], 1, inputs + i);
+  assert (expected[0][0] == 8);
+  assert (expected[2][2] == 121);
+
+  DBCC_IR_InlineOptions options = DBCC_IR_INLINE_OPTIONS_DEFAULT;
+  DBCC_IR_InlineStats stats;
+  dbcc_ir_module_inline (module, &options, &stats);
+
+  for (unsigned e = 0; e < N_ENTRY_POINTS; e++)
+    for (unsigned i = 0; i < N_INPUTS; i++)
+      assert (run_by_name (entry_points[e], 1, inputs + i) == expected[e][i]);
+
+  assert (count_calls ("use_abs") == 0);
+  assert (count_calls ("use_noinline") == 1);
+  assert (count_calls ("use_fact") == 1);       /* fact is inlined once... */
+  assert (count_calls ("fact") == 1);           /* ...but not into itself */
+  assert (count_calls ("use_shared_1") == 1);   /* too big for two callers */
+  assert (count_calls ("use_single") == 0);
+
+  /* abs64, big_single and add1 are gone;  fact survives because it
+   * still calls itself from use_fact's copy. */
+  assert (dbcc_ir_module_lookup (module, sym ("abs64")) == NULL);
+  assert (dbcc_ir_module_lookup (module, sym ("big_single")) == NULL);
+  assert (dbcc_ir_module_lookup (module, sym ("add1")) == NULL);
+  assert (dbcc_ir_module_lookup (module, sym ("big_shared")) != NULL);
+  assert (dbcc_ir_module_lookup (module, sym ("fact")) != NULL);
+  assert (stats.n_rejected_recursive == 1);
+  assert (stats.n_rejected_flags == 1);
+  assert (stats.n_rejected_cost == 2);
+  assert (stats.n_functions_removed == 3);
+
+  printf ("inline: %zu of %zu call sites inlined, %zu functions removed\n",
+          stats.n_inlined, stats.n_call_sites, stats.n_functions_removed);
+  dbcc_ir_module_destroy (module);
+}
+
+/* int64 NAME (int64 *a, int64 *b):
+ *   x = a[0];  b[0] = 5;  a[1] = 7;  y = a[0];  z = a[1];
+ *   return x + y + z;
+ */
+static DBCC_Function *
+make_loads (const char *name, DBCC_Function_ParamFlags flags)
+{
+  DBCC_Function *f = dbcc_function_new (sym (name), 2, 0);
+  dbcc_function_set_param_flags (f, 0, flags);
+  dbcc_function_set_param_flags (f, 1, flags);
+  DBCC_BB *bb = dbcc_function_add_block (f);
+  unsigned a1 = dbcc_function_add_reg (f);
+  unsigned x = dbcc_function_add_reg (f);
+  unsigned y = dbcc_function_add_reg (f);
+  unsigned z = dbcc_function_add_reg (f);
+  unsigned seven = dbcc_function_add_reg (f);
+  dbcc_bb_append (bb, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, R(a1), R(0), I(8)));
+  dbcc_bb_append (bb, dbcc_ir_new_move (R(x), dbcc_location_ptr (W, 0)));
+  dbcc_bb_append (bb, dbcc_ir_new_move (dbcc_location_ptr (W, 1), I(5)));
+  dbcc_bb_append (bb, dbcc_ir_new_move (R(seven), I(7)));
+  dbcc_bb_append (bb, dbcc_ir_new_move (dbcc_location_ptr (W, a1), R(seven)));
+  dbcc_bb_append (bb, dbcc_ir_new_move (R(y), dbcc_location_ptr (W, 0)));
+  dbcc_bb_append (bb, dbcc_ir_new_move (R(z), dbcc_location_ptr (W, a1)));
+  dbcc_bb_append (bb, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, R(x), R(x), R(y)));
+  dbcc_bb_append (bb, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, R(x), R(x), R(z)));
+  dbcc_bb_append (bb, dbcc_ir_new_return_reg (x));
+  dbcc_ir_module_add (module, f);
+  return f;
+}
+
+static void
+test_alias (void)
+{
+  module = dbcc_ir_module_new ();
+  DBCC_Function *plain = make_loads ("loads", 0);
+  DBCC_Function *restricted = make_loads ("loads_restrict", DBCC_FUNCTION_PARAM_RESTRICT);
+
+  DBCC_AliasInfo *info = dbcc_alias_info_new (restricted);
+  DBCC_Location a0 = dbcc_location_ptr (W, 0);
+  DBCC_Location b0 = dbcc_location_ptr (W, 1);
+  DBCC_Location a1 = dbcc_location_ptr (W, 2);
+  DBCC_Location a1_byte = dbcc_location_ptr (0, 2);
+  assert (dbcc_alias_info_query (info, &a0, &b0) == DBCC_ALIAS_NO);
+  assert (dbcc_alias_info_query (info, &a0, &a1) == DBCC_ALIAS_NO);
+  assert (dbcc_alias_info_query (info, &a1, &a1_byte) == DBCC_ALIAS_MAY);
+  dbcc_alias_info_destroy (info);
+  info = dbcc_alias_info_new (plain);
+  assert (dbcc_alias_info_query (info, &a0, &b0) == DBCC_ALIAS_MAY);
+  assert (dbcc_alias_info_query (info, &a0, &a1) == DBCC_ALIAS_NO);
+  dbcc_alias_info_destroy (info);
+
+  /* Without restrict, the store to b[0] may clobber a[0], so only
+   * the load of a[1] (from the store just before it) is forwarded. */
+  int64_t a[2] = { 100, 0 }, b[1] = { 0 };
+  int64_t args[2] = { (intptr_t) a, (intptr_t) b };
+  assert (dbcc_function_forward_loads (plain) == 1);
+  assert (dbcc_function_forward_loads (restricted) == 2);
+  assert (run_by_name ("loads", 2, args) == 207);
+  assert (run_by_name ("loads_restrict", 2, args) == 207);
+
+  /* Called with a == b, the unforwarded load sees the store. */
+  args[1] = args[0];
+  a[0] = 100;
+  assert (run_by_name ("loads", 2, args) == 112);
+
+  printf ("alias: ok\n");
+  dbcc_ir_module_destroy (module);
+}
+
+/* int64 NAME (int64 *a, int64 n):
+ *   s = 0;
+ *   for (i = 0; i < BOUND; i++)        BOUND is n, or 'bound' if nonzero
+ *     s += a[i] + n * 3;
+ *   return s;
+ */
+static void
+make_sum (const char *name, int64_t bound)
+{
+  DBCC_Function *f = dbcc_function_new (sym (name), 2, 0);
+  DBCC_BB *entry = dbcc_function_add_block (f);
+  DBCC_BB *header = dbcc_function_add_block (f);
+  DBCC_BB *body = dbcc_function_add_block (f);
+  DBCC_BB *exit = dbcc_function_add_block (f);
+  unsigned i = dbcc_function_add_reg (f);
+  unsigned s = dbcc_function_add_reg (f);
+  unsigned c = dbcc_function_add_reg (f);
+  unsigned off = dbcc_function_add_reg (f);
+  unsigned p = dbcc_function_add_reg (f);
+  unsigned v = dbcc_function_add_reg (f);
+  unsigned k = dbcc_function_add_reg (f);
+  dbcc_bb_append (entry, dbcc_ir_new_move (R(i), I(0)));
+  dbcc_bb_append (entry, dbcc_ir_new_move (R(s), I(0)));
+  dbcc_bb_append (entry, dbcc_ir_new_jump (header));
+  dbcc_bb_append (header, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_GTEQ, R(c), R(i),
+                                              bound ? I(bound) : R(1)));
+  dbcc_bb_append (header, dbcc_ir_new_jump_conditional (c, exit));
+  dbcc_bb_append (header, dbcc_ir_new_jump (body));
+  dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_SHIFT_LEFT, R(off), R(i), I(3)));
+  dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, R(p), R(0), R(off)));
+  dbcc_bb_append (body, dbcc_ir_new_move (R(v), dbcc_location_ptr (W, p)));
+  dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, R(s), R(s), R(v)));
+  dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_MUL, R(k), R(1), I(3)));
+  dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, R(s), R(s), R(k)));
+  dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, R(i), R(i), I(1)));
+  dbcc_bb_append (body, dbcc_ir_new_jump (header));
+  dbcc_bb_append (exit, dbcc_ir_new_return_reg (s));
+  dbcc_ir_module_add (module, f);
+}
+
+/* int64 NAME (int64 n):
+ *   s = 0;
+ *   for (j = 0; j < 3; j++) for (i = 0; i < 4; i++) s += n * 7;
+ *   return s;
+ */
+static void
+make_nested (const char *name)
+{
+  DBCC_Function *f = dbcc_function_new (sym (name), 1, 0);
+  DBCC_BB *entry = dbcc_function_add_block (f);
+  DBCC_BB *outer = dbcc_function_add_block (f);
+  DBCC_BB *outer_body = dbcc_function_add_block (f);
+  DBCC_BB *inner = dbcc_function_add_block (f);
+  DBCC_BB *inner_body = dbcc_function_add_block (f);
+  DBCC_BB *outer_latch = dbcc_function_add_block (f);
+  DBCC_BB *exit = dbcc_function_add_block (f);
+  unsigned j = dbcc_function_add_reg (f);
+  unsigned i = dbcc_function_add_reg (f);
+  unsigned s = dbcc_function_add_reg (f);
+  unsigned c = dbcc_function_add_reg (f);
+  unsigned x = dbcc_function_add_reg (f);
+  dbcc_bb_append (entry, dbcc_ir_new_move (R(j), I(0)));
+  dbcc_bb_append (entry, dbcc_ir_new_move (R(s), I(0)));
+  dbcc_bb_append (entry, dbcc_ir_new_jump (outer));
+  dbcc_bb_append (outer, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_GTEQ, R(c), R(j), I(3)));
+  dbcc_bb_append (outer, dbcc_ir_new_jump_conditional (c, exit));
+  dbcc_bb_append (outer, dbcc_ir_new_jump (outer_body));
+  dbcc_bb_append (outer_body, dbcc_ir_new_move (R(i), I(0)));
+  dbcc_bb_append (outer_body, dbcc_ir_new_jump (inner));
+  dbcc_bb_append (inner, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_GTEQ, R(c), R(i), I(4)));
+  dbcc_bb_append (inner, dbcc_ir_new_jump_conditional (c, outer_latch));
+  dbcc_bb_append (inner, dbcc_ir_new_jump (inner_body));
+  dbcc_bb_append (inner_body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_MUL, R(x), R(0), I(7)));
+  dbcc_bb_append (inner_body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, R(s), R(s), R(x)));
+  dbcc_bb_append (inner_body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, R(i), R(i), I(1)));
+  dbcc_bb_append (inner_body, dbcc_ir_new_jump (inner));
+  dbcc_bb_append (outer_latch, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, R(j), R(j), I(1)));
+  dbcc_bb_append (outer_latch, dbcc_ir_new_jump (outer));
+  dbcc_bb_append (exit, dbcc_ir_new_return_reg (s));
+  dbcc_ir_module_add (module, f);
+}
+
+/* void NAME (int64 *dst, int64 *src, int64 n):
+ *   for (i = 0; ; i++) { v = *src; if (i >= n) break; dst[i] = v; }
+ */
+static void
+make_fill (const char *name, DBCC_Function_ParamFlags flags)
+{
+  DBCC_Function *f = dbcc_function_new (sym (name), 3, 0);
+  dbcc_function_set_param_flags (f, 0, flags);
+  dbcc_function_set_param_flags (f, 1, flags);
+  DBCC_BB *entry = dbcc_function_add_block (f);
+  DBCC_BB *header = dbcc_function_add_block (f);
+  DBCC_BB *body = dbcc_function_add_block (f);
+  DBCC_BB *exit = dbcc_function_add_block (f);
+  unsigned i = dbcc_function_add_reg (f);
+  unsigned v = dbcc_function_add_reg (f);
+  unsigned c = dbcc_function_add_reg (f);
+  unsigned off = dbcc_function_add_reg (f);
+  unsigned p = dbcc_function_add_reg (f);
+  dbcc_bb_append (entry, dbcc_ir_new_move (R(i), I(0)));
+  dbcc_bb_append (entry, dbcc_ir_new_jump (header));
+  dbcc_bb_append (header, dbcc_ir_new_move (R(v), dbcc_location_ptr (W, 1)));
+  dbcc_bb_append (header, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_GTEQ, R(c), R(i), R(2)));
+  dbcc_bb_append (header, dbcc_ir_new_jump_conditional (c, exit));
+  dbcc_bb_append (header, dbcc_ir_new_jump (body));
+  dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_MUL, R(off), R(i), I(8)));
+  dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, R(p), R(0), R(off)));
+  dbcc_bb_append (body, dbcc_ir_new_move (dbcc_location_ptr (W, p), R(v)));
+  dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, R(i), R(i), I(1)));
+  dbcc_bb_append (body, dbcc_ir_new_jump (header));
+  dbcc_bb_append (exit, dbcc_ir_new_return_void ());
+  dbcc_ir_module_add (module, f);
+}
+
+static void
+test_loops (void)
+{
+  module = dbcc_ir_module_new ();
+  make_sum ("sum", 0);
+  make_sum ("sum10", 10);
+  make_nested ("nested");
+  make_fill ("fill", 0);
+  make_fill ("fill_restrict", DBCC_FUNCTION_PARAM_RESTRICT);
+
+  int64_t a[10];
+  for (unsigned i = 0; i < 10; i++)
+    a[i] = i * i;
+  int64_t sum_args[2] = { (intptr_t) a, 10 };
+  int64_t nested_args[1] = { 5 };
+  int64_t sum_expected = run_by_name ("sum", 2, sum_args);
+  assert (sum_expected == 285 + 10 * 30);
+  assert (run_by_name ("sum10", 2, sum_args) == sum_expected);
+  size_t sum10_executed = n_executed;
+  assert (run_by_name ("nested", 1, nested_args) == 12 * 35);
+  size_t nested_executed = n_executed;
+
+  DBCC_IR_LoopStats stats;
+  dbcc_function_optimize_loops (dbcc_ir_module_lookup (module, sym ("sum")), &stats);
+  assert (stats.n_loops == 1);
+  assert (stats.n_hoisted == 1);                /* n * 3 */
+  assert (stats.n_strength_reduced == 1);       /* i << 3 */
+  assert (stats.n_ivs_eliminated == 0);         /* the bound isn't constant */
+  assert (run_by_name ("sum", 2, sum_args) == sum_expected);
+
+  dbcc_function_optimize_loops (dbcc_ir_module_lookup (module, sym ("sum10")), &stats);
+  assert (stats.n_ivs_eliminated == 1);
+  assert (run_by_name ("sum10", 2, sum_args) == sum_expected);
+  assert (n_executed < sum10_executed - 5);     /* no increment of i */
+
+  dbcc_function_optimize_loops (dbcc_ir_module_lookup (module, sym ("nested")), &stats);
+  assert (stats.n_loops == 2);
+  assert (stats.n_hoisted == 2);                /* out of both loops */
+  assert (run_by_name ("nested", 1, nested_args) == 12 * 35);
+  assert (n_executed == nested_executed - 11);  /* once instead of 12 times */
+
+  /* The load of *src only leaves the loop when dst can't point at it. */
+  dbcc_function_optimize_loops (dbcc_ir_module_lookup (module, sym ("fill")), &stats);
+  assert (stats.n_hoisted == 0);
+  dbcc_function_optimize_loops (dbcc_ir_module_lookup (module, sym ("fill_restrict")), &stats);
+  assert (stats.n_hoisted == 1);
+  int64_t dst[4] = { 0, 0, 0, 0 }, src = 42;
+  int64_t fill_args[3] = { (intptr_t) dst, (intptr_t) &src, 4 };
+  run_by_name ("fill_restrict", 3, fill_args);
+  assert (dst[0] == 42 && dst[3] == 42);
+  fill_args[1] = (intptr_t) (dst + 1);
+  dst[1] = 7;
+  run_by_name ("fill", 3, fill_args);          /* src overlaps dst */
+  assert (dst[0] == 7 && dst[1] == 7 && dst[3] == 7);
+
+  /* A loop headed by the entry block gets a new entry block. */
+  DBCC_Function *f = dbcc_function_new (sym ("countdown"), 1, 0);
+  DBCC_BB *header = dbcc_function_add_block (f);
+  DBCC_BB *body = dbcc_function_add_block (f);
+  DBCC_BB *exit = dbcc_function_add_block (f);
+  unsigned x = dbcc_function_add_reg (f);
+  unsigned c = dbcc_function_add_reg (f);
+  dbcc_bb_append (header, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_MUL, R(x), I(5), I(9)));
+  dbcc_bb_append (header, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_LTEQ, R(c), R(0), I(0)));
+  dbcc_bb_append (header, dbcc_ir_new_jump_conditional (c, exit));
+  dbcc_bb_append (header, dbcc_ir_new_jump (body));
+  dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_SUB, R(0), R(0), I(1)));
+  dbcc_bb_append (body, dbcc_ir_new_jump (header));
+  dbcc_bb_append (exit, dbcc_ir_new_return_reg (x));
+  dbcc_ir_module_add (module, f);
+  dbcc_function_optimize_loops (f, &stats);
+  assert (stats.n_hoisted == 1);
+  assert (f->entry != header);
+  assert (run_by_name ("countdown", 1, nested_args) == 45);
+
+  printf ("loops: ok\n");
+  dbcc_ir_module_destroy (module);
+}
+
+/* int32 arrays.  Each variant is a two-block loop the way the
+ * front end lays out "for (i = 0; i < n; i++) ...":
+ *   VADD:     void (int32 *d, int32 *a, int32 *b, int64 n)   d[i] = (a[i] + b[i]) ^ 5
+ *   VMUL:     void (int32 *d, int32 *a, int64 n)             d[i] = a[i] * 3
+ *   INPLACE:  void (int32 *a, int64 n)                        a[i] = a[i] + 1
+ *   REDUCE:   int64 (int32 *a, int64 n)                       s += a[i]
+ */
+typedef enum { VADD, VMUL, INPLACE, REDUCE } VLoop;
+#define E(r)    dbcc_location_reg (2, (r))
+#define EP(r)   dbcc_location_ptr (2, (r))
+
+static void
+make_vloop (const char *name, VLoop which, DBCC_Function_ParamFlags flags)
+{
+  static const unsigned n_params[] = { 4, 3, 2, 2 };
+  unsigned n = n_params[which] - 1;
+  DBCC_Function *f = dbcc_function_new (sym (name), n_params[which], 0);
+  for (unsigned p = 0; p < n; p++)
+    dbcc_function_set_param_flags (f, p, flags);
+  DBCC_BB *entry = dbcc_function_add_block (f);
+  DBCC_BB *header = dbcc_function_add_block (f);
+  DBCC_BB *body = dbcc_function_add_block (f);
+  DBCC_BB *exit = dbcc_function_add_block (f);
+  unsigned i = dbcc_function_add_reg (f);
+  unsigned c = dbcc_function_add_reg (f);
+  unsigned s = dbcc_function_add_reg (f);
+  unsigned off = dbcc_function_add_reg (f);
+  unsigned y = dbcc_function_add_reg (f);
+  unsigned p[3], x[3];
+  for (unsigned k = 0; k < 3; k++)
+    {
+      p[k] = dbcc_function_add_reg (f);
+      x[k] = dbcc_function_add_reg (f);
+    }
+  dbcc_bb_append (entry, dbcc_ir_new_move (R(i), I(0)));
+  dbcc_bb_append (entry, dbcc_ir_new_move (R(s), I(0)));
+  dbcc_bb_append (entry, dbcc_ir_new_jump (header));
+  if (which == VMUL)
+    {
+      dbcc_bb_append (header, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_LT, R(c), R(i), R(n)));
+      dbcc_bb_append (header, dbcc_ir_new_jump_conditional (c, body));
+      dbcc_bb_append (header, dbcc_ir_new_jump (exit));
+    }
+  else
+    {
+      dbcc_bb_append (header, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_GTEQ, R(c), R(i), R(n)));
+      dbcc_bb_append (header, dbcc_ir_new_jump_conditional (c, exit));
+      dbcc_bb_append (header, dbcc_ir_new_jump (body));
+    }
+  if (which == VMUL)
+    dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_MUL, R(off), R(i), I(4)));
+  else
+    dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_SHIFT_LEFT, R(off), R(i), I(2)));
+  for (unsigned k = 0; k < n; k++)
+    dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, R(p[k]), R(k), R(off)));
+  switch (which)
+    {
+    case VADD:
+      dbcc_bb_append (body, dbcc_ir_new_move (E(x[1]), EP(p[1])));
+      dbcc_bb_append (body, dbcc_ir_new_move (E(x[2]), EP(p[2])));
+      dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, E(x[0]), E(x[1]), E(x[2])));
+      dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_BITWISE_XOR, E(y), E(x[0]), I(5)));
+      dbcc_bb_append (body, dbcc_ir_new_move (EP(p[0]), E(y)));
+      break;
+    case VMUL:
+      dbcc_bb_append (body, dbcc_ir_new_move (E(x[1]), EP(p[1])));
+      dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_MUL, E(x[0]), E(x[1]), I(3)));
+      dbcc_bb_append (body, dbcc_ir_new_move (EP(p[0]), E(x[0])));
+      break;
+    case INPLACE:
+      dbcc_bb_append (body, dbcc_ir_new_move (E(x[0]), EP(p[0])));
+      dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, E(x[1]), E(x[0]), I(1)));
+      dbcc_bb_append (body, dbcc_ir_new_move (EP(p[0]), E(x[1])));
+      break;
+    case REDUCE:
+      dbcc_bb_append (body, dbcc_ir_new_move (E(x[0]), EP(p[0])));
+      dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, R(s), R(s), E(x[0])));
+      break;
+    }
+  dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, R(i), R(i), I(1)));
+  dbcc_bb_append (body, dbcc_ir_new_jump (header));
+  dbcc_bb_append (exit, dbcc_ir_new_return_reg (s));
+  dbcc_ir_module_add (module, f);
+}
+
+static size_t
+vectorize (const char *name, unsigned vector_size)
+{
+  DBCC_TargetEnvironment env;
+  memset (&env, 0, sizeof (env));
+  env.max_vector_size = vector_size;
+  return dbcc_function_vectorize_loops (dbcc_ir_module_lookup (module, sym (name)), &env);
+}
+
+static void
+test_vectorize (void)
+{
+  module = dbcc_ir_module_new ();
+  make_vloop ("vadd", VADD, DBCC_FUNCTION_PARAM_RESTRICT);
+  make_vloop ("vadd_may_alias", VADD, 0);
+  make_vloop ("vmul", VMUL, DBCC_FUNCTION_PARAM_RESTRICT);
+  make_vloop ("vmul_avx2", VMUL, DBCC_FUNCTION_PARAM_RESTRICT);
+  make_vloop ("inplace", INPLACE, 0);
+  make_vloop ("reduce", REDUCE, 0);
+
+  enum { N = 37 };
+  int32_t a[N], b[N], d[N];
+  for (unsigned i = 0; i < N; i++)
+    {
+      a[i] = i * 1000003 - 7;
+      b[i] = 0x7ffffff0 + i;            /* overflows 32 bits when added */
+    }
+  int64_t vadd_args[4] = { (intptr_t) d, (intptr_t) a, (intptr_t) b, N };
+  int64_t vmul_args[3] = { (intptr_t) d, (intptr_t) a, N };
+  int64_t a_args[2] = { (intptr_t) a, N };
+
+  run_by_name ("vadd", 4, vadd_args);
+  size_t vadd_executed = n_executed;
+  assert (vectorize ("vadd", 0) == 0);
+  assert (vectorize ("vadd", DBCC_TARGET_VECTOR_SIZE_SSE2) == 1);
+  memset (d, 0, sizeof (d));
+  run_by_name ("vadd", 4, vadd_args);
+  for (unsigned i = 0; i < N; i++)
+    assert (d[i] == ((int32_t) ((uint32_t) a[i] + (uint32_t) b[i]) ^ 5));
+  assert (n_executed < vadd_executed / 2);
+
+  /* d might be a or b shifted by an element */
+  assert (vectorize ("vadd_may_alias", DBCC_TARGET_VECTOR_SIZE_AVX2) == 0);
+
+  /* 32-bit multiply needs AVX2 */
+  assert (vectorize ("vmul", DBCC_TARGET_VECTOR_SIZE_SSE2) == 0);
+  assert (vectorize ("vmul_avx2", DBCC_TARGET_VECTOR_SIZE_AVX2) == 1);
+  run_by_name ("vmul_avx2", 3, vmul_args);
+  for (unsigned i = 0; i < N; i++)
+    assert (d[i] == (int32_t) ((uint32_t) a[i] * 3));
+
+  /* the same address register for the load and the store */
+  int32_t orig[N];
+  memcpy (orig, a, sizeof (a));
+  assert (vectorize ("inplace", DBCC_TARGET_VECTOR_SIZE_SSE2) == 1);
+  run_by_name ("inplace", 2, a_args);
+  for (unsigned i = 0; i < N; i++)
+    assert (a[i] == orig[i] + 1);
+  a_args[1] = 3;                        /* shorter than a vector */
+  run_by_name ("inplace", 2, a_args);
+  assert (a[2] == orig[2] + 2 && a[3] == orig[3] + 1);
+
+  /* s is carried from one iteration to the next */
+  assert (vectorize ("reduce", DBCC_TARGET_VECTOR_SIZE_AVX2) == 0);
+
+  printf ("vectorize: ok\n");
+  dbcc_ir_module_destroy (module);
+}
+
+/* int64 driver (int64 n):
+ *   for (i = 0; i < n; i++) {
+ *     s += big (i);
+ *     if (i == -1) s += abs_cold (i);
+ *   }
+ */
+static void
+make_driver (void)
+{
+  DBCC_Function *f = dbcc_function_new (sym ("driver"), 1, 0);
+  DBCC_BB *entry = dbcc_function_add_block (f);
+  DBCC_BB *header = dbcc_function_add_block (f);
+  DBCC_BB *body = dbcc_function_add_block (f);
+  DBCC_BB *cold = dbcc_function_add_block (f);
+  DBCC_BB *latch = dbcc_function_add_block (f);
+  DBCC_BB *exit = dbcc_function_add_block (f);
+  unsigned i = dbcc_function_add_reg (f);
+  unsigned s = dbcc_function_add_reg (f);
+  unsigned c = dbcc_function_add_reg (f);
+  unsigned t = dbcc_function_add_reg (f);
+  DBCC_Location arg = R(i), result = R(t);
+  dbcc_bb_append (entry, dbcc_ir_new_move (R(i), I(0)));
+  dbcc_bb_append (entry, dbcc_ir_new_move (R(s), I(0)));
+  dbcc_bb_append (entry, dbcc_ir_new_jump (header));
+  dbcc_bb_append (header, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_GTEQ, R(c), R(i), R(0)));
+  dbcc_bb_append (header, dbcc_ir_new_jump_conditional (c, exit));
+  dbcc_bb_append (header, dbcc_ir_new_jump (body));
+  dbcc_bb_append (body, dbcc_ir_new_call_by_name (sym ("big"), 1, &arg, &result));
+  dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, R(s), R(s), R(t)));
+  dbcc_bb_append (body, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_EQ, R(c), R(i), I(-1)));
+  dbcc_bb_append (body, dbcc_ir_new_jump_conditional (c, cold));
+  dbcc_bb_append (body, dbcc_ir_new_jump (latch));
+  dbcc_bb_append (cold, dbcc_ir_new_call_by_name (sym ("abs_cold"), 1, &arg, &result));
+  dbcc_bb_append (cold, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, R(s), R(s), R(t)));
+  dbcc_bb_append (cold, dbcc_ir_new_jump (latch));
+  dbcc_bb_append (latch, dbcc_ir_new_binary (DBCC_BINARY_OPERATOR_ADD, R(i), R(i), I(1)));
+  dbcc_bb_append (latch, dbcc_ir_new_jump (header));
+  dbcc_bb_append (exit, dbcc_ir_new_return_reg (s));
+  dbcc_ir_module_add (module, f);
+}
+
+static void
+make_profiled_module (void)
+{
+  module = dbcc_ir_module_new ();
+  make_big ("big", 40, 0);
+  make_abs ("abs_cold", 0);
+  make_driver ();
+}
+
+static void
+test_profile (void)
+{
+  static const char filename[] = "test-ir.profile";
+  int64_t args[1] = { 20 };
+  DBCC_Error *error = NULL;
+
+  /* Without a profile, big is too big and abs_cold is cheap. */
+  make_profiled_module ();
+  DBCC_IR_InlineOptions options = DBCC_IR_INLINE_OPTIONS_DEFAULT;
+  options.hot_call_count = 20;
+  DBCC_IR_InlineStats stats;
+  dbcc_ir_module_inline (module, &options, &stats);
+  assert (stats.n_inlined == 1 && stats.n_rejected_cost == 1);
+  assert (count_calls ("driver") == 1);
+  dbcc_ir_module_destroy (module);
+
+  /* Collect a profile from an instrumented build. */
+  make_profiled_module ();
+  profile_being_collected = dbcc_ir_module_instrument (module, symbols);
+  assert (run_by_name ("driver", 1, args) == 190 + 20 * 780);
+  assert (dbcc_ir_profile_write (profile_being_collected, filename, &error));
+  dbcc_ir_profile_destroy (profile_being_collected);
+  profile_being_collected = NULL;
+  dbcc_ir_module_destroy (module);
+
+  DBCC_IR_Profile *profile = dbcc_ir_profile_read (symbols, filename, &error);
+  assert (profile != NULL);
+  assert (profile->n_functions == 3);
+  DBCC_IR_Profile *twice = dbcc_ir_profile_read (symbols, filename, &error);
+  assert (dbcc_ir_profile_merge (twice, profile, &error));
+
+  /* Hot big is inlined;  abs_cold never ran, so it isn't. */
+  make_profiled_module ();
+  assert (dbcc_ir_module_apply_profile (module, twice) == 3);
+  DBCC_Function *driver = dbcc_ir_module_lookup (module, sym ("driver"));
+  assert (driver->blocks[1]->count == 42);      /* header */
+  assert (driver->blocks[2]->count == 40);      /* body */
+  assert (driver->blocks[3]->count == 0);       /* cold */
+  dbcc_ir_module_inline (module, &options, &stats);
+  assert (stats.n_inlined == 1 && stats.n_rejected_cold == 1);
+  assert (count_calls ("driver") == 1);
+  assert (dbcc_ir_module_lookup (module, sym ("big"))->entry->count == 0);
+  assert (run_by_name ("driver", 1, args) == 190 + 20 * 780);
+  dbcc_ir_module_destroy (module);
+
+  /* A function edited since the profile was taken gets no counts. */
+  make_profiled_module ();
+  DBCC_Function *big = dbcc_ir_module_lookup (module, sym ("big"));
+  DBCC_BB *extra = dbcc_function_add_block (big);
+  dbcc_bb_append (extra, dbcc_ir_new_return_reg (0));
+  assert (dbcc_ir_module_apply_profile (module, profile) == 2);
+  assert (!big->has_profile);
+  dbcc_ir_module_destroy (module);
+
+  dbcc_ir_profile_destroy (profile);
+  dbcc_ir_profile_destroy (twice);
+  dsk_file_set_contents (filename, 4, (const uint8_t *) "junk", NULL);
+  assert (dbcc_ir_profile_read (symbols, filename, &error) == NULL);
+  assert (error->code == DBCC_ERROR_BAD_PROFILE);
+  dbcc_error_unref (error);
+  unlink (filename);
+
+  printf ("profile: ok\n");
+}
+
+int main(void)
+{
+  symbols = dbcc_symbol_space_new ();
+  test_inline ();
+  test_alias ();
+  test_loops ();
+  test_vectorize ();
+  test_profile ();
+  return 0;
+}
@@ -0,0 +1,125 @@
+#include "../dbcc.h"
+#include "../dsk/dsk.h"
+#include <stdio.h>
+#include <assert.h>
+
+/* Parse files with lazy_function_bodies set, and check
+ * which deferred definitions were materialized.
+ * A body that must never be parsed refers to an undeclared
+ * name, so parsing it would be an error.
+ */
+
+static const char dir[] = "test-lazy-bodies.tmp";
+
+static DBCC_TargetEnvironment target_env = {
+  .is_char_signed = 1,
+  .is_wchar_signed = 1,
+  .sizeof_int = 4,
+  .sizeof_long_int = 8,
+  .sizeof_long_long_int = 8,
+  .sizeof_pointer = 8,
+  .alignof_int = 4,
+  .alignof_long_int = 8,
+  .alignof_long_long_int = 8,
+  .alignof_pointer = 8,
+  .sizeof_wchar = 4,
+  .alignof_int16 = 2,
+  .alignof_int32 = 4,
+  .alignof_int64 = 8,
+  .alignof_float = 4,
+  .alignof_double = 8,
+  .sizeof_long_double = 16,
+  .alignof_long_double = 16,
+  .sizeof_bool = 1,
+  .alignof_bool = 1,
+  .min_struct_alignof = 1,
+};
+
+static unsigned n_errors;
+
+static void
+handle_error (DBCC_Error *error, void *handler_data)
+{
+  (void) handler_data;
+  n_errors++;
+  dbcc_error_unref (error);
+}
+
+/* Returns whether the parse succeeded;  the number of bodies
+ * deferred and materialized are stored in 'stats'. */
+static bool
+parse (const char *name, const char *text, bool lazy, DBCC_ParserStats *stats)
+{
+  char *path = dsk_strdup_printf ("%s/%s", dir, name);
+  assert (dsk_file_set_contents (path, strlen (text), (const uint8_t *) text, NULL));
+
+  DBCC_Parser_NewOptions options = DBCC_PARSER_NEW_OPTIONS;
+  options.target_env = &target_env;
+  options.handle_error = handle_error;
+  options.lazy_function_bodies = lazy;
+  DBCC_Parser *parser = dbcc_parser_new (&options);
+  unsigned old_n_errors = n_errors;
+  bool ok = dbcc_parser_parse_file (parser, path);
+  assert (ok == (n_errors == old_n_errors));
+  dbcc_parser_get_stats (parser, stats);
+  dbcc_parser_destroy (parser);
+  dsk_free (path);
+  return ok;
+}
+
+static const char three_functions[] =
+  "static int referenced (void) { return 1; }\n"
+  "static int unreferenced (void) { return never_declared; }\n"
+  "int exported (void)\n"
+  "{\n"
+  "  return referenced ();\n"
+  "}\n";
+
+static void
+test_three_functions (void)
+{
+  DBCC_ParserStats stats;
+
+  /* the unreferenced body is bad:  only skipping it lets the parse succeed */
+  assert (!parse ("three.c", three_functions, false, &stats));
+  assert (stats.function_bodies_deferred == 0);
+
+  assert (parse ("three.c", three_functions, true, &stats));
+  assert (stats.function_bodies_deferred == 3);
+  assert (stats.function_bodies_materialized == 2);
+}
+
+/* A static function named only from a materialized body, and one
+ * used before its definition, are both materialized. */
+static void
+test_references (void)
+{
+  DBCC_ParserStats stats;
+  assert (parse ("chain.c",
+                 "static int leaf (void) { return 2; }\n"
+                 "static int middle (void) { return leaf (); }\n"
+                 "static int later (void);\n"
+                 "int exported (void) { return middle () + later (); }\n"
+                 "static int later (void) { return 3; }\n"
+                 "static int dead (void) { return leaf () + never_declared; }\n",
+                 true, &stats));
+  assert (stats.function_bodies_deferred == 5);
+  assert (stats.function_bodies_materialized == 4);
+
+  /* a bad body is reported once it is needed */
+  assert (!parse ("bad.c",
+                  "static int bad (void) { return never_declared; }\n"
+                  "int exported (void) { return bad (); }\n",
+                  true, &stats));
+}
+
+int main()
+{
+  dsk_rm_rf (dir, NULL);
+  assert (dsk_mkdir_recursive (dir, 0755, NULL));
+  test_three_functions ();
+  test_references ();
+  dsk_rm_rf (dir, NULL);
+  printf ("lazy-bodies: ok\n");
+  return 0;
+}
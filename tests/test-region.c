@@ -0,0 +1,178 @@
+#include "../dbcc.h"
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+/* Allocate from a DBCC_Region:  alignment, chunk rollover,
+ * the per-allocation statistics, and nodes made while a
+ * region is current.
+ */
+
+#define LINE            DBCC_REGION_CACHE_LINE_SIZE
+#define CHUNK           DBCC_REGION_CHUNK_SIZE
+
+static void *
+alloc_and_fill (DBCC_Region *region, size_t size)
+{
+  void *rv = dbcc_region_alloc (region, size);
+  memset (rv, 0xaa, size);
+  return rv;
+}
+
+static bool
+in_line (const void *ptr, size_t size)
+{
+  uintptr_t at = (uintptr_t) ptr;
+  return at / LINE == (at + size - 1) / LINE;
+}
+
+/* Every node is NODE_ALIGN aligned;  sizes that divide the
+ * cache line never straddle one, and other sizes are packed. */
+static void
+test_alignment (void)
+{
+  static const size_t sizes[] = { 1, 8, 16, 17, 24, 32, 40, 48, 64, 72, 100 };
+  DBCC_Region *region = dbcc_region_new ();
+  DBCC_RegionStats stats;
+  size_t requested = 0, rounded = 0;
+  unsigned n = 0;
+
+  for (unsigned pass = 0; pass < 20; pass++)
+    for (unsigned i = 0; i < DSK_N_ELEMENTS (sizes); i++)
+      {
+        size_t size = sizes[i];
+        char *prev_end = region->at;
+        char *p = alloc_and_fill (region, size);
+        size_t r = DBCC_ALIGN (size, DBCC_REGION_NODE_ALIGN);
+        assert ((uintptr_t) p % DBCC_REGION_NODE_ALIGN == 0);
+        if (r <= LINE && (r & (r - 1)) == 0)
+          assert (in_line (p, r));
+        else
+          assert (p == prev_end);
+        requested += size;
+        rounded += r;
+        n++;
+      }
+
+  dbcc_region_get_stats (region, &stats);
+  assert (stats.n_allocs == n);
+  assert (stats.bytes_requested == requested);
+  assert (stats.bytes_used >= rounded);
+  assert (stats.bytes_used < rounded + n * LINE);
+  assert (stats.n_chunks == 1);
+  assert (stats.bytes_reserved == CHUNK);
+  dbcc_region_destroy (region);
+}
+
+/* A chunk holds (CHUNK - one header line) / LINE line-sized nodes;
+ * the next one starts a new chunk without touching the old. */
+static void
+test_rollover (void)
+{
+  DBCC_Region *region = dbcc_region_new ();
+  DBCC_RegionStats stats;
+  unsigned per_chunk = (CHUNK - LINE) / LINE;
+  char *first = alloc_and_fill (region, LINE);
+  char *last = first;
+
+  for (unsigned i = 1; i < per_chunk; i++)
+    {
+      char *p = alloc_and_fill (region, LINE);
+      assert (p == last + LINE);
+      last = p;
+    }
+  dbcc_region_get_stats (region, &stats);
+  assert (stats.n_chunks == 1);
+  assert (stats.bytes_used == per_chunk * LINE);
+  assert (region->at == region->end);
+
+  char *next = alloc_and_fill (region, LINE);
+  assert (next < first - LINE || next >= first - LINE + CHUNK);
+  assert ((uintptr_t) next % LINE == 0);
+  dbcc_region_get_stats (region, &stats);
+  assert (stats.n_chunks == 2);
+  assert (stats.bytes_reserved == 2 * CHUNK);
+  assert (stats.n_allocs == per_chunk + 1);
+  assert (stats.bytes_requested == (per_chunk + 1) * LINE);
+
+  /* the old nodes are intact */
+  for (char *at = first; at < last + LINE; at++)
+    assert ((uint8_t) *at == 0xaa);
+
+  dbcc_region_destroy (region);
+}
+
+/* A big request that fits is served from the shared chunk;
+ * one that doesn't gets a chunk of its own, and the shared
+ * chunk goes on filling from where it was. */
+static void
+test_large (void)
+{
+  DBCC_Region *region = dbcc_region_new ();
+  DBCC_RegionStats stats;
+  size_t big = CHUNK / 2;
+  char *a = alloc_and_fill (region, 48);
+  char *b = alloc_and_fill (region, big);
+  assert (b == a + 48);
+  char *c = alloc_and_fill (region, big);
+  assert ((uintptr_t) c % LINE == 0);
+  char *d = alloc_and_fill (region, 48);
+  assert (d == b + big);
+
+  dbcc_region_get_stats (region, &stats);
+  assert (stats.n_chunks == 2);
+  assert (stats.bytes_reserved == CHUNK + LINE + big);
+  assert (stats.n_allocs == 4);
+  assert (stats.bytes_requested == 2 * big + 96);
+  dbcc_region_destroy (region);
+}
+
+/* Nodes are marked from_region while a region is current;
+ * ref/unref/destroy leave those to the region. */
+static void
+test_nodes (void)
+{
+  DBCC_SymbolSpace *space = dbcc_symbol_space_new ();
+  DBCC_Symbol *filename = dbcc_symbol_space_force (space, "test.c");
+  DBCC_Region *region = dbcc_region_new ();
+  DBCC_RegionStats stats;
+
+  DBCC_CodePosition *heap_cp = dbcc_code_position_new (NULL, NULL, filename, 1, 1, 0);
+  assert (!heap_cp->from_region);
+
+  DBCC_Region *old = dbcc_region_set_current (region);
+  assert (old == NULL);
+  assert (dbcc_region_get_current () == region);
+  DBCC_CodePosition *cp = dbcc_code_position_new (NULL, NULL, filename, 2, 1, 10);
+  DBCC_Statement *stmt = dbcc_statement_new_break (cp);
+  assert (cp->from_region);
+  assert (stmt->base.from_region);
+  assert (dbcc_code_position_ref (cp) == cp);
+  dbcc_code_position_unref (cp);
+  dbcc_code_position_unref (cp);
+  dbcc_statement_destroy (stmt);
+  assert (dbcc_region_set_current (old) == region);
+
+  dbcc_region_get_stats (region, &stats);
+  assert (stats.n_allocs == 2);
+  assert (stats.bytes_requested
+          == sizeof (DBCC_CodePosition) + sizeof (DBCC_Statement));
+
+  /* the region's nodes are still readable until it is destroyed */
+  assert (cp->line_no == 2);
+  assert (stmt->base.code_position == cp);
+
+  dbcc_region_destroy (region);
+  dbcc_code_position_unref (heap_cp);
+  dbcc_symbol_space_destroy (space);
+}
+
+int main()
+{
+  test_alignment ();
+  test_rollover ();
+  test_large ();
+  test_nodes ();
+  printf ("region: ok\n");
+  return 0;
+}
@@ -0,0 +1,74 @@
+#include "../dbcc.h"
+#include <stdio.h>
+#include <assert.h>
+#include <pthread.h>
+
+/* Several threads intern overlapping sets of strings in one
+ * symbol space;  every string must map to exactly one symbol.
+ */
+#define N_THREADS       8
+#define N_STRINGS       200000
+
+static DBCC_SymbolSpace *space;
+static DBCC_Symbol **results[N_THREADS];
+
+static void
+make_string (char *buf, unsigned i)
+{
+  sprintf (buf, "sym_%u_%x", i, i * 2654435761u);
+}
+
+static void *
+intern_all (void *arg)
+{
+  unsigned t = (unsigned) (uintptr_t) arg;
+  DBCC_Symbol **out = malloc (sizeof (DBCC_Symbol *) * N_STRINGS);
+  char buf[64];
+
+  /* each thread walks the strings in a different order;
+   * the strides are coprime to N_STRINGS */
+  static const unsigned strides[N_THREADS] = { 1, 3, 7, 9, 11, 13, 17, 19 };
+  for (unsigned j = 0; j < N_STRINGS; j++)
+    {
+      unsigned i = (unsigned) (((uint64_t) j * strides[t] + t * 7919) % N_STRINGS);
+      make_string (buf, i);
+      out[i] = dbcc_symbol_space_force (space, buf);
+    }
+  results[t] = out;
+  return NULL;
+}
+
+int main(void)
+{
+  space = dbcc_symbol_space_new ();
+  pthread_t threads[N_THREADS];
+  for (unsigned t = 0; t < N_THREADS; t++)
+    pthread_create (&threads[t], NULL, intern_all, (void *) (uintptr_t) t);
+  for (unsigned t = 0; t < N_THREADS; t++)
+    pthread_join (threads[t], NULL);
+
+  char buf[64];
+  for (unsigned i = 0; i < N_STRINGS; i++)
+    {
+      make_string (buf, i);
+      DBCC_Symbol *sym = dbcc_symbol_space_try (space, buf);
+      assert (sym != NULL);
+      assert (strcmp (dbcc_symbol_get_string (sym), buf) == 0);
+      for (unsigned t = 0; t < N_THREADS; t++)
+        assert (results[t][i] == sym);
+    }
+  assert (atomic_load (&space->n_symbols) == N_STRINGS);
+  assert (dbcc_symbol_space_try (space, "not-interned") == NULL);
+
+  /* length-delimited lookups match only the prefix */
+  DBCC_Symbol *a = dbcc_symbol_space_force_len (space, 3, "abcdef");
+  assert (a == dbcc_symbol_space_force (space, "abc"));
+  assert (a->length == 3);
+
+  printf ("ok: %u threads, %u symbols, %zu buckets\n",
+          N_THREADS, N_STRINGS, atomic_load (&space->n_buckets));
+  for (unsigned t = 0; t < N_THREADS; t++)
+    free (results[t]);
+  dbcc_symbol_space_destroy (space);
+  return 0;
+}